@@ -1,23 +1,36 @@
 #include "AnimationSystem.hpp"
 #include "Components/AnimationComponent.hpp"
 #include "Components/IKComponent.hpp"
+#include "Components/FootPlacementComponent.hpp"
+#include "Components/RagdollComponent.hpp"
+#include "Components/Components.hpp"
+#include "FootPlacement.hpp"
 #include "Pose.hpp"
 #include "IKSolver.hpp"
 #include "Events/EventBus.hpp"
 #include "Events/EngineEvents.hpp"
+#include "Utils/MemoryTracker.hpp"
+#include <algorithm>
 
 namespace AnimationSystem
 {
 
 void update(entt::registry& registry, float dt)
 {
+    MemoryTagScope memory_tag(MemoryTag::Animation);
     auto view = registry.view<AnimationComponent>();
+    std::vector<glm::mat4> global_transforms;
+    std::vector<glm::mat4> bind_locals;
 
     for (auto entity : view)
     {
         auto& anim = view.get<AnimationComponent>(entity);
 
-        if (!anim.skeleton || !anim.blender.isPlaying())
+        // A running ragdoll keeps the entity posed after its clip has stopped
+        auto* ragdoll = registry.try_get<RagdollComponent>(entity);
+        const bool ragdolled = ragdoll && ragdoll->simulate;
+
+        if (!anim.skeleton || (!anim.blender.isPlaying() && !ragdolled))
             continue;
 
         int bone_count = anim.skeleton->getBoneCount();
@@ -26,15 +39,24 @@ void update(entt::registry& registry, float dt)
         bool was_playing = anim.blender.isPlaying();
         const AnimationClip* clip_before = anim.blender.getCurrentClip();
 
-        // Step 1: Advance blender and produce decomposed pose
+        // Step 1: Advance blender and produce decomposed pose (the bind pose once it stops)
         Pose local_pose(bone_count);
-        anim.blender.updatePose(dt, bone_count, local_pose);
+        if (was_playing)
+        {
+            anim.blender.updatePose(dt, bone_count, local_pose);
+        }
+        else
+        {
+            bind_locals.clear();
+            for (const Bone& bone : anim.skeleton->getBones())
+                bind_locals.push_back(bone.local_transform);
+            local_pose.fromMatrices(bind_locals);
+        }
 
         // Step 2: Apply IK if entity has IKComponent
         auto* ik = registry.try_get<IKComponent>(entity);
         if (ik && ik->enabled)
         {
-            std::vector<glm::mat4> global_transforms;
             anim.skeleton->computeGlobalTransforms(local_pose, global_transforms);
 
             for (auto& constraint : ik->two_bone_constraints)
@@ -48,10 +70,31 @@ void update(entt::registry& registry, float dt)
             }
         }
 
-        // Step 3: Compute final bone matrices for GPU
+        // Step 3: Plant feet on the ground probed by FootPlacement::updateProbes
+        auto* feet = registry.try_get<FootPlacementComponent>(entity);
+        if (feet && feet->enabled && !feet->legs.empty())
+        {
+            auto* transform = registry.try_get<TransformComponent>(entity);
+            const glm::mat4 model_to_world = transform ? transform->getTransformMatrix() : glm::mat4(1.0f);
+            FootPlacement::apply(*anim.skeleton, local_pose, global_transforms, *feet, model_to_world, dt);
+        }
+
+        // Step 4: The animated pose becomes the ragdoll's motor target, and the simulated
+        // pose read back by PhysicsSystem::updateRagdolls is blended over it
+        if (ragdoll)
+        {
+            ragdoll->animated_pose = local_pose;
+            if (ragdolled && ragdoll->has_physics_pose && ragdoll->blend_weight > 0.0f
+                && ragdoll->physics_pose.getBoneCount() == bone_count)
+            {
+                local_pose = Pose::blend(local_pose, ragdoll->physics_pose, std::min(ragdoll->blend_weight, 1.0f));
+            }
+        }
+
+        // Step 5: Compute final bone matrices for GPU
         anim.skeleton->computeFinalMatrices(local_pose, anim.bone_matrices);
 
-        // Step 4: Publish event if animation just finished
+        // Step 6: Publish event if animation just finished
         if (was_playing && !anim.blender.isPlaying() && clip_before)
         {
             EventBus::get().queue(AnimationFinishedEvent{entity, clip_before->name});
@@ -0,0 +1,313 @@
+#include "FootPlacement.hpp"
+#include "IKSolver.hpp"
+#include "Components/AnimationComponent.hpp"
+#include "Components/Components.hpp"
+#include "Components/FootPlacementComponent.hpp"
+#include "PhysicsSystem.hpp"
+#include "Threading/JobSystem.hpp"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    constexpr glm::vec3 UP{0.0f, 1.0f, 0.0f};
+
+    // Model-space position of a bone in the skeleton's bind pose
+    glm::vec3 bindPosition(const Skeleton& skeleton, int bone)
+    {
+        const auto& bones = skeleton.getBones();
+        glm::mat4 global(1.0f);
+        for (int i = bone; i >= 0 && i < static_cast<int>(bones.size()); i = bones[i].parent_id)
+            global = bones[i].local_transform * global;
+        return glm::vec3(global[3]);
+    }
+
+    glm::quat globalRotation(const glm::mat4& m)
+    {
+        return glm::normalize(glm::quat_cast(glm::mat3(
+            glm::normalize(glm::vec3(m[0])), glm::normalize(glm::vec3(m[1])), glm::normalize(glm::vec3(m[2])))));
+    }
+
+    glm::quat weightedDelta(const glm::quat& delta, float weight)
+    {
+        if (weight >= 1.0f)
+            return delta;
+        return glm::slerp(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), delta, weight);
+    }
+
+    // Corrections are stored as deltas on top of the animated pose, so frames the LOD
+    // skips (and the fade-out) can reapply them without any transforms
+    void applyCorrections(Pose& local_pose, const FootPlacementComponent& feet, float weight)
+    {
+        const int bone_count = local_pose.getBoneCount();
+        if (feet.pelvis_bone >= 0 && feet.pelvis_bone < bone_count)
+            local_pose[feet.pelvis_bone].translation += feet.pelvis_local_delta * weight;
+
+        for (const FootPlacementLeg& leg : feet.legs)
+        {
+            if (leg.foot_bone >= bone_count || leg.shin_bone >= bone_count || leg.thigh_bone >= bone_count)
+                continue;
+            local_pose[leg.thigh_bone].rotation = glm::normalize(weightedDelta(leg.thigh_delta, weight) * local_pose[leg.thigh_bone].rotation);
+            local_pose[leg.shin_bone].rotation = glm::normalize(weightedDelta(leg.shin_delta, weight) * local_pose[leg.shin_bone].rotation);
+            local_pose[leg.foot_bone].rotation = glm::normalize(weightedDelta(leg.foot_delta, weight) * local_pose[leg.foot_bone].rotation);
+        }
+    }
+
+    void solve(const Skeleton& skeleton,
+               Pose& local_pose,
+               std::vector<glm::mat4>& globals,
+               FootPlacementComponent& feet,
+               const glm::mat4& model_to_world)
+    {
+        const int bone_count = skeleton.getBoneCount();
+        const auto& bones = skeleton.getBones();
+        skeleton.computeGlobalTransforms(local_pose, globals);
+
+        const glm::mat4 world_to_model = glm::inverse(model_to_world);
+        const float root_height = feet.root_grounded ? glm::vec3(world_to_model * glm::vec4(feet.root_ground, 1.0f)).y : 0.0f;
+
+        // First solve snaps; afterwards corrections ease in over time_since_solve
+        const float alpha = feet.has_solution ? 1.0f - std::exp(-feet.blend_speed * feet.time_since_solve) : 1.0f;
+
+        std::vector<glm::vec3> animated_feet(feet.legs.size());
+        float lowest_offset = 0.0f;
+        for (size_t i = 0; i < feet.legs.size(); ++i)
+        {
+            FootPlacementLeg& leg = feet.legs[i];
+            animated_feet[i] = glm::vec3(globals[leg.foot_bone][3]);
+            leg.probe_foot = animated_feet[i];
+
+            // The animation was authored on flat ground at the origin's height, so the
+            // correction is the terrain height under the foot relative to the origin
+            float desired = 0.0f;
+            if (leg.grounded)
+            {
+                const float ground = glm::vec3(world_to_model * glm::vec4(leg.ground_point, 1.0f)).y;
+                desired = glm::clamp(ground - root_height, -feet.max_pelvis_drop, feet.max_step_up);
+            }
+            leg.offset += (desired - leg.offset) * alpha;
+            lowest_offset = std::min(lowest_offset, leg.offset);
+        }
+
+        // Drop the pelvis so the lowest foot can still reach its ground. The leg offsets
+        // are already smoothed, so following them directly keeps that foot reachable.
+        feet.pelvis_offset = std::max(lowest_offset, -feet.max_pelvis_drop);
+
+        feet.pelvis_local_delta = glm::vec3(0.0f);
+        if (feet.pelvis_bone >= 0 && feet.pelvis_bone < bone_count)
+        {
+            glm::vec3 delta = UP * feet.pelvis_offset;
+            const int parent = bones[feet.pelvis_bone].parent_id;
+            if (parent >= 0)
+                delta = glm::inverse(glm::mat3(globals[parent])) * delta;
+            feet.pelvis_local_delta = delta;
+            local_pose[feet.pelvis_bone].translation += delta;
+            skeleton.computeGlobalTransforms(local_pose, globals);
+        }
+
+        for (size_t i = 0; i < feet.legs.size(); ++i)
+        {
+            FootPlacementLeg& leg = feet.legs[i];
+            const glm::quat animated_thigh = local_pose[leg.thigh_bone].rotation;
+            const glm::quat animated_shin = local_pose[leg.shin_bone].rotation;
+            const glm::quat animated_foot = local_pose[leg.foot_bone].rotation;
+
+            // Keep the animated bend plane; straight legs bend along pole_vector
+            const glm::vec3 hip = glm::vec3(globals[leg.thigh_bone][3]);
+            const glm::vec3 knee = glm::vec3(globals[leg.shin_bone][3]);
+            const glm::vec3 ankle = glm::vec3(globals[leg.foot_bone][3]);
+            const glm::vec3 bend = knee - (hip + ankle) * 0.5f;
+
+            TwoBoneIKConstraint constraint;
+            constraint.root_bone = leg.thigh_bone;
+            constraint.mid_bone = leg.shin_bone;
+            constraint.end_bone = leg.foot_bone;
+            constraint.target = animated_feet[i] + UP * leg.offset;
+            constraint.pole_vector = knee + (glm::length(bend) > 1e-3f ? glm::normalize(bend) : leg.pole_vector);
+            TwoBoneIKConstraint::solve(skeleton, local_pose, globals, constraint);
+
+            if (feet.align_to_ground && leg.grounded)
+            {
+                const glm::vec3 normal = glm::normalize(glm::mat3(world_to_model) * leg.ground_normal);
+                const glm::quat tilt = glm::rotation(UP, normal);
+                const glm::quat foot_global = globalRotation(globals[leg.foot_bone]);
+                const glm::quat shin_global = globalRotation(globals[leg.shin_bone]);
+                local_pose[leg.foot_bone].rotation = glm::normalize(glm::inverse(shin_global) * tilt * foot_global);
+            }
+
+            leg.thigh_delta = glm::normalize(local_pose[leg.thigh_bone].rotation * glm::inverse(animated_thigh));
+            leg.shin_delta = glm::normalize(local_pose[leg.shin_bone].rotation * glm::inverse(animated_shin));
+            leg.foot_delta = glm::normalize(local_pose[leg.foot_bone].rotation * glm::inverse(animated_foot));
+
+            local_pose[leg.thigh_bone].rotation = animated_thigh;
+            local_pose[leg.shin_bone].rotation = animated_shin;
+            local_pose[leg.foot_bone].rotation = animated_foot;
+        }
+
+        if (feet.pelvis_bone >= 0 && feet.pelvis_bone < bone_count)
+            local_pose[feet.pelvis_bone].translation -= feet.pelvis_local_delta;
+
+        feet.has_solution = true;
+        feet.time_since_solve = 0.0f;
+    }
+}
+
+namespace FootPlacement
+{
+
+void updateProbes(entt::registry& registry,
+                  const PhysicsSystem& physics,
+                  const glm::vec3& camera_position,
+                  const FootPlacementSettings& settings,
+                  FootPlacementStats* out_stats)
+{
+    const auto start = std::chrono::steady_clock::now();
+    FootPlacementStats stats;
+
+    struct ProbeOwner
+    {
+        FootPlacementComponent* feet;
+        int leg;   // -1 for the probe under the origin
+    };
+    std::vector<SceneQuery> queries;
+    std::vector<ProbeOwner> owners;
+
+    const float full_sq = settings.full_distance * settings.full_distance;
+    const float reduced_sq = settings.reduced_distance * settings.reduced_distance;
+    const uint32_t interval = std::max<uint32_t>(settings.reduced_interval, 1);
+
+    auto view = registry.view<FootPlacementComponent, AnimationComponent, TransformComponent>();
+    for (auto entity : view)
+    {
+        auto& feet = view.get<FootPlacementComponent>(entity);
+        const auto& anim = view.get<AnimationComponent>(entity);
+        const auto& transform = view.get<TransformComponent>(entity);
+        if (!feet.enabled || !anim.skeleton || feet.legs.empty())
+            continue;
+
+        ++stats.characters;
+        const glm::vec3 to_camera = transform.position - camera_position;
+        const float distance_sq = glm::dot(to_camera, to_camera);
+        if (distance_sq <= full_sq)
+        {
+            feet.lod = IKLod::Full;
+            feet.solve_this_frame = true;
+            ++stats.full;
+        }
+        else if (distance_sq <= reduced_sq)
+        {
+            // Staggered by entity so reduced characters don't all solve on the same frame
+            feet.lod = IKLod::Reduced;
+            feet.solve_this_frame = !feet.has_solution ||
+                (feet.lod_frame++ + static_cast<uint32_t>(entt::to_entity(entity))) % interval == 0;
+            ++stats.reduced;
+        }
+        else
+        {
+            feet.lod = IKLod::Disabled;
+            feet.solve_this_frame = false;
+            ++stats.disabled;
+        }
+
+        if (!feet.solve_this_frame)
+            continue;
+
+        if (!feet.has_probe_points)
+        {
+            for (FootPlacementLeg& leg : feet.legs)
+                leg.probe_foot = bindPosition(*anim.skeleton, leg.foot_bone);
+            feet.has_probe_points = true;
+        }
+
+        const glm::mat4 model_to_world = transform.getTransformMatrix();
+        const float probe_length = feet.probe_height + feet.probe_depth;
+        queries.push_back(SceneQuery::raycast(transform.position + UP * feet.probe_height, -UP, probe_length, entity));
+        owners.push_back({&feet, -1});
+        for (size_t i = 0; i < feet.legs.size(); ++i)
+        {
+            const glm::vec3 foot = glm::vec3(model_to_world * glm::vec4(feet.legs[i].probe_foot, 1.0f));
+            queries.push_back(SceneQuery::raycast(foot + UP * feet.probe_height, -UP, probe_length, entity));
+            owners.push_back({&feet, static_cast<int>(i)});
+        }
+    }
+
+    std::vector<SceneQueryResult> results(queries.size());
+    if (!queries.empty())
+    {
+        Threading::JobSystem& jobs = Threading::JobSystem::get();
+        if (settings.parallel && jobs.isInitialized())
+        {
+            jobs.parallelFor("FootProbes", queries.size(), settings.min_batch_size,
+                [&](size_t begin, size_t end) {
+                    physics.runSceneQueries(queries.data() + begin, results.data() + begin, end - begin);
+                },
+                Threading::JobPriority::High);
+        }
+        else
+        {
+            physics.runSceneQueries(queries.data(), results.data(), queries.size());
+        }
+    }
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        FootPlacementComponent& feet = *owners[i].feet;
+        const SceneQueryResult& result = results[i];
+        if (owners[i].leg < 0)
+        {
+            feet.root_grounded = result.hit;
+            feet.root_ground = result.point;
+            continue;
+        }
+
+        FootPlacementLeg& leg = feet.legs[owners[i].leg];
+        leg.grounded = result.hit;
+        if (result.hit)
+        {
+            leg.ground_point = result.point;
+            leg.ground_normal = result.normal;
+        }
+    }
+
+    stats.probes = static_cast<uint32_t>(queries.size());
+    stats.probe_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (out_stats)
+        *out_stats = stats;
+}
+
+void apply(const Skeleton& skeleton,
+           Pose& local_pose,
+           std::vector<glm::mat4>& scratch_globals,
+           FootPlacementComponent& feet,
+           const glm::mat4& model_to_world,
+           float dt)
+{
+    const int bone_count = std::min(skeleton.getBoneCount(), local_pose.getBoneCount());
+    for (const FootPlacementLeg& leg : feet.legs)
+    {
+        if (leg.thigh_bone < 0 || leg.shin_bone < 0 || leg.foot_bone < 0 ||
+            leg.thigh_bone >= bone_count || leg.shin_bone >= bone_count || leg.foot_bone >= bone_count)
+            return;
+    }
+
+    feet.time_since_solve += dt;
+    const float weight_target = feet.lod == IKLod::Disabled ? 0.0f : 1.0f;
+    const float fade = 1.0f - std::exp(-feet.blend_speed * dt);
+    feet.weight += (weight_target - feet.weight) * fade;
+    if (feet.lod == IKLod::Disabled && feet.weight < 0.01f)
+        feet.weight = 0.0f;
+
+    if (feet.solve_this_frame && feet.lod != IKLod::Disabled)
+    {
+        solve(skeleton, local_pose, scratch_globals, feet, model_to_world);
+        feet.solve_this_frame = false;
+    }
+
+    if (feet.has_solution && feet.weight > 0.0f)
+        applyCorrections(local_pose, feet, feet.weight);
+}
+
+} // namespace FootPlacement
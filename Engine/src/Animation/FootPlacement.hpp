@@ -0,0 +1,54 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Pose.hpp"
+#include "Skeleton.hpp"
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PhysicsSystem;
+struct FootPlacementComponent;
+
+struct FootPlacementSettings
+{
+    float full_distance = 15.0f;      // Full solve inside this camera distance
+    float reduced_distance = 40.0f;   // Reduced rate up to here, disabled beyond
+    uint32_t reduced_interval = 4;    // Mid-range characters solve every Nth frame
+    size_t min_batch_size = 64;       // Probes per worker job
+    bool parallel = true;
+};
+
+struct FootPlacementStats
+{
+    uint32_t characters = 0;
+    uint32_t full = 0;
+    uint32_t reduced = 0;
+    uint32_t disabled = 0;
+    uint32_t probes = 0;
+    double probe_ms = 0.0;
+};
+
+namespace FootPlacement
+{
+    // Picks every character's IK LOD from its distance to the camera, then casts the
+    // ground probes of all characters solving this frame as one batch against Jolt.
+    // Run before AnimationSystem::update.
+    ENGINE_API void updateProbes(entt::registry& registry,
+                                 const PhysicsSystem& physics,
+                                 const glm::vec3& camera_position,
+                                 const FootPlacementSettings& settings = {},
+                                 FootPlacementStats* out_stats = nullptr);
+
+    // Lowers the pelvis and solves two-bone leg IK onto the probed ground, or reapplies
+    // the last corrections on frames the LOD skips. Called by AnimationSystem::update.
+    // scratch_globals is working storage for model-space bone transforms.
+    ENGINE_API void apply(const Skeleton& skeleton,
+                          Pose& local_pose,
+                          std::vector<glm::mat4>& scratch_globals,
+                          FootPlacementComponent& feet,
+                          const glm::mat4& model_to_world,
+                          float dt);
+}
@@ -2,6 +2,7 @@
 
 #include <SDL3/SDL.h>
 #include "Graphics/RenderAPI.hpp"
+#include "Timer/FramePacer.hpp"
 #include "Utils/Log.hpp"
 #include <memory>
 
@@ -15,6 +16,7 @@ private:
     int target_fps;
     float fov;
     RenderAPIType api_type;
+    FramePacer frame_pacer;
 
 public:
     Application(int w = 1920, int h = 1080, int fps = 60, float field_of_view = 75.0f, RenderAPIType render_type = DefaultRenderAPI)
@@ -159,6 +161,7 @@ public:
     int getTargetFPS() const { return target_fps; }
     float getFOV() const { return fov; }
     RenderAPIType getAPIType() const { return api_type; }
+    FramePacer& getFramePacer() { return frame_pacer; }
 
     // Setters
     void setTargetFPS(int fps) { target_fps = fps; }
@@ -784,6 +784,23 @@ bool AssetCompiler::compileModel(
     return true;
 }
 
+// ================================================================
+// compileShaders
+// ================================================================
+
+ShaderBuildResult AssetCompiler::compileShaders(const ShaderBuildConfig& config)
+{
+    if (!fs::exists(config.source_dir)) {
+        ShaderBuildResult result;
+        result.errors.push_back("Shader directory not found: " + config.source_dir);
+        LOG_ENGINE_ERROR("[AssetCompiler] Shader directory not found: {}", config.source_dir);
+        return result;
+    }
+
+    LOG_ENGINE_INFO("[AssetCompiler] compileShaders: source='{}' output='{}'", config.source_dir, config.output_root);
+    return ShaderCompiler::build(ShaderCompiler::getEnginePermutations(config), config);
+}
+
 // ================================================================
 // compileAll
 // ================================================================
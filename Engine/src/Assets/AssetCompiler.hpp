@@ -2,6 +2,7 @@
 
 #include "EngineExport.h"
 #include "CompiledTextureFormat.hpp"
+#include "ShaderCompiler.hpp"
 #include <string>
 #include <vector>
 #include <functional>
@@ -56,6 +57,10 @@ public:
         const CompileConfig& config,
         bool is_normal_map = false);
 
+    // Compile the engine's Slang shaders to SPIR-V / DXIL in-process.
+    // Only permutations whose source, imports or defines changed are rebuilt.
+    static ShaderBuildResult compileShaders(const ShaderBuildConfig& config);
+
     // Check whether the compiled output is still up-to-date vs the source.
     static bool isUpToDate(
         const std::string& source_path,
@@ -1,5 +1,6 @@
 #include "AssetManager.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "json.hpp"
 #include <filesystem>
 #include <fstream>
@@ -190,6 +191,7 @@ AssetHandle AssetManager::loadAsync(const std::string& path,
                                    LoadPriority priority,
                                    LoadCallback on_complete,
                                    ProgressCallback on_progress) {
+    MemoryTagScope memory_tag(MemoryTag::Assets);
     if (!m_initialized) {
         LOG_ENGINE_ERROR("AssetManager: Not initialized");
         return AssetHandle();
@@ -251,6 +253,7 @@ AssetHandle AssetManager::loadAsync(const std::string& path,
         .setPriority(job_priority)
         .setContext(Threading::JobContext::Worker)
         .setWork([this, id, path, base_path, loader]() {
+            MemoryTagScope load_tag(MemoryTag::Assets);
             updateProgress(id, 0.1f, LoadState::LoadingIO);
 
             LoadContext context;
@@ -284,6 +287,7 @@ AssetHandle AssetManager::loadAsync(const std::string& path,
                 .setPriority(Threading::JobPriority::High)
                 .setContext(Threading::JobContext::MainThread)
                 .setWork([this, id, loader]() {
+                    MemoryTagScope upload_tag(MemoryTag::Assets);
                     AssetState* state = getAssetState(id);
                     if (!state) return;
 
@@ -0,0 +1,515 @@
+#include "ShaderCompiler.hpp"
+#include "Utils/FileHash.hpp"
+#include "Utils/Log.hpp"
+#include "Threading/JobSystem.hpp"
+
+#include <slang.h>
+#include <slang-com-ptr.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <dlfcn.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace Assets {
+
+// ================================================================
+// Helpers
+// ================================================================
+
+static constexpr const char* SHADER_CACHE_HEADER = "# shader build cache v1";
+static constexpr const char* SLANG_SDK_DIR = "Tools/slang-2026.5.2";
+
+static std::string normalizePath(const std::string& path)
+{
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+static const char* stageName(ShaderStage stage)
+{
+    switch (stage) {
+    case ShaderStage::Vertex:   return "vertex";
+    case ShaderStage::Fragment: return "fragment";
+    case ShaderStage::Compute:  return "compute";
+    }
+    return "unknown";
+}
+
+static const char* targetProfile(ShaderTarget target)
+{
+    return target == ShaderTarget::DXIL ? "sm_6_0" : "glsl_450";
+}
+
+// Everything besides file contents that decides what an output contains
+static uint64_t permutationKey(const ShaderPermutation& permutation)
+{
+    std::string key = permutation.source + '\n' + permutation.entry_point + '\n' +
+        stageName(permutation.stage) + '\n' + targetProfile(permutation.target) + '\n';
+    for (const auto& define : permutation.defines)
+        key += define + '\n';
+    return Utils::hashBuffer(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+}
+
+struct ShaderCacheEntry {
+    uint64_t key = 0;
+    std::vector<std::pair<std::string, uint64_t>> dependencies;   // Path, content hash
+};
+
+using ShaderCache = std::unordered_map<std::string, ShaderCacheEntry>;   // By output path
+
+static ShaderCache loadShaderCache(const std::string& path)
+{
+    ShaderCache cache;
+    std::ifstream file(path);
+    if (!file.is_open())
+        return cache;
+
+    std::string line;
+    if (!std::getline(file, line) || line != SHADER_CACHE_HEADER)
+        return cache;
+
+    // "<output>\t<key>" followed by one "\t<dependency>\t<hash>" line per dependency
+    ShaderCacheEntry* current = nullptr;
+    while (std::getline(file, line)) {
+        if (line.empty())
+            continue;
+        if (line[0] == '\t') {
+            const size_t tab = line.rfind('\t');
+            if (!current || tab == 0)
+                continue;
+            current->dependencies.emplace_back(line.substr(1, tab - 1),
+                std::strtoull(line.c_str() + tab + 1, nullptr, 16));
+        } else {
+            const size_t tab = line.find('\t');
+            if (tab == std::string::npos) {
+                current = nullptr;
+                continue;
+            }
+            current = &cache[line.substr(0, tab)];
+            current->key = std::strtoull(line.c_str() + tab + 1, nullptr, 16);
+            current->dependencies.clear();
+        }
+    }
+    return cache;
+}
+
+static bool saveShaderCache(const std::string& path, const ShaderCache& cache)
+{
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    // Sorted so the file diffs cleanly between builds
+    std::vector<const std::pair<const std::string, ShaderCacheEntry>*> entries;
+    entries.reserve(cache.size());
+    for (const auto& entry : cache)
+        entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    char hex[32];
+    file << SHADER_CACHE_HEADER << '\n';
+    for (const auto* entry : entries) {
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(entry->second.key));
+        file << entry->first << '\t' << hex << '\n';
+        for (const auto& [dependency, hash] : entry->second.dependencies) {
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+            file << '\t' << dependency << '\t' << hex << '\n';
+        }
+    }
+    return file.good();
+}
+
+static bool writeShaderOutput(const std::string& path, const std::vector<uint8_t>& code)
+{
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char*>(code.data()), static_cast<std::streamsize>(code.size()));
+    return file.good();
+}
+
+// ================================================================
+// Slang loading
+// ================================================================
+
+// Loaded at runtime rather than linked, so the engine still builds and runs on
+// machines without the Slang SDK; only shader builds need it.
+using SlangCreateGlobalSessionFn = SlangResult (*)(SlangInt, slang::IGlobalSession**);
+
+static std::once_flag s_slang_load_flag;
+static SlangCreateGlobalSessionFn s_slang_create_global_session = nullptr;
+
+static void* loadSlangLibrary()
+{
+#if defined(_WIN32)
+    const char* sdk_relative = "bin/slang.dll";
+    const char* system_name = "slang.dll";
+#elif defined(__APPLE__)
+    const char* sdk_relative = "lib/libslang.dylib";
+    const char* system_name = "libslang.dylib";
+#else
+    const char* sdk_relative = "lib/libslang.so";
+    const char* system_name = "libslang.so";
+#endif
+
+    const std::string sdk_path = (fs::path(SLANG_SDK_DIR) / sdk_relative).string();
+    for (const std::string& candidate : {sdk_path, std::string(system_name)}) {
+#ifdef _WIN32
+        if (void* handle = (void*)LoadLibraryA(candidate.c_str()))
+            return handle;
+#else
+        if (void* handle = dlopen(candidate.c_str(), RTLD_NOW))
+            return handle;
+#endif
+    }
+    return nullptr;
+}
+
+static SlangCreateGlobalSessionFn getSlangEntryPoint()
+{
+    std::call_once(s_slang_load_flag, []() {
+        void* library = loadSlangLibrary();
+        if (!library) {
+            LOG_ENGINE_WARN("[ShaderCompiler] Slang library not found in {} or on the library path", SLANG_SDK_DIR);
+            return;
+        }
+        // Never unloaded: worker threads keep global sessions alive until they exit
+#ifdef _WIN32
+        s_slang_create_global_session = (SlangCreateGlobalSessionFn)GetProcAddress((HMODULE)library, "slang_createGlobalSession");
+#else
+        s_slang_create_global_session = (SlangCreateGlobalSessionFn)dlsym(library, "slang_createGlobalSession");
+#endif
+        if (!s_slang_create_global_session)
+            LOG_ENGINE_ERROR("[ShaderCompiler] Slang library has no slang_createGlobalSession");
+    });
+    return s_slang_create_global_session;
+}
+
+// A global session is expensive to create and not thread-safe, so each worker keeps its own
+static slang::IGlobalSession* getThreadGlobalSession()
+{
+    thread_local Slang::ComPtr<slang::IGlobalSession> global_session;
+    if (!global_session) {
+        SlangCreateGlobalSessionFn create = getSlangEntryPoint();
+        if (!create || SLANG_FAILED(create(SLANG_API_VERSION, global_session.writeRef())))
+            return nullptr;
+    }
+    return global_session.get();
+}
+
+static void appendDiagnostics(std::string& out, slang::IBlob* diagnostics)
+{
+    if (diagnostics && diagnostics->getBufferSize() > 0)
+        out.append(static_cast<const char*>(diagnostics->getBufferPointer()), diagnostics->getBufferSize());
+}
+
+// ================================================================
+// ShaderCompiler
+// ================================================================
+
+std::string ShaderCompiler::getCachePath(const ShaderBuildConfig& config)
+{
+    return (fs::path(config.output_root) / "shader_cache.txt").generic_string();
+}
+
+bool ShaderCompiler::isSlangAvailable()
+{
+    return getSlangEntryPoint() != nullptr;
+}
+
+std::vector<ShaderPermutation> ShaderCompiler::getEnginePermutations(const ShaderBuildConfig& config)
+{
+    static const char* const VERTEX_FRAGMENT_SHADERS[] = {
+        "shadow", "sky", "fxaa", "basic", "unlit", "skinned", "skinned_shadow",
+        "shadow_alphatest", "ssao", "ssao_blur", "shadow_mask", "gbuffer", "deferred_lighting", "decals",
+    };
+
+    std::vector<ShaderPermutation> permutations;
+    auto add = [&](const std::string& name, const char* entry, ShaderStage stage,
+                   const std::string& spirv_output, const std::string& dxil_output) {
+        ShaderPermutation permutation;
+        permutation.source = name + ".slang";
+        permutation.entry_point = entry;
+        permutation.stage = stage;
+        if (config.build_spirv) {
+            permutation.target = ShaderTarget::SPIRV;
+            permutation.defines = {"TARGET_SPIRV"};
+            permutation.output = "vulkan/" + spirv_output;
+            permutations.push_back(permutation);
+        }
+        if (config.build_dxil) {
+            permutation.target = ShaderTarget::DXIL;
+            permutation.defines = {"TARGET_HLSL"};
+            permutation.output = "d3d12/" + dxil_output;
+            permutations.push_back(permutation);
+        }
+    };
+
+    for (const char* name : VERTEX_FRAGMENT_SHADERS) {
+        const std::string shader = name;
+        add(shader, "vertexMain", ShaderStage::Vertex, shader + ".vert.spv", shader + "_vs.dxil");
+        add(shader, "fragmentMain", ShaderStage::Fragment, shader + ".frag.spv", shader + "_ps.dxil");
+    }
+
+    // RmlUi has two vertex and three fragment entry points (the atlas pair clamps UVs per entry)
+    add("rmlui", "vertexMain", ShaderStage::Vertex, "rmlui.vert.spv", "rmlui_vs.dxil");
+    add("rmlui", "fragmentTextured", ShaderStage::Fragment, "rmlui_texture.frag.spv", "rmlui_ps_textured.dxil");
+    add("rmlui", "fragmentColor", ShaderStage::Fragment, "rmlui_color.frag.spv", "rmlui_ps_color.dxil");
+    add("rmlui", "vertexAtlas", ShaderStage::Vertex, "rmlui_atlas.vert.spv", "rmlui_atlas_vs.dxil");
+    add("rmlui", "fragmentAtlas", ShaderStage::Fragment, "rmlui_atlas.frag.spv", "rmlui_atlas_ps.dxil");
+
+    return permutations;
+}
+
+bool ShaderCompiler::compileWithSlang(
+    const ShaderPermutation& permutation,
+    const ShaderBuildConfig& config,
+    ShaderCompileOutput& output)
+{
+    slang::IGlobalSession* global_session = getThreadGlobalSession();
+    if (!global_session) {
+        output.diagnostics = "Slang is not available";
+        return false;
+    }
+
+    const fs::path source_path = fs::path(config.source_dir) / permutation.source;
+    const std::string module_name = source_path.stem().string();
+    const std::string source_dir = source_path.parent_path().string();
+    const std::string root_dir = config.source_dir;
+    const char* search_paths[] = {source_dir.c_str(), root_dir.c_str()};
+
+    slang::TargetDesc target_desc;
+    target_desc.format = permutation.target == ShaderTarget::DXIL ? SLANG_DXIL : SLANG_SPIRV;
+    target_desc.profile = global_session->findProfile(targetProfile(permutation.target));
+
+    std::vector<std::pair<std::string, std::string>> macro_storage;
+    macro_storage.reserve(permutation.defines.size());
+    for (const auto& define : permutation.defines) {
+        const size_t equals = define.find('=');
+        if (equals == std::string::npos)
+            macro_storage.emplace_back(define, "");
+        else
+            macro_storage.emplace_back(define.substr(0, equals), define.substr(equals + 1));
+    }
+    std::vector<slang::PreprocessorMacroDesc> macros;
+    macros.reserve(macro_storage.size());
+    for (const auto& [name, value] : macro_storage)
+        macros.push_back({name.c_str(), value.c_str()});
+
+    // A fresh session per permutation: sessions cache loaded modules, and an edited
+    // import must not be served from a previous build
+    slang::SessionDesc session_desc;
+    session_desc.targets = &target_desc;
+    session_desc.targetCount = 1;
+    session_desc.searchPaths = search_paths;
+    session_desc.searchPathCount = source_dir == root_dir ? 1 : 2;
+    session_desc.preprocessorMacros = macros.data();
+    session_desc.preprocessorMacroCount = static_cast<SlangInt>(macros.size());
+
+    Slang::ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(global_session->createSession(session_desc, session.writeRef()))) {
+        output.diagnostics = "Failed to create Slang session";
+        return false;
+    }
+
+    Slang::ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModule(module_name.c_str(), diagnostics.writeRef());
+    appendDiagnostics(output.diagnostics, diagnostics);
+    if (!module)
+        return false;
+
+    // Includes imported modules and #included files, transitively
+    output.dependencies.clear();
+    output.dependencies.push_back(source_path.generic_string());
+    for (SlangInt32 i = 0; i < module->getDependencyFileCount(); ++i) {
+        if (const char* dependency = module->getDependencyFilePath(i))
+            output.dependencies.push_back(dependency);
+    }
+
+    SlangStage stage = SLANG_STAGE_VERTEX;
+    if (permutation.stage == ShaderStage::Fragment)
+        stage = SLANG_STAGE_FRAGMENT;
+    else if (permutation.stage == ShaderStage::Compute)
+        stage = SLANG_STAGE_COMPUTE;
+
+    Slang::ComPtr<slang::IEntryPoint> entry_point;
+    diagnostics = nullptr;
+    module->findAndCheckEntryPoint(permutation.entry_point.c_str(), stage, entry_point.writeRef(), diagnostics.writeRef());
+    appendDiagnostics(output.diagnostics, diagnostics);
+    if (!entry_point)
+        return false;
+
+    slang::IComponentType* components[] = {module, entry_point};
+    Slang::ComPtr<slang::IComponentType> program;
+    diagnostics = nullptr;
+    session->createCompositeComponentType(components, 2, program.writeRef(), diagnostics.writeRef());
+    appendDiagnostics(output.diagnostics, diagnostics);
+    if (!program)
+        return false;
+
+    Slang::ComPtr<slang::IComponentType> linked;
+    diagnostics = nullptr;
+    program->link(linked.writeRef(), diagnostics.writeRef());
+    appendDiagnostics(output.diagnostics, diagnostics);
+    if (!linked)
+        return false;
+
+    Slang::ComPtr<slang::IBlob> code;
+    diagnostics = nullptr;
+    linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef());
+    appendDiagnostics(output.diagnostics, diagnostics);
+    if (!code || code->getBufferSize() == 0)
+        return false;
+
+    const auto* bytes = static_cast<const uint8_t*>(code->getBufferPointer());
+    output.code.assign(bytes, bytes + code->getBufferSize());
+    return true;
+}
+
+ShaderBuildResult ShaderCompiler::build(
+    const std::vector<ShaderPermutation>& permutations,
+    const ShaderBuildConfig& config,
+    ShaderCompileFunction compile)
+{
+    if (!compile)
+        compile = &ShaderCompiler::compileWithSlang;
+
+    ShaderBuildResult result;
+    result.total = static_cast<int>(permutations.size());
+
+    const std::string cache_path = getCachePath(config);
+    ShaderCache cache = loadShaderCache(cache_path);
+
+    // Hash every recorded dependency once up front; jobs only read the results
+    std::unordered_map<std::string, uint64_t> file_hashes;
+    auto currentHash = [&](const std::string& path) -> uint64_t {
+        auto it = file_hashes.find(path);
+        if (it != file_hashes.end())
+            return it->second;
+        std::error_code ec;
+        const uint64_t hash = fs::exists(path, ec) ? Utils::hashFile(path) : ~0ull;
+        file_hashes.emplace(path, hash);
+        return hash;
+    };
+
+    std::vector<size_t> stale;
+    for (size_t i = 0; i < permutations.size(); ++i) {
+        const ShaderPermutation& permutation = permutations[i];
+        const std::string output_path = normalizePath((fs::path(config.output_root) / permutation.output).string());
+
+        bool up_to_date = false;
+        if (config.incremental) {
+            auto it = cache.find(permutation.output);
+            std::error_code ec;
+            up_to_date = it != cache.end() && it->second.key == permutationKey(permutation) &&
+                !it->second.dependencies.empty() && fs::exists(output_path, ec);
+            if (up_to_date) {
+                for (const auto& [dependency, hash] : it->second.dependencies) {
+                    if (currentHash(dependency) != hash) {
+                        up_to_date = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (up_to_date) {
+            LOG_ENGINE_TRACE("[ShaderCompiler] Skipped (up-to-date): {}", permutation.output);
+            ++result.skipped;
+        } else {
+            stale.push_back(i);
+        }
+    }
+
+    struct CompileSlot {
+        ShaderCompileOutput output;
+        bool success = false;
+    };
+    std::vector<CompileSlot> slots(stale.size());
+
+    auto compileOne = [&](size_t slot_index) {
+        const ShaderPermutation& permutation = permutations[stale[slot_index]];
+        CompileSlot& slot = slots[slot_index];
+        slot.success = compile(permutation, config, slot.output) &&
+            writeShaderOutput((fs::path(config.output_root) / permutation.output).string(), slot.output.code);
+    };
+
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    if (config.parallel && jobs.isInitialized() && stale.size() > 1) {
+        std::vector<Threading::JobHandle> handles;
+        handles.reserve(stale.size());
+        for (size_t slot_index = 0; slot_index < stale.size(); ++slot_index) {
+            handles.push_back(jobs.createJob()
+                .setName("Compile shader: " + permutations[stale[slot_index]].output)
+                .setPriority(Threading::JobPriority::Normal)
+                .setContext(Threading::JobContext::Worker)
+                .setWork([&compileOne, slot_index]() { compileOne(slot_index); })
+                .submit());
+        }
+        jobs.waitForJobs(handles);
+    } else {
+        for (size_t slot_index = 0; slot_index < stale.size(); ++slot_index)
+            compileOne(slot_index);
+    }
+
+    for (size_t slot_index = 0; slot_index < stale.size(); ++slot_index) {
+        const ShaderPermutation& permutation = permutations[stale[slot_index]];
+        CompileSlot& slot = slots[slot_index];
+
+        if (!slot.success) {
+            LOG_ENGINE_ERROR("[ShaderCompiler] FAILED {} ({}:{})\n{}", permutation.output,
+                             permutation.source, permutation.entry_point, slot.output.diagnostics);
+            result.errors.push_back("Failed to compile " + permutation.output + ": " + slot.output.diagnostics);
+            ++result.failed;
+            cache.erase(permutation.output);
+            continue;
+        }
+
+        if (!slot.output.diagnostics.empty())
+            LOG_ENGINE_WARN("[ShaderCompiler] {}:\n{}", permutation.output, slot.output.diagnostics);
+
+        ShaderCacheEntry entry;
+        entry.key = permutationKey(permutation);
+        std::vector<std::string> dependencies;
+        dependencies.reserve(slot.output.dependencies.size());
+        for (const auto& dependency : slot.output.dependencies)
+            dependencies.push_back(normalizePath(dependency));
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+        for (const auto& dependency : dependencies)
+            entry.dependencies.emplace_back(dependency, currentHash(dependency));
+        cache[permutation.output] = std::move(entry);
+
+        LOG_ENGINE_INFO("[ShaderCompiler] Compiled: {}", permutation.output);
+        result.compiled_outputs.push_back(permutation.output);
+        ++result.compiled;
+    }
+
+    if (!stale.empty() && !saveShaderCache(cache_path, cache))
+        LOG_ENGINE_WARN("[ShaderCompiler] Could not write {}", cache_path);
+
+    LOG_ENGINE_INFO("[ShaderCompiler] Done: {} compiled, {} up-to-date, {} failed",
+                    result.compiled, result.skipped, result.failed);
+    return result;
+}
+
+} // namespace Assets
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "EngineExport.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Assets {
+
+enum class ShaderTarget : uint8_t {
+    SPIRV,   // vulkan/*.spv, glsl_450
+    DXIL     // d3d12/*.dxil, sm_6_0 (needs dxcompiler next to the Slang library)
+};
+
+enum class ShaderStage : uint8_t {
+    Vertex,
+    Fragment,
+    Compute
+};
+
+// One compiled output: a single entry point of a single source for a single target
+// with a fixed set of defines.
+struct ShaderPermutation {
+    std::string source;                // Relative to ShaderBuildConfig::source_dir, e.g. "basic.slang"
+    std::string entry_point;
+    ShaderStage stage = ShaderStage::Vertex;
+    ShaderTarget target = ShaderTarget::SPIRV;
+    std::vector<std::string> defines;  // "NAME" or "NAME=VALUE"
+    std::string output;                // Relative to ShaderBuildConfig::output_root
+};
+
+struct ShaderBuildConfig {
+    std::string source_dir  = "assets/shaders/slang";
+    std::string output_root = "assets/shaders/compiled";
+    bool build_spirv = true;
+    bool build_dxil  = true;
+    bool incremental = true;
+    bool parallel    = true;
+};
+
+struct ShaderBuildResult {
+    int total    = 0;
+    int compiled = 0;
+    int skipped  = 0;
+    int failed   = 0;
+    std::vector<std::string> compiled_outputs;
+    std::vector<std::string> errors;
+};
+
+// What a backend produces for one permutation. dependencies lists every file the
+// result was built from (the source plus everything it imports or includes).
+struct ShaderCompileOutput {
+    std::vector<uint8_t> code;
+    std::vector<std::string> dependencies;
+    std::string diagnostics;
+};
+
+using ShaderCompileFunction = std::function<bool(
+    const ShaderPermutation& permutation,
+    const ShaderBuildConfig& config,
+    ShaderCompileOutput& output)>;
+
+// Incremental shader builds. Every output remembers a key (source, entry point, stage,
+// target, defines) and the content hash of each file it depended on last time, in
+// <output_root>/shader_cache.txt. An output is rebuilt only when its key changed, a
+// dependency changed, or the file is missing. Stale permutations compile in parallel
+// on the JobSystem.
+class ENGINE_API ShaderCompiler {
+public:
+    // The engine's runtime shaders (what compile_shaders_slang.sh used to build),
+    // filtered by config.build_spirv / config.build_dxil
+    static std::vector<ShaderPermutation> getEnginePermutations(const ShaderBuildConfig& config);
+
+    // Builds the stale permutations. compile defaults to compileWithSlang.
+    static ShaderBuildResult build(
+        const std::vector<ShaderPermutation>& permutations,
+        const ShaderBuildConfig& config,
+        ShaderCompileFunction compile = nullptr);
+
+    // In-process Slang compilation. The Slang shared library is loaded on first use
+    // from Tools/slang-<version>/ or the system library path.
+    static bool compileWithSlang(
+        const ShaderPermutation& permutation,
+        const ShaderBuildConfig& config,
+        ShaderCompileOutput& output);
+    static bool isSlangAvailable();
+
+    static std::string getCachePath(const ShaderBuildConfig& config);
+};
+
+} // namespace Assets
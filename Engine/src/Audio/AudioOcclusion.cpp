@@ -0,0 +1,219 @@
+#include "AudioOcclusion.hpp"
+#include "Threading/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int RAYS_PER_VOICE = 3;
+    // Never-tested voices outrank any refresh
+    constexpr float FIRST_QUERY_STALENESS = 1000.0f;
+}
+
+struct AudioOcclusion::Batch
+{
+    BatchQueryFn fn;
+    std::vector<uint32_t> ids;
+    std::vector<glm::vec3> from;
+    std::vector<glm::vec3> to;
+    std::vector<uint8_t> blocked;
+    Threading::JobHandle job = Threading::INVALID_JOB_HANDLE;
+
+    void run()
+    {
+        fn(from.data(), to.data(), from.size(), blocked.data());
+    }
+};
+
+AudioOcclusion::AudioOcclusion() = default;
+
+AudioOcclusion::~AudioOcclusion()
+{
+    collect();
+}
+
+void AudioOcclusion::setQuery(BatchQueryFn fn)
+{
+    collect();
+    query = std::move(fn);
+}
+
+void AudioOcclusion::clear()
+{
+    collect();
+    states.clear();
+}
+
+void AudioOcclusion::flush()
+{
+    collect();
+}
+
+const AudioOcclusionState* AudioOcclusion::getState(uint32_t id) const
+{
+    auto it = states.find(id);
+    return it != states.end() ? &it->second.state : nullptr;
+}
+
+float AudioOcclusion::occlusionFromRays(bool direct_blocked, int side_paths_blocked)
+{
+    return (static_cast<float>(direct_blocked ? 2 : 0) + static_cast<float>(side_paths_blocked)) / 4.0f;
+}
+
+void AudioOcclusion::collect()
+{
+    if (!pending)
+        return;
+
+    if (pending->job != Threading::INVALID_JOB_HANDLE)
+        Threading::JobSystem::get().waitForJob(pending->job);
+
+    for (size_t i = 0; i < pending->ids.size(); ++i)
+    {
+        auto it = states.find(pending->ids[i]);
+        if (it == states.end())
+            continue;  // Voice stopped while the batch was running
+
+        const uint8_t* blocked = &pending->blocked[i * RAYS_PER_VOICE];
+        AudioOcclusionState& state = it->second.state;
+        state.target = occlusionFromRays(blocked[0] != 0, (blocked[1] != 0) + (blocked[2] != 0));
+        state.since_query = 0.0f;
+        state.has_result = true;
+        state.in_flight = false;
+        stats.results_applied++;
+    }
+
+    pending.reset();
+}
+
+void AudioOcclusion::kick(const glm::vec3& listener, const std::vector<AudioOcclusionVoice>& voices)
+{
+    ranked.clear();
+    for (size_t i = 0; i < voices.size(); ++i)
+    {
+        const AudioOcclusionVoice& voice = voices[i];
+        const float distance = glm::length(voice.position - listener);
+        if (distance > voice.max_distance)
+            continue;
+
+        stats.voices_considered++;
+        const AudioOcclusionState& state = states[voice.id].state;
+        if (state.in_flight || (state.has_result && state.since_query < settings.min_refresh_interval))
+            continue;
+
+        // Near, important and stale voices first
+        const float staleness = state.has_result ? state.since_query : FIRST_QUERY_STALENESS;
+        ranked.emplace_back(voice.priority * staleness / std::max(distance, 1.0f), i);
+    }
+
+    const size_t budget = static_cast<size_t>(std::max(settings.max_voices_per_frame, 0));
+    const size_t count = std::min(budget, ranked.size());
+    if (count == 0)
+        return;
+
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    auto batch = std::make_unique<Batch>();
+    batch->fn = query;
+    batch->ids.reserve(count);
+    batch->from.reserve(count * RAYS_PER_VOICE);
+    batch->to.reserve(count * RAYS_PER_VOICE);
+    batch->blocked.assign(count * RAYS_PER_VOICE, 0);
+
+    for (size_t r = 0; r < count; ++r)
+    {
+        const AudioOcclusionVoice& voice = voices[ranked[r].second];
+        glm::vec3 dir = voice.position - listener;
+        const float length = glm::length(dir);
+        dir = length > 1e-4f ? dir / length : glm::vec3(0.0f, 0.0f, -1.0f);
+
+        glm::vec3 side = glm::cross(dir, glm::vec3(0.0f, 1.0f, 0.0f));
+        if (glm::dot(side, side) < 1e-6f)
+            side = glm::vec3(1.0f, 0.0f, 0.0f);
+        side = glm::normalize(side) * settings.lateral_offset;
+
+        const glm::vec3 targets[RAYS_PER_VOICE] = { voice.position, voice.position + side, voice.position - side };
+        for (const glm::vec3& target : targets)
+        {
+            const glm::vec3 path = target - listener;
+            const float path_length = glm::length(path);
+            const float end = std::max(path_length - settings.end_offset, 0.0f);
+            batch->from.push_back(listener);
+            batch->to.push_back(path_length > 1e-4f ? listener + path * (end / path_length) : listener);
+        }
+
+        batch->ids.push_back(voice.id);
+        states[voice.id].state.in_flight = true;
+    }
+
+    stats.voices_queried = static_cast<uint32_t>(count);
+    stats.rays_cast = static_cast<uint32_t>(batch->from.size());
+    stats.total_rays += batch->from.size();
+
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    if (settings.async && jobs.isInitialized())
+    {
+        Batch* raw = batch.get();
+        batch->job = jobs.createJob()
+            .setName("AudioOcclusion")
+            .setWork([raw]() { raw->run(); })
+            .setPriority(Threading::JobPriority::Normal)
+            .setContext(Threading::JobContext::Worker)
+            .submit();
+    }
+    else
+    {
+        batch->run();
+    }
+
+    pending = std::move(batch);
+}
+
+void AudioOcclusion::applyTarget(AudioOcclusionState& state, float dt) const
+{
+    const float alpha = settings.smoothing_time > 0.0f ? 1.0f - std::exp(-dt / settings.smoothing_time) : 1.0f;
+    state.occlusion += (state.target - state.occlusion) * alpha;
+    state.gain = 1.0f - state.occlusion * (1.0f - settings.occluded_gain);
+
+    // Interpolate the cutoff in log space so the sweep sounds even
+    const float max_cutoff = std::max(settings.max_cutoff_hz, 1.0f);
+    const float min_cutoff = std::clamp(settings.min_cutoff_hz, 1.0f, max_cutoff);
+    state.cutoff_hz = max_cutoff * std::pow(min_cutoff / max_cutoff, state.occlusion);
+}
+
+void AudioOcclusion::update(const glm::vec3& listener, const std::vector<AudioOcclusionVoice>& voices, float delta_time)
+{
+    stats.voices_considered = 0;
+    stats.voices_queried = 0;
+    stats.rays_cast = 0;
+    stats.results_applied = 0;
+
+    // The previous batch normally finished during the last frame
+    collect();
+
+    // Forget voices that are no longer playing
+    update_index++;
+    for (const AudioOcclusionVoice& voice : voices)
+        states[voice.id].last_seen = update_index;
+    for (auto it = states.begin(); it != states.end(); )
+    {
+        if (it->second.last_seen != update_index)
+            it = states.erase(it);
+        else
+            (it++)->second.state.since_query += delta_time;
+    }
+
+    if (settings.enabled && query)
+    {
+        kick(listener, voices);
+    }
+    else
+    {
+        for (const AudioOcclusionVoice& voice : voices)
+            states[voice.id].state.target = 0.0f;
+    }
+
+    for (auto& [id, entry] : states)
+        applyTarget(entry.state, delta_time);
+}
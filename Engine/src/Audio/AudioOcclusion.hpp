@@ -0,0 +1,122 @@
+#pragma once
+
+#include "EngineExport.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct AudioOcclusionSettings
+{
+    bool enabled = true;
+    int max_voices_per_frame = 16;      // Query budget: voices re-tested per update
+    float min_refresh_interval = 0.05f; // Never re-test a voice more often than this (seconds)
+    float lateral_offset = 1.0f;        // Side paths for obstruction, metres either side of the source
+    float end_offset = 0.25f;           // Ray stops short of the source so its own collider does not count
+    float smoothing_time = 0.12f;       // Time constant for gain / cutoff changes (seconds)
+    float occluded_gain = 0.35f;        // Gain when every path is blocked
+    float min_cutoff_hz = 800.0f;       // Low-pass cutoff when every path is blocked
+    float max_cutoff_hz = 20000.0f;     // Low-pass cutoff when clear (effectively bypassed)
+    bool async = true;                  // Run batches on a JobSystem worker when one is available
+};
+
+// Per-voice input for one update
+struct AudioOcclusionVoice
+{
+    uint32_t id = 0;
+    glm::vec3 position{0.0f};
+    float max_distance = 50.0f;  // Beyond this the voice is inaudible and not queried
+    float priority = 1.0f;       // Relative importance (e.g. dialogue > footsteps)
+};
+
+struct AudioOcclusionState
+{
+    float target = 0.0f;        // Occlusion from the last query: 0 = clear, 1 = fully occluded
+    float occlusion = 0.0f;     // Smoothed toward target
+    float gain = 1.0f;          // Derived from the smoothed occlusion
+    float cutoff_hz = 20000.0f;
+    float since_query = 0.0f;   // Seconds since the last result arrived
+    bool has_result = false;
+    bool in_flight = false;
+};
+
+struct AudioOcclusionStats
+{
+    uint32_t voices_considered = 0;  // Audible voices this update
+    uint32_t voices_queried = 0;     // Voices included in the batch kicked this update
+    uint32_t rays_cast = 0;          // Rays in that batch (3 per voice)
+    uint32_t results_applied = 0;    // Voices updated from the previous batch
+    uint64_t total_rays = 0;
+};
+
+// Line-of-sight occlusion and obstruction for spatial voices.
+//
+// Each voice is tested with three rays from the listener: the direct path,
+// and two paths to points offset sideways from the source. Direct blocked
+// with a side path open is obstruction (mild low-pass); everything blocked
+// is occlusion (heavy low-pass and gain cut).
+//
+// Queries are amortized: each update picks at most max_voices_per_frame
+// voices, ranked by priority / distance scaled by how long since they were
+// last tested, and casts their rays as one batch. The batch runs on a
+// worker while the frame continues and is collected by the next update, so
+// results are one update old. Values are smoothed so a door closing fades
+// rather than clicks.
+class ENGINE_API AudioOcclusion
+{
+public:
+    // out_blocked[i] = 1 if anything lies between from[i] and to[i].
+    // Called on a worker thread when async is enabled.
+    using BatchQueryFn = std::function<void(const glm::vec3* from, const glm::vec3* to, size_t count, uint8_t* out_blocked)>;
+
+    AudioOcclusion();
+    ~AudioOcclusion();
+
+    // Waits for any batch in flight before swapping (the old query's world may be going away)
+    void setQuery(BatchQueryFn fn);
+    bool hasQuery() const { return static_cast<bool>(query); }
+
+    void setSettings(const AudioOcclusionSettings& new_settings) { settings = new_settings; }
+    const AudioOcclusionSettings& getSettings() const { return settings; }
+
+    // Collect the previous batch, schedule and kick the next one, smooth all states.
+    // Voices missing from `voices` are forgotten.
+    void update(const glm::vec3& listener, const std::vector<AudioOcclusionVoice>& voices, float delta_time);
+
+    // Block until the in-flight batch (if any) has finished and apply it
+    void flush();
+
+    void removeVoice(uint32_t id) { states.erase(id); }
+    void clear();
+
+    const AudioOcclusionState* getState(uint32_t id) const;
+    const AudioOcclusionStats& getStats() const { return stats; }
+
+    // Occlusion for a ray pattern: direct path counts double, each side path once
+    static float occlusionFromRays(bool direct_blocked, int side_paths_blocked);
+
+private:
+    struct Batch;
+
+    struct Entry
+    {
+        AudioOcclusionState state;
+        uint64_t last_seen = 0;  // update_index when the voice was last passed in
+    };
+
+    void collect();
+    void kick(const glm::vec3& listener, const std::vector<AudioOcclusionVoice>& voices);
+    void applyTarget(AudioOcclusionState& state, float dt) const;
+
+    BatchQueryFn query;
+    AudioOcclusionSettings settings;
+    std::unordered_map<uint32_t, Entry> states;
+    uint64_t update_index = 0;
+    std::unique_ptr<Batch> pending;
+    AudioOcclusionStats stats;
+
+    // Scratch reused each update
+    std::vector<std::pair<float, size_t>> ranked;
+};
@@ -3,8 +3,18 @@
 
 #include "AudioSystem.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    constexpr ma_uint32 OCCLUSION_FILTER_ORDER = 2;
+    // Skip filter reinit for cutoff changes smaller than this (relative)
+    constexpr float CUTOFF_EPSILON = 0.01f;
+}
 
 struct AudioSystem::AudioClip
 {
@@ -22,6 +32,14 @@ struct AudioSystem::ActiveSound
     AudioGroup group = AudioGroup::SFX;
     bool spatial = false;
     bool active = false;
+
+    // Occlusion filter between the sound and the engine endpoint (spatial sounds only)
+    ma_lpf_node filter;
+    bool has_filter = false;
+    float filter_cutoff = 0.0f;
+    glm::vec3 position{0.0f};
+    float max_distance = 50.0f;
+    float occlusion_priority = 1.0f;
 };
 
 struct AudioSystem::Impl
@@ -30,10 +48,72 @@ struct AudioSystem::Impl
     bool engine_initialized = false;
 
     std::unordered_map<AudioClipId, AudioClip> clips;
-    std::vector<ActiveSound> sounds;
+    // Heap-allocated: ma_sound and ma_lpf_node are referenced by the node graph and must not move
+    std::vector<std::unique_ptr<ActiveSound>> sounds;
 
     // Keep track of loaded ma_sound objects for resource management
     ma_resource_manager_config resource_config;
+
+    AudioOcclusion occlusion;
+    std::vector<AudioOcclusionVoice> occlusion_voices;
+    glm::vec3 listener_position{0.0f};
+    std::chrono::steady_clock::time_point last_update{};
+
+    void release(ActiveSound& sound)
+    {
+        if (!sound.active)
+            return;
+        ma_sound_stop(&sound.sound);
+        ma_sound_uninit(&sound.sound);
+        if (sound.has_filter)
+        {
+            ma_lpf_node_uninit(&sound.filter, nullptr);
+            sound.has_filter = false;
+        }
+        occlusion.removeVoice(sound.handle);
+        sound.active = false;
+    }
+
+    ActiveSound* find(SoundHandle handle) const
+    {
+        for (const auto& sound : sounds)
+        {
+            if (sound->handle == handle && sound->active)
+                return sound.get();
+        }
+        return nullptr;
+    }
+
+    // Route the sound through a low-pass node so occlusion can filter and attenuate it
+    bool attachOcclusionFilter(ActiveSound& sound, float cutoff_hz)
+    {
+        const ma_uint32 channels = ma_engine_get_channels(&engine);
+        const ma_uint32 sample_rate = ma_engine_get_sample_rate(&engine);
+        ma_lpf_node_config config = ma_lpf_node_config_init(channels, sample_rate, cutoff_hz, OCCLUSION_FILTER_ORDER);
+        if (ma_lpf_node_init(ma_engine_get_node_graph(&engine), &config, nullptr, &sound.filter) != MA_SUCCESS)
+            return false;
+
+        ma_node_attach_output_bus(&sound.filter, 0, ma_engine_get_endpoint(&engine), 0);
+        ma_node_attach_output_bus(&sound.sound, 0, &sound.filter, 0);
+        sound.has_filter = true;
+        sound.filter_cutoff = cutoff_hz;
+        return true;
+    }
+
+    void applyOcclusion(ActiveSound& sound, const AudioOcclusionState& state)
+    {
+        // The filter can't pass above Nyquist
+        const float nyquist = static_cast<float>(ma_engine_get_sample_rate(&engine)) * 0.5f;
+        const float cutoff = std::min(state.cutoff_hz, nyquist * 0.95f);
+        if (std::abs(cutoff - sound.filter_cutoff) > sound.filter_cutoff * CUTOFF_EPSILON)
+        {
+            ma_lpf_config config = ma_lpf_config_init(ma_format_f32, ma_engine_get_channels(&engine),
+                ma_engine_get_sample_rate(&engine), cutoff, OCCLUSION_FILTER_ORDER);
+            if (ma_lpf_node_reinit(&config, &sound.filter) == MA_SUCCESS)
+                sound.filter_cutoff = cutoff;
+        }
+        ma_node_set_output_bus_volume(&sound.filter, 0, state.gain);
+    }
 };
 
 AudioSystem::AudioSystem()
@@ -49,7 +129,7 @@ AudioSystem::~AudioSystem()
     }
 }
 
-bool AudioSystem::initialize()
+bool AudioSystem::initialize(const AudioSystemConfig& system_config)
 {
     if (initialized) return true;
 
@@ -57,6 +137,7 @@ bool AudioSystem::initialize()
     config.channels = 2;
     config.sampleRate = 44100;
     config.listenerCount = 1;
+    config.noDevice = system_config.null_device ? MA_TRUE : MA_FALSE;
 
     ma_result result = ma_engine_init(&config, &impl->engine);
     if (result != MA_SUCCESS)
@@ -66,9 +147,10 @@ bool AudioSystem::initialize()
     }
 
     impl->engine_initialized = true;
+    impl->last_update = std::chrono::steady_clock::now();
     initialized = true;
 
-    LOG_ENGINE_INFO("Audio system initialized (miniaudio)");
+    LOG_ENGINE_INFO("Audio system initialized (miniaudio{})", system_config.null_device ? ", no device" : "");
     return true;
 }
 
@@ -77,14 +159,9 @@ void AudioSystem::shutdown()
     if (!initialized) return;
 
     // Stop and uninit all active sounds
+    impl->occlusion.clear();
     for (auto& sound : impl->sounds)
-    {
-        if (sound.active)
-        {
-            ma_sound_uninit(&sound.sound);
-            sound.active = false;
-        }
-    }
+        impl->release(*sound);
     impl->sounds.clear();
 
     // Unload all clips
@@ -130,11 +207,8 @@ void AudioSystem::unloadClip(AudioClipId id)
     // Stop any sounds using this clip
     for (auto& sound : impl->sounds)
     {
-        if (sound.active && sound.clip_id == id)
-        {
-            ma_sound_uninit(&sound.sound);
-            sound.active = false;
-        }
+        if (sound->active && sound->clip_id == id)
+            impl->release(*sound);
     }
 
     impl->clips.erase(id);
@@ -155,7 +229,8 @@ SoundHandle AudioSystem::playSound(AudioClipId clip_id, const PlayParams& params
 
     SoundHandle handle = next_sound_id++;
 
-    ActiveSound active;
+    auto active_ptr = std::make_unique<ActiveSound>();
+    ActiveSound& active = *active_ptr;
     active.handle = handle;
     active.clip_id = clip_id;
     active.group = params.group;
@@ -187,7 +262,7 @@ SoundHandle AudioSystem::playSound(AudioClipId clip_id, const PlayParams& params
     ma_sound_start(&active.sound);
     active.active = true;
 
-    impl->sounds.push_back(std::move(active));
+    impl->sounds.push_back(std::move(active_ptr));
     return handle;
 }
 
@@ -200,11 +275,15 @@ SoundHandle AudioSystem::playSound3D(AudioClipId clip_id, const glm::vec3& posit
 
     SoundHandle handle = next_sound_id++;
 
-    ActiveSound active;
+    auto active_ptr = std::make_unique<ActiveSound>();
+    ActiveSound& active = *active_ptr;
     active.handle = handle;
     active.clip_id = clip_id;
     active.group = params.group;
     active.spatial = true;
+    active.position = position;
+    active.max_distance = params.max_distance;
+    active.occlusion_priority = params.occlusion_priority;
 
     ma_result result = ma_sound_init_from_file(
         &impl->engine,
@@ -233,57 +312,50 @@ SoundHandle AudioSystem::playSound3D(AudioClipId clip_id, const glm::vec3& posit
     ma_sound_set_max_distance(&active.sound, params.max_distance);
     ma_sound_set_attenuation_model(&active.sound, ma_attenuation_model_inverse);
 
+    if (params.occlusion && !impl->attachOcclusionFilter(active, impl->occlusion.getSettings().max_cutoff_hz))
+        LOG_ENGINE_WARN("Failed to create occlusion filter for '{}', playing unfiltered", it->second.path);
+
     ma_sound_start(&active.sound);
     active.active = true;
 
-    impl->sounds.push_back(std::move(active));
+    impl->sounds.push_back(std::move(active_ptr));
     return handle;
 }
 
 void AudioSystem::stopSound(SoundHandle handle)
 {
-    for (auto& sound : impl->sounds)
-    {
-        if (sound.handle == handle && sound.active)
-        {
-            ma_sound_stop(&sound.sound);
-            ma_sound_uninit(&sound.sound);
-            sound.active = false;
-            return;
-        }
-    }
+    if (ActiveSound* sound = impl->find(handle))
+        impl->release(*sound);
 }
 
 void AudioSystem::stopAllSounds()
 {
     for (auto& sound : impl->sounds)
-    {
-        if (sound.active)
-        {
-            ma_sound_stop(&sound.sound);
-            ma_sound_uninit(&sound.sound);
-            sound.active = false;
-        }
-    }
+        impl->release(*sound);
     impl->sounds.clear();
 }
 
 bool AudioSystem::isSoundPlaying(SoundHandle handle) const
 {
-    for (const auto& sound : impl->sounds)
-    {
-        if (sound.handle == handle && sound.active)
-        {
-            return ma_sound_is_playing(&sound.sound);
-        }
-    }
-    return false;
+    const ActiveSound* sound = impl->find(handle);
+    return sound && ma_sound_is_playing(&sound->sound);
+}
+
+void AudioSystem::setSoundPosition(SoundHandle handle, const glm::vec3& position)
+{
+    ActiveSound* sound = impl->find(handle);
+    if (!sound || !sound->spatial)
+        return;
+
+    sound->position = position;
+    ma_sound_set_position(&sound->sound, position.x, position.y, position.z);
 }
 
 void AudioSystem::setListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up)
 {
     if (!initialized) return;
 
+    impl->listener_position = position;
     ma_engine_listener_set_position(&impl->engine, 0, position.x, position.y, position.z);
     ma_engine_listener_set_direction(&impl->engine, 0, forward.x, forward.y, forward.z);
     ma_engine_listener_set_world_up(&impl->engine, 0, up.x, up.y, up.z);
@@ -308,20 +380,66 @@ float AudioSystem::getGroupVolume(AudioGroup group) const
     return group_volumes[static_cast<int>(group)];
 }
 
+void AudioSystem::setOcclusionQuery(AudioOcclusion::BatchQueryFn query)
+{
+    impl->occlusion.setQuery(std::move(query));
+}
+
+void AudioSystem::setOcclusionSettings(const AudioOcclusionSettings& settings)
+{
+    impl->occlusion.setSettings(settings);
+}
+
+const AudioOcclusionSettings& AudioSystem::getOcclusionSettings() const
+{
+    return impl->occlusion.getSettings();
+}
+
+const AudioOcclusionStats& AudioSystem::getOcclusionStats() const
+{
+    return impl->occlusion.getStats();
+}
+
+bool AudioSystem::getSoundOcclusion(SoundHandle handle, AudioOcclusionState& out_state) const
+{
+    const AudioOcclusionState* state = impl->occlusion.getState(handle);
+    if (!state)
+        return false;
+    out_state = *state;
+    return true;
+}
+
+float AudioSystem::getSoundOcclusionGain(SoundHandle handle) const
+{
+    const ActiveSound* sound = impl->find(handle);
+    if (!sound || !sound->has_filter)
+        return 1.0f;
+    return ma_node_get_output_bus_volume(&sound->filter, 0);
+}
+
 void AudioSystem::update()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const float delta_time = std::chrono::duration<float>(now - impl->last_update).count();
+    update(std::min(delta_time, 0.25f));
+}
+
+void AudioSystem::update(float delta_time)
 {
     if (!initialized) return;
+    MemoryTagScope memory_tag(MemoryTag::Audio);
+    impl->last_update = std::chrono::steady_clock::now();
 
     // Clean up finished (non-looping) sounds
     for (auto it = impl->sounds.begin(); it != impl->sounds.end(); )
     {
-        if (it->active && !ma_sound_is_playing(&it->sound) && !ma_sound_is_looping(&it->sound))
+        ActiveSound& sound = **it;
+        if (sound.active && !ma_sound_is_playing(&sound.sound) && !ma_sound_is_looping(&sound.sound))
         {
-            ma_sound_uninit(&it->sound);
-            it->active = false;
+            impl->release(sound);
             it = impl->sounds.erase(it);
         }
-        else if (!it->active)
+        else if (!sound.active)
         {
             it = impl->sounds.erase(it);
         }
@@ -330,4 +448,27 @@ void AudioSystem::update()
             ++it;
         }
     }
+
+    // Occlusion for filtered spatial sounds
+    impl->occlusion_voices.clear();
+    for (const auto& sound : impl->sounds)
+    {
+        if (!sound->has_filter)
+            continue;
+        AudioOcclusionVoice voice;
+        voice.id = sound->handle;
+        voice.position = sound->position;
+        voice.max_distance = sound->max_distance;
+        voice.priority = sound->occlusion_priority;
+        impl->occlusion_voices.push_back(voice);
+    }
+    impl->occlusion.update(impl->listener_position, impl->occlusion_voices, delta_time);
+
+    for (const auto& sound : impl->sounds)
+    {
+        if (!sound->has_filter)
+            continue;
+        if (const AudioOcclusionState* state = impl->occlusion.getState(sound->handle))
+            impl->applyOcclusion(*sound, *state);
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineExport.h"
+#include "Audio/AudioOcclusion.hpp"
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
@@ -40,6 +41,14 @@ struct Play3DParams
     AudioGroup group = AudioGroup::SFX;
     float min_distance = 1.0f;
     float max_distance = 50.0f;
+    bool occlusion = true;          // Line-of-sight low-pass / gain (needs an occlusion query)
+    float occlusion_priority = 1.0f; // Relative weight when the query budget is contended
+};
+
+struct AudioSystemConfig
+{
+    // Run the engine without an output device; used by headless servers and tests
+    bool null_device = false;
 };
 
 class ENGINE_API AudioSystem
@@ -52,7 +61,7 @@ public:
     }
 
     // Lifecycle
-    bool initialize();
+    bool initialize(const AudioSystemConfig& config = {});
     void shutdown();
 
     // Clip management
@@ -70,6 +79,7 @@ public:
     void stopSound(SoundHandle handle);
     void stopAllSounds();
     bool isSoundPlaying(SoundHandle handle) const;
+    void setSoundPosition(SoundHandle handle, const glm::vec3& position);
 
     // Listener (typically the camera/player)
     void setListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up);
@@ -80,8 +90,19 @@ public:
     void setGroupVolume(AudioGroup group, float volume);
     float getGroupVolume(AudioGroup group) const;
 
-    // Call each frame to update 3D positions and clean up finished sounds
+    // Occlusion: the query casts batched line-of-sight rays (see AudioOcclusion).
+    // Without a query, spatial sounds play unfiltered.
+    void setOcclusionQuery(AudioOcclusion::BatchQueryFn query);
+    void setOcclusionSettings(const AudioOcclusionSettings& settings);
+    const AudioOcclusionSettings& getOcclusionSettings() const;
+    const AudioOcclusionStats& getOcclusionStats() const;
+    bool getSoundOcclusion(SoundHandle handle, AudioOcclusionState& out_state) const;
+    // Gain currently applied by the sound's occlusion filter (1 when unfiltered)
+    float getSoundOcclusionGain(SoundHandle handle) const;
+
+    // Call each frame to update occlusion and clean up finished sounds
     void update();
+    void update(float delta_time);
 
     bool isInitialized() const { return initialized; }
 
@@ -319,7 +319,7 @@ JPH::BodyID CharacterControllerSystem::create(entt::registry& registry,
     settings->mCharacterPadding = controller.character_padding;
     settings->mCollisionTolerance = controller.collision_tolerance;
     settings->mEnhancedInternalEdgeRemoval = controller.enhanced_internal_edge_removal;
-    settings->mInnerBodyLayer = layer_settings.dynamic_body;
+    settings->mInnerBodyLayer = layer_settings.character_body;
     if (controller.use_inner_body)
         settings->mInnerBodyShape = shape;
 
@@ -473,8 +473,8 @@ bool CharacterControllerSystem::refresh(entt::registry& registry,
     JPH::BodyFilter body_filter;
     JPH::ShapeFilter shape_filter;
     character.RefreshContacts(
-        physics_system.GetDefaultBroadPhaseLayerFilter(layer_settings.dynamic_body),
-        physics_system.GetDefaultLayerFilter(layer_settings.dynamic_body),
+        physics_system.GetDefaultBroadPhaseLayerFilter(layer_settings.character_body),
+        physics_system.GetDefaultLayerFilter(layer_settings.character_body),
         body_filter,
         shape_filter,
         temp_allocator);
@@ -557,8 +557,8 @@ CharacterControllerState CharacterControllerSystem::simulate(entt::registry& reg
             ? JPH::Vec3::sZero()
             : toJolt(settings.gravity_direction * settings.gravity_acceleration * controller.gravity_scale),
         update_settings,
-        physics_system.GetDefaultBroadPhaseLayerFilter(settings.layers.dynamic_body),
-        physics_system.GetDefaultLayerFilter(settings.layers.dynamic_body),
+        physics_system.GetDefaultBroadPhaseLayerFilter(settings.layers.character_body),
+        physics_system.GetDefaultLayerFilter(settings.layers.character_body),
         body_filter,
         shape_filter,
         temp_allocator);
@@ -12,6 +12,15 @@
 #include "Reflection/Reflector.hpp"
 #include <algorithm>
 
+inline glm::mat4 composeTransformMatrix(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
+    glm::mat4 scale_matrix = glm::scale(glm::mat4(1.0f), scale);
+    glm::mat4 rotation_matrix = glm::eulerAngleYXZ(
+        glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
+    glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position);
+
+    return translation_matrix * rotation_matrix * scale_matrix;
+}
+
 struct TransformComponent {
     glm::vec3 position;
     glm::vec3 rotation;
@@ -20,12 +29,7 @@ struct TransformComponent {
     TransformComponent(float x=0, float y=0, float z=0) : position(x,y,z), rotation(0,0,0), scale(1,1,1) {}
 
     glm::mat4 getTransformMatrix() const {
-        glm::mat4 scale_matrix = glm::scale(glm::mat4(1.0f), scale);
-        glm::mat4 rotation_matrix = glm::eulerAngleYXZ(
-            glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
-        glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position);
-
-        return translation_matrix * rotation_matrix * scale_matrix;
+        return composeTransformMatrix(position, rotation, scale);
     }
 
     static void reflect(Reflector<TransformComponent>& r) {
@@ -39,6 +43,47 @@ struct TransformComponent {
     }
 };
 
+// Transform relative to the parent entity. On parented entities this is the authored
+// value and TransformComponent is overwritten with the propagated world result.
+struct LocalTransformComponent {
+    glm::vec3 position{0.0f};
+    glm::vec3 rotation{0.0f};
+    glm::vec3 scale{1.0f};
+
+    glm::mat4 getTransformMatrix() const {
+        return composeTransformMatrix(position, rotation, scale);
+    }
+
+    static void reflect(Reflector<LocalTransformComponent>& r) {
+        r.display("Local Transform").category("Core");
+        r.field<&LocalTransformComponent::position>("position")
+            .tooltip("Position relative to the parent").drag(0.01f).category("Transform");
+        r.field<&LocalTransformComponent::rotation>("rotation")
+            .tooltip("Euler rotation relative to the parent (degrees)").drag(0.5f).category("Transform");
+        r.field<&LocalTransformComponent::scale>("scale")
+            .tooltip("Scale relative to the parent").drag(0.01f).range(0.001f, 1000.0f).category("Transform");
+    }
+};
+
+// Parent/child links, maintained by TransformHierarchy::setParent (Scene/TransformHierarchy.hpp).
+// Set dirty after changing a transform outside the usual per-frame writes to force the
+// subtree to propagate even if the values compare equal.
+struct HierarchyComponent {
+    entt::entity parent = entt::null;
+    entt::entity first_child = entt::null;
+    entt::entity next_sibling = entt::null;
+    entt::entity prev_sibling = entt::null;
+    uint32_t depth = 0;
+    bool dirty = true;
+
+    // Only the parent is authored; sibling links and depth are rebuilt from it
+    static void reflect(Reflector<HierarchyComponent>& r) {
+        r.display("Hierarchy").category("Core");
+        r.field<&HierarchyComponent::parent>("parent")
+            .tooltip("Parent entity; the local transform is relative to it").category("Hierarchy");
+    }
+};
+
 struct TagComponent {
     std::string name;
 
@@ -199,6 +244,9 @@ struct ColliderComponent {
     float friction = 0.2f;
     float restitution = 0.0f;
 
+    // Project collision layer name. Empty uses the default layer for the body's motion type.
+    std::string collision_layer;
+
     bool is_mesh_valid() const
     {
         return m_mesh != nullptr && m_mesh->is_valid;
@@ -231,6 +279,8 @@ struct ColliderComponent {
             .tooltip("Surface friction").drag(0.01f).range(0.0f, 10.0f).category("Material");
         r.field<&ColliderComponent::restitution>("restitution")
             .tooltip("Bounciness").drag(0.01f).range(0.0f, 1.0f).category("Material");
+        r.field<&ColliderComponent::collision_layer>("collision_layer")
+            .tooltip("Collision layer from the project settings; empty picks Static or Dynamic").category("Filtering");
     }
 };
 
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Foliage/FoliageSystem.hpp"
+#include <vector>
+
+// Procedural foliage scattered over the entity's terrain or mesh surface. The instances live in
+// field, bucketed per cell, instead of as entities; the renderer culls the cells and draws each
+// visible one with a single instanced draw.
+struct FoliageComponent
+{
+    std::vector<FoliageLayer> layers;
+    float cell_size = 16.0f;                // Meters; smaller cells cull tighter but draw more often
+
+    // Runtime
+    FoliageField field;
+    bool dirty = true;                      // Set after editing layers to scatter again
+};
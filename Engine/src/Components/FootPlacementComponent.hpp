@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Animation/Skeleton.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class IKLod : uint8_t
+{
+    Full,       // Probe and solve every frame
+    Reduced,    // Probe and solve every few frames, reuse the corrections in between
+    Disabled    // Fade the last corrections out
+};
+
+struct FootPlacementLeg
+{
+    int thigh_bone = -1;
+    int shin_bone = -1;
+    int foot_bone = -1;
+    glm::vec3 pole_vector{0.0f, 0.0f, 1.0f};   // Model-space knee direction when the leg is straight
+
+    // Runtime: filled by FootPlacement::updateProbes and FootPlacement::apply
+    glm::vec3 probe_foot{0.0f};                // Model-space animated foot at the last solve
+    glm::vec3 ground_point{0.0f};              // World space
+    glm::vec3 ground_normal{0.0f, 1.0f, 0.0f};
+    bool grounded = false;
+    float offset = 0.0f;                       // Smoothed model-space height correction
+    glm::quat thigh_delta{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::quat shin_delta{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::quat foot_delta{1.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// Terrain-adaptive foot placement on top of the animated pose. Skeleton space is
+// assumed to be Y-up with the character's origin on the ground it was animated on.
+struct FootPlacementComponent
+{
+    std::vector<FootPlacementLeg> legs;
+    int pelvis_bone = -1;
+
+    float foot_height = 0.08f;       // Ankle height above the sole
+    float probe_height = 0.6f;       // Probes start this far above the animated foot
+    float probe_depth = 0.9f;        // and reach this far below it
+    float max_pelvis_drop = 0.45f;
+    float max_step_up = 0.45f;
+    float blend_speed = 15.0f;       // Smoothing of the corrections, per second
+    bool align_to_ground = true;
+    bool enabled = true;
+
+    // Runtime
+    IKLod lod = IKLod::Full;
+    bool solve_this_frame = true;
+    bool has_probe_points = false;
+    bool has_solution = false;
+    uint32_t lod_frame = 0;
+    float time_since_solve = 0.0f;
+    float weight = 0.0f;             // Ramps toward 1, or toward 0 while Disabled
+    float pelvis_offset = 0.0f;      // Model space
+    glm::vec3 pelvis_local_delta{0.0f};
+    glm::vec3 root_ground{0.0f};     // World space, under the character's origin
+    bool root_grounded = false;
+
+    // Convenience: add a leg (thigh -> shin -> foot)
+    void addLeg(const Skeleton& skeleton,
+                const std::string& thigh_name,
+                const std::string& shin_name,
+                const std::string& foot_name)
+    {
+        FootPlacementLeg leg;
+        leg.thigh_bone = skeleton.getBoneIndex(thigh_name);
+        leg.shin_bone = skeleton.getBoneIndex(shin_name);
+        leg.foot_bone = skeleton.getBoneIndex(foot_name);
+
+        if (leg.thigh_bone >= 0 && leg.shin_bone >= 0 && leg.foot_bone >= 0)
+        {
+            legs.push_back(leg);
+        }
+    }
+
+    void setPelvis(const Skeleton& skeleton, const std::string& pelvis_name)
+    {
+        pelvis_bone = skeleton.getBoneIndex(pelvis_name);
+    }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Particles/ParticleSystem.hpp"
+#include "mesh.hpp"
+#include <glm/glm.hpp>
+#include <memory>
+
+// CPU-simulated particles spawned at the entity's TransformComponent and simulated in world
+// space by ParticleSystem. Each particle is drawn as one instance of particle_mesh, unlit,
+// scaled from size_start to size_end over its lifetime.
+struct ParticleEmitterComponent
+{
+    ParticleEmitterSettings settings;
+    std::shared_ptr<mesh> particle_mesh;    // nullptr draws a unit quad
+    TextureHandle texture = INVALID_TEXTURE;
+    bool emitting = true;                   // Clearing it lets the live particles die out
+
+    // Runtime
+    ParticlePool pool;
+    ParticleLod lod = ParticleLod::Full;
+    bool throttled = false;                 // Spawning stopped by the CPU budget this frame
+    float spawn_accumulator = 0.0f;
+    float pending_dt = 0.0f;                // Time not yet simulated at reduced LOD
+    uint32_t frames_until_update = 0;
+    uint32_t random_state = 0;              // 0 until seeded from settings.seed
+    glm::vec3 bounds_min{0.0f};             // World-space bounds of the live particles
+    glm::vec3 bounds_max{0.0f};
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Animation/Pose.hpp"
+#include "Physics/RagdollSystem.hpp"
+#include <glm/glm.hpp>
+#include <memory>
+
+// Physics-driven pose for an entity with an AnimationComponent. Setting simulate hands the
+// skeleton to a Jolt ragdoll posed from the current animation; clearing it returns the
+// ragdoll to its profile's pool. Skeleton space is assumed to be unscaled.
+struct RagdollComponent
+{
+    std::shared_ptr<const RagdollProfile> profile;
+
+    bool simulate = false;
+    float motor_strength = 0.0f;      // 0 is limp, 1 drives toward the animation with the profile's torque
+    float blend_weight = 1.0f;        // Share of the simulated pose in the final pose
+    glm::vec3 initial_velocity{0.0f}; // Applied to every part when the ragdoll starts
+
+    // Runtime
+    RagdollLod lod = RagdollLod::Full;
+    bool awake = false;
+    bool has_physics_pose = false;
+    Pose animated_pose;               // Written by AnimationSystem, the motors' target
+    Pose physics_pose;                // Written by RagdollSystem after the step, local space
+    glm::mat4 pose_model_to_world{1.0f};
+};
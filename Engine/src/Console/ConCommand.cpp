@@ -1,7 +1,9 @@
 #include "ConCommand.hpp"
 #include "ConVar.hpp"
 #include "Console.hpp"
+#include "Assets/AssetCompiler.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include <algorithm>
 #include <sstream>
 #include <SDL3/SDL.h>
@@ -446,4 +448,50 @@ void CommandRegistry::registerBuiltinCommands()
         }
     }, 0, "Reset a cvar to its default value");
     m_commands["reset"] = &resetCmd;
+
+    // mem_report - Print per-subsystem heap usage
+    static ConCommand memReportCmd("mem_report", [](const CommandArgs&) {
+        std::istringstream report(MemoryTracker::formatReport());
+        std::string line;
+        while (std::getline(report, line))
+        {
+            Console::get().print("{}", line);
+        }
+    }, 0, "Print tagged memory usage per subsystem");
+    m_commands["mem_report"] = &memReportCmd;
+
+    // mem_dump <filename> - Write the memory report to a file
+    static ConCommand memDumpCmd("mem_dump", [](const CommandArgs& args) {
+        if (args.count() < 2)
+        {
+            Console::get().print("Usage: mem_dump <filename>");
+            return;
+        }
+        if (MemoryTracker::writeReport(args[1].c_str()))
+            Console::get().print("Memory report written to {}", args[1]);
+        else
+            Console::get().print("Failed to write memory report to {}", args[1]);
+    }, 0, "Write tagged memory usage to a file");
+    m_commands["mem_dump"] = &memDumpCmd;
+
+    // shaders_build [spirv|dxil|all] [force] - Rebuild stale shaders from assets/shaders/slang
+    static ConCommand shadersBuildCmd("shaders_build", [](const CommandArgs& args) {
+        Assets::ShaderBuildConfig config;
+        for (size_t i = 1; i < args.count(); ++i)
+        {
+            if (args[i] == "spirv")
+                config.build_dxil = false;
+            else if (args[i] == "dxil")
+                config.build_spirv = false;
+            else if (args[i] == "force")
+                config.incremental = false;
+        }
+
+        Assets::ShaderBuildResult result = Assets::AssetCompiler::compileShaders(config);
+        Console::get().print("Shaders: {} compiled, {} up-to-date, {} failed",
+                             result.compiled, result.skipped, result.failed);
+        for (const auto& error : result.errors)
+            Console::get().print("{}", error);
+    }, 0, "Compile stale shaders: shaders_build [spirv|dxil|all] [force]");
+    m_commands["shaders_build"] = &shadersBuildCmd;
 }
\ No newline at end of file
@@ -85,6 +85,19 @@ CONVAR(r_deferred, 0, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
        "Enable deferred rendering (opaque GBuffer + deferred lighting; transparents still forward). "
        "Supported on D3D12 and Vulkan.");
 
+CONVAR(r_dynres, 0, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Enable dynamic resolution: deferred scene passes render below full size to stay within "
+       "r_dynres_budget_ms of GPU time. Vulkan only.");
+
+CONVAR_BOUNDED(r_dynres_budget_ms, 16.6f, 1.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "GPU frame time budget for dynamic resolution, in milliseconds");
+
+CONVAR_BOUNDED(r_dynres_min_scale, 0.5f, 0.25f, 1.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Lowest dynamic resolution scale per axis");
+
+CONVAR_BOUNDED(r_dynres_scale, 0.0f, 0.0f, 1.0f, ConVarFlags::CLIENT_ONLY,
+               "Pin the dynamic resolution scale for testing, 0 lets the budget decide");
+
 CONVAR(r_multicore_rendering, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
        "Enable backend parallel command replay on supported render APIs");
 
@@ -114,6 +127,45 @@ CONVAR(r_vulkan_static_instancing, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT
 CONVAR_BOUNDED(fps_max, 60, 0, 1000, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
                "Maximum frame rate (0=unlimited)");
 
+CONVAR_BOUNDED(fps_pacing, 1, 0, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Frame pacing (0=sleep after present, 1=low latency: predict CPU/GPU time and sleep before input polling)");
+
+CONVAR(fps_late_latch, 0, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Apply mouse motion received during simulation to the render camera just before recording");
+
+CONVAR(snd_occlusion, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Low-pass and attenuate spatial sounds whose line of sight to the listener is blocked");
+
+CONVAR_BOUNDED(snd_occlusion_budget, 16, 0, 256, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Maximum sounds re-tested for occlusion per frame (3 rays each)");
+
+CONVAR(anim_foot_placement, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Plant character feet on uneven ground with leg IK");
+
+CONVAR_BOUNDED(anim_ik_lod_full, 15.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Characters within this camera distance solve foot IK every frame");
+
+CONVAR_BOUNDED(anim_ik_lod_reduced, 40.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Characters within this camera distance solve foot IK every anim_ik_reduced_interval frames, beyond it IK fades out");
+
+CONVAR_BOUNDED(anim_ik_reduced_interval, 4, 1, 30, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Frames between foot IK solves at reduced LOD");
+
+CONVAR_BOUNDED(phys_ragdoll_lod_full, 20.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Ragdolls within this camera distance are fully simulated with motors");
+
+CONVAR_BOUNDED(phys_ragdoll_lod_reduced, 60.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Ragdolls within this camera distance simulate limp and sleep early, beyond it they freeze");
+
+CONVAR_BOUNDED(fx_particle_budget_ms, 2.0f, 0.0f, 100.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "CPU milliseconds for particle simulation per frame; emitters past it stop spawning (0 = unlimited)");
+
+CONVAR_BOUNDED(fx_particle_lod_full, 30.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Particle emitters within this camera distance spawn and update every frame");
+
+CONVAR_BOUNDED(fx_particle_lod_reduced, 80.0f, 0.0f, 1000.0f, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+               "Particle emitters within this camera distance spawn less and update less often, beyond it they are culled");
+
 // Example cheat cvars
 CONVAR(god, 0, ConVarFlags::CHEAT | ConVarFlags::SERVER_ONLY,
        "God mode - invincibility");
@@ -147,6 +199,33 @@ CONVAR_BOUNDED(sv_maxunlag, 1.0f, 0.0f, 2.0f, ConVarFlags::SERVER_ONLY | ConVarF
 CONVAR(net_fullsnapshot_on_baseline_miss, 1, ConVarFlags::SERVER_ONLY,
        "Send a full network snapshot when a client's delta baseline is unavailable");
 
+CONVAR(sv_input_buffer, 1, ConVarFlags::SERVER_ONLY,
+       "Buffer client input and play back one command per tick, sized to measured arrival jitter");
+
+CONVAR_BOUNDED(sv_input_buffer_max, 6, 1, 32, ConVarFlags::SERVER_ONLY,
+               "Maximum input buffer depth in ticks");
+
+CONVAR(sv_bundle_messages, 1, ConVarFlags::SERVER_ONLY,
+       "Coalesce each client's queued and multicast messages into one packet per channel per tick");
+
+CONVAR(sv_physics_hash, 0, ConVarFlags::SERVER_ONLY,
+       "Hash physics state every tick and compare it with clients to catch simulation desyncs");
+
+CONVAR(sv_physics_lod, 0, ConVarFlags::SERVER_ONLY,
+       "Simulate dynamic bodies far from every player with fewer solver iterations, or freeze them (ignored while sv_physics_hash is on)");
+
+CONVAR_BOUNDED(sv_physics_lod_full, 50.0f, 0.0f, 10000.0f, ConVarFlags::SERVER_ONLY,
+               "Dynamic bodies within this distance of a player are fully simulated");
+
+CONVAR_BOUNDED(sv_physics_lod_reduced, 150.0f, 0.0f, 10000.0f, ConVarFlags::SERVER_ONLY,
+               "Dynamic bodies within this distance of a player are simulated cheaply, beyond it they freeze");
+
+CONVAR(net_local_transport, 1, ConVarFlags::NONE,
+       "Connect to a server in the same process in-process instead of over UDP loopback");
+
+CONVAR_BOUNDED(net_fakejitter, 0.0f, 0.0f, 500.0f, ConVarFlags::CLIENT_ONLY,
+               "Hold outgoing input packets back by up to this many milliseconds (testing)");
+
 CONVAR(net_show_connection_trouble, 0, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
        "Show network loss and timeout diagnostics");
 
@@ -0,0 +1,320 @@
+#include "Decals/DecalSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Inclusive tile range covered by a box on screen: x0, y0, x1, y1
+    glm::uvec4 tileRect(const AABB& bounds, const glm::mat4& view_proj)
+    {
+        const glm::uvec4 full(0, 0, DecalFrame::TILES_X - 1, DecalFrame::TILES_Y - 1);
+
+        glm::vec2 ndc_min(std::numeric_limits<float>::max());
+        glm::vec2 ndc_max(std::numeric_limits<float>::lowest());
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const glm::vec3 p((corner & 1) ? bounds.max.x : bounds.min.x,
+                              (corner & 2) ? bounds.max.y : bounds.min.y,
+                              (corner & 4) ? bounds.max.z : bounds.min.z);
+            const glm::vec4 clip = view_proj * glm::vec4(p, 1.0f);
+
+            // A corner behind the eye projects unbounded; cover the whole view
+            if (clip.w <= 1e-5f)
+                return full;
+            const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            ndc_min = glm::min(ndc_min, ndc);
+            ndc_max = glm::max(ndc_max, ndc);
+        }
+
+        auto tile = [](float ndc, uint32_t tiles) {
+            const float t = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+            return static_cast<uint32_t>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+        };
+        return glm::uvec4(tile(ndc_min.x, DecalFrame::TILES_X), tile(ndc_min.y, DecalFrame::TILES_Y),
+                          tile(ndc_max.x, DecalFrame::TILES_X), tile(ndc_max.y, DecalFrame::TILES_Y));
+    }
+
+    uint32_t tileCount(const glm::uvec4& rect)
+    {
+        return (rect.z - rect.x + 1) * (rect.w - rect.y + 1);
+    }
+}
+
+// ============================================================================
+// DecalAtlas / DecalFrame
+// ============================================================================
+
+glm::vec4 DecalAtlas::cellRect(uint32_t cell) const
+{
+    const uint32_t cols = std::max(columns, 1u);
+    const uint32_t rws = std::max(rows, 1u);
+    cell %= cols * rws;
+    const glm::vec2 size(1.0f / static_cast<float>(cols), 1.0f / static_cast<float>(rws));
+    return glm::vec4(static_cast<float>(cell % cols) * size.x, static_cast<float>(cell / cols) * size.y,
+                     size.x, size.y);
+}
+
+void DecalFrame::clear()
+{
+    atlas = INVALID_TEXTURE;
+    decals.clear();
+    tiles.clear();
+    indices.clear();
+}
+
+// ============================================================================
+// DecalPool
+// ============================================================================
+
+DecalPool::DecalPool(uint32_t capacity)
+    : slots(std::max(capacity, 1u))
+{
+    resetSlots();
+}
+
+void DecalPool::resetSlots()
+{
+    for (uint32_t i = 0; i < capacity(); ++i)
+    {
+        slots[i].live = false;
+        slots[i].prev = NO_SLOT;
+        slots[i].next = i + 1 < capacity() ? i + 1 : NO_SLOT;
+    }
+    free_head = 0;
+    oldest = NO_SLOT;
+    newest = NO_SLOT;
+    live = 0;
+}
+
+void DecalPool::unlinkLive(uint32_t index)
+{
+    Slot& slot = slots[index];
+    if (slot.prev != NO_SLOT)
+        slots[slot.prev].next = slot.next;
+    else
+        oldest = slot.next;
+    if (slot.next != NO_SLOT)
+        slots[slot.next].prev = slot.prev;
+    else
+        newest = slot.prev;
+    slot.prev = NO_SLOT;
+    slot.next = NO_SLOT;
+}
+
+void DecalPool::release(uint32_t index)
+{
+    unlinkLive(index);
+    Slot& slot = slots[index];
+    slot.live = false;
+    slot.next = free_head;
+    free_head = index;
+    live--;
+}
+
+DecalHandle DecalPool::spawn(const DecalDesc& desc)
+{
+    uint32_t index = free_head;
+    if (index != NO_SLOT)
+    {
+        free_head = slots[index].next;
+        live++;
+    }
+    else
+    {
+        // Full: overwrite the oldest live decal
+        index = oldest;
+        unlinkLive(index);
+        recycled++;
+    }
+
+    Slot& slot = slots[index];
+    slot.prev = newest;
+    slot.next = NO_SLOT;
+    if (newest != NO_SLOT)
+        slots[newest].next = index;
+    else
+        oldest = index;
+    newest = index;
+
+    slot.live = true;
+    slot.generation++;
+    slot.age = 0.0f;
+    slot.lifetime = std::max(desc.lifetime, 0.0f);
+    slot.fade_time = std::max(desc.fade_time, 0.0f);
+    if (slot.lifetime > 0.0f)
+        slot.fade_time = std::min(slot.fade_time, slot.lifetime);
+    slot.alpha = 1.0f;
+
+    // Decal space: X and Y span the image, Z runs along the projection direction. X is picked
+    // so that the image reads upright to a viewer looking along the direction.
+    const float length = glm::length(desc.direction);
+    const glm::vec3 dir = length > 1e-6f ? desc.direction / length : glm::vec3(0.0f, -1.0f, 0.0f);
+    const glm::vec3 up = std::abs(dir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    const glm::vec3 x = glm::normalize(glm::cross(dir, up));
+    const glm::vec3 y = glm::cross(x, dir);
+    const float c = std::cos(desc.rotation);
+    const float s = std::sin(desc.rotation);
+    const glm::vec3 axis_x = (x * c + y * s) * std::max(desc.size.x, 1e-3f);
+    const glm::vec3 axis_y = (y * c - x * s) * std::max(desc.size.y, 1e-3f);
+    const glm::vec3 axis_z = dir * std::max(desc.depth, 1e-3f);
+
+    const glm::mat4 decal_to_world(glm::vec4(axis_x, 0.0f), glm::vec4(axis_y, 0.0f),
+                                   glm::vec4(axis_z, 0.0f), glm::vec4(desc.position, 1.0f));
+    slot.gpu.world_to_decal = glm::inverse(decal_to_world);
+    slot.gpu.atlas_rect = atlas.cellRect(desc.atlas_cell);
+    slot.gpu.color = desc.color;
+    slot.gpu.direction = glm::vec4(dir, 0.0f);
+
+    const glm::vec3 extent = (glm::abs(axis_x) + glm::abs(axis_y) + glm::abs(axis_z)) * 0.5f;
+    slot.bounds = AABB(desc.position - extent, desc.position + extent);
+
+    const DecalHandle handle{index, slot.generation};
+    spawned++;
+    return handle;
+}
+
+bool DecalPool::remove(DecalHandle handle)
+{
+    if (!alive(handle))
+        return false;
+    release(handle.slot);
+    return true;
+}
+
+bool DecalPool::alive(DecalHandle handle) const
+{
+    return handle.slot < slots.size() && slots[handle.slot].live &&
+           slots[handle.slot].generation == handle.generation;
+}
+
+void DecalPool::update(float dt)
+{
+    if (live == 0)
+        return;
+
+    for (uint32_t i = 0; i < capacity(); ++i)
+    {
+        Slot& slot = slots[i];
+        if (!slot.live || slot.lifetime <= 0.0f)
+            continue;
+
+        slot.age += dt;
+        if (slot.age >= slot.lifetime)
+        {
+            release(i);
+            continue;
+        }
+
+        const float remaining = slot.lifetime - slot.age;
+        slot.alpha = (slot.fade_time > 0.0f && remaining < slot.fade_time) ? remaining / slot.fade_time : 1.0f;
+    }
+}
+
+void DecalPool::clear()
+{
+    resetSlots();
+}
+
+// ============================================================================
+// DecalSystem
+// ============================================================================
+
+DecalPool& DecalSystem::pool(entt::registry& registry)
+{
+    if (auto* decals = registry.ctx().find<DecalPool>())
+        return *decals;
+    return registry.ctx().emplace<DecalPool>();
+}
+
+DecalPool* DecalSystem::findPool(entt::registry& registry)
+{
+    return registry.ctx().find<DecalPool>();
+}
+
+void DecalSystem::buildFrame(const DecalPool& pool, const Frustum& frustum, const glm::mat4& view_proj,
+                             DecalFrame& frame, DecalStats& stats)
+{
+    frame.clear();
+    frame.atlas = pool.atlas.texture;
+    frame.tiles.assign(DecalFrame::TILES_X * DecalFrame::TILES_Y, glm::uvec2(0));
+
+    stats = {};
+    stats.live = pool.live;
+    if (pool.live == 0)
+        return;
+
+    // Walk from the oldest decal, so that newer decals blend over older ones
+    std::vector<glm::uvec4> rects;
+    for (uint32_t i = pool.oldest; i != DecalPool::NO_SLOT; i = pool.slots[i].next)
+    {
+        const DecalPool::Slot& slot = pool.slots[i];
+        if (!frustum.intersectsAABB(slot.bounds))
+        {
+            stats.frustum_culled++;
+            continue;
+        }
+
+        GPUDecal decal = slot.gpu;
+        decal.color.a *= slot.alpha;
+        frame.decals.push_back(decal);
+        rects.push_back(tileRect(slot.bounds, view_proj));
+    }
+
+    // Over the caps, the oldest visible decals go first
+    size_t first = frame.decals.size() > DecalFrame::MAX_DECALS ? frame.decals.size() - DecalFrame::MAX_DECALS : 0;
+    size_t entries = 0;
+    for (size_t i = first; i < rects.size(); ++i)
+        entries += tileCount(rects[i]);
+    while (entries > DecalFrame::MAX_TILE_ENTRIES)
+        entries -= tileCount(rects[first++]);
+    if (first > 0)
+    {
+        frame.decals.erase(frame.decals.begin(), frame.decals.begin() + static_cast<std::ptrdiff_t>(first));
+        rects.erase(rects.begin(), rects.begin() + static_cast<std::ptrdiff_t>(first));
+        stats.dropped = static_cast<uint32_t>(first);
+    }
+
+    for (const glm::uvec4& rect : rects)
+        for (uint32_t ty = rect.y; ty <= rect.w; ++ty)
+            for (uint32_t tx = rect.x; tx <= rect.z; ++tx)
+                frame.tiles[ty * DecalFrame::TILES_X + tx].y++;
+
+    uint32_t offset = 0;
+    for (glm::uvec2& tile : frame.tiles)
+    {
+        tile.x = offset;
+        offset += tile.y;
+        tile.y = 0;
+    }
+
+    frame.indices.resize(entries);
+    for (uint32_t i = 0; i < rects.size(); ++i)
+    {
+        const glm::uvec4& rect = rects[i];
+        for (uint32_t ty = rect.y; ty <= rect.w; ++ty)
+            for (uint32_t tx = rect.x; tx <= rect.z; ++tx)
+            {
+                glm::uvec2& tile = frame.tiles[ty * DecalFrame::TILES_X + tx];
+                frame.indices[tile.x + tile.y++] = i;
+            }
+    }
+
+    stats.visible = static_cast<uint32_t>(frame.decals.size());
+    stats.tile_entries = static_cast<uint32_t>(entries);
+}
+
+bool DecalSystem::project(const GPUDecal& decal, const glm::vec3& world_position, glm::vec2& atlas_uv, float& fade)
+{
+    const glm::vec3 local = glm::vec3(decal.world_to_decal * glm::vec4(world_position, 1.0f));
+    if (std::abs(local.x) > 0.5f || std::abs(local.y) > 0.5f || std::abs(local.z) > 0.5f)
+        return false;
+
+    const glm::vec2 uv(local.x + 0.5f, 0.5f - local.y);
+    atlas_uv = glm::vec2(decal.atlas_rect) + uv * glm::vec2(decal.atlas_rect.z, decal.atlas_rect.w);
+
+    // Soften the front and back faces of the box so the decal does not end in a hard line
+    fade = 1.0f - glm::smoothstep(0.35f, 0.5f, std::abs(local.z));
+    return true;
+}
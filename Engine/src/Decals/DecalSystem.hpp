@@ -0,0 +1,160 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Graphics/Frustum.hpp"
+#include "Graphics/RenderAPI.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A grid of equally sized decal images packed into one texture
+struct ENGINE_API DecalAtlas
+{
+    TextureHandle texture = INVALID_TEXTURE;
+    uint32_t columns = 1;
+    uint32_t rows = 1;
+
+    // UV offset (xy) and size (zw) of a cell, counted row by row from the top left
+    glm::vec4 cellRect(uint32_t cell) const;
+};
+
+struct DecalDesc
+{
+    glm::vec3 position{0.0f};               // Center of the projection box, usually the hit point
+    glm::vec3 direction{0.0f, -1.0f, 0.0f}; // Projection direction, into the surface
+    float rotation = 0.0f;                  // Radians around direction
+    glm::vec2 size{0.2f};                   // Width and height in meters
+    float depth = 0.2f;                     // Extent along direction; surfaces outside it are untouched
+    uint32_t atlas_cell = 0;
+    glm::vec4 color{1.0f};                  // Multiplies the atlas texel; alpha scales coverage
+    float lifetime = 30.0f;                 // Seconds; 0 lives until the pool recycles it
+    float fade_time = 2.0f;                 // Fades out over the last seconds of its lifetime
+};
+
+struct DecalHandle
+{
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return slot != UINT32_MAX; }
+};
+
+// One decal as the decal pass reads it. world_to_decal maps the projection box onto
+// [-0.5, 0.5]^3 with +Z along the projection direction.
+struct alignas(16) GPUDecal
+{
+    glm::mat4 world_to_decal{1.0f};
+    glm::vec4 atlas_rect{0.0f, 0.0f, 1.0f, 1.0f};
+    glm::vec4 color{1.0f};                  // Alpha includes the fade
+    glm::vec4 direction{0.0f, -1.0f, 0.0f, 0.0f};
+};
+static_assert(sizeof(GPUDecal) == 112, "GPUDecal must match DecalData in decals.slang");
+
+// The visible decals of one view, binned into a grid of screen tiles the way a clustered
+// light list would be. Each pixel of the decal pass only tests the decals of its tile.
+struct ENGINE_API DecalFrame
+{
+    static constexpr uint32_t TILES_X = 32;
+    static constexpr uint32_t TILES_Y = 18;
+    static constexpr uint32_t MAX_DECALS = 4096;            // Per view; the newest are kept
+    static constexpr uint32_t MAX_TILE_ENTRIES = 65536;
+
+    TextureHandle atlas = INVALID_TEXTURE;
+    std::vector<GPUDecal> decals;           // Oldest first, so newer decals blend on top
+    std::vector<glm::uvec2> tiles;          // TILES_X * TILES_Y over NDC, row by row: first entry, count
+    std::vector<uint32_t> indices;          // Decal indices of each tile, oldest first
+
+    bool empty() const { return decals.empty(); }
+    void clear();
+};
+
+struct DecalStats
+{
+    uint32_t live = 0;
+    uint32_t visible = 0;
+    uint32_t frustum_culled = 0;
+    uint32_t dropped = 0;                   // Visible decals past MAX_DECALS or MAX_TILE_ENTRIES
+    uint32_t tile_entries = 0;
+};
+
+// Fixed-capacity pool of projected box decals. Spawning takes a free slot while there is one and
+// recycles the oldest live decal only when the pool is full. Live slots stay linked in spawn
+// order, so frames blend newer decals over older ones. Nothing is allocated after construction.
+class ENGINE_API DecalPool
+{
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 2048;
+
+    explicit DecalPool(uint32_t capacity = DEFAULT_CAPACITY);
+
+    void setAtlas(const DecalAtlas& decal_atlas) { atlas = decal_atlas; }
+    const DecalAtlas& getAtlas() const { return atlas; }
+
+    DecalHandle spawn(const DecalDesc& desc);
+    bool remove(DecalHandle handle);
+    bool alive(DecalHandle handle) const;
+
+    // Ages every decal and frees the expired ones
+    void update(float dt);
+    void clear();
+
+    uint32_t capacity() const { return static_cast<uint32_t>(slots.size()); }
+    uint32_t liveCount() const { return live; }
+    uint64_t spawnedCount() const { return spawned; }
+    uint64_t recycledCount() const { return recycled; }    // Live decals overwritten by spawn()
+
+private:
+    friend class DecalSystem;
+
+    static constexpr uint32_t NO_SLOT = ~0u;
+
+    struct Slot
+    {
+        GPUDecal gpu;
+        AABB bounds;
+        float alpha = 1.0f;
+        float age = 0.0f;
+        float lifetime = 0.0f;
+        float fade_time = 0.0f;
+        uint32_t generation = 0;
+        uint32_t prev = NO_SLOT;            // Live: spawn order. Free: unused
+        uint32_t next = NO_SLOT;            // Live: spawn order. Free: next free slot
+        bool live = false;
+    };
+
+    void unlinkLive(uint32_t index);
+    void release(uint32_t index);
+    void resetSlots();
+
+    DecalAtlas atlas;
+    std::vector<Slot> slots;
+    uint32_t oldest = NO_SLOT;              // Live list, oldest to newest
+    uint32_t newest = NO_SLOT;
+    uint32_t free_head = NO_SLOT;
+    uint32_t live = 0;
+    uint64_t spawned = 0;
+    uint64_t recycled = 0;
+};
+
+// Builds per-view decal lists for the deferred decal pass. The pass runs between the GBuffer
+// and the lighting pass and blends each pixel's decals into its base color.
+class ENGINE_API DecalSystem
+{
+public:
+    // The decal pool of a world, created on first use
+    static DecalPool& pool(entt::registry& registry);
+    static DecalPool* findPool(entt::registry& registry);
+
+    // Frustum culls the live decals of pool and bins them into screen tiles of view_proj
+    static void buildFrame(const DecalPool& pool, const Frustum& frustum, const glm::mat4& view_proj,
+                           DecalFrame& frame, DecalStats& stats);
+
+    // Atlas UV and depth fade of a decal at a world position, as the decal pass computes them
+    // before its surface facing term. Returns false outside the projection box.
+    static bool project(const GPUDecal& decal, const glm::vec3& world_position, glm::vec2& atlas_uv,
+                        float& fade);
+};
@@ -0,0 +1,328 @@
+#include "Foliage/FoliageSystem.hpp"
+
+#include "Components/Components.hpp"
+#include "Components/FoliageComponent.hpp"
+#include "Components/mesh.hpp"
+#include "Graphics/LODSelector.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace
+{
+    constexpr float kTwoPi = 6.28318530718f;
+
+    uint32_t nextRandom(uint32_t& state)
+    {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Uniform in [0, 1)
+    float randomUnit(uint32_t& state)
+    {
+        return static_cast<float>(nextRandom(state) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Stream for one triangle of one layer, so a triangle scatters the same instances
+    // whatever order the surface is walked in; xorshift needs non-zero
+    uint32_t triangleSeed(uint32_t seed, size_t triangle)
+    {
+        uint32_t h = seed * 0x9e3779b9U ^ static_cast<uint32_t>(triangle) ^ static_cast<uint32_t>(triangle >> 32);
+        h ^= h >> 16;
+        h *= 0x7feb352dU;
+        h ^= h >> 15;
+        h *= 0x846ca68bU;
+        h ^= h >> 16;
+        return h != 0 ? h : 0x9e3779b9U;
+    }
+
+    uint64_t cellKey(const glm::vec3& position, float cell_size)
+    {
+        const int32_t x = static_cast<int32_t>(std::floor(position.x / cell_size));
+        const int32_t z = static_cast<int32_t>(std::floor(position.z / cell_size));
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+
+    // Padding from instance positions to the bounds of the meshes drawn at them, for any yaw
+    void meshPadding(const FoliageLayer& layer, glm::vec3& pad_min, glm::vec3& pad_max)
+    {
+        pad_min = glm::vec3(0.0f);
+        pad_max = glm::vec3(0.0f);
+        const mesh* m = layer.foliage_mesh.get();
+        if (!m || !m->bounds_computed)
+            return;
+        const float scale = std::max(layer.scale_min, layer.scale_max);
+        const glm::vec3 extent = glm::max(glm::abs(m->aabb_min), glm::abs(m->aabb_max));
+        const float radius = std::sqrt(extent.x * extent.x + extent.z * extent.z) * scale;
+        pad_min = glm::vec3(-radius, std::min(m->aabb_min.y, 0.0f) * scale, -radius);
+        pad_max = glm::vec3(radius, std::max(m->aabb_max.y, 0.0f) * scale, radius);
+    }
+}
+
+float FoliageDensityMap::sample(const glm::vec2& uv) const
+{
+    if (values.empty() || width <= 0 || height <= 0)
+        return 1.0f;
+
+    const float x = std::clamp(uv.x, 0.0f, 1.0f) * static_cast<float>(width - 1);
+    const float y = std::clamp(uv.y, 0.0f, 1.0f) * static_cast<float>(height - 1);
+    const int x0 = static_cast<int>(x);
+    const int y0 = static_cast<int>(y);
+    const int x1 = std::min(x0 + 1, width - 1);
+    const int y1 = std::min(y0 + 1, height - 1);
+    const float fx = x - static_cast<float>(x0);
+    const float fy = y - static_cast<float>(y0);
+
+    auto at = [&](int px, int py) {
+        return static_cast<float>(values[static_cast<size_t>(py) * width + px]) / 255.0f;
+    };
+    const float top = at(x0, y0) + (at(x1, y0) - at(x0, y0)) * fx;
+    const float bottom = at(x0, y1) + (at(x1, y1) - at(x0, y1)) * fx;
+    return top + (bottom - top) * fy;
+}
+
+bool FoliageDensityMap::load(const std::string& path, FoliageDensityMap& out, std::string& error)
+{
+    int w = 0;
+    int h = 0;
+    int channels = 0;
+    stbi_set_flip_vertically_on_load_thread(false);
+    uint8_t* raw = stbi_load(path.c_str(), &w, &h, &channels, 1);
+    if (!raw)
+    {
+        error = "Failed to load foliage density map: " + path;
+        return false;
+    }
+
+    out.width = w;
+    out.height = h;
+    out.values.assign(raw, raw + static_cast<size_t>(w) * h);
+    stbi_image_free(raw);
+    return true;
+}
+
+size_t FoliageField::instanceCount() const
+{
+    size_t count = 0;
+    for (const FoliageCell& cell : cells)
+        count += cell.instances.size();
+    return count;
+}
+
+size_t FoliageSystem::scatterTriangles(FoliageField& field, uint32_t layer_index, const FoliageLayer& layer,
+                                       const vertex* vertices, size_t vertex_count, const glm::mat4& world)
+{
+    if (!vertices || vertex_count < 3 || layer.density <= 0.0f)
+        return 0;
+
+    const float cell_size = std::max(field.cell_size, 0.1f);
+    const float min_up = std::cos(glm::radians(std::clamp(layer.max_slope, 0.0f, 90.0f)));
+    const float scale_range = layer.scale_max - layer.scale_min;
+
+    // Cells this layer already has, so repeated scatters over several surfaces share them
+    std::unordered_map<uint64_t, uint32_t> cell_index;
+    for (uint32_t i = 0; i < field.cells.size(); ++i)
+    {
+        if (field.cells[i].layer == layer_index && field.cells[i].bounds.isValid())
+            cell_index.emplace(cellKey(field.cells[i].bounds.getCenter(), cell_size), i);
+    }
+
+    uint64_t last_key = 0;
+    FoliageCell* last_cell = nullptr;
+    auto cellFor = [&](const glm::vec3& position) -> FoliageCell& {
+        const uint64_t key = cellKey(position, cell_size);
+        if (last_cell && key == last_key)
+            return *last_cell;
+        auto [it, inserted] = cell_index.emplace(key, static_cast<uint32_t>(field.cells.size()));
+        if (inserted)
+        {
+            FoliageCell cell;
+            cell.layer = layer_index;
+            field.cells.push_back(std::move(cell));
+        }
+        last_key = key;
+        last_cell = &field.cells[it->second];
+        return *last_cell;
+    };
+
+    size_t added = 0;
+    for (size_t t = 0; t + 2 < vertex_count; t += 3)
+    {
+        const vertex& a = vertices[t];
+        const vertex& b = vertices[t + 1];
+        const vertex& c = vertices[t + 2];
+        const glm::vec3 p0 = glm::vec3(world * glm::vec4(a.vx, a.vy, a.vz, 1.0f));
+        const glm::vec3 p1 = glm::vec3(world * glm::vec4(b.vx, b.vy, b.vz, 1.0f));
+        const glm::vec3 p2 = glm::vec3(world * glm::vec4(c.vx, c.vy, c.vz, 1.0f));
+
+        const glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+        const float double_area = glm::length(cross);
+        if (double_area <= 1.0e-8f)
+            continue;
+        // Surfaces wind either way; only the steepness matters
+        if (std::abs(cross.y) / double_area < min_up)
+            continue;
+
+        uint32_t rng = triangleSeed(layer.seed, t / 3);
+        const float expected = 0.5f * double_area * layer.density;
+        uint32_t count = static_cast<uint32_t>(expected);
+        if (randomUnit(rng) < expected - static_cast<float>(count))
+            ++count;
+
+        const glm::vec2 uv0(a.u, a.v), uv1(b.u, b.v), uv2(c.u, c.v);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            // Uniform point in the triangle
+            const float s = std::sqrt(randomUnit(rng));
+            const float r = randomUnit(rng);
+            const float w0 = 1.0f - s;
+            const float w1 = s * (1.0f - r);
+            const float w2 = s * r;
+            const float keep = randomUnit(rng);
+            const float scale = layer.scale_min + scale_range * randomUnit(rng);
+            const float yaw = layer.random_yaw ? randomUnit(rng) * kTwoPi : 0.0f;
+            if (keep >= layer.density_map.sample(uv0 * w0 + uv1 * w1 + uv2 * w2))
+                continue;
+
+            FoliageInstance instance;
+            instance.position = p0 * w0 + p1 * w1 + p2 * w2;
+            instance.yaw = yaw;
+            instance.scale = scale;
+
+            FoliageCell& cell = cellFor(instance.position);
+            cell.bounds.expand(instance.position);
+            cell.instances.push_back(instance);
+            ++added;
+        }
+    }
+    return added;
+}
+
+bool FoliageSystem::scatterEntity(entt::registry& registry, entt::entity entity)
+{
+    auto* foliage = registry.try_get<FoliageComponent>(entity);
+    if (!foliage)
+        return false;
+
+    const mesh* surface = nullptr;
+    if (registry.all_of<TerrainComponent>(entity))
+    {
+        const auto* collider = registry.try_get<ColliderComponent>(entity);
+        if (collider && collider->m_mesh)
+            surface = collider->m_mesh.get();
+    }
+    if (!surface)
+    {
+        // A displaced render mesh is flat on the CPU; without its collision mesh there is no surface
+        const auto* mesh_component = registry.try_get<MeshComponent>(entity);
+        if (mesh_component && mesh_component->m_mesh && !mesh_component->m_mesh->heightmap_displacement)
+            surface = mesh_component->m_mesh.get();
+    }
+    if (!surface || !surface->is_valid || !surface->vertices || surface->vertices_len < 3)
+        return false;
+
+    const auto* transform = registry.try_get<TransformComponent>(entity);
+    const glm::mat4 world = transform ? transform->getTransformMatrix() : glm::mat4(1.0f);
+
+    foliage->field.clear();
+    foliage->field.cell_size = foliage->cell_size;
+    for (uint32_t i = 0; i < foliage->layers.size(); ++i)
+        scatterTriangles(foliage->field, i, foliage->layers[i], surface->vertices, surface->vertices_len, world);
+    foliage->dirty = false;
+    return true;
+}
+
+void FoliageSystem::cull(const FoliageField& field, const std::vector<FoliageLayer>& layers,
+                         const Frustum& frustum, const glm::vec3& view_position, const glm::mat4& projection,
+                         std::vector<FoliageVisibleCell>& visible, FoliageStats& stats)
+{
+    const size_t first = visible.size();
+    std::vector<float> thresholds;
+    for (uint32_t c = 0; c < field.cells.size(); ++c)
+    {
+        const FoliageCell& cell = field.cells[c];
+        ++stats.cells;
+        stats.instances += cell.instances.size();
+        if (cell.instances.empty() || cell.layer >= layers.size())
+            continue;
+        const FoliageLayer& layer = layers[cell.layer];
+        const mesh* m = layer.foliage_mesh.get();
+        if (!m || !m->visible)
+            continue;
+
+        const glm::vec3 nearest = glm::clamp(view_position, cell.bounds.min, cell.bounds.max);
+        const float distance = glm::length(nearest - view_position);
+        if (distance > layer.cull_distance)
+        {
+            ++stats.distance_culled;
+            continue;
+        }
+
+        glm::vec3 pad_min, pad_max;
+        meshPadding(layer, pad_min, pad_max);
+        if (!frustum.intersectsAABB(AABB(cell.bounds.min + pad_min, cell.bounds.max + pad_max)))
+        {
+            ++stats.frustum_culled;
+            continue;
+        }
+
+        FoliageVisibleCell out;
+        out.cell = c;
+        out.distance = distance;
+        const glm::vec3 farthest = glm::max(glm::abs(view_position - cell.bounds.min),
+                                            glm::abs(view_position - cell.bounds.max));
+        out.fading = glm::length(farthest) > layer.cull_distance - std::max(layer.fade_distance, 0.0f);
+
+        if (m->force_lod >= 0)
+        {
+            out.lod = std::min(m->force_lod, m->getLODCount() - 1);
+        }
+        else if (!m->lod_levels.empty() && m->bounds_computed)
+        {
+            // The whole cell draws at the LOD of its nearest, largest instance
+            const int lod_count = m->getLODCount();
+            thresholds.assign(lod_count, 0.0f);
+            for (int i = 0; i < static_cast<int>(m->lod_levels.size()); ++i)
+                thresholds[i + 1] = m->lod_levels[i].screen_threshold;
+            const glm::vec3 scale(std::max(layer.scale_min, layer.scale_max));
+            const glm::vec3 local_center = (m->aabb_min + m->aabb_max) * 0.5f * scale;
+            out.lod = LODSelector::selectLOD(view_position, nearest - local_center, m->aabb_min, m->aabb_max,
+                                             projection, lod_count, thresholds.data(), scale);
+        }
+
+        ++stats.visible_cells;
+        stats.visible_instances += cell.instances.size();
+        visible.push_back(out);
+    }
+
+    std::sort(visible.begin() + static_cast<std::ptrdiff_t>(first), visible.end(),
+        [](const FoliageVisibleCell& a, const FoliageVisibleCell& b) { return a.distance < b.distance; });
+}
+
+bool FoliageSystem::instanceTransform(const FoliageInstance& instance, const FoliageLayer& layer,
+                                      const glm::vec3& view_position, glm::mat4& out)
+{
+    if (!withinCullDistance(instance, layer, view_position))
+        return false;
+
+    const float distance = glm::length(instance.position - view_position);
+    float scale = instance.scale;
+    if (layer.fade_distance > 0.0f)
+        scale *= std::clamp((layer.cull_distance - distance) / layer.fade_distance, 0.0f, 1.0f);
+
+    const float c = std::cos(instance.yaw) * scale;
+    const float s = std::sin(instance.yaw) * scale;
+    out = glm::mat4(
+        glm::vec4(c, 0.0f, -s, 0.0f),
+        glm::vec4(0.0f, scale, 0.0f, 0.0f),
+        glm::vec4(s, 0.0f, c, 0.0f),
+        glm::vec4(instance.position, 1.0f));
+    return true;
+}
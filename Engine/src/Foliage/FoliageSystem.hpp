@@ -0,0 +1,129 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Graphics/Frustum.hpp"
+#include "Utils/Vertex.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class mesh;
+
+// One scattered instance: no entity, no BVH leaf, just where it stands. The transform is
+// rebuilt from these when the instance is drawn.
+struct FoliageInstance
+{
+    glm::vec3 position{0.0f};
+    float yaw = 0.0f;       // Radians around world up
+    float scale = 1.0f;
+};
+static_assert(sizeof(FoliageInstance) == 20, "FoliageInstance is stored per instance; keep it compact");
+
+// Grayscale map over a surface's UVs scaling its foliage density, 0 (none) to 255 (full)
+struct ENGINE_API FoliageDensityMap
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> values;
+
+    bool empty() const { return values.empty(); }
+
+    // Bilinear, clamped to the edges; 1 for an empty map
+    float sample(const glm::vec2& uv) const;
+
+    static bool load(const std::string& path, FoliageDensityMap& out, std::string& error);
+};
+
+struct FoliageLayer
+{
+    std::shared_ptr<mesh> foliage_mesh;     // Drawn per instance; its LODs are picked per cell
+    FoliageDensityMap density_map;          // Empty scatters uniformly
+    float density = 1.0f;                   // Instances per square meter where the map is white
+    float scale_min = 0.8f;
+    float scale_max = 1.2f;
+    float max_slope = 35.0f;                // Degrees from up; steeper triangles get nothing
+    float cull_distance = 100.0f;           // Instances past this are not drawn
+    float fade_distance = 10.0f;            // Instances shrink away over this many meters before cull_distance
+    bool random_yaw = true;
+    uint32_t seed = 1;
+};
+
+struct FoliageCell
+{
+    uint32_t layer = 0;
+    AABB bounds;                            // Instance positions; drawing pads it by the mesh bounds
+    std::vector<FoliageInstance> instances;
+};
+
+// The scattered instances of a set of layers, bucketed into square cells on the XZ plane.
+// Each cell holds one layer so that it becomes one instanced draw.
+struct ENGINE_API FoliageField
+{
+    float cell_size = 16.0f;
+    std::vector<FoliageCell> cells;
+
+    size_t instanceCount() const;
+    void clear() { cells.clear(); }
+};
+
+struct FoliageVisibleCell
+{
+    uint32_t cell = 0;
+    int lod = 0;
+    float distance = 0.0f;                  // From the view to the nearest point of the cell
+    bool fading = false;                    // Some instances lie past the fade start
+};
+
+struct FoliageStats
+{
+    uint32_t cells = 0;
+    uint32_t visible_cells = 0;
+    uint32_t distance_culled = 0;           // Cells entirely past their layer's cull_distance
+    uint32_t frustum_culled = 0;
+    size_t instances = 0;
+    size_t visible_instances = 0;           // Instances of the visible cells, before per-instance fade
+    size_t drawn_instances = 0;             // Filled in by the renderer
+    size_t draws = 0;
+};
+
+// Scatters and culls foliage. Instances are scattered once, over the triangles of a surface, and
+// stored per cell. Each view culls whole cells against its frustum and the layer distances; the
+// renderer then turns each visible cell into one instanced draw.
+class ENGINE_API FoliageSystem
+{
+public:
+    // Scatters a layer over world-space triangles (vertex triangle list, transformed by world).
+    // Per triangle the expected count is area * density; the density map is sampled at each
+    // candidate's interpolated UV. Deterministic for a given seed. Returns the instances added.
+    static size_t scatterTriangles(FoliageField& field, uint32_t layer_index, const FoliageLayer& layer,
+                                   const vertex* vertices, size_t vertex_count, const glm::mat4& world);
+
+    // Rebuilds the FoliageComponent of an entity over its surface: the terrain collision mesh for
+    // a TerrainComponent (it keeps the heights even with GPU displacement), else its MeshComponent.
+    // Returns false when the entity has no surface yet.
+    static bool scatterEntity(entt::registry& registry, entt::entity entity);
+
+    // Appends the cells of field worth drawing from a view, nearest first
+    static void cull(const FoliageField& field, const std::vector<FoliageLayer>& layers,
+                     const Frustum& frustum, const glm::vec3& view_position, const glm::mat4& projection,
+                     std::vector<FoliageVisibleCell>& visible, FoliageStats& stats);
+
+    // Whether an instance is closer than its layer's cull_distance. instanceTransform uses the
+    // same test, so counting with this matches what gets written.
+    static bool withinCullDistance(const FoliageInstance& instance, const FoliageLayer& layer,
+                                   const glm::vec3& view_position)
+    {
+        const glm::vec3 to_view = instance.position - view_position;
+        return glm::dot(to_view, to_view) < layer.cull_distance * layer.cull_distance;
+    }
+
+    // Transform of an instance, shrunk by the distance fade; returns false past cull_distance
+    static bool instanceTransform(const FoliageInstance& instance, const FoliageLayer& layer,
+                                  const glm::vec3& view_position, glm::mat4& out);
+};
@@ -3,9 +3,12 @@
 #include "Events/EventBus.hpp"
 #include "Timer/TimerSystem.hpp"
 #include "Debug/DebugDraw.hpp"
+#include "Decals/DecalSystem.hpp"
 #include "Audio/AudioSystem.hpp"
 #include "Animation/AnimationSystem.hpp"
+#include "Animation/FootPlacement.hpp"
 #include "GameFramework/GameMode.hpp"
+#include "Console/ConVar.hpp"
 #include "Utils/Log.hpp"
 
 GameSimulation::GameSimulation(world* game_world, std::shared_ptr<InputManager> input_mgr)
@@ -16,6 +19,9 @@ GameSimulation::GameSimulation(world* game_world, std::shared_ptr<InputManager>
 
 GameSimulation::~GameSimulation()
 {
+    // The query captures this world's physics; waits for any batch in flight
+    if (m_initialized)
+        AudioSystem::get().setOcclusionQuery(nullptr);
     m_game_mode = nullptr;
 }
 
@@ -68,6 +74,14 @@ void GameSimulation::initialize()
     // Optimize broad phase after all bodies are set up
     m_world->getPhysicsSystem().getJoltSystem()->OptimizeBroadPhase();
 
+    // Audio occlusion rays run against this world's static geometry
+    PhysicsSystem* physics = &m_world->getPhysicsSystem();
+    AudioSystem::get().setOcclusionQuery(
+        [physics](const glm::vec3* from, const glm::vec3* to, size_t count, uint8_t* out_blocked)
+        {
+            physics->castLineOfSightBatch(from, to, count, out_blocked);
+        });
+
     m_initialized = true;
 
     LOG_ENGINE_INFO("GameSimulation initialized (player={}, freecam={})",
@@ -105,16 +119,54 @@ void GameSimulation::update(float delta_time)
     bool is_freecam = player_controller ? player_controller->isFreecamMode() : false;
     update_player_representations(m_world->registry, is_freecam);
 
+    // Ground probes for foot placement, batched before the animation pass
+    if (CVAR_BOOL(anim_foot_placement))
+    {
+        FootPlacementSettings foot_settings;
+        foot_settings.full_distance = CVAR_FLOAT(anim_ik_lod_full);
+        foot_settings.reduced_distance = CVAR_FLOAT(anim_ik_lod_reduced);
+        foot_settings.reduced_interval = static_cast<uint32_t>(CVAR_INT(anim_ik_reduced_interval));
+        FootPlacement::updateProbes(m_world->registry, m_world->getPhysicsSystem(),
+                                    getActiveCamera().getPosition(), foot_settings);
+    }
+
+    // Ragdoll poses from this step, motor targets and LOD for the next one
+    RagdollLodSettings ragdoll_settings;
+    ragdoll_settings.full_distance = CVAR_FLOAT(phys_ragdoll_lod_full);
+    ragdoll_settings.reduced_distance = CVAR_FLOAT(phys_ragdoll_lod_reduced);
+    m_world->getPhysicsSystem().updateRagdolls(m_world->registry, getActiveCamera().getPosition(),
+                                               delta_time, ragdoll_settings);
+
     // Update animations
     AnimationSystem::update(m_world->registry, delta_time);
 
+    // Particles, budgeted and LODed around the camera
+    ParticleBudgetSettings particle_settings = m_particles.getSettings();
+    particle_settings.budget_ms = CVAR_FLOAT(fx_particle_budget_ms);
+    particle_settings.full_distance = CVAR_FLOAT(fx_particle_lod_full);
+    particle_settings.reduced_distance = CVAR_FLOAT(fx_particle_lod_reduced);
+    m_particles.setSettings(particle_settings);
+    m_particles.update(m_world->registry, getActiveCamera().getPosition(), delta_time);
+
+    // Age decals and fade out the expiring ones
+    if (DecalPool* decals = DecalSystem::findPool(m_world->registry))
+        decals->update(delta_time);
+
     // Update audio listener to match active camera
+    if (auto* occlusion = CVAR_PTR(snd_occlusion))
+    {
+        AudioOcclusionSettings occlusion_settings = AudioSystem::get().getOcclusionSettings();
+        occlusion_settings.enabled = occlusion->getBool();
+        occlusion_settings.max_voices_per_frame = CVAR_INT(snd_occlusion_budget);
+        AudioSystem::get().setOcclusionSettings(occlusion_settings);
+    }
+
     camera& active_cam = getActiveCamera();
     AudioSystem::get().setListenerPosition(
         active_cam.getPosition(),
         active_cam.camera_forward(),
         active_cam.getUpVector());
-    AudioSystem::get().update();
+    AudioSystem::get().update(delta_time);
 }
 
 void GameSimulation::handleMouseMotion(float mouse_dy, float mouse_dx)
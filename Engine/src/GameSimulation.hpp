@@ -6,6 +6,7 @@
 #include "PlayerController.hpp"
 #include "Components/Components.hpp"
 #include "Components/camera.hpp"
+#include "Particles/ParticleSystem.hpp"
 #include <memory>
 #include <entt/entt.hpp>
 
@@ -45,10 +46,13 @@ public:
     entt::entity getPlayerEntity() const  { return m_player_entity; }
     entt::entity getFreecamEntity() const { return m_freecam_entity; }
 
+    const ParticleSystem& getParticleSystem() const { return m_particles; }
+
 private:
     world*                          m_world;
     std::shared_ptr<InputManager>   m_input_manager;
     GameFramework::GameModeBase*    m_game_mode = nullptr;
+    ParticleSystem                  m_particles;
 
     entt::entity m_player_entity     = entt::null;
     entt::entity m_freecam_entity    = entt::null;
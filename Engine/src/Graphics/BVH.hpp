@@ -4,6 +4,8 @@
 #include <entt/entt.hpp>
 #include <vector>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 
 // Forward declarations
 class mesh;
@@ -21,6 +23,13 @@ struct BVHNode
     bool isLeaf() const { return entity != entt::null; }
 };
 
+// Leaf AABB hit returned by SceneBVH::rayQuery
+struct BVHRayHit
+{
+    entt::entity entity = entt::null;
+    float t_enter = 0.0f;  // Entry distance along the ray (0 if the origin is inside)
+};
+
 // Scene BVH for frustum culling
 class SceneBVH
 {
@@ -33,9 +42,23 @@ public:
     // Query all entities visible in the frustum
     void queryFrustum(const Frustum& frustum, std::vector<entt::entity>& results) const;
 
+    // Query several frusta in one traversal. Each result carries a mask with
+    // bit i set when the entity is visible in frusta[i]. At most MAX_QUERY_FRUSTA.
+    static constexpr size_t MAX_QUERY_FRUSTA = 32;
+    struct FrustumMaskHit
+    {
+        entt::entity entity = entt::null;
+        uint32_t mask = 0;
+    };
+    void queryFrustumMask(const Frustum* frusta, size_t count, std::vector<FrustumMaskHit>& results) const;
+
     // Pick the closest entity hit by a ray. Returns entt::null if nothing hit.
     entt::entity rayPick(const glm::vec3& origin, const glm::vec3& direction) const;
 
+    // Collect every leaf whose bounds the ray hits, sorted nearest first.
+    // Used by ScenePicker to refine candidates against triangles.
+    void rayQuery(const glm::vec3& origin, const glm::vec3& direction, std::vector<BVHRayHit>& results) const;
+
     // Mark the BVH as needing rebuild (e.g., when entities move or are added/removed)
     void markDirty() { dirty = true; }
 
@@ -66,12 +89,22 @@ private:
     // Recursive frustum query
     void queryFrustumRecursive(int nodeIndex, const Frustum& frustum, std::vector<entt::entity>& results) const;
 
+    // Recursive multi-frustum query. `testing` holds frusta that still need
+    // bounds tests, `inside` those already known to contain the node.
+    void queryFrustumMaskRecursive(int nodeIndex, const Frustum* frusta, uint32_t testing, uint32_t inside,
+                                   std::vector<FrustumMaskHit>& results) const;
+
     // Collect all leaf entities in a subtree (no frustum tests)
     void collectAllLeaves(int nodeIndex, std::vector<entt::entity>& results) const;
+    void collectAllLeavesMask(int nodeIndex, uint32_t mask, std::vector<FrustumMaskHit>& results) const;
 
     // Recursive ray pick (returns closest hit entity)
     void rayPickRecursive(int nodeIndex, const glm::vec3& origin, const glm::vec3& direction,
                           float& closest_t, entt::entity& closest_entity) const;
+
+    // Recursive ray query (all leaf hits)
+    void rayQueryRecursive(int nodeIndex, const glm::vec3& origin, const glm::vec3& direction,
+                           std::vector<BVHRayHit>& results) const;
 };
 
 // Implementation
@@ -220,6 +253,71 @@ inline void SceneBVH::queryFrustum(const Frustum& frustum, std::vector<entt::ent
     queryFrustumRecursive(root_index, frustum, results);
 }
 
+inline void SceneBVH::queryFrustumMask(const Frustum* frusta, size_t count, std::vector<FrustumMaskHit>& results) const
+{
+    results.clear();
+
+    if (root_index < 0 || nodes.empty() || count == 0)
+        return;
+
+    count = std::min(count, MAX_QUERY_FRUSTA);
+    const uint32_t all = count == 32 ? 0xFFFFFFFFu : ((1u << count) - 1u);
+    queryFrustumMaskRecursive(root_index, frusta, all, 0, results);
+}
+
+inline void SceneBVH::queryFrustumMaskRecursive(int nodeIndex, const Frustum* frusta, uint32_t testing, uint32_t inside,
+                                                std::vector<FrustumMaskHit>& results) const
+{
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(nodes.size()))
+        return;
+
+    const BVHNode& node = nodes[nodeIndex];
+
+    // Resolve each undecided frustum against this node: outside drops it,
+    // fully inside stops testing it for the whole subtree
+    for (uint32_t bits = testing; bits != 0; bits &= bits - 1)
+    {
+        const uint32_t bit = bits & (~bits + 1);
+        const Frustum& frustum = frusta[std::countr_zero(bit)];
+        if (!frustum.intersectsAABB(node.bounds))
+            testing &= ~bit;
+        else if (frustum.containsAABB(node.bounds))
+        {
+            testing &= ~bit;
+            inside |= bit;
+        }
+    }
+
+    if ((testing | inside) == 0)
+        return;
+
+    if (node.isLeaf())
+    {
+        results.push_back({node.entity, testing | inside});
+        return;
+    }
+
+    if (testing == 0)
+    {
+        collectAllLeavesMask(nodeIndex, inside, results);
+        return;
+    }
+
+    if (node.left_child >= 0)
+        queryFrustumMaskRecursive(node.left_child, frusta, testing, inside, results);
+    if (node.right_child >= 0)
+        queryFrustumMaskRecursive(node.right_child, frusta, testing, inside, results);
+}
+
+inline void SceneBVH::collectAllLeavesMask(int nodeIndex, uint32_t mask, std::vector<FrustumMaskHit>& results) const
+{
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(nodes.size())) return;
+    const BVHNode& node = nodes[nodeIndex];
+    if (node.isLeaf()) { results.push_back({node.entity, mask}); return; }
+    if (node.left_child >= 0) collectAllLeavesMask(node.left_child, mask, results);
+    if (node.right_child >= 0) collectAllLeavesMask(node.right_child, mask, results);
+}
+
 inline void SceneBVH::collectAllLeaves(int nodeIndex, std::vector<entt::entity>& results) const
 {
     if (nodeIndex < 0 || nodeIndex >= static_cast<int>(nodes.size())) return;
@@ -314,3 +412,39 @@ inline void SceneBVH::rayPickRecursive(int nodeIndex, const glm::vec3& origin, c
     if (node.right_child >= 0)
         rayPickRecursive(node.right_child, origin, direction, closest_t, closest_entity);
 }
+
+inline void SceneBVH::rayQuery(const glm::vec3& origin, const glm::vec3& direction, std::vector<BVHRayHit>& results) const
+{
+    results.clear();
+
+    if (root_index < 0 || nodes.empty())
+        return;
+
+    rayQueryRecursive(root_index, origin, direction, results);
+    std::sort(results.begin(), results.end(),
+        [](const BVHRayHit& a, const BVHRayHit& b) { return a.t_enter < b.t_enter; });
+}
+
+inline void SceneBVH::rayQueryRecursive(int nodeIndex, const glm::vec3& origin, const glm::vec3& direction,
+                                         std::vector<BVHRayHit>& results) const
+{
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(nodes.size()))
+        return;
+
+    const BVHNode& node = nodes[nodeIndex];
+
+    float tMin;
+    if (!node.bounds.intersectsRay(origin, direction, tMin))
+        return;
+
+    if (node.isLeaf())
+    {
+        results.push_back({ node.entity, std::max(tMin, 0.0f) });
+        return;
+    }
+
+    if (node.left_child >= 0)
+        rayQueryRecursive(node.left_child, origin, direction, results);
+    if (node.right_child >= 0)
+        rayQueryRecursive(node.right_child, origin, direction, results);
+}
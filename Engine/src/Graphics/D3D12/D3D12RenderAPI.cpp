@@ -773,7 +773,9 @@ void D3D12RenderAPI::ensureCommandListOpen()
     if (m_commandListOpen) return;
 
     FrameContext& fc = m_frameContexts[m_frameIndex];
+    const Uint64 fenceWaitStart = SDL_GetTicksNS();
     waitForFence(fc.fenceValue);
+    m_lastFrameStats.cpu_fence_wait_ms = static_cast<float>(SDL_GetTicksNS() - fenceWaitStart) / 1000000.0f;
     consumeFrameTiming(m_frameIndex);
 
     // Now that the fence has retired the frame we're about to reuse, advance
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+struct DynamicResolutionSettings
+{
+    bool enabled = false;
+    float budget_ms = 16.6f;        // GPU frame time to stay under
+    float headroom = 0.9f;          // Aim for this fraction of the budget
+    float min_scale = 0.5f;         // Per axis
+    float max_scale = 1.0f;
+    float forced_scale = 0.0f;      // Above zero pins the scale (tests, benchmarks, lavapipe)
+    float max_step_down = 0.15f;    // Largest change per adjustment
+    float max_step_up = 0.05f;
+    float grow_margin = 0.05f;      // Only grow when the estimate is this much above the current scale
+    uint32_t settle_frames = 3;     // Measurements ignored after a change, while frames in flight drain
+};
+
+// Picks the render scale of the resolution-dependent passes (G-buffer, lighting, SSAO) from
+// measured GPU time. Their cost is modeled as proportional to the pixel count, so a frame
+// measured at scale s predicts fixed + scaled * (s' / s)^2 at scale s'. The controller moves
+// towards the largest scale that keeps that under the budget, quickly down and slowly up.
+class DynamicResolutionController
+{
+public:
+    static constexpr float kScaleStep = 1.0f / 64.0f;    // Scales are multiples of this
+
+    void setSettings(const DynamicResolutionSettings& resolution_settings)
+    {
+        settings = resolution_settings;
+        settings.min_scale = std::clamp(settings.min_scale, kScaleStep, 1.0f);
+        settings.max_scale = std::clamp(settings.max_scale, settings.min_scale, 1.0f);
+        if (!settings.enabled)
+            reset();
+        else if (settings.forced_scale > 0.0f)
+            scale = quantize(std::clamp(settings.forced_scale, kScaleStep, 1.0f));
+        else
+            scale = std::clamp(scale, settings.min_scale, settings.max_scale);
+    }
+    const DynamicResolutionSettings& getSettings() const { return settings; }
+
+    // Feed one completed frame. frame_ms is its GPU time, scaled_ms the part spent in passes
+    // that render at the scaled resolution, and measured_scale the scale they ran at (frames
+    // in flight make it lag behind getScale()).
+    void update(float frame_ms, float scaled_ms, float measured_scale)
+    {
+        if (!settings.enabled || settings.forced_scale > 0.0f)
+            return;
+        if (frame_ms <= 0.0f || measured_scale <= 0.0f)
+            return;
+        if (settle > 0)
+        {
+            --settle;
+            return;
+        }
+
+        scaled_ms = std::clamp(scaled_ms, 0.0f, frame_ms);
+        const float full_res_ms = scaled_ms / (measured_scale * measured_scale);
+        const float fixed_ms = frame_ms - scaled_ms;
+        const float target_ms = settings.budget_ms * settings.headroom;
+
+        float wanted = settings.max_scale;
+        if (full_res_ms > 0.0f)
+            wanted = std::sqrt(std::max(target_ms - fixed_ms, 0.0f) / full_res_ms);
+        wanted = std::clamp(wanted, settings.min_scale, settings.max_scale);
+        predicted_ms = fixed_ms + full_res_ms * wanted * wanted;
+
+        float next = scale;
+        if (wanted < scale)
+            next = std::max(wanted, scale - settings.max_step_down);
+        else if (wanted > scale && wanted >= std::min(scale + settings.grow_margin, settings.max_scale))
+            next = std::min(wanted, scale + settings.max_step_up);
+
+        // Round towards the wanted scale's side so a small step down is never lost
+        next = next < scale ? std::floor(next / kScaleStep) * kScaleStep : quantize(next);
+        next = std::clamp(next, settings.min_scale, settings.max_scale);
+        if (next != scale)
+        {
+            scale = next;
+            settle = settings.settle_frames;
+        }
+    }
+
+    void reset()
+    {
+        scale = settings.enabled && settings.forced_scale > 0.0f
+                    ? quantize(std::clamp(settings.forced_scale, kScaleStep, 1.0f))
+                    : settings.max_scale;
+        settle = 0;
+        predicted_ms = 0.0f;
+    }
+
+    // 1 when disabled
+    float getScale() const { return settings.enabled ? scale : 1.0f; }
+
+    // GPU frame time expected at the scale the last update wanted
+    float getPredictedFrameMs() const { return predicted_ms; }
+
+    // Pixel extent of a width x height target rendered at the given scale
+    static uint32_t scaleExtent(uint32_t extent, float render_scale)
+    {
+        if (render_scale >= 1.0f)
+            return extent;
+        const float scaled = std::round(static_cast<float>(extent) * render_scale);
+        return std::clamp(static_cast<uint32_t>(scaled), 1u, extent);
+    }
+
+private:
+    static float quantize(float value) { return std::round(value / kScaleStep) * kScaleStep; }
+
+    DynamicResolutionSettings settings;
+    float scale = 1.0f;
+    float predicted_ms = 0.0f;
+    uint32_t settle = 0;
+};
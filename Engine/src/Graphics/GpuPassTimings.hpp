@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// GPU time of one named scope: a render graph pass, or a pass recorded outside the graph
+// such as a shadow cascade, the skybox or the UI. Scopes with the same name and depth are
+// summed over the frame, so a graph that runs once per viewport shows up once.
+struct GpuPassTiming
+{
+    std::string name;
+    uint32_t depth = 0;         // 0 at frame level, 1 for scopes nested in those, ...
+    uint32_t count = 0;         // Times it ran in the frame
+    float last_ms = 0.0f;
+    float average_ms = 0.0f;
+};
+
+struct GpuPassTimings
+{
+    bool valid = false;
+    uint64_t frame = 0;                 // Matches RenderFrameStats::completed_gpu_frame
+    float frame_ms = 0.0f;
+    float unattributed_ms = 0.0f;       // Frame time outside every top-level scope
+    float average_frame_ms = 0.0f;
+    float average_unattributed_ms = 0.0f;
+    std::vector<GpuPassTiming> passes;  // In the order they first ran
+};
+
+// Scopes recorded into one frame's command list, as pairs of timestamp queries relative to
+// the frame's slice of a query pool. Names are kept as pointers until the frame is resolved,
+// so they must outlive it (string literals, like render graph pass names).
+class GpuScopeRecorder
+{
+public:
+    static constexpr uint32_t kNoQuery = UINT32_MAX;
+
+    struct Scope
+    {
+        const char* name = "";
+        uint32_t depth = 0;
+        uint32_t begin_query = kNoQuery;
+        uint32_t end_query = kNoQuery;
+    };
+
+    void reset(uint32_t query_capacity)
+    {
+        scopes.clear();
+        open.clear();
+        capacity = query_capacity;
+        used = 0;
+        dropped = 0;
+    }
+
+    // Returns the query for the begin timestamp, or kNoQuery once the slice is full. The end
+    // query is reserved too, so a scope that was started can always be closed.
+    uint32_t begin(const char* name)
+    {
+        if (used + 2 > capacity)
+        {
+            open.push_back(kDroppedScope);
+            ++dropped;
+            return kNoQuery;
+        }
+
+        Scope scope;
+        scope.name = name ? name : "";
+        scope.depth = static_cast<uint32_t>(open.size());
+        scope.begin_query = used;
+        used += 2;
+        open.push_back(static_cast<uint32_t>(scopes.size()));
+        scopes.push_back(scope);
+        return scope.begin_query;
+    }
+
+    // Returns the query for the end timestamp of the innermost open scope, or kNoQuery
+    uint32_t end()
+    {
+        if (open.empty())
+            return kNoQuery;
+
+        const uint32_t index = open.back();
+        open.pop_back();
+        if (index == kDroppedScope)
+            return kNoQuery;
+
+        Scope& scope = scopes[index];
+        scope.end_query = scope.begin_query + 1;
+        return scope.end_query;
+    }
+
+    size_t getOpenCount() const { return open.size(); }
+    const std::vector<Scope>& getScopes() const { return scopes; }
+    uint32_t getQueryCount() const { return used; }
+    uint32_t getDroppedCount() const { return dropped; }
+
+private:
+    static constexpr uint32_t kDroppedScope = UINT32_MAX;
+
+    std::vector<Scope> scopes;
+    std::vector<uint32_t> open;     // Stack of indices into scopes
+    uint32_t capacity = 0;
+    uint32_t used = 0;
+    uint32_t dropped = 0;
+};
+
+// Turns the timestamps of completed frames into per-scope times with rolling averages.
+// Backend independent: the backend reads its query results back and hands them over.
+class GpuPassTimingHistory
+{
+public:
+    static constexpr uint32_t kWindow = 60;                 // Frames in the rolling average
+    static constexpr uint64_t kUnavailable = UINT64_MAX;    // Query result not written
+
+    // timestamps holds recorder.getQueryCount() values in ticks; ms_per_tick converts them.
+    // frame_ms is the GPU time of the whole frame, or negative to use the span of its
+    // top-level scopes.
+    void resolve(const GpuScopeRecorder& recorder, const uint64_t* timestamps, double ms_per_tick,
+                 float frame_ms, uint64_t frame)
+    {
+        frame_entries.clear();
+        float top_level_ms = 0.0f;
+        uint64_t first_tick = UINT64_MAX;
+        uint64_t last_tick = 0;
+
+        for (const GpuScopeRecorder::Scope& scope : recorder.getScopes())
+        {
+            if (scope.end_query == GpuScopeRecorder::kNoQuery)
+                continue;
+            const uint64_t begin = timestamps[scope.begin_query];
+            const uint64_t end = timestamps[scope.end_query];
+            if (begin == kUnavailable || end == kUnavailable || end < begin)
+                continue;
+
+            const float ms = static_cast<float>(static_cast<double>(end - begin) * ms_per_tick);
+            if (scope.depth == 0)
+            {
+                top_level_ms += ms;
+                first_tick = std::min(first_tick, begin);
+                last_tick = std::max(last_tick, end);
+            }
+
+            auto it = std::find_if(frame_entries.begin(), frame_entries.end(), [&](const FrameEntry& entry) {
+                return entry.depth == scope.depth && std::strcmp(entry.name, scope.name) == 0;
+            });
+            if (it == frame_entries.end())
+                frame_entries.push_back({scope.name, scope.depth, 1, ms});
+            else
+            {
+                ++it->count;
+                it->ms += ms;
+            }
+        }
+
+        if (frame_ms < 0.0f)
+            frame_ms = first_tick <= last_tick
+                           ? static_cast<float>(static_cast<double>(last_tick - first_tick) * ms_per_tick)
+                           : 0.0f;
+        const float unattributed_ms = std::max(frame_ms - top_level_ms, 0.0f);
+        frame_average.push(frame_ms);
+        unattributed_average.push(unattributed_ms);
+
+        for (Series& series : history)
+            series.seen = false;
+        timings.passes.resize(frame_entries.size());
+        for (size_t i = 0; i < frame_entries.size(); ++i)
+        {
+            const FrameEntry& entry = frame_entries[i];
+            Series& series = findSeries(entry.name, entry.depth);
+            series.seen = true;
+            series.absent_frames = 0;
+            series.average.push(entry.ms);
+
+            GpuPassTiming& timing = timings.passes[i];
+            timing.name = series.name;
+            timing.depth = entry.depth;
+            timing.count = entry.count;
+            timing.last_ms = entry.ms;
+            timing.average_ms = series.average.get();
+        }
+
+        // Passes that stop running average down to zero, then drop out
+        for (Series& series : history)
+        {
+            if (!series.seen)
+            {
+                series.average.push(0.0f);
+                ++series.absent_frames;
+            }
+        }
+        history.erase(std::remove_if(history.begin(), history.end(),
+                                     [](const Series& series) { return series.absent_frames >= kWindow; }),
+                      history.end());
+
+        timings.valid = true;
+        timings.frame = frame;
+        timings.frame_ms = frame_ms;
+        timings.unattributed_ms = unattributed_ms;
+        timings.average_frame_ms = frame_average.get();
+        timings.average_unattributed_ms = unattributed_average.get();
+    }
+
+    void clear()
+    {
+        history.clear();
+        frame_average = {};
+        unattributed_average = {};
+        timings = {};
+    }
+
+    const GpuPassTimings& getTimings() const { return timings; }
+
+private:
+    struct RollingAverage
+    {
+        std::array<float, kWindow> samples{};
+        uint32_t count = 0;
+        uint32_t head = 0;
+
+        void push(float value)
+        {
+            samples[head] = value;
+            head = (head + 1) % kWindow;
+            count = std::min(count + 1, kWindow);
+        }
+
+        float get() const
+        {
+            float sum = 0.0f;
+            for (uint32_t i = 0; i < count; ++i)
+                sum += samples[i];
+            return count > 0 ? sum / static_cast<float>(count) : 0.0f;
+        }
+    };
+
+    struct Series
+    {
+        std::string name;
+        uint32_t depth = 0;
+        uint32_t absent_frames = 0;
+        bool seen = false;
+        RollingAverage average;
+    };
+
+    struct FrameEntry
+    {
+        const char* name;
+        uint32_t depth;
+        uint32_t count;
+        float ms;
+    };
+
+    Series& findSeries(const char* name, uint32_t depth)
+    {
+        for (Series& series : history)
+        {
+            if (series.depth == depth && series.name == name)
+                return series;
+        }
+        Series& series = history.emplace_back();
+        series.name = name;
+        series.depth = depth;
+        return series;
+    }
+
+    std::vector<Series> history;
+    std::vector<FrameEntry> frame_entries;
+    RollingAverage frame_average;
+    RollingAverage unattributed_average;
+    GpuPassTimings timings;
+};
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Frustum.hpp"
+#include "Utils/Vertex.hpp"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Triangle BVH over a mesh's CPU vertex data (local space).
+// Meshes are non-indexed triangle lists, so triangle i is vertices [3i, 3i+2].
+// Built on demand for picking; positions are copied so the BVH does not
+// depend on the lifetime of the mesh's vertex array.
+class MeshBVH
+{
+public:
+    MeshBVH() = default;
+
+    // Build from a triangle list. Trailing vertices that do not form a full
+    // triangle are ignored.
+    void build(const vertex* vertices, size_t vertex_count);
+
+    bool empty() const { return nodes.empty(); }
+    size_t getTriangleCount() const { return triangles.size(); }
+    size_t getNodeCount() const { return nodes.size(); }
+    AABB getBounds() const { return nodes.empty() ? AABB() : nodes[0].bounds; }
+
+    // Closest triangle hit along origin + t * direction with 0 <= t <= max_t.
+    // direction does not need to be normalized; t is in units of direction.
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float max_t, float& out_t) const;
+
+    // True if any triangle is at least partially inside the frustum.
+    // Conservative like Frustum::intersectsAABB: a triangle is rejected only
+    // when all three corners are outside the same plane.
+    bool intersectsFrustum(const Frustum& frustum) const;
+
+private:
+    struct Triangle
+    {
+        glm::vec3 v0, v1, v2;
+    };
+
+    struct BuildTriangle
+    {
+        Triangle tri;
+        glm::vec3 centroid;
+    };
+
+    struct Node
+    {
+        AABB bounds;
+        uint32_t first = 0;  // Leaf: first triangle. Interior: left child (right = first + 1)
+        uint32_t count = 0;  // Triangle count, 0 for interior nodes
+    };
+
+    static constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+    static constexpr int MAX_STACK_DEPTH = 64;
+
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+
+    void subdivide(uint32_t node_index, std::vector<BuildTriangle>& build_tris, int depth);
+
+    static bool intersectTriangle(const Triangle& tri, const glm::vec3& origin, const glm::vec3& direction,
+                                  float max_t, float& out_t);
+    static bool triangleOutsideFrustum(const Triangle& tri, const Frustum& frustum);
+};
+
+// Implementation
+
+inline void MeshBVH::build(const vertex* vertices, size_t vertex_count)
+{
+    nodes.clear();
+    triangles.clear();
+
+    const size_t triangle_count = vertices ? vertex_count / 3 : 0;
+    if (triangle_count == 0)
+        return;
+
+    std::vector<BuildTriangle> build_tris(triangle_count);
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        const vertex& a = vertices[i * 3 + 0];
+        const vertex& b = vertices[i * 3 + 1];
+        const vertex& c = vertices[i * 3 + 2];
+        BuildTriangle& bt = build_tris[i];
+        bt.tri = { glm::vec3(a.vx, a.vy, a.vz), glm::vec3(b.vx, b.vy, b.vz), glm::vec3(c.vx, c.vy, c.vz) };
+        bt.centroid = (bt.tri.v0 + bt.tri.v1 + bt.tri.v2) * (1.0f / 3.0f);
+    }
+
+    // Worst case 2n-1 nodes for n single-triangle leaves
+    nodes.reserve(triangle_count * 2);
+    nodes.emplace_back();
+    nodes[0].first = 0;
+    nodes[0].count = static_cast<uint32_t>(triangle_count);
+    subdivide(0, build_tris, 0);
+
+    triangles.reserve(triangle_count);
+    for (const BuildTriangle& bt : build_tris)
+        triangles.push_back(bt.tri);
+}
+
+inline void MeshBVH::subdivide(uint32_t node_index, std::vector<BuildTriangle>& build_tris, int depth)
+{
+    Node& node = nodes[node_index];
+    node.bounds.reset();
+    AABB centroid_bounds;
+    for (uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+        node.bounds.expand(build_tris[i].tri.v0);
+        node.bounds.expand(build_tris[i].tri.v1);
+        node.bounds.expand(build_tris[i].tri.v2);
+        centroid_bounds.expand(build_tris[i].centroid);
+    }
+
+    if (node.count <= MAX_LEAF_TRIANGLES || depth >= MAX_STACK_DEPTH - 2)
+        return;
+
+    // Median split on the longest centroid axis
+    const glm::vec3 extent = centroid_bounds.getSize();
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+    if (extent[axis] <= 0.0f)
+        return;  // All centroids coincide; splitting would not separate anything
+
+    const uint32_t first = node.first;
+    const uint32_t count = node.count;
+    const uint32_t mid = count / 2;
+    std::nth_element(build_tris.begin() + first, build_tris.begin() + first + mid, build_tris.begin() + first + count,
+        [axis](const BuildTriangle& a, const BuildTriangle& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+    const uint32_t left_index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[left_index].first = first;
+    nodes[left_index].count = mid;
+    nodes[left_index + 1].first = first + mid;
+    nodes[left_index + 1].count = count - mid;
+
+    // Re-reference: the vector may have grown
+    nodes[node_index].first = left_index;
+    nodes[node_index].count = 0;
+
+    subdivide(left_index, build_tris, depth + 1);
+    subdivide(left_index + 1, build_tris, depth + 1);
+}
+
+// Moller-Trumbore, two-sided (editor picking ignores back-face culling)
+inline bool MeshBVH::intersectTriangle(const Triangle& tri, const glm::vec3& origin, const glm::vec3& direction,
+                                       float max_t, float& out_t)
+{
+    const glm::vec3 edge1 = tri.v1 - tri.v0;
+    const glm::vec3 edge2 = tri.v2 - tri.v0;
+    const glm::vec3 p = glm::cross(direction, edge2);
+    const float det = glm::dot(edge1, p);
+    if (std::abs(det) < 1e-12f)
+        return false;
+
+    const float inv_det = 1.0f / det;
+    const glm::vec3 s = origin - tri.v0;
+    const float u = glm::dot(s, p) * inv_det;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    const glm::vec3 q = glm::cross(s, edge1);
+    const float v = glm::dot(direction, q) * inv_det;
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    const float t = glm::dot(edge2, q) * inv_det;
+    if (t < 0.0f || t > max_t)
+        return false;
+
+    out_t = t;
+    return true;
+}
+
+inline bool MeshBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float max_t, float& out_t) const
+{
+    if (nodes.empty())
+        return false;
+
+    float closest = max_t;
+    bool hit = false;
+
+    uint32_t stack[MAX_STACK_DEPTH];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        const Node& node = nodes[stack[--stack_size]];
+
+        float t_enter;
+        if (!node.bounds.intersectsRay(origin, direction, t_enter) || t_enter > closest)
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i)
+            {
+                float t;
+                if (intersectTriangle(triangles[i], origin, direction, closest, t))
+                {
+                    closest = t;
+                    hit = true;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next
+        float t_left = std::numeric_limits<float>::max();
+        float t_right = std::numeric_limits<float>::max();
+        const bool hit_left = nodes[node.first].bounds.intersectsRay(origin, direction, t_left);
+        const bool hit_right = nodes[node.first + 1].bounds.intersectsRay(origin, direction, t_right);
+        if (hit_left && hit_right)
+        {
+            const bool left_first = t_left <= t_right;
+            stack[stack_size++] = left_first ? node.first + 1 : node.first;
+            stack[stack_size++] = left_first ? node.first : node.first + 1;
+        }
+        else if (hit_left)
+        {
+            stack[stack_size++] = node.first;
+        }
+        else if (hit_right)
+        {
+            stack[stack_size++] = node.first + 1;
+        }
+    }
+
+    if (hit)
+        out_t = closest;
+    return hit;
+}
+
+inline bool MeshBVH::triangleOutsideFrustum(const Triangle& tri, const Frustum& frustum)
+{
+    for (int i = 0; i < Frustum::PLANE_COUNT; ++i)
+    {
+        const Plane& plane = frustum.planes[i];
+        if (plane.distanceToPoint(tri.v0) < 0.0f &&
+            plane.distanceToPoint(tri.v1) < 0.0f &&
+            plane.distanceToPoint(tri.v2) < 0.0f)
+            return true;
+    }
+    return false;
+}
+
+inline bool MeshBVH::intersectsFrustum(const Frustum& frustum) const
+{
+    if (nodes.empty())
+        return false;
+
+    uint32_t stack[MAX_STACK_DEPTH];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        const Node& node = nodes[stack[--stack_size]];
+
+        if (!frustum.intersectsAABB(node.bounds))
+            continue;
+
+        // Every node holds at least one triangle, so full containment is a hit
+        if (frustum.containsAABB(node.bounds))
+            return true;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i)
+            {
+                if (!triangleOutsideFrustum(triangles[i], frustum))
+                    return true;
+            }
+            continue;
+        }
+
+        stack[stack_size++] = node.first;
+        stack[stack_size++] = node.first + 1;
+    }
+
+    return false;
+}
@@ -15,10 +15,13 @@
 #include <algorithm>
 #include <memory>
 
+#include "DynamicResolution.hpp"
+#include "GpuPassTimings.hpp"
 #include "SceneViewport.hpp"
 
 // Forward declaration for command buffer
 class RenderCommandBuffer;
+struct DecalFrame;
 
 // Forward declaration for SDL
 struct SDL_Window;
@@ -76,6 +79,7 @@ struct RenderFrameStats
     bool gpu_frame_ms_valid = false;
     float gpu_frame_ms = 0.0f;
     uint64_t completed_gpu_frame = 0;
+    float cpu_fence_wait_ms = 0.0f;  // CPU time blocked on the frame-in-flight fence this frame
     uint64_t submitted_draw_commands = 0;
     uint64_t backend_draw_calls = 0;
     uint64_t instanced_batches = 0;
@@ -218,6 +222,10 @@ public:
     // small buffers or if the backend doesn't support parallel replay.
     virtual void replayCommandBufferParallel(const RenderCommandBuffer& cmds) { replayCommandBuffer(cmds); }
 
+    // Instances per frame the backend can draw from RenderCommandBuffer::recordDrawInstanced.
+    // 0 if it cannot; callers then record one draw per instance instead.
+    virtual uint32_t getInstanceCapacity() const { return 0; }
+
     // Deferred rendering controls. `isDeferredEnabled` reflects the desired
     // toggle (matches the r_deferred CVar). `isDeferredActive` reports whether
     // it is currently in effect (desired AND backend resources initialized).
@@ -228,6 +236,11 @@ public:
     virtual void submitDeferredOpaqueCommands(const RenderCommandBuffer& cmds) { (void)cmds; }
     virtual void submitDeferredTransparentCommands(const RenderCommandBuffer& cmds) { (void)cmds; }
 
+    // Decals of the next deferred frame, blended into the GBuffer base color
+    // between the GBuffer and lighting passes. Backends without a decal pass
+    // ignore them.
+    virtual void submitDeferredDecals(const DecalFrame& decals) { (void)decals; }
+
     // Populate the backend light StructuredBuffers. Supports up to a
     // backend-specific cap (256 per kind on D3D12/Vulkan).
     virtual void uploadLightBuffers(const GPUPointLight* pts, int ptCount,
@@ -244,6 +257,10 @@ public:
         return stats;
     }
 
+    // Per-pass GPU times of the most recent completed frame, with rolling averages.
+    // Invalid on backends without timestamp queries.
+    virtual GpuPassTimings getGpuPassTimings() const { return {}; }
+
     // Graphics settings
     virtual void setVSyncEnabled(bool enabled) { (void)enabled; }
     virtual bool isVSyncEnabled() const { return true; }
@@ -256,6 +273,12 @@ public:
     virtual bool isSSAOEnabled() const { return false; }
     virtual void setSSAORadius(float radius) { (void)radius; }
     virtual void setSSAOIntensity(float intensity) { (void)intensity; }
+
+    // Dynamic resolution of the deferred path: scene passes render at a fraction of the
+    // target size picked from measured GPU time, then get upscaled. getRenderScale is the
+    // per-axis scale of the next frame, 1 when disabled or unsupported.
+    virtual void setDynamicResolution(const DynamicResolutionSettings& settings) { (void)settings; }
+    virtual float getRenderScale() const { return 1.0f; }
     virtual bool supportsHeightmapDisplacement() const { return false; }
 
     // Autorelease pool support (Metal needs ObjC temporaries drained each frame)
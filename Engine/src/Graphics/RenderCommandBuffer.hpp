@@ -105,6 +105,11 @@ struct DrawCommand
     // For range draws (renderMeshRange). If vertex_count == 0, draw entire mesh.
     size_t start_vertex = 0;
     size_t vertex_count = 0;
+
+    // Instanced draws (recordDrawInstanced): one copy per transform in the buffer's
+    // instance transforms, model_matrix unused. 0 for a regular draw.
+    uint32_t instance_offset = 0;
+    uint32_t instance_count = 0;
 };
 
 // CPU-side command buffer that stores a flat list of self-contained draw commands.
@@ -216,6 +221,51 @@ public:
         m_commands.push_back(cmd);
     }
 
+    // Record one draw of the whole mesh per instance. Returns the instance_count transforms
+    // to fill in, valid until the next record call on this buffer. Only backends that report
+    // an instance capacity (IRenderAPI::getInstanceCapacity) draw these.
+    glm::mat4* recordDrawInstanced(IGPUMesh* gpu_mesh, size_t instance_count,
+                                   TextureHandle texture, bool use_texture,
+                                   const PSOKey& pso_key, const glm::vec3& color = glm::vec3(1.0f))
+    {
+        DrawCommand cmd;
+        cmd.gpu_mesh = gpu_mesh;
+        cmd.texture = texture;
+        cmd.use_texture = use_texture;
+        cmd.pso_key = pso_key;
+        cmd.color = color;
+        return recordInstanced(cmd, instance_count);
+    }
+
+    // Same, for a fully described command (material ranges, PBR state). Its model_matrix is unused.
+    glm::mat4* recordInstanced(DrawCommand cmd, size_t instance_count)
+    {
+        cmd.instance_offset = static_cast<uint32_t>(m_instance_transforms.size());
+        cmd.instance_count = static_cast<uint32_t>(instance_count);
+        m_commands.push_back(cmd);
+        m_instance_transforms.resize(m_instance_transforms.size() + instance_count);
+        return m_instance_transforms.data() + cmd.instance_offset;
+    }
+
+    // Record cmd over the transforms of an earlier instanced draw of this buffer, e.g. the
+    // other material ranges of the same mesh
+    void recordInstancedShared(DrawCommand cmd, const DrawCommand& instances)
+    {
+        cmd.instance_offset = instances.instance_offset;
+        cmd.instance_count = instances.instance_count;
+        m_commands.push_back(cmd);
+    }
+
+    const glm::mat4* instanceTransforms(const DrawCommand& cmd) const
+    {
+        return m_instance_transforms.data() + cmd.instance_offset;
+    }
+    glm::mat4* instanceTransforms(const DrawCommand& cmd)
+    {
+        return m_instance_transforms.data() + cmd.instance_offset;
+    }
+    bool hasInstancedDraws() const { return !m_instance_transforms.empty(); }
+
     // Sort commands to minimize state changes (by PSO key, then texture).
     // Only use for opaque draws -- transparent draws must maintain back-to-front order.
     void sort()
@@ -256,8 +306,10 @@ public:
     // Append all commands from another buffer (for merging parallel results)
     void append(const RenderCommandBuffer& other)
     {
+        const size_t first = m_commands.size();
         m_commands.insert(m_commands.end(),
                           other.m_commands.begin(), other.m_commands.end());
+        appendInstanceTransforms(other, first);
     }
 
     // Move-append for efficiency
@@ -266,17 +318,25 @@ public:
         if (m_commands.empty())
         {
             m_commands = std::move(other.m_commands);
+            m_instance_transforms = std::move(other.m_instance_transforms);
         }
         else
         {
+            const size_t first = m_commands.size();
             m_commands.insert(m_commands.end(),
                               std::make_move_iterator(other.m_commands.begin()),
                               std::make_move_iterator(other.m_commands.end()));
+            appendInstanceTransforms(other, first);
             other.m_commands.clear();
+            other.m_instance_transforms.clear();
         }
     }
 
-    void clear() { m_commands.clear(); }
+    void clear()
+    {
+        m_commands.clear();
+        m_instance_transforms.clear();
+    }
     size_t size() const { return m_commands.size(); }
     bool empty() const { return m_commands.empty(); }
 
@@ -288,6 +348,21 @@ public:
     auto end() const { return m_commands.end(); }
 
 private:
+    // Copies other's instance transforms after ours and rebases the commands appended at first
+    void appendInstanceTransforms(const RenderCommandBuffer& other, size_t first)
+    {
+        if (other.m_instance_transforms.empty())
+            return;
+        const uint32_t base = static_cast<uint32_t>(m_instance_transforms.size());
+        m_instance_transforms.insert(m_instance_transforms.end(),
+                                     other.m_instance_transforms.begin(), other.m_instance_transforms.end());
+        for (size_t i = first; i < m_commands.size(); ++i)
+        {
+            if (m_commands[i].instance_count > 0)
+                m_commands[i].instance_offset += base;
+        }
+    }
+
     static glm::mat4 computeNormalMatrix(const glm::mat4& model_matrix)
     {
         glm::mat3 normalMat3 = glm::mat3(model_matrix);
@@ -298,4 +373,5 @@ private:
     }
 
     std::vector<DrawCommand> m_commands;
+    std::vector<glm::mat4> m_instance_transforms;
 };
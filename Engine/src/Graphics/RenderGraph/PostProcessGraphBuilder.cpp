@@ -1,7 +1,14 @@
 #include "PostProcessGraphBuilder.hpp"
+#include <memory>
 
-void PostProcessGraphBuilder::build(RenderGraph& graph, RGBackend& backend, const Config& cfg)
+void PostProcessGraphBuilder::build(RenderGraph& graph, RGBackend& backend, const Config& config)
 {
+    Config cfg = config;
+    if (!supportsRenderScale() || cfg.sceneWidth() > cfg.width || cfg.sceneHeight() > cfg.height) {
+        cfg.renderWidth  = 0;
+        cfg.renderHeight = 0;
+    }
+
     graph.reset();
     graph.setReferenceResolution(cfg.width, cfg.height);
 
@@ -9,12 +16,15 @@ void PostProcessGraphBuilder::build(RenderGraph& graph, RGBackend& backend, cons
     addScenePasses(graph, h, cfg);
     addPostProcessPasses(graph, h, cfg);
 
-    graph.compile();
+    RGCompileOptions options;
+    options.asyncCompute = backend.supportsAsyncCompute();
+    graph.compile(options);
     graph.execute(backend);
 }
 
-void PostProcessGraphBuilder::addPostProcessPasses(RenderGraph& graph, const Handles& h, const Config& cfg)
+void PostProcessGraphBuilder::addPostProcessPasses(RenderGraph& graph, const Handles& handles, const Config& cfg)
 {
+    Handles h = handles;
     const RGResourceUsage depthRead = depthReadUsage();
 
     if (h.skyboxEnabled) {
@@ -64,9 +74,28 @@ void PostProcessGraphBuilder::addPostProcessPasses(RenderGraph& graph, const Han
 
     addPreTonemapPasses(graph, h, cfg);
 
+    if (cfg.upscale()) {
+        // The target is created during setup, after the execute callback has been built
+        auto uh = std::make_shared<Handles>(h);
+        graph.addPass("Upscale",
+            [&, uh](RGBuilder& b) {
+                RGTextureDesc desc;
+                desc.width     = cfg.width;
+                desc.height    = cfg.height;
+                desc.format    = RGFormat::RGBA16_FLOAT;
+                desc.debugName = "UpscaledHDR";
+                uh->upscaledHDR = b.createTexture(desc);
+                b.read(uh->offscreenHDR, RGResourceUsage::CopySource);
+                b.write(uh->upscaledHDR, RGResourceUsage::CopyDest);
+            },
+            [this, uh, cfg](RGContext& ctx) { this->recordUpscale(ctx, *uh, cfg); });
+        h.upscaledHDR = uh->upscaledHDR;
+    }
+    const RGTextureHandle sceneColor = h.upscaledHDR.isValid() ? h.upscaledHDR : h.offscreenHDR;
+
     graph.addPass("Tonemapping",
         [&](RGBuilder& b) {
-            b.read(h.offscreenHDR, RGResourceUsage::ShaderResource);
+            b.read(sceneColor, RGResourceUsage::ShaderResource);
             if (cfg.wantSSAO && h.ssaoBlurV.isValid())
                 b.read(h.ssaoBlurV, RGResourceUsage::ShaderResource);
             if (cfg.wantShadowMask && h.shadowMask.isValid())
@@ -89,4 +118,14 @@ void PostProcessGraphBuilder::addPostProcessPasses(RenderGraph& graph, const Han
             },
             [](RGContext&) {});
     }
+
+    // Likewise for the scene color the Upscale pass left as a copy source
+    if (h.upscaledHDR.isValid()) {
+        graph.addPass("HDRRestore",
+            [&](RGBuilder& b) {
+                b.read(h.offscreenHDR, RGResourceUsage::ShaderResource);
+                b.setSideEffect();
+            },
+            [](RGContext&) {});
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EngineGraphicsExport.h"
 #include "RenderGraph.hpp"
 #include "RGBackend.hpp"
 #include "RGBuilder.hpp"
@@ -9,7 +10,7 @@
 // Declares the pass graph (Skybox, SSAO, ShadowMask, Tonemapping, ...) once,
 // and delegates backend-specific work (resource import, pass recording,
 // optional extra passes like Present / DepthRestore) to derived classes.
-class PostProcessGraphBuilder {
+class ENGINE_GRAPHICS_API PostProcessGraphBuilder {
 public:
     struct Config {
         uint32_t width          = 0;
@@ -18,6 +19,16 @@ public:
         bool     wantShadowMask = false;
         bool     renderImGui    = false;
         bool     renderRml      = false;
+
+        // Dynamic resolution: the scene passes (G-buffer, lighting, SSAO, ...) render into the
+        // top-left renderWidth x renderHeight of the width x height targets, and an Upscale
+        // pass stretches that over the whole frame before tonemapping. 0 renders at full size.
+        uint32_t renderWidth    = 0;
+        uint32_t renderHeight   = 0;
+
+        uint32_t sceneWidth()  const { return renderWidth  ? renderWidth  : width; }
+        uint32_t sceneHeight() const { return renderHeight ? renderHeight : height; }
+        bool     upscale()     const { return sceneWidth() < width || sceneHeight() < height; }
     };
 
     struct Handles {
@@ -29,6 +40,7 @@ public:
         RGTextureHandle ssaoBlurH;
         RGTextureHandle ssaoBlurV;
         RGTextureHandle shadowMask;
+        RGTextureHandle upscaledHDR; // Full-size copy of offscreenHDR when cfg.upscale()
 
         bool skyboxEnabled     = false;
         bool ssaoEnabled       = false;
@@ -61,6 +73,12 @@ protected:
     virtual void recordShadowMask (RGContext& ctx, const Handles& h, const Config& cfg) = 0;
     virtual void recordTonemapping(RGContext& ctx, const Handles& h, const Config& cfg) = 0;
 
+    // Dynamic resolution. Backends that return true render the scene passes at
+    // cfg.sceneWidth() x cfg.sceneHeight() and implement recordUpscale (offscreenHDR's scene
+    // rectangle to all of upscaledHDR). Otherwise build() ignores the render size.
+    virtual bool supportsRenderScale() const { return false; }
+    virtual void recordUpscale(RGContext& ctx, const Handles& h, const Config& cfg) { (void)ctx; (void)h; (void)cfg; }
+
     virtual void addExtraPasses(RenderGraph& graph, const Handles& h, const Config& cfg) { (void)graph; (void)h; (void)cfg; }
 
     // Hook invoked after Skybox/SSAO/ShadowMask but before Tonemapping. Subclasses
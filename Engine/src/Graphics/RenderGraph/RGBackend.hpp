@@ -2,6 +2,7 @@
 
 #include "RGTypes.hpp"
 #include "RGPass.hpp"
+#include "RGCompiler.hpp"
 
 // Abstract backend interface for render graph execution.
 // Implemented by D3D12RGBackend, VulkanRGBackend, etc.
@@ -29,4 +30,30 @@ public:
     // Begin/end frame-level bookkeeping.
     virtual void beginFrame() = 0;
     virtual void endFrame() = 0;
+
+    // Bracket each executed pass, including the barriers flushed for it (GPU timestamps,
+    // debug markers). No-op by default.
+    virtual void beginPass(const char* name) { (void)name; }
+    virtual void endPass() {}
+
+    // --- Async compute ---
+    // A backend with a separate compute queue returns true; the graph is then compiled with
+    // compute passes on that queue and the calls below are made while it executes. Backends
+    // without one leave these alone and see every pass on the graphics queue.
+    virtual bool supportsAsyncCompute() const { return false; }
+
+    // Following commands (passes, barriers, signals, waits) are recorded for this queue.
+    virtual void setActiveQueue(RGQueueType queue) { (void)queue; }
+
+    // Cross-queue sync points, by index into RGCompileResult::queueSyncs. signalSync is
+    // recorded on the signaling queue after the pass it follows, waitSync on the waiting
+    // queue before the pass it guards.
+    virtual void signalSync(RGQueueType queue, uint32_t syncIndex) { (void)queue; (void)syncIndex; }
+    virtual void waitSync(RGQueueType queue, uint32_t syncIndex) { (void)queue; (void)syncIndex; }
+
+    // The two halves of a queue ownership transfer (barrier.isQueueTransfer()). Release is
+    // recorded on barrier.srcQueue, acquire on barrier.dstQueue; both are flushed by
+    // flushBarriers() like any other barrier.
+    virtual void releaseOwnership(const RGBarrier& barrier) { (void)barrier; }
+    virtual void acquireOwnership(const RGBarrier& barrier) { (void)barrier; }
 };
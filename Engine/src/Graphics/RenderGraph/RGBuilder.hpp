@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EngineGraphicsExport.h"
 #include "RGTypes.hpp"
 #include "RGPass.hpp"
 #include <vector>
@@ -7,7 +8,7 @@
 class RenderGraph;
 
 // Per-pass builder: used inside addPass() setup callbacks to declare resource access.
-class RGBuilder {
+class ENGINE_GRAPHICS_API RGBuilder {
 public:
     // Declare that this pass reads a texture.
     RGTextureHandle read(RGTextureHandle texture,
@@ -26,7 +27,8 @@ public:
     // Mark this pass as having side effects (prevents culling).
     void setSideEffect();
 
-    // Set pass queue type.
+    // Set pass queue type. Compute passes go to the async compute queue when the backend
+    // has one, and run on the graphics queue otherwise.
     void setQueue(RGQueueType queue);
 
 private:
@@ -6,7 +6,8 @@
 
 RGCompileResult RGCompiler::compile(std::vector<RGPassNode>& passes,
                                     std::vector<RGResourceNode>& resources,
-                                    uint32_t refWidth, uint32_t refHeight)
+                                    uint32_t refWidth, uint32_t refHeight,
+                                    const RGCompileOptions& options)
 {
     RGCompileResult result;
 
@@ -33,8 +34,11 @@ RGCompileResult RGCompiler::compile(std::vector<RGPassNode>& passes,
     // Step 5: Compute resource lifetimes
     computeLifetimes(passes, resources, result.executionOrder);
 
-    // Step 6: Schedule barriers
-    result.barriers = scheduleBarriers(passes, resources, result.executionOrder);
+    // Step 6: Assign queues
+    result.passQueues = assignQueues(passes, result.executionOrder, options);
+
+    // Step 7: Schedule barriers and cross-queue syncs
+    scheduleBarriers(passes, resources, result);
 
     result.valid = true;
     return result;
@@ -247,29 +251,90 @@ void RGCompiler::computeLifetimes(const std::vector<RGPassNode>& passes,
     }
 }
 
-std::vector<RGBarrier> RGCompiler::scheduleBarriers(
-    const std::vector<RGPassNode>& passes,
-    const std::vector<RGResourceNode>& resources,
-    const std::vector<uint32_t>& executionOrder)
+std::vector<RGQueueType> RGCompiler::assignQueues(const std::vector<RGPassNode>& passes,
+                                                  const std::vector<uint32_t>& executionOrder,
+                                                  const RGCompileOptions& options)
+{
+    // Compute passes go to the compute queue when there is one. Everything else, and every
+    // pass when there is none, runs on the graphics queue in execution order.
+    std::vector<RGQueueType> queues(executionOrder.size(), RGQueueType::Graphics);
+    if (!options.asyncCompute)
+        return queues;
+
+    for (uint32_t orderIdx = 0; orderIdx < static_cast<uint32_t>(executionOrder.size()); ++orderIdx)
+    {
+        if (passes[executionOrder[orderIdx]].queue == RGQueueType::Compute)
+            queues[orderIdx] = RGQueueType::Compute;
+    }
+    return queues;
+}
+
+void RGCompiler::scheduleBarriers(const std::vector<RGPassNode>& passes,
+                                  const std::vector<RGResourceNode>& resources,
+                                  RGCompileResult& result)
 {
-    std::vector<RGBarrier> barriers;
+    const auto& executionOrder = result.executionOrder;
+    const auto& passQueues = result.passQueues;
+    const uint32_t passCount = static_cast<uint32_t>(executionOrder.size());
+    auto& barriers = result.barriers;
+    auto& syncs = result.queueSyncs;
+
+    result.usesAsyncCompute = std::find(passQueues.begin(), passQueues.end(), RGQueueType::Compute)
+                              != passQueues.end();
 
     // Track the current usage of each resource
     std::unordered_map<uint16_t, RGResourceUsage> currentUsage;
 
+    // Resources are exclusively owned by one queue at a time. A resource has no owner until
+    // it is first accessed, unless it is imported: those come from the graphics queue.
+    struct Ownership {
+        RGQueueType queue;
+        uint32_t    lastAccess; // execution order index on the owning queue, or kRGGraphStart
+    };
+    std::unordered_map<uint16_t, Ownership> owners;
+
     // Initialize imported resources to their import usage
     for (uint16_t ri = 0; ri < static_cast<uint16_t>(resources.size()); ++ri)
     {
         if (resources[ri].imported)
+        {
             currentUsage[ri] = resources[ri].importUsage;
+            owners[ri] = {RGQueueType::Graphics, kRGGraphStart};
+        }
     }
 
-    for (uint32_t orderIdx = 0; orderIdx < static_cast<uint32_t>(executionOrder.size()); ++orderIdx)
+    // Last signal each queue has waited on, per signaling queue. Work on a queue runs in
+    // order, so waiting on a later pass covers every earlier one.
+    constexpr uint32_t kQueueCount = 3;
+    constexpr int64_t kNotWaited = -2; // kRGGraphStart is stored as -1
+    int64_t waited[kQueueCount][kQueueCount];
+    for (auto& row : waited)
+        std::fill(std::begin(row), std::end(row), kNotWaited);
+
+    auto position = [](uint32_t orderIdx) {
+        return orderIdx == kRGGraphStart ? int64_t(-1) : int64_t(orderIdx);
+    };
+    auto addSync = [&](RGQueueType signalQueue, uint32_t signalAfterPass,
+                       RGQueueType waitQueue, uint32_t waitBeforePass) {
+        int64_t& last = waited[static_cast<uint32_t>(waitQueue)][static_cast<uint32_t>(signalQueue)];
+        if (position(signalAfterPass) <= last)
+            return;
+        last = position(signalAfterPass);
+        syncs.push_back({signalQueue, signalAfterPass, waitQueue, waitBeforePass});
+    };
+
+    // Dependencies of the current pass on other queues: latest pass to wait for per queue
+    int64_t dependency[kQueueCount];
+
+    for (uint32_t orderIdx = 0; orderIdx < passCount; ++orderIdx)
     {
         uint32_t passIdx = executionOrder[orderIdx];
         const auto& pass = passes[passIdx];
         if (pass.culled) continue;
 
+        const RGQueueType queue = passQueues[orderIdx];
+        std::fill(std::begin(dependency), std::end(dependency), kNotWaited);
+
         for (const auto& access : pass.accesses)
         {
             auto it = currentUsage.find(access.handle.index);
@@ -277,15 +342,66 @@ std::vector<RGBarrier> RGCompiler::scheduleBarriers(
                 ? it->second
                 : RGResourceUsage::Undefined;
 
-            if (prevUsage != access.usage)
+            auto owner = owners.find(access.handle.index);
+            if (owner != owners.end() && owner->second.queue != queue)
+            {
+                // Move the resource to this queue. The release goes right after the owner's
+                // last access, and this pass waits for it.
+                RGBarrier transfer{access.handle, prevUsage, access.usage, orderIdx};
+                transfer.srcQueue = owner->second.queue;
+                transfer.dstQueue = queue;
+                transfer.releaseAfterPass = owner->second.lastAccess;
+                barriers.push_back(transfer);
+
+                int64_t& dep = dependency[static_cast<uint32_t>(owner->second.queue)];
+                dep = std::max(dep, position(owner->second.lastAccess));
+            }
+            else if (prevUsage != access.usage)
             {
                 barriers.push_back({access.handle, prevUsage, access.usage, orderIdx});
             }
 
             // Update current usage (writes set the "output" state)
             currentUsage[access.handle.index] = access.usage;
+            owners[access.handle.index] = {queue, orderIdx};
         }
+
+        for (uint32_t q = 0; q < kQueueCount; ++q)
+        {
+            if (dependency[q] == kNotWaited)
+                continue;
+            const uint32_t signalAfterPass = dependency[q] < 0 ? kRGGraphStart : static_cast<uint32_t>(dependency[q]);
+            addSync(static_cast<RGQueueType>(q), signalAfterPass, queue, orderIdx);
+        }
+    }
+
+    if (!result.usesAsyncCompute)
+        return;
+
+    // Imported resources leave the graph on the graphics queue, and the graphics queue
+    // does not finish the graph before the compute queue has.
+    for (uint16_t ri = 0; ri < static_cast<uint16_t>(resources.size()); ++ri)
+    {
+        auto owner = owners.find(ri);
+        if (!resources[ri].imported || owner == owners.end() || owner->second.queue == RGQueueType::Graphics)
+            continue;
+
+        RGResourceHandle handle;
+        handle.index = ri;
+        handle.version = 0;
+        RGBarrier transfer{handle, currentUsage[ri], currentUsage[ri], passCount};
+        transfer.srcQueue = owner->second.queue;
+        transfer.dstQueue = RGQueueType::Graphics;
+        transfer.releaseAfterPass = owner->second.lastAccess;
+        barriers.push_back(transfer);
     }
 
-    return barriers;
+    for (uint32_t orderIdx = passCount; orderIdx-- > 0;)
+    {
+        if (passQueues[orderIdx] == RGQueueType::Compute && !passes[executionOrder[orderIdx]].culled)
+        {
+            addSync(RGQueueType::Compute, orderIdx, RGQueueType::Graphics, passCount);
+            break;
+        }
+    }
 }
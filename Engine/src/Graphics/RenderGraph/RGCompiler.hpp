@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EngineGraphicsExport.h"
 #include "RGTypes.hpp"
 #include "RGPass.hpp"
 #include <vector>
@@ -18,27 +19,58 @@ struct RGResourceNode {
     int32_t  aliasGroup = -1;         // -1 = no aliasing (future use)
 };
 
+// Stands in for an execution order index before the first pass, where imported
+// resources are released and signaled on the graphics queue.
+constexpr uint32_t kRGGraphStart = UINT32_MAX;
+
 // Barrier record inserted between passes.
+// When srcQueue != dstQueue it is a queue ownership transfer: released on srcQueue
+// after releaseAfterPass, acquired on dstQueue before insertBeforePass. Both halves
+// carry the same usage transition.
 struct RGBarrier {
     RGResourceHandle handle;
     RGResourceUsage  fromUsage;
     RGResourceUsage  toUsage;
-    uint32_t         insertBeforePass; // execution order index
+    uint32_t         insertBeforePass; // execution order index (== pass count: after the last pass)
+    RGQueueType      srcQueue         = RGQueueType::Graphics;
+    RGQueueType      dstQueue         = RGQueueType::Graphics;
+    uint32_t         releaseAfterPass = kRGGraphStart; // execution order index, transfers only
+
+    bool isQueueTransfer() const { return srcQueue != dstQueue; }
+};
+
+// Cross-queue dependency: waitQueue may not start the pass at waitBeforePass until
+// signalQueue has finished the pass at signalAfterPass. Syncs are listed in wait order.
+struct RGQueueSync {
+    RGQueueType signalQueue;
+    uint32_t    signalAfterPass; // execution order index, or kRGGraphStart
+    RGQueueType waitQueue;
+    uint32_t    waitBeforePass;  // execution order index (== pass count: before the graph ends)
+};
+
+// What the backend offers the compiler.
+struct RGCompileOptions {
+    bool asyncCompute = false; // A separate compute queue exists
 };
 
 // Compilation result.
 struct RGCompileResult {
-    std::vector<uint32_t>  executionOrder; // pass indices in topological order
-    std::vector<RGBarrier> barriers;       // barriers to insert
-    bool                   valid = false;
+    std::vector<uint32_t>    executionOrder; // pass indices in topological order
+    std::vector<RGQueueType> passQueues;     // queue of each executionOrder entry
+    std::vector<RGBarrier>   barriers;       // barriers to insert, by insertBeforePass
+    std::vector<RGQueueSync> queueSyncs;     // empty unless a pass runs on the compute queue
+    bool                     usesAsyncCompute = false;
+    bool                     valid = false;
 };
 
-// Compiles a render graph: topological sort, pass culling, barrier scheduling.
-class RGCompiler {
+// Compiles a render graph: topological sort, pass culling, queue assignment,
+// barrier and cross-queue sync scheduling.
+class ENGINE_GRAPHICS_API RGCompiler {
 public:
     static RGCompileResult compile(std::vector<RGPassNode>& passes,
                                    std::vector<RGResourceNode>& resources,
-                                   uint32_t refWidth, uint32_t refHeight);
+                                   uint32_t refWidth, uint32_t refHeight,
+                                   const RGCompileOptions& options = {});
 
 private:
     // Step 1: Resolve relative texture dimensions.
@@ -60,9 +92,13 @@ private:
                                  std::vector<RGResourceNode>& resources,
                                  const std::vector<uint32_t>& executionOrder);
 
-    // Step 6: Schedule barriers between passes.
-    static std::vector<RGBarrier> scheduleBarriers(
-        const std::vector<RGPassNode>& passes,
-        const std::vector<RGResourceNode>& resources,
-        const std::vector<uint32_t>& executionOrder);
+    // Step 6: Put each pass on a queue.
+    static std::vector<RGQueueType> assignQueues(const std::vector<RGPassNode>& passes,
+                                                 const std::vector<uint32_t>& executionOrder,
+                                                 const RGCompileOptions& options);
+
+    // Step 7: Schedule barriers, ownership transfers and cross-queue syncs between passes.
+    static void scheduleBarriers(const std::vector<RGPassNode>& passes,
+                                 const std::vector<RGResourceNode>& resources,
+                                 RGCompileResult& result);
 };
@@ -53,7 +53,9 @@ enum class RGResourceUsage : uint8_t {
     Present,
 };
 
-// Queue type for a pass.
+// Queue type for a pass. Compute marks a pass as able to run on an async compute
+// queue; the compiler falls back to Graphics when the backend has none. Copy passes
+// always run on Graphics for now.
 enum class RGQueueType : uint8_t {
     Graphics,
     Compute,
@@ -47,10 +47,10 @@ void RenderGraph::setReferenceResolution(uint32_t width, uint32_t height)
     m_refHeight = height;
 }
 
-bool RenderGraph::compile()
+bool RenderGraph::compile(const RGCompileOptions& options)
 {
     m_compiled = false;
-    m_compileResult = RGCompiler::compile(m_passes, m_resources, m_refWidth, m_refHeight);
+    m_compileResult = RGCompiler::compile(m_passes, m_resources, m_refWidth, m_refHeight, options);
     m_compiled = m_compileResult.valid;
     return m_compiled;
 }
@@ -81,25 +81,96 @@ void RenderGraph::execute(RGBackend& backend)
     uint32_t barrierIdx = 0;
     const auto& barriers = m_compileResult.barriers;
     const auto& order = m_compileResult.executionOrder;
+    const auto& queues = m_compileResult.passQueues;
+    const auto& syncs = m_compileResult.queueSyncs;
+    const bool async = m_compileResult.usesAsyncCompute;
+    RGQueueType activeQueue = RGQueueType::Graphics;
+
+    auto switchQueue = [&](RGQueueType queue) {
+        if (queue != activeQueue)
+        {
+            activeQueue = queue;
+            backend.setActiveQueue(queue);
+        }
+    };
+
+    // Release halves of transfers and signals scheduled after a pass, on that pass's queue
+    auto finishPass = [&](uint32_t orderIdx) {
+        bool hasReleases = false;
+        for (const auto& b : barriers)
+        {
+            if (b.isQueueTransfer() && b.releaseAfterPass == orderIdx)
+            {
+                backend.releaseOwnership(b);
+                hasReleases = true;
+            }
+        }
+        if (hasReleases)
+            backend.flushBarriers();
+
+        for (uint32_t si = 0; si < static_cast<uint32_t>(syncs.size()); ++si)
+        {
+            if (syncs[si].signalAfterPass == orderIdx)
+                backend.signalSync(syncs[si].signalQueue, si);
+        }
+    };
+
+    // Waits and barriers scheduled before a pass (or before the end, at order.size())
+    auto insertBarriers = [&](uint32_t orderIdx) {
+        if (async)
+        {
+            for (uint32_t si = 0; si < static_cast<uint32_t>(syncs.size()); ++si)
+            {
+                if (syncs[si].waitBeforePass == orderIdx)
+                    backend.waitSync(syncs[si].waitQueue, si);
+            }
+        }
 
-    for (uint32_t orderIdx = 0; orderIdx < static_cast<uint32_t>(order.size()); ++orderIdx)
-    {
-        // Insert all barriers scheduled before this pass
         bool hasBarriers = false;
         while (barrierIdx < barriers.size() && barriers[barrierIdx].insertBeforePass == orderIdx)
         {
             const auto& b = barriers[barrierIdx];
-            backend.insertBarrier(b.handle, b.fromUsage, b.toUsage);
+            if (b.isQueueTransfer())
+                backend.acquireOwnership(b);
+            else
+                backend.insertBarrier(b.handle, b.fromUsage, b.toUsage);
             hasBarriers = true;
             ++barrierIdx;
         }
         if (hasBarriers)
             backend.flushBarriers();
+    };
 
-        // Execute the pass
+    // Imported resources handed to the compute queue before any graphics pass touched them
+    if (async)
+        finishPass(kRGGraphStart);
+
+    for (uint32_t orderIdx = 0; orderIdx < static_cast<uint32_t>(order.size()); ++orderIdx)
+    {
         const auto& pass = m_passes[order[orderIdx]];
+        if (async)
+            switchQueue(queues[orderIdx]);
+
+        backend.beginPass(pass.name);
+
+        // Insert all barriers scheduled before this pass
+        insertBarriers(orderIdx);
+
+        // Execute the pass
         if (pass.executeFn)
             pass.executeFn(backend.getContext());
+
+        backend.endPass();
+
+        if (async)
+            finishPass(orderIdx);
+    }
+
+    // The graph ends on the graphics queue, after the compute queue and owning every import
+    if (async)
+    {
+        switchQueue(RGQueueType::Graphics);
+        insertBarriers(static_cast<uint32_t>(order.size()));
     }
 
     // Destroy transient textures
@@ -138,6 +209,8 @@ std::string RenderGraph::exportDOT() const
             ss << ", style=dashed, color=gray";
         else if (pass.hasSideEffect)
             ss << ", shape=box, style=bold";
+        if (pass.queue == RGQueueType::Compute)
+            ss << ", fontcolor=darkorange";
         ss << "];\n";
     }
 
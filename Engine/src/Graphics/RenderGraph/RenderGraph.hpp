@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EngineGraphicsExport.h"
 #include "RGTypes.hpp"
 #include "RGPass.hpp"
 #include "RGBuilder.hpp"
@@ -10,7 +11,7 @@
 
 // The render graph: declares passes and resources, compiles, then executes.
 // Rebuilt each frame (lightweight — no GPU allocations during build/compile).
-class RenderGraph {
+class ENGINE_GRAPHICS_API RenderGraph {
 public:
     RenderGraph() = default;
 
@@ -29,8 +30,9 @@ public:
     // Set the reference resolution for relative-sized resources.
     void setReferenceResolution(uint32_t width, uint32_t height);
 
-    // Compile the graph: topological sort, pass culling, barrier scheduling.
-    bool compile();
+    // Compile the graph: topological sort, pass culling, queue assignment, barrier scheduling.
+    // Pass options.asyncCompute = backend.supportsAsyncCompute() for the backend it will run on.
+    bool compile(const RGCompileOptions& options = {});
 
     // Execute the compiled graph through a backend.
     void execute(RGBackend& backend);
@@ -38,6 +40,9 @@ public:
     // Whether compile() succeeded.
     bool isCompiled() const { return m_compiled; }
 
+    // The compiled schedule: pass order and queues, barriers, cross-queue syncs.
+    const RGCompileResult& getCompileResult() const { return m_compileResult; }
+
     // Export the graph as DOT for debug visualization.
     std::string exportDOT() const;
 
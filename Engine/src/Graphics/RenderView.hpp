@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Components/camera.hpp"
+#include "Decals/DecalSystem.hpp"
+#include "Foliage/FoliageSystem.hpp"
+#include "Frustum.hpp"
+#include "RenderCommandBuffer.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <vector>
+
+class SceneViewport;
+
+// One viewport in a multi-view render request (see renderer::render_views).
+// Views that share a registry are culled together in a single BVH pass.
+struct RenderView
+{
+    entt::registry* registry = nullptr;
+    camera* cam = nullptr;
+    SceneViewport* target = nullptr;  // Bound with setEditorViewport; nullptr keeps the current target
+    int width = 0;
+    int height = 0;
+    bool scene_rml = false;           // setSceneRmlEnabled for this view
+};
+
+struct MultiViewStats
+{
+    size_t views = 0;
+    size_t cull_passes = 0;           // BVH traversals for camera visibility (one per registry)
+    size_t visible_entities = 0;      // Summed over views
+    size_t draw_calls = 0;            // Summed over views
+    size_t shadow_passes = 0;         // Shadow maps rendered
+    size_t shadow_passes_shared = 0;  // Views that reused the previous view's shadow map
+    double cull_ms = 0.0;
+    double record_ms = 0.0;
+};
+
+// Per-view results of the cull + record phase, consumed by submission
+struct RenderViewWork
+{
+    const RenderView* view = nullptr;
+    glm::mat4 projection{1.0f};
+    glm::mat4 view_matrix{1.0f};
+    glm::vec3 cam_pos{0.0f};
+    Frustum frustum;
+
+    std::vector<entt::entity> opaque;
+    std::vector<entt::entity> transparent;
+    std::vector<int> opaque_lod;
+
+    RenderCommandBuffer depth_cmds;
+    RenderCommandBuffer opaque_cmds;
+    RenderCommandBuffer transparent_cmds;
+    FoliageStats foliage;
+    DecalFrame decals;
+    DecalStats decal_stats;
+
+    // Views with the same registry, light and camera get identical cascades.
+    // Equal to the view's own index unless an earlier view has the same inputs.
+    size_t shadow_group = 0;
+};
+
+struct MultiViewFrame
+{
+    const entt::registry* primary_registry = nullptr;  // Culled with renderer::scene_bvh; may have no view
+    std::vector<RenderViewWork> work;
+    std::vector<size_t> submit_order;  // Groups views that can share a shadow map
+    MultiViewStats stats;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "Components/Components.hpp"
+#include "BVH.hpp"
+#include "MeshBVH.hpp"
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+struct PickResult
+{
+    entt::entity entity = entt::null;
+    float distance = 0.0f;      // Along the (world-space) pick ray direction
+    bool triangle_hit = false;  // false when the entity was accepted on bounds only
+};
+
+// Triangle-accurate picking and marquee selection on top of SceneBVH.
+//
+// SceneBVH narrows the scene to entities whose world bounds are hit; each
+// candidate is then refined against a per-mesh triangle BVH (MeshBVH) built
+// lazily from the mesh's CPU vertices and cached by mesh, so instances of a
+// prop share one BVH. Meshes without CPU triangles (or displaced on the GPU,
+// like heightmap terrain) fall back to their bounds.
+class ScenePicker
+{
+public:
+    // Closest entity whose triangles the ray hits. direction need not be normalized.
+    PickResult pick(entt::registry& registry, const SceneBVH& bvh,
+                    const glm::vec3& origin, const glm::vec3& direction);
+
+    // Entities with any triangle inside the screen rectangle [ndc_min, ndc_max].
+    // view_projection must be the unflipped (Y-up) matrix used for rendering.
+    void marqueeSelect(entt::registry& registry, const SceneBVH& bvh, const glm::mat4& view_projection,
+                       const glm::vec2& ndc_min, const glm::vec2& ndc_max, std::vector<entt::entity>& results);
+
+    // Clip-space remap that stretches the NDC rectangle to the full [-1, 1] range,
+    // so extracting planes from (remap * view_projection) yields the marquee sub-frustum.
+    static glm::mat4 marqueeRemap(const glm::vec2& ndc_min, const glm::vec2& ndc_max);
+
+    // World-space ray through an NDC point (near plane at z=0, ZO depth).
+    static void unprojectRay(const glm::mat4& view_projection, const glm::vec2& ndc,
+                             glm::vec3& out_origin, glm::vec3& out_direction);
+
+    // Triangle BVH for a mesh, built on first use. nullptr if the mesh has no
+    // usable CPU triangles.
+    const MeshBVH* getMeshBVH(mesh& m);
+
+    // Drop cached triangle BVHs (call on level load; meshes may be freed)
+    void clear() { cache.clear(); }
+    size_t getCachedMeshCount() const { return cache.size(); }
+
+private:
+    struct CachedMeshBVH
+    {
+        const vertex* vertices = nullptr;
+        size_t vertex_count = 0;
+        MeshBVH bvh;
+    };
+
+    std::unordered_map<const mesh*, CachedMeshBVH> cache;
+
+    // Scratch reused across queries
+    std::vector<BVHRayHit> ray_hits;
+    std::vector<entt::entity> frustum_candidates;
+};
+
+// Implementation
+
+inline const MeshBVH* ScenePicker::getMeshBVH(mesh& m)
+{
+    if (!m.is_valid || !m.vertices || m.vertices_len < 3 || m.heightmap_displacement)
+        return nullptr;
+
+    CachedMeshBVH& entry = cache[&m];
+    if (entry.vertices != m.vertices || entry.vertex_count != m.vertices_len || entry.bvh.empty())
+    {
+        entry.vertices = m.vertices;
+        entry.vertex_count = m.vertices_len;
+        entry.bvh.build(m.vertices, m.vertices_len);
+    }
+    return entry.bvh.empty() ? nullptr : &entry.bvh;
+}
+
+inline PickResult ScenePicker::pick(entt::registry& registry, const SceneBVH& bvh,
+                                    const glm::vec3& origin, const glm::vec3& direction)
+{
+    PickResult result;
+    float closest_t = std::numeric_limits<float>::max();
+
+    bvh.rayQuery(origin, direction, ray_hits);
+    for (const BVHRayHit& hit : ray_hits)
+    {
+        // Candidates are sorted by bounds entry distance, so nothing further
+        // along can beat the current closest triangle.
+        if (hit.t_enter > closest_t)
+            break;
+
+        auto* mesh_comp = registry.try_get<MeshComponent>(hit.entity);
+        auto* transform = registry.try_get<TransformComponent>(hit.entity);
+        if (!mesh_comp || !transform || !mesh_comp->m_mesh)
+            continue;
+
+        const MeshBVH* triangles = getMeshBVH(*mesh_comp->m_mesh);
+        if (!triangles)
+        {
+            closest_t = hit.t_enter;
+            result = { hit.entity, hit.t_enter, false };
+            continue;
+        }
+
+        // An affine transform keeps the ray parameter, so local t is world t
+        const glm::mat4 inv_model = glm::inverse(transform->getTransformMatrix());
+        const glm::vec3 local_origin = glm::vec3(inv_model * glm::vec4(origin, 1.0f));
+        const glm::vec3 local_direction = glm::vec3(inv_model * glm::vec4(direction, 0.0f));
+
+        float t;
+        if (triangles->raycast(local_origin, local_direction, closest_t, t))
+        {
+            closest_t = t;
+            result = { hit.entity, t, true };
+        }
+    }
+
+    return result;
+}
+
+inline glm::mat4 ScenePicker::marqueeRemap(const glm::vec2& ndc_min, const glm::vec2& ndc_max)
+{
+    const glm::vec2 center = (ndc_min + ndc_max) * 0.5f;
+    const glm::vec2 half = glm::max((ndc_max - ndc_min) * 0.5f, glm::vec2(1e-6f));
+
+    // x' = (x - cx * w) / hx, y' = (y - cy * w) / hy; z and w unchanged
+    glm::mat4 remap(1.0f);
+    remap[0][0] = 1.0f / half.x;
+    remap[1][1] = 1.0f / half.y;
+    remap[3][0] = -center.x / half.x;
+    remap[3][1] = -center.y / half.y;
+    return remap;
+}
+
+inline void ScenePicker::unprojectRay(const glm::mat4& view_projection, const glm::vec2& ndc,
+                                      glm::vec3& out_origin, glm::vec3& out_direction)
+{
+    const glm::mat4 inv_vp = glm::inverse(view_projection);
+    glm::vec4 near_world = inv_vp * glm::vec4(ndc.x, ndc.y, 0.0f, 1.0f);
+    glm::vec4 far_world = inv_vp * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+    near_world /= near_world.w;
+    far_world /= far_world.w;
+
+    out_origin = glm::vec3(near_world);
+    out_direction = glm::normalize(glm::vec3(far_world) - out_origin);
+}
+
+inline void ScenePicker::marqueeSelect(entt::registry& registry, const SceneBVH& bvh, const glm::mat4& view_projection,
+                                       const glm::vec2& ndc_min, const glm::vec2& ndc_max,
+                                       std::vector<entt::entity>& results)
+{
+    results.clear();
+
+    const glm::mat4 marquee_vp = marqueeRemap(ndc_min, ndc_max) * view_projection;
+    Frustum frustum;
+    frustum.extractFromViewProjection(marquee_vp);
+
+    bvh.queryFrustum(frustum, frustum_candidates);
+    for (entt::entity entity : frustum_candidates)
+    {
+        auto* mesh_comp = registry.try_get<MeshComponent>(entity);
+        auto* transform = registry.try_get<TransformComponent>(entity);
+        if (!mesh_comp || !transform || !mesh_comp->m_mesh)
+            continue;
+
+        mesh& m = *mesh_comp->m_mesh;
+        if (!m.bounds_computed)
+            m.computeBounds();
+
+        const glm::mat4 model = transform->getTransformMatrix();
+        if (frustum.containsAABB(AABB::fromTransformedAABB(m.aabb_min, m.aabb_max, model)))
+        {
+            results.push_back(entity);
+            continue;
+        }
+
+        const MeshBVH* triangles = getMeshBVH(m);
+        if (!triangles)
+        {
+            results.push_back(entity);  // Bounds already intersect the marquee
+            continue;
+        }
+
+        // Planes extracted from (marquee_vp * model) are the marquee frustum in mesh space
+        Frustum local_frustum;
+        local_frustum.extractFromViewProjection(marquee_vp * model);
+        if (triangles->intersectsFrustum(local_frustum))
+            results.push_back(entity);
+    }
+}
@@ -0,0 +1,356 @@
+#include "VulkanDecalPass.hpp"
+#include "Decals/DecalSystem.hpp"
+#include "Utils/Log.hpp"
+
+#define VMA_STATIC_VULKAN_FUNCTIONS 0
+#define VMA_DYNAMIC_VULKAN_FUNCTIONS 1
+#include "vk_mem_alloc.h"
+
+#include "VkPipelineBuilder.hpp"
+#include "VkDescriptorWriter.hpp"
+
+#include <array>
+#include <cstring>
+
+VulkanDecalPass::~VulkanDecalPass()
+{
+    cleanup();
+}
+
+bool VulkanDecalPass::init(VkDevice device,
+                           VmaAllocator allocator,
+                           VkPipelineCache pipelineCache,
+                           const std::vector<char>& vertSPV,
+                           const std::vector<char>& fragSPV,
+                           uint32_t framesInFlight)
+{
+    if (device == VK_NULL_HANDLE || allocator == nullptr) return false;
+    if (vertSPV.empty() || fragSPV.empty()) return false;
+    if (framesInFlight == 0) return false;
+    device_ = device;
+    allocator_ = allocator;
+    framesInFlight_ = framesInFlight;
+
+    if (!createRenderPass())       { cleanup(); return false; }
+    if (!createSampler())          { cleanup(); return false; }
+    if (!createDescriptorLayout()) { cleanup(); return false; }
+    if (!createPipelineLayout())   { cleanup(); return false; }
+    if (!createPipeline(pipelineCache, vertSPV, fragSPV)) { cleanup(); return false; }
+    if (!createDescriptorPools())  { cleanup(); return false; }
+    if (!createFrameBuffers())     { cleanup(); return false; }
+
+    initialized_ = true;
+    return true;
+}
+
+void VulkanDecalPass::cleanup()
+{
+    if (device_ == VK_NULL_HANDLE) return;
+    for (FrameBuffers& frame : frames_) {
+        for (FrameBuffer* b : { &frame.cb, &frame.decals, &frame.tiles, &frame.indices }) {
+            if (b->buffer != VK_NULL_HANDLE)
+                vmaDestroyBuffer(allocator_, b->buffer, b->allocation);
+            *b = FrameBuffer{};
+        }
+    }
+    frames_.clear();
+    if (pipeline_ != VK_NULL_HANDLE)        { vkDestroyPipeline(device_, pipeline_, nullptr); pipeline_ = VK_NULL_HANDLE; }
+    if (pipelineLayout_ != VK_NULL_HANDLE)  { vkDestroyPipelineLayout(device_, pipelineLayout_, nullptr); pipelineLayout_ = VK_NULL_HANDLE; }
+    if (dsLayout_ != VK_NULL_HANDLE)        { vkDestroyDescriptorSetLayout(device_, dsLayout_, nullptr); dsLayout_ = VK_NULL_HANDLE; }
+    for (VkDescriptorPool pool : descriptorPools_) {
+        if (pool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(device_, pool, nullptr);
+    }
+    descriptorPools_.clear();
+    framesInFlight_ = 0;
+    if (linearSampler_ != VK_NULL_HANDLE)   { vkDestroySampler(device_, linearSampler_, nullptr); linearSampler_ = VK_NULL_HANDLE; }
+    if (renderPass_ != VK_NULL_HANDLE)      { vkDestroyRenderPass(device_, renderPass_, nullptr); renderPass_ = VK_NULL_HANDLE; }
+    initialized_ = false;
+    allocator_ = nullptr;
+    device_ = VK_NULL_HANDLE;
+}
+
+bool VulkanDecalPass::createRenderPass()
+{
+    // GBuffer 0 keeps its contents: the graph transitions it to a color
+    // attachment for this pass and the decals blend over it.
+    VkAttachmentDescription color{};
+    color.format         = OUTPUT_FORMAT;
+    color.samples        = VK_SAMPLE_COUNT_1_BIT;
+    color.loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+    color.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+    color.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    color.initialLayout  = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    color.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkAttachmentReference colorRef{};
+    colorRef.attachment = 0;
+    colorRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments    = &colorRef;
+
+    // Wait for the GBuffer writes before sampling depth / normals and blending.
+    std::array<VkSubpassDependency, 2> deps{};
+    deps[0].srcSubpass    = VK_SUBPASS_EXTERNAL;
+    deps[0].dstSubpass    = 0;
+    deps[0].srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+                          | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    deps[0].dstStageMask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                          | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    deps[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+                          | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    deps[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT
+                          | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+                          | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    deps[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+    // Make the modified base color available to the lighting pass.
+    deps[1].srcSubpass    = 0;
+    deps[1].dstSubpass    = VK_SUBPASS_EXTERNAL;
+    deps[1].srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    deps[1].dstStageMask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    deps[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    deps[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    deps[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+    VkRenderPassCreateInfo info{};
+    info.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.attachmentCount = 1;
+    info.pAttachments    = &color;
+    info.subpassCount    = 1;
+    info.pSubpasses      = &subpass;
+    info.dependencyCount = static_cast<uint32_t>(deps.size());
+    info.pDependencies   = deps.data();
+
+    return vkCreateRenderPass(device_, &info, nullptr, &renderPass_) == VK_SUCCESS;
+}
+
+bool VulkanDecalPass::createSampler()
+{
+    VkSamplerCreateInfo s{};
+    s.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    s.magFilter    = VK_FILTER_LINEAR;
+    s.minFilter    = VK_FILTER_LINEAR;
+    s.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    s.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    s.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    s.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    s.maxLod       = VK_LOD_CLAMP_NONE;
+    return vkCreateSampler(device_, &s, nullptr, &linearSampler_) == VK_SUCCESS;
+}
+
+bool VulkanDecalPass::createDescriptorLayout()
+{
+    auto binding = [](uint32_t b, VkDescriptorType type) {
+        VkDescriptorSetLayoutBinding x{};
+        x.binding = b;
+        x.descriptorType = type;
+        x.descriptorCount = 1;
+        x.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        return x;
+    };
+
+    std::array<VkDescriptorSetLayoutBinding, 7> bindings{};
+    bindings[0] = binding(BINDING_CBUFFER,      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    bindings[0].stageFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+    bindings[1] = binding(BINDING_GB1,          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    bindings[2] = binding(BINDING_DEPTH,        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    bindings[3] = binding(BINDING_ATLAS,        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    bindings[4] = binding(BINDING_DECALS,       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    bindings[5] = binding(BINDING_TILES,        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    bindings[6] = binding(BINDING_TILE_INDICES, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+
+    VkDescriptorSetLayoutCreateInfo info{};
+    info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    info.bindingCount = static_cast<uint32_t>(bindings.size());
+    info.pBindings    = bindings.data();
+    return vkCreateDescriptorSetLayout(device_, &info, nullptr, &dsLayout_) == VK_SUCCESS;
+}
+
+bool VulkanDecalPass::createPipelineLayout()
+{
+    VkPipelineLayoutCreateInfo info{};
+    info.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    info.setLayoutCount = 1;
+    info.pSetLayouts    = &dsLayout_;
+    return vkCreatePipelineLayout(device_, &info, nullptr, &pipelineLayout_) == VK_SUCCESS;
+}
+
+VkShaderModule VulkanDecalPass::makeShaderModule(const std::vector<char>& code)
+{
+    VkShaderModuleCreateInfo i{};
+    i.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    i.codeSize = code.size();
+    i.pCode    = reinterpret_cast<const uint32_t*>(code.data());
+    VkShaderModule m = VK_NULL_HANDLE;
+    vkCreateShaderModule(device_, &i, nullptr, &m);
+    return m;
+}
+
+bool VulkanDecalPass::createPipeline(VkPipelineCache cache,
+                                     const std::vector<char>& vs,
+                                     const std::vector<char>& fs)
+{
+    VkShaderModule vsModule = makeShaderModule(vs);
+    VkShaderModule fsModule = makeShaderModule(fs);
+    if (vsModule == VK_NULL_HANDLE || fsModule == VK_NULL_HANDLE) {
+        if (vsModule) vkDestroyShaderModule(device_, vsModule, nullptr);
+        if (fsModule) vkDestroyShaderModule(device_, fsModule, nullptr);
+        return false;
+    }
+
+    // Fullscreen-quad input layout: vec2 position + vec2 texcoord (16 bytes).
+    VkVertexInputBindingDescription binding{};
+    binding.binding   = 0;
+    binding.stride    = 16;
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    std::array<VkVertexInputAttributeDescription, 2> attrs{};
+    attrs[0] = { 0, 0, VK_FORMAT_R32G32_SFLOAT, 0 };
+    attrs[1] = { 1, 0, VK_FORMAT_R32G32_SFLOAT, 8 };
+
+    // Premultiplied "over" into base color; metallic (alpha) is left alone.
+    VkPipelineColorBlendAttachmentState blend{};
+    blend.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+                              | VK_COLOR_COMPONENT_B_BIT;
+    blend.blendEnable         = VK_TRUE;
+    blend.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blend.colorBlendOp        = VK_BLEND_OP_ADD;
+    blend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    blend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend.alphaBlendOp        = VK_BLEND_OP_ADD;
+
+    VkPipelineBuilder builder(device_, cache);
+    builder.setShaders(vsModule, fsModule)
+           .setVertexInput(&binding, 1, attrs.data(), static_cast<uint32_t>(attrs.size()))
+           .setTopology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)  // matches the shared FXAA quad (6 verts)
+           .setCullMode(VK_CULL_MODE_NONE)
+           .setDepthTest(VK_FALSE, VK_FALSE, VK_COMPARE_OP_ALWAYS)
+           .setColorBlend(&blend, 1)
+           .setRenderPass(renderPass_, 0)
+           .setLayout(pipelineLayout_);
+
+    VkResult r = builder.build(&pipeline_);
+
+    vkDestroyShaderModule(device_, vsModule, nullptr);
+    vkDestroyShaderModule(device_, fsModule, nullptr);
+    return r == VK_SUCCESS;
+}
+
+bool VulkanDecalPass::createDescriptorPools()
+{
+    // One set per view; a few views (editor + PIE) per frame.
+    constexpr uint32_t kMaxSets = 4;
+    std::array<VkDescriptorPoolSize, 3> sizes{};
+    sizes[0] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         kMaxSets * 1 };
+    sizes[1] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kMaxSets * 3 };
+    sizes[2] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         kMaxSets * 3 };
+
+    VkDescriptorPoolCreateInfo info{};
+    info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    info.maxSets       = kMaxSets;
+    info.poolSizeCount = static_cast<uint32_t>(sizes.size());
+    info.pPoolSizes    = sizes.data();
+    descriptorPools_.assign(framesInFlight_, VK_NULL_HANDLE);
+    for (uint32_t i = 0; i < framesInFlight_; ++i) {
+        if (vkCreateDescriptorPool(device_, &info, nullptr, &descriptorPools_[i]) != VK_SUCCESS)
+            return false;
+    }
+    return true;
+}
+
+bool VulkanDecalPass::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, FrameBuffer& out)
+{
+    VkBufferCreateInfo bi{};
+    bi.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bi.size  = size;
+    bi.usage = usage;
+
+    VmaAllocationCreateInfo ai{};
+    ai.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    ai.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo ao;
+    if (vmaCreateBuffer(allocator_, &bi, &ai, &out.buffer, &out.allocation, &ao) != VK_SUCCESS)
+        return false;
+    out.mapped = ao.pMappedData;
+    out.size   = size;
+    if (out.mapped) std::memset(out.mapped, 0, size);
+    return out.mapped != nullptr;
+}
+
+bool VulkanDecalPass::createFrameBuffers()
+{
+    frames_.resize(framesInFlight_);
+    for (uint32_t i = 0; i < framesInFlight_; ++i) {
+        FrameBuffers& f = frames_[i];
+        if (!createBuffer(sizeof(DecalCB), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, f.cb)
+            || !createBuffer(sizeof(GPUDecal) * DecalFrame::MAX_DECALS,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, f.decals)
+            || !createBuffer(sizeof(glm::uvec2) * DecalFrame::TILES_X * DecalFrame::TILES_Y,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, f.tiles)
+            || !createBuffer(sizeof(uint32_t) * DecalFrame::MAX_TILE_ENTRIES,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, f.indices)) {
+            LOG_ENGINE_ERROR("[Vulkan] Decals: failed to create per-frame buffers {}", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VulkanDecalPass::upload(uint32_t frameIndex, const DecalFrame& frame, const DecalCB& cb)
+{
+    if (!initialized_ || frameIndex >= frames_.size()) return false;
+    if (frame.empty() || frame.tiles.size() != DecalFrame::TILES_X * DecalFrame::TILES_Y) return false;
+
+    // DecalSystem::buildFrame keeps the lists within the buffers
+    if (frame.decals.size() > DecalFrame::MAX_DECALS || frame.indices.size() > DecalFrame::MAX_TILE_ENTRIES)
+        return false;
+
+    FrameBuffers& f = frames_[frameIndex];
+    std::memcpy(f.cb.mapped, &cb, sizeof(cb));
+    std::memcpy(f.decals.mapped, frame.decals.data(), sizeof(GPUDecal) * frame.decals.size());
+    std::memcpy(f.tiles.mapped, frame.tiles.data(), sizeof(glm::uvec2) * frame.tiles.size());
+    if (!frame.indices.empty())
+        std::memcpy(f.indices.mapped, frame.indices.data(), sizeof(uint32_t) * frame.indices.size());
+    return true;
+}
+
+VkDescriptorSet VulkanDecalPass::allocateDescriptorSet(uint32_t frameIndex)
+{
+    if (!initialized_) return VK_NULL_HANDLE;
+    if (frameIndex >= descriptorPools_.size() || frameIndex >= frames_.size()) return VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo info{};
+    info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    info.descriptorPool     = descriptorPools_[frameIndex];
+    info.descriptorSetCount = 1;
+    info.pSetLayouts        = &dsLayout_;
+    VkDescriptorSet ds = VK_NULL_HANDLE;
+    if (vkAllocateDescriptorSets(device_, &info, &ds) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+
+    const FrameBuffers& f = frames_[frameIndex];
+    VkDescriptorBufferInfo cbInfo     { f.cb.buffer,      0, VK_WHOLE_SIZE };
+    VkDescriptorBufferInfo decalsInfo { f.decals.buffer,  0, VK_WHOLE_SIZE };
+    VkDescriptorBufferInfo tilesInfo  { f.tiles.buffer,   0, VK_WHOLE_SIZE };
+    VkDescriptorBufferInfo indexInfo  { f.indices.buffer, 0, VK_WHOLE_SIZE };
+    VkDescriptorWriter(ds)
+        .writeBuffer(BINDING_CBUFFER,      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &cbInfo)
+        .writeBuffer(BINDING_DECALS,       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &decalsInfo)
+        .writeBuffer(BINDING_TILES,        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &tilesInfo)
+        .writeBuffer(BINDING_TILE_INDICES, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &indexInfo)
+        .update(device_);
+    return ds;
+}
+
+void VulkanDecalPass::resetDescriptors(uint32_t frameIndex)
+{
+    if (frameIndex < descriptorPools_.size()
+        && descriptorPools_[frameIndex] != VK_NULL_HANDLE)
+        vkResetDescriptorPool(device_, descriptorPools_[frameIndex], 0);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// VMA forward declarations (avoid pulling vk_mem_alloc.h into headers)
+struct VmaAllocator_T;
+typedef VmaAllocator_T* VmaAllocator;
+struct VmaAllocation_T;
+typedef VmaAllocation_T* VmaAllocation;
+
+struct DecalFrame;
+
+// Deferred decal pass owner. Runs between the GBuffer and DeferredLighting
+// passes and blends the decals binned into each screen tile over GBuffer 0
+// (base color; metallic in alpha is masked off).
+// Owns the render pass (1 RGBA8 color attachment, loaded), descriptor set
+// layout (7 bindings to match decals.slang), pipeline, descriptor pools, a
+// linear-clamp sampler, and per-frame CB + decal / tile / index SSBOs.
+//
+// Framebuffers and descriptor-set writes are NOT owned — the graph builder
+// creates them per-frame from RG-allocated transient resources.
+class VulkanDecalPass {
+public:
+    // Slot indices match decals.slang's [[vk::binding(N, 0)]]
+    static constexpr uint32_t BINDING_CBUFFER      = 0;
+    static constexpr uint32_t BINDING_GB1          = 1;
+    static constexpr uint32_t BINDING_DEPTH        = 2;
+    static constexpr uint32_t BINDING_ATLAS        = 3;
+    static constexpr uint32_t BINDING_DECALS       = 4;
+    static constexpr uint32_t BINDING_TILES        = 5;
+    static constexpr uint32_t BINDING_TILE_INDICES = 6;
+
+    static constexpr VkFormat OUTPUT_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;   // GBuffer 0
+
+    // HLSL-packing-matched struct mirroring decals.slang's DecalCB.
+    struct DecalCB {
+        glm::mat4 uInvViewProj;
+        glm::mat4 uViewProj;
+        uint32_t  uTilesX;
+        uint32_t  uTilesY;
+        uint32_t  _pad0[2];
+    };
+
+    VulkanDecalPass() = default;
+    ~VulkanDecalPass();
+
+    VulkanDecalPass(const VulkanDecalPass&) = delete;
+    VulkanDecalPass& operator=(const VulkanDecalPass&) = delete;
+
+    bool init(VkDevice device,
+              VmaAllocator allocator,
+              VkPipelineCache pipelineCache,
+              const std::vector<char>& vertSPV,
+              const std::vector<char>& fragSPV,
+              uint32_t framesInFlight = 2);
+
+    void cleanup();
+
+    // Copy a view's decal lists into the frame's buffers; returns false when
+    // there is nothing to draw.
+    bool upload(uint32_t frameIndex, const DecalFrame& frame, const DecalCB& cb);
+
+    VkRenderPass        getRenderPass()       const { return renderPass_; }
+    VkPipeline          getPipeline()         const { return pipeline_; }
+    VkPipelineLayout    getPipelineLayout()   const { return pipelineLayout_; }
+    VkSampler           getLinearSampler()    const { return linearSampler_; }
+    bool                isInitialized()       const { return initialized_; }
+
+    // Allocate a descriptor set from the current frame's pool and point its
+    // buffer bindings at the frame's buffers. Caller writes the image bindings.
+    VkDescriptorSet allocateDescriptorSet(uint32_t frameIndex);
+
+    // Reset the current frame's pool after its fence has signaled.
+    void resetDescriptors(uint32_t frameIndex);
+
+private:
+    struct FrameBuffer {
+        VkBuffer      buffer     = VK_NULL_HANDLE;
+        VmaAllocation allocation = nullptr;
+        void*         mapped     = nullptr;
+        VkDeviceSize  size       = 0;
+    };
+
+    struct FrameBuffers {
+        FrameBuffer cb;
+        FrameBuffer decals;
+        FrameBuffer tiles;
+        FrameBuffer indices;
+    };
+
+    bool createRenderPass();
+    bool createDescriptorLayout();
+    bool createPipelineLayout();
+    bool createPipeline(VkPipelineCache cache,
+                        const std::vector<char>& vs,
+                        const std::vector<char>& fs);
+    bool createSampler();
+    bool createDescriptorPools();
+    bool createFrameBuffers();
+    bool createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, FrameBuffer& out);
+    VkShaderModule makeShaderModule(const std::vector<char>& code);
+
+    VkDevice              device_         = VK_NULL_HANDLE;
+    VmaAllocator          allocator_      = nullptr;
+    VkRenderPass          renderPass_     = VK_NULL_HANDLE;
+    VkDescriptorSetLayout dsLayout_       = VK_NULL_HANDLE;
+    VkPipelineLayout      pipelineLayout_ = VK_NULL_HANDLE;
+    VkPipeline            pipeline_       = VK_NULL_HANDLE;
+    std::vector<VkDescriptorPool> descriptorPools_;
+    std::vector<FrameBuffers> frames_;
+    uint32_t              framesInFlight_ = 0;
+    VkSampler             linearSampler_  = VK_NULL_HANDLE;
+    bool                  initialized_    = false;
+};
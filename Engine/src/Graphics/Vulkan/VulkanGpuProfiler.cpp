@@ -0,0 +1,118 @@
+#include "VulkanGpuProfiler.hpp"
+#include "Utils/Log.hpp"
+
+bool VulkanGpuProfiler::init(VkDevice device, float timestampPeriod, uint32_t framesInFlight)
+{
+    shutdown();
+    if (device == VK_NULL_HANDLE || timestampPeriod <= 0.0f || framesInFlight == 0)
+        return false;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = framesInFlight * kQueriesPerFrame;
+    if (vkCreateQueryPool(device, &poolInfo, nullptr, &m_queryPool) != VK_SUCCESS) {
+        LOG_ENGINE_WARN("[Vulkan] Failed to create GPU pass timing query pool; per-pass timings disabled");
+        m_queryPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    m_device = device;
+    m_msPerTick = static_cast<double>(timestampPeriod) / 1000000.0;
+    m_frames.assign(framesInFlight, GpuScopeRecorder{});
+    m_pendingReadback.assign(framesInFlight, false);
+    m_results.resize(kQueriesPerFrame * 2);
+    m_timestamps.resize(kQueriesPerFrame);
+    m_history.clear();
+    return true;
+}
+
+void VulkanGpuProfiler::shutdown()
+{
+    if (m_queryPool != VK_NULL_HANDLE && m_device != VK_NULL_HANDLE)
+        vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+    m_queryPool = VK_NULL_HANDLE;
+    m_device = VK_NULL_HANDLE;
+    m_recordingFrame = UINT32_MAX;
+    m_frames.clear();
+    m_pendingReadback.clear();
+    m_history.clear();
+}
+
+void VulkanGpuProfiler::beginFrame(uint32_t frameIndex, VkCommandBuffer cmd)
+{
+    m_recordingFrame = UINT32_MAX;
+    if (!isEnabled() || frameIndex >= m_frames.size())
+        return;
+
+    vkCmdResetQueryPool(cmd, m_queryPool, frameIndex * kQueriesPerFrame, kQueriesPerFrame);
+    m_frames[frameIndex].reset(kQueriesPerFrame);
+    m_pendingReadback[frameIndex] = false;
+    m_recordingFrame = frameIndex;
+}
+
+void VulkanGpuProfiler::endFrame(VkCommandBuffer cmd)
+{
+    if (m_recordingFrame == UINT32_MAX)
+        return;
+
+    GpuScopeRecorder& frame = m_frames[m_recordingFrame];
+    while (frame.getOpenCount() > 0)
+        endScope(cmd);
+    if (frame.getDroppedCount() > 0 && !m_warnedDropped) {
+        m_warnedDropped = true;
+        LOG_ENGINE_WARN("[Vulkan] {} GPU timing scopes dropped; more than {} queries in one frame",
+                        frame.getDroppedCount(), kQueriesPerFrame);
+    }
+    m_pendingReadback[m_recordingFrame] = frame.getQueryCount() > 0;
+    m_recordingFrame = UINT32_MAX;
+}
+
+void VulkanGpuProfiler::beginScope(VkCommandBuffer cmd, const char* name)
+{
+    if (m_recordingFrame == UINT32_MAX || cmd == VK_NULL_HANDLE)
+        return;
+
+    const uint32_t query = m_frames[m_recordingFrame].begin(name);
+    if (query != GpuScopeRecorder::kNoQuery) {
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool,
+                            m_recordingFrame * kQueriesPerFrame + query);
+    }
+}
+
+void VulkanGpuProfiler::endScope(VkCommandBuffer cmd)
+{
+    if (m_recordingFrame == UINT32_MAX || cmd == VK_NULL_HANDLE)
+        return;
+
+    const uint32_t query = m_frames[m_recordingFrame].end();
+    if (query != GpuScopeRecorder::kNoQuery) {
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool,
+                            m_recordingFrame * kQueriesPerFrame + query);
+    }
+}
+
+void VulkanGpuProfiler::collect(uint32_t frameIndex, float frameMs, uint64_t frameNumber)
+{
+    if (!isEnabled() || frameIndex >= m_frames.size() || !m_pendingReadback[frameIndex])
+        return;
+    m_pendingReadback[frameIndex] = false;
+
+    const GpuScopeRecorder& frame = m_frames[frameIndex];
+    const uint32_t queryCount = frame.getQueryCount();
+
+    // No WAIT_BIT: the fence has signaled, and a query that somehow was not written comes
+    // back unavailable instead of blocking.
+    VkResult result = vkGetQueryPoolResults(m_device, m_queryPool, frameIndex * kQueriesPerFrame,
+                                            queryCount, sizeof(uint64_t) * 2 * queryCount,
+                                            m_results.data(), sizeof(uint64_t) * 2,
+                                            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+        return;
+
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        m_timestamps[i] = m_results[i * 2 + 1] != 0 ? m_results[i * 2]
+                                                    : GpuPassTimingHistory::kUnavailable;
+    }
+    m_history.resolve(frame, m_timestamps.data(), m_msPerTick, frameMs, frameNumber);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Graphics/GpuPassTimings.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+
+// Per-pass GPU timestamps for the Vulkan backend. Each frame in flight owns a slice of one
+// timestamp query pool; the slice is reset at the start of the frame's command buffer and
+// read back once that frame's fence has signaled, so nothing ever waits on the GPU.
+class VulkanGpuProfiler {
+public:
+    static constexpr uint32_t kQueriesPerFrame = 256;
+
+    // timestampPeriod is VkPhysicalDeviceLimits::timestampPeriod (ns per tick).
+    bool init(VkDevice device, float timestampPeriod, uint32_t framesInFlight);
+    void shutdown();
+    bool isEnabled() const { return m_queryPool != VK_NULL_HANDLE; }
+
+    // Start recording a frame into the given slot. Records the slice reset into cmd, which
+    // must be outside a render pass.
+    void beginFrame(uint32_t frameIndex, VkCommandBuffer cmd);
+
+    // Close scopes left open and stop recording.
+    void endFrame(VkCommandBuffer cmd);
+
+    // Scopes nest. Must be recorded outside render passes that take secondary command buffers.
+    void beginScope(VkCommandBuffer cmd, const char* name);
+    void endScope(VkCommandBuffer cmd);
+
+    // Read back the slot's results. Call after its fence has signaled and before the slot is
+    // recorded again. frameMs is the GPU time of the whole frame, or negative if unknown.
+    void collect(uint32_t frameIndex, float frameMs, uint64_t frameNumber);
+
+    const GpuPassTimings& getTimings() const { return m_history.getTimings(); }
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueryPool m_queryPool = VK_NULL_HANDLE;
+    double m_msPerTick = 0.0;
+    uint32_t m_recordingFrame = UINT32_MAX;
+    bool m_warnedDropped = false;
+
+    std::vector<GpuScopeRecorder> m_frames;
+    std::vector<bool> m_pendingReadback;
+    std::vector<uint64_t> m_results;       // Value/availability pairs
+    std::vector<uint64_t> m_timestamps;
+    GpuPassTimingHistory m_history;
+};
@@ -33,6 +33,14 @@ struct DeferredLightingCB {
     int       uNumSpotLights;
     glm::vec2 _pad4;
 };
+
+// Extent of a pass of the given size that covers the scene rectangle of cfg
+VkExtent2D scaledPassExtent(uint32_t width, uint32_t height, const PostProcessGraphBuilder::Config& cfg)
+{
+    const uint64_t w = (static_cast<uint64_t>(width)  * cfg.sceneWidth()  + cfg.width  - 1) / cfg.width;
+    const uint64_t h = (static_cast<uint64_t>(height) * cfg.sceneHeight() + cfg.height - 1) / cfg.height;
+    return { static_cast<uint32_t>(std::max<uint64_t>(w, 1)), static_cast<uint32_t>(std::max<uint64_t>(h, 1)) };
+}
 } // namespace
 
 void VulkanPostProcessGraphBuilder::clearCachedFramebuffers()
@@ -121,6 +129,43 @@ void VulkanPostProcessGraphBuilder::setFrameInputs(VkImage       outputImage,
     m_depthView           = depthView;
 }
 
+glm::mat4 VulkanPostProcessGraphBuilder::sceneClipRemap(const Config& cfg)
+{
+    // Shaders turn a quad UV into ndc = (2u - 1, 1 - 2v). With UVs scaled by (sx, sy),
+    // full-frame ndc maps to (sx * x + sx - 1, sy * y + 1 - sy).
+    const float sx = static_cast<float>(cfg.sceneWidth())  / static_cast<float>(cfg.width);
+    const float sy = static_cast<float>(cfg.sceneHeight()) / static_cast<float>(cfg.height);
+    glm::mat4 remap(1.0f);
+    remap[0][0] = sx;
+    remap[3][0] = sx - 1.0f;
+    remap[1][1] = sy;
+    remap[3][1] = 1.0f - sy;
+    return remap;
+}
+
+VkBuffer VulkanPostProcessGraphBuilder::sceneQuad(const Config& cfg, VkDeviceSize& offset) const
+{
+    if (cfg.upscale() && m_sceneQuad != VK_NULL_HANDLE) {
+        offset = m_sceneQuadOffset;
+        return m_sceneQuad;
+    }
+    offset = 0;
+    return m_api->fxaa_vertex_buffer;
+}
+
+void VulkanPostProcessGraphBuilder::bindSceneQuad(VkCommandBuffer cmd, const Config& cfg) const
+{
+    VkDeviceSize offset = 0;
+    VkBuffer buffer = sceneQuad(cfg, offset);
+    vkCmdBindVertexBuffers(cmd, 0, 1, &buffer, &offset);
+}
+
+bool VulkanPostProcessGraphBuilder::supportsRenderScale() const
+{
+    // The forward path draws the scene before the graph runs, at full size
+    return m_api && m_api->isDeferredActive() && m_sceneQuad != VK_NULL_HANDLE;
+}
+
 PostProcessGraphBuilder::Handles
 VulkanPostProcessGraphBuilder::importResources(RenderGraph& graph, RGBackend& backend, const Config& cfg)
 {
@@ -281,7 +326,8 @@ void VulkanPostProcessGraphBuilder::recordSkybox(RGContext&, const Handles& h, c
         return;
     }
 
-    VkExtent2D extent = { cfg.width, cfg.height };
+    // Samples nothing, so drawing the regular quad into the scene rectangle is enough
+    VkExtent2D extent = sceneExtent(cfg);
     std::array<VkImageView, 2> attachments = { hdrView, depthView };
     VkFramebuffer framebuffer = getCachedFramebuffer(api->skybox_rg_render_pass,
                                                      attachments.data(),
@@ -303,8 +349,8 @@ void VulkanPostProcessGraphBuilder::recordSkybox(RGContext&, const Handles& h, c
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, api->skybox_pipeline);
 
     VkViewport viewport{};
-    viewport.width    = static_cast<float>(cfg.width);
-    viewport.height   = static_cast<float>(cfg.height);
+    viewport.width    = static_cast<float>(extent.width);
+    viewport.height   = static_cast<float>(extent.height);
     viewport.maxDepth = 1.0f;
     vkCmdSetViewport(cmd, 0, 1, &viewport);
 
@@ -323,7 +369,7 @@ void VulkanPostProcessGraphBuilder::recordSkybox(RGContext&, const Handles& h, c
     vkCmdEndRenderPass(cmd);
 }
 
-void VulkanPostProcessGraphBuilder::recordSSAO(RGContext&, const Handles& h, const Config&)
+void VulkanPostProcessGraphBuilder::recordSSAO(RGContext&, const Handles& h, const Config& cfg)
 {
     auto* api = m_api;
     VkCommandBuffer cmd = api->command_buffers[api->current_frame];
@@ -337,8 +383,8 @@ void VulkanPostProcessGraphBuilder::recordSSAO(RGContext&, const Handles& h, con
     }
 
     SSAOUbo ssaoUbo{};
-    ssaoUbo.projection    = api->projection_matrix;
-    ssaoUbo.invProjection = glm::inverse(api->projection_matrix);
+    ssaoUbo.projection    = sceneClipRemap(cfg) * api->projection_matrix;
+    ssaoUbo.invProjection = glm::inverse(ssaoUbo.projection);
     for (int i = 0; i < 16; i++) ssaoUbo.samples[i] = api->ssaoKernel[i];
     ssaoUbo.screenSize = glm::vec2(
         static_cast<float>(api->ssaoPass_.getWidth()),
@@ -348,12 +394,17 @@ void VulkanPostProcessGraphBuilder::recordSSAO(RGContext&, const Handles& h, con
     ssaoUbo.bias       = api->ssaoBias;
     ssaoUbo.power      = api->ssaoIntensity;
     std::memcpy(api->ssaoPass_.getUBOMapped(api->current_frame), &ssaoUbo, sizeof(SSAOUbo));
-    api->ssaoPass_.record(cmd, api->current_frame, api->fxaa_vertex_buffer);
+
+    VkDeviceSize quadOffset = 0;
+    VkBuffer quad = sceneQuad(cfg, quadOffset);
+    api->ssaoPass_.record(cmd, api->current_frame, quad, 0,
+                          scaledPassExtent(api->ssaoPass_.getWidth(), api->ssaoPass_.getHeight(), cfg),
+                          quadOffset);
 
     vkBackend.setCurrentLayout(h.ssaoRaw.handle, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
-void VulkanPostProcessGraphBuilder::recordSSAOBlurH(RGContext&, const Handles& h, const Config&)
+void VulkanPostProcessGraphBuilder::recordSSAOBlurH(RGContext&, const Handles& h, const Config& cfg)
 {
     auto* api = m_api;
     VkCommandBuffer cmd = api->command_buffers[api->current_frame];
@@ -372,12 +423,17 @@ void VulkanPostProcessGraphBuilder::recordSSAOBlurH(RGContext&, const Handles& h
     blurH.blurDir        = glm::vec2(1.0f, 0.0f);
     blurH.depthThreshold = 0.005f;
     std::memcpy(api->ssaoBlurHPass_.getUBOMapped(api->current_frame), &blurH, sizeof(SSAOBlurUbo));
-    api->ssaoBlurHPass_.record(cmd, api->current_frame, api->fxaa_vertex_buffer);
+
+    VkDeviceSize quadOffset = 0;
+    VkBuffer quad = sceneQuad(cfg, quadOffset);
+    api->ssaoBlurHPass_.record(cmd, api->current_frame, quad, 0,
+                               scaledPassExtent(api->ssaoBlurHPass_.getWidth(), api->ssaoBlurHPass_.getHeight(), cfg),
+                               quadOffset);
 
     vkBackend.setCurrentLayout(h.ssaoBlurH.handle, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
-void VulkanPostProcessGraphBuilder::recordSSAOBlurV(RGContext&, const Handles& h, const Config&)
+void VulkanPostProcessGraphBuilder::recordSSAOBlurV(RGContext&, const Handles& h, const Config& cfg)
 {
     auto* api = m_api;
     VkCommandBuffer cmd = api->command_buffers[api->current_frame];
@@ -396,7 +452,12 @@ void VulkanPostProcessGraphBuilder::recordSSAOBlurV(RGContext&, const Handles& h
     blurV.blurDir        = glm::vec2(0.0f, 1.0f);
     blurV.depthThreshold = 0.005f;
     std::memcpy(api->ssaoBlurVPass_.getUBOMapped(api->current_frame), &blurV, sizeof(SSAOBlurUbo));
-    api->ssaoBlurVPass_.record(cmd, api->current_frame, api->fxaa_vertex_buffer);
+
+    // Covers the whole output while sampling the scene rectangle, which upscales the AO
+    // for tonemapping
+    VkDeviceSize quadOffset = 0;
+    VkBuffer quad = sceneQuad(cfg, quadOffset);
+    api->ssaoBlurVPass_.record(cmd, api->current_frame, quad, 0, {0, 0}, quadOffset);
 
     vkBackend.setCurrentLayout(h.ssaoBlurV.handle, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
@@ -441,7 +502,8 @@ void VulkanPostProcessGraphBuilder::recordTonemapping(RGContext&, const Handles&
     auto* api = m_api;
     auto& vkBackend = static_cast<VulkanRGBackend&>(m_api->m_rgBackend);
 
-    VkImageView hdrView = vkBackend.getImageView(h.offscreenHDR.handle);
+    const RGTextureHandle sceneColor = h.upscaledHDR.isValid() ? h.upscaledHDR : h.offscreenHDR;
+    VkImageView hdrView = vkBackend.getImageView(sceneColor.handle);
     if (hdrView != VK_NULL_HANDLE) {
         api->fxaaPass_.writeImageBinding(api->current_frame, 0,
             hdrView, api->offscreen_sampler,
@@ -454,6 +516,29 @@ void VulkanPostProcessGraphBuilder::recordTonemapping(RGContext&, const Handles&
                         cfg.wantSSAO, cfg.wantShadowMask, cfg.renderRml, cfg.renderImGui);
 }
 
+void VulkanPostProcessGraphBuilder::recordUpscale(RGContext& ctx, const Handles& h, const Config& cfg)
+{
+    auto* vkCtx = static_cast<VulkanRGContext*>(&ctx);
+    auto& backend = m_api->m_rgBackend;
+
+    VkImage src = backend.getImage(h.offscreenHDR.handle);
+    VkImage dst = backend.getImage(h.upscaledHDR.handle);
+    if (src == VK_NULL_HANDLE || dst == VK_NULL_HANDLE) {
+        LOG_ENGINE_ERROR("[Vulkan] Upscale pass: missing images");
+        return;
+    }
+
+    VkImageBlit region{};
+    region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.srcOffsets[1]  = { static_cast<int32_t>(cfg.sceneWidth()), static_cast<int32_t>(cfg.sceneHeight()), 1 };
+    region.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.dstOffsets[1]  = { static_cast<int32_t>(cfg.width), static_cast<int32_t>(cfg.height), 1 };
+    vkCmdBlitImage(vkCtx->commandBuffer,
+                   src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1, &region, VK_FILTER_LINEAR);
+}
+
 void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Handles& h, const Config& cfg)
 {
     if (!m_api || !m_api->isDeferredActive())
@@ -527,7 +612,7 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             rpBegin.renderPass        = rp;
             rpBegin.framebuffer       = framebuffer;
             rpBegin.renderArea.offset = { 0, 0 };
-            rpBegin.renderArea.extent = { cfg.width, cfg.height };
+            rpBegin.renderArea.extent = sceneExtent(cfg);
             rpBegin.clearValueCount   = static_cast<uint32_t>(clears.size());
             rpBegin.pClearValues      = clears.data();
 
@@ -537,15 +622,15 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             VkViewport vp{};
             vp.x        = 0.0f;
             vp.y        = 0.0f;
-            vp.width    = static_cast<float>(cfg.width);
-            vp.height   = static_cast<float>(cfg.height);
+            vp.width    = static_cast<float>(cfg.sceneWidth());
+            vp.height   = static_cast<float>(cfg.sceneHeight());
             vp.minDepth = 0.0f;
             vp.maxDepth = 1.0f;
             vkCmdSetViewport(cmd, 0, 1, &vp);
 
             VkRect2D scissor{};
             scissor.offset = { 0, 0 };
-            scissor.extent = { cfg.width, cfg.height };
+            scissor.extent = sceneExtent(cfg);
             vkCmdSetScissor(cmd, 0, 1, &scissor);
 
             if (!m_api->m_deferredOpaqueCmds.empty()) {
@@ -563,6 +648,123 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             backend.setCurrentLayout(h.depth.handle,  VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
         });
 
+    // Decals blend into GBuffer 0 before it is lit
+    if (m_api->decals_initialized && !m_api->m_deferredDecals.empty())
+    {
+        graph.addPass("Decals",
+            [&, dh](RGBuilder& b) {
+                b.read(dh->gb1,  RGResourceUsage::ShaderResource);
+                b.read(h.depth,  depthReadUsage());
+                b.write(dh->gb0, RGResourceUsage::RenderTarget);
+                b.setSideEffect();
+            },
+            [this, dh, h, cfg](RGContext& ctx) {
+                auto* vkCtx = static_cast<VulkanRGContext*>(&ctx);
+                auto& backend = m_api->m_rgBackend;
+                auto& decalPass = m_api->decalPass_;
+
+                VkImageView gb0V   = backend.getImageView(dh->gb0.handle);
+                VkImageView gb1V   = backend.getImageView(dh->gb1.handle);
+                VkImageView depthV = backend.getImageView(h.depth.handle);
+                if (!gb0V || !gb1V || !depthV) {
+                    LOG_ENGINE_ERROR("[Vulkan] Decals: missing image views");
+                    m_api->m_deferredDecals.clear();
+                    return;
+                }
+
+                VkImageView atlasV = m_api->default_texture.imageView;
+                auto atlasIt = m_api->textures.find(m_api->m_deferredDecals.atlas);
+                if (atlasIt != m_api->textures.end() && atlasIt->second.imageView != VK_NULL_HANDLE)
+                    atlasV = atlasIt->second.imageView;
+
+                VulkanDecalPass::DecalCB cb{};
+                const glm::mat4 viewProj = m_api->projection_matrix * m_api->view_matrix;
+                cb.uInvViewProj = glm::inverse(sceneClipRemap(cfg) * viewProj);
+                cb.uViewProj    = viewProj;
+                cb.uTilesX      = DecalFrame::TILES_X;
+                cb.uTilesY      = DecalFrame::TILES_Y;
+
+                const uint32_t f = m_api->current_frame;
+                const bool uploaded = decalPass.upload(f, m_api->m_deferredDecals, cb);
+                m_api->m_deferredDecals.clear();
+                if (!uploaded)
+                    return;
+
+                decalPass.resetDescriptors(f);
+                VkDescriptorSet ds = decalPass.allocateDescriptorSet(f);
+                if (ds == VK_NULL_HANDLE) {
+                    LOG_ENGINE_ERROR("[Vulkan] Decals: descriptor alloc failed");
+                    return;
+                }
+
+                VkSampler linear = decalPass.getLinearSampler();
+                VkDescriptorImageInfo gb1I  { linear, gb1V,   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+                VkDescriptorImageInfo dpI   { linear, depthV, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+                VkDescriptorImageInfo atlasI{ linear, atlasV, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+                std::array<VkWriteDescriptorSet, 3> writes{};
+                auto fillImage = [&](size_t i, uint32_t binding, const VkDescriptorImageInfo* info) {
+                    writes[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    writes[i].dstSet          = ds;
+                    writes[i].dstBinding      = binding;
+                    writes[i].descriptorCount = 1;
+                    writes[i].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    writes[i].pImageInfo      = info;
+                };
+                fillImage(0, VulkanDecalPass::BINDING_GB1,   &gb1I);
+                fillImage(1, VulkanDecalPass::BINDING_DEPTH, &dpI);
+                fillImage(2, VulkanDecalPass::BINDING_ATLAS, &atlasI);
+                vkUpdateDescriptorSets(m_api->device,
+                                       static_cast<uint32_t>(writes.size()),
+                                       writes.data(), 0, nullptr);
+
+                VkFramebuffer framebuffer = getCachedFramebuffer(decalPass.getRenderPass(),
+                                                                 &gb0V, 1,
+                                                                 cfg.width, cfg.height, 1);
+                if (framebuffer == VK_NULL_HANDLE) {
+                    LOG_ENGINE_ERROR("[Vulkan] Decals: failed to create framebuffer");
+                    return;
+                }
+
+                VkRenderPassBeginInfo rpBegin{};
+                rpBegin.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                rpBegin.renderPass        = decalPass.getRenderPass();
+                rpBegin.framebuffer       = framebuffer;
+                rpBegin.renderArea.offset = { 0, 0 };
+                rpBegin.renderArea.extent = sceneExtent(cfg);
+
+                VkCommandBuffer cmd = vkCtx->commandBuffer;
+                vkCmdBeginRenderPass(cmd, &rpBegin, VK_SUBPASS_CONTENTS_INLINE);
+
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, decalPass.getPipeline());
+
+                VkViewport vp{};
+                vp.x        = 0.0f;
+                vp.y        = 0.0f;
+                vp.width    = static_cast<float>(cfg.sceneWidth());
+                vp.height   = static_cast<float>(cfg.sceneHeight());
+                vp.minDepth = 0.0f;
+                vp.maxDepth = 1.0f;
+                vkCmdSetViewport(cmd, 0, 1, &vp);
+
+                VkRect2D scissor{};
+                scissor.offset = { 0, 0 };
+                scissor.extent = sceneExtent(cfg);
+                vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                        decalPass.getPipelineLayout(),
+                                        0, 1, &ds, 0, nullptr);
+
+                bindSceneQuad(cmd, cfg);
+                vkCmdDraw(cmd, 6, 1, 0, 0);
+
+                vkCmdEndRenderPass(cmd);
+
+                backend.setCurrentLayout(dh->gb0.handle, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            });
+    }
+
     graph.addPass("DeferredLighting",
         [&, dh](RGBuilder& b) {
             b.read(dh->gb0,  RGResourceUsage::ShaderResource);
@@ -594,7 +796,7 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             }
 
             DeferredLightingCB ubo{};
-            ubo.uInvViewProj = glm::inverse(m_api->projection_matrix * m_api->view_matrix);
+            ubo.uInvViewProj = glm::inverse(sceneClipRemap(cfg) * m_api->projection_matrix * m_api->view_matrix);
             ubo.uView        = m_api->view_matrix;
             for (int i = 0; i < VulkanRenderAPI::NUM_CASCADES; ++i)
                 ubo.uLightSpaceMatrices[i] = m_api->lightSpaceMatrices[i];
@@ -709,7 +911,7 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             rpBegin.renderPass        = deferredPass.getRenderPass();
             rpBegin.framebuffer       = framebuffer;
             rpBegin.renderArea.offset = { 0, 0 };
-            rpBegin.renderArea.extent = { cfg.width, cfg.height };
+            rpBegin.renderArea.extent = sceneExtent(cfg);
             rpBegin.clearValueCount   = 1;
             rpBegin.pClearValues      = &clear;
 
@@ -721,24 +923,22 @@ void VulkanPostProcessGraphBuilder::addScenePasses(RenderGraph& graph, const Han
             VkViewport vp{};
             vp.x        = 0.0f;
             vp.y        = 0.0f;
-            vp.width    = static_cast<float>(cfg.width);
-            vp.height   = static_cast<float>(cfg.height);
+            vp.width    = static_cast<float>(cfg.sceneWidth());
+            vp.height   = static_cast<float>(cfg.sceneHeight());
             vp.minDepth = 0.0f;
             vp.maxDepth = 1.0f;
             vkCmdSetViewport(cmd, 0, 1, &vp);
 
             VkRect2D scissor{};
             scissor.offset = { 0, 0 };
-            scissor.extent = { cfg.width, cfg.height };
+            scissor.extent = sceneExtent(cfg);
             vkCmdSetScissor(cmd, 0, 1, &scissor);
 
             vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
                                     deferredPass.getPipelineLayout(),
                                     0, 1, &ds, 0, nullptr);
 
-            VkBuffer vbuf[]  = { m_api->fxaa_vertex_buffer };
-            VkDeviceSize off[] = { 0 };
-            vkCmdBindVertexBuffers(cmd, 0, 1, vbuf, off);
+            bindSceneQuad(cmd, cfg);
             vkCmdDraw(cmd, 6, 1, 0, 0);
 
             vkCmdEndRenderPass(cmd);
@@ -799,7 +999,7 @@ void VulkanPostProcessGraphBuilder::addPreTonemapPasses(RenderGraph& graph,
             rpBegin.renderPass = rp;
             rpBegin.framebuffer = framebuffer;
             rpBegin.renderArea.offset = { 0, 0 };
-            rpBegin.renderArea.extent = { cfg.width, cfg.height };
+            rpBegin.renderArea.extent = sceneExtent(cfg);
             rpBegin.clearValueCount = 0;
 
             VkCommandBuffer cmd = vkCtx->commandBuffer;
@@ -808,15 +1008,15 @@ void VulkanPostProcessGraphBuilder::addPreTonemapPasses(RenderGraph& graph,
             VkViewport vp{};
             vp.x = 0.0f;
             vp.y = 0.0f;
-            vp.width = static_cast<float>(cfg.width);
-            vp.height = static_cast<float>(cfg.height);
+            vp.width = static_cast<float>(cfg.sceneWidth());
+            vp.height = static_cast<float>(cfg.sceneHeight());
             vp.minDepth = 0.0f;
             vp.maxDepth = 1.0f;
             vkCmdSetViewport(cmd, 0, 1, &vp);
 
             VkRect2D scissor{};
             scissor.offset = { 0, 0 };
-            scissor.extent = { cfg.width, cfg.height };
+            scissor.extent = sceneExtent(cfg);
             vkCmdSetScissor(cmd, 0, 1, &scissor);
 
             m_api->m_replayPipelineOverride = VK_NULL_HANDLE;
@@ -2,6 +2,7 @@
 
 #include "Graphics/RenderGraph/PostProcessGraphBuilder.hpp"
 #include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
 #include <vector>
 
 class VulkanRenderAPI;
@@ -26,6 +27,14 @@ public:
                         VkImage         depthImage = VK_NULL_HANDLE,
                         VkImageView     depthView = VK_NULL_HANDLE);
 
+    // Fullscreen quad for the next build when it renders below full resolution: its UVs
+    // span the scene rectangle (Config::sceneWidth() / width, ...) instead of [0, 1].
+    void setSceneQuad(VkBuffer buffer, VkDeviceSize offset)
+    {
+        m_sceneQuad       = buffer;
+        m_sceneQuadOffset = offset;
+    }
+
 protected:
     Handles importResources(RenderGraph& graph, RGBackend& backend, const Config& cfg) override;
     RGResourceUsage depthReadUsage() const override { return RGResourceUsage::DepthStencilReadOnly; }
@@ -37,6 +46,9 @@ protected:
     void recordShadowMask (RGContext& ctx, const Handles& h, const Config& cfg) override;
     void recordTonemapping(RGContext& ctx, const Handles& h, const Config& cfg) override;
 
+    bool supportsRenderScale() const override;
+    void recordUpscale(RGContext& ctx, const Handles& h, const Config& cfg) override;
+
     void addScenePasses(RenderGraph& graph, const Handles& h, const Config& cfg) override;
     void addPreTonemapPasses(RenderGraph& graph, const Handles& h, const Config& cfg) override;
     void addExtraPasses(RenderGraph& graph, const Handles& h, const Config& cfg) override;
@@ -45,6 +57,15 @@ protected:
     VulkanRenderAPI* m_api = nullptr;
 
 private:
+    // Dynamic resolution. Scene passes draw the top-left sceneExtent() of the full-size
+    // targets. Fullscreen passes among them bind sceneQuad(), which samples only that
+    // rectangle, and premultiply the projection by sceneClipRemap() so positions rebuilt
+    // from those UVs land where the geometry pass put them. Identity at full resolution.
+    static VkExtent2D sceneExtent(const Config& cfg) { return { cfg.sceneWidth(), cfg.sceneHeight() }; }
+    static glm::mat4 sceneClipRemap(const Config& cfg);
+    void bindSceneQuad(VkCommandBuffer cmd, const Config& cfg) const;
+    VkBuffer sceneQuad(const Config& cfg, VkDeviceSize& offset) const;
+
     VkFramebuffer getCachedFramebuffer(VkRenderPass renderPass,
                                        const VkImageView* attachments,
                                        uint32_t attachmentCount,
@@ -71,5 +92,7 @@ private:
     VkImageView   m_hdrView              = VK_NULL_HANDLE;
     VkImage       m_depthImage           = VK_NULL_HANDLE;
     VkImageView   m_depthView            = VK_NULL_HANDLE;
+    VkBuffer      m_sceneQuad            = VK_NULL_HANDLE;
+    VkDeviceSize  m_sceneQuadOffset      = 0;
     std::vector<CachedFramebuffer> m_framebufferCache;
 };
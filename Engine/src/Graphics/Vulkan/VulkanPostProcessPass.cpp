@@ -326,16 +326,22 @@ void* VulkanPostProcessPass::getUBOMapped(uint32_t frameIndex) const
 
 void VulkanPostProcessPass::record(
     VkCommandBuffer cmd, uint32_t frameIndex,
-    VkBuffer fullscreenQuadVB, uint32_t framebufferIndex)
+    VkBuffer fullscreenQuadVB, uint32_t framebufferIndex,
+    VkExtent2D extent, VkDeviceSize vertexOffset)
 {
     if (!initialized_) return;
     if (framebufferIndex >= framebuffers_.size()) return;
 
+    if (extent.width == 0 || extent.height == 0)
+        extent = {width_, height_};
+    extent.width  = std::min(extent.width, width_);
+    extent.height = std::min(extent.height, height_);
+
     VkRenderPassBeginInfo rpInfo{};
     rpInfo.sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     rpInfo.renderPass  = renderPass_;
     rpInfo.framebuffer = framebuffers_[framebufferIndex];
-    rpInfo.renderArea  = {{0, 0}, {width_, height_}};
+    rpInfo.renderArea  = {{0, 0}, extent};
 
     VkClearValue clearVal{};
     clearVal.color = config_.clearColor;
@@ -354,22 +360,21 @@ void VulkanPostProcessPass::record(
     VkViewport viewport{};
     viewport.x        = 0.0f;
     viewport.y        = 0.0f;
-    viewport.width    = static_cast<float>(width_);
-    viewport.height   = static_cast<float>(height_);
+    viewport.width    = static_cast<float>(extent.width);
+    viewport.height   = static_cast<float>(extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
     vkCmdSetViewport(cmd, 0, 1, &viewport);
 
     VkRect2D scissor{};
     scissor.offset = {0, 0};
-    scissor.extent = {width_, height_};
+    scissor.extent = extent;
     vkCmdSetScissor(cmd, 0, 1, &scissor);
 
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_,
                             0, 1, &descriptorSets_[frameIndex], 0, nullptr);
 
-    VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(cmd, 0, 1, &fullscreenQuadVB, &offset);
+    vkCmdBindVertexBuffers(cmd, 0, 1, &fullscreenQuadVB, &vertexOffset);
     vkCmdDraw(cmd, 6, 1, 0, 0);
 
     vkCmdEndRenderPass(cmd);
@@ -107,9 +107,13 @@ public:
     // --- Record the fullscreen quad draw ---
     // framebufferIndex: for external-framebuffer mode (e.g., current_image_index).
     //                   For own-output mode, always 0.
+    // extent:           area drawn, from the top-left corner; {0, 0} draws the whole output.
+    // vertexOffset:     byte offset of the quad in fullscreenQuadVB.
     void record(VkCommandBuffer cmd, uint32_t frameIndex,
                 VkBuffer fullscreenQuadVB,
-                uint32_t framebufferIndex = 0);
+                uint32_t framebufferIndex = 0,
+                VkExtent2D extent = {0, 0},
+                VkDeviceSize vertexOffset = 0);
 
     // --- Accessors ---
     VkImageView     getOutputView()    const { return outputView_; }
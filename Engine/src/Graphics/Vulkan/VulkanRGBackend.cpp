@@ -2,6 +2,7 @@
 #include "vk_mem_alloc.h"
 #include "VkInitHelpers.hpp"
 #include "VkDeletionQueue.hpp"
+#include "VulkanGpuProfiler.hpp"
 #include "Utils/Log.hpp"
 
 void VulkanRGBackend::init(VkDevice device, VmaAllocator allocator)
@@ -111,7 +112,8 @@ void VulkanRGBackend::createTransientTexture(RGResourceHandle handle, const RGTe
 
     VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT;
     if (depth) usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    else       usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    else       usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                      | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
     VkImage image = VK_NULL_HANDLE;
     VmaAllocation allocation = nullptr;
@@ -275,6 +277,18 @@ void VulkanRGBackend::endFrame()
     }
 }
 
+void VulkanRGBackend::beginPass(const char* name)
+{
+    if (m_gpuProfiler)
+        m_gpuProfiler->beginScope(m_context.commandBuffer, name);
+}
+
+void VulkanRGBackend::endPass()
+{
+    if (m_gpuProfiler)
+        m_gpuProfiler->endScope(m_context.commandBuffer);
+}
+
 void VulkanRGBackend::clearCachedResources()
 {
     for (auto& pair : m_images) {
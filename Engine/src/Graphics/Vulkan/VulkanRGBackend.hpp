@@ -13,6 +13,7 @@ struct VmaAllocation_T;
 typedef VmaAllocation_T* VmaAllocation;
 
 class VkDeletionQueue;
+class VulkanGpuProfiler;
 
 // Vulkan-specific execution context for render graph pass callbacks.
 class VulkanRGContext : public RGContext {
@@ -34,6 +35,9 @@ public:
     // Set the command buffer the backend will record barriers into for the next execute().
     void setCommandBuffer(VkCommandBuffer commandBuffer);
 
+    // Time every executed pass with GPU timestamps. Null disables pass timing.
+    void setGpuProfiler(VulkanGpuProfiler* profiler) { m_gpuProfiler = profiler; }
+
     // RGBackend overrides
     void createTransientTexture(RGResourceHandle handle, const RGTextureDesc& desc) override;
     void destroyTransientTexture(RGResourceHandle handle) override;
@@ -44,6 +48,8 @@ public:
     RGContext& getContext() override;
     void beginFrame() override;
     void endFrame() override;
+    void beginPass(const char* name) override;
+    void endPass() override;
 
     // Destroy cached transient images. Call only after the device is idle or
     // when the caller otherwise guarantees no command buffer references them.
@@ -70,6 +76,7 @@ private:
     VkDevice m_device = VK_NULL_HANDLE;
     VmaAllocator m_allocator = nullptr;
     VkDeletionQueue* m_deletionQueue = nullptr;
+    VulkanGpuProfiler* m_gpuProfiler = nullptr;
     VulkanRGContext m_context;
 
     struct ImageEntry {
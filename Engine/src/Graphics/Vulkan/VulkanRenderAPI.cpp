@@ -171,6 +171,8 @@ bool VulkanRenderAPI::initialize(WindowHandle window, int width, int height, flo
     // Create deferred GBuffer + lighting passes (non-fatal — disables deferred if either fails)
     createGBufferResources();
     createDeferredLightingResources();
+    // Decals only need the deferred path; failing here just leaves them off
+    createDecalResources();
 
     // Create descriptor pool
     LOG_ENGINE_INFO("[Vulkan] Creating descriptor pool...");
@@ -2,13 +2,16 @@
 
 #include "Graphics/RenderAPI.hpp"
 #include "Graphics/RenderCommandBuffer.hpp"
+#include "Decals/DecalSystem.hpp"
 #include "VulkanTypes.hpp"
 #include "VkDeletionQueue.hpp"
 #include "VkSamplerCache.hpp"
 #include "VulkanPostProcessPass.hpp"
 #include "VulkanGBufferPass.hpp"
 #include "VulkanDeferredLightingPass.hpp"
+#include "VulkanDecalPass.hpp"
 #include "VulkanRGBackend.hpp"
+#include "VulkanGpuProfiler.hpp"
 #include "VulkanPostProcessGraphBuilder.hpp"
 #include "Graphics/RenderGraph/RenderGraph.hpp"
 #include "VulkanSceneViewport.hpp"
@@ -124,12 +127,14 @@ public:
     virtual void replayCommandBuffer(const RenderCommandBuffer& cmds) override;
     virtual void replayCommandBufferParallel(const RenderCommandBuffer& cmds) override;
     bool supportsHeightmapDisplacement() const override { return true; }
+    uint32_t getInstanceCapacity() const override { return instance_data_mapped.empty() ? 0 : MAX_STATIC_INSTANCE_DRAWS; }
 
     // Debug line rendering
     virtual void renderDebugLines(const vertex* vertices, size_t vertex_count) override;
 
     virtual const char* getAPIName() const override { return "Vulkan"; }
     RenderFrameStats getLastFrameStats() const override;
+    GpuPassTimings getGpuPassTimings() const override { return m_gpuProfiler.getTimings(); }
 
     // Graphics settings
     virtual void setVSyncEnabled(bool enabled) override;
@@ -143,12 +148,15 @@ public:
     virtual bool isSSAOEnabled() const override;
     virtual void setSSAORadius(float radius) override;
     virtual void setSSAOIntensity(float intensity) override;
+    void setDynamicResolution(const DynamicResolutionSettings& settings) override;
+    float getRenderScale() const override;
 
     void setDeferredEnabled(bool enabled) override { m_useDeferred = enabled; }
     bool isDeferredEnabled() const override { return m_useDeferred; }
     bool isDeferredActive() const override;
     void submitDeferredOpaqueCommands(const RenderCommandBuffer& cmds) override;
     void submitDeferredTransparentCommands(const RenderCommandBuffer& cmds) override;
+    void submitDeferredDecals(const DecalFrame& decals) override;
     void uploadLightBuffers(const GPUPointLight* pts, int ptCount,
                             const GPUSpotLight* spts, int spCount) override;
 
@@ -169,6 +177,7 @@ public:
     VkCommandBuffer getCurrentCommandBuffer() const { return command_buffers[current_frame]; }
     VkFormat getSwapchainFormat() const { return swapchain_format; }
     uint32_t getCurrentFrameIndex() const { return current_frame; }
+    uint64_t getFrameSerial() const { return frame_serial; }
     VkDeletionQueue& getDeletionQueue() { return deletion_queue; }
 
 private:
@@ -191,7 +200,11 @@ private:
     void consumeFrameTiming(uint32_t frameIndex);
     void beginFrameTiming();
     void endFrameTiming();
+    void beginGpuScope(const char* name);
+    void endGpuScope();
+    void endSceneGpuScope();
     bool ensureRenderFinishedSemaphores();
+    void applyDynamicResolution(PostProcessGraphBuilder::Config& cfg);
     bool createDescriptorSetLayout();
     bool createGraphicsPipeline();
     bool createDescriptorPool();
@@ -390,6 +403,7 @@ private:
     std::vector<VkFence> in_flight_fences;
     uint32_t current_frame = 0;
     uint32_t current_image_index = 0;
+    uint64_t frame_serial = 0; // Incremented each time a frame starts recording
 
     static constexpr uint32_t kFrameTimingQueriesPerFrame = 2;
     VkQueryPool m_frameTimingQueryPool = VK_NULL_HANDLE;
@@ -400,6 +414,21 @@ private:
     uint64_t m_completedTimingFrame = 0;
     RenderFrameStats m_lastFrameStats{};
 
+    // Per-pass GPU timings: render graph passes through m_rgBackend, the rest by name
+    VulkanGpuProfiler m_gpuProfiler;
+
+    // Dynamic resolution: the controller is fed GPU times in consumeFrameTiming. Each frame
+    // slot remembers the scale it was recorded at (0 when nothing rendered scaled) and owns
+    // kSceneQuadsPerFrame fullscreen quads in scene_quad_buffer, one per scaled graph build.
+    static constexpr uint32_t kSceneQuadsPerFrame = 8;
+    DynamicResolutionController m_dynamicResolution;
+    float m_frameRenderScale[MAX_FRAMES_IN_FLIGHT] = {};
+    uint32_t m_sceneQuadsUsed[MAX_FRAMES_IN_FLIGHT] = {};
+    bool m_sceneGpuScopeOpen = false;
+    bool m_shadowGpuScopeOpen = false;
+    bool m_shadowCascadeGpuScopeOpen = false;
+    bool m_previewGpuScopeOpen = false;
+
     // VMA allocator
     VmaAllocator vma_allocator = nullptr;
 
@@ -537,7 +566,8 @@ private:
     std::vector<void*> per_object_uniform_mapped;
     std::atomic<uint32_t> per_object_draw_index[2] = {0, 0}; // per-frame draw counter (atomic for multicore)
 
-    static constexpr uint32_t MAX_STATIC_INSTANCE_DRAWS = MAX_PER_OBJECT_DRAWS;
+    // Shared by static instancing and RenderCommandBuffer instanced draws (particles)
+    static constexpr uint32_t MAX_STATIC_INSTANCE_DRAWS = 65536;
     std::vector<VkBuffer> instance_data_buffers;
     std::vector<VmaAllocation> instance_data_allocations;
     std::vector<void*> instance_data_mapped;
@@ -659,6 +689,9 @@ private:
 
     VkBuffer fxaa_vertex_buffer = VK_NULL_HANDLE;
     VmaAllocation fxaa_vertex_allocation = nullptr;
+    VkBuffer scene_quad_buffer = VK_NULL_HANDLE;        // Dynamic resolution quads, see kSceneQuadsPerFrame
+    VmaAllocation scene_quad_allocation = nullptr;
+    void* scene_quad_mapped = nullptr;
     VulkanPostProcessPass fxaaPass_;                   // FXAA pipeline, render pass, descriptors, UBOs
     std::vector<VkFramebuffer> fxaa_framebuffers;      // Swapchain framebuffers (shared with renderUI)
     VkPipeline viewport_fxaa_pipeline = VK_NULL_HANDLE;
@@ -673,6 +706,10 @@ private:
     void cleanupGBufferResources();
     bool createDeferredLightingResources();
     void cleanupDeferredLightingResources();
+    VulkanDecalPass decalPass_;
+    bool decals_initialized = false;
+    bool createDecalResources();
+    void cleanupDecalResources();
 
     // SSAO post-process passes
     VulkanPostProcessPass ssaoPass_;        // computation
@@ -724,6 +761,7 @@ private:
     // true; the GBuffer / TransparentForward graph passes replay them.
     RenderCommandBuffer m_deferredOpaqueCmds;
     RenderCommandBuffer m_deferredTransparentCmds;
+    DecalFrame m_deferredDecals;
     std::vector<vertex> m_deferredDebugLineVertices;
 
     // Optional pipeline override for replay paths. When non-null, the buffered
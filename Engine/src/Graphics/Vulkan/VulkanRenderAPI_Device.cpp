@@ -197,11 +197,17 @@ bool VulkanRenderAPI::createFrameTimingResources()
 
     m_frameTimingSupported = true;
     m_lastFrameStats.backend_name = getAPIName();
+
+    // Per-pass timings are optional on top of the frame time
+    m_gpuProfiler.init(device, m_frameTimingTimestampPeriod, MAX_FRAMES_IN_FLIGHT);
+    m_rgBackend.setGpuProfiler(&m_gpuProfiler);
     return true;
 }
 
 void VulkanRenderAPI::cleanupFrameTimingResources()
 {
+    m_rgBackend.setGpuProfiler(nullptr);
+    m_gpuProfiler.shutdown();
     if (m_frameTimingQueryPool != VK_NULL_HANDLE && device != VK_NULL_HANDLE)
     {
         vkDestroyQueryPool(device, m_frameTimingQueryPool, nullptr);
@@ -54,11 +54,34 @@ bool VulkanRenderAPI::createPostProcessingResources()
         vmaUnmapMemory(vma_allocator, fxaa_vertex_allocation);
     }
 
+    // ── Dynamic resolution quads (UVs written per graph build by applyDynamicResolution) ──
+    if (scene_quad_buffer == VK_NULL_HANDLE) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = sizeof(float) * 24 * kSceneQuadsPerFrame * MAX_FRAMES_IN_FLIGHT;
+        bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo mapped{};
+        if (vmaCreateBuffer(vma_allocator, &bufferInfo, &allocInfo,
+                            &scene_quad_buffer, &scene_quad_allocation, &mapped) != VK_SUCCESS) {
+            // Not fatal: the graph then always renders at full resolution
+            LOG_ENGINE_WARN("[Vulkan] Failed to create dynamic resolution quad buffer");
+            scene_quad_buffer = VK_NULL_HANDLE;
+            scene_quad_allocation = nullptr;
+        } else {
+            scene_quad_mapped = mapped.pMappedData;
+        }
+    }
+
     // ── Offscreen HDR render target (scene renders here, FXAA reads from it) ──
     if (offscreen_image == VK_NULL_HANDLE) {
         if (vkutil::createImage(vma_allocator, swapchain_extent.width, swapchain_extent.height,
                                 VK_FORMAT_R16G16B16A16_SFLOAT,
-                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
                                 offscreen_image, offscreen_allocation) != VK_SUCCESS) {
             printf("Failed to create offscreen image\n");
             return false;
@@ -409,9 +432,10 @@ void VulkanRenderAPI::cleanupPostProcessingResources()
     // Clean up the FXAA post-process pass
     fxaaPass_.cleanup();
 
-    // Clean up deferred GBuffer + lighting passes
+    // Clean up deferred GBuffer + lighting + decal passes
     cleanupGBufferResources();
     cleanupDeferredLightingResources();
+    cleanupDecalResources();
 
     // Clean up offscreen framebuffers
     for (auto fb : offscreen_framebuffers) {
@@ -461,6 +485,14 @@ void VulkanRenderAPI::cleanupPostProcessingResources()
         fxaa_vertex_allocation = nullptr;
     }
 
+    if (scene_quad_buffer != VK_NULL_HANDLE && vma_allocator) {
+        vmaDestroyBuffer(vma_allocator, scene_quad_buffer, scene_quad_allocation);
+        scene_quad_buffer = VK_NULL_HANDLE;
+        scene_quad_allocation = nullptr;
+        scene_quad_mapped = nullptr;
+        m_ppGraphBuilder.setSceneQuad(VK_NULL_HANDLE, 0);
+    }
+
     // SSAO fallback (created here, cleaned up here)
     if (ssao_fallback_view != VK_NULL_HANDLE) {
         vkDestroyImageView(device, ssao_fallback_view, nullptr);
@@ -518,7 +550,7 @@ void VulkanRenderAPI::recreateOffscreenResources()
     // Recreate offscreen HDR target
     vkutil::createImage(vma_allocator, swapchain_extent.width, swapchain_extent.height,
                         VK_FORMAT_R16G16B16A16_SFLOAT,
-                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
                         offscreen_image, offscreen_allocation);
 
     offscreen_view = vkutil::createImageView(device, offscreen_image, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
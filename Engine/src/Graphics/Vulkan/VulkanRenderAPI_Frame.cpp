@@ -5,6 +5,25 @@
 #include <cstring>
 #include <array>
 
+namespace {
+// Graph passes that run at the dynamic resolution scale
+constexpr const char* kScaledPasses[] = {
+    "GBuffer", "DeferredLighting", "Skybox", "SSAO", "SSAO Blur H", "TransparentForward"
+};
+
+float scaledPassMs(const GpuPassTimings& timings)
+{
+    float ms = 0.0f;
+    for (const GpuPassTiming& pass : timings.passes) {
+        for (const char* name : kScaledPasses) {
+            if (pass.depth == 0 && pass.name == name)
+                ms += pass.last_ms;
+        }
+    }
+    return ms;
+}
+} // namespace
+
 RenderFrameStats VulkanRenderAPI::getLastFrameStats() const
 {
     RenderFrameStats stats = m_lastFrameStats;
@@ -16,7 +35,10 @@ void VulkanRenderAPI::consumeFrameTiming(uint32_t frameIndex)
 {
     if (!m_frameTimingSupported || !m_frameTimingPendingReadback[frameIndex] ||
         m_frameTimingQueryPool == VK_NULL_HANDLE)
+    {
+        m_gpuProfiler.collect(frameIndex, -1.0f, m_completedTimingFrame);
         return;
+    }
 
     const uint32_t base_query = frameIndex * kFrameTimingQueriesPerFrame;
     uint64_t timestamps[kFrameTimingQueriesPerFrame] = {};
@@ -33,11 +55,78 @@ void VulkanRenderAPI::consumeFrameTiming(uint32_t frameIndex)
         m_lastFrameStats.gpu_frame_ms_valid = true;
         m_lastFrameStats.gpu_frame_ms = static_cast<float>(elapsed_ms);
         m_lastFrameStats.completed_gpu_frame = ++m_completedTimingFrame;
+        m_gpuProfiler.collect(frameIndex, static_cast<float>(elapsed_ms), m_completedTimingFrame);
+
+        if (m_frameRenderScale[frameIndex] > 0.0f) {
+            // Without per-pass timings the whole frame is taken to scale with resolution
+            const GpuPassTimings& timings = m_gpuProfiler.getTimings();
+            const float frameMs = static_cast<float>(elapsed_ms);
+            const float scaledMs = timings.valid && timings.frame == m_completedTimingFrame
+                                       ? scaledPassMs(timings) : frameMs;
+            m_dynamicResolution.update(frameMs, scaledMs, m_frameRenderScale[frameIndex]);
+        }
+    }
+    else
+    {
+        m_gpuProfiler.collect(frameIndex, -1.0f, m_completedTimingFrame);
     }
 
     m_frameTimingPendingReadback[frameIndex] = false;
 }
 
+void VulkanRenderAPI::setDynamicResolution(const DynamicResolutionSettings& settings)
+{
+    m_dynamicResolution.setSettings(settings);
+}
+
+float VulkanRenderAPI::getRenderScale() const
+{
+    return isDeferredActive() ? m_dynamicResolution.getScale() : 1.0f;
+}
+
+// Called before each graph build. Renders the deferred scene passes into the top-left of
+// the unchanged full-size targets, so a scale change never reallocates anything.
+void VulkanRenderAPI::applyDynamicResolution(PostProcessGraphBuilder::Config& cfg)
+{
+    if (!m_dynamicResolution.getSettings().enabled || !isDeferredActive() || scene_quad_mapped == nullptr)
+        return;
+
+    // The controller learns from the scale this frame actually rendered at, so the
+    // full-size fallbacks report 1.0
+    const float scale = m_dynamicResolution.getScale();
+    m_frameRenderScale[current_frame] = 1.0f;
+
+    const uint32_t width  = DynamicResolutionController::scaleExtent(cfg.width, scale);
+    const uint32_t height = DynamicResolutionController::scaleExtent(cfg.height, scale);
+    if (width == cfg.width && height == cfg.height)
+        return;
+
+    uint32_t& used = m_sceneQuadsUsed[current_frame];
+    if (used >= kSceneQuadsPerFrame)
+        return;
+
+    const float u = static_cast<float>(width)  / static_cast<float>(cfg.width);
+    const float v = static_cast<float>(height) / static_cast<float>(cfg.height);
+    const float quadVertices[] = {
+        // pos        // texCoords
+        -1.0f,  1.0f, 0.0f, v,
+        -1.0f, -1.0f, 0.0f, 0.0f,
+         1.0f, -1.0f, u,    0.0f,
+
+        -1.0f,  1.0f, 0.0f, v,
+         1.0f, -1.0f, u,    0.0f,
+         1.0f,  1.0f, u,    v
+    };
+    const VkDeviceSize offset = (current_frame * kSceneQuadsPerFrame + used) * sizeof(quadVertices);
+    std::memcpy(static_cast<char*>(scene_quad_mapped) + offset, quadVertices, sizeof(quadVertices));
+    ++used;
+
+    m_ppGraphBuilder.setSceneQuad(scene_quad_buffer, offset);
+    cfg.renderWidth  = width;
+    cfg.renderHeight = height;
+    m_frameRenderScale[current_frame] = scale;
+}
+
 void VulkanRenderAPI::beginFrameTiming()
 {
     if (!m_frameTimingSupported || m_frameTimingQueryPool == VK_NULL_HANDLE ||
@@ -53,6 +142,13 @@ void VulkanRenderAPI::beginFrameTiming()
 
 void VulkanRenderAPI::endFrameTiming()
 {
+    if (frame_started)
+        m_gpuProfiler.endFrame(command_buffers[current_frame]);
+    m_sceneGpuScopeOpen = false;
+    m_shadowGpuScopeOpen = false;
+    m_shadowCascadeGpuScopeOpen = false;
+    m_previewGpuScopeOpen = false;
+
     if (!m_frameTimingSupported || m_frameTimingQueryPool == VK_NULL_HANDLE ||
         !m_frameTimingActive[current_frame] || !frame_started)
         return;
@@ -64,6 +160,28 @@ void VulkanRenderAPI::endFrameTiming()
     m_frameTimingPendingReadback[current_frame] = true;
 }
 
+void VulkanRenderAPI::beginGpuScope(const char* name)
+{
+    if (frame_started)
+        m_gpuProfiler.beginScope(command_buffers[current_frame], name);
+}
+
+void VulkanRenderAPI::endGpuScope()
+{
+    if (frame_started)
+        m_gpuProfiler.endScope(command_buffers[current_frame]);
+}
+
+// The scene scope opens with the first main pass of a view and closes where its
+// post-processing starts, so it covers every continuation pass in between.
+void VulkanRenderAPI::endSceneGpuScope()
+{
+    if (!m_sceneGpuScopeOpen)
+        return;
+    endGpuScope();
+    m_sceneGpuScopeOpen = false;
+}
+
 // Frame management
 void VulkanRenderAPI::prepareFrame()
 {
@@ -86,8 +204,10 @@ void VulkanRenderAPI::prepareFrame()
     }
 
     // Wait for previous frame
+    const Uint64 fenceWaitStart = SDL_GetTicksNS();
     VkResult fenceResult = vkWaitForFences(
         device, 1, &in_flight_fences[current_frame], VK_TRUE, FENCE_TIMEOUT_NS);
+    m_lastFrameStats.cpu_fence_wait_ms = static_cast<float>(SDL_GetTicksNS() - fenceWaitStart) / 1000000.0f;
     if (fenceResult == VK_TIMEOUT) {
         LOG_ENGINE_ERROR("[Vulkan] GPU fence timed out after 5s on frame {}. "
                          "Device may be hung. Skipping frame.", current_frame);
@@ -104,6 +224,8 @@ void VulkanRenderAPI::prepareFrame()
     // Process deferred deletions (safe now that fence has signaled)
     deletion_queue.flush();
     consumeFrameTiming(current_frame);
+    m_frameRenderScale[current_frame] = 0.0f;
+    m_sceneQuadsUsed[current_frame] = 0;
 
     if (m_vsyncDirty) {
         m_vsyncDirty = false;
@@ -195,6 +317,11 @@ void VulkanRenderAPI::prepareFrame()
 
         vkBeginCommandBuffer(command_buffers[current_frame], &beginInfo);
     }
+    m_gpuProfiler.beginFrame(current_frame, command_buffers[current_frame]);
+    m_sceneGpuScopeOpen = false;
+    m_shadowGpuScopeOpen = false;
+    m_shadowCascadeGpuScopeOpen = false;
+    m_previewGpuScopeOpen = false;
 
     // Reset model matrix
     current_model_matrix = glm::mat4(1.0f);
@@ -203,6 +330,7 @@ void VulkanRenderAPI::prepareFrame()
     // Reset bound texture (stale from previous frame)
     bound_texture = INVALID_TEXTURE;
 
+    frame_serial++;
     frame_started = true;
     beginFrameTiming();
 }
@@ -281,6 +409,10 @@ void VulkanRenderAPI::beginFrame()
     current_render_extent = renderExtent;
     current_active_color_image = activeColorImage;
 
+    if (!m_sceneGpuScopeOpen) {
+        beginGpuScope("Scene");
+        m_sceneGpuScopeOpen = true;
+    }
     vkCmdBeginRenderPass(command_buffers[current_frame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
     main_pass_started = true;
 
@@ -336,6 +468,7 @@ void VulkanRenderAPI::endFrame()
             using_continuation_pass = false;
         }
     }
+    endSceneGpuScope();
 
     // Post-process only in standalone mode (viewport mode is handled by endSceneRender + renderUI)
     if (!isViewportMode())
@@ -355,6 +488,7 @@ void VulkanRenderAPI::endFrame()
 
             if (isDeferredActive())
                 cfg.wantShadowMask = false;
+            applyDynamicResolution(cfg);
 
             m_ppGraphBuilder.setFrameInputs(
                 swapchain_images[current_image_index], VK_IMAGE_LAYOUT_UNDEFINED,
@@ -391,6 +525,7 @@ void VulkanRenderAPI::endFrame()
 
                 // SSAO passes
                 if (wantSSAO) {
+                    beginGpuScope("SSAO");
                     SSAOUbo ssaoUbo{};
                     ssaoUbo.projection = projection_matrix;
                     ssaoUbo.invProjection = glm::inverse(projection_matrix);
@@ -418,10 +553,12 @@ void VulkanRenderAPI::endFrame()
                     ssaoBlurVPass_.record(cmd, current_frame, fxaa_vertex_buffer);
 
                     fxaaPass_.writeImageBinding(current_frame, 2, ssaoBlurVPass_.getOutputView(), ssaoBlurVPass_.getOutputSampler());
+                    endGpuScope();
                 }
 
                 // Shadow mask pass
                 if (wantShadowMask) {
+                    beginGpuScope("Shadow Mask");
                     ShadowMaskUbo shadowMaskUbo{};
                     shadowMaskUbo.invViewProj = glm::inverse(projection_matrix * view_matrix);
                     shadowMaskUbo.view = view_matrix;
@@ -441,6 +578,7 @@ void VulkanRenderAPI::endFrame()
                     shadowMaskPass_.record(cmd, current_frame, fxaa_vertex_buffer);
 
                     fxaaPass_.writeImageBinding(current_frame, 3, shadowMaskPass_.getOutputView(), shadowMaskPass_.getOutputSampler());
+                    endGpuScope();
                 }
 
                 // Restore depth layout to ATTACHMENT_OPTIMAL for the next frame's scene pass
@@ -484,12 +622,14 @@ void VulkanRenderAPI::endFrame()
 
             // FXAA/tone-mapping pass (scene renders to HDR offscreen, this resolves to LDR swapchain)
             if (fxaaPass_.isInitialized()) {
+                beginGpuScope("Tonemapping");
                 renderFXAAPass(command_buffers[current_frame],
                                fxaaPass_.getRenderPass(),
                                fxaa_framebuffers[current_image_index],
                                fxaaPass_.getPipeline(),
                                swapchain_extent.width, swapchain_extent.height,
                                wantSSAO, wantShadowMask, true, true);
+                endGpuScope();
             }
         }
     }
@@ -66,3 +66,36 @@ void VulkanRenderAPI::cleanupDeferredLightingResources()
     deferredLightingPass_.cleanup();
     deferred_lighting_initialized = false;
 }
+
+bool VulkanRenderAPI::createDecalResources()
+{
+    if (decals_initialized) return true;
+
+    const std::string vsPath = EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/decals.vert.spv");
+    const std::string fsPath = EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/decals.frag.spv");
+
+    auto vs = readShaderFile(vsPath);
+    auto fs = readShaderFile(fsPath);
+    if (vs.empty() || fs.empty()) {
+        LOG_ENGINE_WARN("[Vulkan] Decal shaders not found (vs={} bytes, fs={} bytes) -- decals disabled",
+                        vs.size(), fs.size());
+        return false;
+    }
+
+    if (!decalPass_.init(device, vma_allocator, vk_pipeline_cache, vs, fs,
+                         MAX_FRAMES_IN_FLIGHT)) {
+        LOG_ENGINE_WARN("[Vulkan] Failed to create Decal pass -- decals disabled");
+        return false;
+    }
+
+    decals_initialized = true;
+    LOG_ENGINE_INFO("[Vulkan] Decal pass created");
+    return true;
+}
+
+void VulkanRenderAPI::cleanupDecalResources()
+{
+    if (device == VK_NULL_HANDLE) return;
+    decalPass_.cleanup();
+    decals_initialized = false;
+}
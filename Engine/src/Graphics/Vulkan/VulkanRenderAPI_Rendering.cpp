@@ -906,7 +906,7 @@ bool VulkanRenderAPI::replayStaticInstancedBatch(VkCommandBuffer cmd, const Rend
                                                  VulkanMesh* vulkanMesh, VkPipeline selectedPipeline,
                                                  VkDescriptorSet ds, uint32_t perObjectDynamicOffset)
 {
-    if (count < 2 || !vulkanMesh)
+    if (count == 0 || !vulkanMesh)
         return false;
 
     const DrawCommand& drawCmd = cmds[start];
@@ -1095,24 +1095,41 @@ void VulkanRenderAPI::replayCommandBuffer(const RenderCommandBuffer& cmds)
             last_bound_pipeline = selectedPipeline;
         }
 
+        // Explicit instanced draws carry their own transforms; otherwise batch runs of
+        // identical static draws into one instanced draw
+        const bool explicitInstances = drawCmd.instance_count > 0;
         size_t batchCount = 1;
-        if (allowStaticInstancing && isStaticInstancingEligible(drawCmd)) {
+        if (!explicitInstances && allowStaticInstancing && isStaticInstancingEligible(drawCmd)) {
             while (cmdIndex + batchCount < cmds.size() &&
                    staticInstanceCompatible(drawCmd, cmds[cmdIndex + batchCount]))
             {
                 ++batchCount;
             }
         }
+        size_t instanceCount = explicitInstances ? drawCmd.instance_count : batchCount;
 
         bool useInstanceData = false;
         uint32_t instanceBase = 0;
-        if (batchCount >= 2 &&
+        if ((explicitInstances || instanceCount >= 2) &&
             current_frame < instance_data_mapped.size() &&
             instance_data_mapped[current_frame] != nullptr)
         {
             uint32_t base = instance_data_index[current_frame].fetch_add(
-                static_cast<uint32_t>(batchCount), std::memory_order_relaxed);
-            if (base + batchCount <= MAX_STATIC_INSTANCE_DRAWS) {
+                static_cast<uint32_t>(instanceCount), std::memory_order_relaxed);
+            if (explicitInstances && base < MAX_STATIC_INSTANCE_DRAWS) {
+                // The slots from base up to the end of the buffer are ours; draw what fits
+                instanceCount = std::min<size_t>(instanceCount, MAX_STATIC_INSTANCE_DRAWS - base);
+                instanceBase = base;
+                useInstanceData = true;
+                VulkanInstanceData* instanceDst =
+                    static_cast<VulkanInstanceData*>(instance_data_mapped[current_frame]) + instanceBase;
+                const glm::mat4* transforms = cmds.instanceTransforms(drawCmd);
+                for (size_t i = 0; i < instanceCount; ++i) {
+                    // Instance transforms are similarity transforms; the shader renormalizes
+                    instanceDst[i].model = transforms[i];
+                    instanceDst[i].normalMatrix = glm::mat4(glm::mat3(transforms[i]));
+                }
+            } else if (!explicitInstances && base + batchCount <= MAX_STATIC_INSTANCE_DRAWS) {
                 instanceBase = base;
                 useInstanceData = true;
                 VulkanInstanceData* instanceDst =
@@ -1124,8 +1141,11 @@ void VulkanRenderAPI::replayCommandBuffer(const RenderCommandBuffer& cmds)
                 }
             } else {
                 batchCount = 1;
+                instanceCount = 1;
             }
         }
+        if (explicitInstances && !useInstanceData)
+            continue;  // Out of instance data this frame
 
         // Upload PerObjectUBO to dynamic ring buffer (atomic increment for multicore safety)
         uint32_t perObjectDynamicOffset;
@@ -1178,7 +1198,7 @@ void VulkanRenderAPI::replayCommandBuffer(const RenderCommandBuffer& cmds)
         }
 
         if (useInstanceData) {
-            if (replayStaticInstancedBatch(cmd, cmds, cmdIndex, batchCount,
+            if (replayStaticInstancedBatch(cmd, cmds, cmdIndex, instanceCount,
                                            vulkanMesh, selectedPipeline,
                                            ds, perObjectDynamicOffset))
             {
@@ -1242,7 +1262,7 @@ void VulkanRenderAPI::replayCommandBufferParallel(const RenderCommandBuffer& cmd
 
     const bool commandClassSupported = std::all_of(cmds.begin(), cmds.end(),
         [](const DrawCommand& cmd) {
-            return !cmd.pso_key.shadow && !cmd.pso_key.depth_only;
+            return !cmd.pso_key.shadow && !cmd.pso_key.depth_only && cmd.instance_count == 0;
         });
     if (!commandClassSupported)
     {
@@ -1819,6 +1839,11 @@ void VulkanRenderAPI::submitDeferredTransparentCommands(const RenderCommandBuffe
     m_deferredTransparentCmds = cmds;
 }
 
+void VulkanRenderAPI::submitDeferredDecals(const DecalFrame& decals)
+{
+    m_deferredDecals = decals;
+}
+
 void VulkanRenderAPI::uploadLightBuffers(const GPUPointLight* pts, int ptCount,
                                          const GPUSpotLight*  spts, int spCount)
 {
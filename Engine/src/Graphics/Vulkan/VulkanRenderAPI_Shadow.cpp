@@ -670,6 +670,11 @@ void VulkanRenderAPI::beginShadowPass(const glm::vec3& lightDir, const camera& c
 
 void VulkanRenderAPI::beginCascade(int cascadeIndex)
 {
+    static const char* const kCascadeScopeNames[] = {
+        "Shadow Cascade 0", "Shadow Cascade 1", "Shadow Cascade 2", "Shadow Cascade 3"
+    };
+    static_assert(std::size(kCascadeScopeNames) == NUM_CASCADES, "one GPU timing scope name per cascade");
+
     if (!frame_started || !in_shadow_pass) return;
 
     if (cascadeIndex < 0 || cascadeIndex >= NUM_CASCADES) {
@@ -689,6 +694,19 @@ void VulkanRenderAPI::beginCascade(int cascadeIndex)
         main_pass_started = false;
     }
 
+    // Timestamps go between the render passes: cascades nest inside one "Shadows" scope
+    if (m_shadowCascadeGpuScopeOpen) {
+        endGpuScope();
+        m_shadowCascadeGpuScopeOpen = false;
+    }
+    if (!m_shadowGpuScopeOpen) {
+        endSceneGpuScope();
+        beginGpuScope("Shadows");
+        m_shadowGpuScopeOpen = true;
+    }
+    beginGpuScope(kCascadeScopeNames[cascadeIndex]);
+    m_shadowCascadeGpuScopeOpen = true;
+
     // Push light space matrix for this cascade (offset 0, embedded in command buffer)
     // Note: UBO approach was broken because all cascades overwrote the same mapped buffer
     // during command recording, and only the last cascade's matrix survived to GPU execution.
@@ -749,6 +767,15 @@ void VulkanRenderAPI::endShadowPass()
         shadow_pass_active = false;
     }
 
+    if (m_shadowCascadeGpuScopeOpen) {
+        endGpuScope();
+        m_shadowCascadeGpuScopeOpen = false;
+    }
+    if (m_shadowGpuScopeOpen) {
+        endGpuScope();
+        m_shadowGpuScopeOpen = false;
+    }
+
     in_shadow_pass = false;
 }
 
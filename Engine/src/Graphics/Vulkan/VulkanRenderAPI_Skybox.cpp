@@ -342,6 +342,9 @@ void VulkanRenderAPI::renderSkybox()
 
     memcpy(skybox_uniform_mapped[current_frame], &ubo, sizeof(SkyboxUBO));
 
+    // Drawn inside the (inline) scene pass, so it nests under the "Scene" scope
+    beginGpuScope("Skybox");
+
     // Bind skybox pipeline
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, skybox_pipeline);
 
@@ -356,6 +359,7 @@ void VulkanRenderAPI::renderSkybox()
 
     // Draw fullscreen quad (6 vertices)
     vkCmdDraw(cmd, 6, 1, 0, 0);
+    endGpuScope();
 
     // Invalidate state tracking -- skybox used different pipeline/descriptors
     last_bound_pipeline = VK_NULL_HANDLE;
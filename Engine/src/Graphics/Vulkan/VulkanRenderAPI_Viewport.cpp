@@ -430,6 +430,8 @@ void VulkanRenderAPI::endSceneRender()
             }
         }
 
+        endSceneGpuScope();
+
         bool wantSSAO = ssaoEnabled && ssao_initialized;
         bool wantShadowMask = shadowQuality > 0 && shadow_mask_initialized && shadow_map_image != VK_NULL_HANDLE;
 
@@ -444,6 +446,7 @@ void VulkanRenderAPI::endSceneRender()
 
             if (isDeferredActive())
                 cfg.wantShadowMask = false;
+            applyDynamicResolution(cfg);
 
             m_ppGraphBuilder.setFrameInputs(
                 target.image, VK_IMAGE_LAYOUT_UNDEFINED,
@@ -496,6 +499,8 @@ void VulkanRenderAPI::endSceneRender()
         }
     }
 
+    endSceneGpuScope();
+
     // Run post-processing (skybox, SSAO, shadow mask, FXAA/tonemapping)
     bool wantSSAO = ssaoEnabled && ssao_initialized;
     bool wantShadowMask = shadowQuality > 0 && shadow_mask_initialized && shadow_map_image != VK_NULL_HANDLE;
@@ -512,6 +517,7 @@ void VulkanRenderAPI::endSceneRender()
 
         if (isDeferredActive())
             cfg.wantShadowMask = false;
+        applyDynamicResolution(cfg);
 
         m_ppGraphBuilder.setFrameInputs(
             viewport_image, VK_IMAGE_LAYOUT_UNDEFINED,
@@ -733,6 +739,7 @@ void VulkanRenderAPI::renderUI()
     rpBegin.clearValueCount = 1;
     rpBegin.pClearValues = &clearValue;
 
+    beginGpuScope("UI");
     vkCmdBeginRenderPass(cmd, &rpBegin, VK_SUBPASS_CONTENTS_INLINE);
 
     VkViewport vp{};
@@ -764,6 +771,7 @@ void VulkanRenderAPI::renderUI()
     }
 
     vkCmdEndRenderPass(cmd);
+    endGpuScope();
     endFrameTiming();
     vkEndCommandBuffer(cmd);
     frame_started = false;
@@ -901,6 +909,11 @@ void VulkanRenderAPI::beginPreviewFrame(int width, int height)
         vkCmdEndRenderPass(cmd);
         main_pass_started = false;
     }
+    endSceneGpuScope();
+    if (!m_previewGpuScopeOpen) {
+        beginGpuScope("Preview");
+        m_previewGpuScopeOpen = true;
+    }
 
     // Transition preview image to color attachment
     VkImageMemoryBarrier barrier{};
@@ -982,6 +995,10 @@ void VulkanRenderAPI::endPreviewFrame()
     vkCmdPipelineBarrier(cmd,
         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
         0, 0, nullptr, 0, nullptr, 1, &barrier);
+    if (m_previewGpuScopeOpen) {
+        endGpuScope();
+        m_previewGpuScopeOpen = false;
+    }
 }
 
 uint64_t VulkanRenderAPI::getPreviewTextureID()
@@ -2,7 +2,10 @@
 
 #include "Components/camera.hpp"
 #include "Components/Components.hpp"
+#include "Components/FoliageComponent.hpp"
 #include "Components/mesh.hpp"
+#include "Components/ParticleEmitterComponent.hpp"
+#include "Decals/DecalSystem.hpp"
 #include "RenderAPI.hpp"
 #include "RenderCommandBuffer.hpp"
 #include "RenderContext.hpp"
@@ -10,14 +13,18 @@
 #include "UI/RmlUiManager.h"
 #include "Frustum.hpp"
 #include "BVH.hpp"
+#include "RenderView.hpp"
 #include "Debug/DebugDraw.hpp"
 #include "LODSelector.hpp"
 #include "Console/ConVar.hpp"
 #include "Threading/FrameSync.hpp"
+#include "Threading/JobSystem.hpp"
 #include <entt/entt.hpp>
 #include <algorithm>
+#include <chrono>
 #include <future>
 #include <thread>
+#include <unordered_map>
 
 class renderer
 {
@@ -37,9 +44,21 @@ public:
     size_t last_total_entities = 0;
     size_t last_visible_entities = 0;
     size_t last_draw_calls = 0;
+    FoliageStats last_foliage_stats;
+    DecalStats last_decal_stats;
 
     bool depth_prepass_enabled = true;
 
+    // Multi-view rendering: BVHs for registries other than the primary one
+    // (which uses scene_bvh), and the last frame's per-view work (kept to
+    // reuse allocations)
+    std::unordered_map<const entt::registry*, SceneBVH> view_bvhs;
+    MultiViewFrame view_frame;
+
+    // Drawn for particle emitters without a particle_mesh, owned here so that it is
+    // released with the renderer rather than at static destruction
+    std::shared_ptr<mesh> default_particle_mesh;
+
     renderer() : render_api(nullptr) {};
     renderer(IRenderAPI* api) : render_api(api) {};
 
@@ -702,6 +721,363 @@ public:
         }
     }
 
+    // ========================================================================
+    // Particles
+    // ========================================================================
+
+    // Particle transforms are cheap; below this many a job costs more than it saves
+    static constexpr size_t PARTICLE_TRANSFORM_BATCH = 2048;
+    // Per-particle draws recorded for an emitter on backends without instancing
+    static constexpr uint32_t MAX_UNINSTANCED_PARTICLES = 1024;
+
+    // Uploads the meshes of every emitter that has live particles (main thread pre-pass)
+    void prepare_particles(entt::registry& registry)
+    {
+        auto view = registry.view<ParticleEmitterComponent>();
+        for (auto entity : view)
+        {
+            auto& emitter = view.get<ParticleEmitterComponent>(entity);
+            if (emitter.pool.count == 0 || emitter.lod == ParticleLod::Culled) continue;
+            mesh& m = emitter.particle_mesh ? *emitter.particle_mesh : particle_quad();
+            ensure_mesh_uploaded(m, render_api);
+        }
+    }
+
+    // Records the live particles of every visible emitter after the transparent meshes.
+    // Each emitter is one instanced draw when the backend supports it, in pool order, so
+    // ParticleSystem's back-to-front sort carries over to alpha-blended emitters.
+    void record_particles(entt::registry& registry, const glm::mat4& view_matrix,
+                          const Frustum* frustum, RenderCommandBuffer& cmds)
+    {
+        const glm::mat3 billboard_basis = glm::transpose(glm::mat3(view_matrix));
+        uint32_t instances_left = render_api->getInstanceCapacity();
+        const bool instanced = instances_left > 0;
+
+        auto view = registry.view<ParticleEmitterComponent>();
+        for (auto entity : view)
+        {
+            const auto& emitter = view.get<ParticleEmitterComponent>(entity);
+            const ParticlePool& pool = emitter.pool;
+            if (pool.count == 0 || emitter.lod == ParticleLod::Culled) continue;
+
+            const mesh& m = emitter.particle_mesh ? *emitter.particle_mesh : particle_quad();
+            if (!m.visible || !m.gpu_mesh || !m.gpu_mesh->isUploaded()) continue;
+
+            if (frustum)
+            {
+                const float pad = std::max(emitter.settings.size_start, emitter.settings.size_end);
+                AABB bounds(emitter.bounds_min - glm::vec3(pad), emitter.bounds_max + glm::vec3(pad));
+                if (!frustum->intersectsAABB(bounds)) continue;
+            }
+
+            PSOKey key;
+            key.blend = emitter.settings.blend;
+            key.cull = CullMode::None;
+            key.lighting = false;
+
+            const glm::mat3 basis = emitter.settings.billboard ? billboard_basis : glm::mat3(1.0f);
+            const bool use_texture = emitter.texture != INVALID_TEXTURE;
+
+            // Sorted pools run back to front, so dropping the head keeps the nearest particles
+            const uint32_t limit = instanced ? instances_left : MAX_UNINSTANCED_PARTICLES;
+            const uint32_t drawn = std::min(pool.count, limit);
+            const uint32_t first = pool.count - drawn;
+            if (drawn == 0) break;
+
+            if (instanced)
+            {
+                glm::mat4* transforms = cmds.recordDrawInstanced(m.gpu_mesh, drawn, emitter.texture,
+                                                                 use_texture, key, emitter.settings.color);
+                Threading::JobSystem::get().parallelFor("Particle transforms", drawn, PARTICLE_TRANSFORM_BATCH,
+                    [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i)
+                            transforms[i] = particle_transform(pool, first + static_cast<uint32_t>(i),
+                                                               basis, emitter.settings);
+                    });
+                instances_left -= drawn;
+            }
+            else
+            {
+                for (uint32_t i = first; i < pool.count; ++i)
+                    cmds.recordDraw(m.gpu_mesh, particle_transform(pool, i, basis, emitter.settings),
+                                    emitter.texture, use_texture, key, emitter.settings.color);
+            }
+        }
+    }
+
+    static glm::mat4 particle_transform(const ParticlePool& pool, uint32_t i, const glm::mat3& basis,
+                                        const ParticleEmitterSettings& settings)
+    {
+        const float t = pool.lifetime[i] > 0.0f ? std::min(pool.age[i] / pool.lifetime[i], 1.0f) : 1.0f;
+        const float size = settings.size_start + (settings.size_end - settings.size_start) * t;
+        glm::mat4 model(basis * size);
+        model[3] = glm::vec4(pool.position_x[i], pool.position_y[i], pool.position_z[i], 1.0f);
+        return model;
+    }
+
+    // Unit quad in XY facing +Z, drawn when an emitter has no particle_mesh
+    mesh& particle_quad()
+    {
+        static vertex vertices[6] = {
+            {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+            { 0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+            { 0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+            {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+            { 0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+            {-0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+        };
+        if (!default_particle_mesh)
+            default_particle_mesh = std::make_shared<mesh>(vertices, 6);
+        return *default_particle_mesh;
+    }
+
+    // ========================================================================
+    // Foliage
+    // ========================================================================
+
+    // Per-instance draws recorded for a view on backends without instancing, nearest cells first
+    static constexpr size_t MAX_UNINSTANCED_FOLIAGE = 4096;
+
+    // Scatters foliage whose layers changed and uploads the layer meshes (main thread pre-pass)
+    void prepare_foliage(entt::registry& registry)
+    {
+        auto view = registry.view<FoliageComponent>();
+        for (auto entity : view)
+        {
+            auto& foliage = view.get<FoliageComponent>(entity);
+            if (foliage.dirty)
+                FoliageSystem::scatterEntity(registry, entity);
+            for (FoliageLayer& layer : foliage.layers)
+            {
+                if (layer.foliage_mesh)
+                    ensure_mesh_uploaded(*layer.foliage_mesh, render_api);
+            }
+        }
+    }
+
+    // Culls the foliage cells of every FoliageComponent for a view and records each visible cell
+    // as one instanced opaque draw per material range, at the cell's LOD. Instances fade by
+    // shrinking over their layer's fade_distance. Foliage casts no shadows and skips the depth
+    // prepass; the main pass depth test is LESS_EQUAL, so that is safe.
+    FoliageStats record_foliage(entt::registry& registry, const glm::vec3& cam_pos, const glm::mat4& projection,
+                                const Frustum& frustum, bool global_lighting, RenderCommandBuffer& cmds)
+    {
+        struct CellDraw
+        {
+            const FoliageComponent* foliage = nullptr;
+            FoliageVisibleCell visible;
+            size_t count = 0;               // Instances to draw
+            size_t command = 0;             // Its instanced draw in cmds
+        };
+
+        FoliageStats stats;
+        std::vector<CellDraw> draws;
+        std::vector<FoliageVisibleCell> visible;
+        auto view = registry.view<FoliageComponent>();
+        for (auto entity : view)
+        {
+            const auto& foliage = view.get<FoliageComponent>(entity);
+            visible.clear();
+            FoliageSystem::cull(foliage.field, foliage.layers, frustum, cam_pos, projection, visible, stats);
+            for (const FoliageVisibleCell& cell : visible)
+                draws.push_back({&foliage, cell});
+        }
+        if (draws.empty())
+            return stats;
+        std::stable_sort(draws.begin(), draws.end(),
+            [](const CellDraw& a, const CellDraw& b) { return a.visible.distance < b.visible.distance; });
+
+        auto cellOf = [](const CellDraw& draw) -> const FoliageCell& {
+            return draw.foliage->field.cells[draw.visible.cell];
+        };
+        auto layerOf = [&](const CellDraw& draw) -> const FoliageLayer& {
+            return draw.foliage->layers[cellOf(draw).layer];
+        };
+
+        // Count what survives the per-instance cull distance in cells that straddle it
+        Threading::JobSystem& jobs = Threading::JobSystem::get();
+        jobs.parallelFor("Foliage count", draws.size(), 16,
+            [&](size_t begin, size_t end) {
+                for (size_t d = begin; d < end; ++d)
+                {
+                    CellDraw& draw = draws[d];
+                    const FoliageCell& cell = cellOf(draw);
+                    if (!draw.visible.fading)
+                    {
+                        draw.count = cell.instances.size();
+                        continue;
+                    }
+                    const FoliageLayer& layer = layerOf(draw);
+                    for (const FoliageInstance& instance : cell.instances)
+                        draw.count += FoliageSystem::withinCullDistance(instance, layer, cam_pos) ? 1 : 0;
+                }
+            });
+
+        std::vector<DrawCommand> materials;
+        size_t instances_left = render_api->getInstanceCapacity();
+        const bool instanced = instances_left > 0;
+        size_t uninstanced_left = MAX_UNINSTANCED_FOLIAGE;
+        glm::mat4 model;
+        for (CellDraw& draw : draws)
+        {
+            const FoliageLayer& layer = layerOf(draw);
+            const mesh& m = *layer.foliage_mesh;
+            foliage_materials(m, draw.visible.lod, global_lighting, materials);
+            draw.count = std::min(draw.count, instanced ? instances_left : uninstanced_left);
+            if (materials.empty() || draw.count == 0)
+            {
+                draw.count = 0;
+                continue;
+            }
+
+            if (instanced)
+            {
+                // Later draws may grow the transform buffer, so keep the command, not the pointer
+                cmds.recordInstanced(materials[0], draw.count);
+                draw.command = cmds.size() - 1;
+                const DrawCommand instances = cmds[draw.command];
+                for (size_t i = 1; i < materials.size(); ++i)
+                    cmds.recordInstancedShared(materials[i], instances);
+                instances_left -= draw.count;
+            }
+            else
+            {
+                // Nearest cells first until the cap, one draw per instance and material
+                size_t drawn = 0;
+                for (const FoliageInstance& instance : cellOf(draw).instances)
+                {
+                    if (drawn == draw.count)
+                        break;
+                    if (!FoliageSystem::instanceTransform(instance, layer, cam_pos, model))
+                        continue;
+                    for (const DrawCommand& material : materials)
+                    {
+                        cmds.recordDrawRangePBR(material.gpu_mesh, model, material.texture, material.use_texture,
+                                                material.pso_key, material.start_vertex, material.vertex_count,
+                                                material.color, material.alpha_cutoff, material.metallic,
+                                                material.roughness, material.emissive, INVALID_TEXTURE, false,
+                                                1.0f, 0.0f, glm::vec2(0.0f), material.material_flags);
+                    }
+                    ++drawn;
+                }
+                draw.count = drawn;
+                uninstanced_left -= drawn;
+            }
+            stats.drawn_instances += draw.count;
+            stats.draws += materials.size() * (instanced ? 1 : draw.count);
+        }
+
+        // Instance transforms, in parallel across cells
+        if (instanced)
+        {
+            jobs.parallelFor("Foliage transforms", draws.size(), 4,
+                [&](size_t begin, size_t end) {
+                    for (size_t d = begin; d < end; ++d)
+                    {
+                        const CellDraw& draw = draws[d];
+                        if (draw.count == 0)
+                            continue;  // No instanced command was recorded for this cell
+                        const FoliageLayer& layer = layerOf(draw);
+                        glm::mat4* transforms = cmds.instanceTransforms(cmds[draw.command]);
+                        size_t written = 0;
+                        for (const FoliageInstance& instance : cellOf(draw).instances)
+                        {
+                            if (written == draw.count)
+                                break;
+                            if (FoliageSystem::instanceTransform(instance, layer, cam_pos, transforms[written]))
+                                ++written;
+                        }
+                    }
+                });
+        }
+        return stats;
+    }
+
+    // The draw state of each material range of m at a LOD, as record_mesh_draw would record it
+    static void foliage_materials(const mesh& m, int lod, bool global_lighting, std::vector<DrawCommand>& out)
+    {
+        out.clear();
+        IGPUMesh* gpu_mesh = m.getGPUMeshForLOD(lod);
+        if (!gpu_mesh || !gpu_mesh->isUploaded())
+        {
+            gpu_mesh = m.gpu_mesh;
+            lod = 0;
+        }
+        if (!gpu_mesh || !gpu_mesh->isUploaded())
+            return;
+
+        const RenderState base_state = m.getRenderState();
+        const std::vector<MaterialRange>* ranges = m.getMaterialRangesForLOD(lod);
+        if (!ranges && lod == 0 && m.uses_material_ranges && !m.material_ranges.empty())
+            ranges = &m.material_ranges;
+
+        if (!ranges)
+        {
+            DrawCommand cmd;
+            cmd.gpu_mesh = gpu_mesh;
+            cmd.pso_key = PSOKey::fromRenderState(base_state, global_lighting);
+            cmd.use_texture = m.texture_set && m.texture != INVALID_TEXTURE;
+            cmd.texture = cmd.use_texture ? m.texture : INVALID_TEXTURE;
+            cmd.color = base_state.color;
+            out.push_back(cmd);
+            return;
+        }
+
+        for (const MaterialRange& range : *ranges)
+        {
+            if (range.vertex_count == 0)
+                continue;
+            RenderState range_state = base_state;
+            if (range.isAlphaMask()) {
+                range_state.alpha_test = true;
+                range_state.alpha_cutoff = range.alpha_cutoff;
+                range_state.blend_mode = BlendMode::None;
+                range_state.depth_write = true;
+            } else if (range.isAlphaBlend()) {
+                // Foliage is drawn with the opaques; blended ranges fall back to alpha test
+                range_state.alpha_test = true;
+                range_state.alpha_cutoff = 0.5f;
+                range_state.blend_mode = BlendMode::None;
+                range_state.depth_write = true;
+            }
+            if (range.double_sided)
+                range_state.cull_mode = CullMode::None;
+
+            DrawCommand cmd;
+            cmd.gpu_mesh = gpu_mesh;
+            cmd.pso_key = PSOKey::fromRenderState(range_state, global_lighting);
+            cmd.use_texture = range.hasValidTexture();
+            cmd.texture = cmd.use_texture ? range.texture : INVALID_TEXTURE;
+            cmd.color = glm::vec3(range.base_color_factor);
+            cmd.alpha_cutoff = range_state.alpha_cutoff;
+            cmd.metallic = range.metallic_factor;
+            cmd.roughness = range.roughness_factor;
+            cmd.emissive = range.emissive_factor;
+            cmd.material_flags = range.material_flags;
+            cmd.start_vertex = range.start_vertex;
+            cmd.vertex_count = range.vertex_count;
+            out.push_back(cmd);
+        }
+    }
+
+    // ========================================================================
+    // Decals
+    // ========================================================================
+
+    // Culls and bins the decals of a world for a view. Decals are drawn by the deferred path
+    // only; without it (or without a decal pool) the frame stays empty.
+    DecalStats build_decals(entt::registry& registry, const glm::mat4& view_proj, const Frustum& frustum,
+                            DecalFrame& frame)
+    {
+        DecalStats stats;
+        frame.clear();
+        if (!render_api->isDeferredActive())
+            return stats;
+        if (const DecalPool* pool = DecalSystem::findPool(registry))
+            DecalSystem::buildFrame(*pool, frustum, view_proj, frame, stats);
+        return stats;
+    }
+
     // ========================================================================
     // Parallel command recording (multicore rendering)
     // ========================================================================
@@ -908,6 +1284,41 @@ public:
         return merged;
     }
 
+    // Pre-select LOD for opaque entities (coherent between depth prepass and main pass)
+    static void select_opaque_lods(entt::registry& registry, const std::vector<entt::entity>& entities,
+                                   const glm::vec3& cam_pos, const glm::mat4& proj, std::vector<int>& lods)
+    {
+        lods.assign(entities.size(), 0);
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            auto* mesh_comp = registry.try_get<MeshComponent>(entities[i]);
+            auto* t = registry.try_get<TransformComponent>(entities[i]);
+            if (!mesh_comp || !t || !mesh_comp->m_mesh) continue;
+            mesh& m = *mesh_comp->m_mesh;
+
+            if (!m.lod_levels.empty() && m.bounds_computed)
+            {
+                if (m.force_lod >= 0)
+                {
+                    lods[i] = m.force_lod;
+                }
+                else
+                {
+                    int lod_count = m.getLODCount();
+                    std::vector<float> thresholds(lod_count, 0.0f);
+                    for (int j = 0; j < static_cast<int>(m.lod_levels.size()); ++j)
+                        thresholds[j + 1] = m.lod_levels[j].screen_threshold;
+
+                    lods[i] = LODSelector::selectLOD(
+                        cam_pos, t->position, m.aabb_min, m.aabb_max,
+                        proj, lod_count, thresholds.data(),
+                        t->scale
+                    );
+                }
+            }
+        }
+    }
+
     // Sort entities by texture handle (primary) and distance (secondary, front-to-back)
     void sort_entities_by_state(entt::registry& registry, std::vector<entt::entity>& entities,
                                 const glm::vec3& cam_pos)
@@ -1137,18 +1548,10 @@ public:
         FrameSync::get().setPhase(FramePhase::PreRender);
 
         // Sync renderer state from CVars
-        bvh_enabled = CVAR_BOOL(r_frustumculling);
-        depth_prepass_enabled = CVAR_BOOL(r_depthprepass);
+        sync_render_cvars();
         bool sky_enabled = CVAR_BOOL(r_sky);
         bool dynamic_lights_enabled = CVAR_BOOL(r_dynamiclights);
         bool global_lighting = CVAR_BOOL(r_lighting);
-        render_api->setFXAAEnabled(CVAR_BOOL(r_fxaa));
-        render_api->setSSAOEnabled(CVAR_BOOL(r_ssao));
-        render_api->setShadowQuality(CVAR_INT(r_shadowquality));
-        render_api->setShadowCascadeCount(CVAR_INT(r_shadowcascades));
-        render_api->setDeferredEnabled(CVAR_BOOL(r_deferred));
-        render_api->setVSyncEnabled(CVAR_BOOL(r_vsync));
-        render_api->enableLighting(global_lighting);
 
         last_draw_calls = 0;
 
@@ -1267,37 +1670,12 @@ public:
             // Ensure all visible meshes are uploaded before recording
             ensure_meshes_uploaded(registry, opaque_entities);
             ensure_meshes_uploaded(registry, transparent_entities);
+            prepare_particles(registry);
+            prepare_foliage(registry);
 
             // Pre-select LOD for opaque entities (coherent between depth prepass and main pass)
-            std::vector<int> opaque_lod(opaque_entities.size(), 0);
-            for (size_t i = 0; i < opaque_entities.size(); ++i)
-            {
-                auto* mesh_comp = registry.try_get<MeshComponent>(opaque_entities[i]);
-                auto* t = registry.try_get<TransformComponent>(opaque_entities[i]);
-                if (!mesh_comp || !t || !mesh_comp->m_mesh) continue;
-                mesh& m = *mesh_comp->m_mesh;
-
-                if (!m.lod_levels.empty() && m.bounds_computed)
-                {
-                    if (m.force_lod >= 0)
-                    {
-                        opaque_lod[i] = m.force_lod;
-                    }
-                    else
-                    {
-                        int lod_count = m.getLODCount();
-                        std::vector<float> thresholds(lod_count, 0.0f);
-                        for (int j = 0; j < static_cast<int>(m.lod_levels.size()); ++j)
-                            thresholds[j + 1] = m.lod_levels[j].screen_threshold;
-
-                        opaque_lod[i] = LODSelector::selectLOD(
-                            cam_pos, t->position, m.aabb_min, m.aabb_max,
-                            proj, lod_count, thresholds.data(),
-                            t->scale
-                        );
-                    }
-                }
-            }
+            std::vector<int> opaque_lod;
+            select_opaque_lods(registry, opaque_entities, cam_pos, proj, opaque_lod);
 
             // Depth prepass: parallel record, then replay
             if (depth_prepass_enabled && !opaque_entities.empty())
@@ -1314,9 +1692,16 @@ public:
             {
                 RenderCommandBuffer opaque_cmds = record_opaque_parallel(
                     registry, opaque_entities, opaque_lod, global_lighting, &camera_frustum);
+                last_foliage_stats = record_foliage(registry, cam_pos, proj, camera_frustum,
+                                                    global_lighting, opaque_cmds);
                 last_draw_calls += opaque_cmds.size();
                 if (render_api->isDeferredActive())
+                {
                     render_api->submitDeferredOpaqueCommands(opaque_cmds);
+                    DecalFrame decals;
+                    last_decal_stats = build_decals(registry, camera_view_proj, camera_frustum, decals);
+                    render_api->submitDeferredDecals(decals);
+                }
                 else
                     render_api->replayCommandBufferParallel(opaque_cmds);
             }
@@ -1339,6 +1724,7 @@ public:
                     }
                 }
 
+                record_particles(registry, render_api->getViewMatrix(), &camera_frustum, transparent_cmds);
                 last_draw_calls += transparent_cmds.size();
                 if (render_api->isDeferredActive())
                     render_api->submitDeferredTransparentCommands(transparent_cmds);
@@ -1369,6 +1755,10 @@ public:
                 }
             }
             last_visible_entities = last_total_entities;
+            prepare_foliage(registry);
+            last_foliage_stats = record_foliage(registry, cam_pos, proj, camera_frustum, global_lighting, all_cmds);
+            prepare_particles(registry);
+            record_particles(registry, render_api->getViewMatrix(), &camera_frustum, all_cmds);
             last_draw_calls = all_cmds.size();
             render_api->replayCommandBuffer(all_cmds);
         }
@@ -1404,18 +1794,10 @@ public:
         }
 
         // Sync renderer state from CVars
-        bvh_enabled = CVAR_BOOL(r_frustumculling);
-        depth_prepass_enabled = CVAR_BOOL(r_depthprepass);
+        sync_render_cvars();
         bool sky_enabled = CVAR_BOOL(r_sky);
         bool dynamic_lights_enabled = CVAR_BOOL(r_dynamiclights);
         bool global_lighting = CVAR_BOOL(r_lighting);
-        render_api->setFXAAEnabled(CVAR_BOOL(r_fxaa));
-        render_api->setSSAOEnabled(CVAR_BOOL(r_ssao));
-        render_api->setShadowQuality(CVAR_INT(r_shadowquality));
-        render_api->setShadowCascadeCount(CVAR_INT(r_shadowcascades));
-        render_api->setDeferredEnabled(CVAR_BOOL(r_deferred));
-        render_api->setVSyncEnabled(CVAR_BOOL(r_vsync));
-        render_api->enableLighting(global_lighting);
 
         last_draw_calls = 0;
 
@@ -1530,37 +1912,12 @@ public:
             // Ensure all visible meshes are uploaded
             ensure_meshes_uploaded(registry, opaque_entities);
             ensure_meshes_uploaded(registry, transparent_entities);
+            prepare_particles(registry);
+            prepare_foliage(registry);
 
             // Pre-select LOD for opaque entities
-            std::vector<int> opaque_lod(opaque_entities.size(), 0);
-            for (size_t i = 0; i < opaque_entities.size(); ++i)
-            {
-                auto* mesh_comp = registry.try_get<MeshComponent>(opaque_entities[i]);
-                auto* t = registry.try_get<TransformComponent>(opaque_entities[i]);
-                if (!mesh_comp || !t || !mesh_comp->m_mesh) continue;
-                mesh& m = *mesh_comp->m_mesh;
-
-                if (!m.lod_levels.empty() && m.bounds_computed)
-                {
-                    if (m.force_lod >= 0)
-                    {
-                        opaque_lod[i] = m.force_lod;
-                    }
-                    else
-                    {
-                        int lod_count = m.getLODCount();
-                        std::vector<float> thresholds(lod_count, 0.0f);
-                        for (int j = 0; j < static_cast<int>(m.lod_levels.size()); ++j)
-                            thresholds[j + 1] = m.lod_levels[j].screen_threshold;
-
-                        opaque_lod[i] = LODSelector::selectLOD(
-                            cam_pos, t->position, m.aabb_min, m.aabb_max,
-                            proj, lod_count, thresholds.data(),
-                            t->scale
-                        );
-                    }
-                }
-            }
+            std::vector<int> opaque_lod;
+            select_opaque_lods(registry, opaque_entities, cam_pos, proj, opaque_lod);
 
             // Depth prepass: parallel record, then replay
             if (depth_prepass_enabled && !opaque_entities.empty())
@@ -1577,9 +1934,16 @@ public:
             {
                 RenderCommandBuffer opaque_cmds = record_opaque_parallel(
                     registry, opaque_entities, opaque_lod, global_lighting, &camera_frustum);
+                last_foliage_stats = record_foliage(registry, cam_pos, proj, camera_frustum,
+                                                    global_lighting, opaque_cmds);
                 last_draw_calls += opaque_cmds.size();
                 if (render_api->isDeferredActive())
+                {
                     render_api->submitDeferredOpaqueCommands(opaque_cmds);
+                    DecalFrame decals;
+                    last_decal_stats = build_decals(registry, camera_view_proj, camera_frustum, decals);
+                    render_api->submitDeferredDecals(decals);
+                }
                 else
                     render_api->replayCommandBufferParallel(opaque_cmds);
             }
@@ -1601,6 +1965,7 @@ public:
                     }
                 }
 
+                record_particles(registry, render_api->getViewMatrix(), &camera_frustum, transparent_cmds);
                 last_draw_calls += transparent_cmds.size();
                 if (render_api->isDeferredActive())
                     render_api->submitDeferredTransparentCommands(transparent_cmds);
@@ -1629,6 +1994,10 @@ public:
                 }
             }
             last_visible_entities = last_total_entities;
+            prepare_foliage(registry);
+            last_foliage_stats = record_foliage(registry, cam_pos, proj, camera_frustum, global_lighting, all_cmds);
+            prepare_particles(registry);
+            record_particles(registry, render_api->getViewMatrix(), &camera_frustum, all_cmds);
             last_draw_calls = all_cmds.size();
             render_api->replayCommandBuffer(all_cmds);
         }
@@ -1647,6 +2016,298 @@ public:
         render_api->endSceneRender();
     };
 
+    // ========================================================================
+    // Multi-view rendering
+    // ========================================================================
+
+    // Render several viewports in one request. Views sharing a registry are
+    // culled in a single BVH traversal with per-view visibility masks, every
+    // view is recorded in parallel, and a view whose registry, light and camera
+    // match the previously submitted view reuses its shadow map. Each view ends
+    // with endSceneRender(), like render_scene_to_texture(). `primary_registry`
+    // is the scene whose edits mark scene_bvh dirty (the editor's world); it
+    // may be null or have no view, e.g. when only PIE viewports are visible.
+    void render_views(const std::vector<RenderView>& views, const entt::registry* primary_registry)
+    {
+        if (!render_api)
+        {
+            printf("Error: No render API set for renderer\n");
+            return;
+        }
+
+        for (size_t first = 0; first < views.size(); first += SceneBVH::MAX_QUERY_FRUSTA)
+        {
+            const size_t count = std::min(views.size() - first, SceneBVH::MAX_QUERY_FRUSTA);
+            std::vector<RenderView> batch(views.begin() + first, views.begin() + first + count);
+
+            if (!CVAR_BOOL(r_frustumculling))
+            {
+                // Without a BVH there is nothing to share; render views one at a time
+                for (const RenderView& view : batch)
+                {
+                    bind_view_target(view);
+                    render_api->setSceneRmlEnabled(view.scene_rml);
+                    render_scene_to_texture(*view.registry, *view.cam);
+                }
+                continue;
+            }
+
+            build_view_frame(batch, primary_registry, view_frame);
+            submit_view_frame(view_frame);
+        }
+    }
+
+    // Cull and record every view (no GPU submission). Public so the CPU side
+    // can be measured headlessly.
+    void build_view_frame(const std::vector<RenderView>& views, const entt::registry* primary_registry,
+                          MultiViewFrame& frame)
+    {
+        using clock = std::chrono::steady_clock;
+
+        FrameSync::get().setPhase(FramePhase::PreRender);
+        sync_render_cvars();
+
+        frame.primary_registry = primary_registry;
+        frame.stats = {};
+        frame.stats.views = views.size();
+        frame.work.resize(views.size());
+        frame.submit_order.clear();
+
+        // Camera matrices come from the API so they match what the GPU will use
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            RenderViewWork& work = frame.work[i];
+            work.view = &views[i];
+            work.opaque.clear();
+            work.transparent.clear();
+            work.depth_cmds.clear();
+            work.opaque_cmds.clear();
+            work.transparent_cmds.clear();
+
+            bind_view_target(views[i]);
+            render_api->setCamera(*views[i].cam);
+            work.projection = render_api->getProjectionMatrix();
+            work.view_matrix = render_api->getViewMatrix();
+            work.cam_pos = views[i].cam->getPosition();
+            work.frustum.extractFromViewProjection(work.projection * work.view_matrix);
+        }
+
+        // One culling pass per registry
+        const auto cull_start = clock::now();
+        for (auto it = view_bvhs.begin(); it != view_bvhs.end(); )
+        {
+            const bool in_use = it->first != primary_registry && std::any_of(views.begin(), views.end(),
+                [&](const RenderView& v) { return v.registry == it->first; });
+            it = in_use ? std::next(it) : view_bvhs.erase(it);
+        }
+
+        std::vector<bool> culled(views.size(), false);
+        std::vector<Frustum> frusta;
+        std::vector<size_t> members;
+        std::vector<SceneBVH::FrustumMaskHit> hits;
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            if (culled[i])
+                continue;
+
+            entt::registry& registry = *views[i].registry;
+            frusta.clear();
+            members.clear();
+            for (size_t j = i; j < views.size(); ++j)
+            {
+                if (views[j].registry != &registry)
+                    continue;
+                culled[j] = true;
+                frusta.push_back(frame.work[j].frustum);
+                members.push_back(j);
+            }
+
+            const bool primary = &registry == primary_registry;
+            SceneBVH& bvh = view_bvh(registry, primary);
+            if (!primary)
+                bvh.build(registry);
+            bvh.queryFrustumMask(frusta.data(), frusta.size(), hits);
+            frame.stats.cull_passes++;
+
+            // Upload and classify each visible entity once, then hand it to its views
+            for (const SceneBVH::FrustumMaskHit& hit : hits)
+            {
+                auto* mc = registry.try_get<MeshComponent>(hit.entity);
+                if (mc && mc->m_mesh)
+                {
+                    prepare_water_mesh(registry, hit.entity, *mc);
+                    ensure_mesh_uploaded(*mc->m_mesh, render_api);
+                }
+                const bool transparent = mc && mc->m_mesh && mc->m_mesh->transparent;
+
+                for (uint32_t bits = hit.mask; bits != 0; bits &= bits - 1)
+                {
+                    RenderViewWork& work = frame.work[members[std::countr_zero(bits)]];
+                    (transparent ? work.transparent : work.opaque).push_back(hit.entity);
+                }
+            }
+
+            prepare_particles(registry);
+            prepare_foliage(registry);
+
+            if (primary)
+                last_total_entities = bvh.getTotalEntities();
+        }
+        frame.stats.cull_ms = std::chrono::duration<double, std::milli>(clock::now() - cull_start).count();
+
+        // Sort, select LODs and record every view in parallel
+        const auto record_start = clock::now();
+        const bool global_lighting = CVAR_BOOL(r_lighting);
+        if (frame.work.size() == 1)
+        {
+            // A single view parallelizes over entity chunks instead
+            RenderViewWork& work = frame.work[0];
+            prepare_view_work(work);
+            if (depth_prepass_enabled && !work.opaque.empty())
+                work.depth_cmds = record_depth_parallel(*work.view->registry, work.opaque, work.opaque_lod, &work.frustum);
+            work.opaque_cmds = record_opaque_parallel(*work.view->registry, work.opaque, work.opaque_lod,
+                                                      global_lighting, &work.frustum);
+            work.foliage = record_foliage(*work.view->registry, work.cam_pos, work.projection, work.frustum,
+                                          global_lighting, work.opaque_cmds);
+            work.decal_stats = build_decals(*work.view->registry, work.projection * work.view_matrix,
+                                            work.frustum, work.decals);
+            record_view_transparents(work, global_lighting);
+        }
+        else
+        {
+            FrameSync::get().setPhase(FramePhase::ParallelRecord);
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(frame.work.size());
+            for (RenderViewWork& work : frame.work)
+            {
+                futures.push_back(std::async(std::launch::async,
+                    [this, &work, global_lighting]() {
+                        prepare_view_work(work);
+                        record_view_opaques(work, global_lighting);
+                        record_view_transparents(work, global_lighting);
+                    }));
+            }
+            for (auto& f : futures)
+                f.get();
+
+            FrameSync::get().setPhase(FramePhase::Replay);
+        }
+        frame.stats.record_ms = std::chrono::duration<double, std::milli>(clock::now() - record_start).count();
+
+        for (const RenderViewWork& work : frame.work)
+        {
+            frame.stats.visible_entities += work.opaque.size() + work.transparent.size();
+            frame.stats.draw_calls += work.opaque_cmds.size() + work.transparent_cmds.size();
+        }
+        last_visible_entities = frame.work[0].opaque.size() + frame.work[0].transparent.size();
+        last_draw_calls = frame.work[0].opaque_cmds.size() + frame.work[0].transparent_cmds.size();
+        last_foliage_stats = frame.work[0].foliage;
+        last_decal_stats = frame.work[0].decal_stats;
+
+        // Identical registry + camera + light produce identical cascades. Submit
+        // such views back to back so the later ones can skip their shadow pass.
+        for (size_t i = 0; i < frame.work.size(); ++i)
+        {
+            RenderViewWork& work = frame.work[i];
+            work.shadow_group = i;
+            for (size_t j = 0; j < i; ++j)
+            {
+                const RenderViewWork& other = frame.work[j];
+                if (other.shadow_group == j && other.view->registry == work.view->registry &&
+                    other.view_matrix == work.view_matrix && other.projection == work.projection)
+                {
+                    work.shadow_group = j;
+                    break;
+                }
+            }
+        }
+        frame.submit_order.resize(frame.work.size());
+        for (size_t i = 0; i < frame.submit_order.size(); ++i)
+            frame.submit_order[i] = i;
+        std::stable_sort(frame.submit_order.begin(), frame.submit_order.end(),
+            [&frame](size_t a, size_t b) { return frame.work[a].shadow_group < frame.work[b].shadow_group; });
+    }
+
+    // Replay recorded views to their targets
+    void submit_view_frame(MultiViewFrame& frame)
+    {
+        const bool sky_enabled = CVAR_BOOL(r_sky);
+        const bool dynamic_lights_enabled = CVAR_BOOL(r_dynamiclights);
+        const std::string api_name = render_api->getAPIName();
+
+        size_t last_shadow_group = SIZE_MAX;
+        for (size_t index : frame.submit_order)
+        {
+            RenderViewWork& work = frame.work[index];
+            const RenderView& view = *work.view;
+            entt::registry& registry = *view.registry;
+            camera& c = *view.cam;
+
+            bind_view_target(view);
+            render_api->setSceneRmlEnabled(view.scene_rml);
+
+            // 1. Shadow pass, unless the previous view rendered the same cascades
+            if (render_api->getShadowQuality() > 0)
+            {
+                if (work.shadow_group == last_shadow_group)
+                {
+                    frame.stats.shadow_passes_shared++;
+                }
+                else
+                {
+                    render_view_shadows(registry, c, view_bvh(registry, &registry == frame.primary_registry));
+                    last_shadow_group = work.shadow_group;
+                    frame.stats.shadow_passes++;
+                }
+            }
+
+            // 2. Main pass
+            render_api->beginFrame();
+            render_api->clear(glm::vec3(0.2f, 0.3f, 0.8f));
+            render_api->setCamera(c);
+            render_api->setLighting(ambient_light, diffuse_light, light_direction);
+            if (dynamic_lights_enabled)
+            {
+                gatherAndSetLights(registry, c);
+            }
+            else
+            {
+                LightCBuffer empty_lights{};
+                empty_lights.cameraPos = c.getPosition();
+                render_api->setPointAndSpotLights(empty_lights);
+            }
+
+            if (!work.depth_cmds.empty())
+            {
+                render_api->beginDepthPrepass();
+                render_api->replayCommandBuffer(work.depth_cmds);
+                render_api->endDepthPrepass();
+            }
+
+            if (render_api->isDeferredActive())
+            {
+                render_api->submitDeferredOpaqueCommands(work.opaque_cmds);
+                render_api->submitDeferredDecals(work.decals);
+                render_api->submitDeferredTransparentCommands(work.transparent_cmds);
+            }
+            else
+            {
+                render_api->replayCommandBufferParallel(work.opaque_cmds);
+                render_api->replayCommandBuffer(work.transparent_cmds);
+            }
+
+            if (sky_enabled)
+                render_api->renderSkybox();
+            DebugDraw::get().render(render_api, c);
+
+            if (api_name != "D3D12" && api_name != "Vulkan")
+                RmlUiManager::get().render();
+
+            render_api->endSceneRender();
+        }
+    }
+
     // Access the scene BVH (for ray picking, etc.)
     SceneBVH& getSceneBVH() { return scene_bvh; }
     const SceneBVH& getSceneBVH() const { return scene_bvh; }
@@ -1672,4 +2333,136 @@ public:
     size_t getTotalEntities() const { return last_total_entities; }
     size_t getVisibleEntities() const { return last_visible_entities; }
     size_t getDrawCalls() const { return last_draw_calls; }
+
+private:
+    // Applies the renderer CVars to this renderer and the render API
+    void sync_render_cvars()
+    {
+        bvh_enabled = CVAR_BOOL(r_frustumculling);
+        depth_prepass_enabled = CVAR_BOOL(r_depthprepass);
+        bool global_lighting = CVAR_BOOL(r_lighting);
+        render_api->setFXAAEnabled(CVAR_BOOL(r_fxaa));
+        render_api->setSSAOEnabled(CVAR_BOOL(r_ssao));
+        render_api->setShadowQuality(CVAR_INT(r_shadowquality));
+        render_api->setShadowCascadeCount(CVAR_INT(r_shadowcascades));
+        render_api->setDeferredEnabled(CVAR_BOOL(r_deferred));
+        render_api->setVSyncEnabled(CVAR_BOOL(r_vsync));
+        render_api->enableLighting(global_lighting);
+
+        DynamicResolutionSettings dynres;
+        dynres.enabled = CVAR_BOOL(r_dynres);
+        dynres.budget_ms = CVAR_FLOAT(r_dynres_budget_ms);
+        dynres.min_scale = CVAR_FLOAT(r_dynres_min_scale);
+        dynres.forced_scale = CVAR_FLOAT(r_dynres_scale);
+        render_api->setDynamicResolution(dynres);
+    }
+
+    void bind_view_target(const RenderView& view)
+    {
+        if (view.target)
+            render_api->setEditorViewport(view.target);
+        if (view.width > 0 && view.height > 0)
+            render_api->setViewportSize(view.width, view.height);
+    }
+
+    // scene_bvh follows the primary registry and its dirty flag. Other
+    // registries (PIE clients) have no dirty tracking; build_view_frame
+    // rebuilds their BVH once per request.
+    SceneBVH& view_bvh(entt::registry& registry, bool primary)
+    {
+        if (!primary)
+            return view_bvhs[&registry];
+        if (scene_bvh.needsRebuild())
+            scene_bvh.build(registry);
+        return scene_bvh;
+    }
+
+    void prepare_view_work(RenderViewWork& work)
+    {
+        entt::registry& registry = *work.view->registry;
+        const glm::vec3 cam_pos = work.cam_pos;
+
+        sort_entities_by_state(registry, work.opaque, cam_pos);
+        std::sort(work.transparent.begin(), work.transparent.end(),
+            [&registry, &cam_pos](entt::entity a, entt::entity b) {
+                auto* ta = registry.try_get<TransformComponent>(a);
+                auto* tb = registry.try_get<TransformComponent>(b);
+                if (!ta) return false;
+                if (!tb) return true;
+                return glm::dot(cam_pos - ta->position, cam_pos - ta->position) > glm::dot(cam_pos - tb->position, cam_pos - tb->position);
+            });
+        select_opaque_lods(registry, work.opaque, cam_pos, work.projection, work.opaque_lod);
+    }
+
+    // Serial recording for one view; used when views themselves run in parallel
+    void record_view_opaques(RenderViewWork& work, bool global_lighting)
+    {
+        entt::registry& registry = *work.view->registry;
+        work.depth_cmds.reserve(depth_prepass_enabled ? work.opaque.size() : 0);
+        work.opaque_cmds.reserve(work.opaque.size());
+        for (size_t i = 0; i < work.opaque.size(); ++i)
+        {
+            if (!registry.valid(work.opaque[i])) continue;
+            auto* mc = registry.try_get<MeshComponent>(work.opaque[i]);
+            auto* t = registry.try_get<TransformComponent>(work.opaque[i]);
+            if (!mc || !t || !mc->m_mesh || !mc->m_mesh->visible) continue;
+            if (depth_prepass_enabled)
+                record_depth_draw_at_lod(*mc->m_mesh, *t, work.depth_cmds, work.opaque_lod[i], &work.frustum);
+            record_mesh_at_lod(*mc->m_mesh, *t, work.opaque_cmds, global_lighting, work.opaque_lod[i], &work.frustum);
+        }
+        work.opaque_cmds.sort();
+        work.foliage = record_foliage(registry, work.cam_pos, work.projection, work.frustum,
+                                      global_lighting, work.opaque_cmds);
+        work.decal_stats = build_decals(registry, work.projection * work.view_matrix, work.frustum, work.decals);
+    }
+
+    void record_view_transparents(RenderViewWork& work, bool global_lighting)
+    {
+        entt::registry& registry = *work.view->registry;
+        work.transparent_cmds.reserve(work.transparent.size());
+        for (auto entity : work.transparent)
+        {
+            if (!registry.valid(entity)) continue;
+            auto* mc = registry.try_get<MeshComponent>(entity);
+            auto* t = registry.try_get<TransformComponent>(entity);
+            if (mc && t && mc->m_mesh && mc->m_mesh->visible)
+                record_mesh_with_lod(*mc->m_mesh, *t, work.transparent_cmds,
+                                     global_lighting, work.cam_pos, work.projection, &work.frustum);
+        }
+        record_particles(registry, work.view_matrix, &work.frustum, work.transparent_cmds);
+    }
+
+    // CSM shadow pass for one camera, casters culled per cascade
+    void render_view_shadows(entt::registry& registry, camera& c, SceneBVH& bvh)
+    {
+        render_api->beginShadowPass(light_direction, c);
+        const glm::mat4* cascade_matrices = render_api->getLightSpaceMatrices();
+
+        std::vector<entt::entity> shadow_entities;
+        for (int cascade = 0; cascade < render_api->getCascadeCount(); cascade++)
+        {
+            render_api->beginCascade(cascade);
+
+            Frustum shadow_frustum;
+            const Frustum* shadow_frustum_ptr = nullptr;
+            if (cascade_matrices)
+            {
+                shadow_frustum.extractFromViewProjection(cascade_matrices[cascade]);
+                shadow_frustum_ptr = &shadow_frustum;
+                bvh.queryFrustum(shadow_frustum, shadow_entities);
+            }
+            else
+            {
+                shadow_entities.clear();
+                auto view = registry.view<MeshComponent, TransformComponent>();
+                for (auto entity : view)
+                    shadow_entities.push_back(entity);
+            }
+
+            ensure_meshes_uploaded(registry, shadow_entities);
+            RenderCommandBuffer shadow_cmds = record_shadow_parallel(registry, shadow_entities, cascade, shadow_frustum_ptr);
+            render_api->replayCommandBuffer(shadow_cmds);
+        }
+        render_api->endShadowPass();
+    }
 };
@@ -324,6 +324,7 @@ static void copyColliderSettings(ColliderComponent& col, const LevelEntity& enti
     col.cylinder_radius = entity_data.collider_cylinder_radius;
     col.friction = entity_data.collider_friction;
     col.restitution = entity_data.collider_restitution;
+    col.collision_layer = entity_data.collider_layer;
 }
 
 static bool readVec3Json(const json& value, glm::vec3& out)
@@ -404,6 +405,7 @@ static void applyReflectedComponentsToLevelEntity(const json& components, LevelE
         entity.collider_cylinder_radius = c.value("cylinder_radius", entity.collider_cylinder_radius);
         entity.collider_friction = c.value("friction", entity.collider_friction);
         entity.collider_restitution = c.value("restitution", entity.collider_restitution);
+        entity.collider_layer = c.value("collision_layer", entity.collider_layer);
     }
 
     if (hasComponentJson(components, "ConstraintComponent"))
@@ -665,7 +667,8 @@ static void setupLevelTerrainComponent(entt::registry& registry,
     }
 }
 
-static PhysicsSystem::PhysicsBodyDesc makeBodyDesc(const LevelEntity& entity_data, const ColliderComponent& col, bool player_body = false)
+static PhysicsSystem::PhysicsBodyDesc makeBodyDesc(const LevelEntity& entity_data, const ColliderComponent& col,
+                                                   const PhysicsSystem& physics, bool player_body = false)
 {
     PhysicsSystem::PhysicsBodyDesc desc;
     desc.mass = entity_data.mass;
@@ -673,6 +676,13 @@ static PhysicsSystem::PhysicsBodyDesc makeBodyDesc(const LevelEntity& entity_dat
     desc.restitution = col.restitution;
     desc.apply_gravity = player_body ? false : entity_data.apply_gravity;
     desc.lock_rotation = true;
+    if (!col.collision_layer.empty())
+    {
+        desc.object_layer = physics.findLayer(col.collision_layer);
+        if (desc.object_layer == JPH::cObjectLayerInvalid)
+            LOG_ENGINE_WARN("Entity '{}': unknown collision layer '{}', using the default layer",
+                            entity_data.name, col.collision_layer);
+    }
     return desc;
 }
 
@@ -685,7 +695,7 @@ static bool createLevelPhysicsBody(world& game_world, entt::entity e, const Leve
 
     auto& col = game_world.registry.get<ColliderComponent>(e);
     auto& t = game_world.registry.get<TransformComponent>(e);
-    PhysicsSystem::PhysicsBodyDesc desc = makeBodyDesc(entity_data, col);
+    PhysicsSystem::PhysicsBodyDesc desc = makeBodyDesc(entity_data, col, game_world.getPhysicsSystem());
 
     if (entity_data.type == EntityType::Physical)
     {
@@ -1431,6 +1441,7 @@ bool LevelManager::parseEntityFromJSON(const void* json_ptr, LevelEntity& entity
         entity.collider_cylinder_radius = col.value("cylinder_radius", 0.5f);
         entity.collider_friction = col.value("friction", 0.2f);
         entity.collider_restitution = col.value("restitution", 0.0f);
+        entity.collider_layer = col.value("layer", std::string());
     }
 
     // Parse constraint
@@ -1668,6 +1679,8 @@ bool LevelManager::saveLevelToJSON(const std::string& json_path, const LevelData
 
             e["collider"]["friction"] = le.collider_friction;
             e["collider"]["restitution"] = le.collider_restitution;
+            if (!le.collider_layer.empty())
+                e["collider"]["layer"] = le.collider_layer;
         }
 
         if (le.has_constraint)
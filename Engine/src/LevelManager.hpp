@@ -72,6 +72,7 @@ struct LevelEntity
     float collider_cylinder_radius = 0.5f;
     float collider_friction = 0.2f;
     float collider_restitution = 0.0f;
+    std::string collider_layer;      // Empty uses the default layer for the motion type
 
     // Constraint data
     bool has_constraint = false;
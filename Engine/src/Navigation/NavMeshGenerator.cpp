@@ -1,6 +1,7 @@
 #include "NavMeshGenerator.hpp"
 #include "Components/Components.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <chrono>
 #include <cmath>
@@ -126,6 +127,7 @@ void NavMeshGenerator::extractDebugPolys(NavMesh& navmesh)
 NavMesh NavMeshGenerator::generate(entt::registry& registry, const NavMeshConfig& config,
                                     GenerationStats* stats)
 {
+    MemoryTagScope memory_tag(MemoryTag::Navigation);
     auto t0 = std::chrono::high_resolution_clock::now();
 
     NavMesh navmesh;
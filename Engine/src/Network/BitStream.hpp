@@ -65,6 +65,11 @@ public:
         writeBits(value, 32);
     }
 
+    // Write a 64-bit value
+    void writeUInt64(uint64_t value) {
+        writeBits(value, 64);
+    }
+
     // Write a full 32-bit float
     void writeFloat(float value) {
         uint32_t bits;
@@ -211,6 +216,11 @@ public:
         return static_cast<uint32_t>(readBits(32));
     }
 
+    // Read a 64-bit value
+    uint64_t readUInt64() {
+        return readBits(64);
+    }
+
     // Read a 32-bit float
     float readFloat() {
         uint32_t bits = readUInt32();
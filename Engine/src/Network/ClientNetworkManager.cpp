@@ -2,9 +2,13 @@
 #include "NetworkInput.hpp"
 #include "NetworkRuntime.hpp"
 #include "NetworkTransport.hpp"
+#include "ENetTransport.hpp"
+#include "LocalTransport.hpp"
+#include "MessageBundle.hpp"
 #include "world.hpp"
 #include "Components/Components.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "Console/ConVar.hpp"
 #include "Console/Console.hpp"
 #include <entt/entt.hpp>
@@ -42,53 +46,60 @@ bool ClientNetworkManager::initialize()
     return true;
 }
 
+namespace {
+
+bool isLoopbackAddress(const char* address)
+{
+    return address != nullptr &&
+           (std::strcmp(address, "127.0.0.1") == 0 ||
+            std::strcmp(address, "localhost") == 0 ||
+            std::strcmp(address, "::1") == 0);
+}
+
+} // namespace
+
 bool ClientNetworkManager::connectToServer(const char* address, uint16_t port, const char* name)
 {
-    if (client_host != nullptr) {
-        LOG_ENGINE_WARN("Client already initialized");
-        return false;
+    // A listen server in this process skips the socket round trip entirely
+    if (CVAR_BOOL(net_local_transport) && isLoopbackAddress(address) && LocalTransport::isListening(port)) {
+        return connectToServer(std::make_unique<LocalTransport>(), address, port, name);
     }
+    return connectToServer(std::make_unique<ENetTransport>(), address, port, name);
+}
 
-    // Store player name
-    player_name = name;
-
-    // Create client host with reliable, sequenced unreliable, and unordered unreliable channels.
-    client_host = enet_host_create(nullptr, 1, NETWORK_CHANNEL_COUNT, 0, 0);
-    if (client_host == nullptr) {
-        LOG_ENGINE_ERROR("Failed to create ENet client host");
+bool ClientNetworkManager::connectToServer(std::unique_ptr<INetworkTransport> client_transport,
+                                           const char* address,
+                                           uint16_t port,
+                                           const char* name)
+{
+    if (transport != nullptr) {
+        LOG_ENGINE_WARN("Client already initialized");
         return false;
     }
-
-    // Parse address
-    ENetAddress server_address = {};
-    if (enet_address_set_host(&server_address, address) != 0) {
-        LOG_ENGINE_ERROR("Failed to resolve server address: {0}", address);
-        enet_host_destroy(client_host);
-        client_host = nullptr;
+    if (client_transport == nullptr) {
         return false;
     }
-    server_address.port = port;
-    server_address.sin6_scope_id = 0;
+
+    // Store player name
+    player_name = name;
 
     // Connect to server
-    server_peer = enet_host_connect(client_host, &server_address, NETWORK_CHANNEL_COUNT, 0);
-    if (server_peer == nullptr) {
-        LOG_ENGINE_ERROR("Failed to create connection to server");
-        enet_host_destroy(client_host);
-        client_host = nullptr;
+    server_peer = client_transport->connect(address, port);
+    if (server_peer == INVALID_TRANSPORT_PEER) {
         return false;
     }
+    transport = std::move(client_transport);
 
     setConnectionState(ConnectionState::CONNECTING);
     connection_timeout = 0.0f;
 
-    LOG_ENGINE_INFO("Connecting to server {0}:{1}...", address, port);
+    LOG_ENGINE_INFO("Connecting to server {0}:{1} ({2} transport)...", address, port, transport->getName());
     return true;
 }
 
 void ClientNetworkManager::disconnect(const char* reason)
 {
-    if (server_peer != nullptr && connection_state != ConnectionState::DISCONNECTED) {
+    if (server_peer != INVALID_TRANSPORT_PEER && connection_state != ConnectionState::DISCONNECTED) {
         // Send disconnect message
         BitWriter writer;
         DisconnectMessage msg;
@@ -98,7 +109,7 @@ void ClientNetworkManager::disconnect(const char* reason)
         sendReliableMessage(writer);
 
         // Graceful disconnect
-        enet_peer_disconnect(server_peer, 0);
+        transport->disconnect(server_peer);
 
         LOG_ENGINE_INFO("Disconnecting from server: {0}", reason);
     }
@@ -113,15 +124,13 @@ void ClientNetworkManager::shutdown()
 
     disconnect("Client shutdown");
 
-    if (client_host != nullptr) {
+    if (transport != nullptr) {
         // Give time for disconnect message to send (bounded drain)
-        drainHostForShutdown(client_host, "Client");
-
-        enet_host_destroy(client_host);
-        client_host = nullptr;
+        transport->close("Client");
+        transport.reset();
     }
 
-    server_peer = nullptr;
+    server_peer = INVALID_TRANSPORT_PEER;
     network_id_to_entity.clear();
     client_id = 0;
     client_tick = 0;
@@ -129,6 +138,7 @@ void ClientNetworkManager::shutdown()
     pending_input_tick = 0;
     has_pending_input = false;
     recent_input_count = 0;
+    delayed_inputs.clear();
     local_player_entity = entt::null;
     local_player_network_id = 0;
 
@@ -141,10 +151,13 @@ void ClientNetworkManager::shutdown()
 
 void ClientNetworkManager::update(float delta_time)
 {
-    if (client_host == nullptr) {
+    MemoryTagScope memory_tag(MemoryTag::Network);
+    if (transport == nullptr) {
         return;
     }
 
+    fake_jitter_clock += delta_time;
+
     // Check connection timeout
     if (connection_state == ConnectionState::CONNECTING) {
         connection_timeout += delta_time;
@@ -156,32 +169,28 @@ void ClientNetworkManager::update(float delta_time)
     }
 
     // Process network events (bounded to prevent flood-induced stalls)
-    ENetEvent event;
+    TransportEvent event;
     NetworkEventBudget event_budget("Client");
-    while (enet_host_service(client_host, &event, 0) > 0) {
-        if (!event_budget.shouldProcess(event)) {
+    while (transport->poll(event)) {
+        if (!event_budget.shouldProcess()) {
             break;
         }
         switch (event.type) {
-            case ENET_EVENT_TYPE_CONNECT:
+            case TransportEventType::Connect:
                 handleServerConnect(event);
                 break;
 
-            case ENET_EVENT_TYPE_RECEIVE: {
-                size_t packet_size = event.packet->dataLength;
+            case TransportEventType::Receive:
                 handleServerMessage(event);
-                enet_packet_destroy(event.packet);
                 stats.packets_received++;
-                stats.bytes_received += packet_size;
+                stats.bytes_received += event.size;
                 break;
-            }
 
-            case ENET_EVENT_TYPE_DISCONNECT:
-            case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT:
+            case TransportEventType::Disconnect:
                 handleServerDisconnect(event);
                 break;
 
-            case ENET_EVENT_TYPE_NONE:
+            case TransportEventType::None:
                 break;
         }
     }
@@ -214,6 +223,10 @@ void ClientNetworkManager::update(float delta_time)
             msg.camera_pitch = last_sent_input.camera_pitch;
             msg.move_forward = last_sent_input.move_forward;
             msg.move_right = last_sent_input.move_right;
+            if (getPhysicsHashForServerTick(last_received_server_tick, msg.physics_hash)) {
+                msg.flags |= InputCommandFlags::PHYSICS_HASH;
+                msg.physics_hash_tick = last_received_server_tick;
+            }
 
             // Include up to 2 older inputs for redundancy, oldest first.
             uint8_t redundant_count = (recent_input_count > 1) ? static_cast<uint8_t>(recent_input_count - 1) : 0;
@@ -223,9 +236,10 @@ void ClientNetworkManager::update(float delta_time)
                 redundant_inputs[i] = recent_inputs[redundant_count - i];
             }
             NetworkSerializer::serialize(writer, msg, redundant_inputs, redundant_count);
-            sendUnreliableMessage(writer);
+            sendInputPacket(writer);
         }
     }
+    releaseDelayedInputs();
 
     // Ping/RTT measurement
     if (connection_state == ConnectionState::CONNECTED) {
@@ -237,7 +251,7 @@ void ClientNetworkManager::update(float delta_time)
     }
 
     // Flush all queued packets at end of update
-    enet_host_flush(client_host);
+    transport->flush();
     refreshStats(delta_time);
 }
 
@@ -248,7 +262,7 @@ void ClientNetworkManager::sendInputCommand(const InputState& input)
 
 void ClientNetworkManager::sendInputCommand(uint32_t command_tick, const InputState& input)
 {
-    if (!isConnected() || server_peer == nullptr) {
+    if (!isConnected() || server_peer == INVALID_TRANSPORT_PEER) {
         return;
     }
 
@@ -271,6 +285,34 @@ void ClientNetworkManager::sendInputCommand(uint32_t command_tick, const InputSt
     has_pending_input = true;
 }
 
+void ClientNetworkManager::sendInputPacket(const BitWriter& writer)
+{
+    const float jitter_ms = CVAR_FLOAT(net_fakejitter);
+    if (jitter_ms <= 0.0f && delayed_inputs.empty()) {
+        sendUnreliableMessage(writer);
+        return;
+    }
+
+    // Random hold-back, never earlier than the packet before it, so inputs arrive in bursts but in order
+    fake_jitter_seed = fake_jitter_seed * 1664525u + 1013904223u;
+    const double unit = static_cast<double>(fake_jitter_seed >> 8) / static_cast<double>(1u << 24);
+    double release_time = fake_jitter_clock + unit * (std::max)(jitter_ms, 0.0f) / 1000.0;
+    if (!delayed_inputs.empty()) {
+        release_time = (std::max)(release_time, delayed_inputs.back().release_time);
+    }
+    delayed_inputs.push_back({release_time, writer});
+}
+
+void ClientNetworkManager::releaseDelayedInputs()
+{
+    while (!delayed_inputs.empty() && delayed_inputs.front().release_time <= fake_jitter_clock) {
+        if (isConnected()) {
+            sendUnreliableMessage(delayed_inputs.front().writer);
+        }
+        delayed_inputs.pop_front();
+    }
+}
+
 uint32_t ClientNetworkManager::beginInputCommandTick()
 {
     if (!isConnected()) {
@@ -288,7 +330,7 @@ entt::entity ClientNetworkManager::getEntityByNetworkId(uint32_t net_id) const
     return entt::null;
 }
 
-void ClientNetworkManager::handleServerConnect(ENetEvent& event)
+void ClientNetworkManager::handleServerConnect(const TransportEvent& event)
 {
     LOG_ENGINE_INFO("Connected to server, sending connection request...");
 
@@ -304,14 +346,14 @@ void ClientNetworkManager::handleServerConnect(ENetEvent& event)
     sendReliableMessage(writer);
 
     // Flush immediately to ensure packet is transmitted
-    enet_host_flush(client_host);
+    transport->flush();
 }
 
-void ClientNetworkManager::handleServerDisconnect(ENetEvent& event)
+void ClientNetworkManager::handleServerDisconnect(const TransportEvent& event)
 {
     LOG_ENGINE_INFO("Disconnected from server");
     setConnectionState(ConnectionState::DISCONNECTED);
-    server_peer = nullptr;
+    server_peer = INVALID_TRANSPORT_PEER;
 
     // Clear all networked entities
     if (game_world != nullptr) {
@@ -331,22 +373,25 @@ void ClientNetworkManager::handleServerDisconnect(ENetEvent& event)
     }
 }
 
-void ClientNetworkManager::handleServerMessage(ENetEvent& event)
+void ClientNetworkManager::handleServerMessage(const TransportEvent& event)
 {
-    if (event.packet == nullptr ||
-        event.packet->data == nullptr ||
-        event.packet->dataLength == 0 ||
-        event.packet->dataLength > NETWORK_MAX_PACKET_BYTES) {
-        const size_t packet_size = event.packet ? event.packet->dataLength : 0;
-        LOG_ENGINE_WARN("Dropping invalid server packet ({} bytes)", packet_size);
-        recordDroppedIncomingPacket(stats, packet_size);
+    if (event.data == nullptr ||
+        event.size == 0 ||
+        event.size > NETWORK_MAX_PACKET_BYTES) {
+        LOG_ENGINE_WARN("Dropping invalid server packet ({} bytes)", event.size);
+        recordDroppedIncomingPacket(stats, event.size);
         return;
     }
 
+    dispatchServerMessage(event.data, event.size, true);
+}
+
+void ClientNetworkManager::dispatchServerMessage(const uint8_t* data, size_t size, bool allow_bundle)
+{
     uint8_t msg_type = 0;
-    if (!NetworkSerializer::tryGetMessageType(event.packet->data, event.packet->dataLength, msg_type)) {
+    if (!NetworkSerializer::tryGetMessageType(data, size, msg_type)) {
         LOG_ENGINE_WARN("Dropping server packet without message type");
-        recordDroppedIncomingPacket(stats, event.packet->dataLength);
+        recordDroppedIncomingPacket(stats, size);
         return;
     }
 
@@ -354,11 +399,22 @@ void ClientNetworkManager::handleServerMessage(ENetEvent& event)
         LOG_ENGINE_WARN("Dropping server message type {} while client is in state {}",
                         static_cast<int>(msg_type),
                         static_cast<int>(connection_state));
-        recordDroppedIncomingPacket(stats, event.packet->dataLength);
+        recordDroppedIncomingPacket(stats, size);
         return;
     }
 
-    BitReader reader(event.packet->data, event.packet->dataLength);
+    if (static_cast<MessageType>(msg_type) == MessageType::MESSAGE_BUNDLE) {
+        const bool valid = allow_bundle && forEachBundledMessage(data, size, [this](const uint8_t* message, size_t message_size) {
+            dispatchServerMessage(message, message_size, false);
+        });
+        if (!valid) {
+            LOG_ENGINE_WARN("Dropping malformed or nested message bundle ({} bytes)", size);
+            recordDroppedIncomingPacket(stats, size);
+        }
+        return;
+    }
+
+    BitReader reader(data, size);
 
     switch (static_cast<MessageType>(msg_type)) {
         case MessageType::CONNECT_ACCEPT:
@@ -418,6 +474,8 @@ void ClientNetworkManager::handleConnectAccept(BitReader& reader)
     client_id = msg.client_id;
     client_tick = 0;
     last_received_server_tick = msg.server_tick;
+    physics_tick_offset = game_world != nullptr ? msg.server_tick - game_world->getSimulationTick() : 0;
+    physics_desync.reset();
 
     setConnectionState(ConnectionState::CONNECTED);
     LOG_ENGINE_INFO("Connection accepted! Client ID: {0}, Server Tick: {1}", client_id, msg.server_tick);
@@ -429,9 +487,9 @@ void ClientNetworkManager::handleConnectReject(BitReader& reader)
     if (!NetworkSerializer::deserialize(reader, msg)) {
         LOG_ENGINE_WARN("Failed to deserialize CONNECT_REJECT message");
         setConnectionState(ConnectionState::DISCONNECTED);
-        if (server_peer != nullptr) {
-            enet_peer_disconnect(server_peer, 0);
-            server_peer = nullptr;
+        if (server_peer != INVALID_TRANSPORT_PEER) {
+            transport->disconnect(server_peer);
+            server_peer = INVALID_TRANSPORT_PEER;
         }
         return;
     }
@@ -440,9 +498,9 @@ void ClientNetworkManager::handleConnectReject(BitReader& reader)
     setConnectionState(ConnectionState::DISCONNECTED);
 
     // Disconnect
-    if (server_peer != nullptr) {
-        enet_peer_disconnect(server_peer, 0);
-        server_peer = nullptr;
+    if (server_peer != INVALID_TRANSPORT_PEER) {
+        transport->disconnect(server_peer);
+        server_peer = INVALID_TRANSPORT_PEER;
     }
 }
 
@@ -470,6 +528,7 @@ void ClientNetworkManager::handleWorldStateUpdate(BitReader& reader)
 
     // Update last received server tick
     last_received_server_tick = msg.server_tick;
+    comparePhysicsHash(msg);
 
     std::unordered_set<uint32_t> full_snapshot_entities;
     if (msg.isFullSnapshot()) {
@@ -530,6 +589,40 @@ void ClientNetworkManager::handleWorldStateUpdate(BitReader& reader)
     }
 }
 
+bool ClientNetworkManager::getPhysicsHashForServerTick(uint32_t server_tick, uint64_t& out_hash) const
+{
+    if (game_world == nullptr || server_tick == 0) {
+        return false;
+    }
+    const PhysicsSystem& physics = game_world->getPhysicsSystem();
+    return physics.getDeterminismChecks() && physics.getStateHash(server_tick - physics_tick_offset, out_hash);
+}
+
+void ClientNetworkManager::comparePhysicsHash(const WorldStateUpdateMessage& msg)
+{
+    // Hash the local simulation only while the server is sending its own hashes.
+    // setDeterminismChecks ignores repeats, so the recorded hashes survive every snapshot.
+    PhysicsSystem& physics = game_world->getPhysicsSystem();
+    physics.setDeterminismChecks(msg.hasPhysicsHash());
+
+    uint64_t client_hash = 0;
+    if (!msg.hasPhysicsHash() || !getPhysicsHashForServerTick(msg.server_tick, client_hash)) {
+        return;
+    }
+
+    const bool already_captured = physics_desync.hasDesync();
+    if (physics_desync.compare(msg.server_tick, client_hash, msg.physics_hash) || already_captured) {
+        return;
+    }
+
+    const PhysicsDesyncReport& report = physics_desync.getReport();
+    LOG_ENGINE_ERROR("Physics desync at server tick {0} (last match {1}): client {2:016x}, server {3:016x}",
+                     report.tick, report.last_matching_tick, report.local_hash, report.remote_hash);
+    if (on_physics_desync) {
+        on_physics_desync(report);
+    }
+}
+
 void ClientNetworkManager::handleSpawnPlayer(BitReader& reader)
 {
     if (game_world == nullptr) {
@@ -643,7 +736,7 @@ void ClientNetworkManager::handlePong(BitReader& reader)
 
 void ClientNetworkManager::sendPing()
 {
-    if (server_peer == nullptr) {
+    if (server_peer == INVALID_TRANSPORT_PEER) {
         return;
     }
 
@@ -786,7 +879,7 @@ void ClientNetworkManager::deleteEntity(uint32_t network_id)
 
 bool ClientNetworkManager::sendReliableMessage(const BitWriter& writer)
 {
-    PacketSendResult result = sendPacketToPeer(server_peer, writer, PacketReliability::Reliable);
+    PacketSendResult result = sendPacketToPeer(transport.get(), server_peer, writer, PacketReliability::Reliable);
     if (!packetSendSucceeded(result)) {
         recordDroppedOutgoingPacket(stats, writer.getByteSize());
         return false;
@@ -798,7 +891,7 @@ bool ClientNetworkManager::sendReliableMessage(const BitWriter& writer)
 
 bool ClientNetworkManager::sendUnreliableMessage(const BitWriter& writer, PacketReliability reliability)
 {
-    PacketSendResult result = sendPacketToPeer(server_peer, writer, reliability);
+    PacketSendResult result = sendPacketToPeer(transport.get(), server_peer, writer, reliability);
     if (!packetSendSucceeded(result)) {
         recordDroppedOutgoingPacket(stats, writer.getByteSize());
         return false;
@@ -833,6 +926,7 @@ bool ClientNetworkManager::shouldAcceptServerMessage(uint8_t message_type) const
         case MessageType::SPAWN_PLAYER:
         case MessageType::DESPAWN_PLAYER:
         case MessageType::WORLD_STATE_UPDATE:
+        case MessageType::MESSAGE_BUNDLE:
         case MessageType::PONG:
         case MessageType::CVAR_SYNC:
         case MessageType::CVAR_INITIAL_SYNC:
@@ -854,7 +948,9 @@ void ClientNetworkManager::setConnectionState(ConnectionState new_state)
 
 void ClientNetworkManager::refreshStats(float delta_time)
 {
-    updateStatsFromPeer(stats, server_peer, client_host);
+    TransportPeerStats peer_stats;
+    const bool has_peer_stats = transport != nullptr && transport->getPeerStats(server_peer, peer_stats);
+    updateStatsFromTransport(stats, has_peer_stats ? &peer_stats : nullptr);
     stats_sampler.update(stats, delta_time);
 }
 
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <utility>
 #include "EngineExport.h"
-#include "enet.h"
 #include "NetworkProtocol.hpp"
 #include "NetworkTypes.hpp"
 #include "BitStream.hpp"
@@ -15,6 +16,7 @@
 #include "SharedMovement.hpp"
 #include "PredictionTypes.hpp"
 #include "InterpolationBuffer.hpp"
+#include "Physics/PhysicsDeterminism.hpp"
 #include <entt/entt.hpp>
 
 // Forward declarations
@@ -23,6 +25,7 @@ class world;
 namespace Net {
 
 using ClientCustomMessageHandler = std::function<void(uint8_t message_type, BitReader& reader)>;
+using ClientPhysicsDesyncHandler = std::function<void(const PhysicsDesyncReport& report)>;
 
 // Connection state
 enum class ConnectionState : uint8_t
@@ -48,8 +51,8 @@ class ENGINE_API ClientNetworkManager
 private:
     bool m_shutdown = false;
     bool runtime_acquired = false;
-    ENetHost* client_host = nullptr;
-    ENetPeer* server_peer = nullptr;
+    std::unique_ptr<INetworkTransport> transport;
+    TransportPeerId server_peer = INVALID_TRANSPORT_PEER;
     world* game_world = nullptr;
 
     // Client state
@@ -75,6 +78,16 @@ private:
     uint32_t pending_input_tick = 0;
     bool has_pending_input = false;
 
+    // net_fakejitter: input packets held back by a random delay, released in order
+    struct DelayedInputPacket
+    {
+        double release_time = 0.0;
+        BitWriter writer;
+    };
+    std::deque<DelayedInputPacket> delayed_inputs;
+    double fake_jitter_clock = 0.0;
+    uint32_t fake_jitter_seed = 0x9e3779b9u;
+
     // Ping/RTT measurement
     float ping_timer = 0.0f;
     static constexpr float PING_INTERVAL = 1.0f;  // Send ping every 1 second
@@ -99,6 +112,12 @@ private:
     std::unordered_map<uint32_t, EntityInterpolationBuffer> interp_buffers;
     static constexpr float INTERP_DELAY_TICKS = static_cast<float>(DEFAULT_INTERP_DELAY_TICKS);
 
+    // Physics determinism checks, enabled while the server sends state hashes (sv_physics_hash).
+    // Local world tick = server tick - physics_tick_offset, fixed on connect.
+    PhysicsDesyncDetector physics_desync;
+    ClientPhysicsDesyncHandler on_physics_desync;
+    uint32_t physics_tick_offset = 0;
+
     // Network stats
     NetworkStats stats;
     NetworkStatsRateSampler stats_sampler;
@@ -109,7 +128,13 @@ public:
 
     // Initialization
     bool initialize();
+    // Uses LocalTransport when address is loopback and a server in this process listens on
+    // port (net_local_transport 1), ENet otherwise
     bool connectToServer(const char* address, uint16_t port, const char* player_name);
+    bool connectToServer(std::unique_ptr<INetworkTransport> client_transport,
+                         const char* address,
+                         uint16_t port,
+                         const char* player_name);
     void disconnect(const char* reason = "Client disconnect");
     void shutdown();
 
@@ -145,6 +170,8 @@ public:
 
     // Stats
     const NetworkStats& getStats() const { return stats; }
+    const INetworkTransport* getTransport() const { return transport.get(); }
+    const PhysicsDesyncReport& getPhysicsDesyncReport() const { return physics_desync.getReport(); }
 
     void sendCustomReliable(const BitWriter& writer);
     void sendCustomUnreliable(const BitWriter& writer);
@@ -156,12 +183,16 @@ public:
     void setCustomMessageHandler(ClientCustomMessageHandler callback) {
         on_custom_message = std::move(callback);
     }
+    void setPhysicsDesyncHandler(ClientPhysicsDesyncHandler callback) {
+        on_physics_desync = std::move(callback);
+    }
 
 private:
     // Event handlers
-    void handleServerConnect(ENetEvent& event);
-    void handleServerDisconnect(ENetEvent& event);
-    void handleServerMessage(ENetEvent& event);
+    void handleServerConnect(const TransportEvent& event);
+    void handleServerDisconnect(const TransportEvent& event);
+    void handleServerMessage(const TransportEvent& event);
+    void dispatchServerMessage(const uint8_t* data, size_t size, bool allow_bundle);
 
     // Message handlers
     void handleConnectAccept(BitReader& reader);
@@ -176,6 +207,10 @@ private:
     // Ping/RTT
     void sendPing();
 
+    // Physics determinism checks
+    bool getPhysicsHashForServerTick(uint32_t server_tick, uint64_t& out_hash) const;
+    void comparePhysicsHash(const WorldStateUpdateMessage& msg);
+
     // Entity management
     void createOrUpdateEntity(const EntityUpdateData& update);
     void pushInterpolationSnapshot(uint32_t network_id, uint32_t server_tick);
@@ -185,6 +220,8 @@ private:
     bool sendReliableMessage(const BitWriter& writer);
     bool sendUnreliableMessage(const BitWriter& writer,
                                PacketReliability reliability = PacketReliability::UnreliableSequenced);
+    void sendInputPacket(const BitWriter& writer);
+    void releaseDelayedInputs();
     bool shouldAcceptServerMessage(uint8_t message_type) const;
     void setConnectionState(ConnectionState new_state);
     void refreshStats(float delta_time);
@@ -0,0 +1,186 @@
+#include "CompositeTransport.hpp"
+#include "Utils/Log.hpp"
+
+namespace Net {
+
+namespace {
+    constexpr uint32_t COMPOSITE_INDEX_SHIFT = 24;
+    constexpr TransportPeerId COMPOSITE_CHILD_MASK = (1u << COMPOSITE_INDEX_SHIFT) - 1u;
+    constexpr std::size_t COMPOSITE_MAX_TRANSPORTS = 255;
+
+    TransportPeerId makeCompositePeer(std::size_t index, TransportPeerId child_peer)
+    {
+        if (child_peer == INVALID_TRANSPORT_PEER || child_peer > COMPOSITE_CHILD_MASK) {
+            return INVALID_TRANSPORT_PEER;
+        }
+        return (static_cast<TransportPeerId>(index) << COMPOSITE_INDEX_SHIFT) | child_peer;
+    }
+}
+
+void CompositeTransport::addTransport(std::unique_ptr<INetworkTransport> transport)
+{
+    if (transport == nullptr || transports.size() >= COMPOSITE_MAX_TRANSPORTS) {
+        LOG_ENGINE_WARN("CompositeTransport cannot take another transport");
+        return;
+    }
+    transports.push_back(std::move(transport));
+}
+
+INetworkTransport* CompositeTransport::getTransport(std::size_t index) const
+{
+    return index < transports.size() ? transports[index].get() : nullptr;
+}
+
+bool CompositeTransport::listen(uint16_t port, uint32_t max_peers)
+{
+    if (transports.empty()) {
+        LOG_ENGINE_ERROR("CompositeTransport has no transports to listen on");
+        return false;
+    }
+
+    for (std::size_t i = 0; i < transports.size(); ++i) {
+        if (!transports[i]->listen(port, max_peers)) {
+            LOG_ENGINE_ERROR("Failed to listen on {0} transport (port {1})", transports[i]->getName(), port);
+            for (std::size_t j = 0; j < i; ++j) {
+                transports[j]->close("CompositeTransport");
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+TransportPeerId CompositeTransport::connect(const char* address, uint16_t port)
+{
+    (void)address;
+    (void)port;
+    LOG_ENGINE_ERROR("CompositeTransport only listens; connect through one transport instead");
+    return INVALID_TRANSPORT_PEER;
+}
+
+void CompositeTransport::close(const char* owner_name)
+{
+    for (auto& transport : transports) {
+        transport->close(owner_name);
+    }
+}
+
+bool CompositeTransport::isOpen() const
+{
+    for (const auto& transport : transports) {
+        if (transport->isOpen()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CompositeTransport::poll(TransportEvent& out_event)
+{
+    const std::size_t count = transports.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t index = (next_poll_index + i) % count;
+        if (transports[index]->poll(out_event)) {
+            out_event.peer = makeCompositePeer(index, out_event.peer);
+            next_poll_index = (index + 1) % count;
+            return true;
+        }
+    }
+    out_event = TransportEvent{};
+    return false;
+}
+
+PacketSendResult CompositeTransport::send(TransportPeerId peer,
+                                          const uint8_t* data,
+                                          std::size_t size,
+                                          PacketReliability reliability)
+{
+    TransportPeerId child_peer = INVALID_TRANSPORT_PEER;
+    INetworkTransport* transport = findTransport(peer, child_peer);
+    return transport != nullptr
+        ? transport->send(child_peer, data, size, reliability)
+        : PacketSendResult::InvalidPeer;
+}
+
+void CompositeTransport::sendToPeers(const TransportPeerId* peers,
+                                     std::size_t peer_count,
+                                     const uint8_t* data,
+                                     std::size_t size,
+                                     PacketReliability reliability,
+                                     PacketSendResult* out_results)
+{
+    for (std::size_t i = 0; i < peer_count; ++i) {
+        out_results[i] = PacketSendResult::InvalidPeer;
+    }
+
+    // One child call per transport keeps each child's packet sharing
+    for (std::size_t index = 0; index < transports.size(); ++index) {
+        child_peers.clear();
+        child_slots.clear();
+        for (std::size_t i = 0; i < peer_count; ++i) {
+            if ((peers[i] >> COMPOSITE_INDEX_SHIFT) == index) {
+                child_peers.push_back(peers[i] & COMPOSITE_CHILD_MASK);
+                child_slots.push_back(i);
+            }
+        }
+        if (child_peers.empty()) {
+            continue;
+        }
+
+        child_results.resize(child_peers.size());
+        transports[index]->sendToPeers(child_peers.data(), child_peers.size(), data, size, reliability,
+                                       child_results.data());
+        for (std::size_t i = 0; i < child_slots.size(); ++i) {
+            out_results[child_slots[i]] = child_results[i];
+        }
+    }
+}
+
+void CompositeTransport::flush()
+{
+    for (auto& transport : transports) {
+        transport->flush();
+    }
+}
+
+void CompositeTransport::disconnect(TransportPeerId peer)
+{
+    TransportPeerId child_peer = INVALID_TRANSPORT_PEER;
+    if (INetworkTransport* transport = findTransport(peer, child_peer)) {
+        transport->disconnect(child_peer);
+    }
+}
+
+void CompositeTransport::disconnectLater(TransportPeerId peer)
+{
+    TransportPeerId child_peer = INVALID_TRANSPORT_PEER;
+    if (INetworkTransport* transport = findTransport(peer, child_peer)) {
+        transport->disconnectLater(child_peer);
+    }
+}
+
+bool CompositeTransport::isPeerConnected(TransportPeerId peer) const
+{
+    TransportPeerId child_peer = INVALID_TRANSPORT_PEER;
+    const INetworkTransport* transport = findTransport(peer, child_peer);
+    return transport != nullptr && transport->isPeerConnected(child_peer);
+}
+
+bool CompositeTransport::getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const
+{
+    TransportPeerId child_peer = INVALID_TRANSPORT_PEER;
+    const INetworkTransport* transport = findTransport(peer, child_peer);
+    return transport != nullptr && transport->getPeerStats(child_peer, out_stats);
+}
+
+INetworkTransport* CompositeTransport::findTransport(TransportPeerId peer, TransportPeerId& out_child_peer) const
+{
+    const std::size_t index = peer >> COMPOSITE_INDEX_SHIFT;
+    out_child_peer = peer & COMPOSITE_CHILD_MASK;
+    if (out_child_peer == INVALID_TRANSPORT_PEER || index >= transports.size()) {
+        return nullptr;
+    }
+    return transports[index].get();
+}
+
+} // namespace Net
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "NetworkTransport.hpp"
+#include "EngineExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Net {
+
+// Listens on several transports at once, so a listen server can take remote clients over
+// ENet and in-process clients over LocalTransport. The top byte of a peer handle selects
+// the child transport; children must issue handles below 2^24.
+class ENGINE_API CompositeTransport final : public INetworkTransport
+{
+public:
+    CompositeTransport() = default;
+    ~CompositeTransport() override = default;
+
+    CompositeTransport(const CompositeTransport&) = delete;
+    CompositeTransport& operator=(const CompositeTransport&) = delete;
+
+    // Children are added before listen(); up to 255
+    void addTransport(std::unique_ptr<INetworkTransport> transport);
+    std::size_t getTransportCount() const { return transports.size(); }
+    INetworkTransport* getTransport(std::size_t index) const;
+
+    const char* getName() const override { return "composite"; }
+
+    bool listen(uint16_t port, uint32_t max_peers) override;
+    TransportPeerId connect(const char* address, uint16_t port) override;
+    void close(const char* owner_name) override;
+    bool isOpen() const override;
+
+    bool poll(TransportEvent& out_event) override;
+    PacketSendResult send(TransportPeerId peer,
+                          const uint8_t* data,
+                          std::size_t size,
+                          PacketReliability reliability) override;
+    void sendToPeers(const TransportPeerId* peers,
+                     std::size_t peer_count,
+                     const uint8_t* data,
+                     std::size_t size,
+                     PacketReliability reliability,
+                     PacketSendResult* out_results) override;
+    void flush() override;
+
+    void disconnect(TransportPeerId peer) override;
+    void disconnectLater(TransportPeerId peer) override;
+    bool isPeerConnected(TransportPeerId peer) const override;
+    bool getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const override;
+
+private:
+    INetworkTransport* findTransport(TransportPeerId peer, TransportPeerId& out_child_peer) const;
+
+    std::vector<std::unique_ptr<INetworkTransport>> transports;
+    std::size_t next_poll_index = 0;  // Round-robin so one busy transport cannot starve the rest
+    std::vector<TransportPeerId> child_peers;  // sendToPeers scratch
+    std::vector<PacketSendResult> child_results;
+    std::vector<std::size_t> child_slots;
+};
+
+} // namespace Net
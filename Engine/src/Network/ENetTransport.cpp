@@ -0,0 +1,416 @@
+#include "ENetTransport.hpp"
+#include "NetworkRuntime.hpp"
+#include "Utils/Log.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+#endif
+
+namespace Net {
+
+namespace {
+    float enetPacketLossToPercent(uint32_t packet_loss)
+    {
+        return static_cast<float>(packet_loss) * 100.0f / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
+    }
+
+    bool isPeerConnectedForApplicationSend(const ENetPeer* peer)
+    {
+        return peer != nullptr &&
+            (peer->state == ENET_PEER_STATE_CONNECTED ||
+             peer->state == ENET_PEER_STATE_DISCONNECT_LATER ||
+             peer->state == ENET_PEER_STATE_DISCONNECTING);
+    }
+
+    PacketSendResult validateSend(const ENetPeer* peer, std::size_t byte_size, PacketReliability reliability)
+    {
+        if (!isPeerConnectedForApplicationSend(peer)) {
+            return PacketSendResult::InvalidPeer;
+        }
+
+        const PacketSendResult result = validatePacketPayload(byte_size, reliability);
+        if (result != PacketSendResult::Sent) {
+            return result;
+        }
+
+        return validateSendQueue(static_cast<uint32_t>(peer->outgoingDataTotal), reliability);
+    }
+
+    bool queuePacketOnPeer(ENetPeer* peer, ENetPacket* packet, PacketReliability reliability)
+    {
+        const uint8_t channel = static_cast<uint8_t>(getPacketChannel(reliability));
+        if (enet_peer_send(peer, channel, packet) < 0) {
+            LOG_ENGINE_WARN("enet_peer_send failed for {0} message", getPacketReliabilityName(reliability));
+            return false;
+        }
+        return true;
+    }
+
+    void destroyReceivedPacket(ENetEvent& event)
+    {
+        if (event.type == ENET_EVENT_TYPE_RECEIVE && event.packet != nullptr) {
+            enet_packet_destroy(event.packet);
+            event.packet = nullptr;
+        }
+    }
+
+    void drainHostForShutdown(ENetHost* host, const char* owner_name)
+    {
+        ENetEvent event;
+        const enet_uint32 drain_start = enet_time_get();
+        int drained = 0;
+
+        while (enet_host_service(host, &event, 100) > 0) {
+            destroyReceivedPacket(event);
+
+            if (++drained >= NETWORK_MAX_EVENTS_PER_TICK) {
+                LOG_ENGINE_WARN("{0} shutdown drain hit event cap ({1}); breaking",
+                                owner_name,
+                                NETWORK_MAX_EVENTS_PER_TICK);
+                break;
+            }
+
+            const enet_uint32 elapsed_ms = ENET_TIME_DIFFERENCE(enet_time_get(), drain_start);
+            if (elapsed_ms >= NETWORK_SHUTDOWN_DRAIN_BUDGET_MS) {
+                LOG_ENGINE_WARN("{0} shutdown drain hit time budget ({1}ms); breaking",
+                                owner_name,
+                                NETWORK_SHUTDOWN_DRAIN_BUDGET_MS);
+                break;
+            }
+        }
+    }
+
+#ifdef _WIN32
+    // Pre-flight UDP bind probes. ENet6 creates an AF_INET6 dual-stack socket,
+    // so we test both families to locate the failure.
+    void probeUdpBind(uint16_t port)
+    {
+        // IPv4 probe
+        SOCKET probe4 = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (probe4 == INVALID_SOCKET) {
+            LOG_ENGINE_ERROR("IPv4 probe socket() failed: WSA {}", WSAGetLastError());
+        } else {
+            sockaddr_in sa{};
+            sa.sin_family = AF_INET;
+            sa.sin_port = htons(port);
+            sa.sin_addr.s_addr = INADDR_ANY;
+            if (::bind(probe4, (sockaddr*)&sa, sizeof(sa)) == SOCKET_ERROR) {
+                LOG_ENGINE_ERROR("IPv4 probe bind port {} failed: WSA {}", port, WSAGetLastError());
+            } else {
+                LOG_ENGINE_INFO("IPv4 probe bind port {} OK", port);
+            }
+            ::closesocket(probe4);
+        }
+
+        // IPv6 probe (what ENet actually does)
+        SOCKET probe6 = ::socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        if (probe6 == INVALID_SOCKET) {
+            LOG_ENGINE_ERROR("IPv6 probe socket() failed: WSA {} (IPv6 stack disabled?)", WSAGetLastError());
+        } else {
+            DWORD v6only = 0;
+            if (::setsockopt(probe6, IPPROTO_IPV6, IPV6_V6ONLY, (const char*)&v6only, sizeof(v6only)) == SOCKET_ERROR) {
+                LOG_ENGINE_ERROR("IPv6 probe IPV6_V6ONLY=0 failed: WSA {}", WSAGetLastError());
+            }
+            sockaddr_in6 sa6{};
+            sa6.sin6_family = AF_INET6;
+            sa6.sin6_port = htons(port);
+            sa6.sin6_addr = in6addr_any;
+            if (::bind(probe6, (sockaddr*)&sa6, sizeof(sa6)) == SOCKET_ERROR) {
+                LOG_ENGINE_ERROR("IPv6 probe bind port {} failed: WSA {}", port, WSAGetLastError());
+            } else {
+                LOG_ENGINE_INFO("IPv6 probe bind port {} OK", port);
+            }
+            ::closesocket(probe6);
+        }
+    }
+#endif
+}
+
+ENetTransport::~ENetTransport()
+{
+    close("ENet transport");
+}
+
+bool ENetTransport::listen(uint16_t port, uint32_t max_peers)
+{
+    if (host != nullptr) {
+        LOG_ENGINE_WARN("ENet transport already open");
+        return false;
+    }
+
+    ENetAddress address = {};
+    address.host = ENET_HOST_ANY;
+    address.port = port;
+    address.sin6_scope_id = 0;
+
+#ifdef _WIN32
+    probeUdpBind(port);
+#endif
+
+    if (!openHost(&address, max_peers)) {
+#ifdef _WIN32
+        int err = WSAGetLastError();
+        const char* hint = "";
+        if (err == WSAEADDRINUSE)      hint = " (port already in use - another server running?)";
+        else if (err == WSAEACCES)     hint = " (permission denied - port in Windows reserved range?)";
+        LOG_ENGINE_ERROR("Failed to create ENet server host on UDP port {} (WSA error {}){}",
+                         port, err, hint);
+#else
+        int err = errno;
+        LOG_ENGINE_ERROR("Failed to create ENet server host on UDP port {} (errno {}: {})",
+                         port, err, std::strerror(err));
+#endif
+        return false;
+    }
+
+    return true;
+}
+
+TransportPeerId ENetTransport::connect(const char* address, uint16_t port)
+{
+    if (host != nullptr) {
+        LOG_ENGINE_WARN("ENet transport already open");
+        return INVALID_TRANSPORT_PEER;
+    }
+
+    if (!openHost(nullptr, 1)) {
+        LOG_ENGINE_ERROR("Failed to create ENet client host");
+        return INVALID_TRANSPORT_PEER;
+    }
+
+    ENetAddress server_address = {};
+    if (enet_address_set_host(&server_address, address) != 0) {
+        LOG_ENGINE_ERROR("Failed to resolve server address: {0}", address);
+        destroyHost();
+        return INVALID_TRANSPORT_PEER;
+    }
+    server_address.port = port;
+    server_address.sin6_scope_id = 0;
+
+    ENetPeer* peer = enet_host_connect(host, &server_address, NETWORK_CHANNEL_COUNT, 0);
+    if (peer == nullptr) {
+        LOG_ENGINE_ERROR("Failed to create connection to server");
+        destroyHost();
+        return INVALID_TRANSPORT_PEER;
+    }
+
+    return getPeerId(peer);
+}
+
+void ENetTransport::close(const char* owner_name)
+{
+    if (host == nullptr) {
+        return;
+    }
+
+    releaseReceivedPacket();
+    for (size_t i = 0; i < host->peerCount; ++i) {
+        if (host->peers[i].state == ENET_PEER_STATE_CONNECTED) {
+            enet_peer_disconnect(&host->peers[i], 0);
+        }
+    }
+
+    // Give time for disconnect messages to send (bounded drain)
+    drainHostForShutdown(host, owner_name);
+    destroyHost();
+}
+
+bool ENetTransport::poll(TransportEvent& out_event)
+{
+    releaseReceivedPacket();
+    out_event = TransportEvent{};
+    if (host == nullptr) {
+        return false;
+    }
+
+    ENetEvent event;
+    while (enet_host_service(host, &event, 0) > 0) {
+        switch (event.type) {
+            case ENET_EVENT_TYPE_CONNECT:
+                out_event.type = TransportEventType::Connect;
+                out_event.peer = getPeerId(event.peer);
+                return true;
+
+            case ENET_EVENT_TYPE_RECEIVE:
+                received_packet = event.packet;
+                out_event.type = TransportEventType::Receive;
+                out_event.peer = getPeerId(event.peer);
+                if (received_packet != nullptr) {
+                    out_event.data = received_packet->data;
+                    out_event.size = received_packet->dataLength;
+                }
+                return true;
+
+            case ENET_EVENT_TYPE_DISCONNECT:
+            case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT:
+                out_event.type = TransportEventType::Disconnect;
+                out_event.peer = getPeerId(event.peer);
+                return true;
+
+            case ENET_EVENT_TYPE_NONE:
+                break;
+        }
+    }
+
+    return false;
+}
+
+PacketSendResult ENetTransport::send(TransportPeerId peer,
+                                     const uint8_t* data,
+                                     std::size_t size,
+                                     PacketReliability reliability)
+{
+    ENetPeer* enet_peer = findPeer(peer);
+    const PacketSendResult result = validateSend(enet_peer, size, reliability);
+    if (result != PacketSendResult::Sent) {
+        return result;
+    }
+
+    ENetPacket* packet = enet_packet_create(data, size, getPacketFlags(reliability));
+    if (packet == nullptr) {
+        LOG_ENGINE_WARN("enet_packet_create failed for {0} message", getPacketReliabilityName(reliability));
+        return PacketSendResult::CreateFailed;
+    }
+
+    if (!queuePacketOnPeer(enet_peer, packet, reliability)) {
+        enet_packet_destroy(packet);
+        return PacketSendResult::SendFailed;
+    }
+
+    return PacketSendResult::Sent;
+}
+
+void ENetTransport::sendToPeers(const TransportPeerId* peers,
+                                std::size_t peer_count,
+                                const uint8_t* data,
+                                std::size_t size,
+                                PacketReliability reliability,
+                                PacketSendResult* out_results)
+{
+    // ENet reference-counts packets, so every recipient queues the same one
+    ENetPacket* shared_packet = nullptr;
+    for (std::size_t i = 0; i < peer_count; ++i) {
+        ENetPeer* enet_peer = findPeer(peers[i]);
+        PacketSendResult result = validateSend(enet_peer, size, reliability);
+        if (packetSendSucceeded(result) && shared_packet == nullptr) {
+            shared_packet = enet_packet_create(data, size, getPacketFlags(reliability));
+            if (shared_packet == nullptr) {
+                LOG_ENGINE_WARN("enet_packet_create failed for {0} multicast", getPacketReliabilityName(reliability));
+                result = PacketSendResult::CreateFailed;
+            }
+        }
+        if (packetSendSucceeded(result) && !queuePacketOnPeer(enet_peer, shared_packet, reliability)) {
+            result = PacketSendResult::SendFailed;
+        }
+        out_results[i] = result;
+    }
+
+    // No peer took a reference
+    if (shared_packet != nullptr && shared_packet->referenceCount == 0) {
+        enet_packet_destroy(shared_packet);
+    }
+}
+
+void ENetTransport::flush()
+{
+    if (host != nullptr) {
+        enet_host_flush(host);
+    }
+}
+
+void ENetTransport::disconnect(TransportPeerId peer)
+{
+    if (ENetPeer* enet_peer = findPeer(peer)) {
+        enet_peer_disconnect(enet_peer, 0);
+    }
+}
+
+void ENetTransport::disconnectLater(TransportPeerId peer)
+{
+    if (ENetPeer* enet_peer = findPeer(peer)) {
+        enet_peer_disconnect_later(enet_peer, 0);
+    }
+}
+
+bool ENetTransport::isPeerConnected(TransportPeerId peer) const
+{
+    return isPeerConnectedForApplicationSend(findPeer(peer));
+}
+
+bool ENetTransport::getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const
+{
+    const ENetPeer* enet_peer = findPeer(peer);
+    if (enet_peer == nullptr) {
+        return false;
+    }
+
+    out_stats.rtt_ms = static_cast<float>(enet_peer->roundTripTime);
+    out_stats.rtt_variance_ms = static_cast<float>(enet_peer->roundTripTimeVariance);
+    out_stats.packet_loss_percent = enetPacketLossToPercent(enet_peer->packetLoss);
+    out_stats.packet_loss_variance_percent = enetPacketLossToPercent(enet_peer->packetLossVariance);
+    out_stats.outgoing_queue_bytes = static_cast<uint32_t>(enet_peer->outgoingDataTotal);
+    out_stats.time_since_last_receive_seconds = enet_peer->lastReceiveTime > 0
+        ? static_cast<float>(host->serviceTime - enet_peer->lastReceiveTime) / 1000.0f
+        : 0.0f;
+    out_stats.timeout_seconds = static_cast<float>(enet_peer->timeoutMaximum) / 1000.0f;
+    return true;
+}
+
+ENetPeer* ENetTransport::findPeer(TransportPeerId peer) const
+{
+    if (host == nullptr || peer == INVALID_TRANSPORT_PEER || peer > host->peerCount) {
+        return nullptr;
+    }
+    return &host->peers[peer - 1];
+}
+
+TransportPeerId ENetTransport::getPeerId(const ENetPeer* peer) const
+{
+    if (host == nullptr || peer == nullptr) {
+        return INVALID_TRANSPORT_PEER;
+    }
+    return static_cast<TransportPeerId>(peer - host->peers) + 1;
+}
+
+bool ENetTransport::openHost(const ENetAddress* address, uint32_t max_peers)
+{
+    if (!NetworkRuntime::acquire()) {
+        return false;
+    }
+    runtime_acquired = true;
+
+    // Reliable, sequenced unreliable, and unordered unreliable channels
+    host = enet_host_create(address, max_peers, NETWORK_CHANNEL_COUNT, 0, 0);
+    if (host == nullptr) {
+        destroyHost();
+        return false;
+    }
+    return true;
+}
+
+void ENetTransport::destroyHost()
+{
+    releaseReceivedPacket();
+    if (host != nullptr) {
+        enet_host_destroy(host);
+        host = nullptr;
+    }
+    if (runtime_acquired) {
+        NetworkRuntime::release();
+        runtime_acquired = false;
+    }
+}
+
+void ENetTransport::releaseReceivedPacket()
+{
+    if (received_packet != nullptr) {
+        enet_packet_destroy(received_packet);
+        received_packet = nullptr;
+    }
+}
+
+} // namespace Net
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "NetworkTransport.hpp"
+#include "EngineExport.h"
+#include "enet.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Net {
+
+inline ENetPacketFlag getPacketFlags(PacketReliability reliability)
+{
+    switch (reliability) {
+        case PacketReliability::Reliable:
+            return ENET_PACKET_FLAG_RELIABLE;
+        case PacketReliability::UnreliableSequenced:
+            return static_cast<ENetPacketFlag>(0);
+        case PacketReliability::UnreliableUnordered:
+            return ENET_PACKET_FLAG_UNSEQUENCED;
+    }
+
+    return static_cast<ENetPacketFlag>(0);
+}
+
+// UDP transport over ENet. Peer handles are 1-based indices into the host's peer array.
+class ENGINE_API ENetTransport final : public INetworkTransport
+{
+public:
+    ENetTransport() = default;
+    ~ENetTransport() override;
+
+    ENetTransport(const ENetTransport&) = delete;
+    ENetTransport& operator=(const ENetTransport&) = delete;
+
+    const char* getName() const override { return "enet"; }
+
+    bool listen(uint16_t port, uint32_t max_peers) override;
+    TransportPeerId connect(const char* address, uint16_t port) override;
+    void close(const char* owner_name) override;
+    bool isOpen() const override { return host != nullptr; }
+
+    bool poll(TransportEvent& out_event) override;
+    PacketSendResult send(TransportPeerId peer,
+                          const uint8_t* data,
+                          std::size_t size,
+                          PacketReliability reliability) override;
+    void sendToPeers(const TransportPeerId* peers,
+                     std::size_t peer_count,
+                     const uint8_t* data,
+                     std::size_t size,
+                     PacketReliability reliability,
+                     PacketSendResult* out_results) override;
+    void flush() override;
+
+    void disconnect(TransportPeerId peer) override;
+    void disconnectLater(TransportPeerId peer) override;
+    bool isPeerConnected(TransportPeerId peer) const override;
+    bool getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const override;
+
+private:
+    ENetPeer* findPeer(TransportPeerId peer) const;
+    TransportPeerId getPeerId(const ENetPeer* peer) const;
+    bool openHost(const ENetAddress* address, uint32_t max_peers);
+    void destroyHost();
+    void releaseReceivedPacket();
+
+    ENetHost* host = nullptr;
+    ENetPacket* received_packet = nullptr;  // Backs the last Receive event
+    bool runtime_acquired = false;
+};
+
+} // namespace Net
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "NetworkInput.hpp"
+#include "NetworkProtocol.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace Net {
+
+struct InputJitterSettings
+{
+    uint32_t min_depth = 1;           // Inputs held before playback starts, even with no jitter
+    uint32_t max_depth = 6;
+    float depth_per_jitter_tick = 2.0f;
+    uint32_t overflow_slack = 2;      // Merge once the buffer runs this far past its target
+};
+
+struct InputJitterStats
+{
+    uint32_t depth = 0;
+    uint32_t target_depth = 0;
+    float jitter_ticks = 0.0f;        // Smoothed arrival jitter, RFC 3550 style
+    uint64_t received = 0;
+    uint64_t consumed = 0;            // Real inputs played back
+    uint64_t synthesized = 0;         // Underflow: last input repeated without one-shot actions
+    uint64_t merged = 0;              // Overflow: oldest input folded into the next one
+};
+
+struct BufferedInput
+{
+    InputSample sample;
+    uint32_t acknowledged_server_tick = 0;
+    bool synthesized = false;
+};
+
+// Per-client input de-jitter buffer (server side). Packets arrive in bursts; playback
+// takes exactly one input per server tick from a queue whose depth follows the
+// measured arrival jitter. An empty queue repeats the last input and refills to the
+// target before real inputs resume; a queue well past its target folds its oldest
+// input into the next so latency drains back down.
+class InputJitterBuffer
+{
+public:
+    void setSettings(const InputJitterSettings& new_settings)
+    {
+        settings = new_settings;
+        settings.min_depth = (std::max)(settings.min_depth, 1u);
+        settings.max_depth = (std::max)(settings.max_depth, settings.min_depth);
+        stats.target_depth = computeTargetDepth();
+    }
+
+    const InputJitterSettings& getSettings() const { return settings; }
+    const InputJitterStats& getStats() const { return stats; }
+
+    void reset()
+    {
+        inputs.clear();
+        stats = {};
+        stats.target_depth = computeTargetDepth();
+        last_transit = 0;
+        has_transit = false;
+        playing = false;
+        has_played = false;
+    }
+
+    // Once per input packet: the newest client tick it carried and the server tick it arrived on
+    void recordArrival(uint32_t client_tick, uint32_t server_tick)
+    {
+        const int32_t transit = static_cast<int32_t>(server_tick - client_tick);
+        if (has_transit) {
+            const float delta = std::abs(static_cast<float>(transit - last_transit));
+            stats.jitter_ticks += (delta - stats.jitter_ticks) / 16.0f;
+        }
+        last_transit = transit;
+        has_transit = true;
+        stats.target_depth = computeTargetDepth();
+    }
+
+    // Samples must be newer than anything pushed before (the server filters redundant copies)
+    void push(const InputSample& sample, uint32_t acknowledged_server_tick)
+    {
+        BufferedInput input;
+        input.sample = sample;
+        input.acknowledged_server_tick = acknowledged_server_tick;
+
+        auto it = inputs.end();
+        while (it != inputs.begin() && isTickNewer((it - 1)->sample.tick, sample.tick)) {
+            --it;
+        }
+        inputs.insert(it, input);
+        stats.received++;
+        stats.depth = static_cast<uint32_t>(inputs.size());
+    }
+
+    // Call exactly once per server tick. False only before the first input has played.
+    bool consume(BufferedInput& out)
+    {
+        if (!playing && inputs.size() >= stats.target_depth) {
+            playing = true;
+        }
+
+        if (!playing || inputs.empty()) {
+            // Underflow: hold position with the last input until the buffer refills
+            playing = false;
+            if (!has_played) {
+                return false;
+            }
+            out = last_played;
+            out.sample.buttons &= static_cast<uint8_t>(~INPUT_ACTION_LATCH_MASK);
+            out.synthesized = true;
+            stats.synthesized++;
+            return true;
+        }
+
+        if (inputs.size() > static_cast<size_t>(stats.target_depth) + settings.overflow_slack && inputs.size() >= 2) {
+            // One-shot actions survive the merge
+            const uint8_t latched = static_cast<uint8_t>(inputs.front().sample.buttons & INPUT_ACTION_LATCH_MASK);
+            inputs.pop_front();
+            inputs.front().sample.buttons |= latched;
+            stats.merged++;
+        }
+
+        out = inputs.front();
+        inputs.pop_front();
+        last_played = out;
+        has_played = true;
+        stats.consumed++;
+        stats.depth = static_cast<uint32_t>(inputs.size());
+        return true;
+    }
+
+    size_t size() const { return inputs.size(); }
+
+private:
+    uint32_t computeTargetDepth() const
+    {
+        const float extra = std::ceil(stats.jitter_ticks * settings.depth_per_jitter_tick);
+        const uint32_t depth = settings.min_depth + static_cast<uint32_t>((std::max)(extra, 0.0f));
+        return (std::min)(depth, settings.max_depth);
+    }
+
+    InputJitterSettings settings;
+    InputJitterStats stats{0, 1};
+    std::deque<BufferedInput> inputs;
+    BufferedInput last_played;
+    int32_t last_transit = 0;
+    bool has_transit = false;
+    bool playing = false;
+    bool has_played = false;
+};
+
+} // namespace Net
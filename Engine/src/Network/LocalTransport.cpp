@@ -0,0 +1,571 @@
+#include "LocalTransport.hpp"
+#include "Utils/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace Net {
+
+namespace {
+    constexpr uint8_t LOCAL_CONTROL_NONE = 0;        // Application payload
+    constexpr uint8_t LOCAL_CONTROL_ACCEPT = 1;      // Server -> client: connection accepted
+    constexpr uint8_t LOCAL_CONTROL_DISCONNECT = 2;
+    constexpr std::size_t LOCAL_RING_CAPACITY = 512; // Packets per direction; power of two
+    // CompositeTransport keeps the top byte of a peer handle for the transport index
+    constexpr TransportPeerId LOCAL_PEER_ID_MASK = 0x00FFFFFFu;
+}
+
+struct LocalPacket
+{
+    std::shared_ptr<const std::vector<uint8_t>> payload;  // Shared by every recipient of a sendToPeers
+    PacketReliability reliability = PacketReliability::Reliable;
+    uint8_t control = LOCAL_CONTROL_NONE;
+    uint32_t sequence = 0;  // UnreliableSequenced only
+};
+
+namespace {
+    // Lamport ring: one thread pushes, one thread pops, no locks
+    class LocalPacketRing
+    {
+    public:
+        bool push(LocalPacket&& packet)
+        {
+            const std::size_t tail = write_index.load(std::memory_order_relaxed);
+            if (tail - read_index.load(std::memory_order_acquire) >= LOCAL_RING_CAPACITY) {
+                return false;
+            }
+            slots[tail & (LOCAL_RING_CAPACITY - 1)] = std::move(packet);
+            write_index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(LocalPacket& out_packet)
+        {
+            const std::size_t head = read_index.load(std::memory_order_relaxed);
+            if (head == write_index.load(std::memory_order_acquire)) {
+                return false;
+            }
+            out_packet = std::move(slots[head & (LOCAL_RING_CAPACITY - 1)]);
+            read_index.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<LocalPacket, LOCAL_RING_CAPACITY> slots;
+        alignas(64) std::atomic<std::size_t> write_index{0};
+        alignas(64) std::atomic<std::size_t> read_index{0};
+    };
+
+    std::size_t getPayloadSize(const LocalPacket& packet)
+    {
+        return packet.payload ? packet.payload->size() : 0;
+    }
+}
+
+// One direction of a connection
+struct LocalLink
+{
+    LocalPacketRing ring;
+    std::atomic<uint32_t> queued_bytes{0};  // Held back by the sender plus waiting in the ring
+    std::atomic<bool> closed{false};        // The sending end went away
+};
+
+struct LocalConnection
+{
+    LocalLink to_server;
+    LocalLink to_client;
+};
+
+struct LocalListener
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<LocalConnection>> pending;
+    bool open = true;
+};
+
+namespace {
+    std::mutex g_listener_mutex;
+
+    std::unordered_map<uint16_t, std::weak_ptr<LocalListener>>& getListenerRegistry()
+    {
+        static std::unordered_map<uint16_t, std::weak_ptr<LocalListener>> registry;
+        return registry;
+    }
+}
+
+struct LocalTransport::Peer
+{
+    struct DelayedPacket
+    {
+        double release_time = 0.0;
+        uint64_t order = 0;
+        std::size_t size = 0;
+        LocalPacket packet;
+    };
+
+    std::shared_ptr<LocalConnection> connection;
+    LocalLink* outgoing = nullptr;
+    LocalLink* incoming = nullptr;
+    std::vector<DelayedPacket> delayed;  // Sent but not yet on the ring, by release time
+    uint64_t next_order = 0;
+    uint32_t next_sequence = 0;
+    uint32_t last_released_sequence = 0;
+    double last_reliable_release = 0.0;
+    double last_receive_time = 0.0;
+    bool connected = false;            // Handshake finished
+    bool closing = false;              // Disconnect queued; no further sends
+    bool disconnect_reported = false;  // Removed on the next poll
+};
+
+LocalTransport::LocalTransport(LocalTransportSettings transport_settings)
+    : settings(std::move(transport_settings))
+    , rng_state(settings.seed)
+{
+}
+
+LocalTransport::~LocalTransport()
+{
+    close("Local transport");
+}
+
+bool LocalTransport::isListening(uint16_t port)
+{
+    std::lock_guard<std::mutex> lock(g_listener_mutex);
+    auto& registry = getListenerRegistry();
+    auto it = registry.find(port);
+    return it != registry.end() && !it->second.expired();
+}
+
+bool LocalTransport::listen(uint16_t port, uint32_t max_peers)
+{
+    if (isOpen()) {
+        LOG_ENGINE_WARN("Local transport already open");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_listener_mutex);
+    auto& registry = getListenerRegistry();
+    auto it = registry.find(port);
+    if (it != registry.end() && !it->second.expired()) {
+        LOG_ENGINE_ERROR("Local transport port {0} is already in use in this process", port);
+        return false;
+    }
+
+    listener = std::make_shared<LocalListener>();
+    registry[port] = listener;
+    listen_port = port;
+    max_peer_count = max_peers;
+    return true;
+}
+
+TransportPeerId LocalTransport::connect(const char* address, uint16_t port)
+{
+    if (isOpen()) {
+        LOG_ENGINE_WARN("Local transport already open");
+        return INVALID_TRANSPORT_PEER;
+    }
+
+    std::shared_ptr<LocalListener> target;
+    {
+        std::lock_guard<std::mutex> lock(g_listener_mutex);
+        auto it = getListenerRegistry().find(port);
+        if (it != getListenerRegistry().end()) {
+            target = it->second.lock();
+        }
+    }
+
+    auto connection = std::make_shared<LocalConnection>();
+    bool queued = false;
+    if (target != nullptr) {
+        std::lock_guard<std::mutex> lock(target->mutex);
+        if (target->open) {
+            target->pending.push_back(connection);
+            queued = true;
+        }
+    }
+    if (!queued) {
+        LOG_ENGINE_ERROR("No local server listening on port {0} (address {1})", port, address ? address : "");
+        return INVALID_TRANSPORT_PEER;
+    }
+
+    return addPeer(std::move(connection), false);
+}
+
+void LocalTransport::close(const char* owner_name)
+{
+    (void)owner_name;
+    received_payload.reset();
+
+    for (auto& [id, peer] : peers) {
+        if (!peer->closing && !peer->disconnect_reported) {
+            queueControl(*peer, LOCAL_CONTROL_DISCONNECT);
+        }
+        // Nothing to wait for in-process: everything still held back goes out now
+        for (Peer::DelayedPacket& delayed : peer->delayed) {
+            delayed.release_time = 0.0;
+        }
+        releaseDuePackets(*peer, 0.0);
+        peer->outgoing->closed.store(true, std::memory_order_release);
+    }
+    peers.clear();
+
+    if (listener != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(g_listener_mutex);
+            auto& registry = getListenerRegistry();
+            auto it = registry.find(listen_port);
+            if (it != registry.end() && it->second.lock() == listener) {
+                registry.erase(it);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(listener->mutex);
+        listener->open = false;
+        for (auto& connection : listener->pending) {
+            connection->to_client.closed.store(true, std::memory_order_release);
+        }
+        listener->pending.clear();
+    }
+    listener.reset();
+}
+
+bool LocalTransport::poll(TransportEvent& out_event)
+{
+    received_payload.reset();
+    out_event = TransportEvent{};
+    removeClosedPeers();
+
+    if (acceptPending(out_event)) {
+        return true;
+    }
+
+    const double time = now();
+    for (auto& [id, peer_ptr] : peers) {
+        Peer& peer = *peer_ptr;
+        releaseDuePackets(peer, time);
+        if (peer.disconnect_reported) {
+            continue;
+        }
+
+        // Read before draining: whatever the other end pushed before closing is delivered first
+        const bool remote_closed = peer.incoming->closed.load(std::memory_order_acquire);
+        LocalPacket packet;
+        while (peer.incoming->ring.pop(packet)) {
+            peer.incoming->queued_bytes.fetch_sub(static_cast<uint32_t>(getPayloadSize(packet)),
+                                                  std::memory_order_relaxed);
+            peer.last_receive_time = time;
+
+            if (packet.control == LOCAL_CONTROL_ACCEPT) {
+                peer.connected = true;
+                out_event.type = TransportEventType::Connect;
+                out_event.peer = id;
+                return true;
+            }
+            if (packet.control == LOCAL_CONTROL_DISCONNECT) {
+                return reportDisconnect(peer, id, out_event);
+            }
+            if (!peer.connected || !packet.payload) {
+                continue;
+            }
+
+            received_payload = std::move(packet.payload);
+            out_event.type = TransportEventType::Receive;
+            out_event.peer = id;
+            out_event.data = received_payload->data();
+            out_event.size = received_payload->size();
+            return true;
+        }
+
+        // Our own disconnect has left, or the other end vanished without one
+        if ((peer.closing && peer.delayed.empty()) || remote_closed) {
+            return reportDisconnect(peer, id, out_event);
+        }
+    }
+
+    return false;
+}
+
+PacketSendResult LocalTransport::send(TransportPeerId peer,
+                                      const uint8_t* data,
+                                      std::size_t size,
+                                      PacketReliability reliability)
+{
+    Peer* local_peer = findPeer(peer);
+    if (local_peer == nullptr || !isPeerConnected(peer)) {
+        return PacketSendResult::InvalidPeer;
+    }
+
+    PacketSendResult result = validatePacketPayload(size, reliability);
+    if (result == PacketSendResult::Sent) {
+        result = validateSendQueue(local_peer->outgoing->queued_bytes.load(std::memory_order_relaxed), reliability);
+    }
+    if (result != PacketSendResult::Sent) {
+        return result;
+    }
+
+    return queuePacket(*local_peer, std::make_shared<const std::vector<uint8_t>>(data, data + size), reliability);
+}
+
+void LocalTransport::sendToPeers(const TransportPeerId* peer_ids,
+                                 std::size_t peer_count,
+                                 const uint8_t* data,
+                                 std::size_t size,
+                                 PacketReliability reliability,
+                                 PacketSendResult* out_results)
+{
+    std::shared_ptr<const std::vector<uint8_t>> payload;
+    for (std::size_t i = 0; i < peer_count; ++i) {
+        Peer* local_peer = findPeer(peer_ids[i]);
+        if (local_peer == nullptr || !isPeerConnected(peer_ids[i])) {
+            out_results[i] = PacketSendResult::InvalidPeer;
+            continue;
+        }
+
+        PacketSendResult result = validatePacketPayload(size, reliability);
+        if (result == PacketSendResult::Sent) {
+            result = validateSendQueue(local_peer->outgoing->queued_bytes.load(std::memory_order_relaxed), reliability);
+        }
+        if (result == PacketSendResult::Sent) {
+            if (!payload) {
+                payload = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+            }
+            result = queuePacket(*local_peer, payload, reliability);
+        }
+        out_results[i] = result;
+    }
+}
+
+void LocalTransport::flush()
+{
+    const double time = now();
+    for (auto& [id, peer] : peers) {
+        releaseDuePackets(*peer, time);
+    }
+}
+
+void LocalTransport::disconnect(TransportPeerId peer)
+{
+    Peer* local_peer = findPeer(peer);
+    if (local_peer != nullptr && !local_peer->closing && !local_peer->disconnect_reported) {
+        queueControl(*local_peer, LOCAL_CONTROL_DISCONNECT);
+        local_peer->closing = true;
+    }
+}
+
+void LocalTransport::disconnectLater(TransportPeerId peer)
+{
+    // Packets leave in send order, so the disconnect already trails everything queued
+    disconnect(peer);
+}
+
+bool LocalTransport::isPeerConnected(TransportPeerId peer) const
+{
+    const Peer* local_peer = findPeer(peer);
+    return local_peer != nullptr &&
+        local_peer->connected &&
+        !local_peer->closing &&
+        !local_peer->disconnect_reported;
+}
+
+bool LocalTransport::getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const
+{
+    const Peer* local_peer = findPeer(peer);
+    if (local_peer == nullptr) {
+        return false;
+    }
+
+    out_stats.rtt_ms = 2.0f * settings.latency_ms + settings.jitter_ms;
+    out_stats.rtt_variance_ms = settings.jitter_ms;
+    out_stats.packet_loss_percent = settings.loss_percent;
+    out_stats.packet_loss_variance_percent = 0.0f;
+    out_stats.outgoing_queue_bytes = local_peer->outgoing->queued_bytes.load(std::memory_order_relaxed);
+    out_stats.time_since_last_receive_seconds = local_peer->last_receive_time > 0.0
+        ? static_cast<float>(now() - local_peer->last_receive_time)
+        : 0.0f;
+    out_stats.timeout_seconds = 0.0f;
+    return true;
+}
+
+double LocalTransport::now() const
+{
+    if (settings.clock) {
+        return settings.clock();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+float LocalTransport::nextRandom()
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return static_cast<float>(rng_state >> 8) / static_cast<float>(1u << 24);
+}
+
+LocalTransport::Peer* LocalTransport::findPeer(TransportPeerId peer)
+{
+    auto it = peers.find(peer);
+    return it != peers.end() ? it->second.get() : nullptr;
+}
+
+const LocalTransport::Peer* LocalTransport::findPeer(TransportPeerId peer) const
+{
+    auto it = peers.find(peer);
+    return it != peers.end() ? it->second.get() : nullptr;
+}
+
+TransportPeerId LocalTransport::addPeer(std::shared_ptr<LocalConnection> connection, bool server_side)
+{
+    TransportPeerId id = next_peer_id;
+    while (id == INVALID_TRANSPORT_PEER || peers.find(id) != peers.end()) {
+        id = (id + 1) & LOCAL_PEER_ID_MASK;
+    }
+    next_peer_id = (id + 1) & LOCAL_PEER_ID_MASK;
+
+    auto peer = std::make_unique<Peer>();
+    peer->outgoing = server_side ? &connection->to_client : &connection->to_server;
+    peer->incoming = server_side ? &connection->to_server : &connection->to_client;
+    peer->connection = std::move(connection);
+    peers[id] = std::move(peer);
+    return id;
+}
+
+PacketSendResult LocalTransport::queuePacket(Peer& peer,
+                                             const std::shared_ptr<const std::vector<uint8_t>>& payload,
+                                             PacketReliability reliability)
+{
+    float delay_ms = settings.latency_ms;
+    if (settings.jitter_ms > 0.0f) {
+        delay_ms += nextRandom() * settings.jitter_ms;
+    }
+    if (reliability != PacketReliability::Reliable) {
+        if (settings.loss_percent > 0.0f && nextRandom() * 100.0f < settings.loss_percent) {
+            return PacketSendResult::Sent;  // Lost on the wire
+        }
+        if (settings.reorder_percent > 0.0f && nextRandom() * 100.0f < settings.reorder_percent) {
+            delay_ms += settings.reorder_delay_ms;
+        }
+    }
+
+    LocalPacket packet;
+    packet.payload = payload;
+    packet.reliability = reliability;
+    if (reliability == PacketReliability::UnreliableSequenced) {
+        packet.sequence = ++peer.next_sequence;
+    }
+    schedulePacket(peer, std::move(packet), payload->size(), now() + delay_ms / 1000.0);
+    return PacketSendResult::Sent;
+}
+
+void LocalTransport::queueControl(Peer& peer, uint8_t control)
+{
+    LocalPacket packet;
+    packet.control = control;
+    schedulePacket(peer, std::move(packet), 0, now() + settings.latency_ms / 1000.0);
+}
+
+void LocalTransport::schedulePacket(Peer& peer, LocalPacket&& packet, std::size_t size, double release_time)
+{
+    // Reliable data and control packets never overtake each other
+    if (packet.reliability == PacketReliability::Reliable) {
+        release_time = (std::max)(release_time, peer.last_reliable_release);
+        peer.last_reliable_release = release_time;
+    }
+
+    Peer::DelayedPacket delayed;
+    delayed.release_time = release_time;
+    delayed.order = peer.next_order++;
+    delayed.size = size;
+    delayed.packet = std::move(packet);
+
+    auto it = std::upper_bound(peer.delayed.begin(), peer.delayed.end(), release_time,
+        [](double time, const Peer::DelayedPacket& other) { return time < other.release_time; });
+    peer.delayed.insert(it, std::move(delayed));
+    peer.outgoing->queued_bytes.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+}
+
+void LocalTransport::releaseDuePackets(Peer& peer, double time)
+{
+    std::size_t released = 0;
+    for (; released < peer.delayed.size() && peer.delayed[released].release_time <= time; ++released) {
+        Peer::DelayedPacket& delayed = peer.delayed[released];
+        if (delayed.packet.reliability == PacketReliability::UnreliableSequenced &&
+            delayed.packet.control == LOCAL_CONTROL_NONE) {
+            // Stale: a newer sequenced packet already went out
+            if (static_cast<int32_t>(delayed.packet.sequence - peer.last_released_sequence) < 0) {
+                peer.outgoing->queued_bytes.fetch_sub(static_cast<uint32_t>(delayed.size), std::memory_order_relaxed);
+                continue;
+            }
+            peer.last_released_sequence = delayed.packet.sequence;
+        }
+
+        // Ring full: the rest waits for the next flush
+        if (!peer.outgoing->ring.push(std::move(delayed.packet))) {
+            break;
+        }
+    }
+    peer.delayed.erase(peer.delayed.begin(), peer.delayed.begin() + static_cast<std::ptrdiff_t>(released));
+}
+
+bool LocalTransport::acceptPending(TransportEvent& out_event)
+{
+    if (listener == nullptr) {
+        return false;
+    }
+
+    while (true) {
+        std::shared_ptr<LocalConnection> connection;
+        {
+            std::lock_guard<std::mutex> lock(listener->mutex);
+            if (listener->pending.empty()) {
+                return false;
+            }
+            connection = std::move(listener->pending.front());
+            listener->pending.erase(listener->pending.begin());
+        }
+
+        if (peers.size() >= max_peer_count) {
+            LOG_ENGINE_WARN("Local transport on port {0} is full; refusing connection", listen_port);
+            connection->to_client.closed.store(true, std::memory_order_release);
+            continue;
+        }
+
+        const TransportPeerId id = addPeer(std::move(connection), true);
+        Peer& peer = *peers[id];
+        peer.connected = true;
+        queueControl(peer, LOCAL_CONTROL_ACCEPT);
+
+        out_event.type = TransportEventType::Connect;
+        out_event.peer = id;
+        return true;
+    }
+}
+
+bool LocalTransport::reportDisconnect(Peer& peer, TransportPeerId id, TransportEvent& out_event)
+{
+    peer.disconnect_reported = true;
+    out_event.type = TransportEventType::Disconnect;
+    out_event.peer = id;
+    return true;
+}
+
+void LocalTransport::removeClosedPeers()
+{
+    for (auto it = peers.begin(); it != peers.end();) {
+        Peer& peer = *it->second;
+        if (!peer.disconnect_reported) {
+            ++it;
+            continue;
+        }
+
+        for (Peer::DelayedPacket& delayed : peer.delayed) {
+            delayed.release_time = 0.0;
+        }
+        releaseDuePackets(peer, 0.0);
+        peer.outgoing->closed.store(true, std::memory_order_release);
+        it = peers.erase(it);
+    }
+}
+
+} // namespace Net
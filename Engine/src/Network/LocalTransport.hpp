@@ -0,0 +1,103 @@
+#pragma once
+
+#include "NetworkTransport.hpp"
+#include "EngineExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Net {
+
+struct LocalConnection;
+struct LocalListener;
+struct LocalPacket;
+
+// Simulated link conditions, applied by the sending end: delayed packets are released when
+// it next polls or flushes. Reliable packets are never lost and never overtake each other;
+// sequenced packets older than one already delivered are dropped.
+struct LocalTransportSettings
+{
+    float latency_ms = 0.0f;        // One-way delay
+    float jitter_ms = 0.0f;         // Extra random delay per packet, 0..jitter_ms
+    float loss_percent = 0.0f;      // Unreliable packets only
+    float reorder_percent = 0.0f;   // Unreliable packets held back by reorder_delay_ms so later ones overtake them
+    float reorder_delay_ms = 20.0f;
+    uint32_t seed = 0x9e3779b9u;
+    std::function<double()> clock;  // Seconds. Empty uses the steady clock; tests pass a manual clock.
+};
+
+// In-process transport between a server and clients in the same process, for listen
+// servers and tests. Servers listen on a port number in a process-wide registry instead of
+// a socket. Packets move through one single-producer/single-consumer ring per direction,
+// so sending and polling never lock; only connect and accept take a mutex.
+class ENGINE_API LocalTransport final : public INetworkTransport
+{
+public:
+    explicit LocalTransport(LocalTransportSettings transport_settings = {});
+    ~LocalTransport() override;
+
+    LocalTransport(const LocalTransport&) = delete;
+    LocalTransport& operator=(const LocalTransport&) = delete;
+
+    // True if a LocalTransport in this process is listening on port
+    static bool isListening(uint16_t port);
+
+    const char* getName() const override { return "local"; }
+
+    bool listen(uint16_t port, uint32_t max_peers) override;
+    TransportPeerId connect(const char* address, uint16_t port) override;
+    void close(const char* owner_name) override;
+    bool isOpen() const override { return listener != nullptr || !peers.empty(); }
+
+    bool poll(TransportEvent& out_event) override;
+    PacketSendResult send(TransportPeerId peer,
+                          const uint8_t* data,
+                          std::size_t size,
+                          PacketReliability reliability) override;
+    void sendToPeers(const TransportPeerId* peers,
+                     std::size_t peer_count,
+                     const uint8_t* data,
+                     std::size_t size,
+                     PacketReliability reliability,
+                     PacketSendResult* out_results) override;
+    void flush() override;
+
+    void disconnect(TransportPeerId peer) override;
+    void disconnectLater(TransportPeerId peer) override;
+    bool isPeerConnected(TransportPeerId peer) const override;
+    bool getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const override;
+
+    const LocalTransportSettings& getSettings() const { return settings; }
+
+private:
+    struct Peer;
+
+    double now() const;
+    float nextRandom();
+    Peer* findPeer(TransportPeerId peer);
+    const Peer* findPeer(TransportPeerId peer) const;
+    TransportPeerId addPeer(std::shared_ptr<LocalConnection> connection, bool server_side);
+    PacketSendResult queuePacket(Peer& peer, const std::shared_ptr<const std::vector<uint8_t>>& payload,
+                                 PacketReliability reliability);
+    void queueControl(Peer& peer, uint8_t control);
+    void schedulePacket(Peer& peer, LocalPacket&& packet, std::size_t size, double release_time);
+    void releaseDuePackets(Peer& peer, double time);
+    bool acceptPending(TransportEvent& out_event);
+    bool reportDisconnect(Peer& peer, TransportPeerId id, TransportEvent& out_event);
+    void removeClosedPeers();
+
+    LocalTransportSettings settings;
+    std::shared_ptr<LocalListener> listener;
+    uint16_t listen_port = 0;
+    uint32_t max_peer_count = 0;
+    std::unordered_map<TransportPeerId, std::unique_ptr<Peer>> peers;
+    TransportPeerId next_peer_id = 1;
+    uint32_t rng_state = 0;
+    std::shared_ptr<const std::vector<uint8_t>> received_payload;  // Backs the last Receive event
+};
+
+} // namespace Net
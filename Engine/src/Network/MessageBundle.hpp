@@ -0,0 +1,113 @@
+#pragma once
+
+#include "NetworkProtocol.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Net {
+
+constexpr std::size_t MESSAGE_BUNDLE_HEADER_BYTES = 3;   // type + uint16 message count
+constexpr std::size_t MESSAGE_BUNDLE_ENTRY_BYTES = 2;    // uint16 length before each message
+constexpr uint16_t MESSAGE_BUNDLE_MAX_MESSAGES = 0xFFFF;
+
+// Serialized messages bound for one peer and channel, sent as a single MESSAGE_BUNDLE
+// packet. Wire format: type byte, uint16 message count, then for every message a uint16
+// byte length followed by the message bytes exactly as they were serialized.
+class MessageBundle
+{
+public:
+    explicit MessageBundle(std::size_t max_packet_bytes)
+        : max_bytes(max_packet_bytes)
+    {
+        clear();
+    }
+
+    bool empty() const { return message_count == 0; }
+    uint16_t getMessageCount() const { return message_count; }
+
+    bool canAppend(std::size_t message_bytes) const
+    {
+        return message_bytes > 0 &&
+            message_bytes <= 0xFFFF &&
+            message_count < MESSAGE_BUNDLE_MAX_MESSAGES &&
+            bytes.size() + MESSAGE_BUNDLE_ENTRY_BYTES + message_bytes <= max_bytes;
+    }
+
+    void append(const uint8_t* data, std::size_t size)
+    {
+        bytes.push_back(static_cast<uint8_t>(size & 0xFF));
+        bytes.push_back(static_cast<uint8_t>((size >> 8) & 0xFF));
+        bytes.insert(bytes.end(), data, data + size);
+        ++message_count;
+        bytes[1] = static_cast<uint8_t>(message_count & 0xFF);
+        bytes[2] = static_cast<uint8_t>((message_count >> 8) & 0xFF);
+    }
+
+    // A bundle holding one message is sent as that message, without the bundle framing
+    const uint8_t* getPacketData() const
+    {
+        return message_count == 1
+            ? bytes.data() + MESSAGE_BUNDLE_HEADER_BYTES + MESSAGE_BUNDLE_ENTRY_BYTES
+            : bytes.data();
+    }
+
+    std::size_t getPacketSize() const
+    {
+        return message_count == 1
+            ? bytes.size() - MESSAGE_BUNDLE_HEADER_BYTES - MESSAGE_BUNDLE_ENTRY_BYTES
+            : bytes.size();
+    }
+
+    void clear()
+    {
+        bytes.clear();
+        bytes.push_back(static_cast<uint8_t>(MessageType::MESSAGE_BUNDLE));
+        bytes.push_back(0);
+        bytes.push_back(0);
+        message_count = 0;
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+    std::size_t max_bytes = 0;
+    uint16_t message_count = 0;
+};
+
+// Calls visit(data, size) for every message in a MESSAGE_BUNDLE packet. Returns false,
+// without visiting anything, if the framing does not match the packet size.
+template<typename Visitor>
+bool forEachBundledMessage(const uint8_t* data, std::size_t size, Visitor&& visit)
+{
+    if (data == nullptr || size < MESSAGE_BUNDLE_HEADER_BYTES ||
+        data[0] != static_cast<uint8_t>(MessageType::MESSAGE_BUNDLE)) {
+        return false;
+    }
+
+    const uint16_t count = static_cast<uint16_t>(data[1] | (data[2] << 8));
+    std::size_t offset = MESSAGE_BUNDLE_HEADER_BYTES;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (offset + MESSAGE_BUNDLE_ENTRY_BYTES > size) {
+            return false;
+        }
+        const std::size_t length = static_cast<std::size_t>(data[offset] | (data[offset + 1] << 8));
+        offset += MESSAGE_BUNDLE_ENTRY_BYTES + length;
+        if (length == 0 || offset > size) {
+            return false;
+        }
+    }
+    if (offset != size) {
+        return false;
+    }
+
+    offset = MESSAGE_BUNDLE_HEADER_BYTES;
+    for (uint16_t i = 0; i < count; ++i) {
+        const std::size_t length = static_cast<std::size_t>(data[offset] | (data[offset + 1] << 8));
+        visit(data + offset + MESSAGE_BUNDLE_ENTRY_BYTES, length);
+        offset += MESSAGE_BUNDLE_ENTRY_BYTES + length;
+    }
+    return true;
+}
+
+} // namespace Net
@@ -8,7 +8,7 @@
 namespace Net {
 
 // Protocol version for compatibility checking
-constexpr uint32_t NETWORK_PROTOCOL_VERSION = 2;
+constexpr uint32_t NETWORK_PROTOCOL_VERSION = 4;
 constexpr uint16_t MAX_NETWORKED_ENTITIES = 2048;
 constexpr uint16_t MAX_SYNCED_CVARS = 1024;
 constexpr uint8_t CUSTOM_MESSAGE_START = 64;
@@ -32,6 +32,7 @@ enum class MessageType : uint8_t
     // Input & Simulation (Unreliable)
     INPUT_COMMAND = 10,       // Client -> Server
     WORLD_STATE_UPDATE = 11,  // Server -> Clients
+    MESSAGE_BUNDLE = 12,      // Server -> Client: one tick's queued messages for one channel
     // Debugging
     PING = 20,
     PONG = 21,
@@ -41,11 +42,11 @@ enum class MessageType : uint8_t
     CVAR_INITIAL_SYNC = 31    // Server -> Client: Batch of all replicated cvars on connect
 };
 
-// Network channels for ENet
+// Network channels (every transport provides all three)
 enum class NetworkChannel : uint8_t
 {
     RELIABLE_ORDERED = 0,      // Connection, spawns (reliable)
-    UNRELIABLE_SEQUENCED = 1,  // Input, state (unreliable, stale packets discarded by ENet)
+    UNRELIABLE_SEQUENCED = 1,  // Input, state (unreliable, stale packets discarded by the transport)
     UNRELIABLE_UNORDERED = 2   // Fire-and-forget custom messages
 };
 
@@ -80,7 +81,16 @@ namespace SnapshotFlags
     constexpr uint8_t NONE          = 0;
     constexpr uint8_t FULL          = 1 << 0;  // Snapshot is authoritative for all currently networked entities.
     constexpr uint8_t BASELINE_MISS = 1 << 1;  // Server could not find the client's acknowledged delta baseline.
-    constexpr uint8_t ALL_KNOWN     = FULL | BASELINE_MISS;
+    constexpr uint8_t PHYSICS_HASH  = 1 << 2;  // Server physics state hash for server_tick follows the header.
+    constexpr uint8_t ALL_KNOWN     = FULL | BASELINE_MISS | PHYSICS_HASH;
+}
+
+// Input command flags
+namespace InputCommandFlags
+{
+    constexpr uint8_t NONE          = 0;
+    constexpr uint8_t PHYSICS_HASH  = 1 << 0;  // Client physics state hash for physics_hash_tick follows the inputs.
+    constexpr uint8_t ALL_KNOWN     = PHYSICS_HASH;
 }
 
 // Message structures
@@ -146,6 +156,7 @@ struct InputCommandMessage
     MessageType type = MessageType::INPUT_COMMAND;
     uint32_t client_tick = 0;         // Latest tick in this packet
     uint32_t last_received_tick = 0;  // Acknowledge server tick
+    uint8_t flags = InputCommandFlags::NONE;
     uint8_t input_count = 1;          // Number of inputs (1-3 for redundancy)
     // Primary input (always present)
     uint8_t buttons = 0;
@@ -154,6 +165,10 @@ struct InputCommandMessage
     float move_forward = 0.0f;
     float move_right = 0.0f;
     // Redundant inputs stored separately during serialization
+    uint32_t physics_hash_tick = 0;   // If PHYSICS_HASH: server tick the client hash belongs to
+    uint64_t physics_hash = 0;        // If PHYSICS_HASH
+
+    bool hasPhysicsHash() const { return (flags & InputCommandFlags::PHYSICS_HASH) != 0; }
 };
 
 struct EntityUpdateData
@@ -184,9 +199,11 @@ struct WorldStateUpdateMessage
     uint8_t snapshot_flags = SnapshotFlags::NONE;
     uint16_t num_entities = 0;
     uint32_t last_processed_input_tick = 0; // Per-client: last input tick the server applied
+    uint64_t physics_hash = 0;              // If PHYSICS_HASH
     // EntityUpdateData entities[] follows in memory
 
     bool isFullSnapshot() const { return (snapshot_flags & SnapshotFlags::FULL) != 0; }
+    bool hasPhysicsHash() const { return (snapshot_flags & SnapshotFlags::PHYSICS_HASH) != 0; }
 };
 
 struct PingMessage
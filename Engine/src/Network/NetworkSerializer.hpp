@@ -34,6 +34,11 @@ namespace NetworkSerializer
         return (flags & ~SnapshotFlags::ALL_KNOWN) == 0;
     }
 
+    inline bool hasOnlyKnownInputCommandFlags(uint8_t flags)
+    {
+        return (flags & ~InputCommandFlags::ALL_KNOWN) == 0;
+    }
+
     inline bool tryGetMessageType(const uint8_t* data, size_t size, uint8_t& out_type)
     {
         if (data == nullptr || size < 1) {
@@ -149,6 +154,7 @@ namespace NetworkSerializer
         writer.writeByte(static_cast<uint8_t>(msg.type));
         writer.writeUInt32(msg.client_tick);
         writer.writeUInt32(msg.last_received_tick);
+        writer.writeByte(msg.flags);
         if (redundant_inputs == nullptr) {
             redundant_count = 0;
         }
@@ -169,6 +175,10 @@ namespace NetworkSerializer
             writer.writeFloat(redundant_inputs[i].move_forward);
             writer.writeFloat(redundant_inputs[i].move_right);
         }
+        if (msg.hasPhysicsHash()) {
+            writer.writeUInt32(msg.physics_hash_tick);
+            writer.writeUInt64(msg.physics_hash);
+        }
     }
 
     inline bool deserialize(BitReader& reader, InputCommandMessage& msg,
@@ -178,6 +188,8 @@ namespace NetworkSerializer
         if (msg.type != MessageType::INPUT_COMMAND) return false;
         msg.client_tick = reader.readUInt32();
         msg.last_received_tick = reader.readUInt32();
+        msg.flags = reader.readByte();
+        if (!hasOnlyKnownInputCommandFlags(msg.flags)) return false;
         msg.input_count = reader.readByte();
         if (msg.input_count == 0 || msg.input_count > MAX_INPUT_SAMPLES_PER_PACKET) return false;
         // Primary input
@@ -211,6 +223,10 @@ namespace NetworkSerializer
             }
             redundant_inputs.push_back(sample);
         }
+        if (msg.hasPhysicsHash()) {
+            msg.physics_hash_tick = reader.readUInt32();
+            msg.physics_hash = reader.readUInt64();
+        }
         return !reader.hasError();
     }
 
@@ -285,6 +301,9 @@ namespace NetworkSerializer
         writer.writeByte(msg.snapshot_flags);
         writer.writeUInt16(static_cast<uint16_t>(entities.size()));
         writer.writeUInt32(msg.last_processed_input_tick);
+        if (msg.hasPhysicsHash()) {
+            writer.writeUInt64(msg.physics_hash);
+        }
 
         // Serialize each entity
         for (const auto& entity : entities) {
@@ -305,6 +324,9 @@ namespace NetworkSerializer
         if (num_entities > MAX_NETWORKED_ENTITIES) return false;
         msg.num_entities = num_entities;
         msg.last_processed_input_tick = reader.readUInt32();
+        if (msg.hasPhysicsHash()) {
+            msg.physics_hash = reader.readUInt64();
+        }
 
         entities.clear();
         entities.reserve(num_entities);
@@ -356,11 +378,6 @@ namespace NetworkSerializer
         return type;
     }
 
-    // Helper: Create an ENet packet from serialized data
-    inline ENetPacket* createPacket(const BitWriter& writer, bool reliable) {
-        ENetPacketFlag flags = reliable ? ENET_PACKET_FLAG_RELIABLE : ENET_PACKET_FLAG_UNSEQUENCED;
-        return enet_packet_create(writer.getData(), writer.getByteSize(), flags);
-    }
     // Serialize CVarSyncMessage
     inline void serialize(BitWriter& writer, const CVarSyncMessage& msg) {
         writer.writeByte(static_cast<uint8_t>(msg.type));
@@ -3,8 +3,8 @@
 #include "BitStream.hpp"
 #include "NetworkProtocol.hpp"
 #include "NetworkTypes.hpp"
+#include "EngineExport.h"
 #include "Utils/Log.hpp"
-#include "enet.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -16,6 +16,9 @@ constexpr int NETWORK_SHUTDOWN_DRAIN_BUDGET_MS = 3000;
 constexpr std::size_t NETWORK_MAX_PACKET_BYTES = 128u * 1024u;
 constexpr uint32_t NETWORK_MAX_UNRELIABLE_QUEUE_BYTES = 128u * 1024u;
 constexpr uint32_t NETWORK_MAX_RELIABLE_QUEUE_BYTES = NETWORK_DEFAULT_SATURATED_QUEUE_BYTES;
+constexpr std::size_t NETWORK_MAX_RELIABLE_BUNDLE_BYTES = 16u * 1024u;
+// Below one datagram: ENet sends unreliable packets larger than the MTU as reliable fragments
+constexpr std::size_t NETWORK_MAX_UNRELIABLE_BUNDLE_BYTES = 1100u;
 
 enum class PacketReliability : uint8_t
 {
@@ -35,20 +38,6 @@ enum class PacketSendResult : uint8_t
     SendFailed
 };
 
-inline ENetPacketFlag getPacketFlags(PacketReliability reliability)
-{
-    switch (reliability) {
-        case PacketReliability::Reliable:
-            return ENET_PACKET_FLAG_RELIABLE;
-        case PacketReliability::UnreliableSequenced:
-            return static_cast<ENetPacketFlag>(0);
-        case PacketReliability::UnreliableUnordered:
-            return ENET_PACKET_FLAG_UNSEQUENCED;
-    }
-
-    return static_cast<ENetPacketFlag>(0);
-}
-
 inline NetworkChannel getPacketChannel(PacketReliability reliability)
 {
     switch (reliability) {
@@ -95,14 +84,6 @@ inline void recordDroppedOutgoingPacket(NetworkStats& stats, std::size_t byte_co
     stats.bytes_dropped_outgoing += byte_count;
 }
 
-inline bool isPeerConnectedForApplicationSend(const ENetPeer* peer)
-{
-    return peer != nullptr &&
-        (peer->state == ENET_PEER_STATE_CONNECTED ||
-         peer->state == ENET_PEER_STATE_DISCONNECT_LATER ||
-         peer->state == ENET_PEER_STATE_DISCONNECTING);
-}
-
 inline uint32_t getQueueLimitForReliability(PacketReliability reliability)
 {
     return reliability == PacketReliability::Reliable
@@ -110,18 +91,9 @@ inline uint32_t getQueueLimitForReliability(PacketReliability reliability)
         : NETWORK_MAX_UNRELIABLE_QUEUE_BYTES;
 }
 
-inline bool shouldDropForSaturation(const ENetPeer* peer, PacketReliability reliability)
-{
-    return isPeerSendQueueSaturated(peer, getQueueLimitForReliability(reliability));
-}
-
-inline PacketSendResult sendPacketToPeer(ENetPeer* peer, const BitWriter& writer, PacketReliability reliability)
+// Payload checks shared by every transport; connection state and queue saturation are theirs
+inline PacketSendResult validatePacketPayload(std::size_t byte_size, PacketReliability reliability)
 {
-    if (!isPeerConnectedForApplicationSend(peer)) {
-        return PacketSendResult::InvalidPeer;
-    }
-
-    const std::size_t byte_size = writer.getByteSize();
     if (byte_size == 0) {
         return PacketSendResult::EmptyPayload;
     }
@@ -134,32 +106,18 @@ inline PacketSendResult sendPacketToPeer(ENetPeer* peer, const BitWriter& writer
         return PacketSendResult::OversizedPayload;
     }
 
-    if (shouldDropForSaturation(peer, reliability)) {
+    return PacketSendResult::Sent;
+}
+
+inline PacketSendResult validateSendQueue(uint32_t queued_bytes, PacketReliability reliability)
+{
+    if (queued_bytes >= getQueueLimitForReliability(reliability)) {
         LOG_ENGINE_WARN("Dropping {0} message because peer send queue is saturated ({1} bytes queued)",
                         getPacketReliabilityName(reliability),
-                        peer->outgoingDataTotal);
+                        queued_bytes);
         return PacketSendResult::Saturated;
     }
 
-    ENetPacket* packet = enet_packet_create(
-        writer.getData(),
-        byte_size,
-        getPacketFlags(reliability)
-    );
-
-    if (packet == nullptr) {
-        LOG_ENGINE_WARN("enet_packet_create failed for {0} message", getPacketReliabilityName(reliability));
-        return PacketSendResult::CreateFailed;
-    }
-
-    const uint8_t channel = static_cast<uint8_t>(getPacketChannel(reliability));
-    if (enet_peer_send(peer, channel, packet) < 0) {
-        LOG_ENGINE_WARN("enet_peer_send failed for {0} message; destroying unqueued packet",
-                        getPacketReliabilityName(reliability));
-        enet_packet_destroy(packet);
-        return PacketSendResult::SendFailed;
-    }
-
     return PacketSendResult::Sent;
 }
 
@@ -168,11 +126,109 @@ inline bool packetSendSucceeded(PacketSendResult result)
     return result == PacketSendResult::Sent;
 }
 
-inline void destroyReceivedPacket(ENetEvent& event)
+enum class TransportEventType : uint8_t
+{
+    None,
+    Connect,
+    Receive,
+    Disconnect  // Graceful or timed out
+};
+
+struct TransportEvent
+{
+    TransportEventType type = TransportEventType::None;
+    TransportPeerId peer = INVALID_TRANSPORT_PEER;
+    const uint8_t* data = nullptr;  // Receive only; owned by the transport until the next poll()
+    std::size_t size = 0;
+};
+
+// Link quality as the transport sees it, folded into NetworkStats once per update
+struct TransportPeerStats
+{
+    float rtt_ms = 0.0f;
+    float rtt_variance_ms = 0.0f;
+    float packet_loss_percent = 0.0f;
+    float packet_loss_variance_percent = 0.0f;
+    uint32_t outgoing_queue_bytes = 0;
+    float time_since_last_receive_seconds = 0.0f;
+    float timeout_seconds = 0.0f;  // 0 = the transport never times out
+};
+
+// Moves packets between a server and its clients. An instance is either a listening server
+// or a client with one connection. Peer handles only mean something to the transport that
+// issued them; a disconnected peer's handle may be reused by a later connection.
+class ENGINE_API INetworkTransport
+{
+public:
+    virtual ~INetworkTransport() = default;
+
+    virtual const char* getName() const = 0;
+
+    virtual bool listen(uint16_t port, uint32_t max_peers) = 0;
+    virtual TransportPeerId connect(const char* address, uint16_t port) = 0;
+    // Disconnects every peer, drains outgoing traffic within a bounded budget and releases the endpoint
+    virtual void close(const char* owner_name) = 0;
+    virtual bool isOpen() const = 0;
+
+    // Non-blocking; returns false once no event is ready
+    virtual bool poll(TransportEvent& out_event) = 0;
+    virtual PacketSendResult send(TransportPeerId peer,
+                                  const uint8_t* data,
+                                  std::size_t size,
+                                  PacketReliability reliability) = 0;
+    // One payload for several peers; the transport may share one packet between them.
+    // out_results receives one result per peer.
+    virtual void sendToPeers(const TransportPeerId* peers,
+                             std::size_t peer_count,
+                             const uint8_t* data,
+                             std::size_t size,
+                             PacketReliability reliability,
+                             PacketSendResult* out_results) = 0;
+    virtual void flush() = 0;
+
+    // disconnect may discard sends still queued for the peer; disconnectLater delivers them first
+    virtual void disconnect(TransportPeerId peer) = 0;
+    virtual void disconnectLater(TransportPeerId peer) = 0;
+    virtual bool isPeerConnected(TransportPeerId peer) const = 0;
+    virtual bool getPeerStats(TransportPeerId peer, TransportPeerStats& out_stats) const = 0;
+};
+
+inline PacketSendResult sendPacketToPeer(INetworkTransport* transport,
+                                         TransportPeerId peer,
+                                         const BitWriter& writer,
+                                         PacketReliability reliability)
+{
+    if (transport == nullptr) {
+        return PacketSendResult::InvalidPeer;
+    }
+    return transport->send(peer, writer.getData(), writer.getByteSize(), reliability);
+}
+
+inline void updateStatsFromTransport(NetworkStats& stats, const TransportPeerStats* peer_stats)
 {
-    if (event.type == ENET_EVENT_TYPE_RECEIVE && event.packet != nullptr) {
-        enet_packet_destroy(event.packet);
-        event.packet = nullptr;
+    if (peer_stats == nullptr) {
+        stats.trouble = NetworkConnectionTrouble::None;
+        stats.time_since_last_receive_seconds = 0.0f;
+        stats.outgoing_queue_bytes = 0;
+        return;
+    }
+
+    stats.rtt_ms = peer_stats->rtt_ms;
+    stats.ping_ms = stats.rtt_ms;
+    stats.jitter_ms = peer_stats->rtt_variance_ms;
+    stats.packet_loss_percent = peer_stats->packet_loss_percent;
+    stats.packet_loss_variance_percent = peer_stats->packet_loss_variance_percent;
+    stats.outgoing_queue_bytes = peer_stats->outgoing_queue_bytes;
+    stats.time_since_last_receive_seconds = peer_stats->time_since_last_receive_seconds;
+
+    stats.trouble = NetworkConnectionTrouble::None;
+    if (peer_stats->outgoing_queue_bytes >= NETWORK_DEFAULT_SATURATED_QUEUE_BYTES) {
+        stats.trouble = NetworkConnectionTrouble::Saturated;
+    } else if (peer_stats->timeout_seconds > 0.0f &&
+               stats.time_since_last_receive_seconds > peer_stats->timeout_seconds * 0.5f) {
+        stats.trouble = NetworkConnectionTrouble::Timeout;
+    } else if (stats.packet_loss_percent > 0.0f) {
+        stats.trouble = NetworkConnectionTrouble::Loss;
     }
 }
 
@@ -184,7 +240,7 @@ public:
     {
     }
 
-    bool shouldProcess(ENetEvent& event)
+    bool shouldProcess()
     {
         if (++event_count <= NETWORK_MAX_EVENTS_PER_TICK) {
             return true;
@@ -193,7 +249,6 @@ public:
         LOG_ENGINE_WARN("{0} event loop hit cap ({1}) - possible flood",
                         owner,
                         NETWORK_MAX_EVENTS_PER_TICK);
-        destroyReceivedPacket(event);
         return false;
     }
 
@@ -202,34 +257,4 @@ private:
     int event_count = 0;
 };
 
-inline void drainHostForShutdown(ENetHost* host, const char* owner_name)
-{
-    if (host == nullptr) {
-        return;
-    }
-
-    ENetEvent event;
-    const enet_uint32 drain_start = enet_time_get();
-    int drained = 0;
-
-    while (enet_host_service(host, &event, 100) > 0) {
-        destroyReceivedPacket(event);
-
-        if (++drained >= NETWORK_MAX_EVENTS_PER_TICK) {
-            LOG_ENGINE_WARN("{0} shutdown drain hit event cap ({1}); breaking",
-                            owner_name,
-                            NETWORK_MAX_EVENTS_PER_TICK);
-            break;
-        }
-
-        const enet_uint32 elapsed_ms = ENET_TIME_DIFFERENCE(enet_time_get(), drain_start);
-        if (elapsed_ms >= NETWORK_SHUTDOWN_DRAIN_BUDGET_MS) {
-            LOG_ENGINE_WARN("{0} shutdown drain hit time budget ({1}ms); breaking",
-                            owner_name,
-                            NETWORK_SHUTDOWN_DRAIN_BUDGET_MS);
-            break;
-        }
-    }
-}
-
 } // namespace Net
@@ -7,7 +7,6 @@
 #include <string>
 #include <unordered_map>
 #include <glm/glm.hpp>
-#include "enet.h"
 
 namespace Net {
 
@@ -195,51 +194,11 @@ struct NetworkStatsRateSampler
     }
 };
 
-inline float enetPacketLossToPercent(uint32_t packet_loss)
-{
-    return static_cast<float>(packet_loss) * 100.0f / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
-}
-
 constexpr uint32_t NETWORK_DEFAULT_SATURATED_QUEUE_BYTES = 512u * 1024u;
 
-inline bool isPeerSendQueueSaturated(
-    const ENetPeer* peer,
-    uint32_t queued_byte_limit = NETWORK_DEFAULT_SATURATED_QUEUE_BYTES)
-{
-    return peer != nullptr && peer->outgoingDataTotal >= queued_byte_limit;
-}
-
-inline void updateStatsFromPeer(NetworkStats& stats, const ENetPeer* peer, const ENetHost* host)
-{
-    if (peer == nullptr) {
-        stats.trouble = NetworkConnectionTrouble::None;
-        stats.time_since_last_receive_seconds = 0.0f;
-        stats.outgoing_queue_bytes = 0;
-        return;
-    }
-
-    stats.rtt_ms = static_cast<float>(peer->roundTripTime);
-    stats.ping_ms = stats.rtt_ms;
-    stats.jitter_ms = static_cast<float>(peer->roundTripTimeVariance);
-    stats.packet_loss_percent = enetPacketLossToPercent(peer->packetLoss);
-    stats.packet_loss_variance_percent = enetPacketLossToPercent(peer->packetLossVariance);
-    stats.outgoing_queue_bytes = peer->outgoingDataTotal;
-
-    if (host != nullptr && peer->lastReceiveTime > 0) {
-        stats.time_since_last_receive_seconds =
-            static_cast<float>(host->serviceTime - peer->lastReceiveTime) / 1000.0f;
-    }
-
-    stats.trouble = NetworkConnectionTrouble::None;
-    const float timeout_seconds = static_cast<float>(peer->timeoutMaximum) / 1000.0f;
-    if (isPeerSendQueueSaturated(peer)) {
-        stats.trouble = NetworkConnectionTrouble::Saturated;
-    } else if (timeout_seconds > 0.0f && stats.time_since_last_receive_seconds > timeout_seconds * 0.5f) {
-        stats.trouble = NetworkConnectionTrouble::Timeout;
-    } else if (stats.packet_loss_percent > 0.0f) {
-        stats.trouble = NetworkConnectionTrouble::Loss;
-    }
-}
+// Opaque connection handle issued by an INetworkTransport; 0 is never a valid peer
+using TransportPeerId = uint32_t;
+constexpr TransportPeerId INVALID_TRANSPORT_PEER = 0;
 
 // Client information (server-side tracking)
 struct ClientInfo
@@ -247,16 +206,17 @@ struct ClientInfo
     uint16_t client_id = 0;
     uint32_t player_entity_network_id = 0;  // Network ID of the player entity
     std::string player_name;
-    ENetPeer* peer = nullptr;
+    TransportPeerId peer = INVALID_TRANSPORT_PEER;
     uint32_t last_acknowledged_tick = 0;  // Last tick the client acknowledged
-    uint32_t last_input_tick = 0;         // Last tick we received input from client
+    uint32_t last_input_tick = 0;         // Last tick we received input from client (ordering/duplicates)
+    uint32_t last_applied_input_tick = 0; // Last input tick simulated; acknowledged in world state
     uint32_t last_input_budget_server_tick = 0;
     uint32_t input_tick_budget = 3;
     float ping_ms = 0.0f;
     NetworkStats stats;
 
     ClientInfo() = default;
-    ClientInfo(uint16_t id, const std::string& name, ENetPeer* p)
+    ClientInfo(uint16_t id, const std::string& name, TransportPeerId p)
         : client_id(id), player_name(name), peer(p) {}
 };
 
@@ -1,16 +1,19 @@
 #include "ServerNetworkManager.hpp"
 #include "NetworkRuntime.hpp"
 #include "NetworkTransport.hpp"
+#include "ENetTransport.hpp"
+#include "LocalTransport.hpp"
+#include "CompositeTransport.hpp"
 #include "NetworkInput.hpp"
 #include "world.hpp"
 #include "Components/Components.hpp"
 #include "SharedMovement.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "Console/ConVar.hpp"
 #include "Console/Console.hpp"
 #include <entt/entt.hpp>
 #include <cstring>
-#include <cerrno>
 #include <cmath>
 #include <algorithm>
 #include <glm/glm.hpp>
@@ -41,11 +44,6 @@ namespace {
     }
 }
 
-#ifdef _WIN32
-  #include <winsock2.h>
-  #include <ws2tcpip.h>
-#endif
-
 namespace Net {
 
 ServerNetworkManager::ServerNetworkManager()
@@ -75,102 +73,49 @@ bool ServerNetworkManager::initialize()
 
 bool ServerNetworkManager::startServer(uint16_t port, uint32_t max_clients)
 {
-    if (server_host != nullptr) {
-        LOG_ENGINE_WARN("Server already started");
-        return false;
+    if (!getBoolCVarOrDefault("net_local_transport", true)) {
+        return startServer(std::make_unique<ENetTransport>(), port, max_clients);
     }
 
-    ENetAddress address = {};
-    address.host = ENET_HOST_ANY;
-    address.port = port;
-    address.sin6_scope_id = 0;
-
-#ifdef _WIN32
-    // Pre-flight UDP bind probes. ENet6 creates an AF_INET6 dual-stack socket,
-    // so we test both families to locate the failure.
-    {
-        // IPv4 probe
-        SOCKET probe4 = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-        if (probe4 == INVALID_SOCKET) {
-            LOG_ENGINE_ERROR("IPv4 probe socket() failed: WSA {}", WSAGetLastError());
-        } else {
-            sockaddr_in sa{};
-            sa.sin_family = AF_INET;
-            sa.sin_port = htons(port);
-            sa.sin_addr.s_addr = INADDR_ANY;
-            if (::bind(probe4, (sockaddr*)&sa, sizeof(sa)) == SOCKET_ERROR) {
-                LOG_ENGINE_ERROR("IPv4 probe bind port {} failed: WSA {}", port, WSAGetLastError());
-            } else {
-                LOG_ENGINE_INFO("IPv4 probe bind port {} OK", port);
-            }
-            ::closesocket(probe4);
-        }
+    auto composite = std::make_unique<CompositeTransport>();
+    composite->addTransport(std::make_unique<ENetTransport>());
+    composite->addTransport(std::make_unique<LocalTransport>());
+    return startServer(std::move(composite), port, max_clients);
+}
 
-        // IPv6 probe (what ENet actually does)
-        SOCKET probe6 = ::socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
-        if (probe6 == INVALID_SOCKET) {
-            LOG_ENGINE_ERROR("IPv6 probe socket() failed: WSA {} (IPv6 stack disabled?)", WSAGetLastError());
-        } else {
-            DWORD v6only = 0;
-            if (::setsockopt(probe6, IPPROTO_IPV6, IPV6_V6ONLY, (const char*)&v6only, sizeof(v6only)) == SOCKET_ERROR) {
-                LOG_ENGINE_ERROR("IPv6 probe IPV6_V6ONLY=0 failed: WSA {}", WSAGetLastError());
-            }
-            sockaddr_in6 sa6{};
-            sa6.sin6_family = AF_INET6;
-            sa6.sin6_port = htons(port);
-            sa6.sin6_addr = in6addr_any;
-            if (::bind(probe6, (sockaddr*)&sa6, sizeof(sa6)) == SOCKET_ERROR) {
-                LOG_ENGINE_ERROR("IPv6 probe bind port {} failed: WSA {}", port, WSAGetLastError());
-            } else {
-                LOG_ENGINE_INFO("IPv6 probe bind port {} OK", port);
-            }
-            ::closesocket(probe6);
-        }
+bool ServerNetworkManager::startServer(std::unique_ptr<INetworkTransport> server_transport,
+                                       uint16_t port,
+                                       uint32_t max_clients)
+{
+    if (transport != nullptr) {
+        LOG_ENGINE_WARN("Server already started");
+        return false;
     }
-#endif
-
-    // Create server with reliable, sequenced unreliable, and unordered unreliable channels.
-    server_host = enet_host_create(&address, max_clients, NETWORK_CHANNEL_COUNT, 0, 0);
-
-    if (server_host == nullptr) {
-#ifdef _WIN32
-        int err = WSAGetLastError();
-        const char* hint = "";
-        if (err == WSAEADDRINUSE)      hint = " (port already in use - another server running?)";
-        else if (err == WSAEACCES)     hint = " (permission denied - port in Windows reserved range?)";
-        LOG_ENGINE_ERROR("Failed to create ENet server host on UDP port {} (WSA error {}){}",
-                         port, err, hint);
-#else
-        int err = errno;
-        LOG_ENGINE_ERROR("Failed to create ENet server host on UDP port {} (errno {}: {})",
-                         port, err, std::strerror(err));
-#endif
+
+    if (server_transport == nullptr || !server_transport->listen(port, max_clients)) {
         return false;
     }
 
-    LOG_ENGINE_INFO("Server started on port {0}, max clients: {1}", port, max_clients);
+    transport = std::move(server_transport);
+    max_client_count = max_clients;
+    LOG_ENGINE_INFO("Server started on port {0} ({1} transport), max clients: {2}",
+                    port, transport->getName(), max_clients);
     return true;
 }
 
 void ServerNetworkManager::shutdown()
 {
-    if (server_host != nullptr) {
-        // Disconnect all clients
-        for (auto& [client_id, connection] : clients) {
-            if (connection.info.peer != nullptr) {
-                enet_peer_disconnect(connection.info.peer, 0);
-            }
-        }
-
-        // Give time for disconnect messages to send (bounded drain)
-        drainHostForShutdown(server_host, "Server");
+    if (transport != nullptr) {
+        flushOutgoingMessages();
 
-        enet_host_destroy(server_host);
-        server_host = nullptr;
+        // Disconnect all clients and give time for disconnect messages to send (bounded drain)
+        transport->close("Server");
+        transport.reset();
     }
 
     clients.clear();
     peer_to_client_id.clear();
+    max_client_count = 0;
     entity_to_net_id.clear();
     net_id_to_entity.clear();
     current_tick = 0;
@@ -198,45 +143,44 @@ void ServerNetworkManager::update(float delta_time)
 
 void ServerNetworkManager::pumpNetworkEvents(float delta_time)
 {
-    if (server_host == nullptr || game_world == nullptr) {
+    MemoryTagScope memory_tag(MemoryTag::Network);
+    if (transport == nullptr || game_world == nullptr) {
         return;
     }
 
+    syncPhysicsHashing();
+    syncPhysicsLod();
+    syncInputBuffering();
+    syncMessageBundling();
+
     // Process network events (bounded to prevent flood-induced stalls)
-    ENetEvent event;
+    TransportEvent event;
     NetworkEventBudget event_budget("Server");
-    while (enet_host_service(server_host, &event, 0) > 0) {
-        if (!event_budget.shouldProcess(event)) {
+    while (transport->poll(event)) {
+        if (!event_budget.shouldProcess()) {
             break;
         }
         switch (event.type) {
-            case ENET_EVENT_TYPE_CONNECT:
+            case TransportEventType::Connect:
                 handleClientConnect(event);
                 break;
 
-            case ENET_EVENT_TYPE_RECEIVE: {
-                size_t packet_size = event.packet->dataLength;
+            case TransportEventType::Receive: {
                 handleClientMessage(event);
-                enet_packet_destroy(event.packet);
                 stats.packets_received++;
-                stats.bytes_received += packet_size;
-                auto peer_it = peer_to_client_id.find(event.peer);
-                if (peer_it != peer_to_client_id.end()) {
-                    auto client_it = clients.find(peer_it->second);
-                    if (client_it != clients.end()) {
-                        client_it->second.info.stats.packets_received++;
-                        client_it->second.info.stats.bytes_received += packet_size;
-                    }
+                stats.bytes_received += event.size;
+                if (ClientConnection* connection = findConnection(event.peer)) {
+                    connection->info.stats.packets_received++;
+                    connection->info.stats.bytes_received += event.size;
                 }
                 break;
             }
 
-            case ENET_EVENT_TYPE_DISCONNECT:
-            case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT:
+            case TransportEventType::Disconnect:
                 handleClientDisconnect(event);
                 break;
 
-            case ENET_EVENT_TYPE_NONE:
+            case TransportEventType::None:
                 break;
         }
     }
@@ -250,15 +194,24 @@ void ServerNetworkManager::advanceSimulationTicks(uint32_t tick_count)
         return;
     }
 
-    current_tick += tick_count;
+    for (uint32_t i = 0; i < tick_count; ++i) {
+        ++current_tick;
+        if (input_buffering && game_world != nullptr) {
+            playBufferedInputs();
+        }
+    }
 }
 
 void ServerNetworkManager::publishWorldState()
 {
-    if (server_host == nullptr || game_world == nullptr) {
+    MemoryTagScope memory_tag(MemoryTag::Network);
+    if (transport == nullptr || game_world == nullptr) {
         return;
     }
 
+    // Attachments moved by game code after the physics step replicate this tick
+    game_world->propagateTransforms();
+
     const float max_unlag_seconds = getFloatCVarOrDefault("sv_maxunlag", 1.0f);
     const float fixed_delta = game_world->fixed_delta > 0.0f ? game_world->fixed_delta : (1.0f / 60.0f);
     const size_t max_lag_records = static_cast<size_t>((std::max)(2.0f, std::ceil(max_unlag_seconds / fixed_delta) + 2.0f));
@@ -277,11 +230,15 @@ void ServerNetworkManager::publishWorldState()
     }
     if (state_update_counter >= 3) {
         state_update_counter %= 3;
+        // Spawns, despawns and events bundled this tick go out ahead of the world state
+        // that may already reference them
+        flushOutgoingMessages();
         broadcastWorldState();
     }
 
-    // Flush all queued packets at end of update
-    enet_host_flush(server_host);
+    // Flush this tick's message bundles and all queued packets at end of update
+    flushOutgoingMessages();
+    transport->flush();
 }
 
 void ServerNetworkManager::refreshStats(float delta_time)
@@ -291,11 +248,13 @@ void ServerNetworkManager::refreshStats(float delta_time)
     size_t peer_count = 0;
 
     for (auto& [_, connection] : clients) {
-        updateStatsFromPeer(connection.info.stats, connection.info.peer, server_host);
+        TransportPeerStats peer_stats;
+        const bool has_peer_stats = transport != nullptr && transport->getPeerStats(connection.info.peer, peer_stats);
+        updateStatsFromTransport(connection.info.stats, has_peer_stats ? &peer_stats : nullptr);
         connection.stats_sampler.update(connection.info.stats, delta_time);
         connection.info.ping_ms = connection.info.stats.ping_ms;
 
-        if (connection.info.peer != nullptr) {
+        if (connection.info.peer != INVALID_TRANSPORT_PEER) {
             ping_sum += connection.info.stats.ping_ms;
             loss_sum += connection.info.stats.packet_loss_percent;
             peer_count++;
@@ -310,15 +269,15 @@ void ServerNetworkManager::refreshStats(float delta_time)
     stats_sampler.update(stats, delta_time);
 }
 
-void ServerNetworkManager::handleClientConnect(ENetEvent& event)
+void ServerNetworkManager::handleClientConnect(const TransportEvent& event)
 {
-    LOG_ENGINE_INFO("Client connecting (port: {0})", event.peer->address.port);
+    LOG_ENGINE_INFO("Client connecting (peer {0})", event.peer);
 
     // Wait for ConnectRequestMessage - don't assign client ID yet
     // The actual connection will be finalized when we receive CONNECT_REQUEST
 }
 
-void ServerNetworkManager::handleClientDisconnect(ENetEvent& event)
+void ServerNetworkManager::handleClientDisconnect(const TransportEvent& event)
 {
     auto it = peer_to_client_id.find(event.peer);
     if (it != peer_to_client_id.end()) {
@@ -338,33 +297,31 @@ void ServerNetworkManager::handleClientDisconnect(ENetEvent& event)
     }
 }
 
-void ServerNetworkManager::handleClientMessage(ENetEvent& event)
+void ServerNetworkManager::handleClientMessage(const TransportEvent& event)
 {
-    if (event.packet == nullptr ||
-        event.packet->data == nullptr ||
-        event.packet->dataLength == 0 ||
-        event.packet->dataLength > NETWORK_MAX_PACKET_BYTES) {
-        const size_t packet_size = event.packet ? event.packet->dataLength : 0;
-        LOG_ENGINE_WARN("Dropping invalid client packet ({} bytes)", packet_size);
-        recordDroppedFromPeer(event.peer, packet_size);
+    if (event.data == nullptr ||
+        event.size == 0 ||
+        event.size > NETWORK_MAX_PACKET_BYTES) {
+        LOG_ENGINE_WARN("Dropping invalid client packet ({} bytes)", event.size);
+        recordDroppedFromPeer(event.peer, event.size);
         return;
     }
 
     uint8_t msg_type = 0;
-    if (!NetworkSerializer::tryGetMessageType(event.packet->data, event.packet->dataLength, msg_type)) {
+    if (!NetworkSerializer::tryGetMessageType(event.data, event.size, msg_type)) {
         LOG_ENGINE_WARN("Dropping client packet without message type");
-        recordDroppedFromPeer(event.peer, event.packet->dataLength);
+        recordDroppedFromPeer(event.peer, event.size);
         return;
     }
 
     if (!shouldAcceptClientMessage(event.peer, msg_type)) {
         LOG_ENGINE_WARN("Dropping client message type {} before/after invalid connection state",
                         static_cast<int>(msg_type));
-        recordDroppedFromPeer(event.peer, event.packet->dataLength);
+        recordDroppedFromPeer(event.peer, event.size);
         return;
     }
 
-    BitReader reader(event.packet->data, event.packet->dataLength);
+    BitReader reader(event.data, event.size);
 
     switch (static_cast<MessageType>(msg_type)) {
         case MessageType::CONNECT_REQUEST:
@@ -403,7 +360,7 @@ void ServerNetworkManager::handleClientMessage(ENetEvent& event)
     }
 }
 
-void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reader)
+void ServerNetworkManager::handleConnectRequest(TransportPeerId peer, BitReader& reader)
 {
     if (peer_to_client_id.find(peer) != peer_to_client_id.end()) {
         LOG_ENGINE_WARN("Ignoring duplicate CONNECT_REQUEST from authenticated peer");
@@ -413,7 +370,7 @@ void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reade
     ConnectRequestMessage msg;
     if (!NetworkSerializer::deserialize(reader, msg)) {
         LOG_ENGINE_WARN("Failed to deserialize CONNECT_REQUEST from peer");
-        enet_peer_disconnect_later(peer, 0);
+        transport->disconnectLater(peer);
         return;
     }
 
@@ -429,14 +386,16 @@ void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reade
         NetworkSerializer::serialize(writer, reject);
         sendReliableMessage(peer, writer);
 
-        enet_peer_disconnect_later(peer, 0);
+        transport->disconnectLater(peer);
         return;
     }
 
-    // Assign client ID (skip any that collide after uint16_t wrap)
+    // Assign client ID (skip any that collide after uint16_t wrap). Transports cap their own
+    // peers; a server listening on several of them also caps the total here.
     uint16_t client_id = 0;
     bool id_assigned = false;
-    for (size_t attempts = 0; attempts < 65536; ++attempts) {
+    const bool server_full = max_client_count > 0 && clients.size() >= max_client_count;
+    for (size_t attempts = 0; attempts < 65536 && !server_full; ++attempts) {
         client_id = next_client_id++;
         if (clients.find(client_id) == clients.end()) {
             id_assigned = true;
@@ -444,7 +403,7 @@ void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reade
         }
     }
     if (!id_assigned) {
-        LOG_ENGINE_ERROR("Server full: no free client_id slots; rejecting connection");
+        LOG_ENGINE_ERROR("Server full: no free client slots; rejecting connection");
         ConnectRejectMessage reject;
         reject.type = MessageType::CONNECT_REJECT;
         std::strncpy(reject.reason, "Server full", 63);
@@ -452,7 +411,7 @@ void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reade
         BitWriter writer;
         NetworkSerializer::serialize(writer, reject);
         sendReliableMessage(peer, writer);
-        enet_peer_disconnect_later(peer, 0);
+        transport->disconnectLater(peer);
         return;
     }
     peer_to_client_id[peer] = client_id;
@@ -460,6 +419,7 @@ void ServerNetworkManager::handleConnectRequest(ENetPeer* peer, BitReader& reade
     // Create client info
     ClientInfo info(client_id, msg.player_name, peer);
     ClientConnection connection(info);
+    connection.input_buffer.setSettings(input_buffer_settings);
     clients[client_id] = connection;
 
     LOG_ENGINE_INFO("Client {0} connected: {1}", client_id, msg.player_name);
@@ -501,41 +461,23 @@ void ServerNetworkManager::handleInputCommand(uint16_t client_id, BitReader& rea
         it->second.acknowledgeSnapshot(msg.last_received_tick);
     }
 
-    // Get player entity for this client
-    uint32_t player_net_id = it->second.info.player_entity_network_id;
-    if (player_net_id == 0) {
-        return;  // Player not spawned yet
-    }
-
-    entt::entity player_entity = getEntityByNetworkId(player_net_id);
-    if (!game_world->registry.valid(player_entity)) {
-        return;
-    }
+    comparePhysicsHash(client_id, it->second, msg);
 
-    // Get required components
-    if (!game_world->registry.all_of<PlayerComponent, TransformComponent, RigidBodyComponent>(player_entity)) {
+    entt::entity player_entity = resolveInputPlayer(client_id, it->second);
+    if (player_entity == entt::null) {
         return;
     }
 
-    if (input_filter && !input_filter(client_id, player_entity)) {
-        return;
-    }
-
-    auto& player = game_world->registry.get<PlayerComponent>(player_entity);
-    auto& transform = game_world->registry.get<TransformComponent>(player_entity);
-    auto& rigidbody = game_world->registry.get<RigidBodyComponent>(player_entity);
-
-    MovementConfig movement_config;
-    movement_config.speed = player.speed;
-    movement_config.jump_force = player.jump_force;
-    movement_config.fixed_delta = game_world->fixed_delta;
-
     const auto samples = collectInputSamplesChronological(msg, redundant_inputs);
     accrueInputTickBudget(
         current_tick,
         it->second.info.last_input_budget_server_tick,
         it->second.info.input_tick_budget);
 
+    if (input_buffering) {
+        it->second.input_buffer.recordArrival(msg.client_tick, current_tick);
+    }
+
     for (const auto& sample : samples) {
         if (!isValidInputSample(sample)) {
             LOG_ENGINE_WARN("Client {0} sent invalid input sample at tick {1}", client_id, sample.tick);
@@ -552,43 +494,109 @@ void ServerNetworkManager::handleInputCommand(uint16_t client_id, BitReader& rea
             break;
         }
 
-        transform.rotation.y = sample.camera_yaw;
-        transform.rotation.x = sample.camera_pitch;
-
-        MovementInput move_input;
-        move_input.move_forward = sample.move_forward;
-        move_input.move_right = sample.move_right;
-        move_input.camera_yaw = sample.camera_yaw;
-        move_input.camera_pitch = sample.camera_pitch;
-        move_input.buttons = sample.buttons;
-
-        MovementState move_state;
-        move_state.position = transform.position;
-        move_state.velocity = rigidbody.velocity;
-        move_state.grounded = player.grounded;
-        move_state.ground_normal = player.ground_normal;
-
-        MovementState result;
-        if (game_world->registry.all_of<CharacterControllerComponent>(player_entity)) {
-            CharacterControllerState controller_state = game_world->simulate_character_controller(
-                player_entity, toCharacterMoveInput(move_input), movement_config.fixed_delta);
-            result.position = controller_state.position;
-            result.velocity = controller_state.velocity;
-            result.grounded = controller_state.grounded;
-            result.ground_normal = controller_state.ground_normal;
+        it->second.info.last_input_tick = sample.tick;
+
+        if (input_buffering) {
+            it->second.input_buffer.push(sample, msg.last_received_tick);
         } else {
-            result = SharedMovement::simulate(move_input, move_state, movement_config);
+            applyInputSample(client_id, player_entity, sample, msg.last_received_tick);
         }
-        transform.position = result.position;
-        rigidbody.velocity = result.velocity;
-        player.grounded = result.grounded;
-        player.ground_normal = result.ground_normal;
+    }
+}
 
-        it->second.info.last_input_tick = sample.tick;
+entt::entity ServerNetworkManager::resolveInputPlayer(uint16_t client_id, const ClientConnection& connection)
+{
+    uint32_t player_net_id = connection.info.player_entity_network_id;
+    if (player_net_id == 0) {
+        return entt::null;  // Player not spawned yet
+    }
+
+    entt::entity player_entity = getEntityByNetworkId(player_net_id);
+    if (!game_world->registry.valid(player_entity)) {
+        return entt::null;
+    }
+
+    if (!game_world->registry.all_of<PlayerComponent, TransformComponent, RigidBodyComponent>(player_entity)) {
+        return entt::null;
+    }
+
+    if (input_filter && !input_filter(client_id, player_entity)) {
+        return entt::null;
+    }
+
+    return player_entity;
+}
+
+void ServerNetworkManager::applyInputSample(uint16_t client_id, entt::entity player_entity, const InputSample& sample,
+                                            uint32_t acknowledged_server_tick, bool notify)
+{
+    auto& player = game_world->registry.get<PlayerComponent>(player_entity);
+    auto& transform = game_world->registry.get<TransformComponent>(player_entity);
+    auto& rigidbody = game_world->registry.get<RigidBodyComponent>(player_entity);
+
+    MovementConfig movement_config;
+    movement_config.speed = player.speed;
+    movement_config.jump_force = player.jump_force;
+    movement_config.fixed_delta = game_world->fixed_delta;
+
+    transform.rotation.y = sample.camera_yaw;
+    transform.rotation.x = sample.camera_pitch;
+
+    MovementInput move_input;
+    move_input.move_forward = sample.move_forward;
+    move_input.move_right = sample.move_right;
+    move_input.camera_yaw = sample.camera_yaw;
+    move_input.camera_pitch = sample.camera_pitch;
+    move_input.buttons = sample.buttons;
+
+    MovementState move_state;
+    move_state.position = transform.position;
+    move_state.velocity = rigidbody.velocity;
+    move_state.grounded = player.grounded;
+    move_state.ground_normal = player.ground_normal;
+
+    MovementState result;
+    if (game_world->registry.all_of<CharacterControllerComponent>(player_entity)) {
+        CharacterControllerState controller_state = game_world->simulate_character_controller(
+            player_entity, toCharacterMoveInput(move_input), movement_config.fixed_delta);
+        result.position = controller_state.position;
+        result.velocity = controller_state.velocity;
+        result.grounded = controller_state.grounded;
+        result.ground_normal = controller_state.ground_normal;
+    } else {
+        result = SharedMovement::simulate(move_input, move_state, movement_config);
+    }
+    transform.position = result.position;
+    rigidbody.velocity = result.velocity;
+    player.grounded = result.grounded;
+    player.ground_normal = result.ground_normal;
+
+    // Buffered inputs are received ticks before they run; only what ran is acknowledged
+    auto connection = clients.find(client_id);
+    if (connection != clients.end()) {
+        connection->second.info.last_applied_input_tick = sample.tick;
+    }
+
+    if (notify && input_sample_handler) {
+        input_sample_handler(client_id, player_entity, sample, acknowledged_server_tick);
+    }
+}
+
+void ServerNetworkManager::playBufferedInputs()
+{
+    for (auto& [client_id, connection] : clients) {
+        BufferedInput input;
+        if (!connection.input_buffer.consume(input)) {
+            continue;
+        }
 
-        if (input_sample_handler) {
-            input_sample_handler(client_id, player_entity, sample, msg.last_received_tick);
+        entt::entity player_entity = resolveInputPlayer(client_id, connection);
+        if (player_entity == entt::null) {
+            continue;
         }
+
+        // Repeated inputs move the player but are not reported as client commands
+        applyInputSample(client_id, player_entity, input.sample, input.acknowledged_server_tick, !input.synthesized);
     }
 }
 
@@ -602,7 +610,7 @@ void ServerNetworkManager::handleDisconnect(uint16_t client_id, BitReader& reade
     disconnectClient(client_id, "Client requested disconnect");
 }
 
-void ServerNetworkManager::handlePing(ENetPeer* peer, BitReader& reader)
+void ServerNetworkManager::handlePing(TransportPeerId peer, BitReader& reader)
 {
     PingMessage ping;
     if (!NetworkSerializer::deserialize(reader, ping)) {
@@ -770,7 +778,7 @@ std::vector<EntityUpdateData> ServerNetworkManager::generateDeltaUpdate(
 void ServerNetworkManager::sendWorldStateToClient(uint16_t client_id, const WorldSnapshot& snapshot)
 {
     auto it = clients.find(client_id);
-    if (it == clients.end() || it->second.info.peer == nullptr) {
+    if (it == clients.end() || it->second.info.peer == INVALID_TRANSPORT_PEER) {
         return;
     }
 
@@ -801,7 +809,10 @@ void ServerNetworkManager::sendWorldStateToClient(uint16_t client_id, const Worl
     if (baseline_miss) {
         msg.snapshot_flags |= SnapshotFlags::BASELINE_MISS;
     }
-    msg.last_processed_input_tick = it->second.info.last_input_tick;
+    msg.last_processed_input_tick = it->second.info.last_applied_input_tick;
+    if (getPhysicsHashForTick(snapshot.tick, msg.physics_hash)) {
+        msg.snapshot_flags |= SnapshotFlags::PHYSICS_HASH;
+    }
     NetworkSerializer::serialize(writer, msg, updates);
 
     // Send unreliable
@@ -873,9 +884,118 @@ const ClientInfo* ServerNetworkManager::getClientInfo(uint16_t client_id) const
     return nullptr;
 }
 
-bool ServerNetworkManager::sendReliableMessage(ENetPeer* peer, const BitWriter& writer)
+const PhysicsDesyncReport* ServerNetworkManager::getPhysicsDesyncReport(uint16_t client_id) const
+{
+    auto it = clients.find(client_id);
+    if (it != clients.end()) {
+        return &it->second.physics_desync.getReport();
+    }
+    return nullptr;
+}
+
+const InputJitterStats* ServerNetworkManager::getInputJitterStats(uint16_t client_id) const
+{
+    auto it = clients.find(client_id);
+    if (it != clients.end()) {
+        return &it->second.input_buffer.getStats();
+    }
+    return nullptr;
+}
+
+void ServerNetworkManager::syncInputBuffering()
+{
+    const bool enabled = getBoolCVarOrDefault("sv_input_buffer", true);
+    ConVarBase* max_depth_cvar = ConVarRegistry::get().find("sv_input_buffer_max");
+    const uint32_t max_depth = max_depth_cvar ? static_cast<uint32_t>((std::max)(max_depth_cvar->getInt(), 1)) : 6u;
+
+    if (enabled != input_buffering || max_depth != input_buffer_settings.max_depth) {
+        input_buffer_settings.max_depth = max_depth;
+        for (auto& [client_id, connection] : clients) {
+            connection.input_buffer.setSettings(input_buffer_settings);
+            if (enabled != input_buffering) {
+                connection.input_buffer.reset();
+            }
+        }
+        input_buffering = enabled;
+    }
+}
+
+void ServerNetworkManager::syncPhysicsHashing()
+{
+    game_world->getPhysicsSystem().setDeterminismChecks(getBoolCVarOrDefault("sv_physics_hash", false));
+}
+
+void ServerNetworkManager::syncPhysicsLod()
+{
+    PhysicsSystem& physics = game_world->getPhysicsSystem();
+    SimulationLodSettings lod_settings = physics.getSimulationLodSettings();
+    // Clients step without the LOD, so it would fail every hash comparison
+    lod_settings.enabled = getBoolCVarOrDefault("sv_physics_lod", false) && !physics.getDeterminismChecks();
+    lod_settings.full_distance = getFloatCVarOrDefault("sv_physics_lod_full", lod_settings.full_distance);
+    lod_settings.reduced_distance = getFloatCVarOrDefault("sv_physics_lod_reduced", lod_settings.reduced_distance);
+    physics.setSimulationLodSettings(lod_settings);
+
+    // Every spawned player is an observer; with none, nothing is reduced
+    physics_lod_observers.clear();
+    for (const auto& [client_id, connection] : clients) {
+        if (connection.info.player_entity_network_id == 0) {
+            continue;  // Player not spawned yet
+        }
+        const entt::entity player = getEntityByNetworkId(connection.info.player_entity_network_id);
+        if (!game_world->registry.valid(player)) {
+            continue;
+        }
+        if (const auto* transform = game_world->registry.try_get<TransformComponent>(player)) {
+            physics_lod_observers.push_back(transform->position);
+        }
+    }
+    physics.setSimulationLodObservers(physics_lod_observers.data(), physics_lod_observers.size());
+}
+
+bool ServerNetworkManager::getPhysicsHashForTick(uint32_t server_tick, uint64_t& out_hash) const
+{
+    if (game_world == nullptr) {
+        return false;
+    }
+
+    const PhysicsSystem& physics = game_world->getPhysicsSystem();
+    if (!physics.getDeterminismChecks()) {
+        return false;
+    }
+
+    // Server and world ticks advance together; only a world reset changes the offset.
+    const uint32_t world_tick = server_tick - (current_tick - game_world->getSimulationTick());
+    return physics.getStateHash(world_tick, out_hash);
+}
+
+void ServerNetworkManager::comparePhysicsHash(uint16_t client_id, ClientConnection& connection, const InputCommandMessage& msg)
 {
-    PacketSendResult result = sendPacketToPeer(peer, writer, PacketReliability::Reliable);
+    uint64_t server_hash = 0;
+    if (!msg.hasPhysicsHash() || !getPhysicsHashForTick(msg.physics_hash_tick, server_hash)) {
+        return;
+    }
+
+    const bool already_captured = connection.physics_desync.hasDesync();
+    if (connection.physics_desync.compare(msg.physics_hash_tick, server_hash, msg.physics_hash) || already_captured) {
+        return;
+    }
+
+    const PhysicsDesyncReport& report = connection.physics_desync.getReport();
+    LOG_ENGINE_ERROR("Physics desync with client {0} at server tick {1} (last match {2}): server {3:016x}, client {4:016x}",
+                     client_id, report.tick, report.last_matching_tick, report.local_hash, report.remote_hash);
+    if (on_physics_desync) {
+        on_physics_desync(client_id, report);
+    }
+}
+
+bool ServerNetworkManager::sendReliableMessage(TransportPeerId peer, const BitWriter& writer)
+{
+    ClientConnection* connection = findConnection(peer);
+    if (connection != nullptr && !connection->reliable_bundle.empty()) {
+        flushBundle(*connection, connection->reliable_bundle, PacketReliability::Reliable);
+    }
+
+    PacketSendResult result = sendPacketToPeer(transport.get(), peer, writer, PacketReliability::Reliable);
     if (!packetSendSucceeded(result)) {
         recordDroppedToPeer(peer, writer.getByteSize());
         return false;
@@ -885,9 +1005,9 @@ bool ServerNetworkManager::sendReliableMessage(ENetPeer* peer, const BitWriter&
     return true;
 }
 
-bool ServerNetworkManager::sendUnreliableMessage(ENetPeer* peer, const BitWriter& writer, PacketReliability reliability)
+bool ServerNetworkManager::sendUnreliableMessage(TransportPeerId peer, const BitWriter& writer, PacketReliability reliability)
 {
-    PacketSendResult result = sendPacketToPeer(peer, writer, reliability);
+    PacketSendResult result = sendPacketToPeer(transport.get(), peer, writer, reliability);
     if (!packetSendSucceeded(result)) {
         recordDroppedToPeer(peer, writer.getByteSize());
         return false;
@@ -897,22 +1017,40 @@ bool ServerNetworkManager::sendUnreliableMessage(ENetPeer* peer, const BitWriter
     return true;
 }
 
-void ServerNetworkManager::recordSentToPeer(ENetPeer* peer, std::size_t byte_count)
+void ServerNetworkManager::recordSentToPeer(TransportPeerId peer, std::size_t byte_count)
+{
+    ClientConnection* connection = findConnection(peer);
+    if (connection != nullptr) {
+        recordSentToConnection(*connection, byte_count);
+    } else {
+        recordSentPacket(stats, byte_count);
+    }
+}
+
+void ServerNetworkManager::recordSentToConnection(ClientConnection& connection, std::size_t byte_count)
 {
     recordSentPacket(stats, byte_count);
+    recordSentPacket(connection.info.stats, byte_count);
+}
 
+void ServerNetworkManager::recordDroppedToConnection(ClientConnection& connection, std::size_t byte_count)
+{
+    recordDroppedOutgoingPacket(stats, byte_count);
+    recordDroppedOutgoingPacket(connection.info.stats, byte_count);
+}
+
+ClientConnection* ServerNetworkManager::findConnection(TransportPeerId peer)
+{
     auto peer_it = peer_to_client_id.find(peer);
     if (peer_it == peer_to_client_id.end()) {
-        return;
+        return nullptr;
     }
 
     auto client_it = clients.find(peer_it->second);
-    if (client_it != clients.end()) {
-        recordSentPacket(client_it->second.info.stats, byte_count);
-    }
+    return client_it != clients.end() ? &client_it->second : nullptr;
 }
 
-void ServerNetworkManager::recordDroppedFromPeer(ENetPeer* peer, std::size_t byte_count)
+void ServerNetworkManager::recordDroppedFromPeer(TransportPeerId peer, std::size_t byte_count)
 {
     recordDroppedIncomingPacket(stats, byte_count);
 
@@ -927,7 +1065,7 @@ void ServerNetworkManager::recordDroppedFromPeer(ENetPeer* peer, std::size_t byt
     }
 }
 
-void ServerNetworkManager::recordDroppedToPeer(ENetPeer* peer, std::size_t byte_count)
+void ServerNetworkManager::recordDroppedToPeer(TransportPeerId peer, std::size_t byte_count)
 {
     recordDroppedOutgoingPacket(stats, byte_count);
 
@@ -942,7 +1080,7 @@ void ServerNetworkManager::recordDroppedToPeer(ENetPeer* peer, std::size_t byte_
     }
 }
 
-bool ServerNetworkManager::shouldAcceptClientMessage(ENetPeer* peer, uint8_t message_type) const
+bool ServerNetworkManager::shouldAcceptClientMessage(TransportPeerId peer, uint8_t message_type) const
 {
     const bool is_authenticated = peer_to_client_id.find(peer) != peer_to_client_id.end();
     const MessageType type = static_cast<MessageType>(message_type);
@@ -958,6 +1096,7 @@ bool ServerNetworkManager::shouldAcceptClientMessage(ENetPeer* peer, uint8_t mes
         case MessageType::SPAWN_PLAYER:
         case MessageType::DESPAWN_PLAYER:
         case MessageType::WORLD_STATE_UPDATE:
+        case MessageType::MESSAGE_BUNDLE:
         case MessageType::PONG:
         case MessageType::CVAR_SYNC:
         case MessageType::CVAR_INITIAL_SYNC:
@@ -978,8 +1117,8 @@ void ServerNetworkManager::disconnectClient(uint16_t client_id, const char* reas
         return;
     }
 
-    ENetPeer* peer = it->second.info.peer;
-    if (peer != nullptr) {
+    const TransportPeerId peer = it->second.info.peer;
+    if (peer != INVALID_TRANSPORT_PEER) {
         // Send disconnect message
         BitWriter writer;
         DisconnectMessage msg;
@@ -989,7 +1128,7 @@ void ServerNetworkManager::disconnectClient(uint16_t client_id, const char* reas
         sendReliableMessage(peer, writer);
 
         // Disconnect peer
-        enet_peer_disconnect_later(peer, 0);
+        transport->disconnectLater(peer);
     }
 
     // Clean up
@@ -1016,7 +1155,7 @@ void ServerNetworkManager::setClientPlayerEntity(uint16_t client_id, uint32_t ne
 void ServerNetworkManager::sendReliableToClient(uint16_t client_id, const BitWriter& writer)
 {
     auto it = clients.find(client_id);
-    if (it != clients.end() && it->second.info.peer != nullptr) {
+    if (it != clients.end() && it->second.info.peer != INVALID_TRANSPORT_PEER) {
         sendReliableMessage(it->second.info.peer, writer);
     } else {
         LOG_ENGINE_WARN("Cannot send to client {0}: not found or no peer", client_id);
@@ -1026,7 +1165,7 @@ void ServerNetworkManager::sendReliableToClient(uint16_t client_id, const BitWri
 void ServerNetworkManager::sendUnreliableToClient(uint16_t client_id, const BitWriter& writer)
 {
     auto it = clients.find(client_id);
-    if (it != clients.end() && it->second.info.peer != nullptr) {
+    if (it != clients.end() && it->second.info.peer != INVALID_TRANSPORT_PEER) {
         sendUnreliableMessage(it->second.info.peer, writer, PacketReliability::UnreliableUnordered);
     } else {
         LOG_ENGINE_WARN("Cannot send to client {0}: not found or no peer", client_id);
@@ -1036,7 +1175,7 @@ void ServerNetworkManager::sendUnreliableToClient(uint16_t client_id, const BitW
 void ServerNetworkManager::broadcastReliable(const BitWriter& writer)
 {
     for (auto& [client_id, connection] : clients) {
-        if (connection.info.peer) {
+        if (connection.info.peer != INVALID_TRANSPORT_PEER) {
             sendReliableMessage(connection.info.peer, writer);
         }
     }
@@ -1045,12 +1184,167 @@ void ServerNetworkManager::broadcastReliable(const BitWriter& writer)
 void ServerNetworkManager::broadcastUnreliable(const BitWriter& writer)
 {
     for (auto& [client_id, connection] : clients) {
-        if (connection.info.peer) {
+        if (connection.info.peer != INVALID_TRANSPORT_PEER) {
             sendUnreliableMessage(connection.info.peer, writer, PacketReliability::UnreliableUnordered);
         }
     }
 }
 
+void ServerNetworkManager::queueReliableToClient(uint16_t client_id, const BitWriter& writer)
+{
+    auto it = clients.find(client_id);
+    if (it != clients.end() && it->second.info.peer != INVALID_TRANSPORT_PEER) {
+        queueMessage(it->second, writer.getData(), writer.getByteSize(), PacketReliability::Reliable);
+    } else {
+        LOG_ENGINE_WARN("Cannot queue for client {0}: not found or no peer", client_id);
+    }
+}
+
+void ServerNetworkManager::queueUnreliableToClient(uint16_t client_id, const BitWriter& writer)
+{
+    auto it = clients.find(client_id);
+    if (it != clients.end() && it->second.info.peer != INVALID_TRANSPORT_PEER) {
+        queueMessage(it->second, writer.getData(), writer.getByteSize(), PacketReliability::UnreliableUnordered);
+    } else {
+        LOG_ENGINE_WARN("Cannot queue for client {0}: not found or no peer", client_id);
+    }
+}
+
+void ServerNetworkManager::multicastReliable(const BitWriter& writer, const ServerRelevancyFilter& relevant)
+{
+    multicastMessage(writer, PacketReliability::Reliable, relevant);
+}
+
+void ServerNetworkManager::multicastUnreliable(const BitWriter& writer, const ServerRelevancyFilter& relevant)
+{
+    multicastMessage(writer, PacketReliability::UnreliableUnordered, relevant);
+}
+
+void ServerNetworkManager::flushOutgoingMessages()
+{
+    for (auto& [client_id, connection] : clients) {
+        flushBundle(connection, connection.reliable_bundle, PacketReliability::Reliable);
+        flushBundle(connection, connection.unreliable_bundle, PacketReliability::UnreliableUnordered);
+    }
+}
+
+void ServerNetworkManager::syncMessageBundling()
+{
+    const bool enabled = getBoolCVarOrDefault("sv_bundle_messages", true);
+    if (!enabled && message_bundling) {
+        flushOutgoingMessages();
+    }
+    message_bundling = enabled;
+}
+
+void ServerNetworkManager::queueMessage(ClientConnection& connection,
+                                        const uint8_t* data,
+                                        std::size_t size,
+                                        PacketReliability reliability)
+{
+    if (!message_bundling) {
+        sendToConnection(connection, data, size, reliability);
+        return;
+    }
+
+    MessageBundle& bundle = reliability == PacketReliability::Reliable
+        ? connection.reliable_bundle
+        : connection.unreliable_bundle;
+    if (!bundle.canAppend(size)) {
+        flushBundle(connection, bundle, reliability);
+        if (!bundle.canAppend(size)) {
+            // Larger than a whole bundle: goes out on its own, after everything queued before it
+            sendToConnection(connection, data, size, reliability);
+            return;
+        }
+    }
+
+    bundle.append(data, size);
+    message_stats.messages_queued++;
+}
+
+void ServerNetworkManager::multicastMessage(const BitWriter& writer,
+                                            PacketReliability reliability,
+                                            const ServerRelevancyFilter& relevant)
+{
+    const std::size_t byte_size = writer.getByteSize();
+    if (byte_size == 0) {
+        return;
+    }
+
+    message_stats.multicasts++;
+    multicast_peers.clear();
+    multicast_connections.clear();
+    for (auto& [client_id, connection] : clients) {
+        if (connection.info.peer == INVALID_TRANSPORT_PEER) {
+            continue;
+        }
+        if (relevant && !relevant(client_id, connection.info)) {
+            message_stats.multicast_filtered++;
+            continue;
+        }
+        message_stats.multicast_recipients++;
+
+        if (message_bundling) {
+            queueMessage(connection, writer.getData(), byte_size, reliability);
+            continue;
+        }
+
+        if (reliability == PacketReliability::Reliable && !connection.reliable_bundle.empty()) {
+            flushBundle(connection, connection.reliable_bundle, reliability);
+        }
+        multicast_peers.push_back(connection.info.peer);
+        multicast_connections.push_back(&connection);
+    }
+
+    if (multicast_peers.empty() || transport == nullptr) {
+        return;
+    }
+
+    // Every recipient shares one packet where the transport supports it
+    multicast_results.resize(multicast_peers.size());
+    transport->sendToPeers(multicast_peers.data(), multicast_peers.size(), writer.getData(), byte_size,
+                           reliability, multicast_results.data());
+    for (size_t i = 0; i < multicast_connections.size(); ++i) {
+        if (packetSendSucceeded(multicast_results[i])) {
+            recordSentToConnection(*multicast_connections[i], byte_size);
+        } else {
+            recordDroppedToConnection(*multicast_connections[i], byte_size);
+        }
+    }
+}
+
+void ServerNetworkManager::flushBundle(ClientConnection& connection, MessageBundle& bundle, PacketReliability reliability)
+{
+    if (bundle.empty()) {
+        return;
+    }
+
+    if (bundle.getMessageCount() > 1) {
+        message_stats.bundles_sent++;
+        message_stats.messages_bundled += bundle.getMessageCount();
+    }
+    sendToConnection(connection, bundle.getPacketData(), bundle.getPacketSize(), reliability);
+    bundle.clear();
+}
+
+bool ServerNetworkManager::sendToConnection(ClientConnection& connection,
+                                            const uint8_t* data,
+                                            std::size_t size,
+                                            PacketReliability reliability)
+{
+    const PacketSendResult result = transport != nullptr
+        ? transport->send(connection.info.peer, data, size, reliability)
+        : PacketSendResult::InvalidPeer;
+    if (!packetSendSucceeded(result)) {
+        recordDroppedToConnection(connection, size);
+        return false;
+    }
+
+    recordSentToConnection(connection, size);
+    return true;
+}
+
 void ServerNetworkManager::broadcastCVar(const std::string& name, const std::string& value)
 {
     if (clients.empty()) {
@@ -1068,7 +1362,7 @@ void ServerNetworkManager::broadcastCVar(const std::string& name, const std::str
 
     // Send to all connected clients
     for (auto& [client_id, connection] : clients) {
-        if (connection.info.peer) {
+        if (connection.info.peer != INVALID_TRANSPORT_PEER) {
             sendReliableMessage(connection.info.peer, writer);
         }
     }
@@ -1079,7 +1373,7 @@ void ServerNetworkManager::broadcastCVar(const std::string& name, const std::str
 void ServerNetworkManager::sendInitialCVarsToClient(uint16_t client_id)
 {
     auto it = clients.find(client_id);
-    if (it == clients.end() || it->second.info.peer == nullptr) {
+    if (it == clients.end() || it->second.info.peer == INVALID_TRANSPORT_PEER) {
         return;
     }
 
@@ -6,15 +6,18 @@
 #include <deque>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <utility>
 #include "EngineExport.h"
-#include "enet.h"
 #include "NetworkProtocol.hpp"
 #include "NetworkTypes.hpp"
 #include "BitStream.hpp"
 #include "NetworkSerializer.hpp"
 #include "NetworkTransport.hpp"
+#include "MessageBundle.hpp"
+#include "InputJitterBuffer.hpp"
 #include "LagHistory.hpp"
+#include "Physics/PhysicsDeterminism.hpp"
 #include <entt/entt.hpp>
 
 // Forward declarations
@@ -29,6 +32,20 @@ using ServerInputSampleHandler = std::function<void(
     entt::entity player_entity,
     const InputSample& input,
     uint32_t acknowledged_server_tick)>;
+using ServerPhysicsDesyncHandler = std::function<void(uint16_t client_id, const PhysicsDesyncReport& report)>;
+// Returns true if a multicast message is relevant to this client
+using ServerRelevancyFilter = std::function<bool(uint16_t client_id, const ClientInfo& client)>;
+
+// Outgoing message batching counters (cumulative). Packet and byte totals are in NetworkStats.
+struct ServerMessageStats
+{
+    uint64_t messages_queued = 0;       // Messages added to a client bundle
+    uint64_t messages_bundled = 0;      // Messages that left in a packet with at least one other message
+    uint64_t bundles_sent = 0;          // MESSAGE_BUNDLE packets sent
+    uint64_t multicasts = 0;            // Payloads passed to multicastReliable / multicastUnreliable
+    uint64_t multicast_recipients = 0;  // Clients a multicast payload was delivered or queued to
+    uint64_t multicast_filtered = 0;    // Clients a relevancy filter skipped
+};
 
 // Client connection tracking (server-side)
 struct ClientConnection
@@ -36,6 +53,10 @@ struct ClientConnection
     ClientInfo info;
     NetworkStatsRateSampler stats_sampler;
     uint32_t last_sent_tick = 0;
+    PhysicsDesyncDetector physics_desync;  // Server ticks; compared against the client's acknowledged hashes
+    InputJitterBuffer input_buffer;        // Played back one input per server tick (sv_input_buffer)
+    MessageBundle reliable_bundle{NETWORK_MAX_RELIABLE_BUNDLE_BYTES};      // Flushed once per tick (sv_bundle_messages)
+    MessageBundle unreliable_bundle{NETWORK_MAX_UNRELIABLE_BUNDLE_BYTES};
 
     ClientConnection() = default;
     ClientConnection(const ClientInfo& client_info) : info(client_info) {}
@@ -51,13 +72,14 @@ class ENGINE_API ServerNetworkManager
 {
 private:
     bool runtime_acquired = false;
-    ENetHost* server_host = nullptr;
+    std::unique_ptr<INetworkTransport> transport;
     world* game_world = nullptr;
 
     // Client management
     std::unordered_map<uint16_t, ClientConnection> clients;  // client_id -> connection
-    std::unordered_map<ENetPeer*, uint16_t> peer_to_client_id;  // peer -> client_id
+    std::unordered_map<TransportPeerId, uint16_t> peer_to_client_id;  // peer -> client_id
     uint16_t next_client_id = 1;
+    uint32_t max_client_count = 0;
 
     // Entity management
     std::unordered_map<entt::entity, uint32_t> entity_to_net_id;
@@ -71,6 +93,9 @@ private:
     uint32_t last_lag_history_tick = 0;
     std::deque<WorldSnapshot> snapshot_history;
     LagHistory lag_history;
+    bool input_buffering = true;
+    bool message_bundling = true;
+    InputJitterSettings input_buffer_settings;
 
     // Callbacks
     std::function<void(uint16_t)> on_client_connected;
@@ -78,10 +103,20 @@ private:
     ServerCustomMessageHandler on_custom_message;
     ServerInputFilter input_filter;
     ServerInputSampleHandler input_sample_handler;
+    ServerPhysicsDesyncHandler on_physics_desync;
 
     // Network stats
     NetworkStats stats;
     NetworkStatsRateSampler stats_sampler;
+    ServerMessageStats message_stats;
+
+    // Multicast scratch, reused across sends
+    std::vector<TransportPeerId> multicast_peers;
+    std::vector<ClientConnection*> multicast_connections;
+    std::vector<PacketSendResult> multicast_results;
+
+    // Player positions handed to the physics simulation LOD, reused across ticks
+    std::vector<glm::vec3> physics_lod_observers;
 
 public:
     ServerNetworkManager();
@@ -89,8 +124,12 @@ public:
 
     // Initialization
     bool initialize();
+    // Listens over ENet and, with net_local_transport 1, over LocalTransport on the same port
+    // so clients in this process skip the socket layer.
     bool startServer(uint16_t port, uint32_t max_clients = 32);
+    bool startServer(std::unique_ptr<INetworkTransport> server_transport, uint16_t port, uint32_t max_clients = 32);
     void shutdown();
+    const INetworkTransport* getTransport() const { return transport.get(); }
 
     // Set the game world
     void setWorld(world* w) { game_world = w; }
@@ -124,9 +163,12 @@ public:
     void setCustomMessageHandler(ServerCustomMessageHandler callback) { on_custom_message = std::move(callback); }
     void setInputFilter(ServerInputFilter callback) { input_filter = std::move(callback); }
     void setInputSampleHandler(ServerInputSampleHandler callback) { input_sample_handler = std::move(callback); }
+    void setPhysicsDesyncHandler(ServerPhysicsDesyncHandler callback) { on_physics_desync = std::move(callback); }
 
     // Client management
     const ClientInfo* getClientInfo(uint16_t client_id) const;
+    const PhysicsDesyncReport* getPhysicsDesyncReport(uint16_t client_id) const;
+    const InputJitterStats* getInputJitterStats(uint16_t client_id) const;
     size_t getClientCount() const { return clients.size(); }
     void setClientPlayerEntity(uint16_t client_id, uint32_t network_id);
     void sendReliableToClient(uint16_t client_id, const BitWriter& writer);
@@ -135,8 +177,23 @@ public:
     void broadcastUnreliable(const BitWriter& writer);
     uint16_t getNextClientId() const { return next_client_id; }
 
+    // Per-tick event sends. With sv_bundle_messages 1 (the default) each message is copied
+    // into the client's bundle for its channel and every bundle leaves as one packet when
+    // publishWorldState flushes, so call these between pumpNetworkEvents and publishWorldState.
+    // Immediate reliable sends flush the client's reliable bundle first to keep the order.
+    void queueReliableToClient(uint16_t client_id, const BitWriter& writer);
+    void queueUnreliableToClient(uint16_t client_id, const BitWriter& writer);
+
+    // Serialize once, deliver to every connected client the filter accepts (all if empty).
+    // Without bundling, all recipients share one transport packet. Unreliable multicasts are for
+    // cosmetic events (tracers, impacts) that can be lost without gameplay consequences.
+    void multicastReliable(const BitWriter& writer, const ServerRelevancyFilter& relevant = nullptr);
+    void multicastUnreliable(const BitWriter& writer, const ServerRelevancyFilter& relevant = nullptr);
+    void flushOutgoingMessages();
+
     // Stats
     const NetworkStats& getStats() const { return stats; }
+    const ServerMessageStats& getMessageStats() const { return message_stats; }
     uint32_t getCurrentTick() const { return current_tick; }
 
     // ConVar replication
@@ -146,15 +203,22 @@ public:
 
 private:
     // Event handlers
-    void handleClientConnect(ENetEvent& event);
-    void handleClientDisconnect(ENetEvent& event);
-    void handleClientMessage(ENetEvent& event);
+    void handleClientConnect(const TransportEvent& event);
+    void handleClientDisconnect(const TransportEvent& event);
+    void handleClientMessage(const TransportEvent& event);
 
     // Message handlers
-    void handleConnectRequest(ENetPeer* peer, BitReader& reader);
+    void handleConnectRequest(TransportPeerId peer, BitReader& reader);
     void handleInputCommand(uint16_t client_id, BitReader& reader);
     void handleDisconnect(uint16_t client_id, BitReader& reader);
-    void handlePing(ENetPeer* peer, BitReader& reader);
+    void handlePing(TransportPeerId peer, BitReader& reader);
+
+    // Input playback
+    entt::entity resolveInputPlayer(uint16_t client_id, const ClientConnection& connection);
+    void applyInputSample(uint16_t client_id, entt::entity player_entity, const InputSample& sample,
+                          uint32_t acknowledged_server_tick, bool notify = true);
+    void playBufferedInputs();
+    void syncInputBuffering();
 
     // State synchronization
     WorldSnapshot generateWorldSnapshot();
@@ -166,15 +230,33 @@ private:
     void sendWorldStateToClient(uint16_t client_id, const WorldSnapshot& snapshot);
     void refreshStats(float delta_time);
 
+    // Physics determinism checks (sv_physics_hash)
+    void syncPhysicsHashing();
+    bool getPhysicsHashForTick(uint32_t server_tick, uint64_t& out_hash) const;
+    void comparePhysicsHash(uint16_t client_id, ClientConnection& connection, const InputCommandMessage& msg);
+
+    // Physics simulation LOD around connected players (sv_physics_lod)
+    void syncPhysicsLod();
+
+    // Message bundling (sv_bundle_messages)
+    void syncMessageBundling();
+    void queueMessage(ClientConnection& connection, const uint8_t* data, std::size_t size, PacketReliability reliability);
+    void multicastMessage(const BitWriter& writer, PacketReliability reliability, const ServerRelevancyFilter& relevant);
+    void flushBundle(ClientConnection& connection, MessageBundle& bundle, PacketReliability reliability);
+    bool sendToConnection(ClientConnection& connection, const uint8_t* data, std::size_t size, PacketReliability reliability);
+
     // Helper functions
-    bool sendReliableMessage(ENetPeer* peer, const BitWriter& writer);
-    bool sendUnreliableMessage(ENetPeer* peer,
+    bool sendReliableMessage(TransportPeerId peer, const BitWriter& writer);
+    bool sendUnreliableMessage(TransportPeerId peer,
                                const BitWriter& writer,
                                PacketReliability reliability = PacketReliability::UnreliableSequenced);
-    void recordSentToPeer(ENetPeer* peer, std::size_t byte_count);
-    void recordDroppedFromPeer(ENetPeer* peer, std::size_t byte_count);
-    void recordDroppedToPeer(ENetPeer* peer, std::size_t byte_count);
-    bool shouldAcceptClientMessage(ENetPeer* peer, uint8_t message_type) const;
+    void recordSentToPeer(TransportPeerId peer, std::size_t byte_count);
+    void recordSentToConnection(ClientConnection& connection, std::size_t byte_count);
+    void recordDroppedToConnection(ClientConnection& connection, std::size_t byte_count);
+    void recordDroppedFromPeer(TransportPeerId peer, std::size_t byte_count);
+    void recordDroppedToPeer(TransportPeerId peer, std::size_t byte_count);
+    ClientConnection* findConnection(TransportPeerId peer);
+    bool shouldAcceptClientMessage(TransportPeerId peer, uint8_t message_type) const;
     void disconnectClient(uint16_t client_id, const char* reason);
 };
 
@@ -0,0 +1,525 @@
+#include "Particles/ParticleSystem.hpp"
+
+#include "Components/Components.hpp"
+#include "Components/ParticleEmitterComponent.hpp"
+#include "Threading/JobSystem.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLES_SSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PARTICLES_NEON 1
+#endif
+
+namespace
+{
+#if defined(PARTICLES_SSE)
+    using Float4 = __m128;
+    inline Float4 load4(const float* p) { return _mm_loadu_ps(p); }
+    inline void store4(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+    inline Float4 splat4(float v) { return _mm_set1_ps(v); }
+    inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+    inline Float4 min4(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+    inline Float4 max4(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+    inline uint32_t geMask4(Float4 a, Float4 b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(a, b))); }
+    inline float hmin4(Float4 v)
+    {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, v);
+        return std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    }
+    inline float hmax4(Float4 v)
+    {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, v);
+        return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    }
+#elif defined(PARTICLES_NEON)
+    using Float4 = float32x4_t;
+    inline Float4 load4(const float* p) { return vld1q_f32(p); }
+    inline void store4(float* p, Float4 v) { vst1q_f32(p, v); }
+    inline Float4 splat4(float v) { return vdupq_n_f32(v); }
+    inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+    inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+    inline Float4 min4(Float4 a, Float4 b) { return vminq_f32(a, b); }
+    inline Float4 max4(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+    inline uint32_t geMask4(Float4 a, Float4 b)
+    {
+        const uint32x4_t bits = vandq_u32(vcgeq_f32(a, b), uint32x4_t{1u, 2u, 4u, 8u});
+        return vaddvq_u32(bits);
+    }
+    inline float hmin4(Float4 v) { return vminvq_f32(v); }
+    inline float hmax4(Float4 v) { return vmaxvq_f32(v); }
+#endif
+
+    uint32_t nextRandom(uint32_t& state)
+    {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Uniform in [0, 1)
+    float randomUnit(uint32_t& state)
+    {
+        return static_cast<float>(nextRandom(state) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [-1, 1)
+    float randomSigned(uint32_t& state)
+    {
+        return randomUnit(state) * 2.0f - 1.0f;
+    }
+
+    uint32_t seedRandom(uint32_t seed)
+    {
+        // Avalanche the seed so neighbouring seeds give unrelated streams; xorshift needs non-zero
+        seed ^= seed >> 16;
+        seed *= 0x7feb352dU;
+        seed ^= seed >> 15;
+        seed *= 0x846ca68bU;
+        seed ^= seed >> 16;
+        return seed != 0 ? seed : 0x9e3779b9U;
+    }
+}
+
+void ParticlePool::setCapacity(uint32_t capacity)
+{
+    for (std::vector<float>* stream : {&position_x, &position_y, &position_z,
+                                       &velocity_x, &velocity_y, &velocity_z, &age, &lifetime})
+    {
+        stream->resize(capacity);
+        stream->shrink_to_fit();
+    }
+    count = std::min(count, capacity);
+}
+
+void ParticlePool::swapRemove(uint32_t index)
+{
+    if (index >= count)
+        return;
+    const uint32_t last = --count;
+    position_x[index] = position_x[last];
+    position_y[index] = position_y[last];
+    position_z[index] = position_z[last];
+    velocity_x[index] = velocity_x[last];
+    velocity_y[index] = velocity_y[last];
+    velocity_z[index] = velocity_z[last];
+    age[index] = age[last];
+    lifetime[index] = lifetime[last];
+}
+
+void ParticlePool::reorder(const uint32_t* order, std::vector<float>& scratch)
+{
+    scratch.resize(count);
+    for (std::vector<float>* stream : {&position_x, &position_y, &position_z,
+                                       &velocity_x, &velocity_y, &velocity_z, &age, &lifetime})
+    {
+        const float* src = stream->data();
+        for (uint32_t i = 0; i < count; ++i)
+            scratch[i] = src[order[i]];
+        std::copy(scratch.begin(), scratch.begin() + count, stream->begin());
+    }
+}
+
+void ParticleSystem::integrate(ParticlePool& pool, uint32_t begin, uint32_t end, float dt,
+                               const glm::vec3& acceleration, float drag,
+                               std::vector<uint32_t>& dead, glm::vec3& bounds_min, glm::vec3& bounds_max)
+{
+    end = std::min(end, pool.count);
+    if (begin >= end)
+        return;
+
+    // Exact decay over dt, so a reduced-LOD emitter stepping several frames at once matches
+    const float damping = drag > 0.0f ? std::exp(-drag * dt) : 1.0f;
+    const glm::vec3 delta_v = acceleration * dt;
+
+    float* px = pool.position_x.data();
+    float* py = pool.position_y.data();
+    float* pz = pool.position_z.data();
+    float* vx = pool.velocity_x.data();
+    float* vy = pool.velocity_y.data();
+    float* vz = pool.velocity_z.data();
+    float* age = pool.age.data();
+    const float* lifetime = pool.lifetime.data();
+
+    uint32_t i = begin;
+#if defined(PARTICLES_SSE) || defined(PARTICLES_NEON)
+    const Float4 dt4 = splat4(dt);
+    const Float4 damping4 = splat4(damping);
+    const Float4 dvx4 = splat4(delta_v.x);
+    const Float4 dvy4 = splat4(delta_v.y);
+    const Float4 dvz4 = splat4(delta_v.z);
+    Float4 min_x = splat4(bounds_min.x), min_y = splat4(bounds_min.y), min_z = splat4(bounds_min.z);
+    Float4 max_x = splat4(bounds_max.x), max_y = splat4(bounds_max.y), max_z = splat4(bounds_max.z);
+
+    for (; i + 4 <= end; i += 4)
+    {
+        const Float4 nvx = mul4(add4(load4(vx + i), dvx4), damping4);
+        const Float4 nvy = mul4(add4(load4(vy + i), dvy4), damping4);
+        const Float4 nvz = mul4(add4(load4(vz + i), dvz4), damping4);
+        store4(vx + i, nvx);
+        store4(vy + i, nvy);
+        store4(vz + i, nvz);
+
+        const Float4 x = add4(load4(px + i), mul4(nvx, dt4));
+        const Float4 y = add4(load4(py + i), mul4(nvy, dt4));
+        const Float4 z = add4(load4(pz + i), mul4(nvz, dt4));
+        store4(px + i, x);
+        store4(py + i, y);
+        store4(pz + i, z);
+        min_x = min4(min_x, x);
+        min_y = min4(min_y, y);
+        min_z = min4(min_z, z);
+        max_x = max4(max_x, x);
+        max_y = max4(max_y, y);
+        max_z = max4(max_z, z);
+
+        const Float4 a = add4(load4(age + i), dt4);
+        store4(age + i, a);
+        for (uint32_t mask = geMask4(a, load4(lifetime + i)); mask != 0; mask &= mask - 1)
+            dead.push_back(i + static_cast<uint32_t>(std::countr_zero(mask)));
+    }
+
+    bounds_min = glm::vec3(hmin4(min_x), hmin4(min_y), hmin4(min_z));
+    bounds_max = glm::vec3(hmax4(max_x), hmax4(max_y), hmax4(max_z));
+#endif
+
+    for (; i < end; ++i)
+    {
+        vx[i] = (vx[i] + delta_v.x) * damping;
+        vy[i] = (vy[i] + delta_v.y) * damping;
+        vz[i] = (vz[i] + delta_v.z) * damping;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        pz[i] += vz[i] * dt;
+        const glm::vec3 p(px[i], py[i], pz[i]);
+        bounds_min = glm::min(bounds_min, p);
+        bounds_max = glm::max(bounds_max, p);
+        age[i] += dt;
+        if (age[i] >= lifetime[i])
+            dead.push_back(i);
+    }
+}
+
+ParticleLod ParticleSystem::selectLod(float distance_sq, ParticleLod current) const
+{
+    const float full_limit = settings.full_distance + (current == ParticleLod::Full ? settings.hysteresis : 0.0f);
+    const float reduced_limit = settings.reduced_distance + (current != ParticleLod::Culled ? settings.hysteresis : 0.0f);
+    if (distance_sq <= full_limit * full_limit)
+        return ParticleLod::Full;
+    if (distance_sq <= reduced_limit * reduced_limit)
+        return ParticleLod::Reduced;
+    return ParticleLod::Culled;
+}
+
+void ParticleSystem::applyBudget(float dt)
+{
+    double budget = settings.max_particle_updates > 0 ? static_cast<double>(settings.max_particle_updates)
+                                                      : std::numeric_limits<double>::infinity();
+    if (settings.budget_ms > 0.0f && stats.ns_per_particle > 0.0f)
+        budget = std::min(budget, settings.budget_ms * 1.0e6 / stats.ns_per_particle);
+
+    const uint32_t interval = std::max(settings.reduced_interval, 1u);
+    double planned = 0.0;
+    bool over_budget = false;
+    for (EmitterWork& work : emitters)
+    {
+        ParticleEmitterComponent& emitter = *work.emitter;
+        emitter.throttled = false;
+        if (emitter.lod == ParticleLod::Culled)
+        {
+            ++stats.culled;
+            continue;
+        }
+
+        // Particles this emitter adds to a frame's updates, amortized at reduced LOD
+        auto frameCost = [&](ParticleLod lod, float spawn_scale) {
+            const double spawned = emitter.emitting ? emitter.settings.spawn_rate * spawn_scale * dt : 0.0;
+            const double particles = std::min<double>(emitter.pool.count + spawned, emitter.settings.max_particles);
+            return lod == ParticleLod::Reduced ? particles / interval : particles;
+        };
+
+        float spawn_scale = emitter.lod == ParticleLod::Reduced ? settings.reduced_spawn_scale : 1.0f;
+        double cost = frameCost(emitter.lod, spawn_scale);
+        if (!over_budget && planned + cost > budget)
+            over_budget = true;
+        if (over_budget)
+        {
+            // Let the particles it has die out at reduced LOD
+            emitter.throttled = true;
+            if (emitter.lod == ParticleLod::Full)
+            {
+                emitter.lod = ParticleLod::Reduced;
+                emitter.frames_until_update = 0;
+            }
+            spawn_scale = 0.0f;
+            cost = frameCost(emitter.lod, spawn_scale);
+            ++stats.throttled;
+        }
+        planned += cost;
+        work.spawn_scale = spawn_scale;
+
+        emitter.pending_dt += dt;
+        if (emitter.lod == ParticleLod::Reduced && emitter.frames_until_update > 0)
+        {
+            --emitter.frames_until_update;
+        }
+        else
+        {
+            work.dt = emitter.pending_dt;
+            emitter.pending_dt = 0.0f;
+            emitter.frames_until_update = emitter.lod == ParticleLod::Reduced ? interval - 1 : 0;
+        }
+        ++(emitter.lod == ParticleLod::Full ? stats.full : stats.reduced);
+    }
+}
+
+uint32_t ParticleSystem::spawn(EmitterWork& work)
+{
+    ParticleEmitterComponent& emitter = *work.emitter;
+    const ParticleEmitterSettings& s = emitter.settings;
+    ParticlePool& pool = emitter.pool;
+    if (pool.capacity() != s.max_particles)
+        pool.setCapacity(s.max_particles);
+
+    if (!emitter.emitting || work.spawn_scale <= 0.0f)
+    {
+        emitter.spawn_accumulator = 0.0f;
+        return 0;
+    }
+    if (work.dt <= 0.0f)
+        return 0;
+
+    emitter.spawn_accumulator += s.spawn_rate * work.spawn_scale * work.dt;
+    const uint32_t wanted = static_cast<uint32_t>(emitter.spawn_accumulator);
+    emitter.spawn_accumulator -= static_cast<float>(wanted);
+    const uint32_t spawned = std::min(wanted, pool.capacity() - pool.count);
+    if (spawned == 0)
+        return 0;
+
+    if (emitter.random_state == 0)
+        emitter.random_state = seedRandom(s.seed);
+    uint32_t& rng = emitter.random_state;
+
+    const float lifetime_min = std::max(s.lifetime_min, 1.0e-3f);
+    const float lifetime_range = std::max(s.lifetime_max - lifetime_min, 0.0f);
+    for (uint32_t i = pool.count; i < pool.count + spawned; ++i)
+    {
+        glm::vec3 offset(0.0f);
+        if (s.spawn_radius > 0.0f)
+        {
+            // Rejection sampling; falls back to the center after a few unlucky draws
+            for (int attempt = 0; attempt < 8; ++attempt)
+            {
+                const glm::vec3 candidate(randomSigned(rng), randomSigned(rng), randomSigned(rng));
+                if (glm::dot(candidate, candidate) <= 1.0f)
+                {
+                    offset = candidate * s.spawn_radius;
+                    break;
+                }
+            }
+        }
+        const glm::vec3 jitter(randomSigned(rng), randomSigned(rng), randomSigned(rng));
+        const glm::vec3 velocity = work.rotation * (s.velocity + jitter * s.velocity_jitter);
+
+        pool.position_x[i] = work.position.x + offset.x;
+        pool.position_y[i] = work.position.y + offset.y;
+        pool.position_z[i] = work.position.z + offset.z;
+        pool.velocity_x[i] = velocity.x;
+        pool.velocity_y[i] = velocity.y;
+        pool.velocity_z[i] = velocity.z;
+        pool.age[i] = 0.0f;
+        pool.lifetime[i] = lifetime_min + randomUnit(rng) * lifetime_range;
+    }
+    pool.count += spawned;
+    return spawned;
+}
+
+bool ParticleSystem::sortBackToFront(ParticlePool& pool, const glm::vec3& view_position)
+{
+    thread_local std::vector<float> keys;
+    thread_local std::vector<uint32_t> order;
+    thread_local std::vector<float> scratch;
+
+    keys.resize(pool.count);
+    for (uint32_t i = 0; i < pool.count; ++i)
+    {
+        const float dx = pool.position_x[i] - view_position.x;
+        const float dy = pool.position_y[i] - view_position.y;
+        const float dz = pool.position_z[i] - view_position.z;
+        keys[i] = dx * dx + dy * dy + dz * dz;
+    }
+
+    // Particles move little between frames, so the pool is usually still in order
+    if (std::is_sorted(keys.begin(), keys.end(), std::greater<float>()))
+        return false;
+
+    order.resize(pool.count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [](uint32_t a, uint32_t b) { return keys[a] > keys[b]; });
+    pool.reorder(order.data(), scratch);
+    return true;
+}
+
+void ParticleSystem::finish(EmitterWork& work, const glm::vec3& view_position)
+{
+    ParticleEmitterComponent& emitter = *work.emitter;
+    ParticlePool& pool = emitter.pool;
+
+    if (work.chunk_count > 0)
+    {
+        glm::vec3 bounds_min(std::numeric_limits<float>::max());
+        glm::vec3 bounds_max(std::numeric_limits<float>::lowest());
+
+        // Chunks hold ascending indices in ascending ranges; walking both backwards removes
+        // in descending order
+        for (uint32_t c = work.first_chunk + work.chunk_count; c-- > work.first_chunk;)
+        {
+            const ChunkWork& chunk = chunks[c];
+            bounds_min = glm::min(bounds_min, chunk.bounds_min);
+            bounds_max = glm::max(bounds_max, chunk.bounds_max);
+            for (auto it = chunk.dead.rbegin(); it != chunk.dead.rend(); ++it)
+                pool.swapRemove(*it);
+            work.killed += static_cast<uint32_t>(chunk.dead.size());
+        }
+
+        if (pool.count > 0)
+        {
+            emitter.bounds_min = bounds_min;
+            emitter.bounds_max = bounds_max;
+        }
+        else
+        {
+            emitter.bounds_min = work.position;
+            emitter.bounds_max = work.position;
+        }
+    }
+
+    if (emitter.settings.needsDepthSort() && emitter.lod != ParticleLod::Culled && pool.count > 1)
+        work.sorted = sortBackToFront(pool, view_position);
+}
+
+void ParticleSystem::update(entt::registry& registry, const glm::vec3& view_position, float dt)
+{
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    const float cost_estimate = stats.ns_per_particle;
+    stats = {};
+    stats.ns_per_particle = cost_estimate;
+
+    emitters.clear();
+    const uint32_t interval = std::max(settings.reduced_interval, 1u);
+    auto view = registry.view<ParticleEmitterComponent, TransformComponent>();
+    for (auto entity : view)
+    {
+        auto& emitter = view.get<ParticleEmitterComponent>(entity);
+        const auto& transform = view.get<TransformComponent>(entity);
+
+        EmitterWork work;
+        work.emitter = &emitter;
+        work.position = transform.position;
+        work.rotation = glm::mat3(composeTransformMatrix(glm::vec3(0.0f), transform.rotation, glm::vec3(1.0f)));
+        const glm::vec3 to_view = transform.position - view_position;
+        work.distance_sq = glm::dot(to_view, to_view);
+
+        const ParticleLod lod = selectLod(work.distance_sq, emitter.lod);
+        if (lod == ParticleLod::Reduced && emitter.lod != ParticleLod::Reduced)
+        {
+            // Stagger reduced emitters so they do not all update on the same frame
+            emitter.frames_until_update = static_cast<uint32_t>(entt::to_integral(entity)) % interval;
+        }
+        emitter.lod = lod;
+        emitters.push_back(work);
+    }
+    stats.emitters = static_cast<uint32_t>(emitters.size());
+
+    // Nearest first, so the budget is spent where it is seen
+    std::stable_sort(emitters.begin(), emitters.end(),
+        [](const EmitterWork& a, const EmitterWork& b) { return a.distance_sq < b.distance_sq; });
+    applyBudget(dt);
+
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    jobs.parallelFor("Particle spawn", emitters.size(), 8,
+        [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (emitters[i].emitter->lod != ParticleLod::Culled)
+                    emitters[i].spawned = spawn(emitters[i]);
+            }
+        });
+
+    size_t chunk_count = 0;
+    for (EmitterWork& work : emitters)
+    {
+        if (work.dt <= 0.0f || work.emitter->pool.count == 0)
+            continue;
+        work.first_chunk = static_cast<uint32_t>(chunk_count);
+        work.chunk_count = (work.emitter->pool.count + kChunkSize - 1) / kChunkSize;
+        chunk_count += work.chunk_count;
+        stats.particles_updated += work.emitter->pool.count;
+    }
+    if (chunks.size() < chunk_count)
+        chunks.resize(chunk_count);
+    for (uint32_t e = 0; e < emitters.size(); ++e)
+    {
+        const EmitterWork& work = emitters[e];
+        for (uint32_t c = 0; c < work.chunk_count; ++c)
+        {
+            ChunkWork& chunk = chunks[work.first_chunk + c];
+            chunk.emitter = e;
+            chunk.begin = c * kChunkSize;
+            chunk.end = std::min(chunk.begin + kChunkSize, work.emitter->pool.count);
+            chunk.dead.clear();
+            chunk.bounds_min = glm::vec3(std::numeric_limits<float>::max());
+            chunk.bounds_max = glm::vec3(std::numeric_limits<float>::lowest());
+        }
+    }
+
+    jobs.parallelFor("Particle update", chunk_count, 1,
+        [this](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c)
+            {
+                ChunkWork& chunk = chunks[c];
+                const EmitterWork& work = emitters[chunk.emitter];
+                const ParticleEmitterSettings& s = work.emitter->settings;
+                integrate(work.emitter->pool, chunk.begin, chunk.end, work.dt, s.acceleration, s.drag,
+                          chunk.dead, chunk.bounds_min, chunk.bounds_max);
+            }
+        });
+
+    jobs.parallelFor("Particle finish", emitters.size(), 8,
+        [this, view_position](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                finish(emitters[i], view_position);
+        });
+
+    for (const EmitterWork& work : emitters)
+    {
+        stats.live_particles += work.emitter->pool.count;
+        stats.particles_spawned += work.spawned;
+        stats.particles_killed += work.killed;
+        stats.sorted += work.sorted ? 1u : 0u;
+    }
+
+    stats.update_ms = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+    if (stats.particles_updated >= kChunkSize)
+    {
+        // Small frames are dominated by fixed costs and would overstate the per-particle cost
+        const float sample = stats.update_ms * 1.0e6f / static_cast<float>(stats.particles_updated);
+        stats.ns_per_particle = cost_estimate > 0.0f ? cost_estimate * 0.9f + sample * 0.1f : sample;
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Graphics/RenderAPI.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ParticleEmitterComponent;
+
+enum class ParticleLod : uint8_t
+{
+    Full,       // Spawns at its full rate and updates every frame
+    Reduced,    // Spawns at reduced_spawn_scale and updates every reduced_interval frames
+    Culled      // Neither spawns, updates nor draws; its particles wait where they are
+};
+
+struct ParticleEmitterSettings
+{
+    uint32_t max_particles = 1000;
+    float spawn_rate = 100.0f;                          // Particles per second at full LOD
+    float lifetime_min = 1.0f;                          // Seconds
+    float lifetime_max = 2.0f;
+    float spawn_radius = 0.0f;                          // Particles start inside this sphere around the emitter
+    glm::vec3 velocity{0.0f, 1.0f, 0.0f};               // Initial velocity in emitter space
+    glm::vec3 velocity_jitter{0.5f};                    // Added per axis, uniform in [-jitter, jitter]
+    glm::vec3 acceleration{0.0f, -9.81f, 0.0f};         // World space, constant over the lifetime
+    float drag = 0.0f;                                  // Velocity decays by exp(-drag * seconds)
+    float size_start = 0.1f;                            // Quad edge in meters, lerped over the lifetime
+    float size_end = 0.0f;
+    glm::vec3 color{1.0f};
+    BlendMode blend = BlendMode::Additive;              // Alpha-blended emitters are depth sorted
+    bool billboard = true;                              // Face the camera; otherwise keep world axes
+    uint32_t seed = 1;
+
+    bool needsDepthSort() const { return blend == BlendMode::Alpha; }
+};
+
+// Structure-of-arrays particle storage. Live particles are packed at [0, count), so the
+// update kernels stream over plain float arrays four lanes at a time.
+struct ENGINE_API ParticlePool
+{
+    std::vector<float> position_x, position_y, position_z;
+    std::vector<float> velocity_x, velocity_y, velocity_z;
+    std::vector<float> age, lifetime;
+    uint32_t count = 0;
+
+    uint32_t capacity() const { return static_cast<uint32_t>(age.size()); }
+
+    // Keeps the live particles that still fit
+    void setCapacity(uint32_t capacity);
+    void clear() { count = 0; }
+
+    // Moves the last live particle into index. Removing several in descending index order
+    // never moves a particle that is about to be removed.
+    void swapRemove(uint32_t index);
+
+    // Rearranges the live particles so that particle i is the one previously at order[i]
+    void reorder(const uint32_t* order, std::vector<float>& scratch);
+};
+
+struct ParticleBudgetSettings
+{
+    float budget_ms = 2.0f;                 // CPU time for simulating every emitter; 0 is unlimited
+    uint32_t max_particle_updates = 0;      // Hard cap on particle updates per frame; 0 is unlimited
+    float full_distance = 30.0f;            // Full LOD within this distance of the view
+    float reduced_distance = 80.0f;         // Reduced up to here, culled beyond
+    float hysteresis = 2.0f;                // An emitter leaves a tier this far past its boundary
+    uint32_t reduced_interval = 2;          // Frames between updates at reduced LOD
+    float reduced_spawn_scale = 0.25f;      // Spawn rate multiplier at reduced LOD
+};
+
+struct ParticleSystemStats
+{
+    uint32_t emitters = 0;
+    uint32_t full = 0;
+    uint32_t reduced = 0;
+    uint32_t culled = 0;
+    uint32_t throttled = 0;                 // Emitters the budget stopped spawning this frame
+    uint32_t sorted = 0;                    // Emitters depth sorted this frame
+    uint32_t live_particles = 0;
+    uint32_t particles_updated = 0;
+    uint32_t particles_spawned = 0;
+    uint32_t particles_killed = 0;
+    float update_ms = 0.0f;                 // Spawn, simulate, compact and sort
+    float ns_per_particle = 0.0f;           // Smoothed cost estimate the budget is derived from
+};
+
+// Simulates every ParticleEmitterComponent of a registry. Each frame:
+//
+//  1. Emitters get a LOD from their distance to the view, and the budget walks them nearest
+//     first. Once the particles to update exceed what fits in budget_ms (at the measured cost
+//     per particle) or max_particle_updates, the remaining emitters stop spawning and drop to
+//     reduced LOD until their particles die out.
+//  2. Emitters spawn in parallel, each from its own random stream.
+//  3. Pools are cut into fixed chunks across all emitters and integrated in parallel on the job
+//     system with SIMD kernels. Each chunk collects its dead particles and bounds.
+//  4. Emitters compact their pools in parallel, and those that blend by alpha reorder their
+//     particles back to front for the view.
+//
+// The renderer draws each visible emitter with one instanced draw, in pool order.
+class ENGINE_API ParticleSystem
+{
+public:
+    static constexpr uint32_t kChunkSize = 4096;    // Particles per simulation job
+
+    void setSettings(const ParticleBudgetSettings& budget_settings) { settings = budget_settings; }
+    const ParticleBudgetSettings& getSettings() const { return settings; }
+
+    void update(entt::registry& registry, const glm::vec3& view_position, float dt);
+
+    const ParticleSystemStats& getStats() const { return stats; }
+
+    // Advances particles [begin, end) of a pool by dt and appends the indices of those that
+    // died, in ascending order. bounds_min / bounds_max grow to cover the moved particles.
+    static void integrate(ParticlePool& pool, uint32_t begin, uint32_t end, float dt,
+                          const glm::vec3& acceleration, float drag,
+                          std::vector<uint32_t>& dead, glm::vec3& bounds_min, glm::vec3& bounds_max);
+
+private:
+    struct EmitterWork
+    {
+        ParticleEmitterComponent* emitter = nullptr;
+        glm::vec3 position{0.0f};
+        glm::mat3 rotation{1.0f};
+        float distance_sq = 0.0f;
+        float dt = 0.0f;                    // Time simulated this frame, 0 if it does not update
+        float spawn_scale = 1.0f;
+        uint32_t first_chunk = 0;
+        uint32_t chunk_count = 0;
+        uint32_t spawned = 0;
+        uint32_t killed = 0;
+        bool sorted = false;
+    };
+
+    struct ChunkWork
+    {
+        uint32_t emitter = 0;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        std::vector<uint32_t> dead;
+        glm::vec3 bounds_min{0.0f};
+        glm::vec3 bounds_max{0.0f};
+    };
+
+    ParticleLod selectLod(float distance_sq, ParticleLod current) const;
+    void applyBudget(float dt);
+    static uint32_t spawn(EmitterWork& work);
+    void finish(EmitterWork& work, const glm::vec3& view_position);
+    static bool sortBackToFront(ParticlePool& pool, const glm::vec3& view_position);
+
+    ParticleBudgetSettings settings;
+    ParticleSystemStats stats;
+    std::vector<EmitterWork> emitters;
+    std::vector<ChunkWork> chunks;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Per-tick physics state hashes for client/server desync detection.
+// Jolt is built with JPH_CROSS_PLATFORM_DETERMINISTIC, so two worlds that start from
+// the same bodies and apply the same inputs step to bit-identical states on every
+// platform. Comparing a hash per tick tells a simulation desync apart from an input one.
+namespace PhysicsDeterminism
+{
+    constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+    // One 64-bit word into the running hash (murmur finalizer + FNV step)
+    inline uint64_t mixWord(uint64_t hash, uint64_t word)
+    {
+        word ^= word >> 33;
+        word *= 0xff51afd7ed558ccdull;
+        word ^= word >> 33;
+        return (hash ^ word) * 0x100000001b3ull;
+    }
+
+    // Hashes the exact bits, so -0.0 and 0.0 differ like they would in the simulation
+    inline uint64_t mixFloat(uint64_t hash, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return mixWord(hash, bits);
+    }
+}
+
+// Ring of recent state hashes, indexed by simulation tick
+class PhysicsStateHashHistory
+{
+public:
+    static constexpr size_t CAPACITY = 256;
+
+    void record(uint32_t tick, uint64_t hash)
+    {
+        Entry& entry = entries[tick % CAPACITY];
+        entry.tick = tick;
+        entry.hash = hash;
+        entry.valid = true;
+        latest_tick = tick;
+        has_entries = true;
+    }
+
+    bool find(uint32_t tick, uint64_t& out_hash) const
+    {
+        const Entry& entry = entries[tick % CAPACITY];
+        if (!entry.valid || entry.tick != tick)
+            return false;
+        out_hash = entry.hash;
+        return true;
+    }
+
+    void clear()
+    {
+        entries = {};
+        latest_tick = 0;
+        has_entries = false;
+    }
+
+    bool empty() const { return !has_entries; }
+    uint32_t getLatestTick() const { return latest_tick; }
+
+private:
+    struct Entry
+    {
+        uint32_t tick = 0;
+        uint64_t hash = 0;
+        bool valid = false;
+    };
+
+    std::array<Entry, CAPACITY> entries{};
+    uint32_t latest_tick = 0;
+    bool has_entries = false;
+};
+
+struct PhysicsDesyncReport
+{
+    bool detected = false;
+    uint32_t tick = 0;               // First compared tick whose hashes differed
+    uint32_t last_matching_tick = 0; // Latest agreeing tick before it; the divergence happened in between
+    uint64_t local_hash = 0;
+    uint64_t remote_hash = 0;
+    uint32_t comparisons = 0;
+    uint32_t mismatches = 0;
+};
+
+// Compares local and remote hashes tick by tick and keeps the first divergence.
+// Later mismatches are counted but do not overwrite the capture until reset().
+class PhysicsDesyncDetector
+{
+public:
+    // Returns false on a mismatch
+    bool compare(uint32_t tick, uint64_t local_hash, uint64_t remote_hash)
+    {
+        report.comparisons++;
+        if (local_hash == remote_hash)
+        {
+            if (!report.detected)
+                report.last_matching_tick = tick;
+            return true;
+        }
+
+        report.mismatches++;
+        if (!report.detected)
+        {
+            report.detected = true;
+            report.tick = tick;
+            report.local_hash = local_hash;
+            report.remote_hash = remote_hash;
+        }
+        return false;
+    }
+
+    const PhysicsDesyncReport& getReport() const { return report; }
+    bool hasDesync() const { return report.detected; }
+    void reset() { report = {}; }
+
+private:
+    PhysicsDesyncReport report;
+};
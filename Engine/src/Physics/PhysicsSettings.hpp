@@ -4,58 +4,211 @@
 #include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
 #include <Jolt/Physics/Collision/ObjectLayer.h>
 
+#include <array>
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 
+// One bit per object layer. Queries take a mask of the layers they should see.
+using PhysicsLayerMask = uint32_t;
+static constexpr PhysicsLayerMask PHYSICS_ALL_LAYERS = 0xFFFFFFFFu;
+
 namespace PhysicsObjectLayers
 {
+    // Default layer set. Projects can rename, add and rewire layers; see PhysicsLayerSettings.
     static constexpr JPH::ObjectLayer Static = 0;
     static constexpr JPH::ObjectLayer Dynamic = 1;
-    static constexpr JPH::ObjectLayer Count = 2;
+    static constexpr JPH::ObjectLayer Character = 2;
+    static constexpr JPH::ObjectLayer Projectile = 3;
+    static constexpr JPH::ObjectLayer Debris = 4;
+    static constexpr JPH::ObjectLayer Trigger = 5;
+    static constexpr JPH::ObjectLayer Query = 6;
+    static constexpr JPH::ObjectLayer Count = 7;
+
+    static constexpr JPH::ObjectLayer Max = 32; // One bit per layer in PhysicsLayerMask
 }
 
+// Every object layer maps onto one of these broadphase trees. Jolt keeps one tree per
+// broadphase layer, so bodies that rarely need each other (static geometry, thousands of
+// debris pieces, query-only volumes) stay in separate trees and are not walked together.
 namespace PhysicsBroadPhaseLayers
 {
     static constexpr JPH::BroadPhaseLayer Static(0);
-    static constexpr JPH::BroadPhaseLayer Dynamic(1);
-    static constexpr uint32_t Count = 2;
+    static constexpr JPH::BroadPhaseLayer Moving(1);
+    static constexpr JPH::BroadPhaseLayer Debris(2);
+    static constexpr JPH::BroadPhaseLayer Query(3);
+    static constexpr uint32_t Count = 4;
+
+    static constexpr JPH::BroadPhaseLayer Dynamic = Moving;
+}
+
+inline const char* getPhysicsBroadPhaseName(JPH::BroadPhaseLayer broad_phase)
+{
+    switch (broad_phase.GetValue()) {
+        case 0: return "Static";
+        case 1: return "Moving";
+        case 2: return "Debris";
+        case 3: return "Query";
+        default: return "Invalid";
+    }
+}
+
+// Returns false if name is not one of the names getPhysicsBroadPhaseName produces
+inline bool findPhysicsBroadPhase(std::string_view name, JPH::BroadPhaseLayer& out_broad_phase)
+{
+    for (uint32_t i = 0; i < PhysicsBroadPhaseLayers::Count; ++i) {
+        const JPH::BroadPhaseLayer candidate(static_cast<JPH::BroadPhaseLayer::Type>(i));
+        if (name == getPhysicsBroadPhaseName(candidate)) {
+            out_broad_phase = candidate;
+            return true;
+        }
+    }
+    return false;
 }
 
+// Named object layers, the symmetric collision matrix between them, and the broadphase tree
+// each one lives in. Jolt calls the filters below for every candidate pair, so they are
+// single bit tests against masks precomputed by setCollides/setBroadPhase.
 struct PhysicsLayerSettings
 {
+    // Layers the engine assigns by motion type when a body does not name one
     JPH::ObjectLayer static_body = PhysicsObjectLayers::Static;
     JPH::ObjectLayer dynamic_body = PhysicsObjectLayers::Dynamic;
-    JPH::ObjectLayer object_layer_count = PhysicsObjectLayers::Count;
+    JPH::ObjectLayer character_body = PhysicsObjectLayers::Character;
+    JPH::ObjectLayer object_layer_count = 0;
 
-    JPH::BroadPhaseLayer static_broad_phase = PhysicsBroadPhaseLayers::Static;
-    JPH::BroadPhaseLayer dynamic_broad_phase = PhysicsBroadPhaseLayers::Dynamic;
     uint32_t broad_phase_layer_count = PhysicsBroadPhaseLayers::Count;
 
+    std::array<std::string, PhysicsObjectLayers::Max> names;
+    std::array<JPH::BroadPhaseLayer, PhysicsObjectLayers::Max> broad_phases{};
+    std::array<PhysicsLayerMask, PhysicsObjectLayers::Max> collides_with{};
+    std::array<uint32_t, PhysicsObjectLayers::Max> broad_phase_masks{}; // Trees each layer has to test against
+
+    PhysicsLayerSettings()
+    {
+        using namespace PhysicsObjectLayers;
+
+        addLayer("Static", PhysicsBroadPhaseLayers::Static);
+        addLayer("Dynamic", PhysicsBroadPhaseLayers::Moving);
+        addLayer("Character", PhysicsBroadPhaseLayers::Moving);
+        addLayer("Projectile", PhysicsBroadPhaseLayers::Moving);
+        addLayer("Debris", PhysicsBroadPhaseLayers::Debris);
+        addLayer("Trigger", PhysicsBroadPhaseLayers::Query);
+        addLayer("Query", PhysicsBroadPhaseLayers::Query);
+
+        for (JPH::ObjectLayer layer : {Static, Dynamic, Character, Projectile, Debris, Trigger})
+            setCollides(Dynamic, layer, true);
+        for (JPH::ObjectLayer layer : {Static, Character, Projectile, Trigger})
+            setCollides(Character, layer, true);
+        setCollides(Static, Projectile, true);
+        setCollides(Static, Debris, true);
+    }
+
+    // Removes every layer, including the defaults. The motion-type layers must be reassigned.
+    void clearLayers()
+    {
+        object_layer_count = 0;
+        names.fill({});
+        broad_phases.fill({});
+        collides_with.fill(0);
+        broad_phase_masks.fill(0);
+    }
+
+    // Returns JPH::cObjectLayerInvalid when all PhysicsObjectLayers::Max layers are in use.
+    // A new layer collides with nothing until setCollides is called.
+    JPH::ObjectLayer addLayer(std::string_view name, JPH::BroadPhaseLayer broad_phase)
+    {
+        if (object_layer_count >= PhysicsObjectLayers::Max)
+            return JPH::cObjectLayerInvalid;
+
+        const JPH::ObjectLayer layer = object_layer_count++;
+        names[layer] = std::string(name);
+        broad_phases[layer] = broad_phase;
+        collides_with[layer] = 0;
+        broad_phase_masks[layer] = 0;
+        return layer;
+    }
+
+    void setBroadPhase(JPH::ObjectLayer layer, JPH::BroadPhaseLayer broad_phase)
+    {
+        if (!isValidLayer(layer))
+            return;
+        broad_phases[layer] = broad_phase;
+        rebuildBroadPhaseMasks();
+    }
+
+    void setCollides(JPH::ObjectLayer a, JPH::ObjectLayer b, bool collides)
+    {
+        if (!isValidLayer(a) || !isValidLayer(b))
+            return;
+
+        if (collides) {
+            collides_with[a] |= layerBit(b);
+            collides_with[b] |= layerBit(a);
+        } else {
+            collides_with[a] &= ~layerBit(b);
+            collides_with[b] &= ~layerBit(a);
+        }
+        rebuildBroadPhaseMasks();
+    }
+
+    bool isValidLayer(JPH::ObjectLayer layer) const { return layer < object_layer_count; }
+
+    // Returns JPH::cObjectLayerInvalid if no layer has this name
+    JPH::ObjectLayer findLayer(std::string_view name) const
+    {
+        for (JPH::ObjectLayer layer = 0; layer < object_layer_count; ++layer) {
+            if (names[layer] == name)
+                return layer;
+        }
+        return JPH::cObjectLayerInvalid;
+    }
+
+    static PhysicsLayerMask layerBit(JPH::ObjectLayer layer)
+    {
+        return layer < PhysicsObjectLayers::Max ? (PhysicsLayerMask(1) << layer) : 0;
+    }
+
+    // Mask of the named layer, or 0 if there is no such layer
+    PhysicsLayerMask getLayerMask(std::string_view name) const { return layerBit(findLayer(name)); }
+
+    // Broadphase trees that contain at least one layer in layer_mask
+    uint32_t getBroadPhaseMask(PhysicsLayerMask layer_mask) const
+    {
+        uint32_t mask = 0;
+        for (JPH::ObjectLayer layer = 0; layer < object_layer_count; ++layer) {
+            if (layer_mask & layerBit(layer))
+                mask |= 1u << broad_phases[layer].GetValue();
+        }
+        return mask;
+    }
+
     bool shouldObjectCollideWithBroadPhase(JPH::ObjectLayer object_layer, JPH::BroadPhaseLayer broad_phase_layer) const
     {
-        if (object_layer == static_body)
-            return broad_phase_layer == dynamic_broad_phase;
-        if (object_layer == dynamic_body)
-            return true;
-        return false;
+        if (!isValidLayer(object_layer))
+            return false;
+        return (broad_phase_masks[object_layer] >> broad_phase_layer.GetValue()) & 1u;
     }
 
     bool shouldObjectsCollide(JPH::ObjectLayer a, JPH::ObjectLayer b) const
     {
-        if (a == static_body)
-            return b == dynamic_body;
-        if (a == dynamic_body)
-            return true;
-        return false;
+        if (!isValidLayer(a))
+            return false;
+        return (collides_with[a] & layerBit(b)) != 0;
     }
 
     JPH::BroadPhaseLayer broadPhaseForObjectLayer(JPH::ObjectLayer object_layer) const
     {
-        if (object_layer == static_body)
-            return static_broad_phase;
-        if (object_layer == dynamic_body)
-            return dynamic_broad_phase;
-        return dynamic_broad_phase;
+        if (!isValidLayer(object_layer))
+            return PhysicsBroadPhaseLayers::Moving;
+        return broad_phases[object_layer];
+    }
+
+    void rebuildBroadPhaseMasks()
+    {
+        for (JPH::ObjectLayer layer = 0; layer < object_layer_count; ++layer)
+            broad_phase_masks[layer] = getBroadPhaseMask(collides_with[layer]);
     }
 };
 
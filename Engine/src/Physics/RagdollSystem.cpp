@@ -0,0 +1,688 @@
+#include "Physics/RagdollSystem.hpp"
+
+#include "Animation/Skeleton.hpp"
+#include "Components/AnimationComponent.hpp"
+#include "Components/Components.hpp"
+#include "Components/RagdollComponent.hpp"
+#include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
+
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Constraints/SwingTwistConstraint.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Skeleton/Skeleton.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    JPH::Vec3 toJolt(const glm::vec3& v)
+    {
+        return JPH::Vec3(v.x, v.y, v.z);
+    }
+
+    JPH::Quat toJolt(const glm::quat& q)
+    {
+        return JPH::Quat(q.x, q.y, q.z, q.w);
+    }
+
+    glm::vec3 toGlm(const JPH::Vec3& v)
+    {
+        return glm::vec3(v.GetX(), v.GetY(), v.GetZ());
+    }
+
+    glm::quat toGlm(const JPH::Quat& q)
+    {
+        return glm::quat(q.GetW(), q.GetX(), q.GetY(), q.GetZ());
+    }
+
+    // Rotation of a transform that may carry scale
+    glm::quat rotationOf(const glm::mat4& m)
+    {
+        const glm::mat3 basis(glm::normalize(glm::vec3(m[0])),
+                              glm::normalize(glm::vec3(m[1])),
+                              glm::normalize(glm::vec3(m[2])));
+        return glm::normalize(glm::quat_cast(basis));
+    }
+
+    void bindPose(const Skeleton& skeleton, Pose& out_pose)
+    {
+        std::vector<glm::mat4> locals;
+        locals.reserve(skeleton.getBones().size());
+        for (const Bone& bone : skeleton.getBones())
+            locals.push_back(bone.local_transform);
+        out_pose.fromMatrices(locals);
+    }
+
+    glm::mat4 modelToWorld(entt::registry& registry, entt::entity entity)
+    {
+        auto* transform = registry.try_get<TransformComponent>(entity);
+        return transform ? transform->getTransformMatrix() : glm::mat4(1.0f);
+    }
+
+    // End of a part's capsule in model space, from the profile or the hierarchy
+    glm::vec3 partEnd(const Skeleton& skeleton,
+                      const std::vector<glm::mat4>& bind_global,
+                      const RagdollBoneDesc& desc,
+                      int bone,
+                      int joint,
+                      const std::vector<int>& joint_to_bone,
+                      const std::vector<int>& joint_parent)
+    {
+        const std::vector<Bone>& bones = skeleton.getBones();
+        const glm::vec3 start(bind_global[bone][3]);
+
+        if (!desc.end_bone.empty())
+        {
+            const int end_bone = skeleton.getBoneIndex(desc.end_bone);
+            if (end_bone >= 0)
+                return glm::vec3(bind_global[end_bone][3]);
+            LOG_ENGINE_WARN("Ragdoll part '{}': end bone '{}' not found", desc.bone, desc.end_bone);
+        }
+
+        for (size_t child = 0; child < joint_parent.size(); ++child)
+        {
+            if (joint_parent[child] == joint)
+                return glm::vec3(bind_global[joint_to_bone[child]][3]);
+        }
+
+        for (size_t child = 0; child < bones.size(); ++child)
+        {
+            if (bones[child].parent_id == bone)
+                return glm::vec3(bind_global[child][3]);
+        }
+
+        // Leaf: continue along the parent bone
+        glm::vec3 direction(0.0f, 1.0f, 0.0f);
+        if (joint_parent[joint] >= 0)
+        {
+            const glm::vec3 offset = start - glm::vec3(bind_global[joint_to_bone[joint_parent[joint]]][3]);
+            if (glm::length(offset) > 1.0e-4f)
+                direction = glm::normalize(offset);
+        }
+        return start + direction * desc.length;
+    }
+}
+
+std::shared_ptr<RagdollDefinition> RagdollDefinition::build(const Skeleton& skeleton,
+                                                            const RagdollProfile& profile,
+                                                            const PhysicsLayerSettings& layers)
+{
+    const std::vector<Bone>& bones = skeleton.getBones();
+    const int bone_count = skeleton.getBoneCount();
+
+    // Skeletons store parents before children, so sorting the parts by bone index gives
+    // Jolt the parent-first joint order it needs
+    std::vector<std::pair<int, const RagdollBoneDesc*>> parts;
+    for (const RagdollBoneDesc& desc : profile.bones)
+    {
+        const int bone = skeleton.getBoneIndex(desc.bone);
+        if (bone < 0)
+        {
+            LOG_ENGINE_WARN("Ragdoll profile bone '{}' not found in skeleton", desc.bone);
+            continue;
+        }
+        const bool duplicate = std::any_of(parts.begin(), parts.end(),
+            [bone](const auto& part) { return part.first == bone; });
+        if (!duplicate)
+            parts.emplace_back(bone, &desc);
+    }
+    if (parts.empty())
+    {
+        LOG_ENGINE_ERROR("Ragdoll profile matches no bone of the skeleton");
+        return nullptr;
+    }
+    std::sort(parts.begin(), parts.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto definition = std::make_shared<RagdollDefinition>();
+    definition->bone_to_joint.assign(bone_count, -1);
+    definition->joint_to_bone.reserve(parts.size());
+    std::vector<int> joint_parent;
+    joint_parent.reserve(parts.size());
+
+    JPH::Ref<JPH::Skeleton> joints = new JPH::Skeleton;
+    for (const auto& [bone, desc] : parts)
+    {
+        int parent_joint = -1;
+        for (int ancestor = bones[bone].parent_id; ancestor >= 0 && parent_joint < 0; ancestor = bones[ancestor].parent_id)
+            parent_joint = definition->bone_to_joint[ancestor];
+
+        // Jolt drives and poses ragdolls from a single root at index 0 (the sort puts it
+        // first) and looks up a parent constraint for every later part
+        if (parent_joint < 0 && !definition->joint_to_bone.empty())
+        {
+            LOG_ENGINE_ERROR("Ragdoll profile has more than one root part: '{}' has no ancestor part, root is '{}'",
+                             bones[bone].name, bones[parts.front().first].name);
+            return nullptr;
+        }
+
+        const int joint = static_cast<int>(joints->AddJoint(bones[bone].name, parent_joint));
+        definition->bone_to_joint[bone] = joint;
+        definition->joint_to_bone.push_back(bone);
+        joint_parent.push_back(parent_joint);
+    }
+
+    JPH::ObjectLayer layer = layers.dynamic_body;
+    if (!profile.collision_layer.empty())
+    {
+        const JPH::ObjectLayer named = layers.findLayer(profile.collision_layer);
+        if (named != JPH::cObjectLayerInvalid)
+            layer = named;
+        else
+            LOG_ENGINE_WARN("Ragdoll collision layer '{}' not found, using the dynamic layer", profile.collision_layer);
+    }
+
+    std::vector<glm::mat4> bind_global;
+    skeleton.computeGlobalTransforms(Pose(), bind_global);
+
+    definition->settings = new JPH::RagdollSettings;
+    JPH::RagdollSettings& settings = *definition->settings;
+    settings.mSkeleton = joints;
+    settings.mParts.resize(parts.size());
+    std::vector<JPH::Mat44> bind_matrices(parts.size());
+
+    for (size_t joint = 0; joint < parts.size(); ++joint)
+    {
+        const int bone = parts[joint].first;
+        const RagdollBoneDesc& desc = *parts[joint].second;
+
+        // Bodies sit on their joint with the bone's bind orientation, so a body's rotation
+        // relative to its parent is the joint's local rotation the motors are driven with
+        const glm::vec3 position(bind_global[bone][3]);
+        const glm::quat rotation = rotationOf(bind_global[bone]);
+        const glm::vec3 end = partEnd(skeleton, bind_global, desc, bone, static_cast<int>(joint),
+                                      definition->joint_to_bone, joint_parent);
+
+        glm::vec3 axis = end - position;
+        float length = glm::length(axis);
+        if (length < 1.0e-4f)
+        {
+            axis = glm::vec3(0.0f, 1.0f, 0.0f);
+            length = desc.length;
+        }
+        else
+        {
+            axis /= length;
+        }
+
+        const float radius = std::max(desc.radius, 0.01f);
+        const float half_height = length * 0.5f - radius;
+        JPH::Ref<JPH::ShapeSettings> segment;
+        if (half_height > 0.01f)
+            segment = new JPH::CapsuleShapeSettings(half_height, radius);
+        else
+            segment = new JPH::SphereShapeSettings(radius);
+
+        const glm::vec3 local_axis = glm::inverse(rotation) * axis;
+        JPH::Ref<JPH::ShapeSettings> shape = new JPH::RotatedTranslatedShapeSettings(
+            toJolt(local_axis * (length * 0.5f)),
+            JPH::Quat::sFromTo(JPH::Vec3::sAxisY(), toJolt(local_axis)),
+            segment);
+        JPH::ShapeSettings::ShapeResult shape_result = shape->Create();
+        if (shape_result.HasError())
+        {
+            LOG_ENGINE_ERROR("Ragdoll part '{}': {}", desc.bone, shape_result.GetError().c_str());
+            return nullptr;
+        }
+
+        JPH::RagdollSettings::Part& part = settings.mParts[joint];
+        part.SetShape(shape_result.Get());
+        part.mPosition = JPH::RVec3(position.x, position.y, position.z);
+        part.mRotation = toJolt(rotation);
+        bind_matrices[joint] = JPH::Mat44::sRotationTranslation(part.mRotation, toJolt(position));
+        part.mMotionType = JPH::EMotionType::Dynamic;
+        part.mObjectLayer = layer;
+        part.mFriction = profile.friction;
+        part.mRestitution = profile.restitution;
+        part.mLinearDamping = profile.linear_damping;
+        part.mAngularDamping = profile.angular_damping;
+        if (desc.mass > 0.0f)
+        {
+            part.mOverrideMassProperties = JPH::EOverrideMassProperties::CalculateInertia;
+            part.mMassPropertiesOverride.mMass = desc.mass;
+        }
+
+        if (joint_parent[joint] < 0)
+            continue;
+
+        JPH::Ref<JPH::SwingTwistConstraintSettings> constraint = new JPH::SwingTwistConstraintSettings;
+        constraint->mSpace = JPH::EConstraintSpace::WorldSpace;
+        constraint->mPosition1 = constraint->mPosition2 = part.mPosition;
+        constraint->mTwistAxis1 = constraint->mTwistAxis2 = toJolt(axis);
+        constraint->mPlaneAxis1 = constraint->mPlaneAxis2 = toJolt(axis).GetNormalizedPerpendicular();
+        constraint->mNormalHalfConeAngle = glm::radians(desc.swing_limit_degrees);
+        constraint->mPlaneHalfConeAngle = glm::radians(desc.swing_limit_degrees);
+        constraint->mTwistMinAngle = glm::radians(std::min(desc.twist_min_degrees, desc.twist_max_degrees));
+        constraint->mTwistMaxAngle = glm::radians(std::max(desc.twist_min_degrees, desc.twist_max_degrees));
+        constraint->mMaxFrictionTorque = profile.joint_friction_torque;
+        constraint->mSwingMotorSettings = JPH::MotorSettings(profile.motor_frequency, profile.motor_damping);
+        constraint->mSwingMotorSettings.SetTorqueLimit(profile.max_motor_torque);
+        constraint->mTwistMotorSettings = constraint->mSwingMotorSettings;
+        part.mToParent = constraint;
+    }
+
+    if (!settings.Stabilize())
+        LOG_ENGINE_WARN("Ragdoll mass stabilization failed");
+    // Neighbours that already touch in the bind pose (upper arms against the chest) would
+    // push each other apart forever, so they don't collide either
+    settings.DisableParentChildCollisions(bind_matrices.data(), 0.01f);
+    settings.CalculateBodyIndexToConstraintIndex();
+    settings.CalculateConstraintIndexToBodyIdxPair();
+    return definition;
+}
+
+RagdollSystem::RagdollSystem() = default;
+RagdollSystem::~RagdollSystem() = default;
+
+void RagdollSystem::shutdown(BodyEntityMap& body_to_entity)
+{
+    for (auto& [entity, instance] : instances)
+    {
+        for (const JPH::BodyID& body_id : instance.ragdoll->GetBodyIDs())
+            body_to_entity.erase(body_id);
+        instance.ragdoll->RemoveFromPhysicsSystem();
+    }
+    instances.clear();
+    definitions.clear();
+}
+
+size_t RagdollSystem::getPooledCount() const
+{
+    size_t count = 0;
+    for (const DefinitionEntry& entry : definitions)
+        count += entry.definition->pool.size();
+    return count;
+}
+
+const JPH::Array<JPH::BodyID>* RagdollSystem::getBodyIDs(entt::entity entity) const
+{
+    auto it = instances.find(entity);
+    return it != instances.end() ? &it->second.ragdoll->GetBodyIDs() : nullptr;
+}
+
+std::shared_ptr<RagdollDefinition> RagdollSystem::findDefinition(const std::shared_ptr<Skeleton>& skeleton,
+                                                                 const std::shared_ptr<const RagdollProfile>& profile,
+                                                                 const PhysicsLayerSettings& layers)
+{
+    // Entries whose skeleton or profile is gone take their pool with them; live
+    // instances keep their definition alive until they are released
+    definitions.erase(std::remove_if(definitions.begin(), definitions.end(), [](const DefinitionEntry& entry) {
+        return entry.skeleton.expired() || entry.profile.expired();
+    }), definitions.end());
+
+    for (const DefinitionEntry& entry : definitions)
+    {
+        if (entry.skeleton.lock() == skeleton && entry.profile.lock() == profile)
+            return entry.definition;
+    }
+
+    std::shared_ptr<RagdollDefinition> definition = RagdollDefinition::build(*skeleton, *profile, layers);
+    if (definition)
+        definitions.push_back({skeleton, profile, definition});
+    return definition;
+}
+
+void RagdollSystem::prewarm(const std::shared_ptr<Skeleton>& skeleton,
+                            const std::shared_ptr<const RagdollProfile>& profile,
+                            size_t count,
+                            JPH::PhysicsSystem& physics_system,
+                            const PhysicsLayerSettings& layers)
+{
+    if (!skeleton || !profile)
+        return;
+
+    std::shared_ptr<RagdollDefinition> definition = findDefinition(skeleton, profile, layers);
+    if (!definition)
+        return;
+
+    while (definition->pool.size() < count)
+    {
+        JPH::Ref<JPH::Ragdoll> ragdoll = definition->settings->CreateRagdoll(next_group_id++, 0, &physics_system);
+        if (!ragdoll)
+        {
+            LOG_ENGINE_WARN("Ragdoll prewarm stopped at {} instances: out of bodies", definition->pool.size());
+            return;
+        }
+        definition->pool.push_back(ragdoll);
+    }
+}
+
+bool RagdollSystem::acquire(entt::registry& registry,
+                            entt::entity entity,
+                            RagdollComponent& component,
+                            const std::shared_ptr<Skeleton>& skeleton,
+                            JPH::PhysicsSystem& physics_system,
+                            BodyEntityMap& body_to_entity,
+                            const PhysicsLayerSettings& layers,
+                            RagdollStats& stats)
+{
+    std::shared_ptr<RagdollDefinition> definition = findDefinition(skeleton, component.profile, layers);
+    if (!definition)
+        return false;
+
+    JPH::Ref<JPH::Ragdoll> ragdoll;
+    if (!definition->pool.empty())
+    {
+        ragdoll = definition->pool.back();
+        definition->pool.pop_back();
+    }
+    else
+    {
+        ragdoll = definition->settings->CreateRagdoll(next_group_id++, 0, &physics_system);
+        if (!ragdoll)
+        {
+            LOG_ENGINE_WARN("Cannot create ragdoll: out of bodies");
+            return false;
+        }
+        ++stats.created;
+    }
+
+    Instance& instance = instances[entity];
+    instance = Instance{};
+    instance.definition = definition;
+    instance.skeleton = skeleton;
+    instance.profile = component.profile;
+    instance.ragdoll = ragdoll;
+    instance.target.SetSkeleton(definition->settings->GetSkeleton());
+    instance.joint_matrices.resize(definition->getJointCount());
+
+    // Start from the last animated pose, or the bind pose before the first animation update
+    if (component.animated_pose.getBoneCount() != skeleton->getBoneCount())
+        bindPose(*skeleton, component.animated_pose);
+    skeleton->computeGlobalTransforms(component.animated_pose, scratch_globals);
+
+    const glm::mat4 model_to_world = modelToWorld(registry, entity);
+    const glm::vec3 root_offset(model_to_world[3]);
+    for (size_t joint = 0; joint < instance.joint_matrices.size(); ++joint)
+    {
+        const glm::mat4 world = model_to_world * scratch_globals[definition->joint_to_bone[joint]];
+        instance.joint_matrices[joint] = JPH::Mat44::sRotationTranslation(toJolt(rotationOf(world)),
+                                                                          toJolt(glm::vec3(world[3]) - root_offset));
+    }
+
+    ragdoll->SetPose(JPH::RVec3(root_offset.x, root_offset.y, root_offset.z), instance.joint_matrices.data());
+    ragdoll->ResetWarmStart();
+    ragdoll->SetLinearAndAngularVelocity(toJolt(component.initial_velocity), JPH::Vec3::sZero());
+    applyMotorTorque(instance, 0.0f);
+    ragdoll->AddToPhysicsSystem(JPH::EActivation::Activate);
+
+    for (const JPH::BodyID& body_id : ragdoll->GetBodyIDs())
+        body_to_entity[body_id] = entity;
+
+    component.awake = true;
+    component.has_physics_pose = false;
+    return true;
+}
+
+void RagdollSystem::release(Instance& instance, BodyEntityMap& body_to_entity, const RagdollLodSettings& settings)
+{
+    for (const JPH::BodyID& body_id : instance.ragdoll->GetBodyIDs())
+        body_to_entity.erase(body_id);
+    instance.ragdoll->RemoveFromPhysicsSystem();
+
+    // Pooled ragdolls keep their bodies allocated in Jolt, so the pool is capped
+    std::vector<JPH::Ref<JPH::Ragdoll>>& pool = instance.definition->pool;
+    if (pool.size() < settings.max_pooled_per_profile)
+    {
+        setSolverSteps(instance, 0, 0);
+        pool.push_back(instance.ragdoll);
+    }
+    instance.ragdoll = nullptr;
+}
+
+void RagdollSystem::setSolverSteps(Instance& instance, uint32_t velocity_steps, uint32_t position_steps)
+{
+    for (size_t i = 0; i < instance.ragdoll->GetConstraintCount(); ++i)
+    {
+        JPH::TwoBodyConstraint* constraint = instance.ragdoll->GetConstraint(static_cast<int>(i));
+        constraint->SetNumVelocityStepsOverride(velocity_steps);
+        constraint->SetNumPositionStepsOverride(position_steps);
+    }
+}
+
+void RagdollSystem::applyMotorTorque(Instance& instance, float torque)
+{
+    for (size_t i = 0; i < instance.ragdoll->GetConstraintCount(); ++i)
+    {
+        JPH::TwoBodyConstraint* constraint = instance.ragdoll->GetConstraint(static_cast<int>(i));
+        if (constraint->GetSubType() != JPH::EConstraintSubType::SwingTwist)
+            continue;
+
+        auto* swing_twist = static_cast<JPH::SwingTwistConstraint*>(constraint);
+        swing_twist->GetSwingMotorSettings().SetTorqueLimit(torque);
+        swing_twist->GetTwistMotorSettings().SetTorqueLimit(torque);
+        if (torque <= 0.0f)
+        {
+            // Off leaves only the joint friction
+            swing_twist->SetSwingMotorState(JPH::EMotorState::Off);
+            swing_twist->SetTwistMotorState(JPH::EMotorState::Off);
+        }
+    }
+    instance.motor_torque = torque;
+}
+
+void RagdollSystem::applyLod(Instance& instance, RagdollLod lod, JPH::PhysicsSystem& physics_system,
+                             const RagdollLodSettings& settings)
+{
+    const JPH::Array<JPH::BodyID>& bodies = instance.ragdoll->GetBodyIDs();
+    JPH::BodyInterface& body_interface = physics_system.GetBodyInterface();
+
+    switch (lod)
+    {
+        case RagdollLod::Full:
+            setSolverSteps(instance, 0, 0);
+            break;
+        case RagdollLod::Reduced:
+            setSolverSteps(instance, settings.reduced_velocity_steps, settings.reduced_position_steps);
+            applyMotorTorque(instance, 0.0f);
+            instance.still_time = 0.0f;
+            break;
+        case RagdollLod::Frozen:
+            applyMotorTorque(instance, 0.0f);
+            instance.frozen_awake = instance.ragdoll->IsActive();
+            body_interface.DeactivateBodies(bodies.data(), static_cast<int>(bodies.size()));
+            break;
+    }
+
+    // A ragdoll frozen mid-fall carries on when the camera comes back
+    if (lod != RagdollLod::Frozen && instance.frozen_awake)
+    {
+        body_interface.ActivateBodies(bodies.data(), static_cast<int>(bodies.size()));
+        instance.frozen_awake = false;
+    }
+    instance.lod_applied = true;
+}
+
+bool RagdollSystem::driveMotors(Instance& instance, const RagdollComponent& component)
+{
+    const RagdollDefinition& definition = *instance.definition;
+    const JPH::Skeleton& joints = *definition.settings->GetSkeleton();
+    instance.skeleton->computeGlobalTransforms(component.animated_pose, scratch_globals);
+
+    bool changed = false;
+    for (size_t joint = 0; joint < definition.getJointCount(); ++joint)
+    {
+        const glm::quat rotation = rotationOf(scratch_globals[definition.joint_to_bone[joint]]);
+        const int parent = joints.GetJoint(static_cast<int>(joint)).mParentJointIndex;
+        const glm::quat local = parent >= 0
+            ? glm::inverse(rotationOf(scratch_globals[definition.joint_to_bone[parent]])) * rotation
+            : rotation;
+
+        JPH::Quat& target = instance.target.GetJoint(static_cast<int>(joint)).mRotation;
+        const JPH::Quat next = toJolt(glm::normalize(local));
+        if (std::abs(target.Dot(next)) < 0.99999f)
+            changed = true;
+        target = next;
+    }
+
+    instance.ragdoll->DriveToPoseUsingMotors(instance.target);
+    return changed;
+}
+
+void RagdollSystem::readPose(Instance& instance, RagdollComponent& component, const glm::mat4& model_to_world)
+{
+    const RagdollDefinition& definition = *instance.definition;
+    const Skeleton& skeleton = *instance.skeleton;
+    const std::vector<Bone>& bones = skeleton.getBones();
+    const int bone_count = skeleton.getBoneCount();
+
+    JPH::RVec3 root_offset;
+    instance.ragdoll->GetPose(root_offset, instance.joint_matrices.data());
+
+    // Bones outside the ragdoll keep their animated local transform and follow their
+    // simulated parent
+    const Pose& animated = component.animated_pose;
+    Pose& out_pose = component.physics_pose;
+    out_pose = animated;
+
+    const glm::mat4 world_to_model = glm::inverse(model_to_world);
+    const glm::vec3 offset(float(root_offset.GetX()), float(root_offset.GetY()), float(root_offset.GetZ()));
+    scratch_globals.resize(bone_count);
+    for (int bone = 0; bone < bone_count; ++bone)
+    {
+        const int parent = bones[bone].parent_id;
+        const glm::mat4 parent_global = parent >= 0 ? scratch_globals[parent] : glm::mat4(1.0f);
+        const int joint = definition.bone_to_joint[bone];
+        if (joint >= 0)
+        {
+            const JPH::Mat44& body = instance.joint_matrices[joint];
+            const glm::mat4 world = glm::translate(glm::mat4(1.0f), offset + toGlm(body.GetTranslation()))
+                * glm::mat4_cast(toGlm(body.GetQuaternion()));
+            const glm::mat4 local = glm::inverse(parent_global) * (world_to_model * world);
+
+            out_pose[bone].translation = glm::vec3(local[3]);
+            out_pose[bone].rotation = rotationOf(local);
+        }
+        scratch_globals[bone] = parent_global * out_pose[bone].toMatrix();
+    }
+
+    component.has_physics_pose = true;
+    component.pose_model_to_world = model_to_world;
+}
+
+void RagdollSystem::update(entt::registry& registry,
+                           JPH::PhysicsSystem& physics_system,
+                           BodyEntityMap& body_to_entity,
+                           const PhysicsLayerSettings& layers,
+                           const glm::vec3& camera_position,
+                           float dt,
+                           const RagdollLodSettings& settings,
+                           RagdollStats* out_stats)
+{
+    MemoryTagScope memory_tag(MemoryTag::Physics);
+    RagdollStats stats;
+
+    // Return ragdolls whose entity stopped simulating, lost its component or was destroyed
+    for (auto it = instances.begin(); it != instances.end();)
+    {
+        auto* component = registry.valid(it->first) ? registry.try_get<RagdollComponent>(it->first) : nullptr;
+        auto* anim = registry.valid(it->first) ? registry.try_get<AnimationComponent>(it->first) : nullptr;
+        if (component && component->simulate && component->profile == it->second.profile
+            && anim && anim->skeleton == it->second.skeleton)
+        {
+            ++it;
+            continue;
+        }
+
+        if (component)
+        {
+            component->awake = false;
+            component->has_physics_pose = false;
+        }
+        release(it->second, body_to_entity, settings);
+        it = instances.erase(it);
+    }
+
+    auto view = registry.view<RagdollComponent, AnimationComponent>();
+    for (auto entity : view)
+    {
+        auto& component = view.get<RagdollComponent>(entity);
+        auto& anim = view.get<AnimationComponent>(entity);
+        if (!component.simulate || has(entity))
+            continue;
+
+        if (!component.profile || !anim.skeleton
+            || !acquire(registry, entity, component, anim.skeleton, physics_system, body_to_entity, layers, stats))
+        {
+            LOG_ENGINE_WARN("Entity {} cannot start its ragdoll", entt::to_integral(entity));
+            component.simulate = false;
+        }
+    }
+
+    JPH::BodyInterface& body_interface = physics_system.GetBodyInterface();
+    for (auto& [entity, instance] : instances)
+    {
+        auto& component = registry.get<RagdollComponent>(entity);
+
+        JPH::RVec3 root_position;
+        JPH::Quat root_rotation;
+        instance.ragdoll->GetRootTransform(root_position, root_rotation);
+        const glm::vec3 root(float(root_position.GetX()), float(root_position.GetY()), float(root_position.GetZ()));
+        const float distance = glm::length(root - camera_position);
+
+        const RagdollLod lod = distance <= settings.full_distance ? RagdollLod::Full
+            : distance <= settings.reduced_distance ? RagdollLod::Reduced
+            : RagdollLod::Frozen;
+        if (lod != component.lod || !instance.lod_applied)
+        {
+            applyLod(instance, lod, physics_system, settings);
+            component.lod = lod;
+        }
+
+        bool awake = instance.ragdoll->IsActive();
+        const glm::mat4 model_to_world = modelToWorld(registry, entity);
+        if (awake || !component.has_physics_pose || model_to_world != component.pose_model_to_world)
+            readPose(instance, component, model_to_world);
+
+        // Reduced ragdolls sleep as soon as they settle instead of waiting out Jolt's timer
+        if (lod == RagdollLod::Reduced && awake)
+        {
+            float max_speed = 0.0f;
+            for (const JPH::BodyID& body_id : instance.ragdoll->GetBodyIDs())
+                max_speed = std::max(max_speed, body_interface.GetLinearVelocity(body_id).Length());
+
+            instance.still_time = max_speed < settings.sleep_speed ? instance.still_time + dt : 0.0f;
+            if (instance.still_time >= settings.sleep_time)
+            {
+                const JPH::Array<JPH::BodyID>& bodies = instance.ragdoll->GetBodyIDs();
+                body_interface.DeactivateBodies(bodies.data(), static_cast<int>(bodies.size()));
+                instance.still_time = 0.0f;
+                awake = false;
+                ++stats.put_to_sleep;
+            }
+        }
+
+        if (lod == RagdollLod::Full)
+        {
+            const float torque = instance.profile->max_motor_torque * std::clamp(component.motor_strength, 0.0f, 1.0f);
+            if (torque != instance.motor_torque)
+                applyMotorTorque(instance, torque);
+
+            // Motors only act on awake bodies; a new target wakes the ragdoll up
+            if (torque > 0.0f && component.animated_pose.getBoneCount() == instance.skeleton->getBoneCount()
+                && driveMotors(instance, component) && !awake)
+            {
+                instance.ragdoll->Activate();
+                awake = true;
+            }
+        }
+
+        component.awake = awake;
+        ++stats.instances;
+        stats.awake += awake ? 1u : 0u;
+        stats.full += lod == RagdollLod::Full ? 1u : 0u;
+        stats.reduced += lod == RagdollLod::Reduced ? 1u : 0u;
+        stats.frozen += lod == RagdollLod::Frozen ? 1u : 0u;
+    }
+
+    stats.pooled = static_cast<uint32_t>(getPooledCount());
+    if (out_stats)
+        *out_stats = stats;
+}
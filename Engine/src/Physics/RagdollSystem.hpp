@@ -0,0 +1,194 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Physics/PhysicsSettings.hpp"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Ragdoll/Ragdoll.h>
+#include <Jolt/Skeleton/SkeletonPose.h>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Skeleton;
+struct RagdollComponent;
+
+namespace JPH
+{
+    class PhysicsSystem;
+}
+
+// One simulated body of a ragdoll. Each part is a capsule from its bone to the end bone
+// (or, by default, to the first child bone that is also part of the ragdoll).
+struct RagdollBoneDesc
+{
+    std::string bone;
+    std::string end_bone;             // Empty: first ragdoll child, then first skeleton child
+    float radius = 0.08f;
+    float length = 0.2f;              // Used by leaf bones without an end bone
+    float mass = 0.0f;                // 0 derives the mass from the shape volume
+    float swing_limit_degrees = 45.0f;
+    float twist_min_degrees = -20.0f;
+    float twist_max_degrees = 20.0f;
+};
+
+// Describes how a skeleton is turned into a ragdoll. Bones may be listed in any order; a
+// part's parent is the nearest ancestor bone that is also listed.
+struct RagdollProfile
+{
+    std::vector<RagdollBoneDesc> bones;
+    std::string collision_layer;      // Empty uses the project's dynamic layer
+    float friction = 0.6f;
+    float restitution = 0.0f;
+    float linear_damping = 0.05f;
+    float angular_damping = 0.1f;
+    float joint_friction_torque = 2.0f;   // Resists motion while the motors are off
+    float motor_frequency = 20.0f;
+    float motor_damping = 1.0f;
+    float max_motor_torque = 250.0f;      // At motor_strength 1
+};
+
+enum class RagdollLod : uint8_t
+{
+    Full,       // Motors follow the animation, full solver iterations
+    Reduced,    // Limp, fewer solver iterations, sleeps as soon as it slows down
+    Frozen      // Bodies put to sleep where they are, pose held
+};
+
+struct RagdollLodSettings
+{
+    float full_distance = 20.0f;          // Full simulation inside this camera distance
+    float reduced_distance = 60.0f;       // Reduced up to here, frozen beyond
+    uint32_t reduced_velocity_steps = 2;  // Solver iterations for reduced ragdolls' joints
+    uint32_t reduced_position_steps = 1;
+    float sleep_speed = 0.25f;            // Reduced ragdolls slower than this (m/s)...
+    float sleep_time = 0.25f;             // ...for this long are put to sleep
+    uint32_t max_pooled_per_profile = 32; // Released instances kept for reuse
+};
+
+struct RagdollStats
+{
+    uint32_t instances = 0;
+    uint32_t awake = 0;
+    uint32_t full = 0;
+    uint32_t reduced = 0;
+    uint32_t frozen = 0;
+    uint32_t pooled = 0;
+    uint32_t created = 0;     // Ragdolls built this update instead of reused from the pool
+    uint32_t put_to_sleep = 0;
+};
+
+// Ragdoll settings built once per skeleton and profile, with the joint <-> bone mapping
+// and a pool of released instances that are still allocated in Jolt.
+struct RagdollDefinition
+{
+    JPH::Ref<JPH::RagdollSettings> settings;
+    std::vector<int> joint_to_bone;       // Ragdoll joint index -> skeleton bone index
+    std::vector<int> bone_to_joint;       // Skeleton bone index -> ragdoll joint, or -1
+    std::vector<JPH::Ref<JPH::Ragdoll>> pool;
+
+    size_t getJointCount() const { return joint_to_bone.size(); }
+
+    // Builds parts in the skeleton's bind pose. Returns nullptr (and logs) if the profile
+    // names no bone of the skeleton, or if more than one part has no ancestor part.
+    ENGINE_API static std::shared_ptr<RagdollDefinition> build(const Skeleton& skeleton,
+                                                               const RagdollProfile& profile,
+                                                               const PhysicsLayerSettings& layers);
+};
+
+// Owns the live Jolt ragdolls of a PhysicsSystem. A RagdollComponent asks for a ragdoll by
+// setting simulate; update() then takes one from the profile's pool (or builds one),
+// poses it from the last animated pose, and from then on reads the simulated pose back
+// into the component, drives the motors toward the animation and applies the LOD.
+class ENGINE_API RagdollSystem
+{
+public:
+    using BodyEntityMap = std::unordered_map<JPH::BodyID, entt::entity>;
+
+    RagdollSystem();
+    ~RagdollSystem();
+
+    RagdollSystem(const RagdollSystem&) = delete;
+    RagdollSystem& operator=(const RagdollSystem&) = delete;
+
+    void shutdown(BodyEntityMap& body_to_entity);
+
+    // Run once per frame after the physics step and before AnimationSystem::update.
+    void update(entt::registry& registry,
+                JPH::PhysicsSystem& physics_system,
+                BodyEntityMap& body_to_entity,
+                const PhysicsLayerSettings& layers,
+                const glm::vec3& camera_position,
+                float dt,
+                const RagdollLodSettings& settings,
+                RagdollStats* out_stats);
+
+    // Builds count instances for the skeleton and profile ahead of time so the first
+    // ragdolls of a fight don't stall the frame.
+    void prewarm(const std::shared_ptr<Skeleton>& skeleton,
+                 const std::shared_ptr<const RagdollProfile>& profile,
+                 size_t count,
+                 JPH::PhysicsSystem& physics_system,
+                 const PhysicsLayerSettings& layers);
+
+    bool has(entt::entity entity) const { return instances.find(entity) != instances.end(); }
+    size_t getInstanceCount() const { return instances.size(); }
+    size_t getPooledCount() const;
+
+    // Bodies of an entity's live ragdoll, in joint order; empty if it has none.
+    const JPH::Array<JPH::BodyID>* getBodyIDs(entt::entity entity) const;
+
+private:
+    struct DefinitionEntry
+    {
+        std::weak_ptr<Skeleton> skeleton;
+        std::weak_ptr<const RagdollProfile> profile;
+        std::shared_ptr<RagdollDefinition> definition;
+    };
+
+    struct Instance
+    {
+        std::shared_ptr<RagdollDefinition> definition;
+        std::shared_ptr<Skeleton> skeleton;
+        std::shared_ptr<const RagdollProfile> profile;
+        JPH::Ref<JPH::Ragdoll> ragdoll;
+        JPH::SkeletonPose target;                  // Motor targets, joint rotations relative to the parent joint
+        std::vector<JPH::Mat44> joint_matrices;    // Scratch for SetPose/GetPose
+        float motor_torque = -1.0f;                // Last torque limit written to the constraints
+        float still_time = 0.0f;
+        bool lod_applied = false;
+        bool frozen_awake = false;                 // Was moving when frozen; wake it when it comes back
+    };
+
+    std::shared_ptr<RagdollDefinition> findDefinition(const std::shared_ptr<Skeleton>& skeleton,
+                                                      const std::shared_ptr<const RagdollProfile>& profile,
+                                                      const PhysicsLayerSettings& layers);
+    bool acquire(entt::registry& registry,
+                 entt::entity entity,
+                 RagdollComponent& component,
+                 const std::shared_ptr<Skeleton>& skeleton,
+                 JPH::PhysicsSystem& physics_system,
+                 BodyEntityMap& body_to_entity,
+                 const PhysicsLayerSettings& layers,
+                 RagdollStats& stats);
+    void release(Instance& instance, BodyEntityMap& body_to_entity, const RagdollLodSettings& settings);
+    void applyLod(Instance& instance, RagdollLod lod, JPH::PhysicsSystem& physics_system,
+                  const RagdollLodSettings& settings);
+    void setSolverSteps(Instance& instance, uint32_t velocity_steps, uint32_t position_steps);
+    void applyMotorTorque(Instance& instance, float torque);
+    bool driveMotors(Instance& instance, const RagdollComponent& component);
+    void readPose(Instance& instance, RagdollComponent& component, const glm::mat4& model_to_world);
+
+    std::vector<DefinitionEntry> definitions;
+    std::unordered_map<entt::entity, Instance> instances;
+    std::vector<glm::mat4> scratch_globals;
+    uint32_t next_group_id = 1;
+};
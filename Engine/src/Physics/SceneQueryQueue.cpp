@@ -0,0 +1,138 @@
+#include "SceneQueryQueue.hpp"
+#include "Threading/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+SceneQueryHandle SceneQueryQueue::enqueue(const SceneQuery& scene_query, SceneQueryCallback callback)
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    SceneQueryHandle handle = next_handle++;
+    if (handle == INVALID_SCENE_QUERY)
+        handle = next_handle++;
+
+    Pending entry;
+    entry.handle = handle;
+    entry.query = scene_query;
+    entry.callback = std::move(callback);
+    pending.push_back(std::move(entry));
+    return handle;
+}
+
+bool SceneQueryQueue::cancel(SceneQueryHandle handle)
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    auto it = std::find_if(pending.begin(), pending.end(),
+        [handle](const Pending& p) { return p.handle == handle; });
+    if (it == pending.end())
+        return false;
+    pending.erase(it);
+    return true;
+}
+
+void SceneQueryQueue::clear()
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    pending.clear();
+    completed.clear();
+}
+
+bool SceneQueryQueue::getResult(SceneQueryHandle handle, SceneQueryResult& out) const
+{
+    auto it = completed.find(handle);
+    if (it == completed.end())
+        return false;
+    out = it->second;
+    return true;
+}
+
+bool SceneQueryQueue::isPending(SceneQueryHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    return std::any_of(pending.begin(), pending.end(),
+        [handle](const Pending& p) { return p.handle == handle; });
+}
+
+size_t SceneQueryQueue::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    return pending.size();
+}
+
+void SceneQueryQueue::execute()
+{
+    const auto start = std::chrono::steady_clock::now();
+    completed.clear();
+    running.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        stats.queued = static_cast<uint32_t>(pending.size());
+
+        const size_t budget = std::min<size_t>(settings.max_queries_per_frame, pending.size());
+        if (budget < pending.size())
+        {
+            // Deferred queries gain weight every frame so low priorities still get through.
+            // Stable, so equal scores keep submission order.
+            std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+                return a.query.priority * float(a.frames_waited + 1) > b.query.priority * float(b.frames_waited + 1);
+            });
+        }
+
+        running.assign(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.begin() + budget));
+        pending.erase(pending.begin(), pending.begin() + budget);
+        for (Pending& p : pending)
+            p.frames_waited++;
+        stats.deferred = static_cast<uint32_t>(pending.size());
+    }
+
+    const size_t count = running.size();
+    stats.executed = static_cast<uint32_t>(count);
+    stats.total_executed += count;
+    if (count == 0)
+    {
+        stats.execute_ms = 0.0;
+        return;
+    }
+
+    batch_queries.resize(count);
+    batch_results.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch_queries[i] = running[i].query;
+        batch_results[i] = SceneQueryResult{};
+    }
+
+    if (query)
+    {
+        Threading::JobSystem& jobs = Threading::JobSystem::get();
+        if (settings.parallel && jobs.isInitialized())
+        {
+            jobs.parallelFor("SceneQueries", count, settings.min_batch_size,
+                [this](size_t begin, size_t end) {
+                    query(batch_queries.data() + begin, batch_results.data() + begin, end - begin);
+                },
+                Threading::JobPriority::High);
+        }
+        else
+        {
+            query(batch_queries.data(), batch_results.data(), count);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch_results[i].frames_waited = running[i].frames_waited;
+        completed[running[i].handle] = std::move(batch_results[i]);
+    }
+
+    // Callbacks last: they may enqueue follow-up queries for the next frame
+    for (Pending& p : running)
+    {
+        if (p.callback)
+            p.callback(p.handle, completed[p.handle]);
+    }
+    running.clear();
+
+    stats.execute_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
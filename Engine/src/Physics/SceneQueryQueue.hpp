@@ -0,0 +1,174 @@
+#pragma once
+
+#include "EngineExport.h"
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum class SceneQueryType : uint8_t
+{
+    Raycast,
+    SphereCast,
+    BoxCast,
+    SphereOverlap,
+    BoxOverlap
+};
+
+using SceneQueryHandle = uint32_t;
+constexpr SceneQueryHandle INVALID_SCENE_QUERY = 0;
+
+struct SceneQuery
+{
+    SceneQueryType type = SceneQueryType::Raycast;
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};   // Casts; normalized when run
+    float max_distance = 0.0f;                // Casts
+    float radius = 0.5f;                      // Sphere shapes
+    glm::vec3 half_extents{0.5f};             // Box shapes
+    glm::vec3 rotation{0.0f};                 // Box shapes, Euler degrees
+    entt::entity ignored_entity = entt::null;
+    uint32_t layer_mask = 0xFFFFFFFFu;        // PhysicsLayerMask of the object layers to test
+    float priority = 1.0f;                    // Higher runs first when the frame budget is exceeded
+
+    static SceneQuery raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+        entt::entity ignored_entity = entt::null)
+    {
+        SceneQuery q;
+        q.type = SceneQueryType::Raycast;
+        q.origin = origin;
+        q.direction = direction;
+        q.max_distance = max_distance;
+        q.ignored_entity = ignored_entity;
+        return q;
+    }
+
+    static SceneQuery sphereCast(const glm::vec3& origin, float radius, const glm::vec3& direction, float max_distance,
+        entt::entity ignored_entity = entt::null)
+    {
+        SceneQuery q = raycast(origin, direction, max_distance, ignored_entity);
+        q.type = SceneQueryType::SphereCast;
+        q.radius = radius;
+        return q;
+    }
+
+    static SceneQuery boxCast(const glm::vec3& origin, const glm::vec3& half_extents, const glm::vec3& rotation,
+        const glm::vec3& direction, float max_distance, entt::entity ignored_entity = entt::null)
+    {
+        SceneQuery q = raycast(origin, direction, max_distance, ignored_entity);
+        q.type = SceneQueryType::BoxCast;
+        q.half_extents = half_extents;
+        q.rotation = rotation;
+        return q;
+    }
+
+    static SceneQuery sphereOverlap(const glm::vec3& center, float radius, entt::entity ignored_entity = entt::null)
+    {
+        SceneQuery q;
+        q.type = SceneQueryType::SphereOverlap;
+        q.origin = center;
+        q.radius = radius;
+        q.ignored_entity = ignored_entity;
+        return q;
+    }
+
+    static SceneQuery boxOverlap(const glm::vec3& center, const glm::vec3& half_extents, const glm::vec3& rotation,
+        entt::entity ignored_entity = entt::null)
+    {
+        SceneQuery q;
+        q.type = SceneQueryType::BoxOverlap;
+        q.origin = center;
+        q.half_extents = half_extents;
+        q.rotation = rotation;
+        q.ignored_entity = ignored_entity;
+        return q;
+    }
+};
+
+struct SceneQueryResult
+{
+    bool hit = false;
+    entt::entity entity = entt::null;       // Closest hit (casts) or first overlap
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f, 1.0f, 0.0f};
+    float fraction = 1.0f;
+    float distance = 0.0f;
+    std::vector<entt::entity> overlaps;     // Overlap queries, up to SceneQueryQueue::MAX_OVERLAP_HITS
+    uint32_t frames_waited = 0;             // Frames the budget deferred this query
+};
+
+using SceneQueryCallback = std::function<void(SceneQueryHandle handle, const SceneQueryResult& result)>;
+
+struct SceneQuerySettings
+{
+    uint32_t max_queries_per_frame = 1024;
+    size_t min_batch_size = 64;             // Queries per worker job
+    bool parallel = true;                   // Run on the JobSystem workers when available
+};
+
+struct SceneQueryStats
+{
+    uint32_t queued = 0;                    // Waiting when execute() started
+    uint32_t executed = 0;
+    uint32_t deferred = 0;                  // Left for the next frame by the budget
+    uint64_t total_executed = 0;
+    double execute_ms = 0.0;
+};
+
+// Deferred scene queries. Callers enqueue rays, shape casts and overlaps during the
+// tick; execute() runs the highest-priority ones within the frame budget across the
+// job workers, then hands out results on the calling thread.
+class ENGINE_API SceneQueryQueue
+{
+public:
+    static constexpr size_t MAX_OVERLAP_HITS = 32;
+
+    // Runs `count` queries; must be safe to call from several workers at once
+    using BatchQueryFn = std::function<void(const SceneQuery* queries, SceneQueryResult* results, size_t count)>;
+
+    void setQuery(BatchQueryFn fn) { query = std::move(fn); }
+
+    // Thread-safe. The callback runs inside execute(), on the thread that calls it.
+    SceneQueryHandle enqueue(const SceneQuery& scene_query, SceneQueryCallback callback = {});
+    bool cancel(SceneQueryHandle handle);
+
+    void execute();
+    void clear();
+
+    // Results stay readable until the next execute()
+    bool getResult(SceneQueryHandle handle, SceneQueryResult& out) const;
+    bool isPending(SceneQueryHandle handle) const;
+    size_t getPendingCount() const;
+
+    void setSettings(const SceneQuerySettings& new_settings) { settings = new_settings; }
+    const SceneQuerySettings& getSettings() const { return settings; }
+    const SceneQueryStats& getStats() const { return stats; }
+
+private:
+    struct Pending
+    {
+        SceneQueryHandle handle = INVALID_SCENE_QUERY;
+        SceneQuery query;
+        SceneQueryCallback callback;
+        uint32_t frames_waited = 0;
+    };
+
+    BatchQueryFn query;
+    SceneQuerySettings settings;
+    SceneQueryStats stats;
+
+    mutable std::mutex pending_mutex;
+    std::vector<Pending> pending;
+    SceneQueryHandle next_handle = 1;
+
+    std::unordered_map<SceneQueryHandle, SceneQueryResult> completed;
+
+    // Scratch, reused every frame
+    std::vector<Pending> running;
+    std::vector<SceneQuery> batch_queries;
+    std::vector<SceneQueryResult> batch_results;
+};
@@ -0,0 +1,223 @@
+#include "Physics/SimulationLod.hpp"
+
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Body/BodyLockInterface.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    uint32_t clampSolverSteps(uint32_t steps)
+    {
+        return std::min(steps, 255u);
+    }
+}
+
+void SimulationLodSystem::setObservers(const glm::vec3* positions, size_t count)
+{
+    observers.assign(positions, positions + count);
+}
+
+void SimulationLodSystem::clear()
+{
+    states.clear();
+    observers.clear();
+    stats = {};
+}
+
+SimulationLod SimulationLodSystem::getLod(const JPH::BodyID& body_id) const
+{
+    auto it = states.find(body_id);
+    return it != states.end() ? it->second.lod : SimulationLod::Full;
+}
+
+SimulationLod SimulationLodSystem::selectLod(float distance_sq, SimulationLod current) const
+{
+    const float full_limit = settings.full_distance + (current == SimulationLod::Full ? settings.hysteresis : 0.0f);
+    const float reduced_limit = settings.reduced_distance + (current != SimulationLod::Frozen ? settings.hysteresis : 0.0f);
+    if (distance_sq <= full_limit * full_limit)
+        return SimulationLod::Full;
+    if (distance_sq <= reduced_limit * reduced_limit)
+        return SimulationLod::Reduced;
+    return SimulationLod::Frozen;
+}
+
+void SimulationLodSystem::restoreAll(JPH::PhysicsSystem& physics_system)
+{
+    scratch_ids.clear();
+    for (const auto& [body_id, state] : states)
+        scratch_ids.push_back(body_id);
+    std::sort(scratch_ids.begin(), scratch_ids.end());
+
+    const JPH::BodyLockInterfaceNoLock& lock_interface = physics_system.GetBodyLockInterfaceNoLock();
+    JPH::BodyInterface& body_interface = physics_system.GetBodyInterfaceNoLock();
+    for (const JPH::BodyID& body_id : scratch_ids)
+    {
+        JPH::Body* body = lock_interface.TryGetBody(body_id);
+        if (!body || !body->IsDynamic())
+            continue;
+
+        body->GetMotionProperties()->SetNumVelocityStepsOverride(0);
+        body->GetMotionProperties()->SetNumPositionStepsOverride(0);
+
+        const BodyState& state = states[body_id];
+        if (state.held && state.was_awake)
+        {
+            body_interface.ActivateBody(body_id);
+            body_interface.SetLinearAndAngularVelocity(body_id, JPH::Vec3(state.linear_velocity),
+                                                       JPH::Vec3(state.angular_velocity));
+            ++stats.resumed;
+        }
+    }
+    states.clear();
+}
+
+void SimulationLodSystem::update(const EntityBodyMap& entity_to_body, JPH::PhysicsSystem& physics_system, float dt)
+{
+    stats = {};
+    if (!settings.enabled || observers.empty())
+    {
+        if (!states.empty())
+            restoreAll(physics_system);
+        return;
+    }
+
+    // Body ID order, so activations and deactivations reach Jolt in the same order everywhere
+    scratch_ids.clear();
+    for (const auto& [entity, body_id] : entity_to_body)
+        scratch_ids.push_back(body_id);
+    std::sort(scratch_ids.begin(), scratch_ids.end());
+
+    const JPH::BodyLockInterfaceNoLock& lock_interface = physics_system.GetBodyLockInterfaceNoLock();
+    JPH::BodyInterface& body_interface = physics_system.GetBodyInterfaceNoLock();
+    const float sleep_speed_sq = settings.sleep_speed * settings.sleep_speed;
+    scratch_deactivate.clear();
+
+    // Wakes a body that was held while moving and gives its velocity back. Bodies that were
+    // already asleep stay asleep.
+    auto resume = [&](const JPH::BodyID& body_id, BodyState& state) {
+        if (state.held && state.was_awake)
+        {
+            body_interface.ActivateBody(body_id);
+            body_interface.SetLinearAndAngularVelocity(body_id, JPH::Vec3(state.linear_velocity),
+                                                       JPH::Vec3(state.angular_velocity));
+            ++stats.resumed;
+        }
+        state.held = false;
+        state.was_awake = false;
+        state.linear_velocity = JPH::Float3(0.0f, 0.0f, 0.0f);
+        state.angular_velocity = JPH::Float3(0.0f, 0.0f, 0.0f);
+    };
+
+    // Linear (m/s) and angular (rad/s) speed both below sleep_speed for sleep_time
+    auto settled = [&](const JPH::Body& body, BodyState& state) {
+        const bool slow = body.GetLinearVelocity().LengthSq() < sleep_speed_sq
+                          && body.GetAngularVelocity().LengthSq() < sleep_speed_sq;
+        state.still_time = slow ? state.still_time + dt : 0.0f;
+        return state.still_time >= settings.sleep_time;
+    };
+
+    for (const JPH::BodyID& body_id : scratch_ids)
+    {
+        JPH::Body* body = lock_interface.TryGetBody(body_id);
+        if (!body || !body->IsDynamic() || !body->IsInBroadPhase())
+        {
+            states.erase(body_id);
+            continue;
+        }
+        ++stats.bodies;
+
+        const JPH::RVec3 body_position = body->GetPosition();
+        const glm::vec3 position(static_cast<float>(body_position.GetX()), static_cast<float>(body_position.GetY()),
+                                 static_cast<float>(body_position.GetZ()));
+        float distance_sq = std::numeric_limits<float>::max();
+        for (const glm::vec3& observer : observers)
+        {
+            const glm::vec3 offset = position - observer;
+            distance_sq = std::min(distance_sq, glm::dot(offset, offset));
+        }
+
+        auto it = states.find(body_id);
+        const SimulationLod current = it != states.end() ? it->second.lod : SimulationLod::Full;
+        const SimulationLod lod = selectLod(distance_sq, current);
+        JPH::MotionProperties* motion = body->GetMotionProperties();
+
+        if (lod == SimulationLod::Full)
+        {
+            ++stats.full;
+            if (it != states.end())
+            {
+                motion->SetNumVelocityStepsOverride(0);
+                motion->SetNumPositionStepsOverride(0);
+                resume(body_id, it->second);
+                states.erase(it);
+            }
+            continue;
+        }
+
+        BodyState& state = it != states.end() ? it->second : states[body_id];
+        motion->SetNumVelocityStepsOverride(clampSolverSteps(settings.reduced_velocity_steps));
+        motion->SetNumPositionStepsOverride(clampSolverSteps(settings.reduced_position_steps));
+
+        if (lod == SimulationLod::Reduced)
+        {
+            ++stats.reduced;
+            resume(body_id, state);
+            state.settling = false;
+            if (body->IsActive() && settled(*body, state))
+                scratch_deactivate.push_back(body_id);
+        }
+        else if (!body->IsActive())
+        {
+            // Asleep on its own or already held; either way it stays down until the LOD wakes it
+            ++stats.frozen;
+            state.held = true;
+            state.settling = false;
+        }
+        else if (current != SimulationLod::Frozen)
+        {
+            // Entering the frozen tier while moving: keep the velocity for later
+            ++stats.frozen;
+            state.held = true;
+            state.was_awake = true;
+            state.settling = false;
+            body->GetLinearVelocity().StoreFloat3(&state.linear_velocity);
+            body->GetAngularVelocity().StoreFloat3(&state.angular_velocity);
+            scratch_deactivate.push_back(body_id);
+        }
+        else
+        {
+            ++stats.frozen;
+            ++stats.frozen_awake;
+            if (state.held)
+            {
+                // Woken since the last step: carry on with the held motion on top of whatever woke it
+                ++stats.woken;
+                state.was_awake = false;
+                body->SetLinearVelocityClamped(body->GetLinearVelocity() + JPH::Vec3(state.linear_velocity));
+                body->SetAngularVelocityClamped(body->GetAngularVelocity() + JPH::Vec3(state.angular_velocity));
+                state.held = false;
+                state.settling = true;
+                state.still_time = 0.0f;
+                state.linear_velocity = JPH::Float3(0.0f, 0.0f, 0.0f);
+                state.angular_velocity = JPH::Float3(0.0f, 0.0f, 0.0f);
+            }
+            else if (settled(*body, state))
+            {
+                state.held = true;
+                state.settling = false;
+                scratch_deactivate.push_back(body_id);
+            }
+        }
+        state.lod = lod;
+    }
+
+    if (!scratch_deactivate.empty())
+    {
+        body_interface.DeactivateBodies(scratch_deactivate.data(), static_cast<int>(scratch_deactivate.size()));
+        stats.put_to_sleep = static_cast<uint32_t>(scratch_deactivate.size());
+    }
+}
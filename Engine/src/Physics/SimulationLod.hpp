@@ -0,0 +1,105 @@
+#pragma once
+
+#include "EngineExport.h"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace JPH
+{
+    class PhysicsSystem;
+}
+
+enum class SimulationLod : uint8_t
+{
+    Full,       // Simulated exactly as without LOD
+    Reduced,    // Fewer solver iterations, put to sleep as soon as it slows down
+    Frozen      // Held asleep; its velocity is kept and given back when it wakes
+};
+
+struct SimulationLodSettings
+{
+    bool enabled = false;
+    float full_distance = 50.0f;          // Full simulation within this distance of any observer
+    float reduced_distance = 150.0f;      // Reduced up to here, frozen beyond
+    float hysteresis = 5.0f;              // A body leaves a tier this far past its boundary
+    uint32_t reduced_velocity_steps = 4;  // Solver iterations for reduced bodies
+    uint32_t reduced_position_steps = 1;
+    float sleep_speed = 0.5f;             // Reduced bodies slower than this (m/s)...
+    float sleep_time = 0.5f;              // ...for this long are put to sleep
+};
+
+struct SimulationLodStats
+{
+    uint32_t bodies = 0;          // Dynamic bodies considered
+    uint32_t full = 0;
+    uint32_t reduced = 0;
+    uint32_t frozen = 0;
+    uint32_t frozen_awake = 0;    // In the frozen tier but woken by a contact or game code
+    uint32_t put_to_sleep = 0;    // Deactivated by the LOD this step
+    uint32_t resumed = 0;         // Given their frozen velocity back this step
+    uint32_t woken = 0;           // Frozen bodies found awake this step
+};
+
+// Simulation LOD for the dynamic bodies of a PhysicsSystem, by distance to the nearest
+// observer (the players on a server, or whatever the host passes, such as the camera). Jolt
+// steps every active body with the same delta, so far bodies are made cheaper rather than
+// stepped less often: the reduced tier runs fewer solver iterations and sleeps early, the
+// frozen tier deactivates bodies and keeps their velocity for when an observer comes back.
+//
+// Decisions depend only on body and observer positions and run in body ID order before the
+// step, so two worlds given the same observers stay identical. A frozen body that Jolt wakes
+// (a contact with an active body, an impulse, a velocity set by game code) simulates until it
+// comes to rest again. Bodies in the full tier are never touched.
+class ENGINE_API SimulationLodSystem
+{
+public:
+    using EntityBodyMap = std::unordered_map<entt::entity, JPH::BodyID>;
+
+    void setSettings(const SimulationLodSettings& lod_settings) { settings = lod_settings; }
+    const SimulationLodSettings& getSettings() const { return settings; }
+
+    // With no observers every body is simulated in full
+    void setObservers(const glm::vec3* positions, size_t count);
+    const std::vector<glm::vec3>& getObservers() const { return observers; }
+
+    // Runs before each step with the Jolt update lock held
+    void update(const EntityBodyMap& entity_to_body, JPH::PhysicsSystem& physics_system, float dt);
+
+    // Drops the state of a body about to be destroyed
+    void removeBody(const JPH::BodyID& body_id) { states.erase(body_id); }
+    void clear();
+
+    SimulationLod getLod(const JPH::BodyID& body_id) const;
+    const SimulationLodStats& getStats() const { return stats; }
+
+private:
+    struct BodyState
+    {
+        SimulationLod lod = SimulationLod::Full;
+        bool held = false;        // Kept asleep by the LOD; waking it is the LOD's job
+        bool was_awake = false;   // Held while moving, so it resumes with the velocity below
+        bool settling = false;    // Woken while frozen, simulating until it rests
+        float still_time = 0.0f;
+        JPH::Float3 linear_velocity{0.0f, 0.0f, 0.0f};
+        JPH::Float3 angular_velocity{0.0f, 0.0f, 0.0f};
+    };
+
+    SimulationLod selectLod(float distance_sq, SimulationLod current) const;
+    void restoreAll(JPH::PhysicsSystem& physics_system);
+
+    SimulationLodSettings settings;
+    std::vector<glm::vec3> observers;
+    std::unordered_map<JPH::BodyID, BodyState> states;   // Bodies outside the full tier
+    std::vector<JPH::BodyID> scratch_ids;
+    std::vector<JPH::BodyID> scratch_deactivate;
+    SimulationLodStats stats;
+};
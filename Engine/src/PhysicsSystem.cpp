@@ -1,6 +1,7 @@
 #include "PhysicsSystem.hpp"
 #include "Assets/CookedCollisionSerializer.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include <algorithm>
 #include <atomic>
 #include <cmath>
@@ -86,15 +87,28 @@ static PhysicsSystemSettings sanitizePhysicsSettings(PhysicsSystemSettings sanit
     sanitized.player_min_ground_normal_y = std::clamp(sanitized.player_min_ground_normal_y, -1.0f, 1.0f);
     sanitized.raycast_direction_epsilon = std::max(sanitized.raycast_direction_epsilon, 0.0f);
 
-    if (sanitized.layers.object_layer_count <= sanitized.layers.static_body)
-        sanitized.layers.object_layer_count = sanitized.layers.static_body + 1;
-    if (sanitized.layers.object_layer_count <= sanitized.layers.dynamic_body)
-        sanitized.layers.object_layer_count = sanitized.layers.dynamic_body + 1;
+    PhysicsLayerSettings& layers = sanitized.layers;
+    if (layers.object_layer_count == 0 || layers.object_layer_count > PhysicsObjectLayers::Max)
+        layers = PhysicsLayerSettings{};
 
-    const uint32_t static_broad_phase_index = uint32_t(sanitized.layers.static_broad_phase.GetValue());
-    const uint32_t dynamic_broad_phase_index = uint32_t(sanitized.layers.dynamic_broad_phase.GetValue());
-    const uint32_t needed_broad_phase_count = std::max(static_broad_phase_index, dynamic_broad_phase_index) + 1;
-    sanitized.layers.broad_phase_layer_count = std::max(sanitized.layers.broad_phase_layer_count, needed_broad_phase_count);
+    // Motion-type layers that were removed fall back to the first layer
+    if (!layers.isValidLayer(layers.static_body))
+        layers.static_body = 0;
+    if (!layers.isValidLayer(layers.dynamic_body))
+        layers.dynamic_body = 0;
+    if (!layers.isValidLayer(layers.character_body))
+        layers.character_body = layers.dynamic_body;
+
+    uint32_t needed_broad_phase_count = 1;
+    for (JPH::ObjectLayer layer = 0; layer < layers.object_layer_count; ++layer)
+    {
+        if (layers.broad_phases[layer].GetValue() >= PhysicsBroadPhaseLayers::Count)
+            layers.broad_phases[layer] = PhysicsBroadPhaseLayers::Moving;
+        needed_broad_phase_count = std::max(needed_broad_phase_count, uint32_t(layers.broad_phases[layer].GetValue()) + 1);
+    }
+    layers.broad_phase_layer_count = std::clamp(layers.broad_phase_layer_count, needed_broad_phase_count,
+        PhysicsBroadPhaseLayers::Count);
+    layers.rebuildBroadPhaseMasks();
 
     return sanitized;
 }
@@ -142,6 +156,9 @@ private:
 PhysicsSystem::PhysicsSystem(const PhysicsSystemSettings& system_settings)
 {
     applySettings(system_settings);
+    scene_queries.setQuery([this](const SceneQuery* queries, SceneQueryResult* results, size_t count) {
+        runSceneQueries(queries, results, count);
+    });
 }
 
 PhysicsSystem::PhysicsSystem(const glm::vec3& gravityVector, float deltaTime)
@@ -150,6 +167,9 @@ PhysicsSystem::PhysicsSystem(const glm::vec3& gravityVector, float deltaTime)
     defaults.gravity_direction = gravityVector;
     defaults.fixed_delta = deltaTime;
     applySettings(defaults);
+    scene_queries.setQuery([this](const SceneQuery* queries, SceneQueryResult* results, size_t count) {
+        runSceneQueries(queries, results, count);
+    });
 }
 
 PhysicsSystem::~PhysicsSystem()
@@ -191,6 +211,7 @@ glm::vec3 PhysicsSystem::clampVelocity(const glm::vec3& v) const
 void PhysicsSystem::initialize()
 {
     if (initialized) return;
+    MemoryTagScope memory_tag(MemoryTag::Physics);
 
     ensureJoltRegistered();
 
@@ -233,8 +254,14 @@ void PhysicsSystem::ensureJoltRegistered()
         };
 #endif
 
-        // Use Jolt's built-in default allocator (handles posix_memalign etc.)
-        JPH::RegisterDefaultAllocator();
+        // Jolt allocates through the memory tracker so physics shows up in mem_report
+        JPH::Allocate = [](size_t size) { return MemoryTracker::allocateTagged(MemoryTag::Physics, size); };
+        JPH::Reallocate = [](void* block, size_t, size_t new_size) { return MemoryTracker::reallocate(block, new_size); };
+        JPH::Free = [](void* block) { MemoryTracker::deallocate(block); };
+        JPH::AlignedAllocate = [](size_t size, size_t alignment) {
+            return MemoryTracker::allocateTagged(MemoryTag::Physics, size, alignment);
+        };
+        JPH::AlignedFree = [](void* block) { MemoryTracker::deallocate(block); };
 
         if (!JPH::Factory::sInstance)
             JPH::Factory::sInstance = new JPH::Factory();
@@ -256,6 +283,7 @@ void PhysicsSystem::shutdown()
     entity_to_constraint.clear();
 
     character_controllers.shutdown(body_to_entity);
+    ragdolls.shutdown(body_to_entity);
 
     // Remove all bodies
     if (jolt_system)
@@ -270,6 +298,9 @@ void PhysicsSystem::shutdown()
 
     entity_to_body.clear();
     body_to_entity.clear();
+    simulation_lod.clear();
+    state_hashes.clear();
+    scene_queries.clear();
 
     contact_listener.reset();
     jolt_system.reset();
@@ -303,6 +334,26 @@ void PhysicsSystem::optimizeBroadPhase()
         jolt_system->OptimizeBroadPhase();
 }
 
+JPH::ObjectLayer PhysicsSystem::resolveBodyLayer(const PhysicsBodyDesc& desc, JPH::ObjectLayer motion_type_layer) const
+{
+    if (desc.object_layer == JPH::cObjectLayerInvalid)
+        return motion_type_layer;
+    if (!settings.layers.isValidLayer(desc.object_layer))
+    {
+        LOG_ENGINE_WARN("Physics body uses unknown object layer {}, using {}", desc.object_layer, motion_type_layer);
+        return motion_type_layer;
+    }
+    return desc.object_layer;
+}
+
+JPH::ObjectLayer PhysicsSystem::getBodyLayer(entt::entity entity) const
+{
+    auto it = entity_to_body.find(entity);
+    if (!initialized || it == entity_to_body.end())
+        return JPH::cObjectLayerInvalid;
+    return jolt_system->GetBodyInterfaceNoLock().GetObjectLayer(it->second);
+}
+
 JPH::BodyID PhysicsSystem::createStaticBody(const glm::vec3& position, const glm::vec3& rotation, const JPH::ShapeRefC& shape, entt::entity entity,
     const PhysicsBodyDesc& desc)
 {
@@ -311,7 +362,8 @@ JPH::BodyID PhysicsSystem::createStaticBody(const glm::vec3& position, const glm
     if (entity_to_body.find(entity) != entity_to_body.end())
         removeBody(entity);
 
-    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Static, settings.layers.static_body);
+    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Static,
+        resolveBodyLayer(desc, settings.layers.static_body));
     body_settings.mFriction = desc.friction;
     body_settings.mRestitution = desc.restitution;
 
@@ -402,7 +454,8 @@ JPH::BodyID PhysicsSystem::createDynamicBody(const glm::vec3& position, const gl
     if (entity_to_body.find(entity) != entity_to_body.end())
         removeBody(entity);
 
-    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Dynamic, settings.layers.dynamic_body);
+    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Dynamic,
+        resolveBodyLayer(desc, settings.layers.dynamic_body));
     body_settings.mOverrideMassProperties = JPH::EOverrideMassProperties::CalculateInertia;
     body_settings.mMassPropertiesOverride.mMass = std::max(desc.mass, settings.min_body_mass);
     if (desc.lock_rotation)
@@ -423,7 +476,7 @@ JPH::BodyID PhysicsSystem::createDynamicBody(const glm::vec3& position, const gl
     entity_to_body[entity] = body_id;
     body_to_entity[body_id] = entity;
 
-    LOG_ENGINE_INFO("Created Jolt dynamic body at ({}, {}, {}), mass={}", position.x, position.y, position.z, desc.mass);
+    LOG_ENGINE_TRACE("Created Jolt dynamic body at ({}, {}, {}), mass={}", position.x, position.y, position.z, desc.mass);
     return body_id;
 }
 
@@ -451,7 +504,8 @@ JPH::BodyID PhysicsSystem::createKinematicBody(const glm::vec3& position, const
     if (entity_to_body.find(entity) != entity_to_body.end())
         removeBody(entity);
 
-    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Kinematic, settings.layers.dynamic_body);
+    JPH::BodyCreationSettings body_settings(shape, toJoltR(position), toJoltQuat(rotation), JPH::EMotionType::Kinematic,
+        resolveBodyLayer(desc, settings.layers.dynamic_body));
     body_settings.mMotionQuality = JPH::EMotionQuality::LinearCast;
     body_settings.mFriction = desc.friction;
     body_settings.mRestitution = desc.restitution;
@@ -467,7 +521,7 @@ JPH::BodyID PhysicsSystem::createKinematicBody(const glm::vec3& position, const
     entity_to_body[entity] = body_id;
     body_to_entity[body_id] = entity;
 
-    LOG_ENGINE_INFO("Created Jolt kinematic body at ({}, {}, {})", position.x, position.y, position.z);
+    LOG_ENGINE_TRACE("Created Jolt kinematic body at ({}, {}, {})", position.x, position.y, position.z);
     return body_id;
 }
 
@@ -638,11 +692,14 @@ CharacterControllerState PhysicsSystem::simulateCharacterController(entt::regist
 }
 
 PhysicsSystem::ShapeCastResult PhysicsSystem::shapeCast(const JPH::ShapeRefC& shape, const glm::vec3& position,
-    const glm::vec3& rotation, const glm::vec3& direction)
+    const glm::vec3& rotation, const glm::vec3& direction, PhysicsLayerMask layerMask)
 {
     ShapeCastResult result;
     if (!initialized || !shape) return result;
 
+    const LayerMaskBroadPhaseFilter broad_phase_filter(settings.layers.getBroadPhaseMask(layerMask));
+    const LayerMaskObjectLayerFilter layer_filter(layerMask);
+
     JPH::RMat44 com_start = JPH::RMat44::sRotationTranslation(
         toJoltQuat(rotation), toJoltR(position));
 
@@ -656,7 +713,7 @@ PhysicsSystem::ShapeCastResult PhysicsSystem::shapeCast(const JPH::ShapeRefC& sh
     JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
 
     jolt_system->GetNarrowPhaseQuery().CastShape(
-        shape_cast, settings, com_start.GetTranslation(), collector);
+        shape_cast, settings, com_start.GetTranslation(), collector, broad_phase_filter, layer_filter);
 
     if (collector.HadHit())
     {
@@ -679,7 +736,7 @@ PhysicsSystem::ShapeCastResult PhysicsSystem::shapeCast(const JPH::ShapeRefC& sh
 }
 
 PhysicsSystem::ShapeCastResult PhysicsSystem::sphereCast(const glm::vec3& origin, float radius,
-    const glm::vec3& direction, float maxDistance)
+    const glm::vec3& direction, float maxDistance, PhysicsLayerMask layerMask)
 {
     if (maxDistance <= 0.0f || glm::length(direction) <= settings.raycast_direction_epsilon)
         return {};
@@ -689,11 +746,11 @@ PhysicsSystem::ShapeCastResult PhysicsSystem::sphereCast(const glm::vec3& origin
     if (!shape_result.IsValid()) return {};
 
     glm::vec3 dir = glm::normalize(direction) * maxDistance;
-    return shapeCast(shape_result.Get(), origin, glm::vec3(0), dir);
+    return shapeCast(shape_result.Get(), origin, glm::vec3(0), dir, layerMask);
 }
 
 PhysicsSystem::ShapeCastResult PhysicsSystem::boxCast(const glm::vec3& origin, const glm::vec3& halfExtents,
-    const glm::vec3& rotation, const glm::vec3& direction, float maxDistance)
+    const glm::vec3& rotation, const glm::vec3& direction, float maxDistance, PhysicsLayerMask layerMask)
 {
     if (maxDistance <= 0.0f || glm::length(direction) <= settings.raycast_direction_epsilon)
         return {};
@@ -703,7 +760,7 @@ PhysicsSystem::ShapeCastResult PhysicsSystem::boxCast(const glm::vec3& origin, c
     if (!shape_result.IsValid()) return {};
 
     glm::vec3 dir = glm::normalize(direction) * maxDistance;
-    return shapeCast(shape_result.Get(), origin, rotation, dir);
+    return shapeCast(shape_result.Get(), origin, rotation, dir, layerMask);
 }
 
 JPH::Constraint* PhysicsSystem::createConstraint(entt::entity entityA, entt::entity entityB, const ConstraintComponent& constraint)
@@ -797,19 +854,46 @@ void PhysicsSystem::removeBody(entt::entity entity)
     body_interface.RemoveBody(it->second);
     body_interface.DestroyBody(it->second);
 
+    simulation_lod.removeBody(it->second);
     body_to_entity.erase(it->second);
     entity_to_body.erase(it);
 }
 
+void PhysicsSystem::updateRagdolls(entt::registry& registry, const glm::vec3& camera_position, float dt,
+    const RagdollLodSettings& lod_settings, RagdollStats* out_stats)
+{
+    if (!initialized) return;
+
+    ragdolls.update(registry, *jolt_system, body_to_entity, settings.layers, camera_position, dt, lod_settings, out_stats);
+}
+
+void PhysicsSystem::prewarmRagdolls(const std::shared_ptr<Skeleton>& skeleton,
+    const std::shared_ptr<const RagdollProfile>& profile, size_t count)
+{
+    if (!initialized) return;
+
+    ragdolls.prewarm(skeleton, profile, count, *jolt_system, settings.layers);
+}
+
+SimulationLod PhysicsSystem::getSimulationLod(entt::entity entity) const
+{
+    auto it = entity_to_body.find(entity);
+    return it != entity_to_body.end() ? simulation_lod.getLod(it->second) : SimulationLod::Full;
+}
+
 void PhysicsSystem::stepPhysics(entt::registry& registry)
 {
     if (!initialized) return;
+    MemoryTagScope memory_tag(MemoryTag::Physics);
 
     // Sync ECS -> Jolt for dynamic bodies (in case game code moved them)
     syncTransformsToJolt(registry);
 
-    // Step Jolt physics
+    // Step Jolt physics, after moving far bodies between LOD tiers
+    std::unique_lock<std::shared_mutex> query_lock(async_query_mutex);
+    simulation_lod.update(entity_to_body, *jolt_system, fixed_delta);
     jolt_system->Update(fixed_delta, settings.collision_steps, temp_allocator.get(), job_system.get());
+    query_lock.unlock();
 
     // Drain collision events to EventBus (main thread)
     if (contact_listener)
@@ -840,6 +924,68 @@ void PhysicsSystem::stepPhysics(entt::registry& registry)
     }
 }
 
+void PhysicsSystem::setDeterminismChecks(bool enabled)
+{
+    if (determinism_checks == enabled)
+        return;
+
+    determinism_checks = enabled;
+    state_hashes.clear();
+}
+
+uint64_t PhysicsSystem::computeStateHash() const
+{
+    if (!initialized)
+        return PhysicsDeterminism::HASH_SEED;
+
+    // Body IDs are handed out in creation order, so worlds built the same way agree on them
+    JPH::BodyIDVector body_ids;
+    jolt_system->GetBodies(body_ids);
+    std::sort(body_ids.begin(), body_ids.end());
+
+    const JPH::BodyLockInterfaceNoLock& lock_interface = jolt_system->GetBodyLockInterfaceNoLock();
+    uint64_t hash = PhysicsDeterminism::HASH_SEED;
+    for (const JPH::BodyID& body_id : body_ids)
+    {
+        JPH::BodyLockRead lock(lock_interface, body_id);
+        if (!lock.Succeeded())
+            continue;
+
+        const JPH::Body& body = lock.GetBody();
+        if (body.IsStatic())
+            continue;
+
+        const JPH::RVec3 position = body.GetPosition();
+        const JPH::Quat rotation = body.GetRotation();
+        const JPH::Vec3 linear = body.GetLinearVelocity();
+        const JPH::Vec3 angular = body.GetAngularVelocity();
+
+        hash = PhysicsDeterminism::mixWord(hash, (uint64_t(body_id.GetIndexAndSequenceNumber()) << 1) | (body.IsActive() ? 1u : 0u));
+        hash = PhysicsDeterminism::mixFloat(hash, float(position.GetX()));
+        hash = PhysicsDeterminism::mixFloat(hash, float(position.GetY()));
+        hash = PhysicsDeterminism::mixFloat(hash, float(position.GetZ()));
+        hash = PhysicsDeterminism::mixFloat(hash, rotation.GetX());
+        hash = PhysicsDeterminism::mixFloat(hash, rotation.GetY());
+        hash = PhysicsDeterminism::mixFloat(hash, rotation.GetZ());
+        hash = PhysicsDeterminism::mixFloat(hash, rotation.GetW());
+        hash = PhysicsDeterminism::mixFloat(hash, linear.GetX());
+        hash = PhysicsDeterminism::mixFloat(hash, linear.GetY());
+        hash = PhysicsDeterminism::mixFloat(hash, linear.GetZ());
+        hash = PhysicsDeterminism::mixFloat(hash, angular.GetX());
+        hash = PhysicsDeterminism::mixFloat(hash, angular.GetY());
+        hash = PhysicsDeterminism::mixFloat(hash, angular.GetZ());
+    }
+    return hash;
+}
+
+void PhysicsSystem::recordStateHash(uint32_t tick)
+{
+    if (!determinism_checks || !initialized)
+        return;
+
+    state_hashes.record(tick, computeStateHash());
+}
+
 void PhysicsSystem::syncTransformsFromJolt(entt::registry& registry)
 {
     JPH::BodyInterface& body_interface = jolt_system->GetBodyInterface();
@@ -944,10 +1090,11 @@ void PhysicsSystem::handlePlayerCollisions(entt::registry& registry, entt::entit
         JPH::RayCastResult hit;
         JPH::IgnoreSingleBodyFilter body_filter(it->second);
 
+        // Only ground the player on layers the character collides with
         player.grounded = jolt_system->GetNarrowPhaseQuery().CastRay(
             ray, hit,
-            JPH::BroadPhaseLayerFilter(),
-            JPH::ObjectLayerFilter(),
+            jolt_system->GetDefaultBroadPhaseLayerFilter(settings.layers.character_body),
+            jolt_system->GetDefaultLayerFilter(settings.layers.character_body),
             body_filter);
         if (player.grounded)
         {
@@ -997,8 +1144,144 @@ bool PhysicsSystem::raycast(const glm::vec3& origin, const glm::vec3& direction,
     return true;
 }
 
+void PhysicsSystem::castLineOfSightBatch(const glm::vec3* from, const glm::vec3* to, size_t count,
+    uint8_t* out_blocked) const
+{
+    if (!initialized)
+    {
+        std::fill(out_blocked, out_blocked + count, uint8_t(0));
+        return;
+    }
+
+    std::shared_lock<std::shared_mutex> query_lock(async_query_mutex);
+
+    JPH::RayCastSettings ray_settings;
+    ray_settings.SetBackFaceMode(JPH::EBackFaceMode::IgnoreBackFaces);
+    ray_settings.mTreatConvexAsSolid = false;
+
+    const PhysicsLayerMask static_mask = PhysicsLayerSettings::layerBit(settings.layers.static_body);
+    const LayerMaskBroadPhaseFilter static_trees(settings.layers.getBroadPhaseMask(static_mask));
+    const LayerMaskObjectLayerFilter static_only(static_mask);
+    const JPH::NarrowPhaseQuery& query = jolt_system->GetNarrowPhaseQuery();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        JPH::RRayCast ray(toJoltR(from[i]), toJolt(to[i] - from[i]));
+        JPH::AnyHitCollisionCollector<JPH::CastRayCollector> collector;
+        query.CastRay(ray, ray_settings, collector, static_trees, static_only);
+        out_blocked[i] = collector.HadHit() ? 1 : 0;
+    }
+}
+
+void PhysicsSystem::runSceneQueries(const SceneQuery* queries, SceneQueryResult* results, size_t count) const
+{
+    if (!initialized)
+        return;
+
+    std::shared_lock<std::shared_mutex> query_lock(async_query_mutex);
+
+    const JPH::NarrowPhaseQuery& narrow_phase = jolt_system->GetNarrowPhaseQuery();
+    const JPH::BodyLockInterfaceLocking& lock_interface = jolt_system->GetBodyLockInterface();
+
+    auto entityForBody = [this](const JPH::BodyID& body_id) {
+        auto it = body_to_entity.find(body_id);
+        return it != body_to_entity.end() ? it->second : entt::entity(entt::null);
+    };
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SceneQuery& q = queries[i];
+        SceneQueryResult& result = results[i];
+        IgnoreEntityBodyFilter body_filter(body_to_entity, q.ignored_entity);
+        const LayerMaskBroadPhaseFilter broad_phase_filter(settings.layers.getBroadPhaseMask(q.layer_mask));
+        const LayerMaskObjectLayerFilter layer_filter(q.layer_mask);
+
+        const bool is_cast = q.type == SceneQueryType::Raycast || q.type == SceneQueryType::SphereCast ||
+            q.type == SceneQueryType::BoxCast;
+        if (is_cast && (q.max_distance <= 0.0f || glm::length(q.direction) <= settings.raycast_direction_epsilon))
+            continue;
+
+        if (q.type == SceneQueryType::Raycast)
+        {
+            const JPH::RRayCast ray(toJoltR(q.origin), toJolt(glm::normalize(q.direction)) * q.max_distance);
+            JPH::RayCastResult hit;
+            if (!narrow_phase.CastRay(ray, hit, broad_phase_filter, layer_filter, body_filter))
+                continue;
+
+            const JPH::RVec3 hit_pos = ray.GetPointOnRay(hit.mFraction);
+            result.hit = true;
+            result.entity = entityForBody(hit.mBodyID);
+            result.point = glm::vec3(float(hit_pos.GetX()), float(hit_pos.GetY()), float(hit_pos.GetZ()));
+            result.fraction = hit.mFraction;
+            result.distance = hit.mFraction * q.max_distance;
+
+            JPH::BodyLockRead lock(lock_interface, hit.mBodyID);
+            if (lock.Succeeded())
+                result.normal = toGlm(lock.GetBody().GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, hit_pos));
+            continue;
+        }
+
+        JPH::ShapeRefC shape;
+        if (q.type == SceneQueryType::SphereCast || q.type == SceneQueryType::SphereOverlap)
+            shape = new JPH::SphereShape(std::max(q.radius, 0.001f));
+        else
+            shape = new JPH::BoxShape(toJolt(glm::max(q.half_extents, glm::vec3(0.001f))), 0.0f);
+
+        const JPH::RMat44 transform = JPH::RMat44::sRotationTranslation(toJoltQuat(q.rotation), toJoltR(q.origin));
+
+        if (is_cast)
+        {
+            const glm::vec3 motion = glm::normalize(q.direction) * q.max_distance;
+            const JPH::RShapeCast shape_cast = JPH::RShapeCast::sFromWorldTransform(
+                shape, JPH::Vec3::sReplicate(1.0f), transform, toJolt(motion));
+
+            JPH::ShapeCastSettings cast_settings;
+            cast_settings.mBackFaceModeTriangles = JPH::EBackFaceMode::IgnoreBackFaces;
+            cast_settings.mBackFaceModeConvex = JPH::EBackFaceMode::IgnoreBackFaces;
+
+            JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+            narrow_phase.CastShape(shape_cast, cast_settings, transform.GetTranslation(), collector,
+                broad_phase_filter, layer_filter, body_filter);
+            if (!collector.HadHit())
+                continue;
+
+            result.hit = true;
+            result.entity = entityForBody(collector.mHit.mBodyID2);
+            result.fraction = collector.mHit.mFraction;
+            result.distance = collector.mHit.mFraction * q.max_distance;
+            result.point = q.origin + motion * collector.mHit.mFraction;
+            if (collector.mHit.mPenetrationAxis.LengthSq() > 0.0f)
+                result.normal = toGlm(collector.mHit.mPenetrationAxis.Normalized());
+            continue;
+        }
+
+        JPH::CollideShapeSettings collide_settings;
+        collide_settings.mBackFaceMode = JPH::EBackFaceMode::IgnoreBackFaces;
+        JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> collector;
+        narrow_phase.CollideShape(shape, JPH::Vec3::sReplicate(1.0f), transform, collide_settings,
+            transform.GetTranslation(), collector, broad_phase_filter, layer_filter, body_filter);
+        if (!collector.HadHit())
+            continue;
+
+        // Several sub-shapes of one body report separately
+        collector.Sort();
+        for (const JPH::CollideShapeResult& hit : collector.mHits)
+        {
+            const entt::entity entity = entityForBody(hit.mBodyID2);
+            if (std::find(result.overlaps.begin(), result.overlaps.end(), entity) != result.overlaps.end())
+                continue;
+            result.overlaps.push_back(entity);
+            if (result.overlaps.size() >= SceneQueryQueue::MAX_OVERLAP_HITS)
+                break;
+        }
+        result.hit = true;
+        result.entity = result.overlaps.front();
+        result.point = q.origin;
+    }
+}
+
 PhysicsSystem::RaycastResult PhysicsSystem::raycastClosest(const glm::vec3& origin, const glm::vec3& direction,
-    float maxDistance, entt::entity ignoredEntity)
+    float maxDistance, entt::entity ignoredEntity, PhysicsLayerMask layerMask)
 {
     RaycastResult result;
     if (!initialized) return result;
@@ -1008,11 +1291,13 @@ PhysicsSystem::RaycastResult PhysicsSystem::raycastClosest(const glm::vec3& orig
     JPH::RRayCast ray(toJoltR(origin), dir);
     JPH::RayCastResult hit;
     IgnoreEntityBodyFilter body_filter(body_to_entity, ignoredEntity);
+    const LayerMaskBroadPhaseFilter broad_phase_filter(settings.layers.getBroadPhaseMask(layerMask));
+    const LayerMaskObjectLayerFilter layer_filter(layerMask);
 
     if (jolt_system->GetNarrowPhaseQuery().CastRay(
         ray, hit,
-        JPH::BroadPhaseLayerFilter(),
-        JPH::ObjectLayerFilter(),
+        broad_phase_filter,
+        layer_filter,
         body_filter))
     {
         JPH::RVec3 hitPos = ray.GetPointOnRay(hit.mFraction);
@@ -8,12 +8,17 @@
 #include <glm/gtc/quaternion.hpp>
 #include "Character/CharacterControllerSystem.hpp"
 #include "Components/Components.hpp"
+#include "Physics/PhysicsDeterminism.hpp"
 #include "Physics/PhysicsSettings.hpp"
+#include "Physics/RagdollSystem.hpp"
+#include "Physics/SceneQueryQueue.hpp"
+#include "Physics/SimulationLod.hpp"
 #include <entt/entt.hpp>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <cmath>
+#include <shared_mutex>
 
 // Jolt includes
 #include <Jolt/Jolt.h>
@@ -73,9 +78,7 @@ public:
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
     virtual const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override
     {
-        if (inLayer == layers.static_broad_phase) return "Static";
-        if (inLayer == layers.dynamic_broad_phase) return "Dynamic";
-        return "Invalid";
+        return getPhysicsBroadPhaseName(inLayer);
     }
 #endif
 
@@ -119,6 +122,36 @@ private:
     PhysicsLayerSettings layers;
 };
 
+// Query filters over a PhysicsLayerMask. The broadphase filter skips whole trees that hold
+// none of the requested layers; the object filter then rejects individual layers.
+class LayerMaskBroadPhaseFilter final : public JPH::BroadPhaseLayerFilter
+{
+public:
+    explicit LayerMaskBroadPhaseFilter(uint32_t broad_phase_mask) : mask(broad_phase_mask) {}
+
+    virtual bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
+    {
+        return (mask >> inLayer.GetValue()) & 1u;
+    }
+
+private:
+    uint32_t mask;
+};
+
+class LayerMaskObjectLayerFilter final : public JPH::ObjectLayerFilter
+{
+public:
+    explicit LayerMaskObjectLayerFilter(PhysicsLayerMask layer_mask) : mask(layer_mask) {}
+
+    virtual bool ShouldCollide(JPH::ObjectLayer inLayer) const override
+    {
+        return (mask & PhysicsLayerSettings::layerBit(inLayer)) != 0;
+    }
+
+private:
+    PhysicsLayerMask mask;
+};
+
 // Contact listener that queues CollisionEvents for main-thread dispatch
 class EngineContactListener : public JPH::ContactListener
 {
@@ -204,6 +237,18 @@ private:
     std::unordered_map<entt::entity, JPH::Ref<JPH::Constraint>> entity_to_constraint;
 
     CharacterControllerSystem character_controllers;
+    RagdollSystem ragdolls;
+    SimulationLodSystem simulation_lod;
+
+    // Jolt queries must not overlap PhysicsSystem::Update. stepPhysics() holds
+    // this exclusively; worker-thread queries (castLineOfSightBatch) hold it shared.
+    mutable std::shared_mutex async_query_mutex;
+
+    SceneQueryQueue scene_queries;
+
+    // Desync detection: hash of all non-static bodies after each recorded tick
+    bool determinism_checks = false;
+    PhysicsStateHashHistory state_hashes;
 
     bool initialized = false;
 
@@ -250,8 +295,13 @@ public:
         float restitution = 0.0f;
         bool apply_gravity = true;
         bool lock_rotation = true;
+        JPH::ObjectLayer object_layer = JPH::cObjectLayerInvalid; // Invalid picks the layer for the motion type
     };
 
+private:
+    JPH::ObjectLayer resolveBodyLayer(const PhysicsBodyDesc& desc, JPH::ObjectLayer motion_type_layer) const;
+
+public:
     explicit PhysicsSystem(const PhysicsSystemSettings& settings);
     PhysicsSystem(const glm::vec3& gravityVector = glm::vec3(0, -1, 0), float deltaTime = 1.0f / 60.0f);
     ~PhysicsSystem();
@@ -307,9 +357,26 @@ public:
         const CharacterControllerState& state);
     bool teleportCharacterController(entt::registry& registry, entt::entity entity, const glm::vec3& position);
 
+    // Ragdolls: starts and stops RagdollComponent ragdolls, reads their poses back and
+    // applies motors and LOD. Run after stepping and before AnimationSystem::update.
+    void updateRagdolls(entt::registry& registry, const glm::vec3& camera_position, float dt,
+        const RagdollLodSettings& lod_settings = {}, RagdollStats* out_stats = nullptr);
+    void prewarmRagdolls(const std::shared_ptr<Skeleton>& skeleton,
+        const std::shared_ptr<const RagdollProfile>& profile, size_t count);
+    const RagdollSystem& getRagdolls() const { return ragdolls; }
+
     // Main physics update
     void stepPhysics(entt::registry& registry);
 
+    // Simulation LOD: dynamic bodies far from every observer get fewer solver iterations or
+    // are frozen until an observer or a contact wakes them. Off until settings enable it and
+    // observers are set; stepPhysics applies the latest observers before each step.
+    void setSimulationLodSettings(const SimulationLodSettings& lod_settings) { simulation_lod.setSettings(lod_settings); }
+    const SimulationLodSettings& getSimulationLodSettings() const { return simulation_lod.getSettings(); }
+    void setSimulationLodObservers(const glm::vec3* positions, size_t count) { simulation_lod.setObservers(positions, count); }
+    SimulationLod getSimulationLod(entt::entity entity) const;
+    const SimulationLodStats& getSimulationLodStats() const { return simulation_lod.getStats(); }
+
     // Collision detection and response
     void handlePlayerCollisions(entt::registry& registry, entt::entity playerEntity);
 
@@ -317,7 +384,25 @@ public:
     bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
         entt::registry& registry, glm::vec3& hitPoint, glm::vec3& hitNormal);
     RaycastResult raycastClosest(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
-        entt::entity ignoredEntity = entt::null);
+        entt::entity ignoredEntity = entt::null, PhysicsLayerMask layerMask = PHYSICS_ALL_LAYERS);
+
+    // Batched line-of-sight test against static geometry: out_blocked[i] = 1
+    // if a static body lies between from[i] and to[i]. Rays starting inside a
+    // convex shape ignore it. Safe to call from a worker thread.
+    void castLineOfSightBatch(const glm::vec3* from, const glm::vec3* to, size_t count, uint8_t* out_blocked) const;
+
+    // Deferred scene queries: enqueue during the tick, results and callbacks arrive in
+    // executeSceneQueries(), which world::step_physics runs before stepping.
+    SceneQueryHandle enqueueQuery(const SceneQuery& query, SceneQueryCallback callback = {})
+    {
+        return scene_queries.enqueue(query, std::move(callback));
+    }
+    void executeSceneQueries() { scene_queries.execute(); }
+    SceneQueryQueue& getSceneQueries() { return scene_queries; }
+    const SceneQueryQueue& getSceneQueries() const { return scene_queries; }
+
+    // Runs queries immediately. Safe to call from several worker threads at once.
+    void runSceneQueries(const SceneQuery* queries, SceneQueryResult* results, size_t count) const;
 
     // Shape casting result
     struct ShapeCastResult {
@@ -330,16 +415,31 @@ public:
 
     // Shape casting queries
     ShapeCastResult shapeCast(const JPH::ShapeRefC& shape, const glm::vec3& position,
-        const glm::vec3& rotation, const glm::vec3& direction);
+        const glm::vec3& rotation, const glm::vec3& direction, PhysicsLayerMask layerMask = PHYSICS_ALL_LAYERS);
     ShapeCastResult sphereCast(const glm::vec3& origin, float radius,
-        const glm::vec3& direction, float maxDistance);
+        const glm::vec3& direction, float maxDistance, PhysicsLayerMask layerMask = PHYSICS_ALL_LAYERS);
     ShapeCastResult boxCast(const glm::vec3& origin, const glm::vec3& halfExtents,
-        const glm::vec3& rotation, const glm::vec3& direction, float maxDistance);
+        const glm::vec3& rotation, const glm::vec3& direction, float maxDistance,
+        PhysicsLayerMask layerMask = PHYSICS_ALL_LAYERS);
+
+    // Collision layers
+    const PhysicsLayerSettings& getLayerSettings() const { return settings.layers; }
+    JPH::ObjectLayer findLayer(std::string_view name) const { return settings.layers.findLayer(name); }
+    PhysicsLayerMask getLayerMask(std::string_view name) const { return settings.layers.getLayerMask(name); }
+    JPH::ObjectLayer getBodyLayer(entt::entity entity) const;
 
     // Constraint management
     JPH::Constraint* createConstraint(entt::entity entityA, entt::entity entityB, const ConstraintComponent& constraint);
     void removeConstraint(entt::entity entity);
 
+    // Determinism checks. Off by default; the server turns them on with sv_physics_hash.
+    void setDeterminismChecks(bool enabled);
+    bool getDeterminismChecks() const { return determinism_checks; }
+    uint64_t computeStateHash() const;
+    void recordStateHash(uint32_t tick);  // No-op unless determinism checks are on
+    bool getStateHash(uint32_t tick, uint64_t& out_hash) const { return state_hashes.find(tick, out_hash); }
+    const PhysicsStateHashHistory& getStateHashHistory() const { return state_hashes; }
+
     // Access Jolt system
     JPH::PhysicsSystem* getJoltSystem() { return jolt_system.get(); }
     JPH::BodyInterface& getBodyInterface();
@@ -105,7 +105,15 @@ public:
     {
         if (!game_world) return;
 
-        camera& active_cam = game_world->world_camera;
+        applyMouseLook(game_world->world_camera, yrel, xrel);
+    }
+
+    // Turns a camera by a mouse delta at the possessed entity's sensitivity. Register it as
+    // the frame pacer's camera latch so latched and simulated look turn at the same speed.
+    void applyMouseLook(camera& active_cam, float yrel, float xrel) const
+    {
+        if (!game_world) return;
+
         float sensitivity = 1.0f;
 
         if (currently_possessed == PossessedEntityType::Player && game_world->registry.valid(player_entity))
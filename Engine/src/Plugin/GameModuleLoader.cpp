@@ -1,5 +1,7 @@
 #include "GameModuleLoader.hpp"
 #include "GameFramework/GameModeRegistry.hpp"
+#include "Reflection/ReflectionRegistry.hpp"
+#include <algorithm>
 #include <cstdio>
 #include <filesystem>
 
@@ -188,6 +190,12 @@ void GameModuleLoader::unload()
     if (!m_handle) return;
 
     GameFramework::GameModeRegistry::get().unregisterBySource(getGameName());
+    if (m_reflection)
+    {
+        for (uint32_t type_id : m_component_types)
+            m_reflection->unregisterComponent(type_id);
+    }
+    m_component_types.clear();
     clearFunctionPointers();
     platformUnload(m_handle);
     m_handle = nullptr;
@@ -211,6 +219,38 @@ bool GameModuleLoader::reload(const std::string& dll_path)
     return load(dll_path);
 }
 
+bool GameModuleLoader::reload(const std::string& dll_path, const std::vector<entt::registry*>& registries)
+{
+    ReflectionRegistry* reflection = m_reflection;
+    if (!reflection)
+        return reload(dll_path);
+
+    printf("[GameModule] Hot-reloading '%s' (preserving state)...\n", dll_path.c_str());
+
+    // Local to this call: the snapshot keys components by registry address,
+    // which must not outlive a failed reload (the caller destroys the world).
+    ModuleStateSnapshot preserved;
+    size_t captured = 0;
+    if (m_handle)
+        captured = preserved.captureAndRelease(registries, *reflection, m_component_types);
+
+    unload();
+    if (!load(dll_path))
+    {
+        fprintf(stderr, "[GameModule] Reload failed; dropped %zu preserved component(s)\n", preserved.size());
+        return false;
+    }
+
+    registerComponents(reflection);
+    m_last_restore = preserved.restore(*reflection);
+
+    printf("[GameModule] Preserved %zu component(s): restored %zu, dropped %zu "
+           "(fields: %zu defaulted, %zu discarded, %zu rejected)\n",
+           captured, m_last_restore.components_restored, m_last_restore.components_dropped,
+           m_last_restore.fields_defaulted, m_last_restore.fields_discarded, m_last_restore.fields_rejected);
+    return true;
+}
+
 bool GameModuleLoader::resolveFunctions()
 {
     // Required client exports
@@ -281,7 +321,25 @@ void GameModuleLoader::shutdown()
 
 void GameModuleLoader::registerComponents(ReflectionRegistry* registry)
 {
-    if (m_fnRegisterComponents) m_fnRegisterComponents(registry);
+    if (!m_fnRegisterComponents || !registry) return;
+
+    // Anything that appears during the call belongs to this module. A second
+    // loader registering the same DLL (PIE clients) adds nothing new and so
+    // does not take ownership.
+    std::vector<uint32_t> before;
+    before.reserve(registry->count());
+    for (const auto& desc : registry->getAll())
+        before.push_back(desc.type_id);
+
+    m_fnRegisterComponents(registry);
+    m_reflection = registry;
+
+    for (const auto& desc : registry->getAll())
+    {
+        if (std::find(before.begin(), before.end(), desc.type_id) == before.end() &&
+            std::find(m_component_types.begin(), m_component_types.end(), desc.type_id) == m_component_types.end())
+            m_component_types.push_back(desc.type_id);
+    }
 }
 
 void GameModuleLoader::update(float delta_time)
@@ -2,8 +2,10 @@
 
 #include "EngineExport.h"
 #include "GameModuleAPI.h"
+#include "ModuleStateSnapshot.hpp"
 #include <string>
 #include <cstdint>
+#include <vector>
 
 // Loads and manages a game module DLL at runtime.
 // Handles hot-reload by copying the DLL before loading (Windows locks loaded DLLs).
@@ -16,13 +18,27 @@ public:
     // Load a game DLL from disk. On Windows, copies to a temp path first.
     bool load(const std::string& dll_path);
 
-    // Unload the currently loaded DLL.
+    // Unload the currently loaded DLL. Component types it registered are
+    // removed from the reflection registry (their bridge functions live in the DLL).
     void unload();
 
     // Hot-reload: unload current, copy new, load copy.
     // Returns false if the new DLL fails to load (old is already unloaded).
     bool reload(const std::string& dll_path);
 
+    // Stateful hot-reload. Reflected components the module registered are
+    // captured from `registries` and their storage released before unload;
+    // the new DLL's components are then registered and the data restored
+    // onto the same entities. The caller shuts the module down before and
+    // calls init() after. If the new DLL fails to load, the captured state is
+    // dropped: the caller is expected to tear the world down, and the snapshot
+    // refers to its registries by address.
+    bool reload(const std::string& dll_path, const std::vector<entt::registry*>& registries);
+
+    // Type ids of the reflected components registered by the loaded module
+    const std::vector<uint32_t>& getRegisteredComponentTypes() const { return m_component_types; }
+    const ModuleStateRestoreStats& getLastRestoreStats() const { return m_last_restore; }
+
     bool isLoaded() const { return m_handle != nullptr; }
     const std::string& getLoadedPath() const { return m_source_path; }
 
@@ -54,6 +70,10 @@ private:
     std::string m_loaded_path;        // Temp copy path (for hot-reload)
     int m_reload_counter = 0;         // Increments each reload for unique temp names
 
+    ReflectionRegistry* m_reflection = nullptr;  // Set by registerComponents()
+    std::vector<uint32_t> m_component_types;     // Registered by this module
+    ModuleStateRestoreStats m_last_restore;
+
     // Client function pointers (required)
     using FnGetAPIVersion       = int32_t(*)();
     using FnGetGameName         = const char*(*)();
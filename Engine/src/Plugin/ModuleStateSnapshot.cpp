@@ -0,0 +1,89 @@
+#include "ModuleStateSnapshot.hpp"
+#include "Reflection/ReflectionPropertyOps.hpp"
+#include "Reflection/ReflectionSerializer.hpp"
+
+size_t ModuleStateSnapshot::captureAndRelease(const std::vector<entt::registry*>& registries,
+                                              const ReflectionRegistry& reflection,
+                                              const std::vector<uint32_t>& type_ids)
+{
+    size_t captured = 0;
+    for (entt::registry* registry : registries)
+    {
+        if (!registry)
+            continue;
+
+        for (uint32_t type_id : type_ids)
+        {
+            const ComponentDescriptor* desc = reflection.findByTypeId(type_id);
+            if (!desc)
+                continue;
+
+            // Iterate the type-erased storage; the descriptor's bridge functions
+            // still point into the old module at this point.
+            if (const auto* storage = registry->storage(type_id))
+            {
+                for (entt::entity entity : *storage)
+                {
+                    void* comp = desc->get(*registry, entity);
+                    if (!comp)
+                        continue;
+
+                    SavedComponent saved;
+                    saved.registry = registry;
+                    saved.entity = entity;
+                    saved.name = desc->name;
+                    saved.fields = ReflectionSerializer::serializeComponent(*desc, comp);
+                    m_components.push_back(std::move(saved));
+                    captured++;
+                }
+            }
+
+            // Destroys the components and the pool itself (its vtable lives in the module)
+            registry->reset(type_id);
+        }
+    }
+    return captured;
+}
+
+ModuleStateRestoreStats ModuleStateSnapshot::restore(const ReflectionRegistry& reflection)
+{
+    ModuleStateRestoreStats stats;
+
+    for (const SavedComponent& saved : m_components)
+    {
+        const ComponentDescriptor* desc = reflection.findByName(saved.name.c_str());
+        if (!desc || !saved.registry->valid(saved.entity))
+        {
+            stats.components_dropped++;
+            continue;
+        }
+
+        desc->add(*saved.registry, saved.entity);
+        void* comp = desc->get(*saved.registry, saved.entity);
+        if (!comp)
+        {
+            stats.components_dropped++;
+            continue;
+        }
+
+        size_t matched = 0;
+        for (const auto& prop : desc->properties)
+        {
+            auto it = saved.fields.find(prop.name);
+            if (it == saved.fields.end())
+            {
+                stats.fields_defaulted++;
+                continue;
+            }
+
+            matched++;
+            if (!ReflectionPropertyOps::deserializeProperty(prop, comp, *it))
+                stats.fields_rejected++;
+        }
+        stats.fields_discarded += saved.fields.size() - matched;
+        stats.components_restored++;
+    }
+
+    m_components.clear();
+    return stats;
+}
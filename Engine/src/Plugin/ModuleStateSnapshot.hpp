@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Reflection/ReflectionRegistry.hpp"
+#include "json.hpp"
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ModuleStateRestoreStats
+{
+    size_t components_restored = 0;
+    size_t components_dropped = 0;   // Type no longer registered, or entity gone
+    size_t fields_defaulted = 0;     // New fields with no saved value
+    size_t fields_discarded = 0;     // Saved fields the new type no longer has
+    size_t fields_rejected = 0;      // Saved value no longer fits the field's type
+};
+
+// Holds a game module's reflected component data across a hot reload.
+//
+// Component storage for a module-defined type is instantiated inside the
+// module, so it has to be serialized and destroyed while the old code is
+// still mapped. After the new module registers its types, restore() re-adds
+// the components to the same entities by serialized name. Fields are matched
+// by name: added fields keep their defaults, removed fields are ignored, and
+// values whose type changed are left at the default.
+class ENGINE_API ModuleStateSnapshot
+{
+public:
+    // Serialize every component of the given types from each registry, then
+    // discard their storage. Returns the number of components captured.
+    size_t captureAndRelease(const std::vector<entt::registry*>& registries,
+                             const ReflectionRegistry& reflection,
+                             const std::vector<uint32_t>& type_ids);
+
+    // Re-add captured components using the currently registered descriptors.
+    // The snapshot is cleared afterwards.
+    ModuleStateRestoreStats restore(const ReflectionRegistry& reflection);
+
+    bool empty() const { return m_components.empty(); }
+    size_t size() const { return m_components.size(); }
+    void clear() { m_components.clear(); }
+
+private:
+    struct SavedComponent
+    {
+        entt::registry* registry = nullptr;
+        entt::entity entity = entt::null;
+        std::string name;
+        nlohmann::json fields;
+    };
+
+    std::vector<SavedComponent> m_components;
+};
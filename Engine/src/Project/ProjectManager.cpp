@@ -1,4 +1,5 @@
 #include "ProjectManager.hpp"
+#include "Physics/PhysicsSettings.hpp"
 #include <fstream>
 #include <filesystem>
 #include <cstdio>
@@ -10,6 +11,134 @@
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
+static void loadPhysicsLayers(const json& j, ProjectPhysicsLayers& out)
+{
+    out = ProjectPhysicsLayers{};
+    if (!j.is_object())
+        return;
+
+    out.static_layer = j.value("static_layer", out.static_layer);
+    out.dynamic_layer = j.value("dynamic_layer", out.dynamic_layer);
+    out.character_layer = j.value("character_layer", out.character_layer);
+    if (!j.contains("layers") || !j["layers"].is_array())
+        return;
+
+    for (const auto& entry : j["layers"])
+    {
+        if (!entry.is_object())
+            continue;
+        ProjectPhysicsLayer layer;
+        layer.name = entry.value("name", "");
+        layer.broad_phase = entry.value("broad_phase", layer.broad_phase);
+        if (entry.contains("collides_with") && entry["collides_with"].is_array())
+        {
+            for (const auto& other : entry["collides_with"])
+            {
+                if (other.is_string())
+                    layer.collides_with.push_back(other.get<std::string>());
+            }
+        }
+        out.layers.push_back(std::move(layer));
+    }
+}
+
+static json savePhysicsLayers(const ProjectPhysicsLayers& project_layers)
+{
+    json j;
+    j["static_layer"] = project_layers.static_layer;
+    j["dynamic_layer"] = project_layers.dynamic_layer;
+    j["character_layer"] = project_layers.character_layer;
+    j["layers"] = json::array();
+    for (const ProjectPhysicsLayer& layer : project_layers.layers)
+    {
+        j["layers"].push_back({
+            {"name", layer.name},
+            {"broad_phase", layer.broad_phase},
+            {"collides_with", layer.collides_with},
+        });
+    }
+    return j;
+}
+
+PhysicsLayerSettings makePhysicsLayerSettings(const ProjectPhysicsLayers& project_layers)
+{
+    PhysicsLayerSettings settings;
+    if (project_layers.layers.empty())
+        return settings;
+
+    settings.clearLayers();
+    for (const ProjectPhysicsLayer& layer : project_layers.layers)
+    {
+        JPH::BroadPhaseLayer broad_phase = PhysicsBroadPhaseLayers::Moving;
+        if (!findPhysicsBroadPhase(layer.broad_phase, broad_phase))
+            fprintf(stderr, "[ProjectManager] Physics layer '%s' has unknown broad phase '%s', using Moving\n",
+                    layer.name.c_str(), layer.broad_phase.c_str());
+        if (layer.name.empty() || settings.findLayer(layer.name) != JPH::cObjectLayerInvalid)
+        {
+            fprintf(stderr, "[ProjectManager] Skipping unnamed or duplicate physics layer '%s'\n", layer.name.c_str());
+            continue;
+        }
+        if (settings.addLayer(layer.name, broad_phase) == JPH::cObjectLayerInvalid)
+        {
+            fprintf(stderr, "[ProjectManager] Too many physics layers, ignoring '%s'\n", layer.name.c_str());
+            break;
+        }
+    }
+
+    for (const ProjectPhysicsLayer& layer : project_layers.layers)
+    {
+        const JPH::ObjectLayer a = settings.findLayer(layer.name);
+        for (const std::string& other : layer.collides_with)
+        {
+            const JPH::ObjectLayer b = settings.findLayer(other);
+            if (a == JPH::cObjectLayerInvalid || b == JPH::cObjectLayerInvalid)
+            {
+                fprintf(stderr, "[ProjectManager] Physics layer '%s' collides with unknown layer '%s'\n",
+                        layer.name.c_str(), other.c_str());
+                continue;
+            }
+            settings.setCollides(a, b, true);
+        }
+    }
+
+    auto resolve = [&](const std::string& name, JPH::ObjectLayer fallback) {
+        const JPH::ObjectLayer layer = settings.findLayer(name);
+        if (layer != JPH::cObjectLayerInvalid)
+            return layer;
+        fprintf(stderr, "[ProjectManager] Unknown default physics layer '%s'\n", name.c_str());
+        return fallback;
+    };
+    settings.static_body = resolve(project_layers.static_layer, 0);
+    settings.dynamic_body = resolve(project_layers.dynamic_layer, 0);
+    settings.character_body = resolve(project_layers.character_layer, settings.dynamic_body);
+    return settings;
+}
+
+ProjectPhysicsLayers makeProjectPhysicsLayers(const PhysicsLayerSettings& layer_settings)
+{
+    ProjectPhysicsLayers project_layers;
+    for (JPH::ObjectLayer a = 0; a < layer_settings.object_layer_count; ++a)
+    {
+        ProjectPhysicsLayer layer;
+        layer.name = layer_settings.names[a];
+        layer.broad_phase = getPhysicsBroadPhaseName(layer_settings.broad_phases[a]);
+        for (JPH::ObjectLayer b = 0; b < layer_settings.object_layer_count; ++b)
+        {
+            if (layer_settings.shouldObjectsCollide(a, b))
+                layer.collides_with.push_back(layer_settings.names[b]);
+        }
+        project_layers.layers.push_back(std::move(layer));
+    }
+
+    if (layer_settings.isValidLayer(layer_settings.static_body))
+        project_layers.static_layer = layer_settings.names[layer_settings.static_body];
+    if (layer_settings.isValidLayer(layer_settings.dynamic_body))
+        project_layers.dynamic_layer = layer_settings.names[layer_settings.dynamic_body];
+    if (layer_settings.isValidLayer(layer_settings.character_body))
+        project_layers.character_layer = layer_settings.names[layer_settings.character_body];
+    return project_layers;
+}
+
 bool ProjectManager::loadProject(const std::string& project_file_path)
 {
     m_loaded = false;
@@ -55,6 +184,8 @@ bool ProjectManager::loadProject(const std::string& project_file_path)
     if (m_descriptor.asset_directories.empty())
         m_descriptor.asset_directories.push_back("assets/");
 
+    loadPhysicsLayers(j.value("physics_layers", json::object()), m_descriptor.physics_layers);
+
     m_loaded = true;
     printf("[ProjectManager] Loaded project '%s' from '%s'\n",
            m_descriptor.name.c_str(), project_file_path.c_str());
@@ -217,6 +348,8 @@ bool ProjectManager::saveProject()
     j["asset_directories"] = m_descriptor.asset_directories;
     j["source_directory"] = m_descriptor.source_directory;
     j["buildscript"] = m_descriptor.buildscript;
+    if (!m_descriptor.physics_layers.layers.empty())
+        j["physics_layers"] = savePhysicsLayers(m_descriptor.physics_layers);
 
     std::ofstream file(m_project_file_path);
     if (!file.is_open())
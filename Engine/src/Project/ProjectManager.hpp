@@ -4,6 +4,24 @@
 #include <string>
 #include <vector>
 
+struct PhysicsLayerSettings;
+
+// One named collision layer as stored in the .garden file
+struct ENGINE_API ProjectPhysicsLayer
+{
+    std::string name;
+    std::string broad_phase = "Moving";      // Static, Moving, Debris or Query
+    std::vector<std::string> collides_with;  // Layer names; the matrix is symmetric
+};
+
+struct ENGINE_API ProjectPhysicsLayers
+{
+    std::vector<ProjectPhysicsLayer> layers;  // Empty uses the engine's default layers
+    std::string static_layer = "Static";      // Layers bodies get when their collider names none
+    std::string dynamic_layer = "Dynamic";
+    std::string character_layer = "Character";
+};
+
 struct ENGINE_API ProjectDescriptor
 {
     std::string name;
@@ -16,8 +34,14 @@ struct ENGINE_API ProjectDescriptor
     std::vector<std::string> asset_directories;
     std::string source_directory;  // e.g. "src/"
     std::string buildscript;       // e.g. "MyGame.buildscript"
+    ProjectPhysicsLayers physics_layers;
 };
 
+// Builds the physics layer set from the project. Unknown names are reported and skipped;
+// a project without layers gets the engine defaults.
+ENGINE_API PhysicsLayerSettings makePhysicsLayerSettings(const ProjectPhysicsLayers& project_layers);
+ENGINE_API ProjectPhysicsLayers makeProjectPhysicsLayers(const PhysicsLayerSettings& layer_settings);
+
 // Info about a discovered project template.
 struct ENGINE_API TemplateInfo
 {
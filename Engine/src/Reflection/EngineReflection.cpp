@@ -6,6 +6,8 @@
 void registerEngineReflection(ReflectionRegistry& registry)
 {
     registry.reflect<TransformComponent>("TransformComponent");
+    registry.reflect<LocalTransformComponent>("LocalTransformComponent");
+    registry.reflect<HierarchyComponent>("HierarchyComponent");
     registry.reflect<TagComponent>("TagComponent");
     registry.reflect<TerrainComponent>("TerrainComponent");
     registry.reflect<RigidBodyComponent>("RigidBodyComponent");
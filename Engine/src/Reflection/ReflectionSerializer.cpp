@@ -1,5 +1,6 @@
 #include "ReflectionSerializer.hpp"
 #include "ReflectionPropertyOps.hpp"
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -94,11 +95,14 @@ json ReflectionSerializer::serializeLevel(
 
     for (auto entity : registry.view<entt::entity>())
     {
-        entities.push_back(serializeEntity(registry, entity, reflection));
+        json entity_json = serializeEntity(registry, entity, reflection);
+        // Saved ids only key entity references; loading assigns new entities
+        entity_json["id"] = entt::to_integral(entity);
+        entities.push_back(std::move(entity_json));
     }
 
     level["format"] = "garden_reflected";
-    level["version"] = 1;
+    level["version"] = 2;
     level["entities"] = entities;
     return level;
 }
@@ -111,9 +115,52 @@ void ReflectionSerializer::deserializeLevel(
     if (!level_json.contains("entities"))
         return;
 
-    for (auto& entity_json : level_json["entities"])
+    // Create every entity first so references to later entities can be remapped
+    const json& entities = level_json["entities"];
+    std::vector<entt::entity> created;
+    created.reserve(entities.size());
+    std::unordered_map<uint32_t, entt::entity> id_map;
+    for (auto& entity_json : entities)
     {
         entt::entity entity = registry.create();
-        deserializeEntity(registry, entity, entity_json, reflection);
+        created.push_back(entity);
+        if (entity_json.contains("id") && entity_json["id"].is_number_unsigned())
+            id_map[entity_json["id"].get<uint32_t>()] = entity;
+    }
+
+    for (size_t i = 0; i < created.size(); ++i)
+        deserializeEntity(registry, created[i], entities[i], reflection);
+
+    for (entt::entity entity : created)
+        remapEntityReferences(registry, entity, id_map, reflection);
+}
+
+void ReflectionSerializer::remapEntityReferences(
+    entt::registry& registry,
+    entt::entity entity,
+    const std::unordered_map<uint32_t, entt::entity>& id_map,
+    const ReflectionRegistry& reflection)
+{
+    for (auto& desc : reflection.getAll())
+    {
+        if (!desc.has(registry, entity))
+            continue;
+
+        void* comp = desc.get(registry, entity);
+        if (!comp)
+            continue;
+
+        for (const auto& prop : desc.properties)
+        {
+            if (prop.type != EPropertyType::Entity || !prop.mutable_data)
+                continue;
+
+            auto* ref = static_cast<entt::entity*>(prop.mutable_data(comp));
+            if (*ref == entt::null)
+                continue;
+
+            auto it = id_map.find(entt::to_integral(*ref));
+            *ref = it != id_map.end() ? it->second : entt::null;
+        }
     }
 }
@@ -3,6 +3,7 @@
 #include "EngineExport.h"
 #include "ReflectionRegistry.hpp"
 #include <entt/entt.hpp>
+#include <unordered_map>
 #include "json.hpp"
 
 // Serialize/deserialize entities using reflected component metadata.
@@ -29,12 +30,22 @@ public:
         const nlohmann::json& entity_json,
         const ReflectionRegistry& reflection);
 
-    // Deserialize all entities from a level JSON document
+    // Deserialize all entities from a level JSON document. Entity references
+    // (e.g. HierarchyComponent::parent) are remapped from the saved ids to the
+    // entities created for them; references to entities not in the level become null.
     static void deserializeLevel(
         entt::registry& registry,
         const nlohmann::json& level_json,
         const ReflectionRegistry& reflection);
 
+    // Rewrite every reflected entt::entity property on entity through id_map
+    // (saved id -> loaded entity). Unmapped references are cleared to entt::null.
+    static void remapEntityReferences(
+        entt::registry& registry,
+        entt::entity entity,
+        const std::unordered_map<uint32_t, entt::entity>& id_map,
+        const ReflectionRegistry& reflection);
+
     // Serialize a single component's properties to JSON
     static nlohmann::json serializeComponent(
         const ComponentDescriptor& desc,
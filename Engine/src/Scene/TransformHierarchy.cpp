@@ -0,0 +1,446 @@
+#include "TransformHierarchy.hpp"
+#include "Threading/JobSystem.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    bool hasNode(const entt::registry& registry, entt::entity entity)
+    {
+        return entity != entt::null && registry.valid(entity) && registry.all_of<HierarchyComponent>(entity);
+    }
+
+    // Inverse of composeTransformMatrix for matrices without shear
+    void decomposeTransform(const glm::mat4& matrix, glm::vec3& position, glm::vec3& rotation, glm::vec3& scale)
+    {
+        position = glm::vec3(matrix[3]);
+
+        const glm::vec3 axis_x(matrix[0]);
+        const glm::vec3 axis_y(matrix[1]);
+        const glm::vec3 axis_z(matrix[2]);
+        scale = glm::vec3(glm::length(axis_x), glm::length(axis_y), glm::length(axis_z));
+        if (glm::dot(glm::cross(axis_x, axis_y), axis_z) < 0.0f)
+            scale.x = -scale.x;
+
+        auto safe = [](float s) { return std::abs(s) > 1e-8f ? s : 1.0f; };
+        glm::mat4 rotation_matrix(1.0f);
+        rotation_matrix[0] = glm::vec4(axis_x / safe(scale.x), 0.0f);
+        rotation_matrix[1] = glm::vec4(axis_y / safe(scale.y), 0.0f);
+        rotation_matrix[2] = glm::vec4(axis_z / safe(scale.z), 0.0f);
+
+        float yaw = 0.0f, pitch = 0.0f, roll = 0.0f;
+        glm::extractEulerAngleYXZ(rotation_matrix, yaw, pitch, roll);
+        rotation = glm::degrees(glm::vec3(pitch, yaw, roll));
+    }
+
+    void ensureNode(entt::registry& registry, entt::entity entity)
+    {
+        if (!registry.all_of<TransformComponent>(entity))
+            registry.emplace<TransformComponent>(entity);
+        if (!registry.all_of<HierarchyComponent>(entity))
+            registry.emplace<HierarchyComponent>(entity);
+    }
+
+    void unlinkFromParent(entt::registry& registry, HierarchyComponent& node)
+    {
+        if (node.parent == entt::null)
+            return;
+
+        if (node.prev_sibling != entt::null)
+            registry.get<HierarchyComponent>(node.prev_sibling).next_sibling = node.next_sibling;
+        else
+            registry.get<HierarchyComponent>(node.parent).first_child = node.next_sibling;
+
+        if (node.next_sibling != entt::null)
+            registry.get<HierarchyComponent>(node.next_sibling).prev_sibling = node.prev_sibling;
+
+        node.parent = entt::null;
+        node.prev_sibling = entt::null;
+        node.next_sibling = entt::null;
+    }
+
+    void linkToParent(entt::registry& registry, entt::entity child, HierarchyComponent& node, entt::entity parent)
+    {
+        // Push front: O(1) even under parents with thousands of children
+        HierarchyComponent& parent_node = registry.get<HierarchyComponent>(parent);
+        node.parent = parent;
+        node.prev_sibling = entt::null;
+        node.next_sibling = parent_node.first_child;
+        if (parent_node.first_child != entt::null)
+            registry.get<HierarchyComponent>(parent_node.first_child).prev_sibling = child;
+        parent_node.first_child = child;
+    }
+
+    void removeNodeIfIsolated(entt::registry& registry, entt::entity entity)
+    {
+        if (!hasNode(registry, entity))
+            return;
+        const HierarchyComponent& node = registry.get<HierarchyComponent>(entity);
+        if (node.parent == entt::null && node.first_child == entt::null)
+            registry.remove<HierarchyComponent>(entity);
+    }
+}
+
+bool TransformHierarchy::setParent(entt::registry& registry, entt::entity child, entt::entity parent, bool keep_world)
+{
+    if (!registry.valid(child) || child == parent)
+        return false;
+    if (parent != entt::null && !registry.valid(parent))
+        return false;
+
+    for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = getParent(registry, ancestor))
+    {
+        if (ancestor == child)
+            return false;
+    }
+
+    // Emplace everything first: emplacing into a pool invalidates references into it
+    ensureNode(registry, child);
+    if (parent != entt::null)
+        ensureNode(registry, parent);
+
+    HierarchyComponent& node = registry.get<HierarchyComponent>(child);
+    const entt::entity old_parent = node.parent;
+    if (old_parent == parent)
+        return true;
+
+    TransformComponent& transform = registry.get<TransformComponent>(child);
+    LocalTransformComponent offset;
+    if (const LocalTransformComponent* local = registry.try_get<LocalTransformComponent>(child);
+        local && old_parent != entt::null)
+    {
+        offset = *local;
+    }
+    else
+    {
+        offset.position = transform.position;
+        offset.rotation = transform.rotation;
+        offset.scale = transform.scale;
+    }
+
+    unlinkFromParent(registry, node);
+
+    if (parent != entt::null)
+    {
+        linkToParent(registry, child, node, parent);
+        if (keep_world)
+        {
+            const glm::mat4 parent_world = registry.get<TransformComponent>(parent).getTransformMatrix();
+            decomposeTransform(glm::inverse(parent_world) * transform.getTransformMatrix(),
+                offset.position, offset.rotation, offset.scale);
+        }
+        registry.emplace_or_replace<LocalTransformComponent>(child, offset);
+    }
+    else
+    {
+        // TransformComponent already holds the last propagated world transform
+        if (!keep_world)
+        {
+            transform.position = offset.position;
+            transform.rotation = offset.rotation;
+            transform.scale = offset.scale;
+        }
+        registry.remove<LocalTransformComponent>(child);
+    }
+    node.dirty = true;
+
+    // Removing swaps the last element of the pool into place, so references die here
+    if (old_parent != entt::null)
+        removeNodeIfIsolated(registry, old_parent);
+    removeNodeIfIsolated(registry, child);
+
+    structure_dirty = true;
+    return true;
+}
+
+entt::entity TransformHierarchy::getParent(const entt::registry& registry, entt::entity entity)
+{
+    if (!hasNode(registry, entity))
+        return entt::null;
+    return registry.get<HierarchyComponent>(entity).parent;
+}
+
+std::vector<entt::entity> TransformHierarchy::getChildren(const entt::registry& registry, entt::entity entity)
+{
+    std::vector<entt::entity> children;
+    if (!hasNode(registry, entity))
+        return children;
+
+    for (entt::entity child = registry.get<HierarchyComponent>(entity).first_child; child != entt::null;
+         child = registry.get<HierarchyComponent>(child).next_sibling)
+    {
+        children.push_back(child);
+    }
+    return children;
+}
+
+void TransformHierarchy::markDirty(entt::registry& registry, entt::entity entity)
+{
+    if (hasNode(registry, entity))
+        registry.get<HierarchyComponent>(entity).dirty = true;
+}
+
+void TransformHierarchy::clear()
+{
+    nodes.clear();
+    parent_index.clear();
+    level_offsets.clear();
+    world_matrices.clear();
+    authored.clear();
+    changed.clear();
+    stats.nodes = 0;
+    stats.levels = 0;
+    stats.updated = 0;
+    structure_dirty = true;
+}
+
+void TransformHierarchy::relink(entt::registry& registry)
+{
+    auto view = registry.view<HierarchyComponent>();
+
+    // A parent set by hand (inspector, level file) may not be a node yet
+    std::vector<entt::entity> new_parents;
+    for (entt::entity entity : view)
+    {
+        const entt::entity parent = view.get<HierarchyComponent>(entity).parent;
+        if (parent != entt::null && parent != entity && registry.valid(parent) &&
+            !registry.all_of<HierarchyComponent>(parent))
+        {
+            new_parents.push_back(parent);
+        }
+    }
+    for (entt::entity parent : new_parents)
+        ensureNode(registry, parent);
+
+    for (entt::entity entity : view)
+    {
+        HierarchyComponent& node = view.get<HierarchyComponent>(entity);
+        node.first_child = entt::null;
+        node.prev_sibling = entt::null;
+        node.next_sibling = entt::null;
+        node.dirty = true;
+        if (node.parent == entity || (node.parent != entt::null && !hasNode(registry, node.parent)))
+        {
+            // Parent was destroyed: the child stays at its last world transform
+            node.parent = entt::null;
+            registry.remove<LocalTransformComponent>(entity);
+        }
+    }
+
+    // setParent refuses cycles, but hand-edited parents can close one. Detaching the
+    // first node found on each cycle turns it back into a tree.
+    const size_t max_depth = view.size();
+    for (entt::entity entity : view)
+    {
+        entt::entity ancestor = view.get<HierarchyComponent>(entity).parent;
+        for (size_t steps = 0; ancestor != entt::null && ancestor != entity && steps < max_depth; ++steps)
+            ancestor = view.get<HierarchyComponent>(ancestor).parent;
+        if (ancestor == entity)
+        {
+            view.get<HierarchyComponent>(entity).parent = entt::null;
+            registry.remove<LocalTransformComponent>(entity);
+        }
+    }
+
+    for (entt::entity entity : view)
+    {
+        HierarchyComponent& node = view.get<HierarchyComponent>(entity);
+        if (node.parent != entt::null)
+            linkToParent(registry, entity, node, node.parent);
+    }
+}
+
+void TransformHierarchy::rebuild(entt::registry& registry)
+{
+    auto view = registry.view<HierarchyComponent>();
+
+    // Destroying an entity skips setParent, leaving links to entities that no longer exist.
+    // Components added or parents edited by hand leave the sibling lists out of date.
+    bool needs_relink = false;
+    for (entt::entity entity : view)
+    {
+        const HierarchyComponent& node = view.get<HierarchyComponent>(entity);
+        if ((node.parent != entt::null && !hasNode(registry, node.parent)) ||
+            (node.first_child != entt::null && !hasNode(registry, node.first_child)) ||
+            (node.next_sibling != entt::null && !hasNode(registry, node.next_sibling)) ||
+            (node.prev_sibling != entt::null && !hasNode(registry, node.prev_sibling)))
+        {
+            needs_relink = true;
+            break;
+        }
+
+        const bool linked = node.parent == entt::null
+            ? node.prev_sibling == entt::null && node.next_sibling == entt::null
+            : node.prev_sibling != entt::null
+                ? view.get<HierarchyComponent>(node.prev_sibling).parent == node.parent
+                : view.get<HierarchyComponent>(node.parent).first_child == entity;
+        if (!linked || (node.first_child != entt::null &&
+                           view.get<HierarchyComponent>(node.first_child).parent != entity))
+        {
+            needs_relink = true;
+            break;
+        }
+    }
+    if (needs_relink)
+        relink(registry);
+
+    // Components added by hand instead of through setParent
+    for (entt::entity entity : view)
+    {
+        if (!registry.all_of<TransformComponent>(entity))
+            registry.emplace<TransformComponent>(entity);
+        if (view.get<HierarchyComponent>(entity).parent != entt::null && !registry.all_of<LocalTransformComponent>(entity))
+        {
+            const TransformComponent& transform = registry.get<TransformComponent>(entity);
+            LocalTransformComponent local;
+            local.position = transform.position;
+            local.rotation = transform.rotation;
+            local.scale = transform.scale;
+            registry.emplace<LocalTransformComponent>(entity, local);
+        }
+    }
+
+    nodes.clear();
+    parent_index.clear();
+    level_offsets.clear();
+
+    for (entt::entity entity : view)
+    {
+        HierarchyComponent& node = view.get<HierarchyComponent>(entity);
+        if (node.parent != entt::null)
+            continue;
+        node.depth = 0;
+        nodes.push_back(entity);
+        parent_index.push_back(-1);
+    }
+
+    // Breadth-first from the roots, so every level is contiguous and follows its parents
+    level_offsets.push_back(0);
+    size_t level_begin = 0;
+    uint32_t depth = 1;
+    while (level_begin < nodes.size())
+    {
+        const size_t level_end = nodes.size();
+        level_offsets.push_back(static_cast<uint32_t>(level_end));
+        for (size_t i = level_begin; i < level_end; ++i)
+        {
+            for (entt::entity child = view.get<HierarchyComponent>(nodes[i]).first_child; child != entt::null;)
+            {
+                HierarchyComponent& child_node = view.get<HierarchyComponent>(child);
+                child_node.depth = depth;
+                nodes.push_back(child);
+                parent_index.push_back(static_cast<int32_t>(i));
+                child = child_node.next_sibling;
+            }
+        }
+        level_begin = level_end;
+        ++depth;
+    }
+
+    // NaN never compares equal, so every node recomputes once after a rebuild
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    authored.assign(nodes.size(), TransformSnapshot{glm::vec3(nan), glm::vec3(nan), glm::vec3(nan)});
+    world_matrices.resize(nodes.size());
+    changed.assign(nodes.size(), 0);
+
+    stats.nodes = static_cast<uint32_t>(nodes.size());
+    stats.levels = static_cast<uint32_t>(level_offsets.size() - 1);
+    stats.rebuilds++;
+    structure_dirty = false;
+}
+
+uint32_t TransformHierarchy::propagateRange(entt::storage_for_t<HierarchyComponent>& hierarchy,
+    entt::storage_for_t<TransformComponent>& transforms,
+    const entt::storage_for_t<LocalTransformComponent>& locals, size_t begin, size_t end)
+{
+    uint32_t updated = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const entt::entity entity = nodes[i];
+        HierarchyComponent& node = hierarchy.get(entity);
+        TransformComponent& transform = transforms.get(entity);
+        const bool forced = node.dirty;
+        node.dirty = false;
+
+        const int32_t parent = parent_index[i];
+        const TransformSnapshot snapshot = parent < 0
+            ? TransformSnapshot{transform.position, transform.rotation, transform.scale}
+            : TransformSnapshot{locals.get(entity).position, locals.get(entity).rotation, locals.get(entity).scale};
+
+        const TransformSnapshot& previous = authored[i];
+        const bool same = snapshot.position == previous.position &&
+            snapshot.rotation == previous.rotation && snapshot.scale == previous.scale;
+        if (!forced && same && (parent < 0 || !changed[parent]))
+        {
+            changed[i] = 0;
+            continue;
+        }
+
+        authored[i] = snapshot;
+        if (parent < 0)
+        {
+            world_matrices[i] = transform.getTransformMatrix();
+        }
+        else
+        {
+            world_matrices[i] = world_matrices[parent] *
+                composeTransformMatrix(snapshot.position, snapshot.rotation, snapshot.scale);
+            decomposeTransform(world_matrices[i], transform.position, transform.rotation, transform.scale);
+        }
+        changed[i] = 1;
+        ++updated;
+    }
+    return updated;
+}
+
+void TransformHierarchy::propagate(entt::registry& registry)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    auto& hierarchy = registry.storage<HierarchyComponent>();
+    bool stale = structure_dirty || hierarchy.size() != nodes.size();
+    for (size_t i = 0; i < nodes.size() && !stale; ++i)
+    {
+        // Component swapped or parent edited by hand since the last rebuild
+        const int32_t parent = parent_index[i];
+        stale = !hierarchy.contains(nodes[i]) ||
+            hierarchy.get(nodes[i]).parent != (parent < 0 ? entt::entity{entt::null} : nodes[parent]);
+    }
+    if (stale)
+        rebuild(registry);
+
+    // Looked up once here: worker threads must not touch the registry's pool map
+    auto& transforms = registry.storage<TransformComponent>();
+    const auto& locals = registry.storage<LocalTransformComponent>();
+
+    uint32_t updated = 0;
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    const size_t min_batch = settings.min_batch_size > 0 ? settings.min_batch_size : 1;
+    for (size_t level = 0; level + 1 < level_offsets.size(); ++level)
+    {
+        const size_t begin = level_offsets[level];
+        const size_t count = level_offsets[level + 1] - begin;
+
+        if (settings.parallel && jobs.isInitialized() && count >= min_batch * 2)
+        {
+            std::atomic<uint32_t> level_updated{0};
+            jobs.parallelFor("TransformHierarchy", count, min_batch,
+                [&, begin](size_t batch_begin, size_t batch_end) {
+                    level_updated.fetch_add(
+                        propagateRange(hierarchy, transforms, locals, begin + batch_begin, begin + batch_end),
+                        std::memory_order_relaxed);
+                },
+                Threading::JobPriority::High);
+            updated += level_updated.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            updated += propagateRange(hierarchy, transforms, locals, begin, begin + count);
+        }
+    }
+
+    stats.updated = updated;
+    stats.propagate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
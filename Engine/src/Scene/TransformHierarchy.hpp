@@ -0,0 +1,86 @@
+#pragma once
+
+#include "EngineExport.h"
+#include "Components/Components.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+struct TransformHierarchySettings
+{
+    bool parallel = true;
+    size_t min_batch_size = 512;   // Levels smaller than two batches run on the calling thread
+};
+
+struct TransformHierarchyStats
+{
+    uint32_t nodes = 0;
+    uint32_t levels = 0;
+    uint32_t updated = 0;          // World transforms recomputed by the last propagate()
+    uint32_t rebuilds = 0;         // Flat array rebuilds since creation
+    double propagate_ms = 0.0;
+};
+
+// Parent/child transforms. Parented entities author a LocalTransformComponent, and
+// propagate() writes their world result into TransformComponent, so physics (kinematic
+// bodies), rendering and replication keep reading TransformComponent unchanged. Roots
+// keep authoring TransformComponent directly.
+//
+// Nodes live in a flat array sorted by depth. Each level is processed in parallel, and
+// only subtrees whose root transform, local transform or dirty flag changed are
+// recomputed. World transforms with shear (non-uniform parent scale under a rotated
+// child) lose the shear when written back to TransformComponent; grandchildren still
+// use the exact matrix.
+class ENGINE_API TransformHierarchy
+{
+public:
+    // Attaches child under parent, or detaches it when parent is entt::null. With
+    // keep_world the child stays where it is; otherwise its current transform becomes
+    // the offset from the new parent. Fails on invalid entities and on cycles.
+    bool setParent(entt::registry& registry, entt::entity child, entt::entity parent, bool keep_world = true);
+    void detach(entt::registry& registry, entt::entity child, bool keep_world = true)
+    {
+        setParent(registry, child, entt::null, keep_world);
+    }
+
+    static entt::entity getParent(const entt::registry& registry, entt::entity entity);
+    static std::vector<entt::entity> getChildren(const entt::registry& registry, entt::entity entity);
+    static void markDirty(entt::registry& registry, entt::entity entity);
+
+    // Recomputes world transforms for dirty subtrees, parents before children
+    void propagate(entt::registry& registry);
+
+    // Drops the flat array; the next propagate rebuilds it and recomputes everything
+    void clear();
+
+    void setSettings(const TransformHierarchySettings& new_settings) { settings = new_settings; }
+    const TransformHierarchySettings& getSettings() const { return settings; }
+    const TransformHierarchyStats& getStats() const { return stats; }
+
+private:
+    struct TransformSnapshot
+    {
+        glm::vec3 position;
+        glm::vec3 rotation;
+        glm::vec3 scale;
+    };
+
+    void rebuild(entt::registry& registry);
+    void relink(entt::registry& registry);
+    uint32_t propagateRange(entt::storage_for_t<HierarchyComponent>& hierarchy,
+        entt::storage_for_t<TransformComponent>& transforms,
+        const entt::storage_for_t<LocalTransformComponent>& locals, size_t begin, size_t end);
+
+    TransformHierarchySettings settings;
+    TransformHierarchyStats stats;
+
+    std::vector<entt::entity> nodes;         // Depth-sorted
+    std::vector<int32_t> parent_index;       // Into nodes, -1 for roots
+    std::vector<uint32_t> level_offsets;     // levels + 1 entries
+    std::vector<glm::mat4> world_matrices;
+    std::vector<TransformSnapshot> authored; // Last seen root world / child local transform
+    std::vector<uint8_t> changed;            // Recomputed during the current propagate
+    bool structure_dirty = true;
+};
@@ -0,0 +1,174 @@
+#include "FramePacer.hpp"
+#include "Components/camera.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // EMA weight for new samples; ~10 frames of memory
+    constexpr double PREDICTION_ALPHA = 0.1;
+    // Predict mean + N deviations so an ordinary slow frame still makes its deadline
+    constexpr double PREDICTION_DEVIATIONS = 2.0;
+    // Fixed slack for scheduler wake-up jitter after SDL_DelayPrecise
+    constexpr uint64_t WAKE_MARGIN_NS = 250000;
+    // Upper bound on mouse events inspected by the late latch
+    constexpr int MAX_LATCH_EVENTS = 256;
+}
+
+FramePacer::FramePacer()
+    : now_fn([]() { return static_cast<uint64_t>(SDL_GetTicksNS()); })
+    , sleep_fn([](uint64_t ns) { SDL_DelayPrecise(ns); })
+{
+    setTargetFPS(target_fps);
+}
+
+void FramePacer::setTargetFPS(int fps)
+{
+    if (fps == target_fps && (period_ns != 0 || fps <= 0))
+        return;
+
+    target_fps = fps;
+    period_ns = fps > 0 ? 1000000000ull / static_cast<uint64_t>(fps) : 0;
+    next_submit_ns = 0;  // Re-anchor on the next submit
+    stats.period_ns = period_ns;
+}
+
+void FramePacer::setTimeSource(NowFn now, SleepFn sleep)
+{
+    now_fn = std::move(now);
+    sleep_fn = std::move(sleep);
+    next_submit_ns = 0;
+}
+
+void FramePacer::sleepUntil(uint64_t deadline_ns)
+{
+    const uint64_t current = now();
+    if (deadline_ns > current)
+    {
+        sleep_fn(deadline_ns - current);
+        stats.last_wait_ns += deadline_ns - current;
+    }
+}
+
+void FramePacer::beginFrame()
+{
+    stats.last_wait_ns = 0;
+
+    if (mode == FramePacingMode::LowLatency && next_submit_ns != 0)
+    {
+        // Sleep now, before input is polled, so the wait is not spent
+        // holding input that has already been sampled.
+        const uint64_t predicted = stats.predicted_cpu_ns + WAKE_MARGIN_NS;
+        if (next_submit_ns > predicted)
+            sleepUntil(next_submit_ns - predicted);
+    }
+
+    frame_start_ns = now();
+    input_sample_ns = frame_start_ns;
+}
+
+void FramePacer::markInputSampled()
+{
+    input_sample_ns = now();
+}
+
+void FramePacer::markSubmitted(float gpu_frame_ms, bool gpu_frame_ms_valid, float cpu_blocked_ms)
+{
+    const uint64_t submit_ns = now();
+    const uint64_t elapsed_ns = submit_ns - input_sample_ns;
+    const uint64_t blocked_ns = std::min(elapsed_ns, static_cast<uint64_t>(std::max(cpu_blocked_ms, 0.0f) * 1.0e6f));
+    const double work_ns = static_cast<double>(elapsed_ns - blocked_ns);
+
+    if (!has_cpu_sample)
+    {
+        cpu_mean_ns = work_ns;
+        cpu_dev_ns = 0.0;
+        has_cpu_sample = true;
+    }
+    else
+    {
+        cpu_dev_ns += PREDICTION_ALPHA * (std::abs(work_ns - cpu_mean_ns) - cpu_dev_ns);
+        cpu_mean_ns += PREDICTION_ALPHA * (work_ns - cpu_mean_ns);
+    }
+
+    if (gpu_frame_ms_valid && gpu_frame_ms > 0.0f)
+    {
+        const double gpu_ns = static_cast<double>(gpu_frame_ms) * 1.0e6;
+        if (!has_gpu_sample)
+        {
+            gpu_mean_ns = gpu_ns;
+            gpu_dev_ns = 0.0;
+            has_gpu_sample = true;
+        }
+        else
+        {
+            gpu_dev_ns += PREDICTION_ALPHA * (std::abs(gpu_ns - gpu_mean_ns) - gpu_dev_ns);
+            gpu_mean_ns += PREDICTION_ALPHA * (gpu_ns - gpu_mean_ns);
+        }
+    }
+
+    stats.frame_index++;
+    stats.last_input_to_submit_ns = elapsed_ns;
+    stats.last_blocked_ns = blocked_ns;
+    stats.predicted_cpu_ns = static_cast<uint64_t>(cpu_mean_ns + PREDICTION_DEVIATIONS * cpu_dev_ns);
+    stats.predicted_gpu_ns = has_gpu_sample ? static_cast<uint64_t>(gpu_mean_ns + PREDICTION_DEVIATIONS * gpu_dev_ns) : 0;
+
+    // A GPU-bound frame cannot be presented faster than the GPU finishes it;
+    // pacing the CPU to that rate keeps it from blocking on a fence after
+    // input has been sampled.
+    const uint64_t interval = std::max(period_ns, stats.predicted_gpu_ns);
+    if (mode != FramePacingMode::LowLatency || interval == 0)
+    {
+        next_submit_ns = 0;
+        return;
+    }
+
+    // Keep a fixed cadence while deadlines are being met; re-anchor once a
+    // frame overruns so a long hitch does not cause a burst of catch-up frames.
+    next_submit_ns = next_submit_ns != 0 ? next_submit_ns + interval : submit_ns + interval;
+    if (next_submit_ns <= submit_ns)
+        next_submit_ns = submit_ns + interval;
+}
+
+void FramePacer::endFrame()
+{
+    if (mode != FramePacingMode::EndOfFrame || period_ns == 0)
+        return;
+
+    sleepUntil(frame_start_ns + period_ns);
+}
+
+bool FramePacer::lateLatchCamera(camera& render_camera, float sensitivity_x, float sensitivity_y) const
+{
+    SDL_PumpEvents();
+
+    SDL_Event events[MAX_LATCH_EVENTS];
+    const int count = SDL_PeepEvents(events, MAX_LATCH_EVENTS, SDL_PEEKEVENT,
+                                     SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    if (count <= 0)
+        return false;
+
+    float dx = 0.0f;
+    float dy = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        dx += events[i].motion.xrel;
+        dy += events[i].motion.yrel;
+    }
+    if (dx == 0.0f && dy == 0.0f)
+        return false;
+
+    if (camera_latch)
+    {
+        camera_latch(render_camera, dx, dy);
+        return true;
+    }
+
+    // PlayerController::applyMouseLook without the per-entity sensitivity; modules using
+    // PlayerController register that through setCameraLatch
+    render_camera.rotation.x += dy / 1000.0f * sensitivity_y;
+    render_camera.rotation.y += -dx / 1000.0f * sensitivity_x;
+    render_camera.rotation.x = std::clamp(render_camera.rotation.x, -1.5f, 1.5f);
+    return true;
+}
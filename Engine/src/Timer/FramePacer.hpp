@@ -0,0 +1,108 @@
+#pragma once
+
+#include "EngineExport.h"
+#include <cstdint>
+#include <functional>
+
+class camera;
+
+enum class FramePacingMode
+{
+    EndOfFrame = 0,  // Legacy: simulate, submit, then sleep off the remainder of the frame
+    LowLatency = 1,  // Sleep before input polling so input is as fresh as possible at submit
+};
+
+struct FramePacerStats
+{
+    uint64_t frame_index = 0;
+    uint64_t period_ns = 0;            // Target frame interval (0 = uncapped)
+    uint64_t predicted_cpu_ns = 0;     // Predicted input-sample -> submit time
+    uint64_t predicted_gpu_ns = 0;     // Predicted GPU frame time (0 when the backend reports none)
+    uint64_t last_wait_ns = 0;         // Time slept by the pacer for the last frame
+    uint64_t last_input_to_submit_ns = 0;
+    uint64_t last_blocked_ns = 0;      // Part of the above spent blocked on the GPU
+};
+
+// Frame pacing with CPU/GPU work prediction.
+//
+// In LowLatency mode the wait happens at the top of the frame: the pacer
+// predicts how long sampling->submit will take and sleeps until
+// (next submit deadline - predicted work), so the input polled right after
+// beginFrame() is at most one frame of work old when it is submitted. When
+// the GPU is the bottleneck the frame interval stretches to the predicted
+// GPU time, which keeps the CPU from racing ahead and blocking on a fence
+// while holding already-sampled input.
+//
+// Typical loop:
+//   pacer.beginFrame();            // LowLatency wait
+//   poll input; pacer.markInputSampled();
+//   simulate; pacer.lateLatchCamera(cam, input);  (optional)
+//   record + submit; pacer.markSubmitted(gpu_ms, gpu_ms_valid, fence_wait_ms);
+//   pacer.endFrame();              // EndOfFrame wait
+class ENGINE_API FramePacer
+{
+public:
+    using NowFn = std::function<uint64_t()>;
+    using SleepFn = std::function<void(uint64_t)>;
+    using CameraLatchFn = std::function<void(camera&, float mouse_dx, float mouse_dy)>;
+
+    FramePacer();
+
+    void setMode(FramePacingMode new_mode) { mode = new_mode; }
+    FramePacingMode getMode() const { return mode; }
+
+    // fps <= 0 disables the cap (the pacer still measures latency)
+    void setTargetFPS(int fps);
+    int getTargetFPS() const { return target_fps; }
+
+    // Override the clock and sleep (headless tests drive a virtual clock)
+    void setTimeSource(NowFn now, SleepFn sleep);
+
+    void beginFrame();
+    void markInputSampled();
+    // cpu_blocked_ms is time spent waiting on the GPU between sampling and
+    // submit (frame fence). It is excluded from the CPU prediction, since
+    // pacing exists to make it go away.
+    void markSubmitted(float gpu_frame_ms = 0.0f, bool gpu_frame_ms_valid = false, float cpu_blocked_ms = 0.0f);
+    void endFrame();
+
+    // Apply mouse motion that arrived after markInputSampled() to a copy of
+    // the camera used only for rendering. Events are peeked, not consumed, so
+    // the next frame's simulation still sees them and the camera converges.
+    // Returns false when nothing was latched.
+    bool lateLatchCamera(camera& render_camera, float sensitivity_x, float sensitivity_y) const;
+
+    // Game modules register the mapping from mouse delta to camera rotation.
+    // The default only applies the input sensitivity passed to lateLatchCamera;
+    // PlayerController users register PlayerController::applyMouseLook.
+    void setCameraLatch(CameraLatchFn fn) { camera_latch = std::move(fn); }
+
+    uint64_t getInputSampleTimeNS() const { return input_sample_ns; }
+    const FramePacerStats& getStats() const { return stats; }
+
+private:
+    uint64_t now() const { return now_fn(); }
+    void sleepUntil(uint64_t deadline_ns);
+
+    NowFn now_fn;
+    SleepFn sleep_fn;
+    CameraLatchFn camera_latch;
+
+    FramePacingMode mode = FramePacingMode::LowLatency;
+    int target_fps = 60;
+    uint64_t period_ns = 0;
+
+    uint64_t frame_start_ns = 0;
+    uint64_t input_sample_ns = 0;
+    uint64_t next_submit_ns = 0;  // LowLatency submit deadline for the next frame
+
+    // Exponential moving averages (mean and mean absolute deviation)
+    double cpu_mean_ns = 0.0;
+    double cpu_dev_ns = 0.0;
+    double gpu_mean_ns = 0.0;
+    double gpu_dev_ns = 0.0;
+    bool has_cpu_sample = false;
+    bool has_gpu_sample = false;
+
+    FramePacerStats stats;
+};
@@ -1,4 +1,5 @@
 #include "RmlRenderer_VK.h"
+#include "Console/ConVar.hpp"
 #include "Graphics/VulkanRenderAPI.hpp"
 #include "Utils/EnginePaths.hpp"
 #include "Utils/Log.hpp"
@@ -6,9 +7,21 @@
 
 #include "stb_image.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
 #include <fstream>
 #include <cstring>
 
+CONVAR(r_ui_batching, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Merge consecutive RmlUi geometry with matching texture/scissor/transform into one Vulkan draw");
+
+CONVAR(r_ui_atlas, 1, ConVarFlags::ARCHIVE | ConVarFlags::CLIENT_ONLY,
+       "Pack small RmlUi textures and glyph pages into shared atlas pages (applies to new textures)");
+
+CONVAR(r_ui_stats, 0, ConVarFlags::CLIENT_ONLY,
+       "Log RmlUi Vulkan batching counters (geometries, draws, vertices, record time) every frame");
+
 RmlRenderer_VK::RmlRenderer_VK() = default;
 
 RmlRenderer_VK::~RmlRenderer_VK()
@@ -39,6 +52,12 @@ bool RmlRenderer_VK::Init(VulkanRenderAPI* renderAPI)
     if (!CreateDescriptorResources())
         return false;
 
+    m_atlasShaders =
+        !ReadShaderFile(EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/rmlui_atlas.vert.spv")).empty() &&
+        !ReadShaderFile(EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/rmlui_atlas.frag.spv")).empty();
+    if (!m_atlasShaders)
+        LOG_ENGINE_WARN("RmlUi atlas shaders not found; rebuild shaders to enable UI texture atlasing");
+
     return true;
 }
 
@@ -49,22 +68,36 @@ void RmlRenderer_VK::Shutdown()
 
     vkDeviceWaitIdle(m_device);
 
-    // Release all geometries
-    for (auto& [id, geo] : m_geometries)
+    m_geometries.clear();
+    m_batchVertices.clear();
+    m_batchIndices.clear();
+    m_batches.clear();
+    m_batchTransforms.clear();
+
+    for (auto& stream : m_streams)
     {
-        vmaDestroyBuffer(m_allocator, geo.vertexBuffer, geo.vertexAlloc);
-        vmaDestroyBuffer(m_allocator, geo.indexBuffer, geo.indexAlloc);
+        if (stream.vertexBuffer) vmaDestroyBuffer(m_allocator, stream.vertexBuffer, stream.vertexAlloc);
+        if (stream.indexBuffer) vmaDestroyBuffer(m_allocator, stream.indexBuffer, stream.indexAlloc);
+        stream = StreamBuffer{};
     }
-    m_geometries.clear();
 
-    // Release all textures
+    // Release all textures (atlas entries share their page's image)
     for (auto& [id, tex] : m_textures)
     {
+        if (tex.atlasPage >= 0)
+            continue;
         vkDestroyImageView(m_device, tex.imageView, nullptr);
         vmaDestroyImage(m_allocator, tex.image, tex.allocation);
     }
     m_textures.clear();
 
+    for (auto& page : m_atlasPages)
+    {
+        vkDestroyImageView(m_device, page.imageView, nullptr);
+        vmaDestroyImage(m_allocator, page.image, page.allocation);
+    }
+    m_atlasPages.clear();
+
     if (m_sampler) { vkDestroySampler(m_device, m_sampler, nullptr); m_sampler = VK_NULL_HANDLE; }
     for (auto& [renderPass, pipelines] : m_pipelines)
     {
@@ -94,6 +127,27 @@ void RmlRenderer_VK::BeginFrame()
 {
     m_currentCmdBuffer = m_renderAPI->getCurrentCommandBuffer();
     m_currentRenderPass = m_renderAPI->getCurrentRmlRenderPass();
+
+    // The render API waited on this slot's fence before handing out the
+    // command buffer, so the stream written two frames ago can be rewound.
+    m_streamSlot = m_renderAPI->getCurrentFrameIndex() % kStreamSlots;
+    StreamBuffer& stream = m_streams[m_streamSlot];
+    const uint64_t serial = m_renderAPI->getFrameSerial();
+    if (stream.frameSerial != serial)
+    {
+        stream.frameSerial = serial;
+        stream.vertexCursor = 0;
+        stream.indexCursor = 0;
+    }
+
+    m_batchVertices.clear();
+    m_batchIndices.clear();
+    m_batches.clear();
+    m_batchTransforms.clear();
+    m_batchGeometries = 0;
+    m_transformIndex = -1;
+    m_scissorEnabled = false;
+    m_batchingEnabled = CVAR_BOOL(r_ui_batching);
 }
 
 std::vector<char> RmlRenderer_VK::ReadShaderFile(const std::string& path)
@@ -211,9 +265,14 @@ bool RmlRenderer_VK::CreatePipelines(VkRenderPass renderPass)
     if (renderPass == VK_NULL_HANDLE)
         return false;
 
-    // Load shaders
-    auto vertCode = ReadShaderFile(EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/rmlui.vert.spv"));
-    auto fragTexCode = ReadShaderFile(EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/rmlui_texture.frag.spv"));
+    // Load shaders. The atlas pair reads the per-vertex UV rect; the legacy
+    // pair ignores it, which is fine while no texture lives in an atlas page.
+    auto vertCode = ReadShaderFile(EnginePaths::resolveEngineAsset(m_atlasShaders
+        ? "../assets/shaders/compiled/vulkan/rmlui_atlas.vert.spv"
+        : "../assets/shaders/compiled/vulkan/rmlui.vert.spv"));
+    auto fragTexCode = ReadShaderFile(EnginePaths::resolveEngineAsset(m_atlasShaders
+        ? "../assets/shaders/compiled/vulkan/rmlui_atlas.frag.spv"
+        : "../assets/shaders/compiled/vulkan/rmlui_texture.frag.spv"));
     auto fragColCode = ReadShaderFile(EnginePaths::resolveEngineAsset("../assets/shaders/compiled/vulkan/rmlui_color.frag.spv"));
 
     if (vertCode.empty() || fragTexCode.empty() || fragColCode.empty())
@@ -258,31 +317,36 @@ bool RmlRenderer_VK::CreatePipelines(VkRenderPass renderPass)
     // Vertex input
     VkVertexInputBindingDescription bindingDesc = {};
     bindingDesc.binding = 0;
-    bindingDesc.stride = sizeof(Rml::Vertex);
+    bindingDesc.stride = sizeof(BatchVertex);
     bindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-    VkVertexInputAttributeDescription attrDescs[3] = {};
+    VkVertexInputAttributeDescription attrDescs[4] = {};
     // position
     attrDescs[0].location = 0;
     attrDescs[0].binding = 0;
     attrDescs[0].format = VK_FORMAT_R32G32_SFLOAT;
-    attrDescs[0].offset = offsetof(Rml::Vertex, position);
+    attrDescs[0].offset = offsetof(BatchVertex, position);
     // color
     attrDescs[1].location = 1;
     attrDescs[1].binding = 0;
     attrDescs[1].format = VK_FORMAT_R8G8B8A8_UNORM;
-    attrDescs[1].offset = offsetof(Rml::Vertex, colour);
+    attrDescs[1].offset = offsetof(BatchVertex, colour);
     // texcoord
     attrDescs[2].location = 2;
     attrDescs[2].binding = 0;
     attrDescs[2].format = VK_FORMAT_R32G32_SFLOAT;
-    attrDescs[2].offset = offsetof(Rml::Vertex, tex_coord);
+    attrDescs[2].offset = offsetof(BatchVertex, tex_coord);
+    // atlas UV clamp rect
+    attrDescs[3].location = 3;
+    attrDescs[3].binding = 0;
+    attrDescs[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attrDescs[3].offset = offsetof(BatchVertex, uvRect);
 
     VkPipelineVertexInputStateCreateInfo vertexInput = {};
     vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     vertexInput.vertexBindingDescriptionCount = 1;
     vertexInput.pVertexBindingDescriptions = &bindingDesc;
-    vertexInput.vertexAttributeDescriptionCount = 3;
+    vertexInput.vertexAttributeDescriptionCount = m_atlasShaders ? 4 : 3;
     vertexInput.pVertexAttributeDescriptions = attrDescs;
 
     VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
@@ -405,65 +469,202 @@ bool RmlRenderer_VK::CreatePipelines(VkRenderPass renderPass)
     return true;
 }
 
+
 Rml::CompiledGeometryHandle RmlRenderer_VK::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
+    // No GPU allocation here: RmlUi recompiles text and animated elements
+    // constantly, and the data is copied into the frame stream on render.
     GeometryData geo;
-    geo.numIndices = (int)indices.size();
-
-    VkDeviceSize vbSize = vertices.size() * sizeof(Rml::Vertex);
-    VkDeviceSize ibSize = indices.size() * sizeof(int);
+    geo.vertices.assign(vertices.begin(), vertices.end());
+    geo.indices.reserve(indices.size());
+    for (int index : indices)
+        geo.indices.push_back((uint32_t)index);
 
-    // Create vertex buffer (host visible for frequent UI updates)
-    VkBufferCreateInfo vbInfo = {};
-    vbInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    vbInfo.size = vbSize;
-    vbInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    uintptr_t handle = m_nextGeometryHandle++;
+    m_geometries[handle] = std::move(geo);
+    return (Rml::CompiledGeometryHandle)handle;
+}
 
-    VmaAllocationCreateInfo vbAllocInfo = {};
-    vbAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    vbAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+void RmlRenderer_VK::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+    auto it = m_geometries.find((uintptr_t)handle);
+    if (it == m_geometries.end() || !m_currentCmdBuffer || m_currentRenderPass == VK_NULL_HANDLE)
+        return;
 
-    if (vmaCreateBuffer(m_allocator, &vbInfo, &vbAllocInfo, &geo.vertexBuffer, &geo.vertexAlloc, nullptr) != VK_SUCCESS)
-        return 0;
+    const GeometryData& geo = it->second;
+    if (geo.indices.empty())
+        return;
 
-    // Copy vertex data
-    void* mapped = nullptr;
-    vmaMapMemory(m_allocator, geo.vertexAlloc, &mapped);
-    memcpy(mapped, vertices.data(), vbSize);
-    vmaUnmapMemory(m_allocator, geo.vertexAlloc);
+    // Resolve the descriptor and UV remap. Untextured geometry samples the
+    // white block of an atlas page, so it can join the page's batch instead
+    // of switching to the color-only pipeline.
+    VkDescriptorSet descriptorSet = m_colorOnlyDescriptorSet;
+    bool textured = false;
+    float uvOffset[2] = { 0.0f, 0.0f };
+    float uvScale[2] = { 1.0f, 1.0f };
+    // Standalone textures are clamped by the sampler; the open rect is a no-op.
+    float uvRect[4] = { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX };
+    if (texture)
+    {
+        auto tex_it = m_textures.find((uintptr_t)texture);
+        if (tex_it == m_textures.end())
+            return;
+        const TextureData& tex = tex_it->second;
+        descriptorSet = tex.descriptorSet;
+        textured = true;
+        uvOffset[0] = tex.uvOffset[0];
+        uvOffset[1] = tex.uvOffset[1];
+        uvScale[0] = tex.uvScale[0];
+        uvScale[1] = tex.uvScale[1];
+        if (tex.atlasPage >= 0)
+        {
+            uvRect[0] = tex.uvOffset[0];
+            uvRect[1] = tex.uvOffset[1];
+            uvRect[2] = tex.uvOffset[0] + tex.uvScale[0];
+            uvRect[3] = tex.uvOffset[1] + tex.uvScale[1];
+        }
+    }
+    else if (m_batchingEnabled && !m_batches.empty() && m_batches.back().textured)
+    {
+        const VkDescriptorSet lastSet = m_batches.back().descriptorSet;
+        for (const AtlasPage& page : m_atlasPages)
+        {
+            if (page.descriptorSet != lastSet)
+                continue;
+            descriptorSet = lastSet;
+            textured = true;
+            const float white = (kAtlasWhiteBlockSize * 0.5f) / (float)kAtlasPageSize;
+            uvOffset[0] = uvOffset[1] = white;
+            uvScale[0] = uvScale[1] = 0.0f;
+            uvRect[0] = uvRect[1] = uvRect[2] = uvRect[3] = white;
+            break;
+        }
+    }
 
-    // Create index buffer
-    VkBufferCreateInfo ibInfo = {};
-    ibInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    ibInfo.size = ibSize;
-    ibInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    const bool startNewBatch = !m_batchingEnabled || m_batches.empty() ||
+        m_batches.back().descriptorSet != descriptorSet ||
+        m_batches.back().textured != textured ||
+        m_batches.back().scissorEnabled != m_scissorEnabled ||
+        (m_scissorEnabled && m_batches.back().scissor != m_scissorRegion) ||
+        m_batches.back().transformIndex != m_transformIndex;
 
-    VmaAllocationCreateInfo ibAllocInfo = {};
-    ibAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    ibAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    if (startNewBatch)
+    {
+        DrawBatch batch{};
+        batch.descriptorSet = descriptorSet;
+        batch.textured = textured;
+        batch.scissorEnabled = m_scissorEnabled;
+        batch.scissor = m_scissorRegion;
+        batch.transformIndex = m_transformIndex;
+        batch.firstIndex = (uint32_t)m_batchIndices.size();
+        batch.indexCount = 0;
+        m_batches.push_back(batch);
+    }
 
-    if (vmaCreateBuffer(m_allocator, &ibInfo, &ibAllocInfo, &geo.indexBuffer, &geo.indexAlloc, nullptr) != VK_SUCCESS)
+    // Bake translation and the atlas UV remap into the streamed vertices so
+    // every geometry in a batch can share one push-constant block. UVs are
+    // remapped unclamped; the atlas fragment shader clamps them to uvRect, so
+    // tiled decorators interpolate across the quad as they did standalone.
+    const uint32_t baseVertex = (uint32_t)m_batchVertices.size();
+    m_batchVertices.reserve(m_batchVertices.size() + geo.vertices.size());
+    for (const Rml::Vertex& src : geo.vertices)
     {
-        vmaDestroyBuffer(m_allocator, geo.vertexBuffer, geo.vertexAlloc);
-        return 0;
+        BatchVertex v;
+        v.position = src.position + translation;
+        v.colour = src.colour;
+        v.tex_coord.x = uvOffset[0] + src.tex_coord.x * uvScale[0];
+        v.tex_coord.y = uvOffset[1] + src.tex_coord.y * uvScale[1];
+        memcpy(v.uvRect, uvRect, sizeof(uvRect));
+        m_batchVertices.push_back(v);
     }
 
-    vmaMapMemory(m_allocator, geo.indexAlloc, &mapped);
-    memcpy(mapped, indices.data(), ibSize);
-    vmaUnmapMemory(m_allocator, geo.indexAlloc);
+    m_batchIndices.reserve(m_batchIndices.size() + geo.indices.size());
+    for (uint32_t index : geo.indices)
+        m_batchIndices.push_back(baseVertex + index);
 
-    uintptr_t handle = m_nextGeometryHandle++;
-    m_geometries[handle] = geo;
-    return (Rml::CompiledGeometryHandle)handle;
+    m_batches.back().indexCount += (uint32_t)geo.indices.size();
+    m_batchGeometries++;
 }
 
-void RmlRenderer_VK::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+bool RmlRenderer_VK::EnsureStreamCapacity(size_t vertexBytes, size_t indexBytes)
 {
-    auto it = m_geometries.find((uintptr_t)handle);
-    if (it == m_geometries.end() || !m_currentCmdBuffer || m_currentRenderPass == VK_NULL_HANDLE)
+    StreamBuffer& stream = m_streams[m_streamSlot];
+    VmaAllocator alloc = m_allocator;
+
+    auto grow = [&](VkBuffer& buffer, VmaAllocation& allocation, void*& mapped, VkDeviceSize& capacity,
+                    VkDeviceSize& cursor, VkDeviceSize required, VkBufferUsageFlags usage) -> bool
+    {
+        if (cursor + required <= capacity)
+            return true;
+
+        // Earlier flushes this frame still reference the old buffer, so it
+        // is retired through the deletion queue and the new one starts empty.
+        if (buffer)
+        {
+            VkBuffer oldBuffer = buffer;
+            VmaAllocation oldAlloc = allocation;
+            m_renderAPI->getDeletionQueue().push([alloc, oldBuffer, oldAlloc]() {
+                vmaDestroyBuffer(alloc, oldBuffer, oldAlloc);
+            });
+        }
+
+        VkDeviceSize newCapacity = std::max<VkDeviceSize>(capacity * 2, 64 * 1024);
+        while (newCapacity < required)
+            newCapacity *= 2;
+
+        VkBufferCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = newCapacity;
+        info.usage = usage;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo result = {};
+        buffer = VK_NULL_HANDLE;
+        allocation = nullptr;
+        mapped = nullptr;
+        capacity = 0;
+        cursor = 0;
+        if (vmaCreateBuffer(m_allocator, &info, &allocInfo, &buffer, &allocation, &result) != VK_SUCCESS)
+        {
+            buffer = VK_NULL_HANDLE;
+            allocation = nullptr;
+            return false;
+        }
+        mapped = result.pMappedData;
+        capacity = newCapacity;
+        return true;
+    };
+
+    return grow(stream.vertexBuffer, stream.vertexAlloc, stream.vertexMapped, stream.vertexCapacity,
+                stream.vertexCursor, vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) &&
+           grow(stream.indexBuffer, stream.indexAlloc, stream.indexMapped, stream.indexCapacity,
+                stream.indexCursor, indexBytes, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+}
+
+void RmlRenderer_VK::EndFrame()
+{
+    const auto recordStart = std::chrono::steady_clock::now();
+
+    m_stats = FrameStats{};
+    m_stats.geometries = m_batchGeometries;
+    m_stats.vertices = (uint32_t)m_batchVertices.size();
+    m_stats.indices = (uint32_t)m_batchIndices.size();
+    m_stats.atlasPages = (uint32_t)m_atlasPages.size();
+    for (const auto& [id, tex] : m_textures)
+    {
+        (void)id;
+        if (tex.atlasPage >= 0)
+            m_stats.atlasTextures++;
+        else
+            m_stats.standaloneTextures++;
+    }
+
+    if (m_batches.empty() || !m_currentCmdBuffer || m_currentRenderPass == VK_NULL_HANDLE)
         return;
 
-    const auto& geo = it->second;
     auto pipeline_it = m_pipelines.find(m_currentRenderPass);
     if (pipeline_it == m_pipelines.end())
     {
@@ -475,116 +676,142 @@ void RmlRenderer_VK::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vec
     }
     const PipelineSet& pipelines = pipeline_it->second;
 
-    // Build UBO data
-    RmlUBO ubo = {};
+    const size_t vertexBytes = m_batchVertices.size() * sizeof(BatchVertex);
+    const size_t indexBytes = m_batchIndices.size() * sizeof(uint32_t);
+    if (!EnsureStreamCapacity(vertexBytes, indexBytes))
+    {
+        LOG_ENGINE_ERROR("Failed to allocate RmlUi stream buffers ({} vertex bytes, {} index bytes)", vertexBytes, indexBytes);
+        return;
+    }
+
+    StreamBuffer& stream = m_streams[m_streamSlot];
+    const VkDeviceSize vertexOffset = stream.vertexCursor;
+    const VkDeviceSize indexOffset = stream.indexCursor;
+    memcpy((char*)stream.vertexMapped + vertexOffset, m_batchVertices.data(), vertexBytes);
+    memcpy((char*)stream.indexMapped + indexOffset, m_batchIndices.data(), indexBytes);
+    vmaFlushAllocation(m_allocator, stream.vertexAlloc, vertexOffset, vertexBytes);
+    vmaFlushAllocation(m_allocator, stream.indexAlloc, indexOffset, indexBytes);
+    // uint32 indices keep indexCursor 4-byte aligned as vkCmdBindIndexBuffer requires.
+    stream.vertexCursor += vertexBytes;
+    stream.indexCursor += indexBytes;
+
+    VkCommandBuffer cmd = m_currentCmdBuffer;
+
+    VkViewport viewport = {};
+    viewport.width = (float)m_viewportWidth;
+    viewport.height = (float)m_viewportHeight;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+    vkCmdBindVertexBuffers(cmd, 0, 1, &stream.vertexBuffer, &vertexOffset);
+    vkCmdBindIndexBuffer(cmd, stream.indexBuffer, indexOffset, VK_INDEX_TYPE_UINT32);
 
     // Orthographic projection (top-left origin, Vulkan clip space).
     // The shader is compiled with slangc's command-line default column-major
     // layout, matching the D3D12 Rml backend's CPU matrix convention.
     float L = 0.0f, R = (float)m_viewportWidth;
     float T = 0.0f, B = (float)m_viewportHeight;
-    float ortho[16] = {
+    const float ortho[16] = {
         2.0f / (R - L),    0.0f,              0.0f, 0.0f,
         0.0f,              2.0f / (B - T),    0.0f, 0.0f,
         0.0f,              0.0f,              1.0f, 0.0f,
         (L + R) / (L - R), (T + B) / (T - B), 0.0f, 1.0f
     };
 
-    if (m_transformEnabled)
-    {
-        // RmlUi's transform matrix uses the same memory convention as the
-        // D3D12 backend. Keep the multiply/indexing aligned so CSS transforms
-        // such as the HUD crosshair do not explode into clipped fullscreen tris.
-        const float* a = ortho;
-        const float* b = m_transform.data();
-        for (int i = 0; i < 4; i++)
-            for (int j = 0; j < 4; j++)
-            {
-                ubo.transform[j * 4 + i] = 0.0f;
-                for (int k = 0; k < 4; k++)
-                    ubo.transform[j * 4 + i] += a[k * 4 + i] * b[j * 4 + k];
-            }
-    }
-    else
-    {
-        memcpy(ubo.transform, ortho, sizeof(ortho));
-    }
-
-    ubo.translation[0] = translation.x;
-    ubo.translation[1] = translation.y;
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkDescriptorSet boundSet = VK_NULL_HANDLE;
+    int pushedTransform = -2;
+    bool scissorValid = false;
+    bool boundScissorEnabled = false;
+    Rml::Rectanglei boundScissor;
 
-    // Set viewport
-    VkViewport viewport = {};
-    viewport.x = 0;
-    viewport.y = 0;
-    viewport.width = (float)m_viewportWidth;
-    viewport.height = (float)m_viewportHeight;
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(m_currentCmdBuffer, 0, 1, &viewport);
-
-    // Set scissor
-    VkRect2D scissor = {};
-    if (!m_scissorEnabled)
+    for (const DrawBatch& batch : m_batches)
     {
-        scissor.offset = { 0, 0 };
-        scissor.extent = { (uint32_t)m_viewportWidth, (uint32_t)m_viewportHeight };
-    }
-    // If scissor is enabled, the scissor rect was already set by SetScissorRegion
-
-    if (!m_scissorEnabled)
-        vkCmdSetScissor(m_currentCmdBuffer, 0, 1, &scissor);
+        VkPipeline pipeline = batch.textured ? pipelines.textured : pipelines.color;
+        if (pipeline != boundPipeline)
+        {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            boundPipeline = pipeline;
+        }
 
-    // Bind pipeline
-    if (texture)
-        vkCmdBindPipeline(m_currentCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.textured);
-    else
-        vkCmdBindPipeline(m_currentCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.color);
+        if (batch.descriptorSet != boundSet)
+        {
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                m_pipelineLayout, 0, 1, &batch.descriptorSet, 0, nullptr);
+            boundSet = batch.descriptorSet;
+        }
 
-    // Upload UBO via push constants (per-draw, recorded inline in command buffer)
-    vkCmdPushConstants(m_currentCmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(RmlUBO), &ubo);
+        if (batch.transformIndex != pushedTransform)
+        {
+            RmlUBO ubo = {};
+            if (batch.transformIndex >= 0)
+            {
+                // RmlUi's transform matrix uses the same memory convention as the
+                // D3D12 backend. Keep the multiply/indexing aligned so CSS transforms
+                // such as the HUD crosshair do not explode into clipped fullscreen tris.
+                const float* a = ortho;
+                const float* b = m_batchTransforms[batch.transformIndex].data();
+                for (int i = 0; i < 4; i++)
+                    for (int j = 0; j < 4; j++)
+                    {
+                        ubo.transform[j * 4 + i] = 0.0f;
+                        for (int k = 0; k < 4; k++)
+                            ubo.transform[j * 4 + i] += a[k * 4 + i] * b[j * 4 + k];
+                    }
+            }
+            else
+            {
+                memcpy(ubo.transform, ortho, sizeof(ortho));
+            }
+            // Translation is baked into the streamed vertices.
+            vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(RmlUBO), &ubo);
+            pushedTransform = batch.transformIndex;
+        }
 
-    // Bind descriptor set (set 0 with texture binding 0 + UBO binding 1)
-    if (texture)
-    {
-        auto tex_it = m_textures.find((uintptr_t)texture);
-        if (tex_it != m_textures.end())
+        if (!scissorValid || batch.scissorEnabled != boundScissorEnabled ||
+            (batch.scissorEnabled && batch.scissor != boundScissor))
         {
-            vkCmdBindDescriptorSets(m_currentCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                m_pipelineLayout, 0, 1, &tex_it->second.descriptorSet, 0, nullptr);
+            VkRect2D scissor = {};
+            if (batch.scissorEnabled)
+            {
+                scissor.offset.x = batch.scissor.Left();
+                scissor.offset.y = batch.scissor.Top();
+                scissor.extent.width = (uint32_t)std::max(batch.scissor.Width(), 0);
+                scissor.extent.height = (uint32_t)std::max(batch.scissor.Height(), 0);
+            }
+            else
+            {
+                scissor.extent = { (uint32_t)m_viewportWidth, (uint32_t)m_viewportHeight };
+            }
+            vkCmdSetScissor(cmd, 0, 1, &scissor);
+            scissorValid = true;
+            boundScissorEnabled = batch.scissorEnabled;
+            boundScissor = batch.scissor;
         }
-    }
-    else
-    {
-        // Color-only: bind descriptor set with dummy texture + UBO
-        vkCmdBindDescriptorSets(m_currentCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            m_pipelineLayout, 0, 1, &m_colorOnlyDescriptorSet, 0, nullptr);
+
+        vkCmdDrawIndexed(cmd, batch.indexCount, 1, batch.firstIndex, 0, 0);
+        m_stats.drawCalls++;
     }
 
-    // Bind geometry
-    VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(m_currentCmdBuffer, 0, 1, &geo.vertexBuffer, &offset);
-    vkCmdBindIndexBuffer(m_currentCmdBuffer, geo.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    m_batches.clear();
+    m_batchVertices.clear();
+    m_batchIndices.clear();
+    m_batchGeometries = 0;
 
-    // Draw
-    vkCmdDrawIndexed(m_currentCmdBuffer, geo.numIndices, 1, 0, 0, 0);
+    m_stats.recordMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+    if (CVAR_BOOL(r_ui_stats))
+    {
+        LOG_ENGINE_INFO("[RmlUi] geometries={} draws={} vertices={} indices={} atlas_pages={} atlas_textures={} textures={} record={:.3f}ms",
+            m_stats.geometries, m_stats.drawCalls, m_stats.vertices, m_stats.indices,
+            m_stats.atlasPages, m_stats.atlasTextures, m_stats.standaloneTextures, m_stats.recordMs);
+    }
 }
 
 void RmlRenderer_VK::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
-    auto it = m_geometries.find((uintptr_t)handle);
-    if (it == m_geometries.end())
-        return;
-
-    // Defer destruction until GPU is done with these buffers
-    auto geo = it->second;
-    m_geometries.erase(it);
-
-    VmaAllocator alloc = m_allocator;
-    m_renderAPI->getDeletionQueue().push([alloc, geo]() {
-        vmaDestroyBuffer(alloc, geo.vertexBuffer, geo.vertexAlloc);
-        vmaDestroyBuffer(alloc, geo.indexBuffer, geo.indexAlloc);
-    });
+    // Geometry is CPU-side only; anything already streamed this frame was copied.
+    m_geometries.erase((uintptr_t)handle);
 }
 
 Rml::TextureHandle RmlRenderer_VK::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
@@ -612,10 +839,74 @@ Rml::TextureHandle RmlRenderer_VK::LoadTexture(Rml::Vector2i& texture_dimensions
     return handle;
 }
 
-Rml::TextureHandle RmlRenderer_VK::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+bool RmlRenderer_VK::CreateImage(uint32_t width, uint32_t height, VkImage& image, VmaAllocation& allocation, VkImageView& view)
 {
-    TextureData tex = {};
-    VkDeviceSize imageSize = source_dimensions.x * source_dimensions.y * 4;
+    VkImageCreateInfo imgInfo = {};
+    imgInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imgInfo.imageType = VK_IMAGE_TYPE_2D;
+    imgInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imgInfo.extent = { width, height, 1 };
+    imgInfo.mipLevels = 1;
+    imgInfo.arrayLayers = 1;
+    imgInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imgInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imgInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VmaAllocationCreateInfo imgAllocInfo = {};
+    imgAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+    if (vmaCreateImage(m_allocator, &imgInfo, &imgAllocInfo, &image, &allocation, nullptr) != VK_SUCCESS)
+        return false;
+
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    if (vkCreateImageView(m_device, &viewInfo, nullptr, &view) != VK_SUCCESS)
+    {
+        vmaDestroyImage(m_allocator, image, allocation);
+        image = VK_NULL_HANDLE;
+        allocation = nullptr;
+        return false;
+    }
+    return true;
+}
+
+VkDescriptorSet RmlRenderer_VK::AllocateTextureDescriptor(VkImageView view)
+{
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo dsAlloc = {};
+    dsAlloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    dsAlloc.descriptorPool = m_descriptorPool;
+    dsAlloc.descriptorSetCount = 1;
+    dsAlloc.pSetLayouts = &m_textureSetLayout;
+    if (vkAllocateDescriptorSets(m_device, &dsAlloc, &set) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+
+    // Update descriptor set: binding 0 = texture (UBO removed, now via push constants)
+    VkDescriptorImageInfo descImage = {};
+    descImage.sampler = m_sampler;
+    descImage.imageView = view;
+    descImage.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &descImage;
+
+    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+    return set;
+}
+
+bool RmlRenderer_VK::UploadImageRegion(VkImage image, bool firstUpload, int x, int y, int width, int height, const Rml::byte* rgba)
+{
+    const VkDeviceSize imageSize = (VkDeviceSize)width * height * 4;
 
     // Create staging buffer
     VkBufferCreateInfo stagingInfo = {};
@@ -630,35 +921,13 @@ Rml::TextureHandle RmlRenderer_VK::GenerateTexture(Rml::Span<const Rml::byte> so
     VkBuffer stagingBuffer;
     VmaAllocation stagingAlloc;
     if (vmaCreateBuffer(m_allocator, &stagingInfo, &stagingAllocInfo, &stagingBuffer, &stagingAlloc, nullptr) != VK_SUCCESS)
-        return 0;
+        return false;
 
     void* mapped;
     vmaMapMemory(m_allocator, stagingAlloc, &mapped);
-    memcpy(mapped, source_data.data(), imageSize);
+    memcpy(mapped, rgba, imageSize);
     vmaUnmapMemory(m_allocator, stagingAlloc);
 
-    // Create image
-    VkImageCreateInfo imgInfo = {};
-    imgInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imgInfo.imageType = VK_IMAGE_TYPE_2D;
-    imgInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    imgInfo.extent = { (uint32_t)source_dimensions.x, (uint32_t)source_dimensions.y, 1 };
-    imgInfo.mipLevels = 1;
-    imgInfo.arrayLayers = 1;
-    imgInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imgInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imgInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-    VmaAllocationCreateInfo imgAllocInfo = {};
-    imgAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-
-    if (vmaCreateImage(m_allocator, &imgInfo, &imgAllocInfo, &tex.image, &tex.allocation, nullptr) != VK_SUCCESS)
-    {
-        vmaDestroyBuffer(m_allocator, stagingBuffer, stagingAlloc);
-        return 0;
-    }
-
     // Transition + copy using a one-shot command buffer
     VkCommandPool cmdPool = m_renderAPI->getCommandPool();
     VkQueue queue = m_renderAPI->getGraphicsQueue();
@@ -677,25 +946,28 @@ Rml::TextureHandle RmlRenderer_VK::GenerateTexture(Rml::Span<const Rml::byte> so
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(cmd, &beginInfo);
 
-    // Transition to TRANSFER_DST
+    // Transition to TRANSFER_DST. Atlas pages are already sampled by earlier
+    // submissions, so wait on their fragment reads and keep the contents.
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.oldLayout = firstUpload ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = tex.image;
+    barrier.image = image;
     barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-    barrier.srcAccessMask = 0;
+    barrier.srcAccessMask = firstUpload ? 0 : VK_ACCESS_SHADER_READ_BIT;
     barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-        0, 0, nullptr, 0, nullptr, 1, &barrier);
+    vkCmdPipelineBarrier(cmd,
+        firstUpload ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 
     // Copy buffer to image
     VkBufferImageCopy region = {};
     region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
-    region.imageExtent = { (uint32_t)source_dimensions.x, (uint32_t)source_dimensions.y, 1 };
-    vkCmdCopyBufferToImage(cmd, stagingBuffer, tex.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    region.imageOffset = { x, y, 0 };
+    region.imageExtent = { (uint32_t)width, (uint32_t)height, 1 };
+    vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
     // Transition to SHADER_READ
     barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
@@ -725,48 +997,146 @@ Rml::TextureHandle RmlRenderer_VK::GenerateTexture(Rml::Span<const Rml::byte> so
 
     vkFreeCommandBuffers(m_device, cmdPool, 1, &cmd);
     vmaDestroyBuffer(m_allocator, stagingBuffer, stagingAlloc);
+    return true;
+}
 
-    // Create image view
-    VkImageViewCreateInfo viewInfo = {};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = tex.image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-    if (vkCreateImageView(m_device, &viewInfo, nullptr, &tex.imageView) != VK_SUCCESS)
+int RmlRenderer_VK::CreateAtlasPage()
+{
+    AtlasPage page;
+    if (!CreateImage(kAtlasPageSize, kAtlasPageSize, page.image, page.allocation, page.imageView))
+        return -1;
+
+    page.descriptorSet = AllocateTextureDescriptor(page.imageView);
+    if (!page.descriptorSet)
     {
-        vmaDestroyImage(m_allocator, tex.image, tex.allocation);
+        vkDestroyImageView(m_device, page.imageView, nullptr);
+        vmaDestroyImage(m_allocator, page.image, page.allocation);
+        return -1;
+    }
+
+    // Reserve a white block in the corner for untextured geometry
+    std::vector<Rml::byte> white(kAtlasWhiteBlockSize * kAtlasWhiteBlockSize * 4, 255);
+    if (!UploadImageRegion(page.image, true, 0, 0, kAtlasWhiteBlockSize, kAtlasWhiteBlockSize, white.data()))
+    {
+        vkFreeDescriptorSets(m_device, m_descriptorPool, 1, &page.descriptorSet);
+        vkDestroyImageView(m_device, page.imageView, nullptr);
+        vmaDestroyImage(m_allocator, page.image, page.allocation);
+        return -1;
+    }
+    page.cursorX = kAtlasWhiteBlockSize;
+    page.shelfHeight = kAtlasWhiteBlockSize;
+
+    m_atlasPages.push_back(page);
+    return (int)m_atlasPages.size() - 1;
+}
+
+int RmlRenderer_VK::AllocateAtlasRegion(int width, int height, int& outX, int& outY)
+{
+    // Shelf packing: fill rows left to right, open a new shelf when the
+    // current one is full. Pages are only repacked once every entry is gone.
+    auto tryPlace = [&](AtlasPage& page) -> bool
+    {
+        if (page.cursorX + width <= kAtlasPageSize && height <= page.shelfHeight)
+        {
+            // Fits on the open shelf
+        }
+        else if (page.cursorX == 0 && width <= kAtlasPageSize && page.shelfY + height <= kAtlasPageSize)
+        {
+            page.shelfHeight = height;
+        }
+        else if (width <= kAtlasPageSize && page.shelfY + page.shelfHeight + height <= kAtlasPageSize)
+        {
+            page.shelfY += page.shelfHeight;
+            page.shelfHeight = height;
+            page.cursorX = 0;
+        }
+        else
+        {
+            return false;
+        }
+
+        outX = page.cursorX;
+        outY = page.shelfY;
+        page.cursorX += width;
+        return true;
+    };
+
+    for (int pageIndex = 0; pageIndex < (int)m_atlasPages.size(); pageIndex++)
+    {
+        if (tryPlace(m_atlasPages[pageIndex]))
+            return pageIndex;
+    }
+
+    const int pageIndex = CreateAtlasPage();
+    if (pageIndex < 0 || !tryPlace(m_atlasPages[pageIndex]))
+        return -1;
+    return pageIndex;
+}
+
+Rml::TextureHandle RmlRenderer_VK::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+    if (source_dimensions.x <= 0 || source_dimensions.y <= 0)
         return 0;
+
+    TextureData tex = {};
+
+    if (CVAR_BOOL(r_ui_atlas) && m_atlasShaders &&
+        source_dimensions.x <= kAtlasMaxEntrySize && source_dimensions.y <= kAtlasMaxEntrySize)
+    {
+        // Pad by one texel on each side, replicating the edge, so bilinear
+        // filtering never pulls in a neighbouring entry.
+        const int w = source_dimensions.x;
+        const int h = source_dimensions.y;
+        const int paddedW = w + 2;
+        const int paddedH = h + 2;
+        std::vector<Rml::byte> padded((size_t)paddedW * paddedH * 4);
+        for (int py = 0; py < paddedH; py++)
+        {
+            const int sy = std::clamp(py - 1, 0, h - 1);
+            for (int px = 0; px < paddedW; px++)
+            {
+                const int sx = std::clamp(px - 1, 0, w - 1);
+                memcpy(&padded[((size_t)py * paddedW + px) * 4], &source_data[((size_t)sy * w + sx) * 4], 4);
+            }
+        }
+
+        int x = 0, y = 0;
+        const int pageIndex = AllocateAtlasRegion(paddedW, paddedH, x, y);
+        if (pageIndex >= 0 && UploadImageRegion(m_atlasPages[pageIndex].image, false, x, y, paddedW, paddedH, padded.data()))
+        {
+            AtlasPage& page = m_atlasPages[pageIndex];
+            page.liveEntries++;
+            tex.atlasPage = pageIndex;
+            tex.descriptorSet = page.descriptorSet;
+            tex.uvOffset[0] = (float)(x + 1) / (float)kAtlasPageSize;
+            tex.uvOffset[1] = (float)(y + 1) / (float)kAtlasPageSize;
+            tex.uvScale[0] = (float)w / (float)kAtlasPageSize;
+            tex.uvScale[1] = (float)h / (float)kAtlasPageSize;
+
+            uintptr_t handle = m_nextTextureHandle++;
+            m_textures[handle] = tex;
+            return (Rml::TextureHandle)handle;
+        }
+        // Fall through to a dedicated image if the atlas is unavailable
     }
 
-    // Allocate descriptor set
-    VkDescriptorSetAllocateInfo dsAlloc = {};
-    dsAlloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    dsAlloc.descriptorPool = m_descriptorPool;
-    dsAlloc.descriptorSetCount = 1;
-    dsAlloc.pSetLayouts = &m_textureSetLayout;
-    if (vkAllocateDescriptorSets(m_device, &dsAlloc, &tex.descriptorSet) != VK_SUCCESS)
+    if (!CreateImage((uint32_t)source_dimensions.x, (uint32_t)source_dimensions.y, tex.image, tex.allocation, tex.imageView))
+        return 0;
+
+    if (!UploadImageRegion(tex.image, true, 0, 0, source_dimensions.x, source_dimensions.y, source_data.data()))
     {
         vkDestroyImageView(m_device, tex.imageView, nullptr);
         vmaDestroyImage(m_allocator, tex.image, tex.allocation);
         return 0;
     }
 
-    // Update descriptor set: binding 0 = texture (UBO removed, now via push constants)
-    VkDescriptorImageInfo descImage = {};
-    descImage.sampler = m_sampler;
-    descImage.imageView = tex.imageView;
-    descImage.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.dstSet = tex.descriptorSet;
-    write.dstBinding = 0;
-    write.descriptorCount = 1;
-    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    write.pImageInfo = &descImage;
-
-    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+    tex.descriptorSet = AllocateTextureDescriptor(tex.imageView);
+    if (!tex.descriptorSet)
+    {
+        vkDestroyImageView(m_device, tex.imageView, nullptr);
+        vmaDestroyImage(m_allocator, tex.image, tex.allocation);
+        return 0;
+    }
 
     uintptr_t handle = m_nextTextureHandle++;
     m_textures[handle] = tex;
@@ -779,10 +1149,24 @@ void RmlRenderer_VK::ReleaseTexture(Rml::TextureHandle texture)
     if (it == m_textures.end())
         return;
 
-    // Defer destruction until GPU is done with these resources
     auto tex = it->second;
     m_textures.erase(it);
 
+    if (tex.atlasPage >= 0)
+    {
+        // Once a page is empty its space can be repacked. Later uploads wait
+        // on earlier fragment reads, so in-flight frames never see new texels.
+        AtlasPage& page = m_atlasPages[tex.atlasPage];
+        if (--page.liveEntries == 0)
+        {
+            page.shelfY = 0;
+            page.shelfHeight = kAtlasWhiteBlockSize;
+            page.cursorX = kAtlasWhiteBlockSize;
+        }
+        return;
+    }
+
+    // Defer destruction until GPU is done with these resources
     VkDevice dev = m_device;
     VmaAllocator alloc = m_allocator;
     VkDescriptorPool pool = m_descriptorPool;
@@ -801,26 +1185,19 @@ void RmlRenderer_VK::EnableScissorRegion(bool enable)
 
 void RmlRenderer_VK::SetScissorRegion(Rml::Rectanglei region)
 {
-    if (!m_currentCmdBuffer)
-        return;
-
-    VkRect2D scissor = {};
-    scissor.offset.x = region.Left();
-    scissor.offset.y = region.Top();
-    scissor.extent.width = region.Width();
-    scissor.extent.height = region.Height();
-    vkCmdSetScissor(m_currentCmdBuffer, 0, 1, &scissor);
+    // Applied per batch in EndFrame(); a change simply starts a new batch.
+    m_scissorRegion = region;
 }
 
 void RmlRenderer_VK::SetTransform(const Rml::Matrix4f* transform)
 {
     if (transform)
     {
-        m_transformEnabled = true;
-        m_transform = *transform;
+        m_batchTransforms.push_back(*transform);
+        m_transformIndex = (int)m_batchTransforms.size() - 1;
     }
     else
     {
-        m_transformEnabled = false;
+        m_transformIndex = -1;
     }
 }
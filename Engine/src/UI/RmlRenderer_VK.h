@@ -2,6 +2,7 @@
 
 #include <RmlUi/Core/RenderInterface.h>
 #include <vulkan/vulkan.h>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -26,6 +27,24 @@ public:
     // Called each frame to sync with current command buffer
     void BeginFrame();
 
+    // Uploads the geometry queued since BeginFrame() and records one draw per
+    // batch. Must be called inside the same render pass, after Context::Render().
+    void EndFrame();
+
+    // Counters for the most recent EndFrame(), used by r_ui_stats and the
+    // lavapipe UI benchmark to catch draw-count and CPU-time regressions.
+    struct FrameStats {
+        uint32_t geometries = 0;
+        uint32_t drawCalls = 0;
+        uint32_t vertices = 0;
+        uint32_t indices = 0;
+        uint32_t atlasPages = 0;
+        uint32_t atlasTextures = 0;
+        uint32_t standaloneTextures = 0;
+        float recordMs = 0.0f;
+    };
+    const FrameStats& GetFrameStats() const { return m_stats; }
+
     // -- Rml::RenderInterface --
     Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
     void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
@@ -47,6 +66,13 @@ private:
     std::vector<char> ReadShaderFile(const std::string& path);
     VkShaderModule CreateShaderModule(const std::vector<char>& code);
 
+    bool CreateImage(uint32_t width, uint32_t height, VkImage& image, VmaAllocation& allocation, VkImageView& view);
+    VkDescriptorSet AllocateTextureDescriptor(VkImageView view);
+    bool UploadImageRegion(VkImage image, bool firstUpload, int x, int y, int width, int height, const Rml::byte* rgba);
+    bool EnsureStreamCapacity(size_t vertexBytes, size_t indexBytes);
+    int AllocateAtlasRegion(int width, int height, int& outX, int& outY);
+    int CreateAtlasPage();
+
     VulkanRenderAPI* m_renderAPI = nullptr;
     VkDevice m_device = VK_NULL_HANDLE;
     VmaAllocator m_allocator = nullptr;
@@ -79,33 +105,100 @@ private:
     VmaAllocation m_dummyAllocation = nullptr;
     VkImageView m_dummyImageView = VK_NULL_HANDLE;
 
-    // Geometry storage
+    // Geometry storage. Compiled geometry stays on the CPU; RenderGeometry()
+    // appends it (pre-translated) into a per-frame stream so consecutive
+    // geometries with the same texture, scissor and transform share one draw.
     struct GeometryData {
-        VkBuffer vertexBuffer;
-        VmaAllocation vertexAlloc;
-        VkBuffer indexBuffer;
-        VmaAllocation indexAlloc;
-        int numIndices;
+        std::vector<Rml::Vertex> vertices;
+        std::vector<uint32_t> indices;
     };
     uintptr_t m_nextGeometryHandle = 1;
     std::unordered_map<uintptr_t, GeometryData> m_geometries;
 
-    // Texture storage
+    // Texture storage. Small textures (icons, glyph pages) live in a shared
+    // atlas page and only remap UVs; large ones keep a dedicated image.
     struct TextureData {
-        VkImage image;
-        VmaAllocation allocation;
-        VkImageView imageView;
-        VkDescriptorSet descriptorSet;
+        VkImage image = VK_NULL_HANDLE;
+        VmaAllocation allocation = nullptr;
+        VkImageView imageView = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        int atlasPage = -1;
+        float uvOffset[2] = { 0.0f, 0.0f };
+        float uvScale[2] = { 1.0f, 1.0f };
     };
     uintptr_t m_nextTextureHandle = 1;
     std::unordered_map<uintptr_t, TextureData> m_textures;
 
+    static constexpr int kAtlasPageSize = 1024;
+    static constexpr int kAtlasMaxEntrySize = 256;
+    static constexpr int kAtlasWhiteBlockSize = 4;
+    struct AtlasPage {
+        VkImage image = VK_NULL_HANDLE;
+        VmaAllocation allocation = nullptr;
+        VkImageView imageView = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        int shelfY = 0;
+        int shelfHeight = 0;
+        int cursorX = 0;
+        int liveEntries = 0;
+    };
+    std::vector<AtlasPage> m_atlasPages;
+    // rmlui_atlas shaders found at Init(); without them nothing is atlased
+    bool m_atlasShaders = false;
+
+    // Per-frame batch queue, flushed by EndFrame()
+    struct DrawBatch {
+        VkDescriptorSet descriptorSet;
+        bool textured;
+        bool scissorEnabled;
+        Rml::Rectanglei scissor;
+        int transformIndex;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+    };
+    // Streamed vertex: Rml::Vertex plus the UV rect the atlas fragment shader
+    // clamps to, so tiled UVs stop at the entry edge like CLAMP_TO_EDGE would.
+    struct BatchVertex {
+        Rml::Vector2f position;
+        Rml::ColourbPremultiplied colour;
+        Rml::Vector2f tex_coord;
+        float uvRect[4];    // min u, min v, max u, max v
+    };
+    std::vector<BatchVertex> m_batchVertices;
+    std::vector<uint32_t> m_batchIndices;
+    std::vector<DrawBatch> m_batches;
+    std::vector<Rml::Matrix4f> m_batchTransforms;
+    uint32_t m_batchGeometries = 0;
+    bool m_batchingEnabled = true;
+
+    // Host-visible stream buffers, one pair per frame in flight. A frame can
+    // flush more than once (game HUD + editor shell), so the write cursor is
+    // only rewound when the render API starts a new frame.
+    static constexpr uint32_t kStreamSlots = 2;
+    struct StreamBuffer {
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VmaAllocation vertexAlloc = nullptr;
+        void* vertexMapped = nullptr;
+        VkDeviceSize vertexCapacity = 0;
+        VkDeviceSize vertexCursor = 0;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        VmaAllocation indexAlloc = nullptr;
+        void* indexMapped = nullptr;
+        VkDeviceSize indexCapacity = 0;
+        VkDeviceSize indexCursor = 0;
+        uint64_t frameSerial = UINT64_MAX;
+    };
+    StreamBuffer m_streams[kStreamSlots];
+    uint32_t m_streamSlot = 0;
+
+    FrameStats m_stats;
+
     // State
     int m_viewportWidth = 0;
     int m_viewportHeight = 0;
     bool m_scissorEnabled = false;
-    bool m_transformEnabled = false;
-    Rml::Matrix4f m_transform;
+    Rml::Rectanglei m_scissorRegion;
+    int m_transformIndex = -1;
 
     VkCommandBuffer m_currentCmdBuffer = VK_NULL_HANDLE;
     VkRenderPass m_currentRenderPass = VK_NULL_HANDLE;
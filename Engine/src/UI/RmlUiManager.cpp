@@ -27,6 +27,8 @@ static volatile auto s_force_rml_family = &Rml::Family<int>::Id;
 #include "Graphics/VulkanRenderAPI.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <string>
 #include <unordered_map>
@@ -34,14 +36,38 @@ static volatile auto s_force_rml_family = &Rml::Family<int>::Id;
 
 namespace
 {
+    enum class DataVariableType : uint8_t
+    {
+        Int,
+        Bool,
+        String,
+        Float,   // Stored as text in strings, see dataModelBindFloat
+    };
+
+    struct RmlUiDataVariable
+    {
+        DataVariableType type = DataVariableType::Int;
+        Rml::String name;
+        int* int_value = nullptr;
+        bool* bool_value = nullptr;
+        Rml::String* string_value = nullptr;
+        int decimals = 0;
+        long long quantized = 0;   // Float: the displayed value times 10^decimals
+        float scale = 1.0f;
+    };
+
     struct RmlUiDataModel
     {
         std::string name;
         Rml::DataModelConstructor constructor;
         Rml::DataModelHandle handle;
+        // Node-based maps keep the bound addresses stable
         std::unordered_map<std::string, int> ints;
         std::unordered_map<std::string, bool> bools;
         std::unordered_map<std::string, Rml::String> strings;
+        // Handle N refers to variables[N - 1]
+        std::vector<RmlUiDataVariable> variables;
+        std::unordered_map<std::string, RmlUiManager::DataVariable> lookup;
     };
 
     RmlUiDataModel* asDataModel(void* model)
@@ -49,6 +75,50 @@ namespace
         return static_cast<RmlUiDataModel*>(model);
     }
 
+    RmlUiManager::DataVariable addVariable(RmlUiDataModel* model, RmlUiDataVariable variable)
+    {
+        model->variables.push_back(std::move(variable));
+        const auto handle = static_cast<RmlUiManager::DataVariable>(model->variables.size());
+        model->lookup.emplace(model->variables.back().name, handle);
+        return handle;
+    }
+
+    RmlUiDataVariable* findVariable(RmlUiDataModel* model, RmlUiManager::DataVariable handle, DataVariableType type)
+    {
+        if (!model || handle == 0 || handle > model->variables.size())
+            return nullptr;
+
+        RmlUiDataVariable& variable = model->variables[handle - 1];
+        return variable.type == type ? &variable : nullptr;
+    }
+
+    long long quantize(const RmlUiDataVariable& variable, float value)
+    {
+        return std::llround(static_cast<double>(value) * variable.scale);
+    }
+
+    void formatFloat(RmlUiDataVariable& variable, float value)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.*f", variable.decimals, value);
+        *variable.string_value = buffer;
+        variable.quantized = quantize(variable, value);
+    }
+
+    // Null backend for initializeHeadless: geometry and textures are accepted and dropped
+    class NullRenderInterface final : public Rml::RenderInterface
+    {
+    public:
+        Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex>, Rml::Span<const int>) override { return 1; }
+        void RenderGeometry(Rml::CompiledGeometryHandle, Rml::Vector2f, Rml::TextureHandle) override {}
+        void ReleaseGeometry(Rml::CompiledGeometryHandle) override {}
+        Rml::TextureHandle LoadTexture(Rml::Vector2i&, const Rml::String&) override { return 0; }
+        Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte>, Rml::Vector2i) override { return 1; }
+        void ReleaseTexture(Rml::TextureHandle) override {}
+        void EnableScissorRegion(bool) override {}
+        void SetScissorRegion(Rml::Rectanglei) override {}
+    };
+
     bool isValidName(const char* name)
     {
         return name && name[0] != '\0';
@@ -350,6 +420,43 @@ bool RmlUiManager::initialize(SDL_Window* window, IRenderAPI* renderAPI, RenderA
     int w, h;
     SDL_GetWindowSize(window, &w, &h);
 
+    if (!initializeContexts(w, h))
+        return false;
+
+    LOG_ENGINE_INFO("[RmlUi] Initialized successfully with {} backend", renderAPI->getAPIName());
+    return true;
+}
+
+bool RmlUiManager::initializeHeadless(int width, int height)
+{
+    if (m_initialized)
+        return true;
+
+    m_headless = true;
+    m_renderInterface = new NullRenderInterface();
+    Rml::SetRenderInterface(m_renderInterface);
+
+    if (!Rml::Initialise())
+    {
+        LOG_ENGINE_ERROR("[RmlUi] Failed to initialise RmlUi core");
+        delete m_renderInterface;
+        m_renderInterface = nullptr;
+        m_headless = false;
+        return false;
+    }
+
+    if (!initializeContexts(width, height))
+    {
+        m_headless = false;
+        return false;
+    }
+
+    LOG_ENGINE_INFO("[RmlUi] Initialized headless ({}x{})", width, height);
+    return true;
+}
+
+bool RmlUiManager::initializeContexts(int w, int h)
+{
     // Create main/game context
     m_context = Rml::CreateContext("main", Rml::Vector2i(w, h));
     if (!m_context)
@@ -389,8 +496,9 @@ bool RmlUiManager::initialize(SDL_Window* window, IRenderAPI* renderAPI, RenderA
     // Initialize debugger
     Rml::Debugger::Initialise(m_context);
 
+    m_contextDirty = true;
+    m_updateStats = {};
     m_initialized = true;
-    LOG_ENGINE_INFO("[RmlUi] Initialized successfully with {} backend", renderAPI->getAPIName());
     return true;
 }
 
@@ -522,17 +630,20 @@ void RmlUiManager::shutdown()
 
     if (m_renderInterface)
     {
-        // Shutdown specific renderer
-        if (m_apiType == RenderAPIType::Vulkan)
-            static_cast<RmlRenderer_VK*>(m_renderInterface)->Shutdown();
+        // Shutdown specific renderer; the headless interface holds no GPU resources
+        if (!m_headless)
+        {
+            if (m_apiType == RenderAPIType::Vulkan)
+                static_cast<RmlRenderer_VK*>(m_renderInterface)->Shutdown();
 #ifdef _WIN32
-        else if (m_apiType == RenderAPIType::D3D12)
-            static_cast<RmlRenderer_D3D12*>(m_renderInterface)->Shutdown();
+            else if (m_apiType == RenderAPIType::D3D12)
+                static_cast<RmlRenderer_D3D12*>(m_renderInterface)->Shutdown();
 #endif
 #ifdef __APPLE__
-        else if (m_apiType == RenderAPIType::Metal)
-            static_cast<RmlRenderer_Metal*>(m_renderInterface)->Shutdown();
+            else if (m_apiType == RenderAPIType::Metal)
+                static_cast<RmlRenderer_Metal*>(m_renderInterface)->Shutdown();
 #endif
+        }
         delete m_renderInterface;
         m_renderInterface = nullptr;
     }
@@ -541,6 +652,7 @@ void RmlUiManager::shutdown()
     m_systemInterface = nullptr;
 
     m_initialized = false;
+    m_headless = false;
     LOG_ENGINE_INFO("[RmlUi] Shutdown complete");
 }
 
@@ -559,9 +671,16 @@ void RmlUiManager::beginFrame(int width, int height)
     if (!m_initialized || !m_context || width <= 0 || height <= 0)
         return;
 
-    m_context->SetDimensions(Rml::Vector2i(width, height));
+    if (m_context->GetDimensions() != Rml::Vector2i(width, height))
+    {
+        m_context->SetDimensions(Rml::Vector2i(width, height));
+        m_contextDirty = true;
+    }
 
     // Update renderer viewport
+    if (m_headless)
+        return;
+
     if (m_apiType == RenderAPIType::Vulkan)
     {
         auto* vkRenderer = static_cast<RmlRenderer_VK*>(m_renderInterface);
@@ -591,8 +710,65 @@ void RmlUiManager::render()
     if (!m_initialized || !m_context)
         return;
 
-    m_context->Update();
+    updateContext();
     m_context->Render();
+
+    if (!m_headless && m_apiType == RenderAPIType::Vulkan)
+        static_cast<RmlRenderer_VK*>(m_renderInterface)->EndFrame();
+}
+
+void RmlUiManager::updateContext()
+{
+    // Nothing changed and RmlUi has no animation, transition or timer pending: the
+    // element tree, data views and layout are exactly as the last Update left them
+    const double now = Rml::GetSystemInterface()->GetElapsedTime();
+    if (!m_contextDirty && now - m_lastContextUpdate < m_context->GetNextUpdateDelay())
+    {
+        ++m_updateStats.skipped;
+        return;
+    }
+
+    m_contextDirty = false;
+    m_lastContextUpdate = now;
+    m_context->Update();
+    ++m_updateStats.updates;
+}
+
+RmlUiManager::UpdateStats RmlUiManager::getUpdateStats() const
+{
+    return m_updateStats;
+}
+
+void RmlUiManager::resetUpdateStats()
+{
+    m_updateStats = {};
+}
+
+void RmlUiManager::requestUpdate()
+{
+    m_contextDirty = true;
+}
+
+void RmlUiManager::markDocumentDirty(void* document)
+{
+    if (document && static_cast<Rml::ElementDocument*>(document)->GetContext() == m_context)
+        m_contextDirty = true;
+}
+
+RmlUiManager::RenderStats RmlUiManager::getRenderStats() const
+{
+    RenderStats stats;
+    if (!m_initialized || m_headless || m_apiType != RenderAPIType::Vulkan || !m_renderInterface)
+        return stats;
+
+    const auto& vkStats = static_cast<RmlRenderer_VK*>(m_renderInterface)->GetFrameStats();
+    stats.geometries = vkStats.geometries;
+    stats.draw_calls = vkStats.drawCalls;
+    stats.vertices = vkStats.vertices;
+    stats.atlas_textures = vkStats.atlasTextures;
+    stats.textures = vkStats.atlasTextures + vkStats.standaloneTextures;
+    stats.record_ms = vkStats.recordMs;
+    return stats;
 }
 
 void RmlUiManager::beginEditorFrame(int width, int height)
@@ -602,6 +778,9 @@ void RmlUiManager::beginEditorFrame(int width, int height)
 
     m_editorContext->SetDimensions(Rml::Vector2i(width, height));
 
+    if (m_headless)
+        return;
+
     if (m_apiType == RenderAPIType::Vulkan)
     {
         auto* vkRenderer = static_cast<RmlRenderer_VK*>(m_renderInterface);
@@ -633,6 +812,9 @@ void RmlUiManager::renderEditor()
 
     m_editorContext->Update();
     m_editorContext->Render();
+
+    if (!m_headless && m_apiType == RenderAPIType::Vulkan)
+        static_cast<RmlRenderer_VK*>(m_renderInterface)->EndFrame();
 }
 
 bool RmlUiManager::processEvent(SDL_Event& event)
@@ -640,6 +822,10 @@ bool RmlUiManager::processEvent(SDL_Event& event)
     if (!m_initialized || !m_context)
         return false;
 
+    // Relative mouse motion (mouse look) doesn't move RmlUi's cursor, so it can't change hover
+    if (event.type != SDL_EVENT_MOUSE_MOTION || !m_window || !SDL_GetWindowRelativeMouseMode(m_window))
+        m_contextDirty = true;
+
     return !RmlSDL::InputEventHandler(m_context, m_window, event);
 }
 
@@ -661,6 +847,7 @@ void* RmlUiManager::loadDocument(const char* path)
     {
         doc->Show();
         m_documents.push_back(doc);
+        m_contextDirty = true;
     }
     return doc;
 }
@@ -690,7 +877,10 @@ void RmlUiManager::closeDocument(void* document)
     m_documents.erase(it, m_documents.end());
 
     if (m_context)
+    {
         static_cast<Rml::ElementDocument*>(document)->Close();
+        m_contextDirty = true;
+    }
 }
 
 void RmlUiManager::closeEditorDocument(void* document)
@@ -714,6 +904,7 @@ void RmlUiManager::toggleDebugger()
 
     m_debuggerVisible = !m_debuggerVisible;
     Rml::Debugger::SetVisible(m_debuggerVisible);
+    m_contextDirty = true;
 }
 
 void RmlUiManager::setEditorElementText(void* document, const char* id, const char* text)
@@ -722,7 +913,10 @@ void RmlUiManager::setEditorElementText(void* document, const char* id, const ch
         return;
 
     if (Rml::Element* element = findElementById(document, id))
+    {
         element->SetInnerRML(text ? text : "");
+        markDocumentDirty(document);
+    }
 }
 
 void RmlUiManager::setEditorElementClass(void* document, const char* id, const char* class_name, bool enabled)
@@ -731,7 +925,10 @@ void RmlUiManager::setEditorElementClass(void* document, const char* id, const c
         return;
 
     if (Rml::Element* element = findElementById(document, id))
+    {
         element->SetClass(class_name, enabled);
+        markDocumentDirty(document);
+    }
 }
 
 void RmlUiManager::setEditorElementAttribute(void* document, const char* id, const char* attribute, const char* value)
@@ -740,7 +937,10 @@ void RmlUiManager::setEditorElementAttribute(void* document, const char* id, con
         return;
 
     if (Rml::Element* element = findElementById(document, id))
+    {
         element->SetAttribute(attribute, Rml::String(value ? value : ""));
+        markDocumentDirty(document);
+    }
 }
 
 void RmlUiManager::setEditorElementProperty(void* document, const char* id, const char* property, const char* value)
@@ -749,7 +949,10 @@ void RmlUiManager::setEditorElementProperty(void* document, const char* id, cons
         return;
 
     if (Rml::Element* element = findElementById(document, id))
+    {
         element->SetProperty(property, value ? value : "");
+        markDocumentDirty(document);
+    }
 }
 
 void RmlUiManager::setEditorElementStyleDp(void* document, const char* id, EditorStyleProperty property, int value)
@@ -762,7 +965,10 @@ void RmlUiManager::setEditorElementStyleDp(void* document, const char* id, Edito
         return;
 
     if (Rml::Element* element = findElementById(document, id))
+    {
         element->SetProperty(property_id, Rml::Property(static_cast<float>(value), Rml::Unit::DP));
+        markDocumentDirty(document);
+    }
 }
 
 void RmlUiManager::setDocumentVisible(void* document, bool visible)
@@ -775,6 +981,7 @@ void RmlUiManager::setDocumentVisible(void* document, bool visible)
         element_document->Show();
     else
         element_document->Hide();
+    markDocumentDirty(document);
 }
 
 RmlUiManager::EditorEventHandle RmlUiManager::registerEditorElementEvent(
@@ -910,6 +1117,7 @@ void RmlUiManager::removeDataModel(void* model)
     m_dataModels.erase(it, m_dataModels.end());
 
     deleteDataModel(m_context, asDataModel(model));
+    m_contextDirty = true;
 }
 
 bool RmlUiManager::dataModelBindInt(void* model_handle, const char* name, int value)
@@ -920,16 +1128,19 @@ bool RmlUiManager::dataModelBindInt(void* model_handle, const char* name, int va
 
     auto [it, inserted] = model->ints.emplace(name, value);
     if (!inserted)
-    {
-        it->second = value;
-        return true;
-    }
+        return dataModelSetInt(model_handle, name, value);
 
     if (!model->constructor.Bind(it->first, &it->second))
     {
         model->ints.erase(it);
         return false;
     }
+
+    RmlUiDataVariable variable;
+    variable.type = DataVariableType::Int;
+    variable.name = it->first;
+    variable.int_value = &it->second;
+    addVariable(model, std::move(variable));
     return true;
 }
 
@@ -941,16 +1152,19 @@ bool RmlUiManager::dataModelBindBool(void* model_handle, const char* name, bool
 
     auto [it, inserted] = model->bools.emplace(name, value);
     if (!inserted)
-    {
-        it->second = value;
-        return true;
-    }
+        return dataModelSetBool(model_handle, name, value);
 
     if (!model->constructor.Bind(it->first, &it->second))
     {
         model->bools.erase(it);
         return false;
     }
+
+    RmlUiDataVariable variable;
+    variable.type = DataVariableType::Bool;
+    variable.name = it->first;
+    variable.bool_value = &it->second;
+    addVariable(model, std::move(variable));
     return true;
 }
 
@@ -962,58 +1176,90 @@ bool RmlUiManager::dataModelBindString(void* model_handle, const char* name, con
 
     auto [it, inserted] = model->strings.emplace(name, value ? value : "");
     if (!inserted)
-    {
-        it->second = value ? value : "";
-        return true;
-    }
+        return dataModelSetString(model_handle, name, value);
 
     if (!model->constructor.Bind(it->first, &it->second))
     {
         model->strings.erase(it);
         return false;
     }
+
+    RmlUiDataVariable variable;
+    variable.type = DataVariableType::String;
+    variable.name = it->first;
+    variable.string_value = &it->second;
+    addVariable(model, std::move(variable));
     return true;
 }
 
-bool RmlUiManager::dataModelSetInt(void* model_handle, const char* name, int value)
+bool RmlUiManager::dataModelBindFloat(void* model_handle, const char* name, float value, int decimals)
 {
     RmlUiDataModel* model = asDataModel(model_handle);
     if (!model || !isValidName(name))
         return false;
 
-    auto it = model->ints.find(name);
-    if (it == model->ints.end())
+    auto [it, inserted] = model->strings.emplace(name, "");
+    if (!inserted)
+        return dataModelSetFloat(model_handle, name, value);
+
+    if (!model->constructor.Bind(it->first, &it->second))
+    {
+        model->strings.erase(it);
         return false;
+    }
 
-    it->second = value;
+    RmlUiDataVariable variable;
+    variable.type = DataVariableType::Float;
+    variable.name = it->first;
+    variable.string_value = &it->second;
+    variable.decimals = std::clamp(decimals, 0, 6);
+    variable.scale = std::pow(10.0f, static_cast<float>(variable.decimals));
+    formatFloat(variable, value);
+    addVariable(model, std::move(variable));
     return true;
 }
 
-bool RmlUiManager::dataModelSetBool(void* model_handle, const char* name, bool value)
+bool RmlUiManager::dataModelSetInt(void* model_handle, const char* name, int value)
 {
     RmlUiDataModel* model = asDataModel(model_handle);
-    if (!model || !isValidName(name))
+    const DataVariable variable = dataModelFindVariable(model_handle, name);
+    if (!findVariable(model, variable, DataVariableType::Int))
         return false;
 
-    auto it = model->bools.find(name);
-    if (it == model->bools.end())
+    dataModelUpdateInt(model_handle, variable, value);
+    return true;
+}
+
+bool RmlUiManager::dataModelSetBool(void* model_handle, const char* name, bool value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    const DataVariable variable = dataModelFindVariable(model_handle, name);
+    if (!findVariable(model, variable, DataVariableType::Bool))
         return false;
 
-    it->second = value;
+    dataModelUpdateBool(model_handle, variable, value);
     return true;
 }
 
 bool RmlUiManager::dataModelSetString(void* model_handle, const char* name, const char* value)
 {
     RmlUiDataModel* model = asDataModel(model_handle);
-    if (!model || !isValidName(name))
+    const DataVariable variable = dataModelFindVariable(model_handle, name);
+    if (!findVariable(model, variable, DataVariableType::String))
         return false;
 
-    auto it = model->strings.find(name);
-    if (it == model->strings.end())
+    dataModelUpdateString(model_handle, variable, value);
+    return true;
+}
+
+bool RmlUiManager::dataModelSetFloat(void* model_handle, const char* name, float value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    const DataVariable variable = dataModelFindVariable(model_handle, name);
+    if (!findVariable(model, variable, DataVariableType::Float))
         return false;
 
-    it->second = value ? value : "";
+    dataModelUpdateFloat(model_handle, variable, value);
     return true;
 }
 
@@ -1024,4 +1270,73 @@ void RmlUiManager::dataModelDirtyAll(void* model_handle)
         return;
 
     model->handle.DirtyAllVariables();
+    m_updateStats.dirty_variables += static_cast<std::uint32_t>(model->variables.size());
+    m_contextDirty = true;
+}
+
+RmlUiManager::DataVariable RmlUiManager::dataModelFindVariable(void* model_handle, const char* name)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    if (!model || !isValidName(name))
+        return 0;
+
+    auto it = model->lookup.find(name);
+    return it != model->lookup.end() ? it->second : 0;
+}
+
+bool RmlUiManager::dataModelUpdateInt(void* model_handle, DataVariable handle, int value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    RmlUiDataVariable* variable = findVariable(model, handle, DataVariableType::Int);
+    if (!variable || *variable->int_value == value)
+        return false;
+
+    *variable->int_value = value;
+    model->handle.DirtyVariable(variable->name);
+    ++m_updateStats.dirty_variables;
+    m_contextDirty = true;
+    return true;
+}
+
+bool RmlUiManager::dataModelUpdateBool(void* model_handle, DataVariable handle, bool value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    RmlUiDataVariable* variable = findVariable(model, handle, DataVariableType::Bool);
+    if (!variable || *variable->bool_value == value)
+        return false;
+
+    *variable->bool_value = value;
+    model->handle.DirtyVariable(variable->name);
+    ++m_updateStats.dirty_variables;
+    m_contextDirty = true;
+    return true;
+}
+
+bool RmlUiManager::dataModelUpdateString(void* model_handle, DataVariable handle, const char* value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    RmlUiDataVariable* variable = findVariable(model, handle, DataVariableType::String);
+    const char* text = value ? value : "";
+    if (!variable || *variable->string_value == text)
+        return false;
+
+    *variable->string_value = text;
+    model->handle.DirtyVariable(variable->name);
+    ++m_updateStats.dirty_variables;
+    m_contextDirty = true;
+    return true;
+}
+
+bool RmlUiManager::dataModelUpdateFloat(void* model_handle, DataVariable handle, float value)
+{
+    RmlUiDataModel* model = asDataModel(model_handle);
+    RmlUiDataVariable* variable = findVariable(model, handle, DataVariableType::Float);
+    if (!variable || quantize(*variable, value) == variable->quantized)
+        return false;
+
+    formatFloat(*variable, value);
+    model->handle.DirtyVariable(variable->name);
+    ++m_updateStats.dirty_variables;
+    m_contextDirty = true;
+    return true;
 }
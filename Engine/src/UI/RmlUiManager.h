@@ -18,6 +18,8 @@ public:
 
     // Initialization - call after render API is initialized
     bool initialize(SDL_Window* window, IRenderAPI* renderAPI, RenderAPIType apiType);
+    // No window or GPU: contexts lay out and "render" into a null backend (tests, benchmarks)
+    bool initializeHeadless(int width, int height);
     void shutdown();
 
     // Per-frame calls
@@ -27,6 +29,33 @@ public:
     void beginEditorFrame(int width, int height);
     void renderEditor();
 
+    // Backend submission counters for the most recent render()/renderEditor().
+    // Only the Vulkan renderer batches today; other backends report zeros.
+    struct RenderStats
+    {
+        std::uint32_t geometries = 0;
+        std::uint32_t draw_calls = 0;
+        std::uint32_t vertices = 0;
+        std::uint32_t textures = 0;
+        std::uint32_t atlas_textures = 0;
+        float record_ms = 0.0f;
+    };
+    RenderStats getRenderStats() const;
+
+    // The game context only runs Context::Update when something changed since the last
+    // one: a data model variable, a document, an element, input, the size, or a pending
+    // RmlUi animation. Code that edits elements through getContext() must call
+    // requestUpdate(). The editor context updates every frame.
+    struct UpdateStats
+    {
+        std::uint32_t updates = 0;
+        std::uint32_t skipped = 0;
+        std::uint32_t dirty_variables = 0;
+    };
+    UpdateStats getUpdateStats() const;
+    void resetUpdateStats();
+    void requestUpdate();
+
     // Event handling - returns true if RmlUi consumed the event
     bool processEvent(SDL_Event& event);
     bool processEditorEvent(SDL_Event& event);
@@ -100,16 +129,31 @@ public:
 
     // C-safe data model API for hot-loaded game modules. The model values are
     // owned by EngineGraphics so RmlUi never reads STL objects from game DLLs.
+    // Setting a variable to the value it already holds is a no-op; a changed value
+    // dirties only that variable.
     void* createDataModel(const char* name);
     void removeDataModel(void* model);
     bool dataModelBindInt(void* model, const char* name, int value);
     bool dataModelBindBool(void* model, const char* name, bool value);
     bool dataModelBindString(void* model, const char* name, const char* value);
+    // A float shown as text with a fixed number of decimals. It is reformatted only
+    // when the displayed value changes.
+    bool dataModelBindFloat(void* model, const char* name, float value, int decimals);
     bool dataModelSetInt(void* model, const char* name, int value);
     bool dataModelSetBool(void* model, const char* name, bool value);
     bool dataModelSetString(void* model, const char* name, const char* value);
+    bool dataModelSetFloat(void* model, const char* name, float value);
     void dataModelDirtyAll(void* model);
 
+    // Handle-based updates skip the name lookup. Handles stay valid for the model's
+    // lifetime; 0 is never a valid handle. Update* returns true if the value changed.
+    using DataVariable = std::uint32_t;
+    DataVariable dataModelFindVariable(void* model, const char* name);
+    bool dataModelUpdateInt(void* model, DataVariable variable, int value);
+    bool dataModelUpdateBool(void* model, DataVariable variable, bool value);
+    bool dataModelUpdateString(void* model, DataVariable variable, const char* value);
+    bool dataModelUpdateFloat(void* model, DataVariable variable, float value);
+
 private:
     RmlUiManager() = default;
     ~RmlUiManager();
@@ -121,9 +165,16 @@ private:
     bool initD3D12(SDL_Window* window, IRenderAPI* api);
     bool initVulkan(SDL_Window* window, IRenderAPI* api);
     bool initMetal(SDL_Window* window, IRenderAPI* api);
+    bool initializeContexts(int width, int height);
     void clearEditorEventRegistrationsForDocument(void* document);
+    void markDocumentDirty(void* document);
+    void updateContext();
 
     bool m_initialized = false;
+    bool m_headless = false;
+    bool m_contextDirty = true;
+    double m_lastContextUpdate = 0.0;
+    UpdateStats m_updateStats;
     RenderAPIType m_apiType = DefaultRenderAPI;
     SDL_Window* m_window = nullptr;
     IRenderAPI* m_renderAPI = nullptr;
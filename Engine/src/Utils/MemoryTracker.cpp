@@ -0,0 +1,243 @@
+#include "MemoryTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ENGINE_MEMORY_TRACKING
+#include "TrackedNewDelete.hpp"
+#endif
+
+namespace
+{
+    constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+    constexpr int MAX_TAG_DEPTH = 32;
+
+    // Plain atomics with constant initialization: operator new may run before any
+    // dynamic initializer in this module.
+    struct TagCounters
+    {
+        std::atomic<int64_t> current_bytes{0};
+        std::atomic<int64_t> peak_bytes{0};
+        std::atomic<uint64_t> total_allocations{0};
+        std::atomic<uint32_t> frame_allocations{0};
+        std::atomic<uint32_t> last_frame_allocations{0};
+    };
+
+    TagCounters g_counters[TAG_COUNT];
+
+    thread_local MemoryTag t_tag_stack[MAX_TAG_DEPTH];
+    thread_local int t_tag_depth = 0;
+
+    // Sits right before every block handed out by MemoryTracker::allocate
+    struct alignas(16) BlockHeader
+    {
+        uint64_t size;
+        uint32_t offset;   // From the start of the malloc'd block to the user pointer
+        uint8_t tag;
+    };
+
+    TagCounters& countersFor(MemoryTag tag)
+    {
+        size_t index = static_cast<size_t>(tag);
+        return g_counters[index < TAG_COUNT ? index : 0];
+    }
+
+    BlockHeader* headerOf(void* block)
+    {
+        return reinterpret_cast<BlockHeader*>(static_cast<char*>(block) - sizeof(BlockHeader));
+    }
+}
+
+const char* MemoryTracker::getTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Untagged:   return "Untagged";
+    case MemoryTag::Physics:    return "Physics";
+    case MemoryTag::Animation:  return "Animation";
+    case MemoryTag::Assets:     return "Assets";
+    case MemoryTag::Network:    return "Network";
+    case MemoryTag::Audio:      return "Audio";
+    case MemoryTag::Navigation: return "Navigation";
+    case MemoryTag::Rendering:  return "Rendering";
+    case MemoryTag::UI:         return "UI";
+    case MemoryTag::Gameplay:   return "Gameplay";
+    case MemoryTag::Count:      break;
+    }
+    return "Unknown";
+}
+
+void MemoryTracker::pushTag(MemoryTag tag)
+{
+    // Deeper scopes still pop correctly; they just keep charging the deepest recorded tag
+    if (t_tag_depth < MAX_TAG_DEPTH)
+        t_tag_stack[t_tag_depth] = tag;
+    ++t_tag_depth;
+}
+
+void MemoryTracker::popTag()
+{
+    if (t_tag_depth > 0)
+        --t_tag_depth;
+}
+
+MemoryTag MemoryTracker::getCurrentTag()
+{
+    if (t_tag_depth <= 0)
+        return MemoryTag::Untagged;
+    return t_tag_stack[std::min(t_tag_depth, MAX_TAG_DEPTH) - 1];
+}
+
+void MemoryTracker::recordAllocation(MemoryTag tag, size_t bytes)
+{
+    TagCounters& counters = countersFor(tag);
+    const int64_t current = counters.current_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+        static_cast<int64_t>(bytes);
+    int64_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (current > peak && !counters.peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+    counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::recordFree(MemoryTag tag, size_t bytes)
+{
+    countersFor(tag).current_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void* MemoryTracker::allocate(size_t bytes, size_t alignment)
+{
+    return allocateTagged(getCurrentTag(), bytes, alignment);
+}
+
+void* MemoryTracker::allocateTagged(MemoryTag tag, size_t bytes, size_t alignment)
+{
+    alignment = std::max(alignment, alignof(BlockHeader));
+    const size_t padding = alignment > alignof(BlockHeader) ? alignment : 0;
+    if (bytes > SIZE_MAX - sizeof(BlockHeader) - padding)
+        return nullptr;
+    char* raw = static_cast<char*>(std::malloc(bytes + sizeof(BlockHeader) + padding));
+    if (!raw)
+        return nullptr;
+
+    const uintptr_t first = reinterpret_cast<uintptr_t>(raw) + sizeof(BlockHeader);
+    const uintptr_t aligned = (first + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    void* block = reinterpret_cast<void*>(aligned);
+
+    BlockHeader* header = headerOf(block);
+    header->size = bytes;
+    header->offset = static_cast<uint32_t>(aligned - reinterpret_cast<uintptr_t>(raw));
+    header->tag = static_cast<uint8_t>(tag);
+
+    recordAllocation(tag, bytes);
+    return block;
+}
+
+void* MemoryTracker::reallocate(void* block, size_t bytes)
+{
+    if (!block)
+        return allocate(bytes);
+
+    BlockHeader* header = headerOf(block);
+    const MemoryTag tag = static_cast<MemoryTag>(header->tag);
+    void* grown = allocateTagged(tag, bytes);
+    if (!grown)
+        return nullptr;
+
+    std::memcpy(grown, block, static_cast<size_t>(std::min<uint64_t>(header->size, bytes)));
+    deallocate(block);
+    return grown;
+}
+
+void MemoryTracker::deallocate(void* block)
+{
+    if (!block)
+        return;
+
+    BlockHeader* header = headerOf(block);
+    recordFree(static_cast<MemoryTag>(header->tag), static_cast<size_t>(header->size));
+    std::free(static_cast<char*>(block) - header->offset);
+}
+
+void MemoryTracker::endFrame()
+{
+    for (TagCounters& counters : g_counters)
+    {
+        counters.last_frame_allocations.store(
+            counters.frame_allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag)
+{
+    const TagCounters& counters = countersFor(tag);
+    MemoryTagStats stats;
+    stats.current_bytes = counters.current_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+    stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+    stats.frame_allocations = counters.last_frame_allocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool MemoryTracker::isGlobalHookEnabled()
+{
+#ifdef ENGINE_MEMORY_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string MemoryTracker::formatReport()
+{
+    std::string report;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-12s %14s %14s %14s %12s\n",
+        "tag", "current_kb", "peak_kb", "allocs", "allocs/frame");
+    report += line;
+
+    int64_t total_current = 0;
+    uint64_t total_frame = 0;
+    for (size_t i = 0; i < TAG_COUNT; ++i)
+    {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = getStats(tag);
+        if (stats.total_allocations == 0 && stats.current_bytes == 0)
+            continue;
+
+        std::snprintf(line, sizeof(line), "%-12s %14.1f %14.1f %14llu %12u\n",
+            getTagName(tag),
+            static_cast<double>(stats.current_bytes) / 1024.0,
+            static_cast<double>(stats.peak_bytes) / 1024.0,
+            static_cast<unsigned long long>(stats.total_allocations),
+            stats.frame_allocations);
+        report += line;
+        total_current += stats.current_bytes;
+        total_frame += stats.frame_allocations;
+    }
+
+    std::snprintf(line, sizeof(line), "%-12s %14.1f %14s %14s %12llu\n",
+        "total", static_cast<double>(total_current) / 1024.0, "", "",
+        static_cast<unsigned long long>(total_frame));
+    report += line;
+    if (!isGlobalHookEnabled())
+        report += "(operator new is not hooked; build with ENGINE_MEMORY_TRACKING for full coverage)\n";
+    return report;
+}
+
+bool MemoryTracker::writeReport(const char* path)
+{
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+        return false;
+
+    const std::string report = formatReport();
+    const bool ok = std::fwrite(report.data(), 1, report.size(), file) == report.size();
+    std::fclose(file);
+    return ok;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EngineExport.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class MemoryTag : uint8_t
+{
+    Untagged,
+    Physics,
+    Animation,
+    Assets,
+    Network,
+    Audio,
+    Navigation,
+    Rendering,
+    UI,
+    Gameplay,
+    Count
+};
+
+struct MemoryTagStats
+{
+    int64_t current_bytes = 0;
+    int64_t peak_bytes = 0;
+    uint64_t total_allocations = 0;
+    uint32_t frame_allocations = 0;   // During the last completed frame (see endFrame)
+};
+
+// Tagged heap accounting. Allocations are charged to the innermost MemoryTagScope on
+// the allocating thread, and freed bytes go back to the tag that allocated them.
+//
+// Jolt allocations are always tracked (under Physics). Global operator new/delete is
+// only hooked when the engine is built with ENGINE_MEMORY_TRACKING; see
+// Utils/TrackedNewDelete.hpp. Counters are lock-free atomics, and reporting never goes
+// through the logger, so it can run inside allocation-heavy or crashing code.
+class ENGINE_API MemoryTracker
+{
+public:
+    static const char* getTagName(MemoryTag tag);
+
+    static void pushTag(MemoryTag tag);
+    static void popTag();
+    static MemoryTag getCurrentTag();
+
+    // Heap blocks with a small header recording their size and tag
+    static void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    static void* allocateTagged(MemoryTag tag, size_t bytes, size_t alignment = alignof(std::max_align_t));
+    static void* reallocate(void* block, size_t bytes);
+    static void deallocate(void* block);
+
+    // For memory owned elsewhere (pools, GPU heaps) that should still show up per tag
+    static void recordAllocation(MemoryTag tag, size_t bytes);
+    static void recordFree(MemoryTag tag, size_t bytes);
+
+    // Call once per frame; rolls the per-frame allocation counters
+    static void endFrame();
+
+    static MemoryTagStats getStats(MemoryTag tag);
+    static bool isGlobalHookEnabled();
+
+    static std::string formatReport();
+    static bool writeReport(const char* path);
+};
+
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(MemoryTag tag) { MemoryTracker::pushTag(tag); }
+    ~MemoryTagScope() { MemoryTracker::popTag(); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+};
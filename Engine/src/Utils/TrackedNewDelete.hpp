@@ -0,0 +1,81 @@
+#pragma once
+
+// Global operator new/delete routed through MemoryTracker.
+//
+// Include from exactly one .cpp per module, and only in ENGINE_MEMORY_TRACKING builds.
+// EngineCore includes it in MemoryTracker.cpp. On Linux and macOS that replaces the
+// allocator for the whole process. On Windows each module links its own CRT operators,
+// so every exe and DLL that shares heap objects with the engine must include it too:
+// blocks from the tracker can only be freed by the tracker.
+
+#include "MemoryTracker.hpp"
+#include <cstddef>
+#include <new>
+
+// Standard operator new contract: retry through the installed new_handler and
+// throw std::bad_alloc once there is none. The nothrow forms return nullptr.
+inline void* trackedNewOrThrow(std::size_t size, std::size_t alignment)
+{
+    for (;;)
+    {
+        if (void* block = MemoryTracker::allocate(size ? size : 1, alignment))
+            return block;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return trackedNewOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return MemoryTracker::allocate(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return MemoryTracker::allocate(size ? size : 1);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return trackedNewOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return MemoryTracker::allocate(size ? size : 1, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return MemoryTracker::allocate(size ? size : 1, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* block) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block) noexcept { MemoryTracker::deallocate(block); }
+void operator delete(void* block, std::size_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block, std::size_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { MemoryTracker::deallocate(block); }
+void operator delete(void* block, std::align_val_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { MemoryTracker::deallocate(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::deallocate(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::deallocate(block); }
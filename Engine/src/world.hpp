@@ -4,6 +4,7 @@
 #include "Components/camera.hpp"
 #include "EngineExport.h"
 #include "PhysicsSystem.hpp"
+#include "Scene/TransformHierarchy.hpp"
 #include "Tick/TickSystem.hpp"
 #include <cstdint>
 #include <vector>
@@ -21,6 +22,7 @@ class ENGINE_API world
 {
 private:
     std::unique_ptr<PhysicsSystem> physics_system;
+    TransformHierarchy transform_hierarchy;
     std::unique_ptr<GameFramework::GameModeBase> authority_game_mode;
     std::unique_ptr<GameFramework::GameStateBase> game_state;
     Tick::FixedTickAccumulator simulation_ticks;
@@ -30,6 +32,7 @@ private:
 
     void clearRegistryStorage()
     {
+        transform_hierarchy.clear();
         registry.clear();
 
         std::vector<entt::id_type> storage_ids;
@@ -110,10 +113,19 @@ public:
         simulation_ticks.setFixedDelta(fixed_delta);
         const uint32_t steps = simulation_ticks.consume(dt);
 
+        // Queries enqueued last tick see the state their callers saw
+        physics_system->executeSceneQueries();
+
+        // Attached kinematic bodies move with their parents. Children of bodies the step
+        // moves catch up in the hosts' propagateTransforms() before rendering and replication.
+        if (steps > 0)
+            transform_hierarchy.propagate(registry);
+
         for (uint32_t i = 0; i < steps; ++i)
         {
             physics_system->stepPhysics(registry);
             ++simulation_tick;
+            physics_system->recordStateHash(simulation_tick);
         }
 
         return steps;
@@ -121,6 +133,21 @@ public:
 
     uint32_t getSimulationTick() const { return simulation_tick; }
 
+    // Entity parenting; see Scene/TransformHierarchy.hpp
+    TransformHierarchy& getTransformHierarchy() { return transform_hierarchy; }
+    const TransformHierarchy& getTransformHierarchy() const { return transform_hierarchy; }
+
+    bool setParent(entt::entity child, entt::entity parent, bool keep_world = true)
+    {
+        return transform_hierarchy.setParent(registry, child, parent, keep_world);
+    }
+
+    // Hosts call this before rendering and replication so both see this frame's attachments
+    void propagateTransforms()
+    {
+        transform_hierarchy.propagate(registry);
+    }
+
     float getPhysicsInterpolationAlpha() const { return simulation_ticks.getAlpha(); }
 
     void player_collisions(entt::entity playerEntity)
@@ -136,22 +163,23 @@ public:
     }
 
     PhysicsSystem::RaycastResult raycastClosest(const glm::vec3& origin, const glm::vec3& direction,
-        float max_distance, entt::entity ignored_entity = entt::null)
+        float max_distance, entt::entity ignored_entity = entt::null, PhysicsLayerMask layer_mask = PHYSICS_ALL_LAYERS)
     {
-        return physics_system->raycastClosest(origin, direction, max_distance, ignored_entity);
+        return physics_system->raycastClosest(origin, direction, max_distance, ignored_entity, layer_mask);
     }
 
     // Shape casting convenience wrappers
     PhysicsSystem::ShapeCastResult sphereCast(const glm::vec3& origin, float radius,
-        const glm::vec3& direction, float maxDistance)
+        const glm::vec3& direction, float maxDistance, PhysicsLayerMask layer_mask = PHYSICS_ALL_LAYERS)
     {
-        return physics_system->sphereCast(origin, radius, direction, maxDistance);
+        return physics_system->sphereCast(origin, radius, direction, maxDistance, layer_mask);
     }
 
     PhysicsSystem::ShapeCastResult boxCast(const glm::vec3& origin, const glm::vec3& halfExtents,
-        const glm::vec3& rotation, const glm::vec3& direction, float maxDistance)
+        const glm::vec3& rotation, const glm::vec3& direction, float maxDistance,
+        PhysicsLayerMask layer_mask = PHYSICS_ALL_LAYERS)
     {
-        return physics_system->boxCast(origin, halfExtents, rotation, direction, maxDistance);
+        return physics_system->boxCast(origin, halfExtents, rotation, direction, maxDistance, layer_mask);
     }
 
     JPH::BodyID create_character_controller(entt::entity entity)
@@ -23,6 +23,7 @@
 #include "InputHandler.hpp"
 #include "Utils/Log.hpp"
 #include "Utils/EnginePaths.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "ImGui/ImGuiManager.hpp"
 #include "UI/RmlUiManager.h"
 #include "Console/ConVar.hpp"
@@ -292,7 +293,9 @@ int main(int argc, char* argv[])
     auto input_manager = input_handler.get_input_manager();
 
     // Initialize world and physics
-    _world = world();
+    PhysicsSystemSettings physics_settings;
+    physics_settings.layers = makePhysicsLayerSettings(project_manager.getDescriptor().physics_layers);
+    _world = world(physics_settings);
     _world.initializePhysics();
 
     // Parse network CLI args before level instantiation so connecting clients
@@ -366,7 +369,16 @@ int main(int argc, char* argv[])
     while (true)
     {
         render_api->executeWithAutoreleasePool([&]() {
-            Uint64 frame_start_ns = SDL_GetTicksNS();
+            FramePacer& pacer = app.getFramePacer();
+            int fps_max_val = CVAR_INT(fps_max);
+            app.setTargetFPS(fps_max_val > 0 ? fps_max_val : 10000);
+            pacer.setTargetFPS(app.getTargetFPS());
+            pacer.setMode(static_cast<FramePacingMode>(CVAR_INT(fps_pacing)));
+
+            // In low-latency mode this is where the frame waits, so the
+            // events polled below are fresh when the frame is submitted.
+            pacer.beginFrame();
+
             Uint64 frame_start = SDL_GetTicks();
 
             ImGuiManager::get().newFrame();
@@ -375,6 +387,7 @@ int main(int argc, char* argv[])
                 RmlUiManager::get().beginFrame();
 
             input_handler.process_events();
+            pacer.markInputSampled();
 
             if (input_handler.is_window_minimized())
             {
@@ -394,20 +407,25 @@ int main(int argc, char* argv[])
             _world.tickGameplayFramework(delta_time);
             game_module.update(delta_time);
 
-            // Render using the world camera (updated by the game DLL)
-            _renderer.render_scene(_world.registry, _world.world_camera);
+            // Render using the world camera (updated by the game DLL). The
+            // late latch only touches this copy; the queued motion is still
+            // consumed by next frame's simulation.
+            _world.propagateTransforms();
+            camera render_camera = _world.world_camera;
+            if (CVAR_BOOL(fps_late_latch) && !input_handler.is_ui_mode())
+                pacer.lateLatchCamera(render_camera, input_manager->get_mouse_sensitivity_x(),
+                                      input_manager->get_mouse_sensitivity_y());
+            _renderer.render_scene(_world.registry, render_camera);
 
             ImGuiManager::get().updatePlatformWindows();
 
             app.swapBuffers();
 
-            Uint64 frame_end_ns = SDL_GetTicksNS();
-            int fps_max_val = CVAR_INT(fps_max);
-            if (fps_max_val > 0)
-                app.setTargetFPS(fps_max_val);
-            else
-                app.setTargetFPS(10000);
-            app.lockFramerate(frame_start_ns, frame_end_ns);
+            const RenderFrameStats frame_stats = render_api->getLastFrameStats();
+            pacer.markSubmitted(frame_stats.gpu_frame_ms, frame_stats.gpu_frame_ms_valid,
+                                frame_stats.cpu_fence_wait_ms);
+            pacer.endFrame();
+            MemoryTracker::endFrame();
         });
     }
 
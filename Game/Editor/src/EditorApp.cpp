@@ -8,6 +8,7 @@
 #include "Utils/Log.hpp"
 #include "Utils/FileDialog.hpp"
 #include "Utils/EnginePaths.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "Components/Components.hpp"
 #include "Components/PrefabInstanceComponent.hpp"
 #include "Prefab/PrefabManager.hpp"
@@ -16,6 +17,7 @@
 #include "Reflection/ReflectionSerializer.hpp"
 #include "Assets/LODMeshSerializer.hpp"
 #include "Assets/AssetManager.hpp"
+#include "Assets/AssetCompiler.hpp"
 #include "Project/ProjectManager.hpp"
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -304,6 +306,7 @@ namespace
     PhysicsSystem::PhysicsBodyDesc makeClonedBodyDesc(entt::registry& registry,
                                                        entt::entity entity,
                                                        const ColliderComponent& collider,
+                                                       const PhysicsSystem& physics,
                                                        bool player_body = false)
     {
         PhysicsSystem::PhysicsBodyDesc desc;
@@ -320,6 +323,8 @@ namespace
         desc.friction = collider.friction;
         desc.restitution = collider.restitution;
         desc.lock_rotation = true;
+        if (!collider.collision_layer.empty())
+            desc.object_layer = physics.findLayer(collider.collision_layer);
         return desc;
     }
 
@@ -340,7 +345,7 @@ namespace
 
         auto& collider = registry.get<ColliderComponent>(entity);
         auto& transform = registry.get<TransformComponent>(entity);
-        PhysicsSystem::PhysicsBodyDesc desc = makeClonedBodyDesc(registry, entity, collider);
+        PhysicsSystem::PhysicsBodyDesc desc = makeClonedBodyDesc(registry, entity, collider, game_world.getPhysicsSystem());
 
         BodyMotionType motion = BodyMotionType::Static;
         if (auto* rb = registry.try_get<RigidBodyComponent>(entity))
@@ -448,9 +453,10 @@ namespace
     std::unique_ptr<world> cloneEditorWorldForPIE(world& editor_world,
                                                   const LevelMetadata& metadata,
                                                   const ReflectionRegistry& reflection,
-                                                  const LevelManager& level_manager)
+                                                  const LevelManager& level_manager,
+                                                  const PhysicsSystemSettings& physics_settings)
     {
-        auto play_world = std::make_unique<world>();
+        auto play_world = std::make_unique<world>(physics_settings);
         play_world->setGravity(metadata.gravity);
         play_world->setFixedDelta(metadata.fixed_delta);
         level_manager.applyGameplayFrameworkSettings(metadata, *play_world);
@@ -561,6 +567,17 @@ bool EditorApp::initialize(RenderAPIType api_type)
         return false;
     }
 
+    // Rebuild shaders whose sources or imports changed since the last run. Without the
+    // Slang SDK the prebuilt outputs in assets/shaders/compiled are used as they are.
+    if (Assets::ShaderCompiler::isSlangAvailable())
+    {
+        Assets::ShaderBuildConfig shader_config;
+#ifndef _WIN32
+        shader_config.build_dxil = false;
+#endif
+        Assets::AssetCompiler::compileShaders(shader_config);
+    }
+
     int win_w = CVAR_INT(window_width);
     int win_h = CVAR_INT(window_height);
     if (win_w <= 0) win_w = 1600;
@@ -796,6 +813,7 @@ bool EditorApp::initialize(RenderAPIType api_type)
     };
     m_navmesh_panel.registry = &m_world.registry;
     m_physics_debug_panel.registry = &m_world.registry;
+    m_physics_layers_panel.project_manager = &m_project_manager;
 
     // Asset scanner: scan and process new/changed mesh assets
     m_content_browser.asset_scanner = &m_asset_scanner;
@@ -833,6 +851,12 @@ bool EditorApp::initialize(RenderAPIType api_type)
         m_level_manager.setGameplayDefaults(m_project_manager.getDescriptor().default_game_mode,
                                             m_project_manager.getDescriptor().default_game_state);
 
+        // The editor world started with the default layers; rebuild it with the project's
+        // before any level bodies exist.
+        m_world.getPhysicsSystem().shutdown();
+        m_world.configurePhysics(projectPhysicsSettings());
+        m_world.initializePhysics();
+
         if (!m_project_manager.getDescriptor().default_level.empty())
             openLevel(m_project_manager.getDescriptor().default_level);
     }
@@ -1339,43 +1363,63 @@ void EditorApp::run()
         // --- Choose which world/camera to render with ---
         world& render_world = chooseRenderWorld();
         camera& render_camera = chooseRenderCamera();
+        render_world.propagateTransforms();
 
-        // --- Phase 1: Render 3D scene to viewport texture ---
+        // --- Phase 1: Render the main viewport and PIE client viewports ---
+        // Submitted as one multi-view request: views of the same world are
+        // culled together, and all views record in parallel.
         IRenderAPI* render_api = m_app.getRenderAPI();
         render_api->setEditorViewport(m_main_viewport.get());
         render_api->setViewportSize(m_viewport.width, m_viewport.height);
         const bool render_main_viewport =
             m_show_viewport && m_viewport.is_visible && m_viewport.width > 0 && m_viewport.height > 0;
-        render_api->setSceneRmlEnabled(!m_external_pie_active &&
-                                       (m_state.play_mode == PlayMode::Playing ||
-                                        m_state.play_mode == PlayMode::Paused));
+
+        std::vector<RenderView> views;
+        views.reserve(1 + m_pie_clients.size());
+        if (render_main_viewport)
         {
-            EditorPerformanceMonitor::ScopedTimer timer(m_perf_monitor, EditorPerfSeries::CpuViewport);
-            if (render_main_viewport)
-                m_renderer.render_scene_to_texture(render_world.registry, render_camera);
+            RenderView main_view;
+            main_view.registry = &render_world.registry;
+            main_view.cam = &render_camera;
+            main_view.target = m_main_viewport.get();
+            main_view.width = m_viewport.width;
+            main_view.height = m_viewport.height;
+            main_view.scene_rml = !m_external_pie_active &&
+                                  (m_state.play_mode == PlayMode::Playing ||
+                                   m_state.play_mode == PlayMode::Paused);
+            views.push_back(main_view);
         }
 
-        // --- Phase 1b: Render additional PIE client viewports ---
         {
-            EditorPerformanceMonitor::ScopedTimer timer(m_perf_monitor, EditorPerfSeries::CpuPIEViewports);
-            render_api->setSceneRmlEnabled(false);
+            // Only collects the PIE views; render_views below culls and records them
+            EditorPerformanceMonitor::ScopedTimer timer(m_perf_monitor, EditorPerfSeries::CpuPIEViewSetup);
             for (auto& inst : m_pie_clients)
             {
                 if (!inst || !inst->initialized || !inst->viewport)
                     continue;
 
-                // Bind the PIE viewport as the active scene render target. resize()
-                // is a no-op if the size hasn't changed.
+                // resize() is a no-op if the size hasn't changed
                 inst->viewport->resize(inst->viewport_width, inst->viewport_height);
-                render_api->setEditorViewport(inst->viewport.get());
-                render_api->setViewportSize(inst->viewport_width, inst->viewport_height);
 
-                // Render the client's world using its camera
-                m_renderer.render_scene_to_texture(inst->client_world.registry,
-                                                    inst->client_world.world_camera);
+                // The client's world through its camera
+                inst->client_world.propagateTransforms();
+                RenderView pie_view;
+                pie_view.registry = &inst->client_world.registry;
+                pie_view.cam = &inst->client_world.world_camera;
+                pie_view.target = inst->viewport.get();
+                pie_view.width = inst->viewport_width;
+                pie_view.height = inst->viewport_height;
+                views.push_back(pie_view);
             }
         }
 
+        {
+            // Every view, main and PIE, until their recording has joined and been submitted
+            EditorPerformanceMonitor::ScopedTimer timer(m_perf_monitor, EditorPerfSeries::CpuViewport);
+            if (!views.empty())
+                m_renderer.render_views(views, &render_world.registry);
+        }
+
         // Restore main viewport binding + size for any post-PIE work that
         // assumes the main editor viewport is current.
         if (!m_pie_clients.empty())
@@ -1520,7 +1564,7 @@ void EditorApp::run()
             {
                 ImTextureID tex = (ImTextureID)render_api->getViewportTextureID();
                 GizmoResult gizmo = m_viewport.draw(tex, m_state,
-                    m_world.registry, m_hierarchy.selected_entity,
+                    m_world.registry, m_hierarchy.selected_entity, m_hierarchy.selected_entities,
                     chooseRenderCamera(), render_api, m_renderer.getSceneBVH(),
                     &m_show_viewport);
 
@@ -1607,6 +1651,9 @@ void EditorApp::run()
             if (m_show_physics_debug)
                 m_physics_debug_panel.draw(&m_show_physics_debug);
 
+            if (m_show_physics_layers)
+                m_physics_layers_panel.draw(&m_show_physics_layers);
+
             if (m_show_performance_monitor)
                 m_performance_monitor_panel.draw(m_perf_monitor, &m_show_performance_monitor);
 
@@ -1665,7 +1712,9 @@ void EditorApp::run()
         Uint64 frame_end_ns = SDL_GetTicksNS();
         m_perf_monitor.addSample(EditorPerfSeries::CpuFrame,
                                  EditorPerformanceMonitor::nsToMs(frame_end_ns - frame_start_ns));
+        m_perf_monitor.setGpuPassTimings(render_api->getGpuPassTimings());
         m_perf_monitor.endFrame(render_api->getLastFrameStats());
+        MemoryTracker::endFrame();
         applyEditorFpsCap(m_app);
         m_app.lockFramerate(frame_start_ns, frame_end_ns);
         }); // executeWithAutoreleasePool
@@ -1861,7 +1910,8 @@ void EditorApp::beginPlay()
         m_world,
         m_play_snapshot.metadata,
         m_reflection,
-        m_level_manager);
+        m_level_manager,
+        projectPhysicsSettings());
     if (!m_play_world)
     {
         LOG_ENGINE_ERROR("PIE: Failed to create isolated play world");
@@ -1911,7 +1961,7 @@ void EditorApp::beginPlay()
             uint16_t port = m_state.network_pie.server_port;
 
             // Initialize a separate server world
-            m_server_world = world();
+            m_server_world = world(projectPhysicsSettings());
             m_server_world.initializePhysics();
 
             // Instantiate level into server world
@@ -1991,7 +2041,7 @@ void EditorApp::beginPlay()
                                 inst->window_title = "Player " + std::to_string(i);
 
                                 // Create isolated world
-                                inst->client_world = world();
+                                inst->client_world = world(projectPhysicsSettings());
                                 inst->client_world.initializePhysics();
                                 m_level_manager.instantiateLevelParallel(m_play_snapshot, inst->client_world,
                                     m_app.getRenderAPI(), nullptr, nullptr, nullptr, false);
@@ -2143,7 +2193,7 @@ void EditorApp::beginPlay()
                             auto inst = std::make_unique<PIEClientInstance>();
                             inst->player_index = i;
                             inst->window_title = "Player " + std::to_string(i);
-                            inst->client_world = world();
+                            inst->client_world = world(projectPhysicsSettings());
                             inst->client_world.initializePhysics();
                             m_level_manager.instantiateLevelParallel(m_play_snapshot, inst->client_world,
                                 m_app.getRenderAPI(), nullptr, nullptr, nullptr, false);
@@ -2313,6 +2363,13 @@ bool EditorApp::beginExternalPlay()
     return true;
 }
 
+PhysicsSystemSettings EditorApp::projectPhysicsSettings() const
+{
+    PhysicsSystemSettings physics_settings;
+    physics_settings.layers = makePhysicsLayerSettings(m_project_manager.getDescriptor().physics_layers);
+    return physics_settings;
+}
+
 void EditorApp::applyPIESpawnLocation()
 {
     if (m_state.pie_spawn_location != PIESpawnLocation::CurrentCameraLocation || !m_play_world)
@@ -2337,6 +2394,45 @@ void EditorApp::applyPIESpawnLocation()
     LOG_ENGINE_WARN("PIE: Current Camera Location was selected, but no Player entity exists in the play world");
 }
 
+void EditorApp::hotReloadGameModule()
+{
+    // Listen-server and multi-client PIE keep module state in more places than
+    // the play world (server world, extra client instances); restart PIE there.
+    if (!m_game_module_active || m_network_pie_active || !m_play_world)
+    {
+        LOG_ENGINE_WARN("Hot reload is only available during standalone PIE");
+        return;
+    }
+
+    std::string dll_path = m_project_manager.getAbsoluteModulePath();
+    if (dll_path.empty() || !std::filesystem::exists(dll_path))
+    {
+        LOG_ENGINE_ERROR("Hot reload: game module '{}' not found", dll_path);
+        return;
+    }
+
+    if (auto* api = m_app.getRenderAPI())
+        api->waitForGPU();
+
+    // Module globals are rebuilt by init(); reflected components carry the
+    // gameplay state across, so the level stays loaded.
+    m_game_module.shutdown();
+    if (!m_game_module.reload(dll_path, { &m_play_world->registry }) ||
+        !m_game_module.init(&m_client_services))
+    {
+        LOG_ENGINE_ERROR("Hot reload of '{}' failed - stopping play", dll_path);
+        m_game_module.unload();
+        m_game_module_active = false;
+        stopPlay();
+        return;
+    }
+
+    m_game_module.onLevelLoaded();
+    const ModuleStateRestoreStats& stats = m_game_module.getLastRestoreStats();
+    LOG_ENGINE_INFO("--- PIE: Game module hot-reloaded ({} components restored, {} dropped) ---",
+                    stats.components_restored, stats.components_dropped);
+}
+
 void EditorApp::stopPlay()
 {
     if (!m_state.isSimulationActive())
@@ -3074,6 +3170,7 @@ void EditorApp::renderMenuBar()
             ImGui::MenuItem("Asset Preview",   nullptr, &m_show_model_preview);
             ImGui::MenuItem("Status Bar",      nullptr, &m_show_status_bar);
             ImGui::MenuItem("NavMesh",         nullptr, &m_show_navmesh_panel);
+            ImGui::MenuItem("Physics Layers",  nullptr, &m_show_physics_layers);
             ImGui::MenuItem("Grid",            nullptr, &m_state.show_grid);
 
             // Plugin-contributed panels (grouped under a sub-header when present).
@@ -3100,6 +3197,10 @@ void EditorApp::renderMenuBar()
         {
             ImGui::MenuItem("Physics Debug",       nullptr, &m_show_physics_debug);
             ImGui::MenuItem("Performance Monitor", nullptr, &m_show_performance_monitor);
+            ImGui::Separator();
+            if (ImGui::MenuItem("Hot Reload Game Module", nullptr, false,
+                                m_game_module_active && !m_network_pie_active))
+                hotReloadGameModule();
             ImGui::EndMenu();
         }
 
@@ -3813,7 +3914,9 @@ void EditorApp::newLevel()
     m_world.registry.clear();
     m_level_manager.cleanup();
     m_inspector.mesh_path_cache.clear();
+    m_viewport.clearPickingCache();
     m_hierarchy.selected_entity = entt::null;
+    m_hierarchy.selected_entities.clear();
 
     m_level_data = LevelData{};
     m_level_settings.metadata = &m_level_data.metadata;
@@ -3841,7 +3944,9 @@ void EditorApp::openLevel(const std::string& path)
     m_world.registry.clear();
     m_level_manager.cleanup();
     m_inspector.mesh_path_cache.clear();
+    m_viewport.clearPickingCache();
     m_hierarchy.selected_entity = entt::null;
+    m_hierarchy.selected_entities.clear();
 
     m_level_data = std::move(new_data);
     m_level_settings.metadata = &m_level_data.metadata;
@@ -3949,6 +4054,7 @@ namespace
                a.collider_cylinder_radius == b.collider_cylinder_radius &&
                a.collider_friction == b.collider_friction &&
                a.collider_restitution == b.collider_restitution &&
+               a.collider_layer == b.collider_layer &&
                a.has_constraint == b.has_constraint &&
                a.constraint_type == b.constraint_type &&
                a.constraint_target_name == b.constraint_target_name &&
@@ -4063,7 +4169,9 @@ void EditorApp::restoreFromSnapshot(const LevelData& snapshot)
     m_world.registry.clear();
     m_level_manager.cleanup();
     m_inspector.mesh_path_cache.clear();
+    m_viewport.clearPickingCache();
     m_hierarchy.selected_entity = entt::null;
+    m_hierarchy.selected_entities.clear();
 
     m_level_data = snapshot;
     m_level_settings.metadata = &m_level_data.metadata;
@@ -4215,6 +4323,7 @@ LevelEntity EditorApp::buildLevelEntityFromECS(entt::entity entity) const
         le.collider_cylinder_radius = col.cylinder_radius;
         le.collider_friction = col.friction;
         le.collider_restitution = col.restitution;
+        le.collider_layer = col.collision_layer;
     }
 
     // Constraint component
@@ -4369,6 +4478,7 @@ void EditorApp::pasteEntity()
         col.cylinder_radius = le.collider_cylinder_radius;
         col.friction = le.collider_friction;
         col.restitution = le.collider_restitution;
+        col.collision_layer = le.collider_layer;
     }
 
     // Constraint
@@ -21,6 +21,7 @@
 #include "panels/ViewportPanel.hpp"
 #include "panels/NavMeshPanel.hpp"
 #include "panels/PhysicsDebugPanel.hpp"
+#include "panels/PhysicsLayersPanel.hpp"
 #include "panels/PerformanceMonitorPanel.hpp"
 #include "panels/LODSettingsPanel.hpp"
 #include "panels/ModelPreviewPanel.hpp"
@@ -86,6 +87,7 @@ private:
     bool m_show_viewport       = true;
     bool m_show_navmesh_panel  = false;
     bool m_show_physics_debug  = false;
+    bool m_show_physics_layers = false;
     bool m_show_model_preview  = true;
     bool m_show_plugin_manager = false;
     bool m_show_performance_monitor = false;
@@ -131,6 +133,7 @@ private:
     EditorRmlGui         m_rml_gui;
     NavMeshPanel         m_navmesh_panel;
     PhysicsDebugPanel    m_physics_debug_panel;
+    PhysicsLayersPanel   m_physics_layers_panel;
     PerformanceMonitorPanel m_performance_monitor_panel;
     EditorPerformanceMonitor m_perf_monitor;
 
@@ -185,12 +188,14 @@ private:
     // PIE state transitions
     void beginPlay();
     void stopPlay();
+    void hotReloadGameModule();
     void pausePlay();
     void resumePlay();
     void ejectFromPlay();
     void returnToPlay();
     bool beginExternalPlay();
     void applyPIESpawnLocation();
+    PhysicsSystemSettings projectPhysicsSettings() const;  // Default settings with the project's layers
     world& chooseRenderWorld();
     camera& chooseRenderCamera();
 
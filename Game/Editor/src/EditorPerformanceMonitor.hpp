@@ -4,13 +4,14 @@
 #include <SDL3/SDL.h>
 #include <array>
 #include <cstddef>
+#include <utility>
 
 enum class EditorPerfSeries : size_t
 {
     CpuFrame = 0,
     CpuSimulation,
     CpuViewport,
-    CpuPIEViewports,
+    CpuPIEViewSetup,
     CpuPrefabPreviews,
     CpuUIBuild,
     CpuPluginTick,
@@ -88,6 +89,15 @@ public:
         m_frameActive = false;
     }
 
+    // Per-pass GPU times arrive a few frames late, whenever the backend reads them back
+    void setGpuPassTimings(GpuPassTimings timings)
+    {
+        if (timings.valid)
+            m_gpuPasses = std::move(timings);
+    }
+
+    const GpuPassTimings& gpuPassTimings() const { return m_gpuPasses; }
+
     int historySize() const { return m_count; }
     const char* backendName() const { return m_backendName; }
     uint64_t completedGpuFrame() const { return m_completedGpuFrame; }
@@ -132,4 +142,5 @@ private:
     bool m_frameActive = false;
     const char* m_backendName = "Unknown";
     uint64_t m_completedGpuFrame = 0;
+    GpuPassTimings m_gpuPasses;
 };
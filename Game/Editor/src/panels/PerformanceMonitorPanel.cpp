@@ -21,8 +21,8 @@ namespace
         static const std::array<SeriesStyle, EditorPerformanceMonitor::kSeriesCount> styles = {{
             { EditorPerfSeries::CpuFrame,          "CPU Frame",       IM_COL32(242, 205, 80, 255) },
             { EditorPerfSeries::CpuSimulation,     "Simulation",      IM_COL32(112, 190, 255, 255) },
-            { EditorPerfSeries::CpuViewport,       "Viewport",        IM_COL32(85, 220, 170, 255) },
-            { EditorPerfSeries::CpuPIEViewports,   "PIE Viewports",   IM_COL32(130, 165, 255, 255) },
+            { EditorPerfSeries::CpuViewport,       "Viewports",       IM_COL32(85, 220, 170, 255) },
+            { EditorPerfSeries::CpuPIEViewSetup,   "PIE View Setup",  IM_COL32(130, 165, 255, 255) },
             { EditorPerfSeries::CpuPrefabPreviews, "Prefab Previews", IM_COL32(255, 155, 95, 255) },
             { EditorPerfSeries::CpuUIBuild,        "UI Build",        IM_COL32(205, 145, 255, 255) },
             { EditorPerfSeries::CpuPluginTick,     "Plugin Tick",     IM_COL32(255, 115, 145, 255) },
@@ -188,5 +188,45 @@ void PerformanceMonitorPanel::draw(const EditorPerformanceMonitor& monitor, bool
         ImGui::EndTable();
     }
 
+    const GpuPassTimings& gpu_passes = monitor.gpuPassTimings();
+    if (gpu_passes.valid && ImGui::CollapsingHeader("GPU Passes", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        if (ImGui::BeginTable("##gpu_passes", 3, ImGuiTableFlags_SizingStretchProp |
+                                                 ImGuiTableFlags_RowBg |
+                                                 ImGuiTableFlags_BordersInnerV))
+        {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("Latest");
+            ImGui::TableSetupColumn("Average");
+            ImGui::TableHeadersRow();
+
+            auto row = [](const char* label, float indent, float latest, float average, bool dim) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Indent(indent + 1.0f);
+                if (dim)
+                    ImGui::TextDisabled("%s", label);
+                else
+                    ImGui::TextUnformatted(label);
+                ImGui::Unindent(indent + 1.0f);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.3f ms", latest);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.3f ms", average);
+            };
+
+            // Nested scopes are already part of their parent's time
+            for (const GpuPassTiming& timing : gpu_passes.passes)
+            {
+                row(timing.name.c_str(), 12.0f * static_cast<float>(timing.depth),
+                    timing.last_ms, timing.average_ms, timing.depth > 0);
+            }
+            row("Other", 0.0f, gpu_passes.unattributed_ms, gpu_passes.average_unattributed_ms, true);
+            row("GPU Frame", 0.0f, gpu_passes.frame_ms, gpu_passes.average_frame_ms, false);
+
+            ImGui::EndTable();
+        }
+    }
+
     ImGui::End();
 }
@@ -0,0 +1,231 @@
+#include "PhysicsLayersPanel.hpp"
+#include "PanelUtils.hpp"
+#include "Project/ProjectManager.hpp"
+#include "imgui.h"
+#include <cstring>
+
+void PhysicsLayersPanel::revert()
+{
+    m_layers = project_manager ? makePhysicsLayerSettings(project_manager->getDescriptor().physics_layers)
+                               : PhysicsLayerSettings{};
+    m_loaded = true;
+    m_dirty = false;
+    m_selected = -1;
+    m_name_buf[0] = '\0';
+}
+
+void PhysicsLayersPanel::draw(bool* p_open)
+{
+    ImGui::Begin("Physics Layers", p_open);
+    PanelMaximizeButton();
+
+    if (!project_manager || !project_manager->isLoaded())
+    {
+        ImGui::TextDisabled("No project loaded.");
+        ImGui::End();
+        return;
+    }
+
+    if (!m_loaded)
+        revert();
+
+    drawLayerList();
+    ImGui::Separator();
+    drawDefaultLayers();
+    ImGui::Separator();
+    drawCollisionMatrix();
+    ImGui::Separator();
+
+    ImGui::BeginDisabled(!m_dirty);
+    if (ImGui::Button("Save to Project"))
+        save();
+    ImGui::SameLine();
+    if (ImGui::Button("Revert"))
+        revert();
+    ImGui::EndDisabled();
+
+    if (!m_status.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextColored(m_status_ok ? ImVec4(0.4f, 0.9f, 0.4f, 1.0f) : ImVec4(0.9f, 0.4f, 0.4f, 1.0f),
+                           "%s", m_status.c_str());
+    }
+    ImGui::TextDisabled("Changes apply to play sessions started after saving.");
+
+    ImGui::End();
+}
+
+void PhysicsLayersPanel::drawLayerList()
+{
+    ImGui::Text("Layers (%u / %u)", uint32_t(m_layers.object_layer_count), uint32_t(PhysicsObjectLayers::Max));
+
+    if (ImGui::BeginTable("##physics_layers", 3, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Broad phase");
+        ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableHeadersRow();
+
+        for (JPH::ObjectLayer layer = 0; layer < m_layers.object_layer_count; ++layer)
+        {
+            ImGui::PushID(int(layer));
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(m_layers.names[layer].c_str(), m_selected == int(layer)))
+            {
+                m_selected = int(layer);
+                std::strncpy(m_name_buf, m_layers.names[layer].c_str(), sizeof(m_name_buf) - 1);
+                m_name_buf[sizeof(m_name_buf) - 1] = '\0';
+            }
+
+            ImGui::TableNextColumn();
+            ImGui::SetNextItemWidth(-1.0f);
+            int broad_phase = m_layers.broad_phases[layer].GetValue();
+            const char* broad_phase_names[PhysicsBroadPhaseLayers::Count];
+            for (uint32_t i = 0; i < PhysicsBroadPhaseLayers::Count; ++i)
+                broad_phase_names[i] = getPhysicsBroadPhaseName(JPH::BroadPhaseLayer(JPH::BroadPhaseLayer::Type(i)));
+            if (ImGui::Combo("##broad_phase", &broad_phase, broad_phase_names, int(PhysicsBroadPhaseLayers::Count)))
+            {
+                m_layers.setBroadPhase(layer, JPH::BroadPhaseLayer(JPH::BroadPhaseLayer::Type(broad_phase)));
+                m_dirty = true;
+            }
+
+            ImGui::TableNextColumn();
+            if (ImGui::SmallButton("Remove"))
+            {
+                removeLayer(layer);
+                ImGui::PopID();
+                break;
+            }
+
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::SetNextItemWidth(180.0f);
+    ImGui::InputText("##layer_name", m_name_buf, sizeof(m_name_buf));
+    ImGui::SameLine();
+    const bool name_taken = m_name_buf[0] == '\0' || m_layers.findLayer(m_name_buf) != JPH::cObjectLayerInvalid;
+    ImGui::BeginDisabled(name_taken || m_layers.object_layer_count >= PhysicsObjectLayers::Max);
+    if (ImGui::Button("Add"))
+    {
+        m_selected = int(m_layers.addLayer(m_name_buf, PhysicsBroadPhaseLayers::Moving));
+        m_dirty = true;
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(name_taken || !m_layers.isValidLayer(JPH::ObjectLayer(m_selected)));
+    if (ImGui::Button("Rename"))
+    {
+        m_layers.names[m_selected] = m_name_buf;
+        m_dirty = true;
+    }
+    ImGui::EndDisabled();
+}
+
+void PhysicsLayersPanel::drawDefaultLayers()
+{
+    ImGui::Text("Default layers");
+    ImGui::TextDisabled("Used by bodies whose collider does not name a layer.");
+
+    auto layerCombo = [this](const char* label, JPH::ObjectLayer& layer) {
+        const char* preview = m_layers.isValidLayer(layer) ? m_layers.names[layer].c_str() : "<none>";
+        ImGui::SetNextItemWidth(180.0f);
+        if (ImGui::BeginCombo(label, preview))
+        {
+            for (JPH::ObjectLayer candidate = 0; candidate < m_layers.object_layer_count; ++candidate)
+            {
+                if (ImGui::Selectable(m_layers.names[candidate].c_str(), candidate == layer))
+                {
+                    layer = candidate;
+                    m_dirty = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+    };
+
+    layerCombo("Static bodies", m_layers.static_body);
+    layerCombo("Dynamic and kinematic bodies", m_layers.dynamic_body);
+    layerCombo("Characters", m_layers.character_body);
+}
+
+void PhysicsLayersPanel::drawCollisionMatrix()
+{
+    ImGui::Text("Collision matrix");
+    const int count = int(m_layers.object_layer_count);
+    if (count == 0)
+        return;
+
+    // Upper triangle only: the matrix is symmetric. Columns run in reverse like rows read down.
+    const ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_Borders |
+                                  ImGuiTableFlags_ScrollX | ImGuiTableFlags_HighlightHoveredColumn;
+    if (!ImGui::BeginTable("##layer_matrix", count + 1, flags))
+        return;
+
+    ImGui::TableSetupColumn("", ImGuiTableColumnFlags_NoHeaderLabel);
+    for (int column = count - 1; column >= 0; --column)
+        ImGui::TableSetupColumn(m_layers.names[column].c_str(), ImGuiTableColumnFlags_AngledHeader);
+    ImGui::TableAngledHeadersRow();
+
+    for (int row = 0; row < count; ++row)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(m_layers.names[row].c_str());
+
+        for (int column = count - 1; column >= row; --column)
+        {
+            ImGui::TableNextColumn();
+            ImGui::PushID(row * int(PhysicsObjectLayers::Max) + column);
+            bool collides = m_layers.shouldObjectsCollide(JPH::ObjectLayer(row), JPH::ObjectLayer(column));
+            if (ImGui::Checkbox("##collides", &collides))
+            {
+                m_layers.setCollides(JPH::ObjectLayer(row), JPH::ObjectLayer(column), collides);
+                m_dirty = true;
+            }
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s / %s", m_layers.names[row].c_str(), m_layers.names[column].c_str());
+            ImGui::PopID();
+        }
+    }
+
+    ImGui::EndTable();
+}
+
+void PhysicsLayersPanel::removeLayer(JPH::ObjectLayer layer)
+{
+    // Layers are indices, so removing one renumbers those after it. Round-trip through the
+    // name-based project form, which the rest of the settings are keyed by anyway.
+    ProjectPhysicsLayers project_layers = makeProjectPhysicsLayers(m_layers);
+    const std::string removed = m_layers.names[layer];
+    project_layers.layers.erase(project_layers.layers.begin() + layer);
+    for (ProjectPhysicsLayer& entry : project_layers.layers)
+        std::erase(entry.collides_with, removed);
+    if (project_layers.layers.empty())
+    {
+        m_status = "At least one layer is required";
+        m_status_ok = false;
+        return;
+    }
+
+    const std::string& fallback = project_layers.layers.front().name;
+    if (project_layers.static_layer == removed) project_layers.static_layer = fallback;
+    if (project_layers.dynamic_layer == removed) project_layers.dynamic_layer = fallback;
+    if (project_layers.character_layer == removed) project_layers.character_layer = project_layers.dynamic_layer;
+
+    m_layers = makePhysicsLayerSettings(project_layers);
+    m_selected = -1;
+    m_dirty = true;
+}
+
+void PhysicsLayersPanel::save()
+{
+    project_manager->getDescriptor().physics_layers = makeProjectPhysicsLayers(m_layers);
+    m_status_ok = project_manager->saveProject();
+    m_status = m_status_ok ? "Saved" : "Failed to write project file";
+    if (m_status_ok)
+        m_dirty = false;
+}
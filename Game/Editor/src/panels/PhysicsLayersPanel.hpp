@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Physics/PhysicsSettings.hpp"
+#include <string>
+
+class ProjectManager;
+
+// Edits the project's named collision layers, their broadphase trees and the collision
+// matrix. Saving writes them to the .garden file; play sessions started afterwards use them.
+class PhysicsLayersPanel
+{
+public:
+    ProjectManager* project_manager = nullptr;
+
+    void draw(bool* p_open = nullptr);
+
+    // Drops unsaved edits and reloads the layers from the project
+    void revert();
+
+private:
+    void drawLayerList();
+    void drawDefaultLayers();
+    void drawCollisionMatrix();
+    void removeLayer(JPH::ObjectLayer layer);
+    void save();
+
+    PhysicsLayerSettings m_layers;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    int m_selected = -1;
+    char m_name_buf[64] = "";
+    std::string m_status;
+    bool m_status_ok = true;
+};
@@ -143,7 +143,7 @@ void SceneHierarchyPanel::draw(entt::registry& registry, bool* out_dirty, bool*
         if (!containsCaseInsensitive(tag.name, m_filter_buf))
             continue;
 
-        bool is_selected = (entity == selected_entity);
+        bool is_selected = isSelected(entity);
         ImGui::PushID(static_cast<int>(static_cast<uint32_t>(entity)));
 
         // Alternating row backgrounds
@@ -318,6 +318,8 @@ void SceneHierarchyPanel::draw(entt::registry& registry, bool* out_dirty, bool*
     {
         if (selected_entity == to_delete)
             selected_entity = entt::null;
+        selected_entities.erase(std::remove(selected_entities.begin(), selected_entities.end(), to_delete),
+                                selected_entities.end());
         m_hidden_entities.erase(to_delete);
         if (on_entity_destroyed)
             on_entity_destroyed(to_delete);
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <algorithm>
 #include <unordered_set>
+#include <vector>
 #include <functional>
 #include <string>
 
@@ -12,6 +14,18 @@ class SceneHierarchyPanel
 public:
     entt::entity selected_entity = entt::null;
 
+    // Multi-selection from the viewport marquee. Only meaningful while its
+    // first entry is selected_entity; selecting anything else invalidates it.
+    std::vector<entt::entity> selected_entities;
+
+    bool isSelected(entt::entity e) const
+    {
+        if (e == selected_entity)
+            return true;
+        return !selected_entities.empty() && selected_entities.front() == selected_entity &&
+               std::find(selected_entities.begin(), selected_entities.end(), e) != selected_entities.end();
+    }
+
     // Callback: editor wires this to open save dialog and write .prefab file
     std::function<void(entt::entity)> on_save_as_prefab;
 
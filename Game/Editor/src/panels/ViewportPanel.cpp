@@ -9,9 +9,12 @@
 #include "Graphics/BVH.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
 
 GizmoResult ViewportPanel::draw(ImTextureID scene_texture, EditorState& state,
                                 entt::registry& registry, entt::entity& selected,
+                                std::vector<entt::entity>& selection,
                                 camera& cam, IRenderAPI* render_api, SceneBVH& bvh,
                                 bool* p_open)
 {
@@ -125,7 +128,9 @@ GizmoResult ViewportPanel::draw(ImTextureID scene_texture, EditorState& state,
 
         // Handle viewport click-to-select (after gizmo so IsOver() is current)
         if (!play_mode_changed_by_toolbar && !state.isSimulationActive())
-            handlePicking(image_clicked, registry, selected, render_api, bvh);
+            handlePicking(image_clicked, registry, selected, selection, render_api, bvh);
+        else
+            m_marquee_pending = false;
     }
     else
     {
@@ -303,55 +308,107 @@ void ViewportPanel::drawGizmo(EditorState& state, entt::registry& registry,
     }
 }
 
+glm::mat4 ViewportPanel::getPickingViewProjection(IRenderAPI* render_api) const
+{
+    glm::mat4 view = render_api->getViewMatrix();
+    glm::mat4 projection = render_api->getProjectionMatrix();
+
+    // Undo Vulkan Y-flip for unprojection
+    if (projection[1][1] < 0.0f)
+        projection[1][1] *= -1.0f;
+
+    return projection * view;
+}
+
+glm::vec2 ViewportPanel::screenToNDC(const ImVec2& screen) const
+{
+    float vp_w = m_image_max.x - m_image_min.x;
+    float vp_h = m_image_max.y - m_image_min.y;
+    float local_x = screen.x - m_image_min.x;
+    float local_y = screen.y - m_image_min.y;
+
+    // Screen Y is down, NDC Y is up
+    return glm::vec2((local_x / vp_w) * 2.0f - 1.0f, 1.0f - (local_y / vp_h) * 2.0f);
+}
+
 void ViewportPanel::handlePicking(bool image_clicked, entt::registry& registry,
-                                  entt::entity& selected, IRenderAPI* render_api,
-                                  SceneBVH& bvh)
+                                  entt::entity& selected, std::vector<entt::entity>& selection,
+                                  IRenderAPI* render_api, SceneBVH& bvh)
 {
-    // Only pick on left-click on the viewport image, and not when clicking the gizmo
-    if (!image_clicked)
-        return;
-    if (ImGuizmo::IsOver())
+    // Pixels the mouse must travel before a press becomes a marquee drag
+    constexpr float kMarqueeDragThreshold = 4.0f;
+
+    // Start on left-click on the viewport image, but not when clicking the gizmo
+    if (image_clicked && !ImGuizmo::IsOver())
+    {
+        m_marquee_pending = true;
+        m_marquee_start = ImGui::GetMousePos();
+    }
+    if (!m_marquee_pending)
         return;
 
-    // Get mouse position relative to the viewport image
-    ImVec2 mouse = ImGui::GetMousePos();
-    float local_x = mouse.x - m_image_min.x;
-    float local_y = mouse.y - m_image_min.y;
     float vp_w = m_image_max.x - m_image_min.x;
     float vp_h = m_image_max.y - m_image_min.y;
-
     if (vp_w <= 0.0f || vp_h <= 0.0f)
+    {
+        m_marquee_pending = false;
         return;
+    }
 
-    // Convert to normalized device coordinates [-1, 1]
-    float ndc_x = (local_x / vp_w) * 2.0f - 1.0f;
-    float ndc_y = 1.0f - (local_y / vp_h) * 2.0f; // flip Y (screen Y is down, NDC Y is up)
-
-    // Get the render API's matrices (same ones used to render the scene)
-    glm::mat4 view = render_api->getViewMatrix();
-    glm::mat4 projection = render_api->getProjectionMatrix();
+    // Clamp the drag to the image so the marquee never leaves the viewport
+    ImVec2 mouse = ImGui::GetMousePos();
+    mouse.x = glm::clamp(mouse.x, m_image_min.x, m_image_max.x);
+    mouse.y = glm::clamp(mouse.y, m_image_min.y, m_image_max.y);
+    const bool dragging = std::abs(mouse.x - m_marquee_start.x) > kMarqueeDragThreshold ||
+                          std::abs(mouse.y - m_marquee_start.y) > kMarqueeDragThreshold;
 
-    // Undo Vulkan Y-flip for unprojection
-    if (projection[1][1] < 0.0f)
-        projection[1][1] *= -1.0f;
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        if (dragging)
+        {
+            ImDrawList* dl = ImGui::GetWindowDrawList();
+            dl->AddRectFilled(m_marquee_start, mouse, IM_COL32(80, 140, 255, 40));
+            dl->AddRect(m_marquee_start, mouse, IM_COL32(80, 140, 255, 200), 0.0f, 0, 1.0f);
+        }
+        return;
+    }
 
-    glm::mat4 inv_vp = glm::inverse(projection * view);
+    // Released: resolve as a click or a marquee
+    m_marquee_pending = false;
+    const glm::mat4 view_projection = getPickingViewProjection(render_api);
 
-    // Unproject near and far points
-    glm::vec4 near_ndc(ndc_x, ndc_y, 0.0f, 1.0f);
-    glm::vec4 far_ndc(ndc_x, ndc_y, 1.0f, 1.0f);
+    if (!dragging)
+    {
+        glm::vec3 ray_origin;
+        glm::vec3 ray_dir;
+        ScenePicker::unprojectRay(view_projection, screenToNDC(m_marquee_start), ray_origin, ray_dir);
 
-    glm::vec4 near_world = inv_vp * near_ndc;
-    glm::vec4 far_world = inv_vp * far_ndc;
+        // Triangle-accurate pick; entt::null if nothing was hit (deselects)
+        selected = m_picker.pick(registry, bvh, ray_origin, ray_dir).entity;
+        selection.clear();
+        return;
+    }
 
-    // Perspective divide
-    near_world /= near_world.w;
-    far_world /= far_world.w;
+    const glm::vec2 a = screenToNDC(m_marquee_start);
+    const glm::vec2 b = screenToNDC(mouse);
+    m_picker.marqueeSelect(registry, bvh, view_projection, glm::min(a, b), glm::max(a, b), m_marquee_results);
 
-    glm::vec3 ray_origin = glm::vec3(near_world);
-    glm::vec3 ray_dir = glm::normalize(glm::vec3(far_world) - ray_origin);
+    // Shift extends the current selection
+    const bool additive = ImGui::GetIO().KeyShift;
+    if (additive && selected != entt::null)
+    {
+        if (selection.empty() || selection.front() != selected)
+            selection.assign(1, selected);
+        for (entt::entity e : m_marquee_results)
+        {
+            if (std::find(selection.begin(), selection.end(), e) == selection.end())
+                selection.push_back(e);
+        }
+    }
+    else
+    {
+        selection = m_marquee_results;
+    }
 
-    // Pick using BVH
-    entt::entity hit = bvh.rayPick(ray_origin, ray_dir);
-    selected = hit; // entt::null if nothing was hit (deselects)
+    selected = selection.empty() ? entt::null : selection.front();
 }
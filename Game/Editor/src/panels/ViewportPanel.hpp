@@ -2,14 +2,15 @@
 
 #include "imgui.h"
 #include "EditorState.hpp"
+#include "Graphics/ScenePicker.hpp"
 #include <entt/entt.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 
 class ToolbarPanel;
 class camera;
 class IRenderAPI;
-class SceneBVH;
 
 struct GizmoResult
 {
@@ -38,9 +39,13 @@ public:
 
     GizmoResult draw(ImTextureID scene_texture, EditorState& state,
                      entt::registry& registry, entt::entity& selected,
+                     std::vector<entt::entity>& selection,
                      camera& cam, IRenderAPI* render_api, SceneBVH& bvh,
                      bool* p_open = nullptr);
 
+    // Drop cached triangle BVHs (meshes are freed on level load)
+    void clearPickingCache() { m_picker.clear(); }
+
 private:
     // Gizmo drag-start detection
     bool m_was_using = false;
@@ -49,10 +54,21 @@ private:
     ImVec2 m_image_min = {0, 0};
     ImVec2 m_image_max = {0, 0};
 
+    // Click / marquee selection
+    ScenePicker m_picker;
+    bool m_marquee_pending = false;
+    ImVec2 m_marquee_start = {0, 0};
+    std::vector<entt::entity> m_marquee_results;
+
     void drawGizmo(EditorState& state, entt::registry& registry,
                    entt::entity selected, camera& cam, IRenderAPI* render_api,
                    GizmoResult& result);
 
     void handlePicking(bool image_clicked, entt::registry& registry,
-                       entt::entity& selected, IRenderAPI* render_api, SceneBVH& bvh);
+                       entt::entity& selected, std::vector<entt::entity>& selection,
+                       IRenderAPI* render_api, SceneBVH& bvh);
+
+    // Same matrices the scene was rendered with, Vulkan Y-flip undone
+    glm::mat4 getPickingViewProjection(IRenderAPI* render_api) const;
+    glm::vec2 screenToNDC(const ImVec2& screen) const;
 };
@@ -9,6 +9,7 @@
 #include "Utils/CrashHandler.hpp"
 #include "Utils/Log.hpp"
 #include "Utils/EnginePaths.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "Application.hpp"
 #include "world.hpp"
 #include "LevelManager.hpp"
@@ -34,9 +35,17 @@ static GameModuleLoader game_module;
 static ProjectManager project_manager;
 static LevelManager level_manager;
 static ReflectionRegistry reflection;
+static std::string memory_report_path;
+
+static void writeMemoryReport()
+{
+    if (!memory_report_path.empty() && !MemoryTracker::writeReport(memory_report_path.c_str()))
+        LOG_ENGINE_WARN("Failed to write memory report to {}", memory_report_path);
+}
 
 static void shutdown_server(int code)
 {
+    writeMemoryReport();
     if (game_module.isLoaded())
     {
         game_module.serverShutdown();
@@ -68,6 +77,16 @@ static uint16_t parsePort(int argc, char* argv[])
     return 0;
 }
 
+static std::string parseMemoryReportPath(int argc, char* argv[])
+{
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "--memory-report") == 0)
+            return argv[i + 1];
+    }
+    return "";
+}
+
 static std::string findGardenFile(const fs::path& dir)
 {
     if (!fs::exists(dir) || !fs::is_directory(dir))
@@ -132,7 +151,9 @@ int main(int argc, char* argv[])
     }
 
     // Initialize world and physics
-    _world = world();
+    PhysicsSystemSettings physics_settings;
+    physics_settings.layers = makePhysicsLayerSettings(project_manager.getDescriptor().physics_layers);
+    _world = world(physics_settings);
     _world.initializePhysics();
 
     registerEngineReflection(reflection);
@@ -201,8 +222,14 @@ int main(int argc, char* argv[])
 
     LOG_ENGINE_INFO("Server started successfully");
 
+    // Headless builds have no console to run mem_report in, so dump periodically instead
+    memory_report_path = parseMemoryReportPath(argc, argv);
+    if (!memory_report_path.empty())
+        LOG_ENGINE_INFO("Writing memory report to {}", memory_report_path);
+
     // Server loop
     Uint64 delta_last = SDL_GetTicks();
+    Uint64 last_memory_report = delta_last;
     bool running = true;
 
     while (running)
@@ -214,6 +241,13 @@ int main(int argc, char* argv[])
 
         _world.tickGameplayFramework(delta_time);
         game_module.serverUpdate(delta_time);
+        MemoryTracker::endFrame();
+
+        if (!memory_report_path.empty() && frame_start - last_memory_report >= 10000)
+        {
+            writeMemoryReport();
+            last_memory_report = frame_start;
+        }
 
         Uint64 frame_end_ns = SDL_GetTicksNS();
         app.lockFramerate(frame_start_ns, frame_end_ns);
@@ -2,13 +2,9 @@
 #include "UI/RmlUiManager.h"
 #include "Utils/Log.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 
-static void FormatFloat(char* buffer, size_t buffer_size, float v, int decimals = 1)
-{
-    snprintf(buffer, buffer_size, "%.*f", decimals, v);
-}
-
 bool GameHUD::initialize(const char* rmlPath)
 {
     RmlUiManager& rml = RmlUiManager::get();
@@ -21,22 +17,22 @@ bool GameHUD::initialize(const char* rmlPath)
 
     bool bound = true;
     bound &= rml.dataModelBindInt(m_model, "fps", 0);
-    bound &= rml.dataModelBindString(m_model, "pos_x", "0.0");
-    bound &= rml.dataModelBindString(m_model, "pos_y", "0.0");
-    bound &= rml.dataModelBindString(m_model, "pos_z", "0.0");
-    bound &= rml.dataModelBindString(m_model, "speed", "0.0");
+    bound &= rml.dataModelBindFloat(m_model, "pos_x", 0.0f, 1);
+    bound &= rml.dataModelBindFloat(m_model, "pos_y", 0.0f, 1);
+    bound &= rml.dataModelBindFloat(m_model, "pos_z", 0.0f, 1);
+    bound &= rml.dataModelBindFloat(m_model, "speed", 0.0f, 2);
     bound &= rml.dataModelBindBool(m_model, "grounded", false);
     bound &= rml.dataModelBindBool(m_model, "connected", false);
-    bound &= rml.dataModelBindString(m_model, "ping", "0");
+    bound &= rml.dataModelBindFloat(m_model, "ping", 0.0f, 0);
     bound &= rml.dataModelBindInt(m_model, "health", 100);
     bound &= rml.dataModelBindInt(m_model, "max_health", 100);
     bound &= rml.dataModelBindString(m_model, "ammo_text", "30 / 30");
     bound &= rml.dataModelBindString(m_model, "reserve_text", "90");
-    bound &= rml.dataModelBindString(m_model, "crosshair_gap", "12.0");
+    bound &= rml.dataModelBindFloat(m_model, "crosshair_gap", 12.0f, 1);
     bound &= rml.dataModelBindBool(m_model, "alive", true);
     bound &= rml.dataModelBindString(m_model, "death_timer", "");
-    bound &= rml.dataModelBindString(m_model, "kills", "0");
-    bound &= rml.dataModelBindString(m_model, "deaths", "0");
+    bound &= rml.dataModelBindInt(m_model, "kills", 0);
+    bound &= rml.dataModelBindInt(m_model, "deaths", 0);
     bound &= rml.dataModelBindString(m_model, "kill_feed", "");
     bound &= rml.dataModelBindBool(m_model, "reloading", false);
     if (!bound)
@@ -46,6 +42,28 @@ bool GameHUD::initialize(const char* rmlPath)
         return false;
     }
 
+    m_fps = rml.dataModelFindVariable(m_model, "fps");
+    m_pos_x = rml.dataModelFindVariable(m_model, "pos_x");
+    m_pos_y = rml.dataModelFindVariable(m_model, "pos_y");
+    m_pos_z = rml.dataModelFindVariable(m_model, "pos_z");
+    m_speed = rml.dataModelFindVariable(m_model, "speed");
+    m_grounded = rml.dataModelFindVariable(m_model, "grounded");
+    m_connected = rml.dataModelFindVariable(m_model, "connected");
+    m_ping = rml.dataModelFindVariable(m_model, "ping");
+    m_health = rml.dataModelFindVariable(m_model, "health");
+    m_max_health = rml.dataModelFindVariable(m_model, "max_health");
+    m_ammo_text = rml.dataModelFindVariable(m_model, "ammo_text");
+    m_reserve_text = rml.dataModelFindVariable(m_model, "reserve_text");
+    m_crosshair_gap = rml.dataModelFindVariable(m_model, "crosshair_gap");
+    m_alive = rml.dataModelFindVariable(m_model, "alive");
+    m_death_timer = rml.dataModelFindVariable(m_model, "death_timer");
+    m_kills = rml.dataModelFindVariable(m_model, "kills");
+    m_deaths = rml.dataModelFindVariable(m_model, "deaths");
+    m_kill_feed = rml.dataModelFindVariable(m_model, "kill_feed");
+    m_reloading = rml.dataModelFindVariable(m_model, "reloading");
+    m_last_ammo = m_last_max_ammo = m_last_reserve = m_last_max_reserve = -1;
+    m_last_death_tenths = -1;
+
     // Load document
     LOG_ENGINE_INFO("[HUD] Loading document: {}", rmlPath ? rmlPath : "");
     m_document = rml.loadDocument(rmlPath);
@@ -86,70 +104,62 @@ void GameHUD::update(float fps, const glm::vec3& position, float speed, bool gro
     if (!m_model)
         return;
 
+    // Each update is compared against the bound value; only changed variables are
+    // dirtied, and an unchanged HUD costs RmlUi nothing
     RmlUiManager& rml = RmlUiManager::get();
-    char pos_x[32];
-    char pos_y[32];
-    char pos_z[32];
-    char speed_text[32];
-    char ping_text[32];
-
-    FormatFloat(pos_x, sizeof(pos_x), position.x);
-    FormatFloat(pos_y, sizeof(pos_y), position.y);
-    FormatFloat(pos_z, sizeof(pos_z), position.z);
-    FormatFloat(speed_text, sizeof(speed_text), speed, 2);
-    FormatFloat(ping_text, sizeof(ping_text), ping, 0);
 
     // Debug info
-    rml.dataModelSetInt(m_model, "fps", (int)fps);
-    rml.dataModelSetString(m_model, "pos_x", pos_x);
-    rml.dataModelSetString(m_model, "pos_y", pos_y);
-    rml.dataModelSetString(m_model, "pos_z", pos_z);
-    rml.dataModelSetString(m_model, "speed", speed_text);
-    rml.dataModelSetBool(m_model, "grounded", grounded);
-    rml.dataModelSetBool(m_model, "connected", connected);
-    rml.dataModelSetString(m_model, "ping", ping_text);
+    rml.dataModelUpdateInt(m_model, m_fps, (int)fps);
+    rml.dataModelUpdateFloat(m_model, m_pos_x, position.x);
+    rml.dataModelUpdateFloat(m_model, m_pos_y, position.y);
+    rml.dataModelUpdateFloat(m_model, m_pos_z, position.z);
+    rml.dataModelUpdateFloat(m_model, m_speed, speed);
+    rml.dataModelUpdateBool(m_model, m_grounded, grounded);
+    rml.dataModelUpdateBool(m_model, m_connected, connected);
+    rml.dataModelUpdateFloat(m_model, m_ping, ping);
 
     // Combat info
-    rml.dataModelSetInt(m_model, "health", health);
-    rml.dataModelSetInt(m_model, "max_health", max_health);
-
-    char ammo_buf[32];
-    if (reloading) {
-        snprintf(ammo_buf, sizeof(ammo_buf), "RELOADING");
-    } else {
-        snprintf(ammo_buf, sizeof(ammo_buf), "%d / %d", ammo, max_ammo);
+    rml.dataModelUpdateInt(m_model, m_health, health);
+    rml.dataModelUpdateInt(m_model, m_max_health, max_health);
+
+    if (ammo != m_last_ammo || max_ammo != m_last_max_ammo || reloading != m_last_reloading) {
+        char ammo_buf[32];
+        if (reloading) {
+            snprintf(ammo_buf, sizeof(ammo_buf), "RELOADING");
+        } else {
+            snprintf(ammo_buf, sizeof(ammo_buf), "%d / %d", ammo, max_ammo);
+        }
+        rml.dataModelUpdateString(m_model, m_ammo_text, ammo_buf);
+        m_last_ammo = ammo;
+        m_last_max_ammo = max_ammo;
+        m_last_reloading = reloading;
     }
-    rml.dataModelSetString(m_model, "ammo_text", ammo_buf);
 
-    char reserve_buf[32];
-    snprintf(reserve_buf, sizeof(reserve_buf), "%d / %d", reserve_ammo, max_reserve_ammo);
-    rml.dataModelSetString(m_model, "reserve_text", reserve_buf);
+    if (reserve_ammo != m_last_reserve || max_reserve_ammo != m_last_max_reserve) {
+        char reserve_buf[32];
+        snprintf(reserve_buf, sizeof(reserve_buf), "%d / %d", reserve_ammo, max_reserve_ammo);
+        rml.dataModelUpdateString(m_model, m_reserve_text, reserve_buf);
+        m_last_reserve = reserve_ammo;
+        m_last_max_reserve = max_reserve_ammo;
+    }
 
-    char crosshair_gap_buf[32];
     const float crosshair_gap = std::clamp(8.0f + weapon_spread * 900.0f, 8.0f, 58.0f);
-    FormatFloat(crosshair_gap_buf, sizeof(crosshair_gap_buf), crosshair_gap, 1);
-    rml.dataModelSetString(m_model, "crosshair_gap", crosshair_gap_buf);
+    rml.dataModelUpdateFloat(m_model, m_crosshair_gap, crosshair_gap);
 
-    rml.dataModelSetBool(m_model, "alive", alive);
-    rml.dataModelSetBool(m_model, "reloading", reloading);
+    rml.dataModelUpdateBool(m_model, m_alive, alive);
+    rml.dataModelUpdateBool(m_model, m_reloading, reloading);
 
-    if (!alive && death_timer > 0.0f) {
+    const int death_tenths = (!alive && death_timer > 0.0f) ? (int)std::lround(death_timer * 10.0f) : 0;
+    if (death_tenths != m_last_death_tenths) {
         char timer_buf[32];
-        snprintf(timer_buf, sizeof(timer_buf), "Respawning in %.1f...", death_timer);
-        rml.dataModelSetString(m_model, "death_timer", timer_buf);
-    } else {
-        rml.dataModelSetString(m_model, "death_timer", "");
+        timer_buf[0] = '\0';
+        if (death_tenths > 0)
+            snprintf(timer_buf, sizeof(timer_buf), "Respawning in %.1f...", death_tenths / 10.0f);
+        rml.dataModelUpdateString(m_model, m_death_timer, timer_buf);
+        m_last_death_tenths = death_tenths;
     }
 
-    char kills_buf[16];
-    snprintf(kills_buf, sizeof(kills_buf), "%d", kills);
-    rml.dataModelSetString(m_model, "kills", kills_buf);
-
-    char deaths_buf[16];
-    snprintf(deaths_buf, sizeof(deaths_buf), "%d", deaths);
-    rml.dataModelSetString(m_model, "deaths", deaths_buf);
-
-    rml.dataModelSetString(m_model, "kill_feed", kill_feed.c_str());
-
-    rml.dataModelDirtyAll(m_model);
+    rml.dataModelUpdateInt(m_model, m_kills, kills);
+    rml.dataModelUpdateInt(m_model, m_deaths, deaths);
+    rml.dataModelUpdateString(m_model, m_kill_feed, kill_feed.c_str());
 }
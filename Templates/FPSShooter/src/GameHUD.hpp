@@ -1,5 +1,6 @@
 #pragma once
 
+#include "UI/RmlUiManager.h"
 #include <glm/glm.hpp>
 #include <cstdint>
 #include <string>
@@ -18,6 +19,37 @@ public:
                 const std::string& kill_feed, bool reloading, float weapon_spread);
 
 private:
+    using Var = RmlUiManager::DataVariable;
+
     void* m_document = nullptr;
     void* m_model = nullptr;
+
+    // Bound variable handles, looked up once in initialize()
+    Var m_fps = 0;
+    Var m_pos_x = 0;
+    Var m_pos_y = 0;
+    Var m_pos_z = 0;
+    Var m_speed = 0;
+    Var m_grounded = 0;
+    Var m_connected = 0;
+    Var m_ping = 0;
+    Var m_health = 0;
+    Var m_max_health = 0;
+    Var m_ammo_text = 0;
+    Var m_reserve_text = 0;
+    Var m_crosshair_gap = 0;
+    Var m_alive = 0;
+    Var m_death_timer = 0;
+    Var m_kills = 0;
+    Var m_deaths = 0;
+    Var m_kill_feed = 0;
+    Var m_reloading = 0;
+
+    // Inputs of the composed strings, so they are only formatted when they change
+    int32_t m_last_ammo = -1;
+    int32_t m_last_max_ammo = -1;
+    int32_t m_last_reserve = -1;
+    int32_t m_last_max_reserve = -1;
+    bool m_last_reloading = false;
+    int m_last_death_tenths = -1;
 };
@@ -25,6 +25,7 @@
 #include "Events/EngineEvents.hpp"
 #include "Timer/TimerSystem.hpp"
 #include "Debug/DebugDraw.hpp"
+#include "Decals/DecalSystem.hpp"
 #include "Audio/AudioSystem.hpp"
 #include "Animation/AnimationSystem.hpp"
 #include "Threading/JobSystem.hpp"
@@ -116,6 +117,85 @@ struct KillFeedEntry {
 };
 static std::vector<KillFeedEntry> g_kill_feed;
 
+// Impact decals: a two-cell atlas built at init, bullet hole on the left, blood on the right
+static constexpr uint32_t IMPACT_CELL_BULLET_HOLE = 0;
+static constexpr uint32_t IMPACT_CELL_BLOOD = 1;
+static DecalAtlas g_impact_atlas;
+
+static void createImpactAtlas(IRenderAPI* render_api)
+{
+    constexpr int CELL = 64;
+    std::vector<uint8_t> pixels(static_cast<size_t>(CELL * 2) * CELL * 4, 0);
+    for (int y = 0; y < CELL; ++y)
+    {
+        for (int x = 0; x < CELL; ++x)
+        {
+            const float u = (static_cast<float>(x) + 0.5f) / CELL * 2.0f - 1.0f;
+            const float v = (static_cast<float>(y) + 0.5f) / CELL * 2.0f - 1.0f;
+            const float r = std::sqrt(u * u + v * v);
+            const float angle = std::atan2(v, u);
+
+            // Dark hole with a lighter scorched ring
+            uint8_t* hole = &pixels[(static_cast<size_t>(y) * CELL * 2 + x) * 4];
+            const float hole_a = std::clamp((0.9f - r) * 6.0f, 0.0f, 1.0f);
+            const float shade = r < 0.3f ? 0.05f : 0.25f;
+            hole[0] = hole[1] = hole[2] = static_cast<uint8_t>(shade * 255.0f);
+            hole[3] = static_cast<uint8_t>(hole_a * 255.0f);
+
+            // Splat with a ragged edge
+            uint8_t* blood = &pixels[(static_cast<size_t>(y) * CELL * 2 + CELL + x) * 4];
+            const float edge = 0.6f + 0.15f * std::sin(angle * 7.0f) + 0.1f * std::sin(angle * 13.0f + 1.3f);
+            const float blood_a = std::clamp((edge - r) * 5.0f, 0.0f, 1.0f);
+            blood[0] = 110;
+            blood[1] = 8;
+            blood[2] = 8;
+            blood[3] = static_cast<uint8_t>(blood_a * 230.0f);
+        }
+    }
+
+    g_impact_atlas.texture = render_api->loadTextureFromMemory(pixels.data(), CELL * 2, CELL, 4);
+    g_impact_atlas.columns = 2;
+    g_impact_atlas.rows = 1;
+}
+
+static void spawnImpactDecal(const ShootResultMessage& msg)
+{
+    if (!g_services || !g_services->game_world || g_impact_atlas.texture == INVALID_TEXTURE)
+        return;
+
+    // Shots that hit nothing end at max range in the air
+    const glm::vec3 ray = msg.hit_position - msg.ray_origin;
+    const float distance = glm::length(ray);
+    const WeaponDef& weapon = getWeaponDef(static_cast<WeaponType>(msg.weapon_type));
+    if (distance < 1e-3f || distance >= weapon.range - 0.01f)
+        return;
+
+    DecalPool& decals = DecalSystem::pool(g_services->game_world->registry);
+    decals.setAtlas(g_impact_atlas);
+
+    DecalDesc desc;
+    desc.direction = ray / distance;
+    desc.rotation = std::fmod(distance * 97.0f, 6.2831853f);
+    if (msg.hit_entity_id != 0)
+    {
+        // Spatter whatever is just behind the victim
+        desc.position = msg.hit_position + desc.direction * 0.75f;
+        desc.size = glm::vec2(0.6f);
+        desc.depth = 1.5f;
+        desc.atlas_cell = IMPACT_CELL_BLOOD;
+        desc.lifetime = 20.0f;
+    }
+    else
+    {
+        desc.position = msg.hit_position;
+        desc.size = glm::vec2(0.08f);
+        desc.depth = 0.1f;
+        desc.atlas_cell = IMPACT_CELL_BULLET_HOLE;
+        desc.lifetime = 30.0f;
+    }
+    decals.spawn(desc);
+}
+
 static WeaponComponent makeLocalWeaponSnapshot()
 {
     WeaponComponent weapon;
@@ -176,6 +256,7 @@ GAME_API bool gardenGameInit(EngineServices* services)
                 ? glm::vec3(1.0f, 0.3f, 0.0f)
                 : glm::vec3(1.0f, 1.0f, 0.5f);
             DebugDraw::get().drawLine(msg.ray_origin, msg.hit_position, color, 0.15f);
+            spawnImpactDecal(msg);
             break;
         }
         case CombatMessageType::DAMAGE_EVENT: {
@@ -296,11 +377,23 @@ GAME_API bool gardenGameInit(EngineServices* services)
         }
     }
 
+    if (services->render_api)
+        createImpactAtlas(services->render_api);
+
     // Create player controller
     g_player_controller = std::make_unique<PlayerController>(
         services->input_manager ? std::shared_ptr<InputManager>(services->input_manager, [](InputManager*){}) : nullptr,
         services->game_world);
 
+    // Late-latched look turns at the same per-entity sensitivity as the simulated look
+    if (services->application)
+    {
+        services->application->getFramePacer().setCameraLatch([](camera& cam, float mouse_dx, float mouse_dy) {
+            if (g_player_controller)
+                g_player_controller->applyMouseLook(cam, mouse_dy, mouse_dx);
+        });
+    }
+
     return true;
 }
 
@@ -310,8 +403,23 @@ GAME_API void gardenGameShutdown()
     AudioSystem::get().shutdown();
     g_network.disconnect("Game closing");
     g_network.shutdown();
+    if (g_services && g_services->application)
+        g_services->application->getFramePacer().setCameraLatch({});
     g_player_controller.reset();
     g_hud.shutdown();
+    if (g_services && g_impact_atlas.texture != INVALID_TEXTURE)
+    {
+        DecalPool* decals = g_services->game_world
+            ? DecalSystem::findPool(g_services->game_world->registry)
+            : nullptr;
+        if (decals)
+            decals->clear();
+        g_services->render_api->deleteTexture(g_impact_atlas.texture);
+        // The pool outlives the module; don't leave it holding the deleted texture across a reload
+        if (decals)
+            decals->setAtlas({});
+        g_impact_atlas = {};
+    }
     g_services = nullptr;
 }
 
@@ -576,6 +684,10 @@ GAME_API void gardenGameUpdate(float delta_time)
     // Update animations
     AnimationSystem::update(game_world->registry, delta_time);
 
+    // Age and fade impact decals
+    if (DecalPool* decals = DecalSystem::findPool(game_world->registry))
+        decals->update(delta_time);
+
     // Update audio listener
     if (g_player_controller)
     {
@@ -171,7 +171,27 @@ static void sendWeaponState(uint16_t client_id, entt::entity player_entity, cons
 
     BitWriter writer;
     CombatSerializer::serialize(writer, msg);
-    g_server_network.sendReliableToClient(client_id, writer);
+    g_server_network.queueReliableToClient(client_id, writer);
+}
+
+// Tracers are cosmetic: only clients whose player is near the shot line receive them.
+constexpr float TRACER_RELEVANCE_DISTANCE = 80.0f;
+
+static bool isTracerRelevant(const world& w, const ClientInfo& client,
+                             const glm::vec3& ray_origin, const glm::vec3& hit_position)
+{
+    const entt::entity player = g_server_network.getEntityByNetworkId(client.player_entity_network_id);
+    if (!w.registry.valid(player) || !w.registry.all_of<TransformComponent>(player)) {
+        return true;
+    }
+
+    const glm::vec3 position = w.registry.get<TransformComponent>(player).position;
+    const glm::vec3 segment = hit_position - ray_origin;
+    const float length_sq = glm::dot(segment, segment);
+    const float t = length_sq > 0.000001f
+        ? std::clamp(glm::dot(position - ray_origin, segment) / length_sq, 0.0f, 1.0f)
+        : 0.0f;
+    return glm::distance(position, ray_origin + segment * t) <= TRACER_RELEVANCE_DISTANCE;
 }
 
 static uint32_t getLagCompensatedAimTick(uint32_t acknowledged_server_tick)
@@ -272,14 +292,12 @@ static void fireServerShot(
         dmg_msg.health_remaining = victim_health.health;
         dmg_msg.hit_position = best_hit_point;
 
+        // Send damage event to the victim, and to the attacker so they see hit confirmation
         BitWriter dmg_writer;
         CombatSerializer::serialize(dmg_writer, dmg_msg);
-        g_server_network.sendReliableToClient(best_hit_client_id, dmg_writer);
-
-        // Also send to attacker so they see hit confirmation
-        if (shooter_client_id != best_hit_client_id) {
-            g_server_network.sendReliableToClient(shooter_client_id, dmg_writer);
-        }
+        g_server_network.multicastReliable(dmg_writer, [&](uint16_t client_id, const ClientInfo&) {
+            return client_id == best_hit_client_id || client_id == shooter_client_id;
+        });
 
         LOG_ENGINE_TRACE("Player {} hit player {} for {} damage (hp: {})",
             shooter_client_id, best_hit_client_id, total_damage, victim_health.health);
@@ -299,12 +317,7 @@ static void fireServerShot(
 
             BitWriter death_writer;
             CombatSerializer::serialize(death_writer, death_msg);
-
-            for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-                const ClientInfo* client = g_server_network.getClientInfo(i);
-                if (client && client->peer)
-                    g_server_network.sendReliableToClient(i, death_writer);
-            }
+            g_server_network.multicastReliable(death_writer);
 
             LOG_ENGINE_INFO("Player {} killed by player {}", best_hit_client_id, shooter_client_id);
 
@@ -313,7 +326,7 @@ static void fireServerShot(
         }
     }
 
-    // Broadcast shoot result to all clients for visual effects (tracers)
+    // Shoot results only drive visual effects (tracers): unreliable, to clients near the shot
     ShootResultMessage result_msg;
     result_msg.shooter_client_id = shooter_client_id;
     result_msg.ray_origin = ray_origin;
@@ -323,12 +336,10 @@ static void fireServerShot(
 
     BitWriter result_writer;
     CombatSerializer::serialize(result_writer, result_msg);
-
-    for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-        const ClientInfo* client = g_server_network.getClientInfo(i);
-        if (client && client->peer)
-            g_server_network.sendReliableToClient(i, result_writer);
-    }
+    g_server_network.multicastUnreliable(result_writer, [&](uint16_t client_id, const ClientInfo& client) {
+        return client_id == shooter_client_id || client_id == best_hit_client_id ||
+            isTracerRelevant(*w, client, ray_origin, best_hit_point);
+    });
 }
 
 static void processWeaponInput(
@@ -410,12 +421,7 @@ static void respawnPlayer(uint16_t client_id, const glm::vec3& spawn_pos)
 
             BitWriter writer;
             CombatSerializer::serialize(writer, respawn_msg);
-
-            for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-                const ClientInfo* other = g_server_network.getClientInfo(i);
-                if (other && other->peer)
-                    g_server_network.sendReliableToClient(i, writer);
-            }
+            g_server_network.multicastReliable(writer);
 
             LOG_ENGINE_INFO("Player {} respawned at ({},{},{})", client_id, spawn_pos.x, spawn_pos.y, spawn_pos.z);
             break;
@@ -486,12 +492,7 @@ static void spawnPlayerForClient(uint16_t client_id)
 
     BitWriter writer;
     NetworkSerializer::serialize(writer, spawn_msg);
-
-    for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-        const ClientInfo* other_client = g_server_network.getClientInfo(i);
-        if (other_client && other_client->peer)
-            g_server_network.sendReliableToClient(i, writer);
-    }
+    g_server_network.multicastReliable(writer);
 
     // Send existing players to the new client
     auto view = w->registry.view<NetworkedEntity, TransformComponent, PlayerComponent>();
@@ -508,7 +509,7 @@ static void spawnPlayerForClient(uint16_t client_id)
 
         BitWriter existing_writer;
         NetworkSerializer::serialize(existing_writer, existing_msg);
-        g_server_network.sendReliableToClient(client_id, existing_writer);
+        g_server_network.queueReliableToClient(client_id, existing_writer);
     }
 
     LOG_ENGINE_INFO("Spawned player (net_id={}) for client {} at ({},{},{})",
@@ -531,13 +532,9 @@ static void despawnPlayerForClient(uint16_t client_id)
 
             BitWriter writer;
             NetworkSerializer::serialize(writer, despawn_msg);
-
-            for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-                if (i == client_id) continue;
-                const ClientInfo* other = g_server_network.getClientInfo(i);
-                if (other && other->peer)
-                    g_server_network.sendReliableToClient(i, writer);
-            }
+            g_server_network.multicastReliable(writer, [client_id](uint16_t other_id, const ClientInfo&) {
+                return other_id != client_id;
+            });
 
             g_server_network.unregisterEntity(entity);
             w->registry.destroy(entity);
@@ -658,12 +655,7 @@ GAME_API void gardenServerUpdate(float delta_time)
 
             BitWriter death_writer;
             CombatSerializer::serialize(death_writer, death_msg);
-
-            for (uint16_t i = 1; i < g_server_network.getNextClientId(); i++) {
-                const ClientInfo* client = g_server_network.getClientInfo(i);
-                if (client && client->peer)
-                    g_server_network.sendReliableToClient(i, death_writer);
-            }
+            g_server_network.multicastReliable(death_writer);
 
             g_game_rules.queueRespawn(net.owner_client_id);
         }
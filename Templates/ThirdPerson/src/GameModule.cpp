@@ -1,5 +1,6 @@
 #include "Plugin/GameModuleAPI.h"
 
+#include "Application.hpp"
 #include "GameSimulation.hpp"
 #include "InputManager.hpp"
 #include "Reflection/ReflectionRegistry.hpp"
@@ -26,11 +27,22 @@ GAME_API bool gardenGameInit(EngineServices* services)
     g_input_manager = services && services->input_manager
         ? std::shared_ptr<InputManager>(services->input_manager, [](InputManager*) {})
         : nullptr;
+
+    // Late-latched look turns at the same per-entity sensitivity as the simulated look
+    if (services && services->application)
+    {
+        services->application->getFramePacer().setCameraLatch([](camera& cam, float mouse_dx, float mouse_dy) {
+            if (PlayerController* controller = g_simulation ? g_simulation->getPlayerController() : nullptr)
+                controller->applyMouseLook(cam, mouse_dy, mouse_dx);
+        });
+    }
     return true;
 }
 
 GAME_API void gardenGameShutdown()
 {
+    if (g_services && g_services->application)
+        g_services->application->getFramePacer().setCameraLatch({});
     g_simulation.reset();
     g_input_manager.reset();
     g_services = nullptr;
@@ -0,0 +1,361 @@
+#include "Audio/AudioOcclusion.hpp"
+#include "Audio/AudioSystem.hpp"
+#include "Components/Components.hpp"
+#include "PhysicsSystem.hpp"
+#include "Utils/Log.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static bool approx(float a, float b, float epsilon = 0.02f)
+{
+    return std::abs(a - b) <= epsilon;
+}
+
+static bool fail(const std::string& name, const std::string& reason)
+{
+    std::cerr << "[FAIL] " << name << ": " << reason << std::endl;
+    return false;
+}
+
+static bool pass(const std::string& name)
+{
+    std::cout << "[PASS] " << name << std::endl;
+    return true;
+}
+
+static void run(const std::string& name)
+{
+    std::cout << "[RUN] " << name << std::endl;
+}
+
+static void appendLe16(std::vector<std::uint8_t>& out, std::uint16_t value)
+{
+    out.push_back(static_cast<std::uint8_t>(value & 0xff));
+    out.push_back(static_cast<std::uint8_t>((value >> 8) & 0xff));
+}
+
+static void appendLe32(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out.push_back(static_cast<std::uint8_t>((value >> (i * 8)) & 0xff));
+}
+
+// One second of a 440 Hz mono tone, 16-bit PCM
+static bool writeTestToneWav(const fs::path& path)
+{
+    const std::uint32_t sample_rate = 44100;
+    const std::uint32_t frames = sample_rate;
+    const std::uint32_t data_size = frames * 2;
+
+    std::vector<std::uint8_t> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    appendLe32(bytes, 36 + data_size);
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    appendLe32(bytes, 16);
+    appendLe16(bytes, 1);  // PCM
+    appendLe16(bytes, 1);  // mono
+    appendLe32(bytes, sample_rate);
+    appendLe32(bytes, sample_rate * 2);
+    appendLe16(bytes, 2);
+    appendLe16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    appendLe32(bytes, data_size);
+    for (std::uint32_t i = 0; i < frames; ++i)
+    {
+        const float s = std::sin(2.0f * 3.14159265f * 440.0f * static_cast<float>(i) / sample_rate);
+        appendLe16(bytes, static_cast<std::uint16_t>(static_cast<std::int16_t>(s * 8000.0f)));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+// Scripted level: a wall in the plane x = 5 spanning |z| < 2
+static bool scriptedWallBlocks(const glm::vec3& from, const glm::vec3& to)
+{
+    if ((from.x - 5.0f) * (to.x - 5.0f) >= 0.0f)
+        return false;
+    const float t = (5.0f - from.x) / (to.x - from.x);
+    const float z = from.z + (to.z - from.z) * t;
+    return std::abs(z) < 2.0f;
+}
+
+static AudioOcclusion::BatchQueryFn makeScriptedQuery(uint32_t* rays_seen)
+{
+    return [rays_seen](const glm::vec3* from, const glm::vec3* to, size_t count, uint8_t* out_blocked)
+    {
+        for (size_t i = 0; i < count; ++i)
+            out_blocked[i] = scriptedWallBlocks(from[i], to[i]) ? 1 : 0;
+        if (rays_seen)
+            *rays_seen += static_cast<uint32_t>(count);
+    };
+}
+
+static bool testOcclusionRespectsQueryBudget()
+{
+    const std::string name = "occlusion respects per-frame query budget";
+
+    uint32_t rays_seen = 0;
+    AudioOcclusion occlusion;
+    AudioOcclusionSettings settings;
+    settings.max_voices_per_frame = 8;
+    settings.async = false;
+    occlusion.setSettings(settings);
+    occlusion.setQuery(makeScriptedQuery(&rays_seen));
+
+    std::vector<AudioOcclusionVoice> voices;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        AudioOcclusionVoice voice;
+        voice.id = i + 1;
+        voice.position = glm::vec3(2.0f + static_cast<float>(i % 10), 0.0f, static_cast<float>(i / 10) - 2.0f);
+        voices.push_back(voice);
+    }
+    // Out of range: never queried
+    AudioOcclusionVoice far_voice;
+    far_voice.id = 1000;
+    far_voice.position = glm::vec3(500.0f, 0.0f, 0.0f);
+    voices.push_back(far_voice);
+
+    const float dt = 1.0f / 60.0f;
+    for (int frame = 0; frame < 6; ++frame)
+    {
+        rays_seen = 0;
+        occlusion.update(glm::vec3(0.0f), voices, dt);
+        const AudioOcclusionStats& stats = occlusion.getStats();
+        if (stats.voices_queried > 8)
+            return fail(name, "frame " + std::to_string(frame) + " queried " + std::to_string(stats.voices_queried) + " voices");
+        if (stats.rays_cast != stats.voices_queried * 3 || rays_seen != stats.rays_cast)
+            return fail(name, "ray count does not match queried voices");
+        if (stats.voices_considered != 40)
+            return fail(name, "out-of-range voice was considered");
+    }
+
+    for (const AudioOcclusionVoice& voice : voices)
+    {
+        const AudioOcclusionState* state = occlusion.getState(voice.id);
+        if (!state)
+            return fail(name, "voice " + std::to_string(voice.id) + " has no state");
+        if (voice.id != far_voice.id && !state->has_result)
+            return fail(name, "voice " + std::to_string(voice.id) + " was starved");
+        if (voice.id == far_voice.id && state->has_result)
+            return fail(name, "out-of-range voice was queried");
+    }
+
+    return pass(name);
+}
+
+static bool testOcclusionPrioritizesNearVoices()
+{
+    const std::string name = "occlusion queries near voices first";
+
+    AudioOcclusion occlusion;
+    AudioOcclusionSettings settings;
+    settings.max_voices_per_frame = 1;
+    settings.async = false;
+    occlusion.setSettings(settings);
+    occlusion.setQuery(makeScriptedQuery(nullptr));
+
+    AudioOcclusionVoice far_voice;
+    far_voice.id = 1;
+    far_voice.position = glm::vec3(0.0f, 0.0f, 30.0f);
+    AudioOcclusionVoice near_voice;
+    near_voice.id = 2;
+    near_voice.position = glm::vec3(0.0f, 0.0f, 3.0f);
+
+    occlusion.update(glm::vec3(0.0f), {far_voice, near_voice}, 1.0f / 60.0f);
+    occlusion.flush();
+    if (!occlusion.getState(near_voice.id)->has_result || occlusion.getState(far_voice.id)->has_result)
+        return fail(name, "far voice was queried before the near one");
+
+    return pass(name);
+}
+
+static bool testOcclusionClassifiesPaths()
+{
+    const std::string name = "occlusion classifies clear, obstructed and occluded paths";
+
+    AudioOcclusion occlusion;
+    AudioOcclusionSettings settings;
+    settings.async = false;
+    occlusion.setSettings(settings);
+    occlusion.setQuery(makeScriptedQuery(nullptr));
+
+    AudioOcclusionVoice clear_voice;
+    clear_voice.id = 1;
+    clear_voice.position = glm::vec3(3.0f, 0.0f, 0.0f);  // In front of the wall
+    AudioOcclusionVoice obstructed_voice;
+    obstructed_voice.id = 2;
+    obstructed_voice.position = glm::vec3(10.0f, 0.0f, 3.6f);  // Behind the edge: one side path open
+    AudioOcclusionVoice occluded_voice;
+    occluded_voice.id = 3;
+    occluded_voice.position = glm::vec3(10.0f, 0.0f, 0.0f);  // Behind the middle
+    const std::vector<AudioOcclusionVoice> voices = {clear_voice, obstructed_voice, occluded_voice};
+
+    // Let the smoothing settle
+    for (int frame = 0; frame < 120; ++frame)
+        occlusion.update(glm::vec3(0.0f), voices, 1.0f / 60.0f);
+
+    const AudioOcclusionState* clear = occlusion.getState(clear_voice.id);
+    const AudioOcclusionState* obstructed = occlusion.getState(obstructed_voice.id);
+    const AudioOcclusionState* occluded = occlusion.getState(occluded_voice.id);
+
+    if (!approx(clear->target, 0.0f) || !approx(clear->gain, 1.0f) || !approx(clear->cutoff_hz, settings.max_cutoff_hz, 1.0f))
+        return fail(name, "clear voice is attenuated");
+    if (!approx(obstructed->target, AudioOcclusion::occlusionFromRays(true, 1)))
+        return fail(name, "obstructed voice target " + std::to_string(obstructed->target));
+    if (!approx(occluded->target, 1.0f) || !approx(occluded->occlusion, 1.0f))
+        return fail(name, "occluded voice target " + std::to_string(occluded->target));
+    if (!approx(occluded->gain, settings.occluded_gain) || !approx(occluded->cutoff_hz, settings.min_cutoff_hz, 5.0f))
+        return fail(name, "occluded voice gain/cutoff not at the occluded limits");
+    if (!(obstructed->gain < clear->gain && obstructed->gain > occluded->gain))
+        return fail(name, "obstructed gain is not between clear and occluded");
+    if (!(obstructed->cutoff_hz < clear->cutoff_hz && obstructed->cutoff_hz > occluded->cutoff_hz))
+        return fail(name, "obstructed cutoff is not between clear and occluded");
+
+    return pass(name);
+}
+
+static bool testOcclusionSmoothsChanges()
+{
+    const std::string name = "occlusion smooths changes";
+
+    AudioOcclusion occlusion;
+    AudioOcclusionSettings settings;
+    settings.async = false;
+    settings.smoothing_time = 0.1f;
+    occlusion.setSettings(settings);
+    occlusion.setQuery(makeScriptedQuery(nullptr));
+
+    AudioOcclusionVoice voice;
+    voice.id = 1;
+    voice.position = glm::vec3(10.0f, 0.0f, 0.0f);
+
+    // First update kicks the batch, the second applies it and starts moving
+    occlusion.update(glm::vec3(0.0f), {voice}, 1.0f / 60.0f);
+    occlusion.update(glm::vec3(0.0f), {voice}, 1.0f / 60.0f);
+    const float first = occlusion.getState(voice.id)->occlusion;
+    if (first <= 0.0f || first >= 0.5f)
+        return fail(name, "occlusion jumped to " + std::to_string(first));
+
+    return pass(name);
+}
+
+// Three voices around a static wall in a physics world, through AudioSystem on the null device
+static bool testAudioSystemOcclusionAgainstPhysics(const fs::path& wav_path)
+{
+    const std::string name = "audio system occlusion against physics";
+
+    AudioSystemConfig config;
+    config.null_device = true;
+    if (!AudioSystem::get().initialize(config))
+        return fail(name, "failed to initialize audio on the null device");
+
+    world w;
+    w.initializePhysics();
+
+    ColliderComponent col;
+    col.shape_type = ColliderShapeType::Box;
+    col.box_half_extents = glm::vec3(0.25f, 4.0f, 2.0f);
+    auto wall = w.registry.create();
+    w.registry.emplace<TransformComponent>(wall);
+    if (w.getPhysicsSystem().createStaticBody(glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(0.0f),
+            PhysicsSystem::createShapeFromCollider(col, glm::vec3(1.0f)), wall).IsInvalid())
+        return fail(name, "failed to create wall body");
+
+    PhysicsSystem* physics = &w.getPhysicsSystem();
+    AudioSystem& audio = AudioSystem::get();
+    audio.setOcclusionQuery([physics](const glm::vec3* from, const glm::vec3* to, size_t count, uint8_t* out_blocked)
+        { physics->castLineOfSightBatch(from, to, count, out_blocked); });
+
+    AudioOcclusionSettings settings = audio.getOcclusionSettings();
+    settings.max_voices_per_frame = 2;
+    audio.setOcclusionSettings(settings);
+
+    AudioClipId clip = audio.loadClip(wav_path.string());
+    Play3DParams params;
+    params.loop = true;
+    SoundHandle clear = audio.playSound3D(clip, glm::vec3(3.0f, 0.0f, 0.0f), params);
+    SoundHandle obstructed = audio.playSound3D(clip, glm::vec3(10.0f, 0.0f, 3.6f), params);
+    SoundHandle occluded = audio.playSound3D(clip, glm::vec3(10.0f, 0.0f, 0.0f), params);
+    params.occlusion = false;
+    SoundHandle unfiltered = audio.playSound3D(clip, glm::vec3(10.0f, 0.0f, 0.0f), params);
+    if (clear == INVALID_SOUND || obstructed == INVALID_SOUND || occluded == INVALID_SOUND || unfiltered == INVALID_SOUND)
+        return fail(name, "failed to start sounds");
+
+    audio.setListenerPosition(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    bool ok = true;
+    for (int frame = 0; frame < 120 && ok; ++frame)
+    {
+        audio.update(1.0f / 60.0f);
+        if (audio.getOcclusionStats().rays_cast > 2 * 3)
+            ok = fail(name, "frame " + std::to_string(frame) + " cast " + std::to_string(audio.getOcclusionStats().rays_cast) + " rays");
+    }
+
+    AudioOcclusionState clear_state, obstructed_state, occluded_state, unfiltered_state;
+    if (ok && (!audio.getSoundOcclusion(clear, clear_state) || !audio.getSoundOcclusion(obstructed, obstructed_state) ||
+               !audio.getSoundOcclusion(occluded, occluded_state)))
+        ok = fail(name, "missing occlusion state");
+    if (ok && audio.getSoundOcclusion(unfiltered, unfiltered_state))
+        ok = fail(name, "unfiltered sound is tracked by occlusion");
+    if (ok && (!approx(clear_state.target, 0.0f) || !approx(audio.getSoundOcclusionGain(clear), 1.0f)))
+        ok = fail(name, "clear sound is attenuated");
+    if (ok && !approx(obstructed_state.target, AudioOcclusion::occlusionFromRays(true, 1)))
+        ok = fail(name, "obstructed target " + std::to_string(obstructed_state.target));
+    if (ok && (!approx(occluded_state.target, 1.0f) || !approx(audio.getSoundOcclusionGain(occluded), settings.occluded_gain)))
+        ok = fail(name, "occluded gain " + std::to_string(audio.getSoundOcclusionGain(occluded)));
+    if (ok && !approx(audio.getSoundOcclusionGain(unfiltered), 1.0f))
+        ok = fail(name, "unfiltered sound is attenuated");
+
+    // Disabling occlusion fades every voice back to clear
+    settings.enabled = false;
+    audio.setOcclusionSettings(settings);
+    for (int frame = 0; frame < 120 && ok; ++frame)
+        audio.update(1.0f / 60.0f);
+    if (ok && !approx(audio.getSoundOcclusionGain(occluded), 1.0f))
+        ok = fail(name, "disabled occlusion left gain at " + std::to_string(audio.getSoundOcclusionGain(occluded)));
+
+    audio.setOcclusionQuery(nullptr);
+    audio.shutdown();
+    return ok ? pass(name) : false;
+}
+
+int main()
+{
+    EE::CLog::Init();
+
+    const fs::path wav_path = fs::temp_directory_path() / "audio_tests_tone.wav";
+    if (!writeTestToneWav(wav_path))
+    {
+        std::cerr << "[FAIL] could not write " << wav_path << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    run("occlusion respects per-frame query budget");
+    ok = testOcclusionRespectsQueryBudget() && ok;
+    run("occlusion queries near voices first");
+    ok = testOcclusionPrioritizesNearVoices() && ok;
+    run("occlusion classifies clear, obstructed and occluded paths");
+    ok = testOcclusionClassifiesPaths() && ok;
+    run("occlusion smooths changes");
+    ok = testOcclusionSmoothsChanges() && ok;
+    run("audio system occlusion against physics");
+    ok = testAudioSystemOcclusionAgainstPhysics(wav_path) && ok;
+
+    fs::remove(wav_path);
+    EE::CLog::Shutdown();
+    return ok ? 0 : 1;
+}
@@ -6,8 +6,11 @@
 #include "LevelManager.hpp"
 #include "Reflection/EngineReflection.hpp"
 #include "Reflection/ReflectionRegistry.hpp"
+#include "Scene/TransformHierarchy.hpp"
+#include "Threading/JobSystem.hpp"
 #include "world.hpp"
 
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <memory>
@@ -578,6 +581,328 @@ bool testClientWorldCreatesOnlyGameState()
     return pass(name);
 }
 
+entt::entity createPositioned(world& game_world, const glm::vec3& position)
+{
+    entt::entity entity = game_world.registry.create();
+    game_world.registry.emplace<TransformComponent>(entity, position.x, position.y, position.z);
+    return entity;
+}
+
+glm::vec3 worldPosition(const world& game_world, entt::entity entity)
+{
+    return game_world.registry.get<TransformComponent>(entity).position;
+}
+
+bool testTransformHierarchyPropagatesDirtySubtrees()
+{
+    const std::string name = "transform hierarchy propagates dirty subtrees";
+
+    world game_world;
+    TransformHierarchy& hierarchy = game_world.getTransformHierarchy();
+    entt::entity vehicle = createPositioned(game_world, glm::vec3(10.0f, 0.0f, 0.0f));
+    entt::entity turret = createPositioned(game_world, glm::vec3(0.0f, 2.0f, 0.0f));
+    entt::entity barrel = createPositioned(game_world, glm::vec3(0.0f, 0.0f, 3.0f));
+    entt::entity bystander = createPositioned(game_world, glm::vec3(-5.0f, 0.0f, 0.0f));
+
+    if (!game_world.setParent(turret, vehicle, false) || !game_world.setParent(barrel, turret, false))
+        return fail(name, "setParent rejected a valid attachment");
+    if (game_world.setParent(vehicle, barrel))
+        return fail(name, "setParent accepted a cycle");
+
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().nodes != 3 || hierarchy.getStats().levels != 3)
+        return fail(name, "bystander joined the hierarchy or depth levels are wrong");
+    if (!approxVec3(worldPosition(game_world, barrel), glm::vec3(10.0f, 2.0f, 3.0f)))
+        return fail(name, "grandchild world position not composed from its parents");
+    if (game_world.registry.get<HierarchyComponent>(barrel).depth != 2)
+        return fail(name, "grandchild depth not recorded");
+
+    // Yaw the turret a quarter turn: the barrel swings around it
+    game_world.registry.get<LocalTransformComponent>(turret).rotation.y = 90.0f;
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().updated != 2)
+        return fail(name, "expected turret and barrel to update, got " + std::to_string(hierarchy.getStats().updated));
+    if (!approxVec3(worldPosition(game_world, barrel), glm::vec3(13.0f, 2.0f, 0.0f)))
+        return fail(name, "child rotation not applied to grandchild");
+    if (!approx(game_world.registry.get<TransformComponent>(barrel).rotation.y, 90.0f))
+        return fail(name, "world rotation not written back to the grandchild");
+
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().updated != 0)
+        return fail(name, "clean hierarchy recomputed transforms");
+
+    // Physics and game code move roots through TransformComponent
+    game_world.registry.get<TransformComponent>(vehicle).position.x = 20.0f;
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().updated != 3)
+        return fail(name, "moving the root did not update the whole subtree");
+    if (!approxVec3(worldPosition(game_world, barrel), glm::vec3(23.0f, 2.0f, 0.0f)))
+        return fail(name, "subtree did not follow the root");
+
+    TransformHierarchy::markDirty(game_world.registry, barrel);
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().updated != 1)
+        return fail(name, "markDirty did not force exactly one node");
+
+    if (!approxVec3(worldPosition(game_world, bystander), glm::vec3(-5.0f, 0.0f, 0.0f)))
+        return fail(name, "unparented entity was touched");
+
+    return pass(name);
+}
+
+bool testTransformHierarchyReparentWhileDirty()
+{
+    const std::string name = "transform hierarchy reparent while dirty";
+
+    world game_world;
+    entt::entity player = createPositioned(game_world, glm::vec3(0.0f));
+    entt::entity platform = createPositioned(game_world, glm::vec3(100.0f, 0.0f, 0.0f));
+    entt::entity weapon = createPositioned(game_world, glm::vec3(1.0f, 1.0f, 0.0f));
+    entt::entity light = createPositioned(game_world, glm::vec3(1.0f, 1.5f, 0.0f));
+    entt::entity holster = createPositioned(game_world, glm::vec3(0.0f, 1.0f, 0.0f));
+
+    game_world.setParent(weapon, player);
+    game_world.setParent(light, weapon);
+    game_world.setParent(holster, player);
+    game_world.propagateTransforms();
+
+    // Dirty the old parent and the moving subtree, then reparent before propagating
+    game_world.registry.get<TransformComponent>(player).position = glm::vec3(0.0f, 0.0f, 50.0f);
+    game_world.registry.get<LocalTransformComponent>(weapon).position = glm::vec3(2.0f, 1.0f, 0.0f);
+    if (!game_world.setParent(weapon, platform, false))
+        return fail(name, "reparent failed");
+    game_world.propagateTransforms();
+
+    if (TransformHierarchy::getParent(game_world.registry, weapon) != platform)
+        return fail(name, "weapon not attached to the platform");
+    if (!approxVec3(worldPosition(game_world, weapon), glm::vec3(102.0f, 1.0f, 0.0f)))
+        return fail(name, "reparented child did not keep its edited local offset");
+    if (!approxVec3(worldPosition(game_world, light), glm::vec3(102.0f, 1.5f, 0.0f)))
+        return fail(name, "grandchild did not move with its reparented parent");
+    if (!approxVec3(worldPosition(game_world, holster), glm::vec3(0.0f, 1.0f, 50.0f)))
+        return fail(name, "remaining sibling missed the old parent's move");
+    if (TransformHierarchy::getChildren(game_world.registry, player).size() != 1)
+        return fail(name, "old parent still links the reparented child");
+
+    // keep_world: attaching under a rotated, scaled parent leaves the child in place
+    TransformComponent& platform_transform = game_world.registry.get<TransformComponent>(platform);
+    platform_transform.rotation.y = 45.0f;
+    platform_transform.scale = glm::vec3(2.0f);
+    game_world.propagateTransforms();
+    const glm::vec3 before = worldPosition(game_world, holster);
+    game_world.setParent(holster, light, true);
+    game_world.propagateTransforms();
+    if (!approxVec3(worldPosition(game_world, holster), before))
+        return fail(name, "keep_world reparent moved the child");
+    if (game_world.registry.get<HierarchyComponent>(holster).depth != 3)
+        return fail(name, "depth not updated after reparent");
+
+    // The player lost its last child and leaves the hierarchy
+    if (game_world.registry.all_of<HierarchyComponent>(player))
+        return fail(name, "childless root kept its hierarchy node");
+
+    // Destroying a middle node orphans its children where they stand
+    const glm::vec3 light_before = worldPosition(game_world, light);
+    game_world.registry.destroy(weapon);
+    game_world.propagateTransforms();
+    if (TransformHierarchy::getParent(game_world.registry, light) != entt::null)
+        return fail(name, "child of a destroyed parent still has a parent");
+    if (!approxVec3(worldPosition(game_world, light), light_before))
+        return fail(name, "orphaned child moved");
+    if (!approxVec3(worldPosition(game_world, holster), before))
+        return fail(name, "orphaned grandchild moved");
+
+    game_world.registry.get<TransformComponent>(light).position.y += 1.0f;
+    game_world.propagateTransforms();
+    if (!approxVec3(worldPosition(game_world, holster), before + glm::vec3(0.0f, 1.0f, 0.0f)))
+        return fail(name, "orphan did not become a working root");
+
+    return pass(name);
+}
+
+bool testTransformHierarchyLinksHandAddedChildren()
+{
+    const std::string name = "transform hierarchy links hand-added children";
+
+    ReflectionRegistry reflection;
+    registerEngineReflection(reflection);
+    if (!reflection.findByName("HierarchyComponent"))
+        return fail(name, "HierarchyComponent was not registered");
+
+    world game_world;
+    entt::registry& registry = game_world.registry;
+    entt::entity vehicle = createPositioned(game_world, glm::vec3(10.0f, 0.0f, 0.0f));
+    entt::entity turret = createPositioned(game_world, glm::vec3(0.0f, 2.0f, 0.0f));
+    entt::entity hatch = createPositioned(game_world, glm::vec3(1.0f, 0.0f, 0.0f));
+    entt::entity trailer = createPositioned(game_world, glm::vec3(-20.0f, 0.0f, 0.0f));
+
+    // As the inspector or a level file would: only the parent is set
+    HierarchyComponent turret_node;
+    turret_node.parent = vehicle;
+    registry.emplace<HierarchyComponent>(turret, turret_node);
+    game_world.propagateTransforms();
+
+    std::vector<entt::entity> children = TransformHierarchy::getChildren(registry, vehicle);
+    if (children.size() != 1 || children[0] != turret)
+        return fail(name, "hand-added child not linked under its parent");
+    if (!approxVec3(worldPosition(game_world, turret), glm::vec3(10.0f, 2.0f, 0.0f)))
+        return fail(name, "hand-added child did not use its transform as the local offset");
+
+    // A second hand-added sibling next to one attached through setParent
+    game_world.setParent(hatch, turret, false);
+    entt::entity antenna = createPositioned(game_world, glm::vec3(0.0f, 1.0f, 0.0f));
+    HierarchyComponent antenna_node;
+    antenna_node.parent = turret;
+    registry.emplace<HierarchyComponent>(antenna, antenna_node);
+    game_world.propagateTransforms();
+    if (TransformHierarchy::getChildren(registry, turret).size() != 2)
+        return fail(name, "hand-added sibling not linked next to the existing child");
+    if (!approxVec3(worldPosition(game_world, antenna), glm::vec3(10.0f, 3.0f, 0.0f)))
+        return fail(name, "hand-added grandchild did not follow its parents");
+
+    registry.get<TransformComponent>(vehicle).position.x = 0.0f;
+    game_world.propagateTransforms();
+    if (!approxVec3(worldPosition(game_world, antenna), glm::vec3(0.0f, 3.0f, 0.0f)))
+        return fail(name, "hand-added subtree did not follow the root");
+
+    // Editing the parent field moves the child between sibling lists
+    registry.get<HierarchyComponent>(antenna).parent = trailer;
+    game_world.propagateTransforms();
+    if (TransformHierarchy::getChildren(registry, turret).size() != 1)
+        return fail(name, "old parent still links the re-parented child");
+    children = TransformHierarchy::getChildren(registry, trailer);
+    if (children.size() != 1 || children[0] != antenna)
+        return fail(name, "edited parent not linked");
+    if (!approxVec3(worldPosition(game_world, antenna), glm::vec3(-20.0f, 1.0f, 0.0f)))
+        return fail(name, "re-parented child did not follow its new parent");
+
+    // A hand-made cycle is broken instead of dropping the nodes from propagation
+    registry.get<HierarchyComponent>(vehicle).parent = hatch;
+    game_world.propagateTransforms();
+    const uint32_t rebuilds = game_world.getTransformHierarchy().getStats().rebuilds;
+    game_world.propagateTransforms();
+    if (game_world.getTransformHierarchy().getStats().rebuilds != rebuilds)
+        return fail(name, "cycle left the hierarchy rebuilding every frame");
+    if (game_world.getTransformHierarchy().getStats().nodes != registry.storage<HierarchyComponent>().size())
+        return fail(name, "nodes on the cycle were left out of propagation");
+    uint32_t roots = 0;
+    for (entt::entity entity : {vehicle, turret, hatch})
+    {
+        if (TransformHierarchy::getParent(registry, entity) == entt::null)
+            ++roots;
+    }
+    if (roots != 1)
+        return fail(name, "expected exactly one node on the cycle to be detached");
+
+    return pass(name);
+}
+
+double timePropagate(world& game_world, int iterations)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        game_world.propagateTransforms();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+bool benchmarkHierarchy(const std::string& name, world& game_world, const std::vector<entt::entity>& roots,
+                        uint32_t expected_nodes)
+{
+    TransformHierarchy& hierarchy = game_world.getTransformHierarchy();
+    game_world.propagateTransforms();
+    if (hierarchy.getStats().nodes != expected_nodes)
+        return fail(name, "unexpected node count " + std::to_string(hierarchy.getStats().nodes));
+
+    constexpr int ITERATIONS = 20;
+    const double clean_ms = timePropagate(game_world, ITERATIONS);
+    if (hierarchy.getStats().updated != 0)
+        return fail(name, "clean propagate recomputed transforms");
+
+    double all_ms = 0.0;
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        for (entt::entity root : roots)
+            game_world.registry.get<TransformComponent>(root).position.x += 1.0f;
+        all_ms += timePropagate(game_world, 1);
+    }
+    all_ms /= ITERATIONS;
+    if (hierarchy.getStats().updated != expected_nodes)
+        return fail(name, "moving every root did not update every node");
+
+    game_world.registry.get<TransformComponent>(roots.front()).position.y += 1.0f;
+    const double one_ms = timePropagate(game_world, 1);
+    const uint32_t one_updated = hierarchy.getStats().updated;
+    if (one_updated == 0 || (roots.size() > 1 && one_updated >= expected_nodes))
+        return fail(name, "moving one root did not limit work to its subtree");
+
+    std::cout << "  " << name << ": " << expected_nodes << " nodes, " << hierarchy.getStats().levels
+              << " levels | clean " << clean_ms << " ms, all dirty " << all_ms << " ms, one subtree ("
+              << one_updated << " nodes) " << one_ms << " ms" << std::endl;
+    return true;
+}
+
+bool testTransformHierarchyBenchmarks()
+{
+    const std::string name = "transform hierarchy benchmarks";
+
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    const bool owns_jobs = !jobs.isInitialized();
+    if (owns_jobs)
+        jobs.initialize();
+
+    bool ok = true;
+    {
+        // Deep: long chains, one node per level per chain (bones, cable segments)
+        world game_world;
+        constexpr int CHAINS = 64;
+        constexpr int DEPTH = 256;
+        std::vector<entt::entity> roots;
+        for (int c = 0; c < CHAINS; ++c)
+        {
+            entt::entity parent = createPositioned(game_world, glm::vec3(float(c), 0.0f, 0.0f));
+            roots.push_back(parent);
+            for (int d = 1; d < DEPTH; ++d)
+            {
+                entt::entity link = createPositioned(game_world, glm::vec3(0.0f, 0.1f, 0.0f));
+                game_world.setParent(link, parent, false);
+                parent = link;
+            }
+        }
+        ok = benchmarkHierarchy("deep", game_world, roots, CHAINS * DEPTH) && ok;
+    }
+    {
+        // Wide: many shallow attachment trees (props with lights, vehicles with parts)
+        world game_world;
+        constexpr int ROOTS = 2000;
+        constexpr int CHILDREN = 16;
+        constexpr int GRANDCHILDREN = 2;
+        std::vector<entt::entity> roots;
+        for (int r = 0; r < ROOTS; ++r)
+        {
+            entt::entity root = createPositioned(game_world, glm::vec3(float(r), 0.0f, 0.0f));
+            roots.push_back(root);
+            for (int c = 0; c < CHILDREN; ++c)
+            {
+                entt::entity child = createPositioned(game_world, glm::vec3(float(c), 1.0f, 0.0f));
+                game_world.setParent(child, root, false);
+                for (int g = 0; g < GRANDCHILDREN; ++g)
+                {
+                    entt::entity grandchild = createPositioned(game_world, glm::vec3(0.0f, 0.5f, float(g)));
+                    game_world.setParent(grandchild, child, false);
+                }
+            }
+        }
+        ok = benchmarkHierarchy("wide", game_world, roots, ROOTS * (1 + CHILDREN * (1 + GRANDCHILDREN))) && ok;
+    }
+
+    if (owns_jobs)
+        jobs.shutdown();
+
+    return ok ? pass(name) : false;
+}
+
 bool testGameModeRegistryCreatesBuiltins()
 {
     const std::string name = "game mode registry creates builtins";
@@ -607,5 +932,9 @@ int main()
     ok = testLevelMetadataAppliesGameplaySettings() && ok;
     ok = testProjectDefaultsResolveGameplayClasses() && ok;
     ok = testClientWorldCreatesOnlyGameState() && ok;
+    ok = testTransformHierarchyPropagatesDirtySubtrees() && ok;
+    ok = testTransformHierarchyReparentWhileDirty() && ok;
+    ok = testTransformHierarchyLinksHandAddedChildren() && ok;
+    ok = testTransformHierarchyBenchmarks() && ok;
     return ok ? 0 : 1;
 }
@@ -1,6 +1,8 @@
 #include "InputManager.hpp"
+#include "Timer/FramePacer.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
@@ -157,6 +159,142 @@ namespace
 
         return ok;
     }
+
+    struct PacingResult
+    {
+        double mean_latency_ms = 0.0;
+        double max_latency_ms = 0.0;
+        double fps = 0.0;
+    };
+
+    // Headless frame loop on a virtual clock. A 1 kHz mouse delivers
+    // timestamped motion events through the real SDL queue, the frame does
+    // cpu_ns of work split around a frame-fence wait, and a virtual GPU with
+    // two frames in flight (like the Vulkan/D3D12 backends) takes gpu_ns per
+    // frame. Latency is measured from event timestamp to queue submit.
+    PacingResult runPacedLoop(FramePacingMode mode, int target_fps, uint64_t cpu_ns, uint64_t gpu_ns)
+    {
+        const uint64_t start_ns = 1000000000ull;  // Non-zero so SDL keeps our timestamps
+        const uint64_t duration_ns = 3000000000ull;
+        const uint64_t event_interval_ns = 1000000ull;
+        uint64_t clock = start_ns;
+
+        FramePacer pacer;
+        pacer.setTimeSource([&clock]() { return clock; }, [&clock](uint64_t ns) { clock += ns; });
+        pacer.setMode(mode);
+        pacer.setTargetFPS(target_fps);
+
+        InputManager input;
+        input.clear_all_mappings();
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+        uint64_t gpu_done[2] = {};
+        uint64_t gpu_free = 0;
+        uint64_t next_event = start_ns;
+        uint64_t frames = 0;
+        uint64_t events = 0;
+        double latency_sum_ms = 0.0;
+        PacingResult result;
+
+        while (clock < start_ns + duration_ns)
+        {
+            pacer.beginFrame();
+
+            // The OS has delivered everything that happened up to now
+            for (; next_event <= clock; next_event += event_interval_ns)
+            {
+                SDL_Event event = makeMouseMotionEvent(1.0f, 0.0f);
+                event.motion.timestamp = next_event;
+                SDL_PushEvent(&event);
+            }
+
+            input.update();
+            std::vector<uint64_t> sampled;
+            SDL_Event event;
+            while (SDL_PollEvent(&event))
+            {
+                input.process_event(event);
+                if (event.type == SDL_EVENT_MOUSE_MOTION)
+                    sampled.push_back(event.motion.timestamp);
+            }
+            pacer.markInputSampled();
+
+            clock += cpu_ns / 2;  // Simulation
+            const size_t slot = frames % 2;
+            const uint64_t blocked_ns = gpu_done[slot] > clock ? gpu_done[slot] - clock : 0;
+            clock += blocked_ns;  // Frame fence for the slot being reused
+            clock += cpu_ns - cpu_ns / 2;  // Command recording
+
+            const uint64_t gpu_start = std::max(clock, gpu_free);
+            gpu_free = gpu_start + gpu_ns;
+            gpu_done[slot] = gpu_free;
+            pacer.markSubmitted(static_cast<float>(gpu_ns) / 1.0e6f, true, static_cast<float>(blocked_ns) / 1.0e6f);
+
+            // Skip the warm-up while the predictors converge
+            if (frames >= 30)
+            {
+                for (uint64_t timestamp : sampled)
+                {
+                    const double latency_ms = static_cast<double>(clock - timestamp) / 1.0e6;
+                    latency_sum_ms += latency_ms;
+                    result.max_latency_ms = std::max(result.max_latency_ms, latency_ms);
+                    events++;
+                }
+            }
+
+            pacer.endFrame();
+            frames++;
+        }
+
+        result.mean_latency_ms = events > 0 ? latency_sum_ms / static_cast<double>(events) : 0.0;
+        result.fps = static_cast<double>(frames) / (static_cast<double>(clock - start_ns) / 1.0e9);
+        return result;
+    }
+
+    bool testFramePacingLatency()
+    {
+        if (!SDL_Init(SDL_INIT_EVENTS))
+            return expect(false, "SDL event subsystem initializes for the pacing test");
+
+        struct Case
+        {
+            int target_fps;
+            uint64_t cpu_ns;
+            uint64_t gpu_ns;
+            bool gpu_bound;
+        };
+        const Case cases[] = {
+            { 30, 3000000, 10000000, false },
+            { 60, 3000000, 10000000, false },
+            { 144, 3000000, 10000000, true },
+            { 10000, 3000000, 10000000, true },  // fps_max 0
+            { 144, 3000000, 2000000, false },
+        };
+
+        bool ok = true;
+        for (const Case& c : cases)
+        {
+            const PacingResult legacy = runPacedLoop(FramePacingMode::EndOfFrame, c.target_fps, c.cpu_ns, c.gpu_ns);
+            const PacingResult paced = runPacedLoop(FramePacingMode::LowLatency, c.target_fps, c.cpu_ns, c.gpu_ns);
+
+            std::printf("  target_fps=%-5d gpu=%.1fms  end-of-frame: %6.2fms mean %6.2fms max %6.1f fps"
+                        "  low-latency: %6.2fms mean %6.2fms max %6.1f fps\n",
+                        c.target_fps, static_cast<double>(c.gpu_ns) / 1.0e6,
+                        legacy.mean_latency_ms, legacy.max_latency_ms, legacy.fps,
+                        paced.mean_latency_ms, paced.max_latency_ms, paced.fps);
+
+            ok = expect(paced.fps >= legacy.fps * 0.95, "low-latency pacing keeps the frame rate") && ok;
+            if (c.gpu_bound)
+                ok = expect(paced.mean_latency_ms < legacy.mean_latency_ms * 0.75,
+                            "low-latency pacing removes the fence wait when GPU bound") && ok;
+            else
+                ok = expect(paced.mean_latency_ms <= legacy.mean_latency_ms + 0.5,
+                            "low-latency pacing is no worse when frame-cap bound") && ok;
+        }
+
+        SDL_Quit();
+        return ok;
+    }
 }
 
 int main()
@@ -166,6 +304,7 @@ int main()
     ok = testMouseTransitions() && ok;
     ok = testActionDispatch() && ok;
     ok = testResetState() && ok;
+    ok = testFramePacingLatency() && ok;
 
     if (!ok)
         return 1;
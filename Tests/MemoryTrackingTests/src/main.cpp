@@ -0,0 +1,160 @@
+// Built with ENGINE_MEMORY_TRACKING: this executable installs the tracked global
+// operator new/delete, so every allocation below goes through MemoryTracker.
+#include "Utils/MemoryTracker.hpp"
+#include "Utils/TrackedNewDelete.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+static bool fail(const std::string& name, const std::string& reason)
+{
+    std::cerr << "[FAIL] " << name << ": " << reason << std::endl;
+    return false;
+}
+
+static bool pass(const std::string& name)
+{
+    std::cout << "[PASS] " << name << std::endl;
+    return true;
+}
+
+// Larger than any heap can provide; volatile so the compiler cannot fold the call
+static std::size_t impossibleSize()
+{
+    volatile std::size_t size = SIZE_MAX - 64;
+    return size;
+}
+
+static bool testNewAndDeleteAreTracked()
+{
+    const std::string name = "operator new/delete are charged to the current tag";
+    const MemoryTagStats before = MemoryTracker::getStats(MemoryTag::Gameplay);
+
+    std::vector<int>* values = nullptr;
+    {
+        MemoryTagScope scope(MemoryTag::Gameplay);
+        values = new std::vector<int>(1000, 7);
+    }
+    const MemoryTagStats during = MemoryTracker::getStats(MemoryTag::Gameplay);
+    delete values;
+    const MemoryTagStats after = MemoryTracker::getStats(MemoryTag::Gameplay);
+
+    if (during.total_allocations < before.total_allocations + 2)
+        return fail(name, "expected the vector and its storage to be counted");
+    if (during.current_bytes - before.current_bytes < static_cast<int64_t>(1000 * sizeof(int)))
+        return fail(name, "live bytes do not include the vector's storage");
+    if (after.current_bytes != before.current_bytes)
+        return fail(name, "delete did not return the bytes to the tag");
+    return pass(name);
+}
+
+static bool testAlignedNewIsTracked()
+{
+    const std::string name = "aligned operator new is tracked and aligned";
+    struct alignas(64) CacheLine { char bytes[64]; };
+
+    const MemoryTagStats before = MemoryTracker::getStats(MemoryTag::Rendering);
+    CacheLine* lines = nullptr;
+    {
+        MemoryTagScope scope(MemoryTag::Rendering);
+        lines = new CacheLine[4];
+    }
+    const bool aligned = reinterpret_cast<std::uintptr_t>(lines) % 64 == 0;
+    const MemoryTagStats during = MemoryTracker::getStats(MemoryTag::Rendering);
+    delete[] lines;
+    const MemoryTagStats after = MemoryTracker::getStats(MemoryTag::Rendering);
+
+    if (!aligned)
+        return fail(name, "block is not 64-byte aligned");
+    if (during.current_bytes - before.current_bytes < static_cast<int64_t>(4 * sizeof(CacheLine)))
+        return fail(name, "aligned block was not counted");
+    if (after.current_bytes != before.current_bytes)
+        return fail(name, "aligned delete did not return the bytes");
+    return pass(name);
+}
+
+static bool testFailedNewThrowsBadAlloc()
+{
+    const std::string name = "failed operator new throws std::bad_alloc";
+    bool plain = false;
+    bool aligned = false;
+    try
+    {
+        ::operator delete(::operator new(impossibleSize()));
+    }
+    catch (const std::bad_alloc&)
+    {
+        plain = true;
+    }
+    try
+    {
+        ::operator delete(::operator new(impossibleSize(), std::align_val_t{64}), std::align_val_t{64});
+    }
+    catch (const std::bad_alloc&)
+    {
+        aligned = true;
+    }
+
+    if (!plain)
+        return fail(name, "plain operator new did not throw");
+    if (!aligned)
+        return fail(name, "aligned operator new did not throw");
+    return pass(name);
+}
+
+static bool testNothrowNewReturnsNull()
+{
+    const std::string name = "nothrow operator new returns nullptr";
+    if (::operator new(impossibleSize(), std::nothrow) != nullptr)
+        return fail(name, "nothrow operator new returned a block");
+    if (::operator new[](impossibleSize(), std::nothrow) != nullptr)
+        return fail(name, "nothrow operator new[] returned a block");
+    if (::operator new(impossibleSize(), std::align_val_t{64}, std::nothrow) != nullptr)
+        return fail(name, "aligned nothrow operator new returned a block");
+    return pass(name);
+}
+
+static int g_new_handler_calls = 0;
+
+static bool testNewHandlerRunsBeforeThrowing()
+{
+    const std::string name = "operator new calls the new_handler before throwing";
+    g_new_handler_calls = 0;
+    std::set_new_handler([] {
+        // A real handler would free a reserve; this one gives up after one try
+        ++g_new_handler_calls;
+        std::set_new_handler(nullptr);
+    });
+
+    bool threw = false;
+    try
+    {
+        ::operator delete(::operator new(impossibleSize()));
+    }
+    catch (const std::bad_alloc&)
+    {
+        threw = true;
+    }
+    std::set_new_handler(nullptr);
+
+    if (g_new_handler_calls != 1)
+        return fail(name, "expected one new_handler call, got " + std::to_string(g_new_handler_calls));
+    if (!threw)
+        return fail(name, "operator new did not throw once the handler was removed");
+    return pass(name);
+}
+
+int main()
+{
+    bool ok = true;
+    ok = testNewAndDeleteAreTracked() && ok;
+    ok = testAlignedNewIsTracked() && ok;
+    ok = testFailedNewThrowsBadAlloc() && ok;
+    ok = testNothrowNewReturnsNull() && ok;
+    ok = testNewHandlerRunsBeforeThrowing() && ok;
+    return ok ? 0 : 1;
+}
@@ -1,7 +1,11 @@
 #include "Components/Components.hpp"
+#include "Console/ConVar.hpp"
 #include "Network/BitStream.hpp"
 #include "Network/ClientNetworkManager.hpp"
+#include "Network/ENetTransport.hpp"
+#include "Network/LocalTransport.hpp"
 #include "Network/NetworkProtocol.hpp"
+#include "Network/NetworkSerializer.hpp"
 #include "Network/NetworkTypes.hpp"
 #include "Network/ServerNetworkManager.hpp"
 #include "Utils/Log.hpp"
@@ -22,6 +26,8 @@ namespace {
 constexpr float kFixedDelta = 1.0f / 60.0f;
 constexpr uint8_t kReliableStressMessage = Net::CUSTOM_MESSAGE_START;
 constexpr uint8_t kUnreliableStressMessage = Net::CUSTOM_MESSAGE_START + 1;
+constexpr uint8_t kReliableEventMessage = Net::CUSTOM_MESSAGE_START + 2;
+constexpr uint8_t kCosmeticEventMessage = Net::CUSTOM_MESSAGE_START + 3;
 
 struct StressConfig
 {
@@ -31,6 +37,9 @@ struct StressConfig
     uint32_t reliable_interval_frames = 30;
     uint32_t unreliable_interval_frames = 5;
     uint16_t requested_port = 0;
+    uint32_t input_jitter_ms = 50;  // 0 skips the input jitter stress
+    uint32_t events_per_tick = 4;   // Server events per frame per channel; 0 skips the event traffic stress
+    bool transport_parity = true;   // Run the scripted match over ENet and LocalTransport and compare
     bool sleep_between_frames = true;
     bool verbose = false;
 };
@@ -90,6 +99,10 @@ static bool parseArgs(int argc, char** argv, StressConfig& config)
             config.verbose = true;
             continue;
         }
+        if (std::strcmp(arg, "--no-transport-parity") == 0) {
+            config.transport_parity = false;
+            continue;
+        }
 
         if (i + 1 >= argc) {
             std::cerr << "[FAIL] Missing value for " << arg << "\n";
@@ -112,6 +125,10 @@ static bool parseArgs(int argc, char** argv, StressConfig& config)
             config.reliable_interval_frames = value;
         } else if (std::strcmp(arg, "--unreliable-interval") == 0) {
             config.unreliable_interval_frames = value;
+        } else if (std::strcmp(arg, "--input-jitter") == 0) {
+            config.input_jitter_ms = value;
+        } else if (std::strcmp(arg, "--events-per-tick") == 0) {
+            config.events_per_tick = value;
         } else if (std::strcmp(arg, "--port") == 0) {
             config.requested_port = static_cast<uint16_t>(value);
         } else {
@@ -472,6 +489,714 @@ static bool runNetworkStress(const StressConfig& config)
     return true;
 }
 
+struct InputCorrectionResult
+{
+    uint64_t ticks = 0;        // Client ticks observed after warm-up
+    uint64_t corrections = 0;  // Ticks where a client's applied inputs did not match the ticks simulated
+    uint64_t synthesized = 0;
+    uint64_t merged = 0;
+};
+
+static void setCVar(const char* name, const std::string& value)
+{
+    if (ConVarBase* cvar = ConVarRegistry::get().find(name)) {
+        cvar->setFromString(value);
+    }
+}
+
+// One loopback session with net_fakejitter on every client. Without buffering, a late
+// burst applies several inputs in one tick and none in the ticks before it; each such
+// tick is a correction the client has to absorb.
+static bool measureInputCorrections(const StressConfig& config, bool buffered, InputCorrectionResult& out)
+{
+    constexpr uint32_t kWarmupFrames = 60;
+    const uint32_t client_count = (std::min)(config.client_count, 4u);
+
+    setCVar("sv_input_buffer", buffered ? "1" : "0");
+    setCVar("net_fakejitter", std::to_string(config.input_jitter_ms));
+
+    world server_world;
+    server_world.setFixedDelta(kFixedDelta);
+    Net::ServerNetworkManager server;
+    if (!server.initialize()) {
+        return false;
+    }
+    server.setWorld(&server_world);
+
+    std::vector<uint32_t> applied(client_count + 1, 0);
+    uint32_t connected = 0;
+    server.setOnClientConnected([&](uint16_t client_id) {
+        ++connected;
+        spawnServerPlayer(server_world, server, client_id);
+    });
+    server.setInputSampleHandler([&](uint16_t client_id, entt::entity, const Net::InputSample&, uint32_t) {
+        if (client_id < applied.size()) {
+            ++applied[client_id];
+        }
+    });
+
+    uint16_t port = 0;
+    if (!startServer(server, config, port)) {
+        server.shutdown();
+        return false;
+    }
+
+    std::vector<std::unique_ptr<StressClient>> clients;
+    for (uint32_t i = 0; i < client_count; ++i) {
+        std::unique_ptr<StressClient> client = std::make_unique<StressClient>();
+        const std::string name = "jitter_" + std::to_string(i + 1);
+        if (!client->manager.initialize() || !client->manager.connectToServer("127.0.0.1", port, name.c_str())) {
+            server.shutdown();
+            return false;
+        }
+        clients.push_back(std::move(client));
+    }
+
+    for (uint32_t frame = 0; frame < config.connect_frame_budget && connected < client_count; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+
+    bool ok = connected == client_count;
+    for (uint32_t frame = 0; ok && frame < config.frame_count + kWarmupFrames; ++frame) {
+        for (auto& client : clients) {
+            Net::InputState input;
+            input.move_forward = 1.0f;
+            input.camera_yaw = static_cast<float>(frame) * 0.01f;
+            client->manager.sendInputCommand(input);
+        }
+
+        std::fill(applied.begin(), applied.end(), 0u);
+        const uint32_t tick_before = server.getCurrentTick();
+        pumpNetwork(server, clients, kFixedDelta);
+        const uint32_t ticks = server.getCurrentTick() - tick_before;
+        sleepForNetworkTurn(config);
+
+        if (frame < kWarmupFrames) {
+            continue;
+        }
+        for (uint16_t client_id = 1; client_id <= client_count; ++client_id) {
+            out.ticks += ticks;
+            if (applied[client_id] != ticks) {
+                ++out.corrections;
+            }
+        }
+    }
+
+    for (uint16_t client_id = 1; client_id <= client_count; ++client_id) {
+        if (const Net::InputJitterStats* stats = server.getInputJitterStats(client_id)) {
+            out.synthesized += stats->synthesized;
+            out.merged += stats->merged;
+        }
+    }
+
+    for (auto& client : clients) {
+        client->manager.disconnect("jitter stress complete");
+    }
+    for (uint32_t frame = 0; frame < 120 && server.getClientCount() != 0; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+    for (auto& client : clients) {
+        client->manager.shutdown();
+    }
+    server.shutdown();
+
+    setCVar("net_fakejitter", "0");
+    setCVar("sv_input_buffer", "1");
+    return ok;
+}
+
+static bool runInputJitterStress(const StressConfig& config)
+{
+    InputCorrectionResult direct;
+    InputCorrectionResult buffered;
+    if (!measureInputCorrections(config, false, direct) || !measureInputCorrections(config, true, buffered)) {
+        std::cerr << "[FAIL] Input jitter stress could not run a loopback session\n";
+        return false;
+    }
+
+    std::cout << "[INFO] InputJitterStress jitter_ms=" << config.input_jitter_ms
+              << " ticks=" << buffered.ticks
+              << " corrections_direct=" << direct.corrections
+              << " corrections_buffered=" << buffered.corrections
+              << " synthesized=" << buffered.synthesized
+              << " merged=" << buffered.merged << "\n";
+
+    if (direct.corrections > 0 && buffered.corrections >= direct.corrections) {
+        std::cerr << "[FAIL] Input buffering did not reduce corrections under jitter\n";
+        return false;
+    }
+
+    std::cout << "[PASS] InputJitterStress\n";
+    return true;
+}
+
+// One buffered loopback client under net_fakejitter. World state may only acknowledge
+// input ticks the server has simulated: inputs still held in the jitter buffer must stay
+// in the client's prediction history so reconciliation replays them.
+static bool runBufferedInputAckStress(const StressConfig& config)
+{
+    setCVar("sv_input_buffer", "1");
+    setCVar("net_fakejitter", std::to_string(config.input_jitter_ms));
+
+    world server_world;
+    server_world.setFixedDelta(kFixedDelta);
+    Net::ServerNetworkManager server;
+    if (!server.initialize()) {
+        std::cerr << "[FAIL] Buffered input ack stress could not initialize the server\n";
+        return false;
+    }
+    server.setWorld(&server_world);
+
+    uint16_t player_client_id = 0;
+    server.setOnClientConnected([&](uint16_t client_id) {
+        player_client_id = client_id;
+        const entt::entity player_entity = spawnServerPlayer(server_world, server, client_id);
+
+        Net::SpawnPlayerMessage spawn_msg;
+        spawn_msg.client_id = client_id;
+        spawn_msg.entity_id = server_world.registry.get<Net::NetworkedEntity>(player_entity).network_id;
+        spawn_msg.position = server_world.registry.get<TransformComponent>(player_entity).position;
+
+        Net::BitWriter writer;
+        Net::NetworkSerializer::serialize(writer, spawn_msg);
+        server.sendReliableToClient(client_id, writer);
+    });
+
+    // Synthesized repeats carry the last played tick, so only real samples can raise this
+    uint32_t applied_tick = 0;
+    server.setInputSampleHandler([&](uint16_t, entt::entity, const Net::InputSample& sample, uint32_t) {
+        applied_tick = (std::max)(applied_tick, sample.tick);
+    });
+
+    uint16_t port = 0;
+    if (!startServer(server, config, port)) {
+        server.shutdown();
+        std::cerr << "[FAIL] Buffered input ack stress could not start a server\n";
+        return false;
+    }
+
+    std::vector<std::unique_ptr<StressClient>> clients;
+    clients.push_back(std::make_unique<StressClient>());
+    Net::ClientNetworkManager& client = clients.front()->manager;
+    if (!client.initialize() || !client.connectToServer("127.0.0.1", port, "input_ack")) {
+        server.shutdown();
+        std::cerr << "[FAIL] Buffered input ack stress could not connect a client\n";
+        return false;
+    }
+
+    for (uint32_t frame = 0; frame < config.connect_frame_budget && player_client_id == 0; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+
+    uint64_t acks = 0;
+    uint64_t early_acks = 0;
+    uint64_t held_frames = 0;
+    uint32_t last_ack = 0;
+    for (uint32_t frame = 0; player_client_id != 0 && frame < config.frame_count; ++frame) {
+        Net::InputState input;
+        input.move_forward = 1.0f;
+        input.camera_yaw = static_cast<float>(frame) * 0.01f;
+        client.sendInputCommand(input);
+
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+
+        if (const Net::InputJitterStats* stats = server.getInputJitterStats(player_client_id)) {
+            if (stats->depth > 0) {
+                ++held_frames;
+            }
+        }
+
+        Net::MovementState authoritative;
+        uint32_t ack = 0;
+        if (client.popAuthoritativeUpdate(authoritative, ack)) {
+            ++acks;
+            last_ack = ack;
+            if (ack > applied_tick) {
+                ++early_acks;
+            }
+        }
+    }
+
+    client.disconnect("input ack stress complete");
+    for (uint32_t frame = 0; frame < 120 && server.getClientCount() != 0; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+    client.shutdown();
+    server.shutdown();
+
+    setCVar("net_fakejitter", "0");
+    setCVar("sv_input_buffer", "1");
+
+    std::cout << "[INFO] BufferedInputAckStress acks=" << acks
+              << " held_frames=" << held_frames
+              << " early_acks=" << early_acks
+              << " last_ack=" << last_ack
+              << " applied_tick=" << applied_tick << "\n";
+
+    if (player_client_id == 0 || acks == 0 || last_ack == 0) {
+        std::cerr << "[FAIL] Buffered input ack stress received no acknowledged input\n";
+        return false;
+    }
+    if (held_frames == 0) {
+        std::cerr << "[FAIL] Jitter buffer never held an input, ack ordering was not exercised\n";
+        return false;
+    }
+    if (early_acks > 0) {
+        std::cerr << "[FAIL] Server acknowledged input ticks still waiting in the jitter buffer\n";
+        return false;
+    }
+
+    std::cout << "[PASS] BufferedInputAckStress\n";
+    return true;
+}
+
+enum class EventSendMode : uint8_t
+{
+    PerClient,  // One sendReliableToClient / sendUnreliableToClient per client per event
+    Multicast,  // multicastReliable / multicastUnreliable, sv_bundle_messages 0
+    Bundled     // multicastReliable / multicastUnreliable, sv_bundle_messages 1
+};
+
+struct EventTrafficResult
+{
+    uint64_t ticks = 0;
+    uint64_t packets_sent = 0;  // Server application packets, world state included
+    uint64_t bytes_sent = 0;
+    uint64_t reliable_sent = 0;
+    uint64_t reliable_received = 0;
+    uint64_t cosmetic_sent = 0;
+    uint64_t cosmetic_received = 0;
+    bool reliable_in_order = true;
+};
+
+static const char* getEventSendModeName(EventSendMode mode)
+{
+    switch (mode) {
+        case EventSendMode::PerClient: return "per_client";
+        case EventSendMode::Multicast: return "multicast";
+        case EventSendMode::Bundled: return "bundled";
+    }
+    return "unknown";
+}
+
+// One loopback session where the server emits events_per_tick reliable and cosmetic
+// events to every client each frame, the way the FPS template reports shots and damage.
+static bool measureEventTraffic(const StressConfig& config, EventSendMode mode, EventTrafficResult& out)
+{
+    constexpr uint32_t kWarmupFrames = 30;
+    const uint32_t client_count = config.client_count;
+
+    setCVar("sv_bundle_messages", mode == EventSendMode::Bundled ? "1" : "0");
+
+    world server_world;
+    server_world.setFixedDelta(kFixedDelta);
+    Net::ServerNetworkManager server;
+    if (!server.initialize()) {
+        return false;
+    }
+    server.setWorld(&server_world);
+
+    uint32_t connected = 0;
+    server.setOnClientConnected([&](uint16_t client_id) {
+        ++connected;
+        spawnServerPlayer(server_world, server, client_id);
+    });
+
+    uint16_t port = 0;
+    if (!startServer(server, config, port)) {
+        server.shutdown();
+        return false;
+    }
+
+    std::vector<uint32_t> last_sequence(client_count, 0);
+    std::vector<std::unique_ptr<StressClient>> clients;
+    for (uint32_t i = 0; i < client_count; ++i) {
+        std::unique_ptr<StressClient> client = std::make_unique<StressClient>();
+        client->manager.setCustomMessageHandler([&out, &last_sequence, i](uint8_t message_type, Net::BitReader& reader) {
+            const uint32_t sequence = reader.readUInt32();
+            if (reader.hasError()) {
+                return;
+            }
+            if (message_type == kReliableEventMessage) {
+                out.reliable_in_order = out.reliable_in_order && sequence == last_sequence[i] + 1;
+                last_sequence[i] = sequence;
+                ++out.reliable_received;
+            } else if (message_type == kCosmeticEventMessage) {
+                ++out.cosmetic_received;
+            }
+        });
+        const std::string name = "events_" + std::to_string(i + 1);
+        if (!client->manager.initialize() || !client->manager.connectToServer("127.0.0.1", port, name.c_str())) {
+            server.shutdown();
+            return false;
+        }
+        clients.push_back(std::move(client));
+    }
+
+    for (uint32_t frame = 0; frame < config.connect_frame_budget && connected < client_count; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+
+    auto sendEvent = [&](uint8_t message_type, uint32_t sequence) {
+        Net::BitWriter writer;
+        writer.writeByte(message_type);
+        writer.writeUInt32(sequence);
+        writer.writeVector3f(glm::vec3(static_cast<float>(sequence), 1.0f, 2.0f));
+        writer.writeVector3f(glm::vec3(3.0f, 4.0f, static_cast<float>(sequence)));
+
+        const bool reliable = message_type == kReliableEventMessage;
+        if (mode != EventSendMode::PerClient) {
+            if (reliable) {
+                server.multicastReliable(writer);
+            } else {
+                server.multicastUnreliable(writer);
+            }
+            return;
+        }
+        for (uint16_t client_id = 1; client_id < server.getNextClientId(); ++client_id) {
+            const Net::ClientInfo* client = server.getClientInfo(client_id);
+            if (client == nullptr || client->peer == Net::INVALID_TRANSPORT_PEER) {
+                continue;
+            }
+            if (reliable) {
+                server.sendReliableToClient(client_id, writer);
+            } else {
+                server.sendUnreliableToClient(client_id, writer);
+            }
+        }
+    };
+
+    bool ok = connected == client_count;
+    uint32_t sequence = 0;
+    uint64_t packets_before = 0;
+    uint64_t bytes_before = 0;
+    uint32_t tick_before = 0;
+    for (uint32_t frame = 0; ok && frame < config.frame_count + kWarmupFrames; ++frame) {
+        if (frame == kWarmupFrames) {
+            packets_before = server.getStats().packets_sent;
+            bytes_before = server.getStats().bytes_sent;
+            tick_before = server.getCurrentTick();
+        }
+        for (uint32_t e = 0; e < config.events_per_tick; ++e) {
+            ++sequence;
+            sendEvent(kReliableEventMessage, sequence);
+            sendEvent(kCosmeticEventMessage, sequence);
+        }
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+
+    out.ticks = server.getCurrentTick() - tick_before;
+    out.packets_sent = server.getStats().packets_sent - packets_before;
+    out.bytes_sent = server.getStats().bytes_sent - bytes_before;
+    out.reliable_sent = static_cast<uint64_t>(sequence) * client_count;
+    out.cosmetic_sent = out.reliable_sent;
+
+    for (uint32_t frame = 0; frame < 60; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+
+    for (auto& client : clients) {
+        client->manager.disconnect("event stress complete");
+    }
+    for (uint32_t frame = 0; frame < 120 && server.getClientCount() != 0; ++frame) {
+        pumpNetwork(server, clients, kFixedDelta);
+        sleepForNetworkTurn(config);
+    }
+    for (auto& client : clients) {
+        client->manager.shutdown();
+    }
+    server.shutdown();
+
+    setCVar("sv_bundle_messages", "1");
+    return ok;
+}
+
+static bool runEventTrafficStress(const StressConfig& config)
+{
+    const EventSendMode modes[] = { EventSendMode::PerClient, EventSendMode::Multicast, EventSendMode::Bundled };
+    EventTrafficResult results[3];
+    bool ok = true;
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (!measureEventTraffic(config, modes[i], results[i])) {
+            std::cerr << "[FAIL] Event traffic stress could not run a loopback session\n";
+            return false;
+        }
+
+        const EventTrafficResult& r = results[i];
+        const double ticks = static_cast<double>((std::max)(r.ticks, uint64_t(1)));
+        std::cout << "[INFO] EventTrafficStress mode=" << getEventSendModeName(modes[i])
+                  << " clients=" << config.client_count
+                  << " events_per_tick=" << config.events_per_tick
+                  << " packets_per_tick=" << static_cast<double>(r.packets_sent) / ticks
+                  << " bytes_per_tick=" << static_cast<double>(r.bytes_sent) / ticks
+                  << " reliable=" << r.reliable_received << "/" << r.reliable_sent
+                  << " cosmetic=" << r.cosmetic_received << "/" << r.cosmetic_sent << "\n";
+
+        if (r.reliable_received != r.reliable_sent || !r.reliable_in_order) {
+            std::cerr << "[FAIL] Reliable events lost or reordered (" << getEventSendModeName(modes[i]) << ")\n";
+            ok = false;
+        }
+        if (r.cosmetic_received == 0) {
+            std::cerr << "[FAIL] No cosmetic events delivered (" << getEventSendModeName(modes[i]) << ")\n";
+            ok = false;
+        }
+    }
+
+    if (results[2].packets_sent >= results[0].packets_sent) {
+        std::cerr << "[FAIL] Bundling did not reduce server packets per tick\n";
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "[PASS] EventTrafficStress\n";
+    }
+    return ok;
+}
+
+enum class MatchTransport : uint8_t
+{
+    ENet,
+    Local
+};
+
+struct TransportMatchResult
+{
+    uint32_t connected = 0;
+    uint32_t disconnected = 0;
+    uint64_t input_samples = 0;
+    uint64_t reliable_sent = 0;        // Client -> server
+    uint64_t reliable_received = 0;
+    uint64_t unreliable_sent = 0;
+    uint64_t unreliable_received = 0;
+    uint64_t events_sent = 0;          // Server -> every client, reliable
+    uint64_t events_received = 0;
+    uint32_t clients_with_world_state = 0;
+    bool reliable_in_order = true;
+};
+
+// LocalTransport link used by the parity run: impaired enough to exercise delay, jitter,
+// loss and reordering, on a clock that only advances with the simulated frames.
+static Net::LocalTransportSettings makeParityLinkSettings(const double& clock, uint32_t seed)
+{
+    Net::LocalTransportSettings settings;
+    settings.latency_ms = 30.0f;
+    settings.jitter_ms = 10.0f;
+    settings.loss_percent = 5.0f;
+    settings.reorder_percent = 5.0f;
+    settings.seed = seed;
+    settings.clock = [&clock]() { return clock; };
+    return settings;
+}
+
+// The same scripted match over either transport: clients send input plus reliable and
+// unreliable messages, the server multicasts a reliable event every frame.
+static bool measureTransportMatch(const StressConfig& config, MatchTransport transport, TransportMatchResult& out)
+{
+    const uint32_t client_count = config.client_count;
+    const bool local = transport == MatchTransport::Local;
+    double local_clock = 0.0;
+
+    world server_world;
+    server_world.setFixedDelta(kFixedDelta);
+    Net::ServerNetworkManager server;
+    if (!server.initialize()) {
+        return false;
+    }
+    server.setWorld(&server_world);
+
+    std::vector<uint32_t> last_reliable(client_count + 1, 0);
+    server.setOnClientConnected([&](uint16_t client_id) {
+        ++out.connected;
+        spawnServerPlayer(server_world, server, client_id);
+    });
+    server.setOnClientDisconnected([&](uint16_t) {
+        ++out.disconnected;
+    });
+    server.setInputSampleHandler([&](uint16_t, entt::entity, const Net::InputSample&, uint32_t) {
+        ++out.input_samples;
+    });
+    server.setCustomMessageHandler([&](uint16_t client_id, uint8_t message_type, Net::BitReader& reader) {
+        reader.readByte();
+        reader.readUInt16();
+        const uint32_t sequence = reader.readUInt32();
+        if (reader.hasError() || client_id == 0 || client_id > client_count) {
+            return;
+        }
+        if (message_type == kReliableStressMessage) {
+            out.reliable_in_order = out.reliable_in_order && sequence == last_reliable[client_id] + 1;
+            last_reliable[client_id] = sequence;
+            ++out.reliable_received;
+        } else if (message_type == kUnreliableStressMessage) {
+            ++out.unreliable_received;
+        }
+    });
+
+    uint16_t port = 0;
+    bool started = false;
+    if (local) {
+        port = config.requested_port != 0 ? config.requested_port : 47100;
+        started = server.startServer(std::make_unique<Net::LocalTransport>(makeParityLinkSettings(local_clock, 1)),
+                                     port, client_count);
+    } else {
+        started = startServer(server, config, port);
+    }
+    if (!started) {
+        server.shutdown();
+        return false;
+    }
+
+    std::vector<uint32_t> last_event(client_count, 0);
+    std::vector<std::unique_ptr<StressClient>> clients;
+    for (uint32_t i = 0; i < client_count; ++i) {
+        std::unique_ptr<StressClient> client = std::make_unique<StressClient>();
+        client->manager.setCustomMessageHandler([&out, &last_event, i](uint8_t message_type, Net::BitReader& reader) {
+            const uint32_t sequence = reader.readUInt32();
+            if (reader.hasError() || message_type != kReliableEventMessage) {
+                return;
+            }
+            out.reliable_in_order = out.reliable_in_order && sequence == last_event[i] + 1;
+            last_event[i] = sequence;
+            ++out.events_received;
+        });
+
+        std::unique_ptr<Net::INetworkTransport> client_transport;
+        if (local) {
+            client_transport = std::make_unique<Net::LocalTransport>(makeParityLinkSettings(local_clock, 100 + i));
+        } else {
+            client_transport = std::make_unique<Net::ENetTransport>();
+        }
+        const std::string name = "parity_" + std::to_string(i + 1);
+        if (!client->manager.initialize() ||
+            !client->manager.connectToServer(std::move(client_transport), "127.0.0.1", port, name.c_str())) {
+            server.shutdown();
+            return false;
+        }
+        clients.push_back(std::move(client));
+    }
+
+    auto runFrame = [&]() {
+        pumpNetwork(server, clients, kFixedDelta);
+        if (local) {
+            local_clock += kFixedDelta;
+        } else {
+            sleepForNetworkTurn(config);
+        }
+    };
+
+    for (uint32_t frame = 0; frame < config.connect_frame_budget && out.connected < client_count; ++frame) {
+        runFrame();
+    }
+
+    uint32_t event_sequence = 0;
+    for (uint32_t frame = 0; out.connected == client_count && frame < config.frame_count; ++frame) {
+        for (uint32_t i = 0; i < clients.size(); ++i) {
+            StressClient& client = *clients[i];
+            if (!client.manager.isConnected()) {
+                continue;
+            }
+            Net::InputState input;
+            input.move_forward = ((frame + i) & 1u) ? 1.0f : -1.0f;
+            client.manager.sendInputCommand(input);
+            if ((frame % config.reliable_interval_frames) == 0) {
+                sendStressMessage(client.manager, kReliableStressMessage, ++client.reliable_sequence);
+                ++out.reliable_sent;
+            }
+            if ((frame % config.unreliable_interval_frames) == 0) {
+                sendStressMessage(client.manager, kUnreliableStressMessage, ++client.unreliable_sequence);
+                ++out.unreliable_sent;
+            }
+        }
+
+        Net::BitWriter writer;
+        writer.writeByte(kReliableEventMessage);
+        writer.writeUInt32(++event_sequence);
+        server.multicastReliable(writer);
+        out.events_sent += client_count;
+
+        runFrame();
+    }
+
+    for (uint32_t frame = 0; frame < 120; ++frame) {
+        runFrame();
+    }
+    for (auto& client : clients) {
+        if (client->manager.getLastReceivedServerTick() != 0) {
+            ++out.clients_with_world_state;
+        }
+        client->manager.disconnect("parity complete");
+    }
+    for (uint32_t frame = 0; frame < 120 && server.getClientCount() != 0; ++frame) {
+        runFrame();
+    }
+
+    for (auto& client : clients) {
+        client->manager.shutdown();
+    }
+    server.shutdown();
+    return true;
+}
+
+static bool runTransportParityStress(const StressConfig& config)
+{
+    const MatchTransport transports[] = { MatchTransport::ENet, MatchTransport::Local, MatchTransport::Local };
+    const char* names[] = { "enet", "local", "local_rerun" };
+    TransportMatchResult results[3];
+    bool ok = true;
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (!measureTransportMatch(config, transports[i], results[i])) {
+            std::cerr << "[FAIL] Transport parity stress could not run a " << names[i] << " session\n";
+            return false;
+        }
+
+        const TransportMatchResult& r = results[i];
+        std::cout << "[INFO] TransportParityStress transport=" << names[i]
+                  << " clients=" << r.connected << "/" << config.client_count
+                  << " input_samples=" << r.input_samples
+                  << " reliable=" << r.reliable_received << "/" << r.reliable_sent
+                  << " unreliable=" << r.unreliable_received << "/" << r.unreliable_sent
+                  << " events=" << r.events_received << "/" << r.events_sent
+                  << " disconnected=" << r.disconnected << "\n";
+
+        if (r.connected != config.client_count || r.disconnected != config.client_count) {
+            std::cerr << "[FAIL] Not every client connected and disconnected (" << names[i] << ")\n";
+            ok = false;
+        }
+        if (r.reliable_received != r.reliable_sent || r.events_received != r.events_sent || !r.reliable_in_order) {
+            std::cerr << "[FAIL] Reliable traffic lost or reordered (" << names[i] << ")\n";
+            ok = false;
+        }
+        if (r.input_samples == 0 || r.unreliable_received == 0 || r.clients_with_world_state != config.client_count) {
+            std::cerr << "[FAIL] Input, unreliable or world-state traffic missing (" << names[i] << ")\n";
+            ok = false;
+        }
+    }
+
+    // A seeded link on a manual clock replays exactly
+    const TransportMatchResult& first = results[1];
+    const TransportMatchResult& rerun = results[2];
+    if (first.input_samples != rerun.input_samples ||
+        first.unreliable_received != rerun.unreliable_received ||
+        first.events_received != rerun.events_received) {
+        std::cerr << "[FAIL] LocalTransport run was not reproducible\n";
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "[PASS] TransportParityStress\n";
+    }
+    return ok;
+}
+
 } // namespace
 
 int main(int argc, char** argv)
@@ -487,7 +1212,19 @@ int main(int argc, char** argv)
         EE::CLog::GetClientLogger()->set_level(spdlog::level::warn);
         EE::CLog::GetLuaLogger()->set_level(spdlog::level::warn);
     }
-    const bool ok = runNetworkStress(config);
+    // The loopback stresses cover the UDP path; LocalTransport has its own parity run
+    setCVar("net_local_transport", "0");
+    bool ok = runNetworkStress(config);
+    if (config.input_jitter_ms > 0) {
+        ok = runInputJitterStress(config) && ok;
+        ok = runBufferedInputAckStress(config) && ok;
+    }
+    if (config.events_per_tick > 0) {
+        ok = runEventTrafficStress(config) && ok;
+    }
+    if (config.transport_parity) {
+        ok = runTransportParityStress(config) && ok;
+    }
     EE::CLog::Shutdown();
     return ok ? 0 : 1;
 }
@@ -1,23 +1,33 @@
+#include "Animation/AnimationSystem.hpp"
+#include "Animation/FootPlacement.hpp"
 #include "Assets/TerrainBuilder.hpp"
 #include "Assets/AssetManager.hpp"
+#include "Components/AnimationComponent.hpp"
 #include "Components/Components.hpp"
+#include "Components/FootPlacementComponent.hpp"
+#include "Components/RagdollComponent.hpp"
 #include "Graphics/HeadlessRenderAPI.hpp"
 #include "LevelManager.hpp"
 #include "PhysicsSystem.hpp"
 #include "PlayerController.hpp"
+#include "Project/ProjectManager.hpp"
 #include "Reflection/EngineReflection.hpp"
 #include "Reflection/ReflectionRegistry.hpp"
+#include "Threading/JobSystem.hpp"
 #include "Tick/TickSystem.hpp"
 #include "Utils/Log.hpp"
+#include "Utils/MemoryTracker.hpp"
 #include "world.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -115,6 +125,103 @@ static bool testWorldSimulationTickTracksPhysicsSteps()
     return pass(name);
 }
 
+static bool testMemoryTrackerAttributesTags()
+{
+    const std::string name = "memory tracker attributes tags";
+    MemoryTracker::endFrame();
+    const MemoryTagStats audio_before = MemoryTracker::getStats(MemoryTag::Audio);
+    const MemoryTagStats nav_before = MemoryTracker::getStats(MemoryTag::Navigation);
+
+    void* audio_block = nullptr;
+    void* nav_block = nullptr;
+    void* aligned_block = nullptr;
+    {
+        MemoryTagScope audio(MemoryTag::Audio);
+        audio_block = MemoryTracker::allocate(1000);
+        {
+            MemoryTagScope nav(MemoryTag::Navigation);
+            nav_block = MemoryTracker::allocate(300);
+        }
+        aligned_block = MemoryTracker::allocate(64, 64);
+    }
+    if (MemoryTracker::getCurrentTag() != MemoryTag::Untagged)
+        return fail(name, "tag stack did not unwind");
+    if ((reinterpret_cast<uintptr_t>(aligned_block) & 63) != 0)
+        return fail(name, "aligned allocation is misaligned");
+
+    MemoryTagStats audio = MemoryTracker::getStats(MemoryTag::Audio);
+    MemoryTagStats nav = MemoryTracker::getStats(MemoryTag::Navigation);
+    if (audio.current_bytes - audio_before.current_bytes != 1064)
+        return fail(name, "outer scope bytes not charged to audio");
+    if (nav.current_bytes - nav_before.current_bytes != 300)
+        return fail(name, "nested scope bytes not charged to navigation");
+
+    MemoryTracker::endFrame();
+    audio = MemoryTracker::getStats(MemoryTag::Audio);
+    if (audio.frame_allocations != 2)
+        return fail(name, "expected 2 audio allocations in the frame, got " + std::to_string(audio.frame_allocations));
+
+    // Frees go back to the allocating tag, whatever scope is active
+    {
+        MemoryTagScope gameplay(MemoryTag::Gameplay);
+        MemoryTracker::deallocate(audio_block);
+        MemoryTracker::deallocate(nav_block);
+        MemoryTracker::deallocate(aligned_block);
+    }
+    audio = MemoryTracker::getStats(MemoryTag::Audio);
+    nav = MemoryTracker::getStats(MemoryTag::Navigation);
+    if (audio.current_bytes != audio_before.current_bytes || nav.current_bytes != nav_before.current_bytes)
+        return fail(name, "frees were not returned to the allocating tag");
+    if (audio.peak_bytes < audio_before.current_bytes + 1064)
+        return fail(name, "peak did not record the high-water mark");
+
+    MemoryTracker::endFrame();
+    if (MemoryTracker::getStats(MemoryTag::Audio).frame_allocations != 0)
+        return fail(name, "frame allocation counter did not roll over");
+
+    const std::string report = MemoryTracker::formatReport();
+    if (report.find("Audio") == std::string::npos)
+        return fail(name, "report is missing the audio tag");
+
+    if (MemoryTracker::isGlobalHookEnabled())
+    {
+        const int64_t before = MemoryTracker::getStats(MemoryTag::Gameplay).current_bytes;
+        std::vector<char>* heap = nullptr;
+        {
+            MemoryTagScope gameplay(MemoryTag::Gameplay);
+            heap = new std::vector<char>(4096);
+        }
+        const int64_t during = MemoryTracker::getStats(MemoryTag::Gameplay).current_bytes;
+        delete heap;
+        if (during - before < 4096)
+            return fail(name, "operator new was not charged to the active tag");
+    }
+
+    return pass(name);
+}
+
+static bool testMemoryTrackerChargesJoltToPhysics()
+{
+    const std::string name = "memory tracker charges Jolt to physics";
+    const MemoryTagStats before = MemoryTracker::getStats(MemoryTag::Physics);
+    int64_t during = 0;
+    {
+        world w;
+        w.getPhysicsSystem().initialize();
+        during = MemoryTracker::getStats(MemoryTag::Physics).current_bytes;
+    }
+    const MemoryTagStats after = MemoryTracker::getStats(MemoryTag::Physics);
+
+    if (during <= before.current_bytes)
+        return fail(name, "Jolt allocations were not charged to physics");
+    if (after.total_allocations <= before.total_allocations)
+        return fail(name, "physics allocation count did not grow");
+    if (after.current_bytes >= during)
+        return fail(name, "physics bytes were not released on shutdown");
+
+    return pass(name);
+}
+
 static void appendLe16(std::vector<std::uint8_t>& out, std::uint16_t value)
 {
     out.push_back(static_cast<std::uint8_t>(value & 0xff));
@@ -905,6 +1012,1246 @@ static bool testRaycastClosestCanIgnoreShooterBody()
     return pass(name);
 }
 
+static bool testSceneQueryQueueBudgetAndPriority()
+{
+    const std::string name = "scene query queue budget and priority";
+    world w;
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+
+    auto shape = makeBoxShape();
+    if (!shape)
+        return fail(name, "failed to create box shape");
+    auto wall = w.registry.create();
+    w.registry.emplace<TransformComponent>(wall, 0.0f, 0.5f, 5.0f);
+    if (physics.createStaticBody(glm::vec3(0.0f, 0.5f, 5.0f), glm::vec3(0.0f), shape, wall).IsInvalid())
+        return fail(name, "failed to create wall body");
+
+    SceneQuerySettings query_settings;
+    query_settings.max_queries_per_frame = 2;
+    query_settings.parallel = false;
+    physics.getSceneQueries().setSettings(query_settings);
+
+    const glm::vec3 eye(0.0f, 0.5f, 0.0f);
+    const glm::vec3 forward(0.0f, 0.0f, 1.0f);
+    SceneQuery low = SceneQuery::raycast(eye, forward, 10.0f);
+    low.priority = 0.25f;
+    SceneQuery high = SceneQuery::sphereCast(eye, 0.2f, forward, 10.0f);
+    high.priority = 4.0f;
+
+    int callbacks = 0;
+    const SceneQueryHandle low_handle = physics.enqueueQuery(low);
+    const SceneQueryHandle high_handle = physics.enqueueQuery(high,
+        [&](SceneQueryHandle, const SceneQueryResult&) { ++callbacks; });
+    const SceneQueryHandle overlap_handle = physics.enqueueQuery(SceneQuery::sphereOverlap(glm::vec3(0.0f, 0.5f, 4.0f), 1.0f));
+    const SceneQueryHandle miss_handle = physics.enqueueQuery(SceneQuery::raycast(eye, -forward, 10.0f));
+
+    SceneQueryResult result;
+    if (physics.getSceneQueries().getResult(high_handle, result))
+        return fail(name, "result available before execute");
+
+    physics.executeSceneQueries();
+    const SceneQueryStats& stats = physics.getSceneQueries().getStats();
+    if (stats.executed != 2 || stats.deferred != 2)
+        return fail(name, "frame budget was not applied");
+    if (callbacks != 1)
+        return fail(name, "callback did not run exactly once");
+    if (!physics.getSceneQueries().getResult(high_handle, result) || !result.hit || result.entity != wall)
+        return fail(name, "high-priority sphere cast missed the wall");
+    if (!approx(result.distance, 4.3f, 0.08f))
+        return fail(name, "sphere cast distance was not the wall face minus its radius");
+    if (!physics.getSceneQueries().getResult(overlap_handle, result) || result.overlaps.size() != 1 || result.overlaps[0] != wall)
+        return fail(name, "overlap query did not report the wall");
+    if (!physics.getSceneQueries().isPending(low_handle) || !physics.getSceneQueries().isPending(miss_handle))
+        return fail(name, "lower-priority queries were not deferred");
+
+    physics.executeSceneQueries();
+    if (!physics.getSceneQueries().getResult(low_handle, result) || !result.hit || result.frames_waited != 1)
+        return fail(name, "deferred raycast did not run on the next frame");
+    if (!physics.getSceneQueries().getResult(miss_handle, result) || result.hit)
+        return fail(name, "raycast away from the wall reported a hit");
+    if (physics.getSceneQueries().getPendingCount() != 0)
+        return fail(name, "queue did not drain");
+
+    return pass(name);
+}
+
+// Starts the job system for one test unless it is already running, and shuts
+// it down on every return path. Declare it before the world so the world's
+// physics is destroyed first.
+struct ScopedJobSystem
+{
+    Threading::JobSystem& jobs = Threading::JobSystem::get();
+    const bool owns = !jobs.isInitialized();
+
+    ScopedJobSystem()
+    {
+        if (owns)
+            jobs.initialize();
+    }
+    ~ScopedJobSystem()
+    {
+        if (owns)
+            jobs.shutdown();
+    }
+    ScopedJobSystem(const ScopedJobSystem&) = delete;
+    ScopedJobSystem& operator=(const ScopedJobSystem&) = delete;
+};
+
+static bool testSceneQueryBatchMatchesSynchronousRaycasts()
+{
+    const std::string name = "scene query batch matches synchronous raycasts";
+    constexpr size_t RAY_COUNT = 10000;
+
+    ScopedJobSystem jobs;
+    world w;
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+
+    // A field of pillars with rays fanned through it, so some hit and some miss
+    auto shape = makeBoxShape();
+    if (!shape)
+        return fail(name, "failed to create box shape");
+    for (int x = 0; x < 16; ++x)
+    {
+        for (int z = 0; z < 16; ++z)
+        {
+            const glm::vec3 position(static_cast<float>(x) * 3.0f - 24.0f, 0.5f, static_cast<float>(z) * 3.0f + 4.0f);
+            auto e = w.registry.create();
+            w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+            if (physics.createStaticBody(position, glm::vec3(0.0f), shape, e).IsInvalid())
+                return fail(name, "failed to create pillar body");
+        }
+    }
+
+    std::vector<SceneQuery> queries;
+    queries.reserve(RAY_COUNT);
+    for (size_t i = 0; i < RAY_COUNT; ++i)
+    {
+        const float angle = (static_cast<float>(i) / static_cast<float>(RAY_COUNT) - 0.5f) * 2.4f;
+        const glm::vec3 origin(static_cast<float>(i % 7) - 3.0f, 0.5f, 0.0f);
+        queries.push_back(SceneQuery::raycast(origin, glm::vec3(std::sin(angle), 0.0f, std::cos(angle)), 60.0f));
+    }
+
+    const auto sync_start = std::chrono::steady_clock::now();
+    std::vector<PhysicsSystem::RaycastResult> expected;
+    expected.reserve(RAY_COUNT);
+    for (const SceneQuery& q : queries)
+        expected.push_back(physics.raycastClosest(q.origin, q.direction, q.max_distance));
+    const double sync_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sync_start).count();
+
+    SceneQuerySettings query_settings;
+    query_settings.max_queries_per_frame = RAY_COUNT;
+    physics.getSceneQueries().setSettings(query_settings);
+
+    std::vector<SceneQueryHandle> handles;
+    handles.reserve(RAY_COUNT);
+    for (const SceneQuery& q : queries)
+        handles.push_back(physics.enqueueQuery(q));
+    physics.executeSceneQueries();
+    const double batch_ms = physics.getSceneQueries().getStats().execute_ms;
+
+    size_t hits = 0;
+    for (size_t i = 0; i < RAY_COUNT; ++i)
+    {
+        SceneQueryResult result;
+        if (!physics.getSceneQueries().getResult(handles[i], result))
+            return fail(name, "missing result for query " + std::to_string(i));
+        if (result.hit != expected[i].hit || result.entity != expected[i].entity ||
+            (result.hit && !approx(result.distance, expected[i].distance, 0.001f)))
+            return fail(name, "batched result differs from raycastClosest for query " + std::to_string(i));
+        hits += result.hit ? 1 : 0;
+    }
+
+    if (hits == 0 || hits == RAY_COUNT)
+        return fail(name, "benchmark rays did not mix hits and misses");
+
+    std::cout << "  " << RAY_COUNT << " raycasts: synchronous " << sync_ms << " ms, batched " << batch_ms << " ms" << std::endl;
+    return pass(name);
+}
+
+static bool testCollisionLayerMatrixAndQueryMasks()
+{
+    const std::string name = "collision layer matrix and query masks";
+    using namespace PhysicsObjectLayers;
+
+    PhysicsLayerSettings layers;
+    if (!layers.shouldObjectsCollide(Debris, Static) || !layers.shouldObjectsCollide(Static, Debris))
+        return fail(name, "debris does not collide with static geometry");
+    if (layers.shouldObjectsCollide(Debris, Debris) || layers.shouldObjectsCollide(Character, Debris))
+        return fail(name, "debris collides with debris or characters by default");
+    if (layers.shouldObjectsCollide(Static, Static) || layers.shouldObjectsCollide(Query, Dynamic))
+        return fail(name, "static or query-only layers collide");
+    if (layers.shouldObjectCollideWithBroadPhase(Debris, PhysicsBroadPhaseLayers::Debris) ||
+        !layers.shouldObjectCollideWithBroadPhase(Dynamic, PhysicsBroadPhaseLayers::Debris))
+        return fail(name, "broadphase masks do not follow the layer matrix");
+
+    const PhysicsLayerSettings round_trip = makePhysicsLayerSettings(makeProjectPhysicsLayers(layers));
+    if (round_trip.object_layer_count != layers.object_layer_count ||
+        round_trip.collides_with != layers.collides_with || round_trip.broad_phase_masks != layers.broad_phase_masks ||
+        round_trip.character_body != layers.character_body)
+        return fail(name, "project layers did not round-trip");
+
+    world w;
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    auto shape = makeBoxShape();
+    if (!shape)
+        return fail(name, "failed to create box shape");
+
+    // Three boxes stacked under one ray: debris on top, then a dynamic body, then static ground
+    auto makeBody = [&](float y, JPH::ObjectLayer layer, bool dynamic) {
+        auto e = w.registry.create();
+        w.registry.emplace<TransformComponent>(e, 0.0f, y, 0.0f);
+        PhysicsSystem::PhysicsBodyDesc desc;
+        desc.apply_gravity = false;
+        desc.object_layer = layer;
+        const glm::vec3 position(0.0f, y, 0.0f);
+        JPH::BodyID id = dynamic ? physics.createDynamicBody(position, glm::vec3(0.0f), shape, e, desc)
+                                 : physics.createStaticBody(position, glm::vec3(0.0f), shape, e, desc);
+        return id.IsInvalid() ? entt::entity(entt::null) : e;
+    };
+    const entt::entity ground = makeBody(0.0f, JPH::cObjectLayerInvalid, false);
+    const entt::entity crate = makeBody(3.0f, JPH::cObjectLayerInvalid, true);
+    const entt::entity debris = makeBody(6.0f, physics.findLayer("Debris"), true);
+    if (ground == entt::null || crate == entt::null || debris == entt::null)
+        return fail(name, "failed to create bodies");
+    if (physics.getBodyLayer(ground) != Static || physics.getBodyLayer(crate) != Dynamic ||
+        physics.getBodyLayer(debris) != Debris)
+        return fail(name, "bodies were not created on the requested layers");
+
+    const glm::vec3 origin(0.0f, 10.0f, 0.0f);
+    const glm::vec3 down(0.0f, -1.0f, 0.0f);
+    const PhysicsLayerMask no_debris = PHYSICS_ALL_LAYERS & ~physics.getLayerMask("Debris");
+    const PhysicsLayerMask static_only = physics.getLayerMask("Static");
+    if (physics.raycastClosest(origin, down, 20.0f).entity != debris)
+        return fail(name, "unmasked raycast did not hit the top body");
+    if (physics.raycastClosest(origin, down, 20.0f, entt::null, no_debris).entity != crate)
+        return fail(name, "raycast without the debris layer did not skip the debris");
+    if (physics.sphereCast(origin, 0.2f, down, 20.0f, static_only).entity != ground)
+        return fail(name, "static-only sphere cast did not reach the ground");
+
+    SceneQuery query = SceneQuery::raycast(origin, down, 20.0f);
+    query.layer_mask = no_debris;
+    SceneQueryResult result;
+    physics.runSceneQueries(&query, &result, 1);
+    if (result.entity != crate)
+        return fail(name, "scene query ignored its layer mask");
+
+    return pass(name);
+}
+
+// 5000 debris pieces falling in a heap around 32 character-sized bodies, stepped once with
+// every body on the Dynamic layer (the old two-layer setup) and once with the debris on
+// the Debris layer, which skips debris-debris and debris-character pairs.
+static double runDebrisBenchmark(bool use_debris_layer, float& out_lowest_debris_y)
+{
+    constexpr int DEBRIS_SIDE = 25;
+    constexpr int DEBRIS_LEVELS = 8;
+    constexpr int CHARACTER_COUNT = 32;
+    constexpr int STEP_COUNT = 120;
+
+    PhysicsSystemSettings settings;
+    settings.max_bodies = 8192;
+    settings.max_body_pairs = 65536;
+    settings.max_contact_constraints = 65536;
+    settings.temp_allocator_size_bytes = 64u * 1024u * 1024u;
+    world w(settings);
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+
+    ColliderComponent ground_col;
+    ground_col.shape_type = ColliderShapeType::Box;
+    ground_col.box_half_extents = glm::vec3(40.0f, 0.5f, 40.0f);
+    ColliderComponent debris_col;
+    debris_col.shape_type = ColliderShapeType::Box;
+    debris_col.box_half_extents = glm::vec3(0.2f);
+    ColliderComponent character_col;
+    character_col.shape_type = ColliderShapeType::Box;
+    character_col.box_half_extents = glm::vec3(0.35f, 0.9f, 0.35f);
+    auto ground_shape = PhysicsSystem::createShapeFromCollider(ground_col, glm::vec3(1.0f));
+    auto debris_shape = PhysicsSystem::createShapeFromCollider(debris_col, glm::vec3(1.0f));
+    auto character_shape = PhysicsSystem::createShapeFromCollider(character_col, glm::vec3(1.0f));
+
+    auto ground = w.registry.create();
+    w.registry.emplace<TransformComponent>(ground, 0.0f, -0.5f, 0.0f);
+    physics.createStaticBody(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f), ground_shape, ground);
+
+    auto addDynamic = [&](const glm::vec3& position, const JPH::ShapeRefC& shape, JPH::ObjectLayer layer) {
+        auto e = w.registry.create();
+        w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+        w.registry.emplace<RigidBodyComponent>(e).mass = 1.0f;
+        PhysicsSystem::PhysicsBodyDesc desc;
+        desc.object_layer = layer;
+        physics.createDynamicBody(position, glm::vec3(0.0f), shape, e, desc);
+        return e;
+    };
+
+    const JPH::ObjectLayer debris_layer = use_debris_layer ? PhysicsObjectLayers::Debris : PhysicsObjectLayers::Dynamic;
+    const JPH::ObjectLayer character_layer = use_debris_layer ? PhysicsObjectLayers::Character : PhysicsObjectLayers::Dynamic;
+    std::vector<entt::entity> debris;
+    debris.reserve(DEBRIS_SIDE * DEBRIS_SIDE * DEBRIS_LEVELS);
+    for (int level = 0; level < DEBRIS_LEVELS; ++level)
+    {
+        for (int x = 0; x < DEBRIS_SIDE; ++x)
+        {
+            for (int z = 0; z < DEBRIS_SIDE; ++z)
+            {
+                const glm::vec3 position(static_cast<float>(x) * 0.45f - 5.4f, 0.5f + static_cast<float>(level) * 0.45f,
+                    static_cast<float>(z) * 0.45f - 5.4f);
+                debris.push_back(addDynamic(position, debris_shape, debris_layer));
+            }
+        }
+    }
+    for (int i = 0; i < CHARACTER_COUNT; ++i)
+    {
+        const float angle = static_cast<float>(i) * 0.19634954f;
+        addDynamic(glm::vec3(std::cos(angle) * 8.0f, 1.0f, std::sin(angle) * 8.0f), character_shape, character_layer);
+    }
+    physics.optimizeBroadPhase();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < STEP_COUNT; ++i)
+        physics.stepPhysics(w.registry);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    out_lowest_debris_y = std::numeric_limits<float>::max();
+    for (entt::entity e : debris)
+        out_lowest_debris_y = std::min(out_lowest_debris_y, w.registry.get<TransformComponent>(e).position.y);
+    return elapsed_ms / STEP_COUNT;
+}
+
+static bool testDebrisLayerBenchmark()
+{
+    const std::string name = "debris layer benchmark";
+
+    float legacy_lowest = 0.0f;
+    float layered_lowest = 0.0f;
+    const double legacy_ms = runDebrisBenchmark(false, legacy_lowest);
+    const double layered_ms = runDebrisBenchmark(true, layered_lowest);
+
+    // Debris that stops colliding with other debris must still land on the static ground
+    if (legacy_lowest < 0.0f || layered_lowest < 0.0f)
+        return fail(name, "debris fell through the ground");
+
+    std::cout << "  5000 debris + 32 characters: single dynamic layer " << legacy_ms << " ms/step, debris layer "
+              << layered_ms << " ms/step" << std::endl;
+    return pass(name);
+}
+
+// In-place walk for a minimal biped: root -> pelvis -> thigh -> shin -> foot per side.
+// The stance leg stays straight with its ankle FOOT_ANKLE above the origin (the pelvis
+// bobs to keep it there), the swing leg bends its knee. Left stance is [0, 0.5).
+static constexpr float WALK_THIGH = 0.45f;
+static constexpr float WALK_SHIN = 0.42f;
+static constexpr float WALK_ANKLE = 0.08f;
+static constexpr float WALK_STRIDE_DEGREES = 25.0f;
+
+static std::shared_ptr<Skeleton> makeWalkSkeleton()
+{
+    auto skeleton = std::make_shared<Skeleton>();
+    auto add = [&](const char* name, int parent, const glm::vec3& offset) {
+        Bone bone;
+        bone.id = skeleton->getBoneCount();
+        bone.parent_id = parent;
+        bone.name = name;
+        bone.local_transform = glm::translate(glm::mat4(1.0f), offset);
+        skeleton->addBone(bone);
+    };
+    const float hip_height = WALK_ANKLE + WALK_THIGH + WALK_SHIN;
+    add("root", -1, glm::vec3(0.0f));
+    add("pelvis", 0, glm::vec3(0.0f, hip_height, 0.0f));
+    add("thigh_l", 1, glm::vec3(-0.11f, 0.0f, 0.0f));
+    add("shin_l", 2, glm::vec3(0.0f, -WALK_THIGH, 0.0f));
+    add("foot_l", 3, glm::vec3(0.0f, -WALK_SHIN, 0.0f));
+    add("thigh_r", 1, glm::vec3(0.11f, 0.0f, 0.0f));
+    add("shin_r", 5, glm::vec3(0.0f, -WALK_THIGH, 0.0f));
+    add("foot_r", 6, glm::vec3(0.0f, -WALK_SHIN, 0.0f));
+    return skeleton;
+}
+
+static std::shared_ptr<AnimationClip> makeWalkClip(const Skeleton& skeleton)
+{
+    auto clip = std::make_shared<AnimationClip>();
+    clip->name = "walk";
+    clip->duration = 1.0f;
+    clip->ticks_per_second = 1.0f;
+    for (const Bone& bone : skeleton.getBones())
+    {
+        BoneAnimation channel;
+        channel.bone_index = bone.id;
+        channel.bone_name = bone.name;
+        clip->channels.push_back(channel);
+    }
+
+    const float stride = glm::radians(WALK_STRIDE_DEGREES);
+    constexpr int KEYS = 64;
+    for (int k = 0; k <= KEYS; ++k)
+    {
+        const float t = static_cast<float>(k) / static_cast<float>(KEYS);
+        const float phase = t < 0.5f ? t * 2.0f : (t - 0.5f) * 2.0f;   // 0..1 within each half cycle
+        const float stance_angle = stride * (1.0f - 2.0f * phase);    // forward to back
+        const float swing_angle = -stance_angle;
+        const float swing_knee = glm::radians(50.0f) * std::sin(phase * glm::pi<float>());
+        const bool left_stance = t < 0.5f;
+
+        for (BoneAnimation& channel : clip->channels)
+        {
+            const Bone& bone = skeleton.getBones()[channel.bone_index];
+            glm::vec3 position = glm::vec3(bone.local_transform[3]);
+            glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+            const bool left = bone.name.back() == 'l';
+            const bool stance = left == left_stance;
+            if (bone.name == "pelvis")
+                position.y = WALK_ANKLE + (WALK_THIGH + WALK_SHIN) * std::cos(stance_angle);
+            else if (bone.name.rfind("thigh", 0) == 0)
+                rotation = glm::angleAxis(stance ? stance_angle : swing_angle, glm::vec3(1.0f, 0.0f, 0.0f));
+            else if (bone.name.rfind("shin", 0) == 0 && !stance)
+                rotation = glm::angleAxis(-swing_knee, glm::vec3(1.0f, 0.0f, 0.0f));
+            channel.position_keys.push_back({t, position});
+            channel.rotation_keys.push_back({t, rotation});
+        }
+    }
+    return clip;
+}
+
+struct FootPlacementScene
+{
+    std::vector<entt::entity> characters;
+    glm::vec3 corner{0.0f};
+};
+
+// 500 walking characters on a tilted slab, each standing at the ground height under it
+static bool buildFootPlacementScene(world& w, FootPlacementScene& scene)
+{
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    ColliderComponent col;
+    col.shape_type = ColliderShapeType::Box;
+    col.box_half_extents = glm::vec3(80.0f, 1.0f, 80.0f);
+    auto ground_shape = PhysicsSystem::createShapeFromCollider(col, glm::vec3(1.0f));
+    auto ground = w.registry.create();
+    w.registry.emplace<TransformComponent>(ground, 0.0f, -1.0f, 0.0f);
+    if (!ground_shape || physics.createStaticBody(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(-6.0f, 0.0f, 10.0f), ground_shape, ground).IsInvalid())
+        return false;
+
+    auto skeleton = makeWalkSkeleton();
+    auto clip = makeWalkClip(*skeleton);
+    uint32_t seed = 12345u;
+    for (int x = 0; x < 25; ++x)
+    {
+        for (int z = 0; z < 20; ++z)
+        {
+            glm::vec3 position(static_cast<float>(x) * 4.0f - 48.0f, 0.0f, static_cast<float>(z) * 4.0f - 38.0f);
+            auto hit = physics.raycastClosest(position + glm::vec3(0.0f, 20.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 40.0f);
+            if (!hit.hit)
+                return false;
+            position.y = hit.hit_point.y;
+
+            auto e = w.registry.create();
+            auto& transform = w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+            seed = seed * 1664525u + 1013904223u;
+            transform.rotation.y = static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 360.0f;
+
+            auto& anim = w.registry.emplace<AnimationComponent>(e);
+            anim.skeleton = skeleton;
+            anim.addClip("walk", clip);
+            anim.blender.setLooping(true);
+            anim.playClip("walk");
+
+            auto& feet = w.registry.emplace<FootPlacementComponent>(e);
+            feet.setPelvis(*skeleton, "pelvis");
+            feet.addLeg(*skeleton, "thigh_l", "shin_l", "foot_l");
+            feet.addLeg(*skeleton, "thigh_r", "shin_r", "foot_r");
+            scene.characters.push_back(e);
+        }
+    }
+    scene.corner = glm::vec3(-48.0f, 2.0f, -38.0f);
+    return true;
+}
+
+static double stepFootPlacementScene(world& w, const glm::vec3& camera, const FootPlacementSettings& settings,
+                                     FootPlacementStats* stats = nullptr)
+{
+    const auto start = std::chrono::steady_clock::now();
+    FootPlacement::updateProbes(w.registry, w.getPhysicsSystem(), camera, settings, stats);
+    AnimationSystem::update(w.registry, 1.0f / 60.0f);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool testFootPlacementPlantsFeetOnSlope()
+{
+    const std::string name = "foot placement plants feet on slope";
+    constexpr int SETTLE_FRAMES = 30;
+    constexpr int MEASURE_FRAMES = 60;
+
+    ScopedJobSystem jobs;
+    world w;
+    w.initializePhysics();
+    FootPlacementScene scene;
+    if (!buildFootPlacementScene(w, scene))
+        return fail(name, "failed to build the sloped scene");
+
+    // Everything at full LOD: measure how far planted ankles end up from the ground
+    FootPlacementSettings all_full;
+    all_full.full_distance = 1.0e4f;
+    all_full.reduced_distance = 1.0e4f;
+    for (int i = 0; i < SETTLE_FRAMES; ++i)
+        stepFootPlacementScene(w, scene.corner, all_full);
+
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    double full_ms = 0.0;
+    double error_sum = 0.0;
+    double error_max = 0.0;
+    size_t samples = 0;
+    for (int i = 0; i < MEASURE_FRAMES; ++i)
+    {
+        full_ms += stepFootPlacementScene(w, scene.corner, all_full);
+
+        // Skip the frames around the stance switch, where both feet are in transition
+        const float t = std::fmod(static_cast<float>(SETTLE_FRAMES + i + 1) / 60.0f, 1.0f);
+        const float half = std::fmod(t, 0.5f);
+        if (half < 0.05f || half > 0.45f)
+            continue;
+        const int stance_foot = t < 0.5f ? 4 : 7;
+
+        for (entt::entity e : scene.characters)
+        {
+            const auto& anim = w.registry.get<AnimationComponent>(e);
+            const glm::mat4 model_to_world = w.registry.get<TransformComponent>(e).getTransformMatrix();
+            const glm::vec3 ankle = glm::vec3(model_to_world * anim.bone_matrices[stance_foot][3]);
+            auto hit = physics.raycastClosest(ankle + glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 4.0f);
+            if (!hit.hit)
+                return fail(name, "no ground under a planted foot");
+            const double error = std::abs(static_cast<double>(ankle.y - WALK_ANKLE - hit.hit_point.y));
+            error_sum += error;
+            error_max = std::max(error_max, error);
+            ++samples;
+        }
+    }
+
+    // Same scene seen from one corner: most characters drop to reduced or disabled IK
+    FootPlacementSettings lod;
+    FootPlacementStats stats;
+    double lod_ms = 0.0;
+    for (int i = 0; i < MEASURE_FRAMES; ++i)
+        lod_ms += stepFootPlacementScene(w, scene.corner, lod, &stats);
+
+    const double error_mean = samples ? error_sum / static_cast<double>(samples) : 1.0;
+    full_ms /= MEASURE_FRAMES;
+    lod_ms /= MEASURE_FRAMES;
+    std::cout << "  " << scene.characters.size() << " characters: planted ankle error mean " << error_mean * 100.0
+              << " cm, max " << error_max * 100.0 << " cm; all full " << full_ms << " ms/frame, LOD " << lod_ms
+              << " ms/frame (" << stats.full << " full, " << stats.reduced << " reduced, " << stats.disabled << " disabled)"
+              << std::endl;
+
+    if (samples == 0)
+        return fail(name, "no planted feet were measured");
+    if (error_mean > 0.02 || error_max > 0.05)
+        return fail(name, "planted feet are too far from the ground");
+    if (stats.full == 0 || stats.reduced == 0 || stats.disabled == 0)
+        return fail(name, "camera distance did not spread characters across IK LODs");
+    if (lod_ms >= full_ms)
+        return fail(name, "IK LOD did not reduce the per-frame cost");
+    return pass(name);
+}
+
+// T-pose humanoid, origin on the ground between the feet
+static std::shared_ptr<Skeleton> makeRagdollSkeleton()
+{
+    auto skeleton = std::make_shared<Skeleton>();
+    auto add = [&](const char* name, int parent, const glm::vec3& offset) {
+        Bone bone;
+        bone.id = skeleton->getBoneCount();
+        bone.parent_id = parent;
+        bone.name = name;
+        bone.local_transform = glm::translate(glm::mat4(1.0f), offset);
+        skeleton->addBone(bone);
+    };
+    add("root", -1, glm::vec3(0.0f));
+    add("pelvis", 0, glm::vec3(0.0f, 1.0f, 0.0f));
+    add("spine", 1, glm::vec3(0.0f, 0.2f, 0.0f));
+    add("neck", 2, glm::vec3(0.0f, 0.3f, 0.0f));
+    add("head", 3, glm::vec3(0.0f, 0.1f, 0.0f));
+    add("upperarm_l", 2, glm::vec3(-0.2f, 0.25f, 0.0f));
+    add("forearm_l", 5, glm::vec3(-0.3f, 0.0f, 0.0f));
+    add("hand_l", 6, glm::vec3(-0.25f, 0.0f, 0.0f));
+    add("upperarm_r", 2, glm::vec3(0.2f, 0.25f, 0.0f));
+    add("forearm_r", 8, glm::vec3(0.3f, 0.0f, 0.0f));
+    add("hand_r", 9, glm::vec3(0.25f, 0.0f, 0.0f));
+    add("thigh_l", 1, glm::vec3(-0.1f, 0.0f, 0.0f));
+    add("shin_l", 11, glm::vec3(0.0f, -0.45f, 0.0f));
+    add("foot_l", 12, glm::vec3(0.0f, -0.45f, 0.0f));
+    add("thigh_r", 1, glm::vec3(0.1f, 0.0f, 0.0f));
+    add("shin_r", 14, glm::vec3(0.0f, -0.45f, 0.0f));
+    add("foot_r", 15, glm::vec3(0.0f, -0.45f, 0.0f));
+    return skeleton;
+}
+
+static std::shared_ptr<RagdollProfile> makeRagdollProfile()
+{
+    auto profile = std::make_shared<RagdollProfile>();
+    auto add = [&](const char* bone, const char* end_bone, float radius, float swing, float twist) {
+        RagdollBoneDesc desc;
+        desc.bone = bone;
+        desc.end_bone = end_bone;
+        desc.radius = radius;
+        desc.swing_limit_degrees = swing;
+        desc.twist_min_degrees = -twist;
+        desc.twist_max_degrees = twist;
+        profile->bones.push_back(desc);
+    };
+    add("pelvis", "spine", 0.12f, 0.0f, 0.0f);
+    add("spine", "neck", 0.12f, 20.0f, 15.0f);
+    add("head", "", 0.1f, 40.0f, 40.0f);
+    add("upperarm_l", "", 0.05f, 80.0f, 30.0f);
+    add("forearm_l", "hand_l", 0.045f, 60.0f, 10.0f);
+    add("upperarm_r", "", 0.05f, 80.0f, 30.0f);
+    add("forearm_r", "hand_r", 0.045f, 60.0f, 10.0f);
+    add("thigh_l", "", 0.07f, 45.0f, 15.0f);
+    add("shin_l", "foot_l", 0.06f, 60.0f, 5.0f);
+    add("thigh_r", "", 0.07f, 45.0f, 15.0f);
+    add("shin_r", "foot_r", 0.06f, 60.0f, 5.0f);
+    return profile;
+}
+
+static void addRagdollGround(world& w, float half_extent)
+{
+    ColliderComponent ground_col;
+    ground_col.shape_type = ColliderShapeType::Box;
+    ground_col.box_half_extents = glm::vec3(half_extent, 0.5f, half_extent);
+    auto ground = w.registry.create();
+    w.registry.emplace<TransformComponent>(ground, 0.0f, -0.5f, 0.0f);
+    w.getPhysicsSystem().createStaticBody(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f),
+        PhysicsSystem::createShapeFromCollider(ground_col, glm::vec3(1.0f)), ground);
+}
+
+static entt::entity addRagdollCharacter(world& w, const std::shared_ptr<Skeleton>& skeleton,
+                                        const std::shared_ptr<RagdollProfile>& profile, const glm::vec3& position,
+                                        float motor_strength)
+{
+    auto e = w.registry.create();
+    w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+    w.registry.emplace<AnimationComponent>(e).skeleton = skeleton;
+    auto& ragdoll = w.registry.emplace<RagdollComponent>(e);
+    ragdoll.profile = profile;
+    ragdoll.motor_strength = motor_strength;
+    ragdoll.simulate = true;
+    return e;
+}
+
+static double stepRagdollScene(world& w, const glm::vec3& camera, const RagdollLodSettings& settings,
+                               RagdollStats* stats = nullptr)
+{
+    constexpr float FRAME_DT = 1.0f / 60.0f;
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    const auto start = std::chrono::steady_clock::now();
+    physics.stepPhysics(w.registry);
+    physics.updateRagdolls(w.registry, camera, FRAME_DT, settings, stats);
+    AnimationSystem::update(w.registry, FRAME_DT);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static float jointAngleDegrees(const glm::quat& a, const glm::quat& b)
+{
+    const float d = std::min(std::abs(glm::dot(glm::normalize(a), glm::normalize(b))), 1.0f);
+    return glm::degrees(2.0f * std::acos(d));
+}
+
+static bool testRagdollDropBudgetAndStability()
+{
+    const std::string name = "ragdoll drop budget and stability";
+    constexpr int GRID_X = 20;
+    constexpr int GRID_Z = 10;
+    constexpr int RAGDOLL_COUNT = GRID_X * GRID_Z;
+    constexpr int DROP_FRAMES = 480;           // Long enough for the fully simulated rows to fall asleep
+    constexpr int HOLD_FRAMES = 60;
+
+    PhysicsSystemSettings settings;
+    settings.max_bodies = 8192;
+    settings.max_body_pairs = 65536;
+    settings.max_contact_constraints = 65536;
+    settings.temp_allocator_size_bytes = 64u * 1024u * 1024u;
+    world w(settings);
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    addRagdollGround(w, 60.0f);
+
+    auto skeleton = makeRagdollSkeleton();
+    auto profile = makeRagdollProfile();
+    physics.prewarmRagdolls(skeleton, profile, RAGDOLL_COUNT);
+    if (physics.getRagdolls().getPooledCount() != RAGDOLL_COUNT)
+        return fail(name, "prewarm did not fill the pool");
+
+    std::vector<entt::entity> ragdolls;
+    for (int x = 0; x < GRID_X; ++x)
+    {
+        for (int z = 0; z < GRID_Z; ++z)
+        {
+            const glm::vec3 position(static_cast<float>(x) * 2.0f - 19.0f, 1.0f, static_cast<float>(z) * 2.0f - 9.0f);
+            ragdolls.push_back(addRagdollCharacter(w, skeleton, profile, position, 0.0f));
+        }
+    }
+
+    // Camera at one end of the field: the near rows simulate fully, the far rows reduced
+    const glm::vec3 camera(-28.0f, 3.0f, 0.0f);
+    RagdollLodSettings lod;
+    RagdollStats first_stats;
+    RagdollStats stats;
+    double drop_ms = stepRagdollScene(w, camera, lod, &first_stats);
+    for (int i = 1; i < DROP_FRAMES; ++i)
+        drop_ms += stepRagdollScene(w, camera, lod, &stats);
+    drop_ms /= DROP_FRAMES;
+
+    if (first_stats.instances != RAGDOLL_COUNT || first_stats.created != 0)
+        return fail(name, "ragdolls were not taken from the prewarmed pool");
+    if (stats.full == 0 || stats.reduced == 0)
+        return fail(name, "camera distance did not spread ragdolls across LODs");
+    if (stats.awake != 0)
+        return fail(name, std::to_string(stats.awake) + " ragdolls still awake after settling");
+
+    // Ground plus one body per part of every ragdoll: nothing was built beyond the pool
+    JPH::PhysicsSystem& jolt = *physics.getJoltSystem();
+    const uint32_t parts = static_cast<uint32_t>(profile->bones.size());
+    if (jolt.GetNumBodies() != 1 + RAGDOLL_COUNT * parts)
+        return fail(name, "body count " + std::to_string(jolt.GetNumBodies()) + " after the drop");
+
+    std::vector<std::vector<glm::mat4>> settled;
+    for (entt::entity e : ragdolls)
+    {
+        const auto& anim = w.registry.get<AnimationComponent>(e);
+        const glm::mat4 model_to_world = w.registry.get<TransformComponent>(e).getTransformMatrix();
+        for (const glm::mat4& m : anim.bone_matrices)
+        {
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r)
+                    if (!std::isfinite(m[c][r]))
+                        return fail(name, "non-finite bone matrix");
+        }
+
+        // The pelvis must rest on the ground, not in it or above the drop height
+        const glm::vec3 pelvis = glm::vec3(model_to_world * anim.bone_matrices[1] * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        if (pelvis.y < 0.0f || pelvis.y > 1.0f)
+            return fail(name, "pelvis at height " + std::to_string(pelvis.y));
+        settled.push_back(anim.bone_matrices);
+    }
+
+    // Settled ragdolls stay asleep: no body enters the solver while they hold
+    double hold_ms = 0.0;
+    uint32_t hold_active_max = 0;
+    for (int i = 0; i < HOLD_FRAMES; ++i)
+    {
+        hold_ms += stepRagdollScene(w, camera, lod, &stats);
+        hold_active_max = std::max(hold_active_max, static_cast<uint32_t>(jolt.GetNumActiveBodies(JPH::EBodyType::RigidBody)));
+    }
+    hold_ms /= HOLD_FRAMES;
+
+    float drift = 0.0f;
+    for (size_t i = 0; i < ragdolls.size(); ++i)
+    {
+        const auto& anim = w.registry.get<AnimationComponent>(ragdolls[i]);
+        for (size_t b = 0; b < anim.bone_matrices.size(); ++b)
+            drift = std::max(drift, glm::length(glm::vec3(anim.bone_matrices[b][3] - settled[i][b][3])));
+    }
+
+    // Far away everything freezes
+    RagdollStats far_stats;
+    stepRagdollScene(w, glm::vec3(500.0f, 3.0f, 0.0f), lod, &far_stats);
+
+    // Released ragdolls go back to the pool, up to its cap, and are reused from there
+    for (int i = 0; i < 50; ++i)
+        w.registry.get<RagdollComponent>(ragdolls[i]).simulate = false;
+    RagdollStats release_stats;
+    stepRagdollScene(w, camera, lod, &release_stats);
+    for (int i = 0; i < 10; ++i)
+        w.registry.get<RagdollComponent>(ragdolls[i]).simulate = true;
+    RagdollStats reuse_stats;
+    stepRagdollScene(w, camera, lod, &reuse_stats);
+
+    std::cout << "  " << RAGDOLL_COUNT << " ragdolls: falling " << drop_ms << " ms/frame (" << stats.full << " full, "
+              << stats.reduced << " reduced), asleep " << hold_ms << " ms/frame, settled drift " << drift * 1000.0f
+              << " mm" << std::endl;
+
+    if (drift > 1.0e-4f)
+        return fail(name, "settled ragdolls drifted");
+    if (hold_active_max != 0 || stats.awake != 0)
+        return fail(name, std::to_string(hold_active_max) + " bodies woke up while the ragdolls held still");
+    if (far_stats.frozen != RAGDOLL_COUNT || far_stats.awake != 0)
+        return fail(name, "distant ragdolls were not frozen");
+    if (release_stats.instances != RAGDOLL_COUNT - 50 || release_stats.pooled != lod.max_pooled_per_profile)
+        return fail(name, "released ragdolls were not pooled up to the cap");
+    if (reuse_stats.created != 0)
+        return fail(name, "restarted ragdolls were not reused from the pool");
+
+    // Released ragdolls beyond the pool cap gave their bodies back to Jolt
+    const uint32_t live = RAGDOLL_COUNT - 50 + 10;
+    const uint32_t pooled = lod.max_pooled_per_profile - 10;
+    if (jolt.GetNumBodies() != 1 + (live + pooled) * parts)
+        return fail(name, "body count " + std::to_string(jolt.GetNumBodies()) + " after release and reuse");
+    return pass(name);
+}
+
+static bool testRagdollProfileNeedsSingleRoot()
+{
+    const std::string name = "ragdoll profile needs a single root";
+
+    world w;
+    w.initializePhysics();
+    auto skeleton = makeRagdollSkeleton();
+
+    auto valid = RagdollDefinition::build(*skeleton, *makeRagdollProfile(), PhysicsLayerSettings{});
+    if (!valid || valid->getJointCount() != makeRagdollProfile()->bones.size())
+        return fail(name, "valid profile did not build");
+
+    // The thigh has no ancestor among the parts, so it would be a second root next to the spine
+    RagdollProfile two_roots;
+    for (const char* bone : {"spine", "head", "thigh_l", "shin_l"})
+    {
+        RagdollBoneDesc desc;
+        desc.bone = bone;
+        two_roots.bones.push_back(desc);
+    }
+    if (RagdollDefinition::build(*skeleton, two_roots, PhysicsLayerSettings{}))
+        return fail(name, "profile with two root parts was accepted");
+
+    return pass(name);
+}
+
+static bool testRagdollMotorsHoldAnimatedPose()
+{
+    const std::string name = "ragdoll motors hold animated pose";
+    constexpr int FRAMES = 120;
+
+    world w;
+    w.initializePhysics();
+    addRagdollGround(w, 20.0f);
+
+    auto skeleton = makeRagdollSkeleton();
+    auto profile = makeRagdollProfile();
+    const entt::entity powered = addRagdollCharacter(w, skeleton, profile, glm::vec3(-3.0f, 0.05f, 0.0f), 1.0f);
+    const entt::entity limp = addRagdollCharacter(w, skeleton, profile, glm::vec3(3.0f, 0.05f, 0.0f), 0.0f);
+
+    const glm::vec3 camera(0.0f, 2.0f, -5.0f);
+    RagdollLodSettings lod;
+    for (int i = 0; i < FRAMES; ++i)
+        stepRagdollScene(w, camera, lod);
+
+    // Upper arm and forearm against the T-pose the animation asks for
+    auto armDeviation = [&](entt::entity e) {
+        const auto& ragdoll = w.registry.get<RagdollComponent>(e);
+        float deviation = 0.0f;
+        for (const char* bone : {"upperarm_l", "forearm_l", "upperarm_r", "forearm_r"})
+        {
+            const int index = skeleton->getBoneIndex(bone);
+            deviation = std::max(deviation, jointAngleDegrees(ragdoll.physics_pose[index].rotation,
+                                                              ragdoll.animated_pose[index].rotation));
+        }
+        return deviation;
+    };
+
+    if (!w.registry.get<RagdollComponent>(powered).has_physics_pose)
+        return fail(name, "no simulated pose was read back");
+
+    const float powered_deviation = armDeviation(powered);
+    const float limp_deviation = armDeviation(limp);
+    std::cout << "  arm deviation from the animated pose: powered " << powered_deviation << " deg, limp "
+              << limp_deviation << " deg" << std::endl;
+
+    if (powered_deviation > 15.0f)
+        return fail(name, "motors did not hold the animated pose");
+    if (limp_deviation < 30.0f)
+        return fail(name, "limp ragdoll kept its arms up");
+    return pass(name);
+}
+
+// 10,000 boxes in 100 clusters of 100, dropped onto a 400 m field
+struct SimulationLodScene
+{
+    std::vector<std::vector<entt::entity>> clusters;
+    std::vector<glm::vec3> centers;
+};
+
+static constexpr int SIM_LOD_CLUSTER_SIDE = 10;      // Clusters per row
+static constexpr float SIM_LOD_CLUSTER_SPACING = 40.0f;
+static constexpr float SIM_LOD_DROP_HEIGHT = 2.0f;
+
+static void buildSimulationLodScene(world& w, SimulationLodScene& scene)
+{
+    constexpr int BOX_SIDE = 5;
+    constexpr int BOX_LEVELS = 4;
+    PhysicsSystem& physics = w.getPhysicsSystem();
+
+    ColliderComponent ground_col;
+    ground_col.shape_type = ColliderShapeType::Box;
+    ground_col.box_half_extents = glm::vec3(220.0f, 0.5f, 220.0f);
+    ColliderComponent box_col;
+    box_col.shape_type = ColliderShapeType::Box;
+    box_col.box_half_extents = glm::vec3(0.25f);
+    auto ground_shape = PhysicsSystem::createShapeFromCollider(ground_col, glm::vec3(1.0f));
+    auto box_shape = PhysicsSystem::createShapeFromCollider(box_col, glm::vec3(1.0f));
+
+    auto ground = w.registry.create();
+    w.registry.emplace<TransformComponent>(ground, 0.0f, -0.5f, 0.0f);
+    physics.createStaticBody(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f), ground_shape, ground);
+
+    const float first = -0.5f * SIM_LOD_CLUSTER_SPACING * static_cast<float>(SIM_LOD_CLUSTER_SIDE - 1);
+    for (int cx = 0; cx < SIM_LOD_CLUSTER_SIDE; ++cx)
+    {
+        for (int cz = 0; cz < SIM_LOD_CLUSTER_SIDE; ++cz)
+        {
+            const glm::vec3 center(first + static_cast<float>(cx) * SIM_LOD_CLUSTER_SPACING, 0.0f,
+                                   first + static_cast<float>(cz) * SIM_LOD_CLUSTER_SPACING);
+            std::vector<entt::entity> cluster;
+            for (int level = 0; level < BOX_LEVELS; ++level)
+            {
+                for (int x = 0; x < BOX_SIDE; ++x)
+                {
+                    for (int z = 0; z < BOX_SIDE; ++z)
+                    {
+                        // Staggered by level so the piles topple instead of stacking neatly
+                        const float stagger = static_cast<float>(level % 2) * 0.3f;
+                        const glm::vec3 position = center + glm::vec3(static_cast<float>(x) * 0.6f - 1.2f + stagger,
+                            SIM_LOD_DROP_HEIGHT + static_cast<float>(level) * 0.6f, static_cast<float>(z) * 0.6f - 1.2f);
+                        auto e = w.registry.create();
+                        w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+                        w.registry.emplace<RigidBodyComponent>(e).mass = 1.0f;
+                        PhysicsSystem::PhysicsBodyDesc desc;
+                        desc.lock_rotation = false;
+                        physics.createDynamicBody(position, glm::vec3(0.0f), box_shape, e, desc);
+                        cluster.push_back(e);
+                    }
+                }
+            }
+            scene.clusters.push_back(std::move(cluster));
+            scene.centers.push_back(center);
+        }
+    }
+    physics.optimizeBroadPhase();
+}
+
+struct SimulationLodRun
+{
+    double ms_per_step = 0.0;
+    uint64_t final_hash = 0;
+    SimulationLodStats peak;                           // Stats of the step with the most frozen bodies
+    std::vector<std::vector<glm::vec3>> positions;     // Final body positions per cluster
+};
+
+// One observer sweeps along the first row of clusters, a second stands by a cluster near the middle
+static SimulationLodRun runSimulationLodScene(bool use_lod, int steps)
+{
+    PhysicsSystemSettings settings;
+    settings.max_bodies = 16384;
+    settings.max_body_pairs = 65536;
+    settings.max_contact_constraints = 65536;
+    settings.temp_allocator_size_bytes = 64u * 1024u * 1024u;
+    world w(settings);
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+
+    SimulationLodScene scene;
+    buildSimulationLodScene(w, scene);
+
+    SimulationLodSettings lod;
+    lod.enabled = use_lod;
+    lod.full_distance = 30.0f;
+    lod.reduced_distance = 80.0f;
+    physics.setSimulationLodSettings(lod);
+
+    const float row_z = scene.centers.front().z;
+    const glm::vec3 standing = scene.centers[5 * SIM_LOD_CLUSTER_SIDE + 5];
+    SimulationLodRun run;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(steps - 1);
+        const glm::vec3 observers[] = {glm::vec3(-200.0f + 400.0f * t, 2.0f, row_z), standing + glm::vec3(0.0f, 2.0f, 0.0f)};
+        physics.setSimulationLodObservers(observers, 2);
+        physics.stepPhysics(w.registry);
+        if (physics.getSimulationLodStats().frozen >= run.peak.frozen)
+            run.peak = physics.getSimulationLodStats();
+    }
+    run.ms_per_step = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / steps;
+    run.final_hash = physics.computeStateHash();
+
+    for (const auto& cluster : scene.clusters)
+    {
+        std::vector<glm::vec3> positions;
+        for (entt::entity e : cluster)
+            positions.push_back(w.registry.get<TransformComponent>(e).position);
+        run.positions.push_back(std::move(positions));
+    }
+    return run;
+}
+
+static bool testSimulationLodStepTime()
+{
+    const std::string name = "simulation LOD step time";
+    constexpr int STEPS = 360;
+
+    const SimulationLodRun full = runSimulationLodScene(false, STEPS);
+    const SimulationLodRun lod = runSimulationLodScene(true, STEPS);
+    const SimulationLodRun replay = runSimulationLodScene(true, STEPS);
+
+    std::cout << "  10000 bodies: no LOD " << full.ms_per_step << " ms/step, LOD " << lod.ms_per_step
+              << " ms/step (at most " << lod.peak.frozen << " frozen, " << lod.peak.reduced << " reduced, "
+              << lod.peak.full << " full)" << std::endl;
+
+    if (lod.peak.frozen == 0 || lod.peak.full == 0)
+        return fail(name, "observers did not spread bodies across LOD tiers");
+    if (lod.final_hash != replay.final_hash)
+        return fail(name, "two runs with the same observers diverged");
+
+    // The cluster the standing observer watches must behave exactly as without LOD
+    const size_t watched = 5 * SIM_LOD_CLUSTER_SIDE + 5;
+    float watched_deviation = 0.0f;
+    for (size_t i = 0; i < full.positions[watched].size(); ++i)
+        watched_deviation = std::max(watched_deviation, glm::length(lod.positions[watched][i] - full.positions[watched][i]));
+    if (watched_deviation > 1.0e-4f)
+        return fail(name, "bodies next to an observer moved differently, by " + std::to_string(watched_deviation));
+
+    // Clusters the sweeping observer passed fell; the far corner never saw anyone and hangs where it started
+    for (int cx = 0; cx < SIM_LOD_CLUSTER_SIDE; ++cx)
+    {
+        float lowest = std::numeric_limits<float>::max();
+        for (const glm::vec3& p : lod.positions[static_cast<size_t>(cx * SIM_LOD_CLUSTER_SIDE)])
+            lowest = std::min(lowest, p.y);
+        if (lowest > 0.5f)
+            return fail(name, "cluster " + std::to_string(cx) + " was not woken by the passing observer");
+    }
+    const size_t corner = SIM_LOD_CLUSTER_SIDE * SIM_LOD_CLUSTER_SIDE - 1;
+    for (const glm::vec3& p : lod.positions[corner])
+    {
+        if (p.y < SIM_LOD_DROP_HEIGHT - 0.01f)
+            return fail(name, "an unobserved cluster kept simulating");
+    }
+
+    if (lod.ms_per_step >= full.ms_per_step)
+        return fail(name, "LOD did not reduce the step time");
+    return pass(name);
+}
+
+static bool testSimulationLodWakesOnObserverAndContact()
+{
+    const std::string name = "simulation LOD wakes on observer and contact";
+    constexpr float FRAME_DT = 1.0f / 60.0f;
+
+    world w;
+    w.initializePhysics();
+    PhysicsSystem& physics = w.getPhysicsSystem();
+    addRagdollGround(w, 150.0f);
+
+    SimulationLodSettings lod;
+    lod.enabled = true;
+    lod.full_distance = 10.0f;
+    lod.reduced_distance = 30.0f;
+    physics.setSimulationLodSettings(lod);
+
+    ColliderComponent box_col;
+    box_col.shape_type = ColliderShapeType::Box;
+    box_col.box_half_extents = glm::vec3(0.5f);
+    auto box_shape = PhysicsSystem::createShapeFromCollider(box_col, glm::vec3(1.0f));
+    auto addBox = [&](const glm::vec3& position, bool kinematic) {
+        auto e = w.registry.create();
+        w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+        w.registry.emplace<RigidBodyComponent>(e).mass = 1.0f;
+        if (kinematic)
+            physics.createKinematicBody(position, glm::vec3(0.0f), box_shape, e);
+        else
+            physics.createDynamicBody(position, glm::vec3(0.0f), box_shape, e);
+        return e;
+    };
+
+    // A box thrown downward far away freezes mid-air, keeping its velocity
+    const entt::entity falling = addBox(glm::vec3(100.0f, 20.0f, 0.0f), false);
+    w.registry.get<RigidBodyComponent>(falling).velocity = glm::vec3(0.0f, -5.0f, 0.0f);
+    const entt::entity resting = addBox(glm::vec3(-100.0f, 0.5f, 0.0f), false);
+    const entt::entity pusher = addBox(glm::vec3(-104.0f, 0.5f, 0.0f), true);
+
+    glm::vec3 observer(0.0f, 2.0f, 0.0f);
+    physics.setSimulationLodObservers(&observer, 1);
+    for (int i = 0; i < 60; ++i)
+        physics.stepPhysics(w.registry);
+
+    if (physics.getSimulationLod(falling) != SimulationLod::Frozen || physics.getSimulationLod(resting) != SimulationLod::Frozen)
+        return fail(name, "distant bodies were not frozen");
+    if (std::abs(w.registry.get<TransformComponent>(falling).position.y - 20.0f) > 0.2f)
+        return fail(name, "a frozen body kept falling");
+
+    // The observer walks over: the box carries on with the velocity it had
+    observer = glm::vec3(95.0f, 18.0f, 0.0f);
+    physics.setSimulationLodObservers(&observer, 1);
+    physics.stepPhysics(w.registry);
+    if (physics.getSimulationLodStats().resumed == 0 || physics.getSimulationLod(falling) != SimulationLod::Full)
+        return fail(name, "the approaching observer did not wake the frozen body");
+    const float resumed_speed = -w.registry.get<RigidBodyComponent>(falling).velocity.y;
+    if (resumed_speed < 5.0f || resumed_speed > 5.5f)
+        return fail(name, "the woken body lost its velocity (" + std::to_string(resumed_speed) + " m/s)");
+    for (int i = 0; i < 180; ++i)
+        physics.stepPhysics(w.registry);
+    if (w.registry.get<TransformComponent>(falling).position.y > 1.0f)
+        return fail(name, "the woken body did not land");
+
+    // A kinematic pusher walks into the resting box, still far from the observer
+    uint32_t woken = 0;
+    for (int i = 0; i < 120; ++i)
+    {
+        w.registry.get<TransformComponent>(pusher).position.x += 3.0f * FRAME_DT;
+        physics.stepPhysics(w.registry);
+        woken += physics.getSimulationLodStats().woken;
+    }
+    const float pushed = w.registry.get<TransformComponent>(resting).position.x + 100.0f;
+    if (woken == 0 || pushed < 1.0f)
+        return fail(name, "a contact did not wake the frozen body");
+
+    // Once the pusher stops the box comes to rest and is held again
+    for (int i = 0; i < 120; ++i)
+        physics.stepPhysics(w.registry);
+    if (physics.getSimulationLodStats().frozen_awake != 0)
+        return fail(name, "the pushed body did not settle back into the frozen tier");
+
+    // Observers gone: everything is simulated in full again
+    physics.setSimulationLodObservers(nullptr, 0);
+    physics.stepPhysics(w.registry);
+    if (physics.getSimulationLod(resting) != SimulationLod::Full)
+        return fail(name, "clearing the observers did not restore full simulation");
+    return pass(name);
+}
+
+struct LoggedPhysicsInput
+{
+    uint32_t tick = 0;
+    size_t body = 0;
+    glm::vec3 force{0.0f};
+};
+
+static std::vector<LoggedPhysicsInput> makeDeterminismInputLog()
+{
+    std::vector<LoggedPhysicsInput> log;
+    for (uint32_t tick = 1; tick <= 150; tick += 7)
+    {
+        const size_t body = tick % 8;
+        const float side = (tick % 2 == 0) ? 1.0f : -1.0f;
+        log.push_back({ tick, body, glm::vec3(side * 40.0f, 90.0f, 0.3f * static_cast<float>(tick % 5)) });
+    }
+    return log;
+}
+
+// A ground slab and a stack of tumbling boxes, rebuilt identically for every run
+static bool buildDeterminismScene(world& w, std::vector<entt::entity>& bodies)
+{
+    w.initializePhysics();
+    w.getPhysicsSystem().setDeterminismChecks(true);
+
+    ColliderComponent ground_col;
+    ground_col.shape_type = ColliderShapeType::Box;
+    ground_col.box_half_extents = glm::vec3(20.0f, 0.5f, 20.0f);
+    auto ground_shape = PhysicsSystem::createShapeFromCollider(ground_col, glm::vec3(1.0f));
+    auto box_shape = makeBoxShape();
+    if (!ground_shape || !box_shape)
+        return false;
+
+    auto ground = w.registry.create();
+    w.registry.emplace<TransformComponent>(ground, 0.0f, -0.5f, 0.0f);
+    if (w.getPhysicsSystem().createStaticBody(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f), ground_shape, ground).IsInvalid())
+        return false;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const glm::vec3 position(static_cast<float>(i % 3) * 1.1f - 1.1f, 1.0f + static_cast<float>(i) * 1.05f,
+            static_cast<float>(i / 3) * 1.1f);
+        auto e = w.registry.create();
+        w.registry.emplace<TransformComponent>(e, position.x, position.y, position.z);
+        auto& rb = w.registry.emplace<RigidBodyComponent>(e);
+        rb.mass = 1.0f;
+
+        PhysicsSystem::PhysicsBodyDesc desc;
+        desc.mass = rb.mass;
+        desc.friction = 0.5f;
+        desc.lock_rotation = false;
+        if (w.getPhysicsSystem().createDynamicBody(position, glm::vec3(0.0f, static_cast<float>(i) * 15.0f, 0.0f),
+                box_shape, e, desc).IsInvalid())
+            return false;
+        bodies.push_back(e);
+    }
+    return true;
+}
+
+static void stepDeterminismScene(world& w, const std::vector<entt::entity>& bodies,
+    const std::vector<LoggedPhysicsInput>& log, uint32_t tick)
+{
+    for (const LoggedPhysicsInput& input : log)
+    {
+        if (input.tick == tick)
+            w.registry.get<RigidBodyComponent>(bodies[input.body]).force += input.force;
+    }
+    w.getPhysicsSystem().stepPhysics(w.registry);
+    w.getPhysicsSystem().recordStateHash(tick);
+}
+
+static bool testPhysicsDeterminismLoopback()
+{
+    const std::string name = "physics determinism loopback";
+    constexpr uint32_t TICKS = 180;
+    constexpr uint32_t PERTURBED_TICK = 60;
+
+    // "Server" and "client" replay the same log; the third run gets one input wrong
+    PhysicsSystemSettings client_settings;
+    client_settings.worker_thread_count = 3;
+    world server;
+    world client(client_settings);
+    world diverged;
+    std::vector<entt::entity> server_bodies;
+    std::vector<entt::entity> client_bodies;
+    std::vector<entt::entity> diverged_bodies;
+    if (!buildDeterminismScene(server, server_bodies) ||
+        !buildDeterminismScene(client, client_bodies) ||
+        !buildDeterminismScene(diverged, diverged_bodies))
+        return fail(name, "failed to build scene");
+
+    const std::vector<LoggedPhysicsInput> log = makeDeterminismInputLog();
+    std::vector<LoggedPhysicsInput> diverged_log = log;
+    diverged_log.push_back({ PERTURBED_TICK, 3, glm::vec3(0.0f, 0.0f, 0.01f) });
+
+    PhysicsDesyncDetector loopback;
+    PhysicsDesyncDetector perturbed;
+    uint64_t first_hash = 0;
+    bool hash_changed = false;
+    for (uint32_t tick = 1; tick <= TICKS; ++tick)
+    {
+        stepDeterminismScene(server, server_bodies, log, tick);
+        stepDeterminismScene(client, client_bodies, log, tick);
+        stepDeterminismScene(diverged, diverged_bodies, diverged_log, tick);
+
+        uint64_t server_hash = 0;
+        uint64_t client_hash = 0;
+        uint64_t diverged_hash = 0;
+        if (!server.getPhysicsSystem().getStateHash(tick, server_hash) ||
+            !client.getPhysicsSystem().getStateHash(tick, client_hash) ||
+            !diverged.getPhysicsSystem().getStateHash(tick, diverged_hash))
+            return fail(name, "state hash was not recorded for tick " + std::to_string(tick));
+
+        if (tick == 1)
+            first_hash = server_hash;
+        hash_changed = hash_changed || server_hash != first_hash;
+
+        loopback.compare(tick, server_hash, client_hash);
+        perturbed.compare(tick, server_hash, diverged_hash);
+    }
+
+    if (!hash_changed)
+        return fail(name, "state hash did not change while bodies moved");
+    if (loopback.hasDesync())
+        return fail(name, "identical input logs diverged at tick " + std::to_string(loopback.getReport().tick));
+    if (loopback.getReport().comparisons != TICKS)
+        return fail(name, "not every tick was compared");
+    if (!perturbed.hasDesync())
+        return fail(name, "perturbed input log was not detected");
+    if (perturbed.getReport().tick != PERTURBED_TICK || perturbed.getReport().last_matching_tick != PERTURBED_TICK - 1)
+        return fail(name, "first divergent tick was " + std::to_string(perturbed.getReport().tick));
+
+    return pass(name);
+}
+
 static bool testFpsShooterLevelReferences(const fs::path& repo_root)
 {
     const std::string name = "FPSShooter level references";
@@ -1151,6 +2498,32 @@ int main()
     ok = testLevelTerrainCreatesMeshAndCollision(repo_root) && ok;
     run("raycast closest ignores shooter body");
     ok = testRaycastClosestCanIgnoreShooterBody() && ok;
+    run("scene query queue budget and priority");
+    ok = testSceneQueryQueueBudgetAndPriority() && ok;
+    run("scene query batch matches synchronous raycasts");
+    ok = testSceneQueryBatchMatchesSynchronousRaycasts() && ok;
+    run("collision layer matrix and query masks");
+    ok = testCollisionLayerMatrixAndQueryMasks() && ok;
+    run("debris layer benchmark");
+    ok = testDebrisLayerBenchmark() && ok;
+    run("foot placement plants feet on slope");
+    ok = testFootPlacementPlantsFeetOnSlope() && ok;
+    run("ragdoll drop budget and stability");
+    ok = testRagdollDropBudgetAndStability() && ok;
+    run("ragdoll profile needs a single root");
+    ok = testRagdollProfileNeedsSingleRoot() && ok;
+    run("ragdoll motors hold animated pose");
+    ok = testRagdollMotorsHoldAnimatedPose() && ok;
+    run("simulation LOD step time");
+    ok = testSimulationLodStepTime() && ok;
+    run("simulation LOD wakes on observer and contact");
+    ok = testSimulationLodWakesOnObserverAndContact() && ok;
+    run("memory tracker attributes tags");
+    ok = testMemoryTrackerAttributesTags() && ok;
+    run("memory tracker charges Jolt to physics");
+    ok = testMemoryTrackerChargesJoltToPhysics() && ok;
+    run("physics determinism loopback");
+    ok = testPhysicsDeterminismLoopback() && ok;
     run("FPSShooter level references");
     ok = testFpsShooterLevelReferences(repo_root) && ok;
     run("ThirdPerson template references");
@@ -0,0 +1,77 @@
+// Minimal game module for the ReflectionTests hot-reload case. Built twice:
+// v2 drops "regen", adds "armor" and changes "label" from string to int, the
+// same changes as the ModuleHealthV1/V2 pair in the test itself.
+#include "Plugin/GameModuleAPI.h"
+#include "Reflection/Reflect.hpp"
+#include "Reflection/ReflectionRegistry.hpp"
+
+#include <string>
+
+namespace
+{
+#if RELOAD_MODULE_VERSION == 1
+    struct ReloadModuleHealthV1
+    {
+        float hp = 100.0f;
+        float regen = 2.0f;
+        int kills = 0;
+        std::string label = "grunt";
+
+        static void reflect(Reflector<ReloadModuleHealthV1>& r)
+        {
+            r.field<&ReloadModuleHealthV1::hp>("hp");
+            r.field<&ReloadModuleHealthV1::regen>("regen");
+            r.field<&ReloadModuleHealthV1::kills>("kills");
+            r.field<&ReloadModuleHealthV1::label>("label");
+        }
+    };
+    using ReloadModuleHealth = ReloadModuleHealthV1;
+#else
+    struct ReloadModuleHealthV2
+    {
+        float hp = 100.0f;
+        int kills = 0;
+        int armor = 5;
+        int label = 7;
+
+        static void reflect(Reflector<ReloadModuleHealthV2>& r)
+        {
+            r.field<&ReloadModuleHealthV2::hp>("hp");
+            r.field<&ReloadModuleHealthV2::kills>("kills");
+            r.field<&ReloadModuleHealthV2::armor>("armor");
+            r.field<&ReloadModuleHealthV2::label>("label");
+        }
+    };
+    using ReloadModuleHealth = ReloadModuleHealthV2;
+#endif
+}
+
+GAME_API int32_t gardenGetAPIVersion()
+{
+    return GARDEN_MODULE_API_VERSION;
+}
+
+GAME_API const char* gardenGetGameName()
+{
+    return "ReflectionReloadModule";
+}
+
+GAME_API bool gardenGameInit(EngineServices* services)
+{
+    (void)services;
+    return true;
+}
+
+GAME_API void gardenGameShutdown()
+{
+}
+
+GAME_API void gardenRegisterComponents(ReflectionRegistry* registry)
+{
+    registry->reflect<ReloadModuleHealth>("ModuleHealth", "ReflectionReloadModule");
+}
+
+GAME_API void gardenGameUpdate(float delta_time)
+{
+    (void)delta_time;
+}
@@ -3,6 +3,9 @@
 #include "Reflection/ReflectionPropertyOps.hpp"
 #include "Reflection/ReflectionRegistry.hpp"
 #include "Reflection/ReflectionSerializer.hpp"
+#include "Plugin/GameModuleLoader.hpp"
+#include "Plugin/ModuleStateSnapshot.hpp"
+#include "Utils/EnginePaths.hpp"
 #include "LevelManager.hpp"
 
 #include <cmath>
@@ -14,6 +17,7 @@
 #include <iostream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace
 {
@@ -53,6 +57,40 @@ namespace
         }
     };
 
+    // The same game component as compiled into two builds of a module:
+    // v2 drops "regen", adds "armor" and changes "label" from string to int.
+    struct ModuleHealthV1
+    {
+        float hp = 100.0f;
+        float regen = 2.0f;
+        int kills = 0;
+        std::string label = "grunt";
+
+        static void reflect(Reflector<ModuleHealthV1>& r)
+        {
+            r.field<&ModuleHealthV1::hp>("hp");
+            r.field<&ModuleHealthV1::regen>("regen");
+            r.field<&ModuleHealthV1::kills>("kills");
+            r.field<&ModuleHealthV1::label>("label");
+        }
+    };
+
+    struct ModuleHealthV2
+    {
+        float hp = 100.0f;
+        int kills = 0;
+        int armor = 5;
+        int label = 7;
+
+        static void reflect(Reflector<ModuleHealthV2>& r)
+        {
+            r.field<&ModuleHealthV2::hp>("hp");
+            r.field<&ModuleHealthV2::kills>("kills");
+            r.field<&ModuleHealthV2::armor>("armor");
+            r.field<&ModuleHealthV2::label>("label");
+        }
+    };
+
     bool approx(float a, float b, float epsilon = 0.001f)
     {
         return std::abs(a - b) <= epsilon;
@@ -239,6 +277,72 @@ namespace
         return pass(name);
     }
 
+    bool testLevelRoundTripRemapsEntityReferences()
+    {
+        const std::string name = "level round trip remaps entity references";
+
+        ReflectionRegistry reflection;
+        registerEngineReflection(reflection);
+
+        // Non-contiguous source ids: the destroyed entity leaves a hole
+        entt::registry registry;
+        entt::entity root = registry.create();
+        entt::entity removed = registry.create();
+        entt::entity child = registry.create();
+        entt::entity grandchild = registry.create();
+        registry.destroy(removed);
+
+        registry.emplace<TagComponent>(root, TagComponent{"Root"});
+        registry.emplace<TagComponent>(child, TagComponent{"Child"});
+        registry.emplace<TagComponent>(grandchild, TagComponent{"Grandchild"});
+        registry.emplace<HierarchyComponent>(child).parent = root;
+        registry.emplace<HierarchyComponent>(grandchild).parent = child;
+
+        // Referencing an entity outside the saved level clears the reference on load
+        entt::entity orphan = registry.create();
+        registry.emplace<TagComponent>(orphan, TagComponent{"Orphan"});
+        registry.emplace<HierarchyComponent>(orphan).parent = static_cast<entt::entity>(4000u);
+
+        const nlohmann::json level_json = ReflectionSerializer::serializeLevel(registry, reflection);
+
+        // Entities already in the target shift every id the level creates
+        entt::registry loaded_registry;
+        for (int i = 0; i < 5; ++i)
+            loaded_registry.emplace<TagComponent>(loaded_registry.create(), TagComponent{"Existing"});
+        ReflectionSerializer::deserializeLevel(loaded_registry, level_json, reflection);
+
+        auto find = [&](const char* tag) {
+            for (auto [entity, tag_component] : loaded_registry.view<TagComponent>().each())
+            {
+                if (tag_component.name == tag)
+                    return entity;
+            }
+            return entt::entity{entt::null};
+        };
+
+        const entt::entity loaded_root = find("Root");
+        const entt::entity loaded_child = find("Child");
+        const entt::entity loaded_grandchild = find("Grandchild");
+        const entt::entity loaded_orphan = find("Orphan");
+        if (loaded_root == entt::null || loaded_child == entt::null || loaded_grandchild == entt::null ||
+            loaded_orphan == entt::null)
+            return fail(name, "level entities were not loaded");
+        if (loaded_child == child)
+            return fail(name, "loaded ids match the source, remapping was not exercised");
+
+        const auto* child_node = loaded_registry.try_get<HierarchyComponent>(loaded_child);
+        const auto* grandchild_node = loaded_registry.try_get<HierarchyComponent>(loaded_grandchild);
+        const auto* orphan_node = loaded_registry.try_get<HierarchyComponent>(loaded_orphan);
+        if (!child_node || !grandchild_node || !orphan_node)
+            return fail(name, "hierarchy components were not loaded");
+        if (child_node->parent != loaded_root || grandchild_node->parent != loaded_child)
+            return fail(name, "parents were not remapped to the loaded entities");
+        if (orphan_node->parent != entt::null)
+            return fail(name, "reference outside the level was not cleared");
+
+        return pass(name);
+    }
+
     bool testWaterComponentReflectionAndObjectVectorJson()
     {
         const std::string name = "water component reflection and object vector json";
@@ -363,6 +467,188 @@ namespace
     }
 }
 
+namespace
+{
+    bool testModuleStateSurvivesHotReload()
+    {
+        const std::string name = "module state survives hot reload";
+
+        ReflectionRegistry reflection;
+        reflection.reflect<TestComponent>("TestComponent", "engine");
+        reflection.reflect<ModuleHealthV1>("ModuleHealth", "TestGame");
+        const uint32_t v1_type = entt::type_hash<ModuleHealthV1>::value();
+
+        entt::registry registry;
+        std::vector<entt::entity> entities;
+        for (int i = 0; i < 3; ++i)
+        {
+            entt::entity e = registry.create();
+            auto& health = registry.emplace<ModuleHealthV1>(e);
+            health.hp = 50.0f + 10.0f * i;
+            registry.emplace<TestComponent>(e).speed = 3.0f;
+            entities.push_back(e);
+        }
+
+        // v1 simulation: take damage, score kills
+        auto tick_v1 = [&registry]() {
+            for (auto [e, health] : registry.view<ModuleHealthV1>().each())
+            {
+                health.hp -= 1.5f;
+                health.kills++;
+            }
+        };
+        for (int frame = 0; frame < 10; ++frame)
+            tick_v1();
+
+        // Unload: capture module-owned types only, then drop their storage
+        ModuleStateSnapshot snapshot;
+        size_t captured = snapshot.captureAndRelease({ &registry }, reflection, { v1_type });
+        reflection.unregisterBySource("TestGame");
+
+        if (captured != 3)
+            return fail(name, "expected 3 captured components, got " + std::to_string(captured));
+        if (registry.storage(v1_type) != nullptr)
+            return fail(name, "module component storage was not released");
+        if (!registry.all_of<TestComponent>(entities[0]) || !approx(registry.get<TestComponent>(entities[0]).speed, 3.0f))
+            return fail(name, "engine component was touched by the snapshot");
+
+        // Load: the new build registers its own type under the same serialized name
+        reflection.reflect<ModuleHealthV2>("ModuleHealth", "TestGame");
+        ModuleStateRestoreStats stats = snapshot.restore(reflection);
+
+        if (stats.components_restored != 3 || stats.components_dropped != 0)
+            return fail(name, "restore counts mismatch");
+        if (stats.fields_defaulted != 3 || stats.fields_discarded != 3 || stats.fields_rejected != 3)
+            return fail(name, "field tolerance counts mismatch");
+        if (!snapshot.empty())
+            return fail(name, "snapshot not cleared after restore");
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto* health = registry.try_get<ModuleHealthV2>(entities[i]);
+            if (!health)
+                return fail(name, "component missing after restore");
+            if (!approx(health->hp, 50.0f + 10.0f * i - 15.0f) || health->kills != 10)
+                return fail(name, "simulated state lost across reload");
+            if (health->armor != 5 || health->label != 7)
+                return fail(name, "new or retyped fields did not keep their defaults");
+        }
+
+        // Simulation continues on the new code from where it left off
+        for (auto [e, health] : registry.view<ModuleHealthV2>().each())
+        {
+            health.hp -= 1.5f;
+            health.kills++;
+        }
+        if (!approx(registry.get<ModuleHealthV2>(entities[0]).hp, 33.5f) ||
+            registry.get<ModuleHealthV2>(entities[0]).kills != 11)
+            return fail(name, "simulation did not resume from restored state");
+
+        // An entity destroyed while the module was unloaded is dropped, not resurrected
+        snapshot.captureAndRelease({ &registry }, reflection, { entt::type_hash<ModuleHealthV2>::value() });
+        registry.destroy(entities[1]);
+        stats = snapshot.restore(reflection);
+        if (stats.components_restored != 2 || stats.components_dropped != 1)
+            return fail(name, "destroyed entity was not skipped");
+
+        return pass(name);
+    }
+}
+
+namespace
+{
+    // ReloadModule/ builds both versions next to this executable
+    std::string reloadModulePath(const char* name)
+    {
+#ifdef _WIN32
+        return (EnginePaths::getExecutableDir() / (std::string(name) + ".dll")).string();
+#elif defined(__APPLE__)
+        return (EnginePaths::getExecutableDir() / ("lib" + std::string(name) + ".dylib")).string();
+#else
+        return (EnginePaths::getExecutableDir() / ("lib" + std::string(name) + ".so")).string();
+#endif
+    }
+
+    bool testModuleLoaderReloadPreservesState()
+    {
+        const std::string name = "module loader reload preserves state";
+
+        const std::string v1_path = reloadModulePath("ReflectionReloadModuleV1");
+        const std::string v2_path = reloadModulePath("ReflectionReloadModuleV2");
+        if (!std::filesystem::exists(v1_path) || !std::filesystem::exists(v2_path))
+            return fail(name, "reload test modules not built next to the test: " + v1_path);
+
+        // The loader unregisters through the reflection registry, and the module's
+        // component pools must be gone before its code is unmapped
+        ReflectionRegistry reflection;
+        registerEngineReflection(reflection);
+        GameModuleLoader loader;
+        entt::registry registry;
+
+        if (!loader.load(v1_path))
+            return fail(name, "failed to load the v1 module");
+        loader.registerComponents(&reflection);
+        const ComponentDescriptor* v1 = reflection.findByName("ModuleHealth");
+        if (!v1 || loader.getRegisteredComponentTypes().size() != 1 ||
+            loader.getRegisteredComponentTypes()[0] != v1->type_id)
+            return fail(name, "loader did not track the module's component");
+        const uint32_t v1_type = v1->type_id;
+
+        std::vector<entt::entity> entities;
+        for (int i = 0; i < 3; ++i)
+        {
+            entt::entity e = registry.create();
+            registry.emplace<TransformComponent>(e).position.x = static_cast<float>(i);
+            v1->add(registry, e);
+            nlohmann::json fields;
+            fields["hp"] = 35.0f + 10.0f * i;
+            fields["kills"] = 10;
+            ReflectionSerializer::deserializeComponent(*v1, v1->get(registry, e), fields);
+            entities.push_back(e);
+        }
+
+        if (!loader.reload(v2_path, { &registry }))
+            return fail(name, "reload to the v2 module failed");
+
+        const ComponentDescriptor* v2 = reflection.findByName("ModuleHealth");
+        if (!v2 || v2->type_id == v1_type)
+            return fail(name, "v2 module did not register its own component type");
+        if (registry.storage(v1_type) != nullptr)
+            return fail(name, "v1 component storage outlived the v1 module");
+
+        const ModuleStateRestoreStats& stats = loader.getLastRestoreStats();
+        if (stats.components_restored != 3 || stats.components_dropped != 0)
+            return fail(name, "restore counts mismatch");
+        if (stats.fields_defaulted != 3 || stats.fields_discarded != 3 || stats.fields_rejected != 3)
+            return fail(name, "field tolerance counts mismatch");
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const void* health = v2->get(registry, entities[i]);
+            if (!health)
+                return fail(name, "component missing after reload");
+            const nlohmann::json fields = ReflectionSerializer::serializeComponent(*v2, health);
+            if (!approx(fields["hp"].get<float>(), 35.0f + 10.0f * i) || fields["kills"].get<int>() != 10)
+                return fail(name, "module state lost across reload");
+            if (fields["armor"].get<int>() != 5 || fields["label"].get<int>() != 7)
+                return fail(name, "new or retyped fields did not keep their defaults");
+            if (!approx(registry.get<TransformComponent>(entities[i]).position.x, static_cast<float>(i)))
+                return fail(name, "engine component was touched by the reload");
+        }
+
+        // A reload that fails leaves nothing of the module behind, not even its state
+        const uint32_t v2_type = v2->type_id;
+        if (loader.reload(v2_path + ".missing", { &registry }))
+            return fail(name, "reload from a missing file succeeded");
+        if (loader.isLoaded() || reflection.findByName("ModuleHealth") != nullptr)
+            return fail(name, "failed reload left the module registered");
+        if (registry.storage(v2_type) != nullptr)
+            return fail(name, "failed reload left the module's component storage");
+
+        return pass(name);
+    }
+}
+
 int main()
 {
     bool ok = true;
@@ -370,7 +656,10 @@ int main()
     ok = testComponentCopy() && ok;
     ok = testEntitySerializationRoundTrip() && ok;
     ok = testInvalidJsonDoesNotMutate() && ok;
+    ok = testLevelRoundTripRemapsEntityReferences() && ok;
     ok = testWaterComponentReflectionAndObjectVectorJson() && ok;
     ok = testReflectedLevelJsonMigration() && ok;
+    ok = testModuleStateSurvivesHotReload() && ok;
+    ok = testModuleLoaderReloadPreservesState() && ok;
     return ok ? 0 : 1;
 }
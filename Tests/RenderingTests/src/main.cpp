@@ -0,0 +1,2335 @@
+#include "Assets/AssetCompiler.hpp"
+#include "Components/Components.hpp"
+#include "Components/FoliageComponent.hpp"
+#include "Components/ParticleEmitterComponent.hpp"
+#include "Console/ConVar.hpp"
+#include "Decals/DecalSystem.hpp"
+#include "Graphics/BVH.hpp"
+#include "Graphics/DynamicResolution.hpp"
+#include "Graphics/GpuPassTimings.hpp"
+#include "Graphics/HeadlessRenderAPI.hpp"
+#include "Graphics/MeshBVH.hpp"
+#include "Graphics/RenderGraph/PostProcessGraphBuilder.hpp"
+#include "Graphics/RenderGraph/RenderGraph.hpp"
+#include "Graphics/ScenePicker.hpp"
+#include "Graphics/renderer.hpp"
+#include "Particles/ParticleSystem.hpp"
+#include "Threading/JobSystem.hpp"
+#include "UI/RmlUiManager.h"
+#include "Utils/Log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <RmlUi/Core.h>
+#include <SDL3/SDL.h>
+
+static bool approx(float a, float b, float epsilon = 0.01f)
+{
+    return std::abs(a - b) <= epsilon;
+}
+
+static bool fail(const std::string& name, const std::string& reason)
+{
+    std::cerr << "[FAIL] " << name << ": " << reason << std::endl;
+    return false;
+}
+
+static bool pass(const std::string& name)
+{
+    std::cout << "[PASS] " << name << std::endl;
+    return true;
+}
+
+static void run(const std::string& name)
+{
+    std::cout << "[RUN] " << name << std::endl;
+}
+
+static vertex makeVertex(const glm::vec3& p)
+{
+    vertex v{};
+    v.vx = p.x;
+    v.vy = p.y;
+    v.vz = p.z;
+    return v;
+}
+
+static void addQuad(std::vector<vertex>& out, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d)
+{
+    out.push_back(makeVertex(a));
+    out.push_back(makeVertex(b));
+    out.push_back(makeVertex(c));
+    out.push_back(makeVertex(a));
+    out.push_back(makeVertex(c));
+    out.push_back(makeVertex(d));
+}
+
+// Square frame in the XY plane: outer half-size 2, inner half-size 1 (a hole you can click through)
+static std::vector<vertex> makeRingVertices()
+{
+    std::vector<vertex> out;
+    addQuad(out, {-2, 1, 0}, {2, 1, 0}, {2, 2, 0}, {-2, 2, 0});       // top
+    addQuad(out, {-2, -2, 0}, {2, -2, 0}, {2, -1, 0}, {-2, -1, 0});   // bottom
+    addQuad(out, {-2, -1, 0}, {-1, -1, 0}, {-1, 1, 0}, {-2, 1, 0});   // left
+    addQuad(out, {1, -1, 0}, {2, -1, 0}, {2, 1, 0}, {1, 1, 0});       // right
+    return out;
+}
+
+// Cube with half-size 0.5 centered on the origin
+static std::vector<vertex> makeCubeVertices()
+{
+    const float h = 0.5f;
+    std::vector<vertex> out;
+    addQuad(out, {-h, -h, h}, {h, -h, h}, {h, h, h}, {-h, h, h});
+    addQuad(out, {h, -h, -h}, {-h, -h, -h}, {-h, h, -h}, {h, h, -h});
+    addQuad(out, {-h, -h, -h}, {-h, -h, h}, {-h, h, h}, {-h, h, -h});
+    addQuad(out, {h, -h, h}, {h, -h, -h}, {h, h, -h}, {h, h, h});
+    addQuad(out, {-h, h, h}, {h, h, h}, {h, h, -h}, {-h, h, -h});
+    addQuad(out, {-h, -h, -h}, {h, -h, -h}, {h, -h, h}, {-h, -h, h});
+    return out;
+}
+
+// Meshes do not own hardcoded vertex arrays, so keep them alive for the whole run
+static std::vector<vertex> g_ring_vertices = makeRingVertices();
+static std::vector<vertex> g_cube_vertices = makeCubeVertices();
+
+static entt::entity addEntity(entt::registry& registry, const std::shared_ptr<mesh>& m,
+                              const glm::vec3& position, const glm::vec3& rotation = glm::vec3(0.0f),
+                              const glm::vec3& scale = glm::vec3(1.0f))
+{
+    entt::entity e = registry.create();
+    auto& transform = registry.emplace<TransformComponent>(e);
+    transform.position = position;
+    transform.rotation = rotation;
+    transform.scale = scale;
+    registry.emplace<MeshComponent>(e, MeshComponent{ m });
+    return e;
+}
+
+// Camera at +Z looking down -Z, square aspect
+static glm::mat4 makeViewProjection()
+{
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0, 0, 10), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+    return projection * view;
+}
+
+static bool testMeshBVHRaycastMissesHole()
+{
+    const std::string name = "mesh BVH raycast misses hole";
+    MeshBVH bvh;
+    bvh.build(g_ring_vertices.data(), g_ring_vertices.size());
+    if (bvh.getTriangleCount() != 8)
+        return fail(name, "expected 8 triangles, got " + std::to_string(bvh.getTriangleCount()));
+
+    float t = 0.0f;
+    if (bvh.raycast(glm::vec3(0, 0, 10), glm::vec3(0, 0, -1), 100.0f, t))
+        return fail(name, "ray through the hole hit a triangle");
+    if (!bvh.raycast(glm::vec3(1.5f, 0, 10), glm::vec3(0, 0, -1), 100.0f, t))
+        return fail(name, "ray through the frame missed");
+    if (!approx(t, 10.0f))
+        return fail(name, "hit distance " + std::to_string(t));
+    if (bvh.raycast(glm::vec3(1.5f, 0, 10), glm::vec3(0, 0, -1), 5.0f, t))
+        return fail(name, "hit beyond max_t");
+    return pass(name);
+}
+
+static bool testPickThroughHoleSelectsObjectBehind()
+{
+    const std::string name = "pick through hole selects object behind";
+    entt::registry registry;
+    auto ring_mesh = std::make_shared<mesh>(g_ring_vertices.data(), g_ring_vertices.size());
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    const entt::entity ring = addEntity(registry, ring_mesh, glm::vec3(0, 0, 0));
+    const entt::entity cube = addEntity(registry, cube_mesh, glm::vec3(0, 0, -5));
+
+    SceneBVH bvh;
+    bvh.build(registry);
+
+    const glm::vec3 origin(0, 0, 10);
+    const glm::vec3 direction(0, 0, -1);
+
+    // Bounds-only picking stops at the ring's AABB
+    if (bvh.rayPick(origin, direction) != ring)
+        return fail(name, "expected bounds pick to return the ring");
+
+    ScenePicker picker;
+    PickResult result = picker.pick(registry, bvh, origin, direction);
+    if (result.entity != cube)
+        return fail(name, "expected the cube behind the ring");
+    if (!result.triangle_hit || !approx(result.distance, 14.5f))
+        return fail(name, "cube hit distance " + std::to_string(result.distance));
+
+    // Clicking the frame itself still selects the ring
+    result = picker.pick(registry, bvh, glm::vec3(1.5f, 0, 10), direction);
+    if (result.entity != ring)
+        return fail(name, "expected the ring when clicking its frame");
+
+    if (picker.getCachedMeshCount() != 2)
+        return fail(name, "expected one cached BVH per mesh");
+    return pass(name);
+}
+
+static bool testPickTransformedEntity()
+{
+    const std::string name = "pick transformed entity";
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    // Scaled to half-size 1 and turned 45 degrees so an edge faces the camera
+    const entt::entity cube = addEntity(registry, cube_mesh, glm::vec3(3, 0, 0), glm::vec3(0, 45, 0), glm::vec3(2.0f));
+
+    SceneBVH bvh;
+    bvh.build(registry);
+
+    ScenePicker picker;
+    PickResult result = picker.pick(registry, bvh, glm::vec3(3, 0, 10), glm::vec3(0, 0, -1));
+    if (result.entity != cube)
+        return fail(name, "missed the rotated cube");
+    if (!approx(result.distance, 10.0f - std::sqrt(2.0f)))
+        return fail(name, "distance " + std::to_string(result.distance));
+
+    // From above, through a corner of the world AABB that the rotated cube does not fill
+    result = picker.pick(registry, bvh, glm::vec3(3.0f + 1.2f, 10, 1.2f), glm::vec3(0, -1, 0));
+    if (result.entity != entt::null)
+        return fail(name, "picked the cube through its empty bounds corner");
+    return pass(name);
+}
+
+static bool testMarqueeSelectsByTriangles()
+{
+    const std::string name = "marquee selects by triangles";
+    entt::registry registry;
+    auto ring_mesh = std::make_shared<mesh>(g_ring_vertices.data(), g_ring_vertices.size());
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    const entt::entity ring = addEntity(registry, ring_mesh, glm::vec3(0, 0, 0));
+    const entt::entity cube = addEntity(registry, cube_mesh, glm::vec3(0, 0, -5));
+
+    SceneBVH bvh;
+    bvh.build(registry);
+    const glm::mat4 view_projection = makeViewProjection();
+
+    ScenePicker picker;
+    std::vector<entt::entity> selected;
+
+    // Inside the hole: the ring's bounds overlap the marquee but none of its triangles do
+    picker.marqueeSelect(registry, bvh, view_projection, glm::vec2(-0.1f), glm::vec2(0.1f), selected);
+    if (selected.size() != 1 || selected[0] != cube)
+        return fail(name, "hole marquee selected " + std::to_string(selected.size()) + " entities");
+
+    // Over the right edge of the frame, beside the cube
+    picker.marqueeSelect(registry, bvh, view_projection, glm::vec2(0.15f, -0.05f), glm::vec2(0.25f, 0.05f), selected);
+    if (selected.size() != 1 || selected[0] != ring)
+        return fail(name, "edge marquee selected " + std::to_string(selected.size()) + " entities");
+
+    // Whole screen takes both
+    picker.marqueeSelect(registry, bvh, view_projection, glm::vec2(-1.0f), glm::vec2(1.0f), selected);
+    if (selected.size() != 2)
+        return fail(name, "full-screen marquee selected " + std::to_string(selected.size()) + " entities");
+    return pass(name);
+}
+
+static bool testPickingScalesToLargeScenes()
+{
+    const std::string name = "picking scales to large scenes";
+    using clock = std::chrono::steady_clock;
+
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    auto ring_mesh = std::make_shared<mesh>(g_ring_vertices.data(), g_ring_vertices.size());
+    const int grid = 224;  // ~50k entities
+    for (int z = 0; z < grid; ++z)
+    {
+        for (int x = 0; x < grid; ++x)
+        {
+            const bool ring = ((x + z) & 1) == 0;
+            addEntity(registry, ring ? ring_mesh : cube_mesh,
+                      glm::vec3(x * 5.0f, 0.0f, -z * 5.0f), glm::vec3(0, (x * 37 + z * 11) % 90, 0));
+        }
+    }
+
+    SceneBVH bvh;
+    bvh.build(registry);
+    ScenePicker picker;
+
+    // Editor-like view: looking down over the field at ~45 degrees
+    const glm::vec3 direction = glm::normalize(glm::vec3(0.05f, -1.0f, -1.0f));
+    auto rayOrigin = [](int i, float extent) {
+        const float fx = static_cast<float>((i * 2654435761u) >> 8 & 0xFFFF) / 65535.0f;
+        const float fz = static_cast<float>((i * 40503u + 12345u) * 2246822519u >> 8 & 0xFFFF) / 65535.0f;
+        return glm::vec3(fx * extent, 20.0f, -fz * extent + 20.0f);
+    };
+
+    const int queries = 2000;
+    int bounds_hits = 0;
+    int triangle_hits = 0;
+
+    auto start = clock::now();
+    for (int i = 0; i < queries; ++i)
+    {
+        const glm::vec3 origin = rayOrigin(i, grid * 5.0f);
+        if (bvh.rayPick(origin, direction) != entt::null)
+            ++bounds_hits;
+    }
+    const double bounds_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    start = clock::now();
+    for (int i = 0; i < queries; ++i)
+    {
+        const glm::vec3 origin = rayOrigin(i, grid * 5.0f);
+        if (picker.pick(registry, bvh, origin, direction).entity != entt::null)
+            ++triangle_hits;
+    }
+    const double triangle_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    std::vector<entt::entity> selected;
+    start = clock::now();
+    picker.marqueeSelect(registry, bvh,
+                         glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 2000.0f) *
+                             glm::lookAt(glm::vec3(grid * 2.5f, 200.0f, 50.0f), glm::vec3(grid * 2.5f, 0.0f, -grid * 2.5f), glm::vec3(0, 1, 0)),
+                         glm::vec2(-0.5f), glm::vec2(0.5f), selected);
+    const double marquee_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    std::cout << "  entities: " << bvh.getTotalEntities() << "\n"
+              << "  bounds pick:   " << bounds_ms * 1000.0 / queries << " us/query (" << bounds_hits << " hits)\n"
+              << "  triangle pick: " << triangle_ms * 1000.0 / queries << " us/query (" << triangle_hits << " hits)\n"
+              << "  marquee:       " << marquee_ms << " ms (" << selected.size() << " selected)" << std::endl;
+
+    if (bvh.getTotalEntities() != static_cast<size_t>(grid * grid))
+        return fail(name, "BVH entity count mismatch");
+    if (picker.getCachedMeshCount() != 2)
+        return fail(name, "instances should share one triangle BVH per mesh");
+    if (triangle_hits > bounds_hits)
+        return fail(name, "triangle picking hit more often than bounds picking");
+    if (selected.empty())
+        return fail(name, "marquee selected nothing");
+    return pass(name);
+}
+
+// Headless API with real camera matrices, so the renderer culls like a GPU backend would
+class CullingRenderAPI : public HeadlessRenderAPI
+{
+public:
+    void setViewportSize(int width, int height) override { aspect = static_cast<float>(width) / std::max(height, 1); }
+    void setCamera(const camera& cam) override { view = glm::lookAt(cam.getPosition(), cam.getTarget(), cam.getUpVector()); }
+    glm::mat4 getViewMatrix() const override { return view; }
+    glm::mat4 getProjectionMatrix() const override { return glm::perspective(glm::radians(60.0f), aspect, 0.1f, 1000.0f); }
+
+private:
+    float aspect = 1.0f;
+    glm::mat4 view{1.0f};
+};
+
+static camera makeCamera(const glm::vec3& position, float yaw_degrees)
+{
+    camera c;
+    c.position = position;
+    c.rotation = glm::vec3(glm::radians(20.0f), glm::radians(yaw_degrees), 0.0f);
+    return c;
+}
+
+// Dense field of cubes, `grid` x `grid`, 3 m apart
+static void buildCubeField(entt::registry& registry, const std::shared_ptr<mesh>& cube_mesh, int grid)
+{
+    for (int z = 0; z < grid; ++z)
+        for (int x = 0; x < grid; ++x)
+            addEntity(registry, cube_mesh, glm::vec3(x * 3.0f, 0.0f, z * 3.0f));
+}
+
+static bool testMultiViewSharesCulling()
+{
+    const std::string name = "multi-view shares culling";
+
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    buildCubeField(registry, cube_mesh, 40);
+
+    CullingRenderAPI api;
+    renderer r(&api);
+
+    // Standing in the middle of the field, looking four ways
+    std::vector<camera> cameras = {
+        makeCamera(glm::vec3(60.0f, 10.0f, 60.0f), 0.0f),
+        makeCamera(glm::vec3(60.0f, 10.0f, 60.0f), 90.0f),
+        makeCamera(glm::vec3(60.0f, 10.0f, 60.0f), 180.0f),
+        makeCamera(glm::vec3(60.0f, 10.0f, 60.0f), 270.0f),
+    };
+    std::vector<RenderView> views;
+    for (camera& c : cameras)
+    {
+        RenderView view;
+        view.registry = &registry;
+        view.cam = &c;
+        view.width = 1280;
+        view.height = 720;
+        views.push_back(view);
+    }
+
+    // Reference: each view on its own
+    std::vector<size_t> single_visible;
+    std::vector<size_t> single_draws;
+    MultiViewFrame frame;
+    for (const RenderView& view : views)
+    {
+        r.build_view_frame({view}, &registry, frame);
+        single_visible.push_back(frame.work[0].opaque.size());
+        single_draws.push_back(frame.work[0].opaque_cmds.size());
+    }
+
+    r.build_view_frame(views, &registry, frame);
+    if (frame.stats.cull_passes != 1)
+        return fail(name, "expected one cull pass for one registry, got " + std::to_string(frame.stats.cull_passes));
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        if (single_visible[i] == 0 || single_visible[i] == registry.storage<MeshComponent>().size())
+            return fail(name, "view " + std::to_string(i) + " should see part of the field");
+        if (frame.work[i].opaque.size() != single_visible[i])
+            return fail(name, "view " + std::to_string(i) + " visibility differs from a single-view request");
+        if (frame.work[i].opaque_cmds.size() != single_draws[i])
+            return fail(name, "view " + std::to_string(i) + " recorded a different number of draws");
+    }
+
+    // A second world is culled separately
+    entt::registry other;
+    buildCubeField(other, cube_mesh, 4);
+    views[3].registry = &other;
+    r.build_view_frame(views, &registry, frame);
+    if (frame.stats.cull_passes != 2)
+        return fail(name, "expected one cull pass per registry");
+    if (frame.work[3].opaque.size() > 16)
+        return fail(name, "view of the second world saw entities from the first");
+
+    // Only the second world is visible (main viewport hidden): the primary
+    // world's BVH must not be rebuilt from it
+    r.build_view_frame({views[3]}, &registry, frame);
+    if (r.getSceneBVH().getTotalEntities() != registry.storage<MeshComponent>().size())
+        return fail(name, "the primary scene BVH was built from a secondary world");
+    if (frame.work[0].opaque.empty() || frame.work[0].opaque.size() > 16)
+        return fail(name, "secondary-only request did not cull the second world");
+
+    return pass(name);
+}
+
+static bool testMultiViewGroupsSharedShadows()
+{
+    const std::string name = "multi-view groups views that can share shadows";
+
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    buildCubeField(registry, cube_mesh, 8);
+
+    CullingRenderAPI api;
+    renderer r(&api);
+
+    camera a = makeCamera(glm::vec3(0.0f, 10.0f, -10.0f), 30.0f);
+    camera b = makeCamera(glm::vec3(20.0f, 10.0f, -10.0f), -30.0f);
+    camera a_copy = a;
+
+    std::vector<RenderView> views(3);
+    camera* cams[3] = {&a, &b, &a_copy};
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        views[i].registry = &registry;
+        views[i].cam = cams[i];
+        views[i].width = 800;
+        views[i].height = 600;
+    }
+
+    MultiViewFrame frame;
+    r.build_view_frame(views, &registry, frame);
+    if (frame.work[0].shadow_group != 0 || frame.work[1].shadow_group != 1 || frame.work[2].shadow_group != 0)
+        return fail(name, "identical cameras should share a shadow group");
+    if (frame.submit_order != std::vector<size_t>{0, 2, 1})
+        return fail(name, "views sharing shadows should be submitted back to back");
+
+    // Same camera, different aspect: different cascades
+    views[2].width = 600;
+    r.build_view_frame(views, &registry, frame);
+    if (frame.work[2].shadow_group != 2)
+        return fail(name, "views with different projections must not share shadows");
+
+    return pass(name);
+}
+
+static bool testMultiViewScalesWithViews()
+{
+    const std::string name = "multi-view 1 vs 4 views";
+    using clock = std::chrono::steady_clock;
+
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    buildCubeField(registry, cube_mesh, 150);  // 22.5k entities
+
+    CullingRenderAPI api;
+    renderer r(&api);
+
+    std::vector<camera> cameras = {
+        makeCamera(glm::vec3(225.0f, 60.0f, -40.0f), 0.0f),
+        makeCamera(glm::vec3(225.0f, 60.0f, -40.0f), 10.0f),
+        makeCamera(glm::vec3(215.0f, 55.0f, -40.0f), -5.0f),
+        makeCamera(glm::vec3(235.0f, 65.0f, -30.0f), 5.0f),
+    };
+    std::vector<RenderView> views;
+    for (camera& c : cameras)
+    {
+        RenderView view;
+        view.registry = &registry;
+        view.cam = &c;
+        view.width = 1280;
+        view.height = 720;
+        views.push_back(view);
+    }
+
+    MultiViewFrame frame;
+    r.build_view_frame(views, &registry, frame);  // Warm-up: BVH build and mesh upload
+
+    const int frames = 10;
+    double one_ms = 0.0, separate_ms = 0.0, multi_ms = 0.0;
+    double separate_cull_ms = 0.0, multi_cull_ms = 0.0;
+    size_t separate_draws = 0, multi_draws = 0;
+    for (int f = 0; f < frames; ++f)
+    {
+        auto start = clock::now();
+        r.build_view_frame({views[0]}, &registry, frame);
+        one_ms += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        start = clock::now();
+        separate_draws = 0;
+        for (const RenderView& view : views)
+        {
+            r.build_view_frame({view}, &registry, frame);
+            separate_cull_ms += frame.stats.cull_ms;
+            separate_draws += frame.stats.draw_calls;
+        }
+        separate_ms += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        start = clock::now();
+        r.build_view_frame(views, &registry, frame);
+        multi_ms += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        multi_cull_ms += frame.stats.cull_ms;
+        multi_draws = frame.stats.draw_calls;
+    }
+
+    std::cout << "  entities: " << registry.storage<MeshComponent>().size() << "\n"
+              << "  1 view:              " << one_ms / frames << " ms/frame\n"
+              << "  4 views, separately: " << separate_ms / frames << " ms/frame (cull " << separate_cull_ms / frames << " ms)\n"
+              << "  4 views, one request: " << multi_ms / frames << " ms/frame (cull " << multi_cull_ms / frames << " ms)\n"
+              << "  draws per frame: " << multi_draws << std::endl;
+
+    if (multi_draws != separate_draws || multi_draws == 0)
+        return fail(name, "multi-view recorded different draws than separate requests");
+    return pass(name);
+}
+
+static void writeTextFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+// Stands in for Slang: the "code" is the source text, and dependencies are the file
+// itself plus every "import x;" line, one level deep like a real module graph here
+static bool fakeShaderCompile(const Assets::ShaderPermutation& permutation,
+                              const Assets::ShaderBuildConfig& config,
+                              Assets::ShaderCompileOutput& output,
+                              std::atomic<int>& calls)
+{
+    calls.fetch_add(1, std::memory_order_relaxed);
+    const std::filesystem::path source = std::filesystem::path(config.source_dir) / permutation.source;
+    std::ifstream file(source);
+    if (!file.is_open())
+        return false;
+
+    output.dependencies.push_back(source.string());
+    std::string line;
+    std::string text;
+    while (std::getline(file, line))
+    {
+        text += line + "\n";
+        if (line.rfind("import ", 0) == 0 && line.size() > 8)
+            output.dependencies.push_back((std::filesystem::path(config.source_dir) / (line.substr(7, line.size() - 8) + ".slang")).string());
+    }
+    for (const auto& define : permutation.defines)
+        text += define + "\n";
+    output.code.assign(text.begin(), text.end());
+    return true;
+}
+
+static std::vector<Assets::ShaderPermutation> makeTestPermutations()
+{
+    std::vector<Assets::ShaderPermutation> permutations;
+    for (const char* name : {"lit", "sky"})
+    {
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            Assets::ShaderPermutation permutation;
+            permutation.source = std::string(name) + ".slang";
+            permutation.entry_point = stage == 0 ? "vertexMain" : "fragmentMain";
+            permutation.stage = stage == 0 ? Assets::ShaderStage::Vertex : Assets::ShaderStage::Fragment;
+            permutation.defines = {"TARGET_SPIRV"};
+            permutation.output = std::string("vulkan/") + name + (stage == 0 ? ".vert.spv" : ".frag.spv");
+            permutations.push_back(permutation);
+        }
+    }
+    return permutations;
+}
+
+static bool testShaderBuildSkipsUpToDateOutputs()
+{
+    const std::string name = "shader build skips up-to-date outputs";
+    namespace fs = std::filesystem;
+
+    const fs::path root = fs::temp_directory_path() / "garden_shader_build_test";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root / "src");
+    writeTextFile(root / "src" / "common.slang", "float4 tint() { return 1; }\n");
+    writeTextFile(root / "src" / "lit.slang", "import common;\nfloat4 vertexMain() { return tint(); }\n");
+    writeTextFile(root / "src" / "sky.slang", "float4 vertexMain() { return 0; }\n");
+
+    Assets::ShaderBuildConfig config;
+    config.source_dir = (root / "src").string();
+    config.output_root = (root / "out").string();
+
+    std::atomic<int> calls{0};
+    auto compile = [&calls](const Assets::ShaderPermutation& permutation, const Assets::ShaderBuildConfig& cfg,
+                            Assets::ShaderCompileOutput& output) {
+        return fakeShaderCompile(permutation, cfg, output, calls);
+    };
+    std::vector<Assets::ShaderPermutation> permutations = makeTestPermutations();
+
+    Assets::ShaderBuildResult first = Assets::ShaderCompiler::build(permutations, config, compile);
+    if (first.compiled != 4 || first.failed != 0 || !fs::exists(root / "out" / "vulkan" / "lit.frag.spv"))
+        return fail(name, "first build should compile every permutation");
+
+    calls = 0;
+    Assets::ShaderBuildResult second = Assets::ShaderCompiler::build(permutations, config, compile);
+    if (second.compiled != 0 || second.skipped != 4 || calls != 0)
+        return fail(name, "second build recompiled " + std::to_string(second.compiled) + " outputs");
+
+    // Editing an imported module rebuilds only its importers
+    writeTextFile(root / "src" / "common.slang", "float4 tint() { return 2; }\n");
+    Assets::ShaderBuildResult after_import = Assets::ShaderCompiler::build(permutations, config, compile);
+    if (after_import.compiled != 2 || after_import.skipped != 2)
+        return fail(name, "editing common.slang should rebuild lit.slang only");
+    for (const auto& output : after_import.compiled_outputs)
+    {
+        if (output.find("lit") == std::string::npos)
+            return fail(name, "rebuilt unrelated output " + output);
+    }
+
+    // New defines and missing outputs are stale as well
+    permutations[2].defines.push_back("NO_CLOUDS");
+    fs::remove(root / "out" / "vulkan" / "lit.vert.spv");
+    Assets::ShaderBuildResult after_changes = Assets::ShaderCompiler::build(permutations, config, compile);
+    if (after_changes.compiled != 2 || after_changes.skipped != 2)
+        return fail(name, "changed defines and deleted outputs should rebuild exactly two outputs");
+
+    config.incremental = false;
+    Assets::ShaderBuildResult forced = Assets::ShaderCompiler::build(permutations, config, compile);
+    if (forced.compiled != 4)
+        return fail(name, "non-incremental build should compile everything");
+
+    fs::remove_all(root, ec);
+    return pass(name);
+}
+
+static bool testShaderBuildSpirvTwiceWithSlang()
+{
+    const std::string name = "slang SPIR-V build is incremental";
+    namespace fs = std::filesystem;
+
+    if (!fs::exists("assets/shaders/slang") || !Assets::ShaderCompiler::isSlangAvailable())
+    {
+        std::cout << "[SKIP] " << name << ": needs the Slang library and assets/shaders/slang" << std::endl;
+        return true;
+    }
+
+    Assets::ShaderBuildConfig config;
+    config.build_dxil = false;
+    config.output_root = (fs::temp_directory_path() / "garden_shader_build_spirv").string();
+    std::error_code ec;
+    fs::remove_all(config.output_root, ec);
+
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    Assets::ShaderBuildResult first = Assets::AssetCompiler::compileShaders(config);
+    const double first_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    start = clock::now();
+    Assets::ShaderBuildResult second = Assets::AssetCompiler::compileShaders(config);
+    const double second_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    std::cout << "  full build: " << first.compiled << " outputs in " << first_ms << " ms\n"
+              << "  no-op build: " << second.skipped << " up-to-date in " << second_ms << " ms" << std::endl;
+
+    fs::remove_all(config.output_root, ec);
+    if (first.failed != 0 || first.compiled != first.total)
+        return fail(name, first.errors.empty() ? "first build failed" : first.errors.front());
+    if (second.compiled != 0 || second.skipped != second.total)
+        return fail(name, "second build recompiled " + std::to_string(second.compiled) + " outputs");
+    return pass(name);
+}
+
+// 50 bound variables, laid out like a HUD: 20 ints, 10 bools, 10 floats, 10 strings
+static constexpr int HUD_INTS = 20;
+static constexpr int HUD_BOOLS = 10;
+static constexpr int HUD_FLOATS = 10;
+static constexpr int HUD_STRINGS = 10;
+
+static std::string hudVariableName(char prefix, int index)
+{
+    return std::string(1, prefix) + std::to_string(index);
+}
+
+static std::string makeHudBenchmarkDocument()
+{
+    std::string rml = "<rml><head><style>body { width: 100%; height: 100%; font-family: LatoLatin; font-size: 14dp; color: #fff; } div { display: block; height: 16px; }</style></head>"
+                      "<body data-model=\"hud_bench\">";
+    for (int i = 0; i < HUD_INTS; ++i)
+        rml += "<div id=\"i" + std::to_string(i) + "\">{{ i" + std::to_string(i) + " }}</div>";
+    for (int i = 0; i < HUD_BOOLS; ++i)
+        rml += "<div data-if=\"b" + std::to_string(i) + "\">on</div>";
+    for (int i = 0; i < HUD_FLOATS; ++i)
+        rml += "<div id=\"f" + std::to_string(i) + "\">{{ f" + std::to_string(i) + " }}</div>";
+    for (int i = 0; i < HUD_STRINGS; ++i)
+        rml += "<div>{{ s" + std::to_string(i) + " }}</div>";
+    return rml + "</body></rml>";
+}
+
+static bool testRmlDataModelTracksChanges()
+{
+    const std::string name = "RmlUi data model dirties only changed variables";
+    using clock = std::chrono::steady_clock;
+
+    RmlUiManager& rml = RmlUiManager::get();
+    if (!rml.initializeHeadless(1280, 720))
+        return fail(name, "headless RmlUi failed to initialize");
+
+    void* model = rml.createDataModel("hud_bench");
+    if (!model)
+        return fail(name, "failed to create data model");
+    bool bound = true;
+    for (int i = 0; i < HUD_INTS; ++i)
+        bound &= rml.dataModelBindInt(model, hudVariableName('i', i).c_str(), 0);
+    for (int i = 0; i < HUD_BOOLS; ++i)
+        bound &= rml.dataModelBindBool(model, hudVariableName('b', i).c_str(), false);
+    for (int i = 0; i < HUD_FLOATS; ++i)
+        bound &= rml.dataModelBindFloat(model, hudVariableName('f', i).c_str(), 0.0f, 1);
+    for (int i = 0; i < HUD_STRINGS; ++i)
+        bound &= rml.dataModelBindString(model, hudVariableName('s', i).c_str(), "");
+    if (!bound)
+        return fail(name, "failed to bind 50 variables");
+
+    const std::filesystem::path document_path = std::filesystem::temp_directory_path() / "hud_bench.rml";
+    writeTextFile(document_path, makeHudBenchmarkDocument());
+    void* document = rml.loadDocument(document_path.string().c_str());
+    if (!document)
+        return fail(name, "failed to load the benchmark document");
+    rml.beginFrame(1280, 720);
+    rml.render();
+
+    // Per frame the "game" changes two values (a timer and a position); the rest hold
+    const int frames = 300;
+    auto game_int = [](int frame, int i) { return i == 0 ? frame : i * 10; };
+    auto game_float = [](int frame, int i) { return i == 0 ? static_cast<float>(frame) * 0.25f : static_cast<float>(i); };
+
+    // Before: everything set by name (floats and strings formatted), then DirtyAllVariables
+    auto start = clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        char buffer[32];
+        for (int i = 0; i < HUD_INTS; ++i)
+            rml.dataModelSetInt(model, hudVariableName('i', i).c_str(), game_int(frame, i));
+        for (int i = 0; i < HUD_BOOLS; ++i)
+            rml.dataModelSetBool(model, hudVariableName('b', i).c_str(), (i & 1) != 0);
+        for (int i = 0; i < HUD_FLOATS; ++i)
+            rml.dataModelSetFloat(model, hudVariableName('f', i).c_str(), game_float(frame, i));
+        for (int i = 0; i < HUD_STRINGS; ++i)
+        {
+            std::snprintf(buffer, sizeof(buffer), "label %d", i);
+            rml.dataModelSetString(model, hudVariableName('s', i).c_str(), buffer);
+        }
+        rml.dataModelDirtyAll(model);
+        rml.beginFrame(1280, 720);
+        rml.render();
+    }
+    const double dirty_all_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count() / frames;
+
+    // After: handles, compared against the bound value
+    std::vector<RmlUiManager::DataVariable> ints, bools, floats, strings;
+    for (int i = 0; i < HUD_INTS; ++i)
+        ints.push_back(rml.dataModelFindVariable(model, hudVariableName('i', i).c_str()));
+    for (int i = 0; i < HUD_BOOLS; ++i)
+        bools.push_back(rml.dataModelFindVariable(model, hudVariableName('b', i).c_str()));
+    for (int i = 0; i < HUD_FLOATS; ++i)
+        floats.push_back(rml.dataModelFindVariable(model, hudVariableName('f', i).c_str()));
+    for (int i = 0; i < HUD_STRINGS; ++i)
+        strings.push_back(rml.dataModelFindVariable(model, hudVariableName('s', i).c_str()));
+
+    rml.resetUpdateStats();
+    start = clock::now();
+    for (int frame = frames; frame < frames * 2; ++frame)
+    {
+        char buffer[32];
+        for (int i = 0; i < HUD_INTS; ++i)
+            rml.dataModelUpdateInt(model, ints[i], game_int(frame, i));
+        for (int i = 0; i < HUD_BOOLS; ++i)
+            rml.dataModelUpdateBool(model, bools[i], (i & 1) != 0);
+        for (int i = 0; i < HUD_FLOATS; ++i)
+            rml.dataModelUpdateFloat(model, floats[i], game_float(frame, i));
+        for (int i = 0; i < HUD_STRINGS; ++i)
+        {
+            std::snprintf(buffer, sizeof(buffer), "label %d", i);
+            rml.dataModelUpdateString(model, strings[i], buffer);
+        }
+        rml.beginFrame(1280, 720);
+        rml.render();
+    }
+    const double tracked_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count() / frames;
+    const RmlUiManager::UpdateStats tracked_stats = rml.getUpdateStats();
+
+    // Idle: nothing changes, so Context::Update should not run at all
+    rml.resetUpdateStats();
+    start = clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        rml.dataModelUpdateInt(model, ints[0], game_int(frames * 2 - 1, 0));
+        rml.beginFrame(1280, 720);
+        rml.render();
+    }
+    const double idle_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count() / frames;
+    const RmlUiManager::UpdateStats idle_stats = rml.getUpdateStats();
+
+    Rml::Element* timer = static_cast<Rml::ElementDocument*>(document)->GetElementById("i0");
+    const std::string timer_text = timer ? timer->GetInnerRML() : std::string();
+    Rml::Element* position = static_cast<Rml::ElementDocument*>(document)->GetElementById("f0");
+    const std::string position_text = position ? position->GetInnerRML() : std::string();
+
+    rml.closeDocument(document);
+    rml.removeDataModel(model);
+    rml.shutdown();
+    std::error_code ec;
+    std::filesystem::remove(document_path, ec);
+
+    std::cout << "  50 variables: set + dirty all " << dirty_all_ms << " ms/frame, tracked " << tracked_ms
+              << " ms/frame, idle " << idle_ms << " ms/frame (" << tracked_stats.dirty_variables / frames
+              << " dirty variables/frame)" << std::endl;
+
+    if (tracked_stats.dirty_variables != static_cast<std::uint32_t>(frames * 2))
+        return fail(name, "expected exactly the two changing variables to be dirtied each frame");
+    if (tracked_stats.updates != static_cast<std::uint32_t>(frames))
+        return fail(name, "changed frames did not update the context");
+    if (idle_stats.updates != 0 || idle_stats.skipped != static_cast<std::uint32_t>(frames))
+        return fail(name, "clean frames still ran Context::Update");
+    if (timer_text != std::to_string(frames * 2 - 1) || position_text != "149.8")
+        return fail(name, "document shows '" + timer_text + "' / '" + position_text + "' instead of the last values");
+    if (tracked_ms >= dirty_all_ms)
+        return fail(name, "change tracking was not cheaper than dirtying every variable");
+    return pass(name);
+}
+
+// Canned HUD: rows of boxed labels with borders, so every row interleaves untextured
+// boxes with glyph-page text, which is the pattern batching and the atlas target
+static std::string makeUiBatchingBenchmarkDocument()
+{
+    std::string rml = "<rml><head><style>body { width: 100%; height: 100%; font-family: LatoLatin; font-size: 14dp; color: #fff; }"
+                      " div.row { display: block; height: 18px; margin: 1px; background-color: #20304080; border: 1px #8090a0; }"
+                      " span { background-color: #40506080; padding: 0 4px; }</style></head><body>";
+    for (int row = 0; row < 40; ++row)
+    {
+        rml += "<div class=\"row\">";
+        for (int col = 0; col < 4; ++col)
+            rml += "<span>item " + std::to_string(row * 4 + col) + "</span>";
+        rml += "</div>";
+    }
+    return rml + "</body></rml>";
+}
+
+static bool testRmlUiVulkanBatchingBenchmark()
+{
+    const std::string name = "RmlUi Vulkan batching cuts draws on a canned HUD";
+    namespace fs = std::filesystem;
+    using clock = std::chrono::steady_clock;
+
+    ConVarBase* batching = ConVarRegistry::get().find("r_ui_batching");
+    if (!fs::exists("assets/shaders/compiled/vulkan/rmlui.vert.spv") || !batching)
+    {
+        std::cout << "[SKIP] " << name << ": needs the compiled RmlUi Vulkan shaders" << std::endl;
+        return true;
+    }
+
+    // lavapipe (or any Vulkan driver) behind SDL's offscreen video driver
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::cout << "[SKIP] " << name << ": SDL video unavailable (" << SDL_GetError() << ")" << std::endl;
+        return true;
+    }
+    const int width = 1280;
+    const int height = 720;
+    SDL_Window* window = SDL_CreateWindow("RenderingTests", width, height, SDL_WINDOW_VULKAN | SDL_WINDOW_HIDDEN);
+    std::unique_ptr<IRenderAPI> api(window ? CreateRenderAPI(RenderAPIType::Vulkan) : nullptr);
+    if (!api || !api->initialize(window, width, height, 60.0f))
+    {
+        std::cout << "[SKIP] " << name << ": no Vulkan device" << std::endl;
+        api.reset();
+        if (window)
+            SDL_DestroyWindow(window);
+        SDL_Quit();
+        return true;
+    }
+
+    RmlUiManager& rml = RmlUiManager::get();
+    rml.shutdown();
+    const fs::path document_path = fs::temp_directory_path() / "ui_batching_bench.rml";
+    writeTextFile(document_path, makeUiBatchingBenchmarkDocument());
+    void* document = rml.initialize(window, api.get(), RenderAPIType::Vulkan)
+        ? rml.loadDocument(document_path.string().c_str()) : nullptr;
+
+    renderer scene_renderer(api.get());
+    entt::registry registry;
+    camera cam = makeCamera(glm::vec3(0.0f, 2.0f, 5.0f), 0.0f);
+
+    struct Run { RmlUiManager::RenderStats stats; double frame_ms = 0.0; };
+    auto measure = [&](bool batched) {
+        batching->setBool(batched);
+        const int frames = 60;
+        Run result;
+        float record_ms = 0.0f;
+        const auto start = clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            scene_renderer.render_scene(registry, cam);
+            api->present();
+            record_ms += rml.getRenderStats().record_ms;
+        }
+        result.frame_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count() / frames;
+        result.stats = rml.getRenderStats();
+        result.stats.record_ms = record_ms / frames;
+        return result;
+    };
+
+    Run unbatched, batched;
+    if (document)
+    {
+        measure(true);   // warm-up: font glyph pages and pipelines
+        unbatched = measure(false);
+        batched = measure(true);
+    }
+
+    batching->setBool(true);
+    if (document)
+        rml.closeDocument(document);
+    rml.shutdown();
+    api->shutdown();
+    api.reset();
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    std::error_code ec;
+    fs::remove(document_path, ec);
+
+    if (!document)
+        return fail(name, "RmlUi failed to initialize on Vulkan or load the benchmark document");
+
+    std::cout << "  " << batched.stats.geometries << " geometries: unbatched " << unbatched.stats.draw_calls
+              << " draws, " << unbatched.stats.record_ms << " ms UI record, " << unbatched.frame_ms << " ms/frame; batched "
+              << batched.stats.draw_calls << " draws, " << batched.stats.record_ms << " ms UI record, " << batched.frame_ms
+              << " ms/frame (" << batched.stats.atlas_textures << "/" << batched.stats.textures << " textures atlased)" << std::endl;
+
+    if (batched.stats.geometries == 0 || unbatched.stats.draw_calls < batched.stats.geometries)
+        return fail(name, "the document produced no UI geometry, or unbatched frames merged draws");
+    if (batched.stats.draw_calls * 4 > batched.stats.geometries)
+        return fail(name, "batching kept " + std::to_string(batched.stats.draw_calls) + " draws for " +
+                              std::to_string(batched.stats.geometries) + " geometries");
+    return pass(name);
+}
+
+// Stands in for a GPU queue: scopes write the current tick into their queries and the
+// work between them advances the clock, one tick per microsecond.
+struct FakeGpuTimeline
+{
+    GpuScopeRecorder recorder;
+    std::vector<uint64_t> timestamps;
+    uint64_t now = 1000;
+
+    void reset(uint32_t capacity)
+    {
+        recorder.reset(capacity);
+        timestamps.assign(capacity, GpuPassTimingHistory::kUnavailable);
+    }
+
+    void begin(const char* name)
+    {
+        const uint32_t query = recorder.begin(name);
+        if (query != GpuScopeRecorder::kNoQuery)
+            timestamps[query] = now;
+    }
+
+    void end()
+    {
+        const uint32_t query = recorder.end();
+        if (query != GpuScopeRecorder::kNoQuery)
+            timestamps[query] = now;
+    }
+
+    void work(float ms) { now += static_cast<uint64_t>(ms * 1000.0f); }
+
+    void pass(const char* name, float ms)
+    {
+        begin(name);
+        work(ms);
+        end();
+    }
+};
+
+static const GpuPassTiming* findPassTiming(const GpuPassTimings& timings, const std::string& name)
+{
+    for (const GpuPassTiming& timing : timings.passes)
+    {
+        if (timing.name == name)
+            return &timing;
+    }
+    return nullptr;
+}
+
+// Records the scopes the Vulkan backend emits for an editor frame with two viewports and
+// checks that they resolve to named passes whose top-level times add up to the frame.
+static bool testGpuPassTimingsSumToFrame()
+{
+    const std::string name = "GPU pass timings sum to the frame time";
+    const double ms_per_tick = 0.001;
+    GpuPassTimingHistory history;
+    FakeGpuTimeline gpu;
+
+    float frame_ms = 0.0f;
+    for (uint64_t frame = 1; frame <= 3; ++frame)
+    {
+        gpu.reset(256);
+        const uint64_t frame_begin = gpu.now;
+        for (int view = 0; view < 2; ++view)
+        {
+            gpu.begin("Shadows");
+            gpu.pass("Shadow Cascade 0", 0.4f);
+            gpu.pass("Shadow Cascade 1", 0.3f);
+            gpu.end();
+            gpu.begin("Scene");
+            gpu.work(2.0f);
+            gpu.pass("Skybox", 0.1f);
+            gpu.end();
+            gpu.pass("SSAO", 0.5f + 0.1f * static_cast<float>(frame));
+            gpu.pass("Tonemapping", 0.2f);
+        }
+        gpu.work(0.05f);   // Between passes, outside every scope
+        gpu.pass("UI", 0.3f);
+        frame_ms = static_cast<float>(static_cast<double>(gpu.now - frame_begin) * ms_per_tick);
+        history.resolve(gpu.recorder, gpu.timestamps.data(), ms_per_tick, frame_ms, frame);
+    }
+
+    const GpuPassTimings& timings = history.getTimings();
+    if (!timings.valid || timings.frame != 3)
+        return fail(name, "timings were not resolved");
+
+    const char* expected[] = {"Shadows", "Shadow Cascade 0", "Shadow Cascade 1", "Scene", "Skybox",
+                              "SSAO", "Tonemapping", "UI"};
+    if (timings.passes.size() != std::size(expected))
+        return fail(name, "expected " + std::to_string(std::size(expected)) + " passes, got " +
+                              std::to_string(timings.passes.size()));
+    for (size_t i = 0; i < std::size(expected); ++i)
+    {
+        if (timings.passes[i].name != expected[i])
+            return fail(name, "pass " + std::to_string(i) + " is '" + timings.passes[i].name + "', expected '" +
+                                  expected[i] + "'");
+    }
+
+    float top_level_ms = 0.0f;
+    for (const GpuPassTiming& timing : timings.passes)
+    {
+        if (timing.depth == 0)
+            top_level_ms += timing.last_ms;
+    }
+    std::cout << "  frame " << timings.frame_ms << " ms, passes " << top_level_ms << " ms, unattributed "
+              << timings.unattributed_ms << " ms" << std::endl;
+    if (!approx(top_level_ms + timings.unattributed_ms, frame_ms, 0.001f))
+        return fail(name, "top-level passes plus unattributed time do not add up to the frame");
+    if (!approx(timings.unattributed_ms, 0.05f, 0.001f))
+        return fail(name, "time between passes was not reported as unattributed");
+
+    const GpuPassTiming* ssao = findPassTiming(timings, "SSAO");
+    const GpuPassTiming* cascade = findPassTiming(timings, "Shadow Cascade 0");
+    const GpuPassTiming* skybox = findPassTiming(timings, "Skybox");
+    if (ssao->count != 2 || !approx(ssao->last_ms, 1.6f, 0.001f))
+        return fail(name, "SSAO from both viewports was not summed");
+    if (!approx(ssao->average_ms, 1.4f, 0.001f))
+        return fail(name, "SSAO rolling average is " + std::to_string(ssao->average_ms) + " instead of 1.4");
+    if (cascade->depth != 1 || skybox->depth != 1)
+        return fail(name, "nested scopes were not reported one level down");
+
+    // A pass that stops running averages down and drops out after a full window
+    for (uint32_t frame = 0; frame < GpuPassTimingHistory::kWindow; ++frame)
+    {
+        gpu.reset(256);
+        gpu.pass("Scene", 2.0f);
+        gpu.pass("UI", 0.3f);
+        history.resolve(gpu.recorder, gpu.timestamps.data(), ms_per_tick, -1.0f, 4 + frame);
+        if (frame == 0 && findPassTiming(history.getTimings(), "SSAO"))
+            return fail(name, "a pass that did not run is still listed");
+    }
+    if (!approx(history.getTimings().frame_ms, 2.3f, 0.001f))
+        return fail(name, "frame time without a measured frame is not the span of its passes");
+
+    // A full query slice drops the scopes that do not fit, never an end of a started one
+    gpu.reset(4);
+    gpu.begin("Scene");
+    gpu.pass("Skybox", 0.1f);
+    gpu.pass("Dropped", 0.1f);
+    gpu.end();
+    if (gpu.recorder.getDroppedCount() != 1 || gpu.recorder.getOpenCount() != 0)
+        return fail(name, "query overflow was not handled");
+    history.resolve(gpu.recorder, gpu.timestamps.data(), ms_per_tick, -1.0f, 100);
+    if (history.getTimings().passes.size() != 2 || findPassTiming(history.getTimings(), "Dropped"))
+        return fail(name, "a dropped scope was resolved");
+    return pass(name);
+}
+
+// GBuffer -> SSAO -> Lighting with SSAO declared as a compute pass. Depth is imported, so it
+// has to come back to the graphics queue at the end of the graph.
+static void buildAsyncComputeGraph(RenderGraph& graph, RGQueueType ssaoQueue)
+{
+    graph.reset();
+    graph.setReferenceResolution(1280, 720);
+
+    RGTextureDesc desc;
+    desc.width = 1280;
+    desc.height = 720;
+    const RGTextureHandle hdr = graph.importTexture("HDR", desc, RGResourceUsage::Undefined);
+    desc.format = RGFormat::D32_FLOAT;
+    const RGTextureHandle depth = graph.importTexture("Depth", desc, RGResourceUsage::DepthStencilWrite);
+
+    RGTextureHandle normals;
+    RGTextureHandle ao;
+    graph.addPass("GBuffer",
+        [&](RGBuilder& b) {
+            RGTextureDesc normalsDesc;
+            normalsDesc.scaleFactor = 1.0f;
+            normalsDesc.format = RGFormat::RGBA16_FLOAT;
+            normalsDesc.debugName = "Normals";
+            normals = b.write(b.createTexture(normalsDesc));
+            b.write(depth, RGResourceUsage::DepthStencilWrite);
+        },
+        [](RGContext&) {});
+    graph.addPass("SSAO",
+        [&](RGBuilder& b) {
+            RGTextureDesc aoDesc;
+            aoDesc.scaleFactor = 0.5f;
+            aoDesc.format = RGFormat::R8_UNORM;
+            aoDesc.debugName = "AO";
+            b.setQueue(ssaoQueue);
+            b.read(depth);
+            b.read(normals);
+            ao = b.write(b.createTexture(aoDesc), RGResourceUsage::UnorderedAccess);
+        },
+        [](RGContext&) {});
+    graph.addPass("Lighting",
+        [&](RGBuilder& b) {
+            b.read(normals);
+            b.read(ao);
+            b.write(hdr);
+            b.setSideEffect();
+        },
+        [](RGContext&) {});
+}
+
+// Compute passes fall back to the graphics queue with exactly the barriers of a graphics
+// pass, and move to the compute queue with ownership transfers and syncs when it exists.
+static bool testRenderGraphSchedulesAsyncCompute()
+{
+    const std::string name = "render graph schedules compute passes on the async compute queue";
+
+    RenderGraph graphicsGraph;
+    buildAsyncComputeGraph(graphicsGraph, RGQueueType::Graphics);
+    RenderGraph fallbackGraph;
+    buildAsyncComputeGraph(fallbackGraph, RGQueueType::Compute);
+    if (!graphicsGraph.compile() || !fallbackGraph.compile())
+        return fail(name, "graph did not compile");
+
+    const RGCompileResult& reference = graphicsGraph.getCompileResult();
+    const RGCompileResult& fallback = fallbackGraph.getCompileResult();
+    if (fallback.usesAsyncCompute || !fallback.queueSyncs.empty())
+        return fail(name, "fallback schedule uses the compute queue");
+    if (fallback.executionOrder != reference.executionOrder || fallback.barriers.size() != reference.barriers.size())
+        return fail(name, "fallback schedule differs from the graphics-only one");
+    for (size_t i = 0; i < fallback.barriers.size(); ++i)
+    {
+        const RGBarrier& a = fallback.barriers[i];
+        const RGBarrier& b = reference.barriers[i];
+        if (a.handle != b.handle || a.fromUsage != b.fromUsage || a.toUsage != b.toUsage ||
+            a.insertBeforePass != b.insertBeforePass || a.isQueueTransfer())
+            return fail(name, "fallback barrier " + std::to_string(i) + " differs from the graphics-only one");
+    }
+    for (RGQueueType queue : fallback.passQueues)
+    {
+        if (queue != RGQueueType::Graphics)
+            return fail(name, "fallback schedule put a pass off the graphics queue");
+    }
+
+    RenderGraph asyncGraph;
+    buildAsyncComputeGraph(asyncGraph, RGQueueType::Compute);
+    RGCompileOptions options;
+    options.asyncCompute = true;
+    if (!asyncGraph.compile(options))
+        return fail(name, "async graph did not compile");
+
+    const RGCompileResult& result = asyncGraph.getCompileResult();
+    const std::vector<RGQueueType> expectedQueues = {RGQueueType::Graphics, RGQueueType::Compute, RGQueueType::Graphics};
+    if (!result.usesAsyncCompute || result.passQueues != expectedQueues)
+        return fail(name, "SSAO was not scheduled on the compute queue");
+
+    // Depth and normals go to compute after GBuffer; normals and AO come back for Lighting;
+    // depth comes back at the end of the graph.
+    uint32_t toCompute = 0;
+    uint32_t toGraphics = 0;
+    bool depthReturned = false;
+    for (const RGBarrier& barrier : result.barriers)
+    {
+        if (!barrier.isQueueTransfer())
+            continue;
+        if (barrier.dstQueue == RGQueueType::Compute)
+        {
+            ++toCompute;
+            if (barrier.releaseAfterPass != 0 || barrier.insertBeforePass != 1)
+                return fail(name, "transfer to the compute queue is not between GBuffer and SSAO");
+        }
+        else
+        {
+            ++toGraphics;
+            if (barrier.releaseAfterPass != 1)
+                return fail(name, "transfer back to graphics is not released after SSAO");
+            depthReturned = depthReturned || barrier.insertBeforePass == 3;
+        }
+    }
+    if (toCompute != 2 || toGraphics != 3 || !depthReturned)
+        return fail(name, "expected 2 transfers to compute and 3 back, with depth returned at the end; got " +
+                              std::to_string(toCompute) + " and " + std::to_string(toGraphics));
+
+    // Compute waits for GBuffer, graphics waits for SSAO before Lighting; that wait also covers
+    // the end of the graph, so there is no separate join.
+    if (result.queueSyncs.size() != 2)
+        return fail(name, "expected 2 queue syncs, got " + std::to_string(result.queueSyncs.size()));
+    const RGQueueSync& first = result.queueSyncs[0];
+    const RGQueueSync& second = result.queueSyncs[1];
+    if (first.signalQueue != RGQueueType::Graphics || first.signalAfterPass != 0 ||
+        first.waitQueue != RGQueueType::Compute || first.waitBeforePass != 1)
+        return fail(name, "compute queue does not wait for GBuffer");
+    if (second.signalQueue != RGQueueType::Compute || second.signalAfterPass != 1 ||
+        second.waitQueue != RGQueueType::Graphics || second.waitBeforePass != 2)
+        return fail(name, "graphics queue does not wait for SSAO");
+    return pass(name);
+}
+
+// Records what the graph asks of a backend with a compute queue, per queue.
+class QueueRecordingBackend : public RGBackend
+{
+public:
+    struct Event
+    {
+        std::string what;
+        RGQueueType queue;
+        uint32_t index;
+    };
+
+    std::vector<Event> events;
+
+    void createTransientTexture(RGResourceHandle, const RGTextureDesc&) override {}
+    void destroyTransientTexture(RGResourceHandle) override {}
+    void insertBarrier(RGResourceHandle handle, RGResourceUsage, RGResourceUsage) override
+    {
+        events.push_back({"barrier", active, handle.index});
+    }
+    void flushBarriers() override {}
+    RGContext& getContext() override { return context; }
+    void beginFrame() override {}
+    void endFrame() override {}
+    void beginPass(const char* name) override { events.push_back({name, active, 0}); }
+
+    bool supportsAsyncCompute() const override { return true; }
+    void setActiveQueue(RGQueueType queue) override { active = queue; }
+    void signalSync(RGQueueType queue, uint32_t syncIndex) override
+    {
+        events.push_back({queue == active ? "signal" : "signal on wrong queue", active, syncIndex});
+    }
+    void waitSync(RGQueueType queue, uint32_t syncIndex) override
+    {
+        events.push_back({queue == active ? "wait" : "wait on wrong queue", active, syncIndex});
+    }
+    void releaseOwnership(const RGBarrier& barrier) override
+    {
+        events.push_back({barrier.srcQueue == active ? "release" : "release on wrong queue", active, barrier.handle.index});
+    }
+    void acquireOwnership(const RGBarrier& barrier) override
+    {
+        events.push_back({barrier.dstQueue == active ? "acquire" : "acquire on wrong queue", active, barrier.handle.index});
+    }
+
+    size_t find(const std::string& what, uint32_t index, size_t from = 0) const
+    {
+        for (size_t i = from; i < events.size(); ++i)
+        {
+            if (events[i].what == what && events[i].index == index)
+                return i;
+        }
+        return SIZE_MAX;
+    }
+
+private:
+    RGContext context;
+    RGQueueType active = RGQueueType::Graphics;
+};
+
+// Executes the async schedule and checks every wait follows its signal and every transfer
+// is released before the signal its acquire waits on.
+static bool testRenderGraphExecutesAsyncComputeInOrder()
+{
+    const std::string name = "render graph records async compute syncs in order";
+
+    QueueRecordingBackend backend;
+    RenderGraph graph;
+    buildAsyncComputeGraph(graph, RGQueueType::Compute);
+    RGCompileOptions options;
+    options.asyncCompute = backend.supportsAsyncCompute();
+    graph.compile(options);
+    graph.execute(backend);
+
+    for (const auto& event : backend.events)
+    {
+        if (event.what.find("wrong queue") != std::string::npos)
+            return fail(name, event.what);
+    }
+
+    const size_t ssao = backend.find("SSAO", 0);
+    if (ssao == SIZE_MAX || backend.events[ssao].queue != RGQueueType::Compute)
+        return fail(name, "SSAO was not recorded on the compute queue");
+    if (backend.events.back().queue != RGQueueType::Graphics)
+        return fail(name, "graph did not end on the graphics queue");
+
+    const RGCompileResult& result = graph.getCompileResult();
+    for (uint32_t si = 0; si < result.queueSyncs.size(); ++si)
+    {
+        const size_t signal = backend.find("signal", si);
+        const size_t wait = backend.find("wait", si);
+        if (signal == SIZE_MAX || wait == SIZE_MAX || signal > wait)
+            return fail(name, "sync " + std::to_string(si) + " is not signaled before it is waited on");
+    }
+
+    for (const RGBarrier& barrier : result.barriers)
+    {
+        if (!barrier.isQueueTransfer())
+            continue;
+        const size_t release = backend.find("release", barrier.handle.index);
+        const size_t acquire = release == SIZE_MAX ? SIZE_MAX : backend.find("acquire", barrier.handle.index, release);
+        if (acquire == SIZE_MAX)
+            return fail(name, "transfer of resource " + std::to_string(barrier.handle.index) + " is incomplete");
+        // Matched; a later transfer of the same resource has to find its own pair
+        backend.events[release].what = "matched release";
+        backend.events[acquire].what = "matched acquire";
+        bool signaledBetween = false;
+        for (size_t i = release; i < acquire; ++i)
+            signaledBetween = signaledBetween || backend.events[i].what == "signal";
+        if (!signaledBetween)
+            return fail(name, "transfer of resource " + std::to_string(barrier.handle.index) +
+                                  " is not released before a signal the acquiring queue waits on");
+    }
+    return pass(name);
+}
+
+// GPU whose frame is fixed_ms plus scaled_ms at full resolution, the scaled part shrinking
+// with the pixel count. Results come back two frames late, like a real swapchain.
+struct SyntheticDynamicResolutionGpu
+{
+    float fixed_ms = 4.0f;
+    float scaled_ms = 20.0f;
+
+    // Runs frames until the controller settles; returns the frame time at the final scale
+    float run(DynamicResolutionController& controller, int frames)
+    {
+        std::vector<float> in_flight;
+        for (int i = 0; i < frames; ++i)
+        {
+            in_flight.push_back(controller.getScale());
+            if (in_flight.size() > 2)
+            {
+                const float scale = in_flight.front();
+                in_flight.erase(in_flight.begin());
+                const float scaled = scaled_ms * scale * scale;
+                controller.update(fixed_ms + scaled, scaled, scale);
+            }
+        }
+        const float scale = controller.getScale();
+        return fixed_ms + scaled_ms * scale * scale;
+    }
+};
+
+static bool testDynamicResolutionMeetsBudget()
+{
+    const std::string name = "dynamic resolution scale meets the GPU budget";
+
+    DynamicResolutionSettings settings;
+    settings.enabled = true;
+    settings.budget_ms = 16.6f;
+    settings.min_scale = 0.5f;
+    DynamicResolutionController controller;
+    controller.setSettings(settings);
+    SyntheticDynamicResolutionGpu gpu;
+
+    // 24 ms at full resolution: the scale drops until the frame fits, without overshooting
+    float frame_ms = gpu.run(controller, 300);
+    const float target_ms = settings.budget_ms * settings.headroom;
+    const float ideal = std::sqrt((target_ms - gpu.fixed_ms) / gpu.scaled_ms);
+    if (frame_ms > target_ms + 0.05f)
+        return fail(name, "heavy load stays over budget: " + std::to_string(frame_ms) + " ms at scale " +
+                              std::to_string(controller.getScale()));
+    if (controller.getScale() < ideal - 0.05f)
+        return fail(name, "scale " + std::to_string(controller.getScale()) + " is far below the " +
+                              std::to_string(ideal) + " that fits");
+
+    // Load goes away: back up to full resolution
+    gpu.scaled_ms = 8.0f;
+    gpu.run(controller, 300);
+    if (controller.getScale() != 1.0f)
+        return fail(name, "light load did not return to full resolution, scale " + std::to_string(controller.getScale()));
+
+    // Load that no scale can fit: clamped at the minimum
+    gpu.scaled_ms = 200.0f;
+    frame_ms = gpu.run(controller, 300);
+    if (controller.getScale() != settings.min_scale)
+        return fail(name, "impossible load did not clamp to the minimum scale");
+
+    // A forced scale ignores measurements; the extents follow it
+    settings.forced_scale = 0.75f;
+    controller.setSettings(settings);
+    gpu.run(controller, 20);
+    if (controller.getScale() != 0.75f)
+        return fail(name, "forced scale was not applied");
+    if (DynamicResolutionController::scaleExtent(1920, controller.getScale()) != 1440 ||
+        DynamicResolutionController::scaleExtent(1080, controller.getScale()) != 810)
+        return fail(name, "scaled extent of 1920x1080 at 0.75 is not 1440x810");
+
+    settings.enabled = false;
+    controller.setSettings(settings);
+    if (controller.getScale() != 1.0f)
+        return fail(name, "disabled controller does not render at full resolution");
+    return pass(name);
+}
+
+// Graph builder with scene and post passes that record nothing but what they were given
+class RecordingPostProcessGraphBuilder : public PostProcessGraphBuilder
+{
+public:
+    bool render_scale = true;
+    uint32_t scene_width = 0;
+    uint32_t scene_height = 0;
+    uint32_t upscale_width = 0;
+    uint32_t upscale_height = 0;
+    RGTextureDesc tonemap_input;
+    RGTextureDesc output;
+
+protected:
+    Handles importResources(RenderGraph& graph, RGBackend&, const Config& cfg) override
+    {
+        this->graph = &graph;
+        RGTextureDesc desc;
+        desc.width = cfg.width;
+        desc.height = cfg.height;
+        desc.format = RGFormat::RGBA16_FLOAT;
+        Handles h;
+        h.offscreenHDR = graph.importTexture("OffscreenHDR", desc, RGResourceUsage::ShaderResource);
+        h.output = graph.importTexture("OutputTarget", desc, RGResourceUsage::RenderTarget);
+        desc.format = RGFormat::D32_FLOAT;
+        h.depth = graph.importTexture("DepthBuffer", desc, RGResourceUsage::DepthStencilWrite);
+        return h;
+    }
+    RGResourceUsage depthReadUsage() const override { return RGResourceUsage::DepthStencilReadOnly; }
+
+    void addScenePasses(RenderGraph& graph, const Handles& h, const Config& cfg) override
+    {
+        graph.addPass("DeferredLighting",
+            [&](RGBuilder& b) {
+                b.write(h.depth, RGResourceUsage::DepthStencilWrite);
+                b.write(h.offscreenHDR, RGResourceUsage::RenderTarget);
+                b.setSideEffect();
+            },
+            [this, cfg](RGContext&) {
+                scene_width = cfg.sceneWidth();
+                scene_height = cfg.sceneHeight();
+            });
+    }
+
+    void recordSkybox(RGContext&, const Handles&, const Config&) override {}
+    void recordSSAO(RGContext&, const Handles&, const Config&) override {}
+    void recordSSAOBlurH(RGContext&, const Handles&, const Config&) override {}
+    void recordSSAOBlurV(RGContext&, const Handles&, const Config&) override {}
+    void recordShadowMask(RGContext&, const Handles&, const Config&) override {}
+    void recordTonemapping(RGContext&, const Handles& h, const Config&) override
+    {
+        const RGTextureHandle input = h.upscaledHDR.isValid() ? h.upscaledHDR : h.offscreenHDR;
+        tonemap_input = graph->getResource(input.handle)->desc;
+        output = graph->getResource(h.output.handle)->desc;
+    }
+
+    bool supportsRenderScale() const override { return render_scale; }
+    void recordUpscale(RGContext&, const Handles&, const Config& cfg) override
+    {
+        upscale_width = cfg.width;
+        upscale_height = cfg.height;
+    }
+
+private:
+    RenderGraph* graph = nullptr;
+};
+
+class TransientRecordingBackend : public RGBackend
+{
+public:
+    std::vector<RGTextureDesc> transients;
+    std::vector<std::string> passes;
+
+    void createTransientTexture(RGResourceHandle, const RGTextureDesc& desc) override { transients.push_back(desc); }
+    void destroyTransientTexture(RGResourceHandle) override {}
+    void insertBarrier(RGResourceHandle, RGResourceUsage, RGResourceUsage) override {}
+    void flushBarriers() override {}
+    RGContext& getContext() override { return context; }
+    void beginFrame() override {}
+    void endFrame() override {}
+    void beginPass(const char* name) override { passes.push_back(name); }
+
+private:
+    RGContext context;
+};
+
+// A 0.75 scale renders the scene into 1440x810 of the 1920x1080 targets; the Upscale pass
+// fills a full-size target that tonemapping reads, and nothing is allocated at scene size.
+static bool testPostProcessGraphUpscalesScaledScene()
+{
+    const std::string name = "post-process graph upscales a scaled scene to the output size";
+
+    PostProcessGraphBuilder::Config cfg;
+    cfg.width = 1920;
+    cfg.height = 1080;
+    cfg.renderWidth = DynamicResolutionController::scaleExtent(cfg.width, 0.75f);
+    cfg.renderHeight = DynamicResolutionController::scaleExtent(cfg.height, 0.75f);
+
+    RecordingPostProcessGraphBuilder builder;
+    TransientRecordingBackend backend;
+    RenderGraph graph;
+    builder.build(graph, backend, cfg);
+
+    if (builder.scene_width != 1440 || builder.scene_height != 810)
+        return fail(name, "scene passes ran at " + std::to_string(builder.scene_width) + "x" +
+                              std::to_string(builder.scene_height));
+    const auto upscale = std::find(backend.passes.begin(), backend.passes.end(), "Upscale");
+    const auto tonemap = std::find(backend.passes.begin(), backend.passes.end(), "Tonemapping");
+    if (upscale == backend.passes.end() || tonemap == backend.passes.end() || upscale > tonemap)
+        return fail(name, "no Upscale pass before Tonemapping");
+    if (builder.upscale_width != 1920 || builder.upscale_height != 1080)
+        return fail(name, "Upscale did not target the full size");
+    if (builder.tonemap_input.width != 1920 || builder.tonemap_input.height != 1080 ||
+        builder.tonemap_input.debugName == nullptr || std::string(builder.tonemap_input.debugName) != "UpscaledHDR")
+        return fail(name, "Tonemapping does not read the full-size upscaled color");
+    if (builder.output.width != 1920 || builder.output.height != 1080)
+        return fail(name, "output is not 1920x1080");
+    for (const RGTextureDesc& desc : backend.transients)
+    {
+        if (desc.width != cfg.width || desc.height != cfg.height)
+            return fail(name, "a transient was allocated at the scene size");
+    }
+    if (std::find(backend.passes.begin(), backend.passes.end(), "HDRRestore") == backend.passes.end())
+        return fail(name, "scene color is not handed back as a shader resource");
+
+    // Backends that cannot scale render everything at full size, without an Upscale pass
+    builder.render_scale = false;
+    backend.passes.clear();
+    builder.build(graph, backend, cfg);
+    if (builder.scene_width != 1920 || builder.scene_height != 1080 ||
+        std::find(backend.passes.begin(), backend.passes.end(), "Upscale") != backend.passes.end())
+        return fail(name, "render size was not ignored by a backend without render scale support");
+    return pass(name);
+}
+
+static entt::entity addEmitter(entt::registry& registry, const glm::vec3& position, const ParticleEmitterSettings& settings)
+{
+    entt::entity e = registry.create();
+    registry.emplace<TransformComponent>(e).position = position;
+    registry.emplace<ParticleEmitterComponent>(e).settings = settings;
+    return e;
+}
+
+// Long-lived particles that fill the pool on the first frame
+static ParticleEmitterSettings makeFillingEmitter(uint32_t max_particles)
+{
+    ParticleEmitterSettings settings;
+    settings.max_particles = max_particles;
+    settings.spawn_rate = 1.0e7f;
+    settings.lifetime_min = 100.0f;
+    settings.lifetime_max = 200.0f;
+    settings.spawn_radius = 0.5f;
+    settings.drag = 0.5f;
+    return settings;
+}
+
+static bool testParticleIntegrateMatchesScalar()
+{
+    const std::string name = "particle integrate matches the scalar reference";
+
+    // 11 particles: two SIMD batches and a scalar tail, some dying this step
+    ParticlePool pool;
+    pool.setCapacity(11);
+    pool.count = 11;
+    for (uint32_t i = 0; i < pool.count; ++i)
+    {
+        pool.position_x[i] = static_cast<float>(i);
+        pool.position_y[i] = 1.0f;
+        pool.position_z[i] = -static_cast<float>(i);
+        pool.velocity_x[i] = 0.5f * i;
+        pool.velocity_y[i] = 2.0f;
+        pool.velocity_z[i] = -1.0f;
+        pool.age[i] = 0.1f * i;
+        pool.lifetime[i] = 0.75f;
+    }
+    ParticlePool reference = pool;
+
+    const float dt = 0.1f;
+    const glm::vec3 acceleration(0.0f, -9.81f, 1.0f);
+    const float drag = 0.5f;
+    std::vector<uint32_t> dead;
+    glm::vec3 bounds_min(std::numeric_limits<float>::max());
+    glm::vec3 bounds_max(std::numeric_limits<float>::lowest());
+    ParticleSystem::integrate(pool, 0, pool.count, dt, acceleration, drag, dead, bounds_min, bounds_max);
+
+    const float damping = std::exp(-drag * dt);
+    std::vector<uint32_t> expected_dead;
+    for (uint32_t i = 0; i < reference.count; ++i)
+    {
+        const glm::vec3 v = (glm::vec3(reference.velocity_x[i], reference.velocity_y[i], reference.velocity_z[i]) +
+                             acceleration * dt) * damping;
+        const glm::vec3 p = glm::vec3(reference.position_x[i], reference.position_y[i], reference.position_z[i]) + v * dt;
+        if (!approx(pool.velocity_x[i], v.x, 1e-4f) || !approx(pool.velocity_y[i], v.y, 1e-4f) ||
+            !approx(pool.velocity_z[i], v.z, 1e-4f))
+            return fail(name, "velocity of particle " + std::to_string(i) + " differs");
+        if (!approx(pool.position_x[i], p.x, 1e-4f) || !approx(pool.position_y[i], p.y, 1e-4f) ||
+            !approx(pool.position_z[i], p.z, 1e-4f))
+            return fail(name, "position of particle " + std::to_string(i) + " differs");
+        if (glm::any(glm::lessThan(p, bounds_min - 1e-4f)) || glm::any(glm::greaterThan(p, bounds_max + 1e-4f)))
+            return fail(name, "bounds do not cover particle " + std::to_string(i));
+        if (reference.age[i] + dt >= reference.lifetime[i])
+            expected_dead.push_back(i);
+    }
+    if (dead != expected_dead)
+        return fail(name, "expected " + std::to_string(expected_dead.size()) + " dead particles in ascending order, got " +
+                          std::to_string(dead.size()));
+    return pass(name);
+}
+
+static bool testParticleSystemUpdatesMillion()
+{
+    const std::string name = "particle system updates 1M particles";
+    using clock = std::chrono::steady_clock;
+
+    entt::registry registry;
+    const uint32_t per_emitter = 4096;
+    const int grid = 16;  // 256 emitters
+    for (int z = 0; z < grid; ++z)
+        for (int x = 0; x < grid; ++x)
+            addEmitter(registry, glm::vec3(x - grid / 2, 0.0f, z - grid / 2), makeFillingEmitter(per_emitter));
+    const uint32_t total = per_emitter * grid * grid;
+
+    ParticleSystem particles;
+    ParticleBudgetSettings settings;
+    settings.budget_ms = 0.0f;
+    particles.setSettings(settings);
+
+    const float dt = 1.0f / 60.0f;
+    particles.update(registry, glm::vec3(0.0f, 5.0f, 0.0f), dt);  // Spawns every pool full
+    if (particles.getStats().particles_spawned != total)
+        return fail(name, "expected " + std::to_string(total) + " spawned, got " +
+                          std::to_string(particles.getStats().particles_spawned));
+
+    const int frames = 20;
+    double total_ms = 0.0;
+    for (int f = 0; f < frames; ++f)
+    {
+        const auto start = clock::now();
+        particles.update(registry, glm::vec3(0.0f, 5.0f, 0.0f), dt);
+        total_ms += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        const ParticleSystemStats& stats = particles.getStats();
+        if (stats.live_particles != total || stats.particles_updated != total)
+            return fail(name, "frame " + std::to_string(f) + " updated " + std::to_string(stats.particles_updated) +
+                              " of " + std::to_string(total) + " particles");
+    }
+
+    const ParticleSystemStats& stats = particles.getStats();
+    std::cout << "  particles: " << stats.live_particles << " in " << stats.emitters << " emitters\n"
+              << "  update:    " << total_ms / frames << " ms/frame (" << stats.ns_per_particle << " ns/particle, "
+              << Threading::JobSystem::get().getWorkerCount() << " workers)" << std::endl;
+
+    if (stats.ns_per_particle <= 0.0f)
+        return fail(name, "no cost estimate for the budget");
+    return pass(name);
+}
+
+static bool testParticleBudgetThrottlesFarEmitters()
+{
+    const std::string name = "particle budget throttles the farthest emitters";
+
+    entt::registry registry;
+    ParticleEmitterSettings settings = makeFillingEmitter(1000);
+    std::vector<entt::entity> near_emitters;
+    for (float distance : {20.0f, 5.0f, 15.0f, 10.0f})
+        near_emitters.push_back(addEmitter(registry, glm::vec3(distance, 0.0f, 0.0f), settings));
+    entt::entity reduced = addEmitter(registry, glm::vec3(50.0f, 0.0f, 0.0f), settings);
+    entt::entity culled = addEmitter(registry, glm::vec3(200.0f, 0.0f, 0.0f), settings);
+
+    ParticleSystem particles;
+    ParticleBudgetSettings budget;
+    budget.budget_ms = 0.0f;
+    particles.setSettings(budget);
+
+    const float dt = 1.0f / 60.0f;
+    particles.update(registry, glm::vec3(0.0f), dt);
+    const ParticleSystemStats& stats = particles.getStats();
+    if (stats.full != 4 || stats.reduced != 1 || stats.culled != 1)
+        return fail(name, "expected 4 full, 1 reduced and 1 culled emitters");
+    if (registry.get<ParticleEmitterComponent>(reduced).lod != ParticleLod::Reduced)
+        return fail(name, "emitter at 50 m should be at reduced LOD");
+    if (registry.get<ParticleEmitterComponent>(culled).pool.count != 0)
+        return fail(name, "culled emitter spawned");
+
+    // Room for the two nearest full emitters only
+    budget.max_particle_updates = 2500;
+    particles.setSettings(budget);
+    particles.update(registry, glm::vec3(0.0f), dt);
+    if (stats.throttled != 3)
+        return fail(name, "expected 3 throttled emitters, got " + std::to_string(stats.throttled));
+    for (size_t i = 0; i < near_emitters.size(); ++i)
+    {
+        const auto& emitter = registry.get<ParticleEmitterComponent>(near_emitters[i]);
+        const float distance = registry.get<TransformComponent>(near_emitters[i]).position.x;
+        const bool expect_throttled = distance > 10.0f;
+        if (emitter.throttled != expect_throttled)
+            return fail(name, "emitter at " + std::to_string(distance) + " m has the wrong throttle state");
+        if (expect_throttled && emitter.lod != ParticleLod::Reduced)
+            return fail(name, "throttled emitter should drop to reduced LOD");
+    }
+
+    // With the budget lifted they return to full LOD
+    budget.max_particle_updates = 0;
+    particles.setSettings(budget);
+    particles.update(registry, glm::vec3(0.0f), dt);
+    if (stats.throttled != 0 || stats.full != 4)
+        return fail(name, "emitters did not recover once the budget was lifted");
+    return pass(name);
+}
+
+// Reports an instance capacity so the renderer records instanced particle draws
+class InstancingRenderAPI : public CullingRenderAPI
+{
+public:
+    uint32_t getInstanceCapacity() const override { return capacity; }
+    uint32_t capacity = 65536;
+};
+
+static bool testParticlesDrawInstancedBackToFront()
+{
+    const std::string name = "particles draw one instanced, depth-sorted draw per emitter";
+
+    entt::registry registry;
+    auto cube_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    addEntity(registry, cube_mesh, glm::vec3(0.0f, 0.0f, 40.0f));
+
+    ParticleEmitterSettings alpha = makeFillingEmitter(2000);
+    alpha.blend = BlendMode::Alpha;
+    alpha.spawn_radius = 3.0f;
+    ParticleEmitterSettings additive = makeFillingEmitter(1500);
+    entt::entity alpha_emitter = addEmitter(registry, glm::vec3(-2.0f, 0.0f, 10.0f), alpha);
+    entt::entity additive_emitter = addEmitter(registry, glm::vec3(2.0f, 0.0f, 10.0f), additive);
+    addEmitter(registry, glm::vec3(0.0f, 0.0f, -20.0f), additive);  // Behind the camera
+
+    camera cam;
+    cam.position = glm::vec3(0.0f);
+    cam.rotation = glm::vec3(0.0f);
+
+    ParticleSystem particles;
+    particles.update(registry, cam.getPosition(), 1.0f / 60.0f);
+    if (particles.getStats().sorted != 1)
+        return fail(name, "only the alpha-blended emitter should be sorted");
+    particles.update(registry, cam.getPosition(), 1.0f / 60.0f);
+
+    InstancingRenderAPI api;
+    renderer r(&api);
+    RenderView view;
+    view.registry = &registry;
+    view.cam = &cam;
+    view.width = 1280;
+    view.height = 720;
+    MultiViewFrame frame;
+    r.build_view_frame({view}, &registry, frame);
+
+    const RenderCommandBuffer& cmds = frame.work[0].transparent_cmds;
+    std::vector<const DrawCommand*> instanced;
+    for (const DrawCommand& cmd : cmds)
+        if (cmd.instance_count > 0)
+            instanced.push_back(&cmd);
+    if (instanced.size() != 2 || cmds.size() != 2)
+        return fail(name, "expected 2 instanced draws, got " + std::to_string(instanced.size()) + " of " +
+                          std::to_string(cmds.size()) + " commands");
+
+    const auto& alpha_pool = registry.get<ParticleEmitterComponent>(alpha_emitter).pool;
+    const auto& additive_pool = registry.get<ParticleEmitterComponent>(additive_emitter).pool;
+    const DrawCommand* alpha_draw = nullptr;
+    for (const DrawCommand* cmd : instanced)
+        if (cmd->pso_key.blend == BlendMode::Alpha)
+            alpha_draw = cmd;
+    if (!alpha_draw || alpha_draw->instance_count != alpha_pool.count)
+        return fail(name, "alpha emitter should draw all of its particles");
+    if (instanced[0]->instance_count + instanced[1]->instance_count != alpha_pool.count + additive_pool.count)
+        return fail(name, "additive emitter should draw all of its particles");
+
+    const glm::mat4* transforms = cmds.instanceTransforms(*alpha_draw);
+    float previous = std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < alpha_draw->instance_count; ++i)
+    {
+        const float distance = glm::length(glm::vec3(transforms[i][3]) - cam.getPosition());
+        if (distance > previous + 1e-4f)
+            return fail(name, "alpha particles are not drawn back to front");
+        previous = distance;
+    }
+
+    // Out of instances: the nearest particles are kept
+    api.capacity = 1000;
+    r.build_view_frame({view}, &registry, frame);
+    uint32_t drawn = 0;
+    for (const DrawCommand& cmd : frame.work[0].transparent_cmds)
+        drawn += cmd.instance_count;
+    if (drawn != api.capacity)
+        return fail(name, "expected draws clipped to the instance capacity, got " + std::to_string(drawn));
+
+    // Without instancing each particle is its own draw, capped per emitter
+    CullingRenderAPI plain;
+    renderer fallback(&plain);
+    fallback.build_view_frame({view}, &registry, frame);
+    const size_t expected = std::min<size_t>(alpha_pool.count, renderer::MAX_UNINSTANCED_PARTICLES) +
+                            std::min<size_t>(additive_pool.count, renderer::MAX_UNINSTANCED_PARTICLES);
+    if (frame.work[0].transparent_cmds.size() != expected)
+        return fail(name, "expected " + std::to_string(expected) + " per-particle draws, got " +
+                          std::to_string(frame.work[0].transparent_cmds.size()));
+    return pass(name);
+}
+
+// Flat square in XZ centered on the origin, UVs 0..1 across it, wound to face up
+static std::vector<vertex> makeGroundVertices(float half_size)
+{
+    auto corner = [&](float x, float z) {
+        vertex v = makeVertex(glm::vec3(x * half_size, 0.0f, z * half_size));
+        v.ny = 1.0f;
+        v.u = (x + 1.0f) * 0.5f;
+        v.v = (z + 1.0f) * 0.5f;
+        return v;
+    };
+    return {corner(-1, -1), corner(-1, 1), corner(1, 1), corner(-1, -1), corner(1, 1), corner(1, -1)};
+}
+
+static bool testFoliageScatterFollowsDensityMap()
+{
+    const std::string name = "foliage scatter follows the density map";
+
+    std::vector<vertex> ground = makeGroundVertices(50.0f);
+    FoliageLayer layer;
+    layer.density = 2.0f;
+    // Bare on the left third, full on the right third
+    layer.density_map.width = 4;
+    layer.density_map.height = 1;
+    layer.density_map.values = {0, 0, 255, 255};
+
+    FoliageField field;
+    const size_t added = FoliageSystem::scatterTriangles(field, 0, layer, ground.data(), ground.size(), glm::mat4(1.0f));
+    if (added == 0 || added != field.instanceCount())
+        return fail(name, "expected every scattered instance to land in a cell");
+
+    // The map averages 0.5 over the square
+    const float expected = 100.0f * 100.0f * layer.density * 0.5f;
+    if (std::abs(static_cast<float>(added) - expected) > expected * 0.05f)
+        return fail(name, "expected about " + std::to_string(static_cast<int>(expected)) + " instances, got " +
+                          std::to_string(added));
+
+    size_t left = 0;
+    size_t right = 0;
+    for (const FoliageCell& cell : field.cells)
+    {
+        for (const FoliageInstance& instance : cell.instances)
+        {
+            if (instance.position.x < -50.0f + 100.0f / 3.0f - 0.01f) ++left;
+            if (instance.position.x > 50.0f - 100.0f / 3.0f) ++right;
+            const glm::vec3 cell_min = glm::floor(cell.bounds.getCenter() / field.cell_size) * field.cell_size;
+            if (instance.position.x < cell_min.x || instance.position.x > cell_min.x + field.cell_size ||
+                instance.position.z < cell_min.z || instance.position.z > cell_min.z + field.cell_size)
+                return fail(name, "instance outside of its cell");
+        }
+    }
+    if (left != 0)
+        return fail(name, std::to_string(left) + " instances where the density map is black");
+    const float right_expected = 100.0f * 100.0f / 3.0f * layer.density;
+    if (std::abs(static_cast<float>(right) - right_expected) > right_expected * 0.05f)
+        return fail(name, "expected full density where the density map is white");
+
+    FoliageField again;
+    if (FoliageSystem::scatterTriangles(again, 0, layer, ground.data(), ground.size(), glm::mat4(1.0f)) != added)
+        return fail(name, "scattering is not deterministic");
+
+    // A wall steeper than max_slope gets nothing
+    std::vector<vertex> wall = makeGroundVertices(10.0f);
+    FoliageField wall_field;
+    const glm::mat4 upright = glm::rotate(glm::mat4(1.0f), glm::radians(80.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    if (FoliageSystem::scatterTriangles(wall_field, 0, layer, wall.data(), wall.size(), upright) != 0)
+        return fail(name, "steep triangles should not get foliage");
+    return pass(name);
+}
+
+static bool testFoliageMillionInstancesCullAndDraw()
+{
+    const std::string name = "foliage culls and draws 1M instances per cell";
+    using clock = std::chrono::steady_clock;
+
+    // 1 km square at one instance per square meter
+    static std::vector<vertex> ground = makeGroundVertices(500.0f);
+    auto ground_mesh = std::make_shared<mesh>(ground.data(), ground.size());
+    auto grass_mesh = std::make_shared<mesh>(g_cube_vertices.data(), g_cube_vertices.size());
+    grass_mesh->computeBounds();
+
+    entt::registry registry;
+    entt::entity terrain = addEntity(registry, ground_mesh, glm::vec3(0.0f));
+    auto& foliage = registry.emplace<FoliageComponent>(terrain);
+    FoliageLayer grass;
+    grass.foliage_mesh = grass_mesh;
+    grass.density = 1.0f;
+    grass.scale_min = 0.2f;
+    grass.scale_max = 0.4f;
+    grass.cull_distance = 120.0f;
+    grass.fade_distance = 20.0f;
+    foliage.layers.push_back(grass);
+
+    auto start = clock::now();
+    if (!FoliageSystem::scatterEntity(registry, terrain))
+        return fail(name, "scatter found no surface");
+    const double scatter_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    const size_t total = foliage.field.instanceCount();
+    if (total < 990000 || total > 1010000)
+        return fail(name, "expected about 1M instances, got " + std::to_string(total));
+
+    camera cam = makeCamera(glm::vec3(0.0f, 2.0f, 0.0f), 0.0f);
+    InstancingRenderAPI api;
+    api.capacity = 1u << 20;
+    renderer r(&api);
+    RenderView view;
+    view.registry = &registry;
+    view.cam = &cam;
+    view.width = 1280;
+    view.height = 720;
+    MultiViewFrame frame;
+    r.build_view_frame({view}, &registry, frame);  // Uploads the meshes
+
+    start = clock::now();
+    r.build_view_frame({view}, &registry, frame);
+    const double frame_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    const FoliageStats& stats = r.last_foliage_stats;
+    std::cout << "  instances: " << total << " in " << stats.cells << " cells, scattered in " << scatter_ms << " ms\n"
+              << "  visible:   " << stats.visible_cells << " cells (" << stats.distance_culled << " past the cull distance, "
+              << stats.frustum_culled << " outside the frustum), " << stats.drawn_instances << " instances drawn\n"
+              << "  cull+record: " << frame_ms << " ms" << std::endl;
+
+    if (stats.cells != foliage.field.cells.size() || stats.instances != total)
+        return fail(name, "stats do not cover the whole field");
+    if (stats.visible_cells + stats.distance_culled + stats.frustum_culled != stats.cells)
+        return fail(name, "every cell should be visible, distance culled or frustum culled");
+    if (stats.distance_culled == 0 || stats.frustum_culled == 0)
+        return fail(name, "expected both distance and frustum culling");
+    if (stats.visible_cells == 0 || stats.visible_cells * 10 > stats.cells)
+        return fail(name, "expected a small fraction of cells visible, got " + std::to_string(stats.visible_cells));
+
+    // One instanced draw per visible cell, every instance within the cull distance
+    size_t instanced_draws = 0;
+    size_t drawn = 0;
+    const RenderCommandBuffer& cmds = frame.work[0].opaque_cmds;
+    for (const DrawCommand& cmd : cmds)
+    {
+        if (cmd.instance_count == 0)
+            continue;
+        ++instanced_draws;
+        drawn += cmd.instance_count;
+        const glm::mat4* transforms = cmds.instanceTransforms(cmd);
+        for (uint32_t i = 0; i < cmd.instance_count; ++i)
+        {
+            if (glm::length(glm::vec3(transforms[i][3]) - cam.getPosition()) >= grass.cull_distance)
+                return fail(name, "instance drawn past the cull distance");
+        }
+    }
+    if (instanced_draws != stats.visible_cells || stats.draws != instanced_draws)
+        return fail(name, "expected " + std::to_string(stats.visible_cells) + " instanced draws, got " +
+                          std::to_string(instanced_draws));
+    if (drawn != stats.drawn_instances || drawn == 0 || drawn > stats.visible_instances)
+        return fail(name, "drawn instances do not match the stats");
+    if (cmds.size() > instanced_draws + 1)
+        return fail(name, "foliage should add no per-instance draws");
+
+    // Without instancing, a capped number of per-instance draws
+    CullingRenderAPI plain;
+    renderer fallback(&plain);
+    fallback.build_view_frame({view}, &registry, frame);
+    if (fallback.last_foliage_stats.draws != renderer::MAX_UNINSTANCED_FOLIAGE)
+        return fail(name, "expected " + std::to_string(renderer::MAX_UNINSTANCED_FOLIAGE) + " per-instance draws, got " +
+                          std::to_string(fallback.last_foliage_stats.draws));
+    return pass(name);
+}
+
+// Frustum around a 20 km cube, so nothing in a test scene is culled
+static Frustum makeEverythingFrustum()
+{
+    Frustum frustum;
+    frustum.extractFromViewProjection(glm::ortho(-1e4f, 1e4f, -1e4f, 1e4f, -1e4f, 1e4f));
+    return frustum;
+}
+
+static bool testDecalPoolRecyclesOldestFirst()
+{
+    const std::string name = "decal pool recycles the oldest decals";
+
+    DecalPool pool;
+    std::vector<DecalHandle> handles;
+    handles.reserve(10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        DecalDesc desc;
+        desc.position = glm::vec3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+        handles.push_back(pool.spawn(desc));
+    }
+
+    const uint32_t capacity = pool.capacity();
+    if (capacity != DecalPool::DEFAULT_CAPACITY || pool.liveCount() != capacity)
+        return fail(name, "expected a full pool of " + std::to_string(DecalPool::DEFAULT_CAPACITY) + ", got " +
+                          std::to_string(pool.liveCount()));
+    if (pool.spawnedCount() != 10000 || pool.recycledCount() != 10000 - capacity)
+        return fail(name, "expected " + std::to_string(10000 - capacity) + " recycled decals, got " +
+                          std::to_string(pool.recycledCount()));
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        if (pool.alive(handles[i]) != (i >= handles.size() - capacity))
+            return fail(name, "only the newest " + std::to_string(capacity) + " decals should be alive, decal " +
+                              std::to_string(i) + " is not");
+    }
+
+    // Removing frees the slot, and a stale handle cannot remove the decal that reuses it
+    if (!pool.remove(handles.back()) || pool.remove(handles.back()) || pool.liveCount() != capacity - 1)
+        return fail(name, "remove should free a live decal once");
+    if (pool.remove(handles[handles.size() - capacity - 1]))
+        return fail(name, "a recycled handle removed a live decal");
+
+    // Fade over the last fade_time seconds, then expire
+    DecalPool timed(4);
+    DecalDesc desc;
+    desc.lifetime = 10.0f;
+    desc.fade_time = 2.0f;
+    DecalHandle fading = timed.spawn(desc);
+    desc.lifetime = 0.0f;
+    DecalHandle forever = timed.spawn(desc);
+    timed.update(9.0f);
+    const Frustum everything = makeEverythingFrustum();
+    DecalFrame frame;
+    DecalStats stats;
+    DecalSystem::buildFrame(timed, everything, glm::mat4(1.0f), frame, stats);
+    if (frame.decals.size() != 2 || std::abs(frame.decals[0].color.a - 0.5f) > 1e-4f ||
+        frame.decals[1].color.a != 1.0f)
+        return fail(name, "expected the timed decal at half alpha one second before it expires");
+    timed.update(1.5f);
+    if (timed.alive(fading) || !timed.alive(forever) || timed.liveCount() != 1)
+        return fail(name, "expected the timed decal to expire and the untimed one to stay");
+
+    // Expired slots are reused before any live decal is recycled
+    for (int i = 0; i < 3; ++i)
+        timed.spawn(desc);
+    if (timed.recycledCount() != 0 || !timed.alive(forever))
+        return fail(name, "recycled a live decal while slots were free");
+    return pass(name);
+}
+
+static bool testDecalPoolReusesFreedSlotsBeforeRecycling()
+{
+    const std::string name = "decal pool reuses freed slots before recycling";
+
+    // Each decal's red channel is its spawn number, so frames show the blend order
+    DecalPool pool(4);
+    uint32_t spawned = 0;
+    auto spawn = [&](float lifetime) {
+        DecalDesc desc;
+        desc.color = glm::vec4(static_cast<float>(spawned++), 1.0f, 1.0f, 1.0f);
+        desc.lifetime = lifetime;
+        desc.fade_time = 0.0f;
+        return pool.spawn(desc);
+    };
+    auto frameOrder = [&]() {
+        DecalFrame frame;
+        DecalStats stats;
+        DecalSystem::buildFrame(pool, makeEverythingFrustum(), glm::mat4(1.0f), frame, stats);
+        std::vector<int> order;
+        for (const GPUDecal& decal : frame.decals)
+            order.push_back(static_cast<int>(decal.color.r));
+        return order;
+    };
+
+    const DecalHandle a = spawn(0.0f);
+    const DecalHandle b = spawn(1.0f);
+    const DecalHandle c = spawn(0.0f);
+    const DecalHandle d = spawn(0.0f);
+
+    // One decal expires, one is removed: both slots are free again, out of ring order
+    pool.update(1.5f);
+    if (pool.alive(b) || !pool.remove(a) || pool.liveCount() != 2)
+        return fail(name, "expected the timed decal to expire and the removed one to go");
+
+    const DecalHandle e = spawn(0.0f);
+    const DecalHandle f = spawn(0.0f);
+    if (pool.recycledCount() != 0 || !pool.alive(c) || !pool.alive(d) || pool.liveCount() != 4)
+        return fail(name, "recycled a live decal while slots were free");
+    if (frameOrder() != std::vector<int>{2, 3, 4, 5})
+        return fail(name, "frame does not list decals oldest first after reusing freed slots");
+
+    // Full: the oldest live decal goes, not whichever slot follows the last spawn
+    const DecalHandle g = spawn(0.0f);
+    if (pool.recycledCount() != 1 || pool.alive(c) || !pool.alive(d) || !pool.alive(e) || !pool.alive(f) ||
+        !pool.alive(g))
+        return fail(name, "expected the oldest live decal to be recycled");
+
+    // A slot freed in the middle of the order is reused, and the new decal still blends last
+    if (!pool.remove(e))
+        return fail(name, "remove failed on a live decal");
+    const DecalHandle h = spawn(0.0f);
+    if (pool.recycledCount() != 1 || h.slot != e.slot || pool.alive(e) || !pool.alive(h))
+        return fail(name, "expected the removed decal's slot to be reused without recycling");
+    if (frameOrder() != std::vector<int>{3, 5, 6, 7})
+        return fail(name, "frame does not list decals oldest first after a removal");
+
+    pool.clear();
+    if (pool.liveCount() != 0 || !frameOrder().empty())
+        return fail(name, "clear left live decals");
+    for (int i = 0; i < 4; ++i)
+        spawn(0.0f);
+    if (pool.recycledCount() != 1 || pool.liveCount() != 4)
+        return fail(name, "a cleared pool should refill without recycling");
+
+    return pass(name);
+}
+
+// Reports the deferred path as active
+class DeferredDecalRenderAPI : public CullingRenderAPI
+{
+public:
+    bool isDeferredActive() const override { return true; }
+};
+
+static bool testDecalProjectionAndTileBinning()
+{
+    const std::string name = "decals project into their box and bin into covering tiles";
+
+    // 1 m decal projected straight down onto the ground at the origin, atlas cell 3 of 2x2
+    DecalPool pool(16);
+    pool.setAtlas({INVALID_TEXTURE, 2, 2});
+    DecalDesc desc;
+    desc.position = glm::vec3(0.0f);
+    desc.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+    desc.size = glm::vec2(1.0f);
+    desc.depth = 0.5f;
+    desc.atlas_cell = 3;
+    desc.lifetime = 0.0f;
+    pool.spawn(desc);
+
+    const Frustum everything = makeEverythingFrustum();
+    DecalFrame frame;
+    DecalStats stats;
+    DecalSystem::buildFrame(pool, everything, glm::mat4(1.0f), frame, stats);
+    if (frame.decals.size() != 1)
+        return fail(name, "expected one decal in the frame");
+    const GPUDecal& decal = frame.decals[0];
+
+    glm::vec2 uv;
+    float fade = 0.0f;
+    if (!DecalSystem::project(decal, glm::vec3(0.0f), uv, fade) || glm::length(uv - glm::vec2(0.75f)) > 1e-4f ||
+        fade != 1.0f)
+        return fail(name, "the center should sample the middle of its atlas cell at full coverage");
+
+    // Corners of the image land on the corners of the cell, and the image is not mirrored
+    glm::vec2 corner_a;
+    glm::vec2 corner_b;
+    if (!DecalSystem::project(decal, glm::vec3(-0.49f, 0.0f, -0.49f), corner_a, fade) ||
+        !DecalSystem::project(decal, glm::vec3(0.49f, 0.0f, 0.49f), corner_b, fade))
+        return fail(name, "points inside the box should project");
+    if (glm::any(glm::lessThan(glm::min(corner_a, corner_b), glm::vec2(0.5f))) ||
+        glm::any(glm::greaterThan(glm::max(corner_a, corner_b), glm::vec2(1.0f))) ||
+        glm::length(corner_a - corner_b) < 0.6f)
+        return fail(name, "the box corners should span the atlas cell");
+
+    if (DecalSystem::project(decal, glm::vec3(0.6f, 0.0f, 0.0f), uv, fade) ||
+        DecalSystem::project(decal, glm::vec3(0.0f, 0.3f, 0.0f), uv, fade))
+        return fail(name, "points outside the box should not project");
+    if (!DecalSystem::project(decal, glm::vec3(0.0f, 0.22f, 0.0f), uv, fade) || fade <= 0.0f || fade >= 1.0f)
+        return fail(name, "coverage should fade toward the faces of the box");
+
+    // Camera above the ground looking down -Z: a decal in front of it covers a few tiles, one
+    // behind it is culled, and tile lists keep spawn order
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 0.0f, -10.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 view_proj = projection * view;
+    Frustum frustum;
+    frustum.extractFromViewProjection(view_proj);
+
+    DecalPool scene(16);
+    desc.atlas_cell = 0;
+    desc.position = glm::vec3(0.0f, 0.0f, -10.0f);
+    desc.color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    scene.spawn(desc);
+    desc.position = glm::vec3(0.0f, 0.0f, 10.0f);
+    scene.spawn(desc);
+    desc.position = glm::vec3(0.2f, 0.0f, -10.0f);
+    desc.color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+    scene.spawn(desc);
+
+    DecalSystem::buildFrame(scene, frustum, view_proj, frame, stats);
+    if (stats.live != 3 || stats.visible != 2 || stats.frustum_culled != 1 || stats.dropped != 0)
+        return fail(name, "expected two visible decals and one culled behind the camera");
+    if (frame.tiles.size() != DecalFrame::TILES_X * DecalFrame::TILES_Y)
+        return fail(name, "expected a full tile grid");
+
+    const glm::vec4 center_clip = view_proj * glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+    const glm::vec2 center_ndc = glm::vec2(center_clip) / center_clip.w;
+    const uint32_t center_tile =
+        static_cast<uint32_t>((center_ndc.y * 0.5f + 0.5f) * DecalFrame::TILES_Y) * DecalFrame::TILES_X +
+        static_cast<uint32_t>((center_ndc.x * 0.5f + 0.5f) * DecalFrame::TILES_X);
+    const glm::uvec2 range = frame.tiles[center_tile];
+    if (range.y != 2 || frame.indices[range.x] != 0 || frame.indices[range.x + 1] != 1 ||
+        frame.decals[0].color.r != 1.0f || frame.decals[1].color.g != 1.0f)
+        return fail(name, "the tile under the decals should list both, oldest first");
+
+    uint32_t covered = 0;
+    uint32_t entries = 0;
+    for (const glm::uvec2& tile : frame.tiles)
+    {
+        covered += tile.y != 0 ? 1 : 0;
+        entries += tile.y;
+    }
+    if (entries != stats.tile_entries || entries != frame.indices.size())
+        return fail(name, "tile counts do not match the index list");
+    if (covered == 0 || covered * 10 > frame.tiles.size())
+        return fail(name, "expected the decals to cover a few tiles, got " + std::to_string(covered));
+
+    // The renderer hands a view's decals to the deferred path only
+    entt::registry registry;
+    DecalPool& world_decals = DecalSystem::pool(registry);
+    camera cam = makeCamera(glm::vec3(0.0f, 2.0f, 0.0f), 0.0f);
+    const glm::vec3 forward = glm::normalize(cam.getTarget() - cam.getPosition());
+    desc.position = cam.getPosition() + forward * 10.0f;
+    desc.direction = forward;
+    world_decals.spawn(desc);
+
+    RenderView render_view;
+    render_view.registry = &registry;
+    render_view.cam = &cam;
+    render_view.width = 1280;
+    render_view.height = 720;
+    MultiViewFrame views;
+
+    DeferredDecalRenderAPI deferred;
+    renderer r(&deferred);
+    r.build_view_frame({render_view}, &registry, views);
+    if (views.work[0].decals.decals.size() != 1 || r.last_decal_stats.visible != 1)
+        return fail(name, "expected the deferred view to carry the decal");
+
+    CullingRenderAPI forward_api;
+    renderer forward_renderer(&forward_api);
+    forward_renderer.build_view_frame({render_view}, &registry, views);
+    if (!views.work[0].decals.empty())
+        return fail(name, "the forward path should not build decals");
+    return pass(name);
+}
+
+int main()
+{
+    EE::CLog::Init();
+    if (!Threading::JobSystem::get().isInitialized())
+        Threading::JobSystem::get().initialize();
+    bool ok = true;
+    run("mesh BVH raycast misses hole");
+    ok = testMeshBVHRaycastMissesHole() && ok;
+    run("pick through hole selects object behind");
+    ok = testPickThroughHoleSelectsObjectBehind() && ok;
+    run("pick transformed entity");
+    ok = testPickTransformedEntity() && ok;
+    run("marquee selects by triangles");
+    ok = testMarqueeSelectsByTriangles() && ok;
+    run("picking scales to large scenes");
+    ok = testPickingScalesToLargeScenes() && ok;
+    run("multi-view shares culling");
+    ok = testMultiViewSharesCulling() && ok;
+    run("multi-view groups views that can share shadows");
+    ok = testMultiViewGroupsSharedShadows() && ok;
+    run("multi-view 1 vs 4 views");
+    ok = testMultiViewScalesWithViews() && ok;
+    run("shader build skips up-to-date outputs");
+    ok = testShaderBuildSkipsUpToDateOutputs() && ok;
+    run("slang SPIR-V build is incremental");
+    ok = testShaderBuildSpirvTwiceWithSlang() && ok;
+    run("RmlUi data model dirties only changed variables");
+    ok = testRmlDataModelTracksChanges() && ok;
+    run("RmlUi Vulkan batching cuts draws on a canned HUD");
+    ok = testRmlUiVulkanBatchingBenchmark() && ok;
+    run("GPU pass timings sum to the frame time");
+    ok = testGpuPassTimingsSumToFrame() && ok;
+    run("render graph schedules compute passes on the async compute queue");
+    ok = testRenderGraphSchedulesAsyncCompute() && ok;
+    run("render graph records async compute syncs in order");
+    ok = testRenderGraphExecutesAsyncComputeInOrder() && ok;
+    run("dynamic resolution scale meets the GPU budget");
+    ok = testDynamicResolutionMeetsBudget() && ok;
+    run("post-process graph upscales a scaled scene to the output size");
+    ok = testPostProcessGraphUpscalesScaledScene() && ok;
+    run("particle integrate matches the scalar reference");
+    ok = testParticleIntegrateMatchesScalar() && ok;
+    run("particle system updates 1M particles");
+    ok = testParticleSystemUpdatesMillion() && ok;
+    run("particle budget throttles the farthest emitters");
+    ok = testParticleBudgetThrottlesFarEmitters() && ok;
+    run("particles draw one instanced, depth-sorted draw per emitter");
+    ok = testParticlesDrawInstancedBackToFront() && ok;
+    run("foliage scatter follows the density map");
+    ok = testFoliageScatterFollowsDensityMap() && ok;
+    run("foliage culls and draws 1M instances per cell");
+    ok = testFoliageMillionInstancesCullAndDraw() && ok;
+    run("decal pool recycles the oldest decals");
+    ok = testDecalPoolRecyclesOldestFirst() && ok;
+    run("decal pool reuses freed slots before recycling");
+    ok = testDecalPoolReusesFreedSlotsBeforeRecycling() && ok;
+    run("decals project into their box and bin into covering tiles");
+    ok = testDecalProjectionAndTileBinning() && ok;
+
+    Threading::JobSystem::get().shutdown();
+    EE::CLog::Shutdown();
+    return ok ? 0 : 1;
+}
@@ -3,12 +3,18 @@
 #include "Network/NetworkSerializer.hpp"
 #include "Network/NetworkInput.hpp"
 #include "Network/NetworkTransport.hpp"
+#include "Network/ENetTransport.hpp"
+#include "Network/LocalTransport.hpp"
 #include "Network/SharedMovement.hpp"
 #include "Network/LagHistory.hpp"
+#include "Network/InputJitterBuffer.hpp"
 #include "Network/PredictionTypes.hpp"
 #include "Network/InterpolationBuffer.hpp"
+#include "Physics/PhysicsDeterminism.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -274,6 +280,84 @@ int testWorldStateSerialization()
     return 0;
 }
 
+int testPhysicsHashSerialization()
+{
+    const char* name = "PhysicsHashSerialization";
+    Net::InputCommandMessage input;
+    input.client_tick = 12;
+    input.last_received_tick = 30;
+    input.flags = Net::InputCommandFlags::PHYSICS_HASH;
+    input.physics_hash_tick = 30;
+    input.physics_hash = 0x0123456789abcdefull;
+
+    Net::InputSample redundant[1] = {};
+    redundant[0].tick = 11;
+
+    Net::BitWriter input_writer;
+    Net::NetworkSerializer::serialize(input_writer, input, redundant, 1);
+    Net::BitReader input_reader(input_writer.getData(), input_writer.getByteSize());
+    Net::InputCommandMessage input_out;
+    std::vector<Net::InputSample> redundant_out;
+    if (!Net::NetworkSerializer::deserialize(input_reader, input_out, redundant_out)) {
+        return fail(name, "input deserialize failed");
+    }
+    if (!input_out.hasPhysicsHash() || input_out.physics_hash_tick != 30 || input_out.physics_hash != 0x0123456789abcdefull) {
+        return fail(name, "input physics hash mismatch");
+    }
+    if (redundant_out.size() != 1 || redundant_out[0].tick != 11) return fail(name, "redundant input lost");
+
+    Net::InputCommandMessage plain = input;
+    plain.flags = Net::InputCommandFlags::NONE;
+    Net::BitWriter plain_writer;
+    Net::NetworkSerializer::serialize(plain_writer, plain, redundant, 1);
+    if (plain_writer.getByteSize() + 12 != input_writer.getByteSize()) {
+        return fail(name, "physics hash size does not follow the flag");
+    }
+
+    Net::BitWriter bad_flags;
+    bad_flags.writeByte(static_cast<uint8_t>(Net::MessageType::INPUT_COMMAND));
+    bad_flags.writeUInt32(1);
+    bad_flags.writeUInt32(0);
+    bad_flags.writeByte(0x80);
+    bad_flags.writeByte(1);
+    Net::BitReader bad_reader(bad_flags.getData(), bad_flags.getByteSize());
+    if (Net::NetworkSerializer::deserialize(bad_reader, input_out, redundant_out)) {
+        return fail(name, "unknown input flags accepted");
+    }
+
+    Net::WorldStateUpdateMessage state;
+    state.server_tick = 30;
+    state.snapshot_flags = Net::SnapshotFlags::FULL | Net::SnapshotFlags::PHYSICS_HASH;
+    state.physics_hash = 0xfedcba9876543210ull;
+    Net::BitWriter state_writer;
+    Net::NetworkSerializer::serialize(state_writer, state, {});
+    Net::BitReader state_reader(state_writer.getData(), state_writer.getByteSize());
+    Net::WorldStateUpdateMessage state_out;
+    std::vector<Net::EntityUpdateData> updates_out;
+    if (!Net::NetworkSerializer::deserialize(state_reader, state_out, updates_out)) {
+        return fail(name, "world state deserialize failed");
+    }
+    if (!state_out.hasPhysicsHash() || state_out.physics_hash != 0xfedcba9876543210ull) {
+        return fail(name, "world state physics hash mismatch");
+    }
+
+    PhysicsStateHashHistory history;
+    history.record(5, 100);
+    history.record(5 + PhysicsStateHashHistory::CAPACITY, 200);
+    uint64_t found = 0;
+    if (history.find(5, found)) return fail(name, "overwritten history tick still found");
+    if (!history.find(5 + PhysicsStateHashHistory::CAPACITY, found) || found != 200) return fail(name, "history lookup mismatch");
+
+    PhysicsDesyncDetector detector;
+    if (!detector.compare(40, 1, 1)) return fail(name, "matching hashes reported a desync");
+    if (detector.compare(43, 2, 3)) return fail(name, "mismatching hashes were accepted");
+    detector.compare(46, 4, 5);
+    const PhysicsDesyncReport& report = detector.getReport();
+    if (!report.detected || report.tick != 43 || report.last_matching_tick != 40) return fail(name, "first divergence not captured");
+    if (report.local_hash != 2 || report.remote_hash != 3 || report.mismatches != 2) return fail(name, "desync report mismatch");
+    return 0;
+}
+
 int testNetworkTransportPolicy()
 {
     const char* name = "NetworkTransportPolicy";
@@ -307,6 +391,86 @@ int testNetworkTransportPolicy()
     return 0;
 }
 
+int testLocalTransport()
+{
+    const char* name = "LocalTransport";
+    constexpr uint16_t port = 47011;
+
+    double clock = 0.0;
+    Net::LocalTransportSettings settings;
+    settings.latency_ms = 10.0f;
+    settings.loss_percent = 100.0f;
+    settings.clock = [&clock]() { return clock; };
+
+    Net::LocalTransport server(settings);
+    Net::LocalTransport client(settings);
+    if (!server.listen(port, 1)) return fail(name, "listen failed");
+    if (!Net::LocalTransport::isListening(port)) return fail(name, "listener not registered");
+
+    const Net::TransportPeerId server_peer = client.connect("127.0.0.1", port);
+    if (server_peer == Net::INVALID_TRANSPORT_PEER) return fail(name, "connect failed");
+
+    Net::TransportEvent event;
+    if (!server.poll(event) || event.type != Net::TransportEventType::Connect) {
+        return fail(name, "server did not accept the connection");
+    }
+    const Net::TransportPeerId client_peer = event.peer;
+
+    // The accept is delayed by the simulated latency and released when the server pumps
+    if (client.poll(event)) return fail(name, "accept arrived before latency elapsed");
+    clock = 0.011;
+    server.flush();
+    if (!client.poll(event) || event.type != Net::TransportEventType::Connect) {
+        return fail(name, "client did not see the accept");
+    }
+
+    // Reliable packets survive 100% loss and keep their order; unreliable ones do not
+    const uint8_t first[] = { 1, 2, 3 };
+    const uint8_t second[] = { 4 };
+    const uint8_t lost[] = { 9 };
+    if (!Net::packetSendSucceeded(client.send(server_peer, first, sizeof(first), Net::PacketReliability::Reliable)) ||
+        !Net::packetSendSucceeded(client.send(server_peer, lost, sizeof(lost), Net::PacketReliability::UnreliableSequenced)) ||
+        !Net::packetSendSucceeded(client.send(server_peer, second, sizeof(second), Net::PacketReliability::Reliable))) {
+        return fail(name, "send failed");
+    }
+    client.flush();
+    if (server.poll(event)) return fail(name, "packet arrived before latency elapsed");
+
+    clock = 0.022;
+    client.flush();
+    if (!server.poll(event) || event.type != Net::TransportEventType::Receive ||
+        event.peer != client_peer || event.size != sizeof(first) || event.data[2] != 3) {
+        return fail(name, "first reliable packet mismatch");
+    }
+    if (!server.poll(event) || event.type != Net::TransportEventType::Receive ||
+        event.size != sizeof(second) || event.data[0] != 4) {
+        return fail(name, "second reliable packet mismatch");
+    }
+    if (server.poll(event)) return fail(name, "unreliable packet survived 100% loss");
+
+    // A second client is refused once the server is full
+    Net::LocalTransport extra(settings);
+    if (extra.connect("127.0.0.1", port) == Net::INVALID_TRANSPORT_PEER) return fail(name, "extra connect failed");
+    server.poll(event);
+    clock = 0.05;
+    if (!extra.poll(event) || event.type != Net::TransportEventType::Disconnect) {
+        return fail(name, "full server did not refuse the extra client");
+    }
+
+    client.disconnect(server_peer);
+    clock = 0.08;
+    client.flush();
+    bool saw_disconnect = false;
+    while (server.poll(event)) {
+        saw_disconnect = saw_disconnect || event.type == Net::TransportEventType::Disconnect;
+    }
+    if (!saw_disconnect) return fail(name, "server missed the disconnect");
+
+    server.close("Test");
+    if (Net::LocalTransport::isListening(port)) return fail(name, "listener still registered after close");
+    return 0;
+}
+
 int testNetworkStats()
 {
     const char* name = "NetworkStats";
@@ -367,6 +531,89 @@ int testLagHistory()
     return 0;
 }
 
+int testInputJitterBuffer()
+{
+    const char* name = "InputJitterBuffer";
+
+    // Client sends one input per tick; each packet is held back 0-3 ticks, in order
+    Net::InputJitterBuffer buffer;
+    uint32_t rng = 12345u;
+    uint32_t release_tick = 0;
+    std::vector<std::pair<uint32_t, Net::InputSample>> in_flight;
+    uint32_t last_played = 0;
+    uint32_t played_ticks = 0;
+    uint32_t jump_sent = 0;
+    uint32_t jump_played = 0;
+
+    for (uint32_t server_tick = 1; server_tick <= 600; ++server_tick) {
+        rng = rng * 1664525u + 1013904223u;
+        release_tick = (std::max)(release_tick, server_tick + ((rng >> 16) % 4u));
+        Net::InputSample sample;
+        sample.tick = server_tick;
+        sample.move_forward = 1.0f;
+        if (server_tick % 50 == 25) {
+            sample.buttons = Net::InputFlags::JUMP;
+            ++jump_sent;
+        }
+        in_flight.push_back({ release_tick, sample });
+
+        size_t delivered = 0;
+        while (delivered < in_flight.size() && in_flight[delivered].first <= server_tick) {
+            buffer.recordArrival(in_flight[delivered].second.tick, server_tick);
+            buffer.push(in_flight[delivered].second, server_tick - 1);
+            ++delivered;
+        }
+        in_flight.erase(in_flight.begin(), in_flight.begin() + static_cast<std::ptrdiff_t>(delivered));
+
+        Net::BufferedInput input;
+        if (!buffer.consume(input)) {
+            if (played_ticks != 0) return fail(name, "playback stopped after it started");
+            continue;
+        }
+        ++played_ticks;
+        if (input.synthesized) {
+            if ((input.sample.buttons & Net::INPUT_ACTION_LATCH_MASK) != 0) return fail(name, "repeated input kept a one-shot action");
+            continue;
+        }
+        if (last_played != 0 && !Net::isTickNewer(input.sample.tick, last_played)) return fail(name, "inputs played out of order");
+        last_played = input.sample.tick;
+        if (input.sample.buttons & Net::InputFlags::JUMP) ++jump_played;
+    }
+
+    const Net::InputJitterStats& stats = buffer.getStats();
+    if (stats.jitter_ticks < 0.25f) return fail(name, "arrival jitter was not measured");
+    if (stats.target_depth <= buffer.getSettings().min_depth) return fail(name, "target depth did not grow with jitter");
+    if (stats.consumed + stats.merged + buffer.size() != stats.received) return fail(name, "inputs were lost");
+    if (stats.synthesized + stats.merged > played_ticks / 10) return fail(name, "too many synthesized or merged ticks under steady jitter");
+    if (jump_played != jump_sent) return fail(name, "one-shot actions were dropped");
+
+    // Underflow repeats the last input, then waits for the target depth before resuming
+    Net::InputJitterBuffer steady;
+    Net::InputSample a;
+    a.tick = 1;
+    a.move_right = 0.5f;
+    a.buttons = Net::InputFlags::ATTACK;
+    steady.push(a, 0);
+    Net::BufferedInput out;
+    if (!steady.consume(out) || out.synthesized || out.sample.tick != 1) return fail(name, "first input did not play");
+    if (!steady.consume(out) || !out.synthesized || !approxEqual(out.sample.move_right, 0.5f)) return fail(name, "underflow did not repeat input");
+    if (out.sample.buttons != 0) return fail(name, "underflow repeated an attack");
+
+    // Overflow folds the oldest input into the next and keeps its one-shot buttons
+    Net::InputJitterBuffer flood;
+    for (uint32_t tick = 1; tick <= 6; ++tick) {
+        Net::InputSample s;
+        s.tick = tick;
+        s.buttons = (tick == 1) ? Net::InputFlags::JUMP : 0;
+        flood.push(s, 0);
+    }
+    if (!flood.consume(out) || out.sample.tick != 2 || (out.sample.buttons & Net::InputFlags::JUMP) == 0) {
+        return fail(name, "overflow merge lost the oldest jump");
+    }
+    if (flood.getStats().merged != 1) return fail(name, "overflow merge was not counted");
+    return 0;
+}
+
 int testCVarSerialization()
 {
     const char* name = "CVarSerialization";
@@ -427,10 +674,13 @@ int main()
     failures += testInputActionLatchPolicy();
     failures += testSharedMovementSourceRules();
     failures += testWorldStateSerialization();
+    failures += testPhysicsHashSerialization();
     failures += testNetworkTransportPolicy();
+    failures += testLocalTransport();
     failures += testCVarSerialization();
     failures += testNetworkStats();
     failures += testLagHistory();
+    failures += testInputJitterBuffer();
     failures += testPredictionAndInterpolation();
 
     if (failures == 0) {
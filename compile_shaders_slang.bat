@@ -68,8 +68,10 @@ echo Compiling gbuffer...
 call :compile gbuffer vertexMain fragmentMain
 echo Compiling deferred_lighting...
 call :compile deferred_lighting vertexMain fragmentMain
+echo Compiling decals...
+call :compile decals vertexMain fragmentMain
 
-REM rmlui has 3 entry points
+REM rmlui has 5 entry points
 echo Compiling rmlui...
 if not exist "%SHADER_DIR%\rmlui.slang" (
     echo   ERROR: Source file not found: %SHADER_DIR%\rmlui.slang
@@ -106,6 +108,26 @@ if errorlevel 1 (
     echo   FAILED: rmlui [SPIR-V fragmentColor]
     set /a ERRORS+=1
 )
+"%SLANGC%" %SLANG_WARN% "%SHADER_DIR%\rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry vertexAtlas -stage vertex -o "%OUT_D3D12%\rmlui_atlas_vs.dxil"
+if errorlevel 1 (
+    echo   FAILED: rmlui [DXIL vertexAtlas]
+    set /a ERRORS+=1
+)
+"%SLANGC%" %SLANG_WARN% "%SHADER_DIR%\rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry fragmentAtlas -stage fragment -o "%OUT_D3D12%\rmlui_atlas_ps.dxil"
+if errorlevel 1 (
+    echo   FAILED: rmlui [DXIL fragmentAtlas]
+    set /a ERRORS+=1
+)
+"%SLANGC%" %SLANG_WARN% "%SHADER_DIR%\rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry vertexAtlas -stage vertex -o "%OUT_VK%\rmlui_atlas.vert.spv"
+if errorlevel 1 (
+    echo   FAILED: rmlui [SPIR-V vertexAtlas]
+    set /a ERRORS+=1
+)
+"%SLANGC%" %SLANG_WARN% "%SHADER_DIR%\rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry fragmentAtlas -stage fragment -o "%OUT_VK%\rmlui_atlas.frag.spv"
+if errorlevel 1 (
+    echo   FAILED: rmlui [SPIR-V fragmentAtlas]
+    set /a ERRORS+=1
+)
 :after_rmlui
 
 echo.
@@ -60,8 +60,10 @@ echo "Compiling gbuffer..."
 compile gbuffer vertexMain fragmentMain
 echo "Compiling deferred_lighting..."
 compile deferred_lighting vertexMain fragmentMain
+echo "Compiling decals..."
+compile decals vertexMain fragmentMain
 
-# rmlui has 3 entry points
+# rmlui has 5 entry points
 echo "Compiling rmlui..."
 "$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry vertexMain -stage vertex -o "$OUT_D3D12/rmlui_vs.dxil" 2>/dev/null || ((ERRORS++))
 "$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry fragmentTextured -stage fragment -o "$OUT_D3D12/rmlui_ps_textured.dxil" 2>/dev/null || ((ERRORS++))
@@ -69,6 +71,10 @@ echo "Compiling rmlui..."
 "$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry vertexMain -stage vertex -o "$OUT_VK/rmlui.vert.spv" 2>/dev/null || ((ERRORS++))
 "$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry fragmentTextured -stage fragment -o "$OUT_VK/rmlui_texture.frag.spv" 2>/dev/null || ((ERRORS++))
 "$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry fragmentColor -stage fragment -o "$OUT_VK/rmlui_color.frag.spv" 2>/dev/null || ((ERRORS++))
+"$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry vertexAtlas -stage vertex -o "$OUT_D3D12/rmlui_atlas_vs.dxil" 2>/dev/null || ((ERRORS++))
+"$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_HLSL -target dxil -profile sm_6_0 -entry fragmentAtlas -stage fragment -o "$OUT_D3D12/rmlui_atlas_ps.dxil" 2>/dev/null || ((ERRORS++))
+"$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry vertexAtlas -stage vertex -o "$OUT_VK/rmlui_atlas.vert.spv" 2>/dev/null || ((ERRORS++))
+"$SLANGC" "$SHADER_DIR/rmlui.slang" -DTARGET_SPIRV -target spirv -profile glsl_450 -entry fragmentAtlas -stage fragment -o "$OUT_VK/rmlui_atlas.frag.spv" 2>/dev/null || ((ERRORS++))
 
 echo ""
 if [ "$ERRORS" -eq 0 ]; then